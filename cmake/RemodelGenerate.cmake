@@ -0,0 +1,55 @@
+# This file is part of the remodel library (zyantific.com).
+#
+# Provides remodel_generate_wrappers(), turning layout spec files into wrapper headers at build
+# time using tools/remodel_gen.py.
+#
+#   remodel_generate_wrappers(<target>
+#       SPECS <spec>...
+#       [OUTPUT_DIR <dir>])
+#
+# One header named after each spec (`game.json` -> `game.hpp`) is generated into OUTPUT_DIR
+# (default: ${CMAKE_CURRENT_BINARY_DIR}/remodel_generated), which is added to the include
+# directories of <target>. Headers are regenerated whenever a spec or the generator changes.
+
+include(CMakeParseArguments)
+
+set(REMODEL_GENERATOR "${CMAKE_CURRENT_LIST_DIR}/../tools/remodel_gen.py" CACHE INTERNAL "")
+
+function (remodel_generate_wrappers target)
+	cmake_parse_arguments(GEN "" "OUTPUT_DIR" "SPECS" ${ARGN})
+	if (NOT GEN_SPECS)
+		message(FATAL_ERROR "remodel_generate_wrappers: no SPECS given")
+	endif ()
+	if (NOT GEN_OUTPUT_DIR)
+		set(GEN_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/remodel_generated")
+	endif ()
+
+	if (NOT PYTHONINTERP_FOUND)
+		find_package(PythonInterp 3 REQUIRED)
+	endif ()
+
+	file(MAKE_DIRECTORY "${GEN_OUTPUT_DIR}")
+	set(headers)
+	foreach (spec ${GEN_SPECS})
+		get_filename_component(spec "${spec}" ABSOLUTE)
+		get_filename_component(name "${spec}" NAME_WE)
+		set(header "${GEN_OUTPUT_DIR}/${name}.hpp")
+		add_custom_command(
+			OUTPUT "${header}"
+			COMMAND "${PYTHON_EXECUTABLE}" "${REMODEL_GENERATOR}" "${spec}" -o "${header}"
+			DEPENDS "${spec}" "${REMODEL_GENERATOR}"
+			COMMENT "Generating remodel wrappers from ${name}"
+			VERBATIM)
+		list(APPEND headers "${header}")
+	endforeach ()
+
+	add_custom_target(${target}_remodel_wrappers ALL DEPENDS ${headers})
+	get_target_property(type ${target} TYPE)
+	if (type STREQUAL "INTERFACE_LIBRARY")
+		# Consumers of interface libraries depend on the generation target themselves.
+		target_include_directories(${target} INTERFACE "${GEN_OUTPUT_DIR}")
+	else ()
+		target_include_directories(${target} PUBLIC "${GEN_OUTPUT_DIR}")
+		add_dependencies(${target} ${target}_remodel_wrappers)
+	endif ()
+endfunction ()
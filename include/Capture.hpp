@@ -0,0 +1,1074 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_CAPTURE_HPP
+#define REMODEL_CAPTURE_HPP
+
+/**     
+ * @file
+ * @brief Contains whole-object captures of wrapped objects into a compact binary format.
+ *        
+ * A capture holds the raw bytes of every object plus one layout record per type, instead of
+ * reading fields one by one. Pointer fields declared with `CaptureType::follow` are followed,
+ * so graphs of objects are captured as a whole, every object being written once.
+ *
+ * @code
+ *      CaptureType<Node> node{"Node"};
+ *      node.follow(&Node::next, node);
+ *      CaptureType<World> world{"World"};
+ *      world.follow(&World::firstNode, node);
+ *      
+ *      CaptureWriter writer{"world.capture"};
+ *      writer.write(world, wrapper_cast<World>(worldPtr));
+ *      writer.close();
+ *      
+ *      std::vector<uint8_t> data;
+ *      CaptureReader::readFile("world.capture", data);
+ *      CaptureReader capture{std::move(data)};
+ *      for (const auto& obj : capture.objects()) { ... }
+ * @endcode
+ * 
+ * Objects are captured from the current address space, or through a memory accessor (see 
+ * Remote.hpp) from another process. Files are written with buffered I/O. Large captures are best
+ * analysed through `MappedCapture`, which maps the file instead of reading it and wraps the 
+ * objects in place.
+ */
+
+#include "Remodel.hpp"
+#include "Remote.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [File format]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The header of a capture file.
+ */
+struct CaptureFileHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char     magic[8];
+    uint32_t version;
+    /// The size of pointers in captured objects.
+    uint32_t pointerSize;
+    uint32_t reserved[2];
+};
+
+static_assert(sizeof(CaptureFileHeader) == 24, "unexpected padding");
+
+const char kCaptureFileMagic[8] = {'R', 'M', 'D', 'L', 'C', 'A', 'P', 'T'};
+
+/**
+ * @brief   The header preceding every record of a capture.
+ * 
+ * Records start at multiples of 8 bytes. The payload follows the header after `padding` bytes,
+ * aligning object bytes to the alignment of their type.
+ * 
+ * Type records precede the first object of their type. Their payload is a `CaptureTypeLayout`,
+ * followed by the offsets of the followed pointer fields (`uint32_t` each) and the name of the
+ * type. Object payloads are the raw bytes of the object.
+ * 
+ * Closed captures end with an index record and a footer record. The index holds the number of
+ * types and the offsets of the type records (`uint64_t` each, in order of IDs), followed by a 
+ * `CaptureIndexEntry` per object, sorted by address. The footer holds the offset of the index 
+ * record (`uint64_t`), so `MappedCapture` can locate objects without parsing other records.
+ */
+struct CaptureRecordHeader
+{
+    enum Kind : uint32_t
+    {
+        kType   = 1,
+        kObject = 2,
+        kIndex  = 3,
+        kFooter = 4,
+    };
+
+    uint32_t kind;
+    /// The ID of the type, the index of its type record.
+    uint32_t typeId;
+    /// The address of the object, zero for other records.
+    uint64_t address;
+    uint32_t size;
+    uint32_t padding;
+};
+
+static_assert(sizeof(CaptureRecordHeader) == 24, "unexpected padding");
+
+/**
+ * @brief   The layout part of a type record.
+ */
+struct CaptureTypeLayout
+{
+    uint32_t objSize;
+    uint32_t objAlign;
+    uint32_t edgeCount;
+    uint32_t nameLength;
+};
+
+/**
+ * @brief   An object in the index record.
+ */
+struct CaptureIndexEntry
+{
+    uint64_t address;
+    /// The offset of the object record from the start of the capture.
+    uint64_t recordOffset;
+    uint32_t typeId;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(CaptureIndexEntry) == 24, "unexpected padding");
+
+// ---------------------------------------------------------------------------------------------- //
+// [CaptureType]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Type-erased part of `CaptureType`.
+ */
+class CaptureTypeBase
+{
+    friend class CaptureWriter;
+public:
+    const std::string& name() const     { return m_name; }
+    std::size_t objSize() const         { return m_objSize; }
+    std::size_t objAlign() const        { return m_objAlign; }
+
+    /**
+     * @brief   Gets the number of followed pointer fields.
+     */
+    std::size_t edgeCount() const       { return m_edges.size(); }
+protected:
+    struct Edge
+    {
+        uint32_t offset;
+        const CaptureTypeBase* target;
+    };
+
+    CaptureTypeBase(const char* name, std::size_t objSize, std::size_t objAlign)
+        : m_name{name}
+        , m_objSize{objSize}
+        , m_objAlign{objAlign}
+    {}
+
+    CaptureTypeBase(const CaptureTypeBase&) = delete;
+    CaptureTypeBase& operator = (const CaptureTypeBase&) = delete;
+protected:
+    std::string m_name;
+    std::size_t m_objSize;
+    std::size_t m_objAlign;
+    std::vector<Edge> m_edges;
+};
+
+/**
+ * @brief   Describes how objects of a wrapper type are captured.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ *                      
+ * Types are referred to by address from other types and from writers, so they have to outlive
+ * both. Types following themselves (e.g. linked lists) are supported.
+ */
+template<typename WrapperT>
+class CaptureType : public CaptureTypeBase
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "CaptureType requires usage of AdvancedClassWrapper as base");
+public:
+    /**
+     * @brief   Constructor.
+     * @param   name    The name of the type, stored in the capture.
+     */
+    explicit CaptureType(const char* name)
+        : CaptureTypeBase{name, WrapperT::kObjSize, WrapperT::kObjAlign}
+    {}
+
+    /**
+     * @brief   Follows a pointer field, capturing the objects it points to.
+     * @param   field   The pointer field member of the wrapper.
+     * @param   target  The type of the objects pointed to.
+     * @return  `*this`.
+     * @note    Only fields located inside the object are followed, fields using getters that
+     *          point elsewhere (e.g. `PtrChainGetter`) are ignored.
+     */
+    template<typename FieldT, typename TargetT>
+    CaptureType& follow(FieldT WrapperT::* field, const CaptureType<TargetT>& target)
+    {
+        static_assert(std::is_pointer<typename FieldT::RewrittenT>::value, 
+            "only pointer fields can be followed");
+
+        alignas(WrapperT::kObjAlign) uint8_t scratch[WrapperT::kObjSize];
+        auto wrapper = wrapper_cast<WrapperT>(static_cast<void*>(scratch));
+        auto offs = reinterpret_cast<const uint8_t*>((wrapper.*field).addressOfObj()) - scratch;
+        if (offs >= 0 && static_cast<std::size_t>(offs) + sizeof(void*) <= WrapperT::kObjSize)
+        {
+            m_edges.push_back({static_cast<uint32_t>(offs), &target});
+        }
+        return *this;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [CaptureWriter]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Writes captures of objects to a file or a memory buffer.
+ * 
+ * Object bytes are copied straight from memory into the write buffer, which is written to the 
+ * file whenever it is full. Every object is written once per writer, even if it is reachable
+ * from several captured objects. Closing the writer appends the index, no objects can be 
+ * written afterwards.
+ */
+class CaptureWriter
+{
+public:
+    static const std::size_t kDefaultBufferSize = 1 << 16;
+
+    /**
+     * @brief   Constructor, creating a capture file.
+     * @param   path        The path of the file, replaced if existing.
+     * @param   bufferSize  The size of the write buffer.
+     */
+    explicit CaptureWriter(const char* path, std::size_t bufferSize = kDefaultBufferSize)
+        : m_file{std::fopen(path, "wb")}
+        , m_out{&m_buffer}
+        , m_bufferSize{bufferSize}
+    {
+        if (!m_file) return;
+        m_ok = true;
+        m_buffer.reserve(bufferSize);
+        writeFileHeader();
+    }
+
+    /**
+     * @brief   Constructor, appending the capture to a memory buffer.
+     * @param   out The buffer, which has to outlive the writer.
+     */
+    explicit CaptureWriter(std::vector<uint8_t>& out)
+        : m_out{&out}
+        , m_ok{true}
+    {
+        writeFileHeader();
+    }
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator = (const CaptureWriter&) = delete;
+
+    /**
+     * @brief   Destructor, closing the writer.
+     */
+    ~CaptureWriter() { close(); }
+
+    /**
+     * @brief   Captures an object of the current address space and the objects reachable from it.
+     * @param   type    The type of the object.
+     * @param   raw     The raw pointer of the object.
+     * @return  The number of objects written, excluding previously written objects.
+     */
+    std::size_t write(const CaptureTypeBase& type, const void* raw)
+    {
+        return write(m_local, type, reinterpret_cast<uintptr_t>(raw));
+    }
+
+    /**
+     * @copydoc write(const CaptureTypeBase&, const void*)
+     */
+    template<typename WrapperT>
+    std::size_t write(const CaptureType<WrapperT>& type, const WrapperT& obj)
+    {
+        return write(type, static_cast<const void*>(obj.addressOfObj()));
+    }
+
+    /**
+     * @brief   Captures an object through a memory accessor and the objects reachable from it.
+     * @tparam  AccessorT   Type of the memory accessor.
+     * @param   accessor    The accessor.
+     * @param   type        The type of the object.
+     * @param   address     The address of the object.
+     * @return  The number of objects written, excluding previously written objects. Objects
+     *          that can't be read are skipped.
+     */
+    template<typename AccessorT>
+    std::size_t write(AccessorT& accessor, const CaptureTypeBase& type, uintptr_t address)
+    {
+        if (!m_ok || m_closed || !address) return 0;
+
+        std::size_t count = 0;
+        m_pending.clear();
+        m_pending.push_back({address, &type});
+        while (!m_pending.empty())
+        {
+            auto cur = m_pending.back();
+            m_pending.pop_back();
+            auto typeId = typeIdOf(*cur.type);
+            if (!m_seen.insert(Key{cur.address, typeId}).second) continue;
+
+            auto bytes = prepareRecord(CaptureRecordHeader::kObject, typeId, cur.address, 
+                cur.type->m_objSize, cur.type->m_objAlign);
+            if (!accessor.read(platform::MemoryRange{cur.address, bytes, cur.type->m_objSize}))
+            {
+                cancelRecord();
+                continue;
+            }
+            m_index.push_back({cur.address, recordOffset(), typeId, 0});
+            
+            for (const auto& edge : cur.type->m_edges)
+            {
+                uintptr_t target;
+                std::memcpy(&target, bytes + edge.offset, sizeof(target));
+                if (target) m_pending.push_back({target, edge.target});
+            }
+            ++count;
+        }
+        m_objects += count;
+        return count;
+    }
+
+    /**
+     * @brief   Writes the buffered records to the file.
+     * @return  @c true if all writes succeeded so far, else @c false.
+     */
+    bool flush()
+    {
+        if (m_file && !m_buffer.empty())
+        {
+            m_ok &= std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) == m_buffer.size();
+            m_flushed += m_buffer.size();
+            m_buffer.clear();
+        }
+        return m_ok;
+    }
+
+    /**
+     * @brief   Appends the index, flushes the buffered records and closes the file.
+     * @return  @c true if all records were written, else @c false.
+     */
+    bool close()
+    {
+        if (m_ok && !m_closed) writeIndex();
+        m_closed = true;
+        if (m_file)
+        {
+            flush();
+            m_ok &= std::fclose(m_file) == 0;
+            m_file = nullptr;
+        }
+        return m_ok;
+    }
+
+    /**
+     * @brief   Determines whether the file was created and all writes succeeded so far.
+     */
+    bool isOk() const { return m_ok; }
+
+    /**
+     * @brief   Gets the number of objects written.
+     */
+    uint64_t objectsWritten() const { return m_objects; }
+private:
+    struct Pending
+    {
+        uintptr_t address;
+        const CaptureTypeBase* type;
+    };
+
+    struct Key
+    {
+        uintptr_t address;
+        uint32_t typeId;
+
+        bool operator == (const Key& rhs) const 
+        { 
+            return address == rhs.address && typeId == rhs.typeId; 
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator () (const Key& key) const
+        {
+            return std::hash<uintptr_t>{}(key.address ^ 
+                (static_cast<uintptr_t>(key.typeId) << (sizeof(uintptr_t) * 8 - 8)));
+        }
+    };
+
+    static std::size_t alignUp(std::size_t value, std::size_t align)
+    {
+        return (value + align - 1) & ~(align - 1);
+    }
+
+    void writeFileHeader()
+    {
+        CaptureFileHeader header{};
+        std::memcpy(header.magic, kCaptureFileMagic, sizeof(header.magic));
+        header.version     = CaptureFileHeader::kVersion;
+        header.pointerSize = sizeof(void*);
+        m_base = m_out->size();
+        m_out->resize(m_base + sizeof(header));
+        std::memcpy(m_out->data() + m_base, &header, sizeof(header));
+    }
+
+    void writeIndex()
+    {
+        std::sort(m_index.begin(), m_index.end(), 
+            [](const CaptureIndexEntry& a, const CaptureIndexEntry& b)
+            {
+                return a.address != b.address ? a.address < b.address : a.typeId < b.typeId;
+            });
+
+        uint64_t typeCount = m_typeOffsets.size();
+        auto typesSize = (typeCount + 1) * sizeof(uint64_t);
+        auto payload = prepareRecord(CaptureRecordHeader::kIndex, 0, 0, 
+            typesSize + m_index.size() * sizeof(CaptureIndexEntry), 8);
+        uint64_t indexOffset = recordOffset();
+        std::memcpy(payload, &typeCount, sizeof(typeCount));
+        if (typeCount) 
+        {
+            std::memcpy(payload + sizeof(typeCount), m_typeOffsets.data(), 
+                typeCount * sizeof(uint64_t));
+        }
+        if (!m_index.empty())
+        {
+            std::memcpy(payload + typesSize, m_index.data(), 
+                m_index.size() * sizeof(CaptureIndexEntry));
+        }
+
+        payload = prepareRecord(CaptureRecordHeader::kFooter, 0, 0, sizeof(indexOffset), 8);
+        std::memcpy(payload, &indexOffset, sizeof(indexOffset));
+    }
+
+    /**
+     * @internal
+     * @brief   Gets the offset of the last prepared record from the start of the capture.
+     */
+    uint64_t recordOffset() const { return m_flushed + m_recordBegin - m_base; }
+
+    /**
+     * @internal
+     * @brief   Looks up the ID of a type, writing its type record first if new.
+     */
+    uint32_t typeIdOf(const CaptureTypeBase& type)
+    {
+        for (std::size_t i = 0; i < m_types.size(); ++i)
+        {
+            if (m_types[i] == &type) return static_cast<uint32_t>(i);
+        }
+
+        auto id = static_cast<uint32_t>(m_types.size());
+        m_types.push_back(&type);
+
+        CaptureTypeLayout layout{static_cast<uint32_t>(type.m_objSize), 
+            static_cast<uint32_t>(type.m_objAlign), static_cast<uint32_t>(type.m_edges.size()), 
+            static_cast<uint32_t>(type.m_name.size())};
+        auto size = sizeof(layout) + layout.edgeCount * sizeof(uint32_t) + layout.nameLength;
+        auto payload = prepareRecord(CaptureRecordHeader::kType, id, 0, size, 1);
+        m_typeOffsets.push_back(recordOffset());
+        std::memcpy(payload, &layout, sizeof(layout));
+        payload += sizeof(layout);
+        for (const auto& edge : type.m_edges)
+        {
+            std::memcpy(payload, &edge.offset, sizeof(edge.offset));
+            payload += sizeof(edge.offset);
+        }
+        std::memcpy(payload, type.m_name.data(), type.m_name.size());
+        return id;
+    }
+
+    /**
+     * @internal
+     * @brief   Appends a record header and reserves space for the payload.
+     * @return  A pointer to the payload, valid until the next record is prepared.
+     */
+    uint8_t* prepareRecord(uint32_t kind, uint32_t typeId, uintptr_t address, std::size_t size, 
+        std::size_t align)
+    {
+        // Payloads are aligned relative to the start of the capture, so the reader can wrap them
+        // in place. Records are multiples of 8 bytes, requiring no padding for most types.
+        auto maxTotal = alignUp(sizeof(CaptureRecordHeader) + align - 1 + size, 8);
+        if (m_file && m_buffer.size() + maxTotal > m_bufferSize) flush();
+
+        m_recordBegin = m_out->size();
+        auto payloadPos = recordOffset() + sizeof(CaptureRecordHeader);
+        auto padding = alignUp(payloadPos, align) - payloadPos;
+        auto total = alignUp(sizeof(CaptureRecordHeader) + padding + size, 8);
+        m_out->resize(m_recordBegin + total);
+        auto record = m_out->data() + m_recordBegin;
+
+        CaptureRecordHeader header{kind, typeId, static_cast<uint64_t>(address), 
+            static_cast<uint32_t>(size), static_cast<uint32_t>(padding)};
+        std::memcpy(record, &header, sizeof(header));
+        return record + sizeof(header) + padding;
+    }
+
+    void cancelRecord() { m_out->resize(m_recordBegin); }
+private:
+    std::FILE* m_file = nullptr;
+    std::vector<uint8_t> m_buffer;
+    std::vector<uint8_t>* m_out;
+    std::size_t m_bufferSize = 0;
+    std::size_t m_base = 0;
+    std::size_t m_flushed = 0;
+    std::size_t m_recordBegin = 0;
+    bool m_ok = false;
+    bool m_closed = false;
+    uint64_t m_objects = 0;
+    LocalMemoryAccessor m_local;
+    std::vector<const CaptureTypeBase*> m_types;
+    std::vector<uint64_t> m_typeOffsets;
+    std::vector<CaptureIndexEntry> m_index;
+    std::vector<Pending> m_pending;
+    std::unordered_set<Key, KeyHash> m_seen;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [CaptureReader]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A captured type.
+ */
+struct CaptureTypeInfo
+{
+    std::string name;
+    uint32_t objSize;
+    uint32_t objAlign;
+    /// The offsets of the followed pointer fields.
+    std::vector<uint32_t> edgeOffsets;
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Parses the payload of a type record.
+ * @param   payload     The payload.
+ * @param   size        The size of the payload.
+ * @param   pointerSize The size of pointers in captured objects.
+ * @param   type        Receives the type.
+ * @return  @c true if the payload is well-formed, else @c false.
+ */
+inline bool parseCaptureType(const uint8_t* payload, std::size_t size, std::size_t pointerSize,
+    CaptureTypeInfo& type)
+{
+    CaptureTypeLayout layout;
+    if (size < sizeof(layout)) return false;
+    std::memcpy(&layout, payload, sizeof(layout));
+    if (size - sizeof(layout) != layout.edgeCount * sizeof(uint32_t) + layout.nameLength) 
+        return false;
+
+    type.objSize  = layout.objSize;
+    type.objAlign = layout.objAlign;
+    type.edgeOffsets.resize(layout.edgeCount);
+    payload += sizeof(layout);
+    std::memcpy(type.edgeOffsets.data(), payload, layout.edgeCount * sizeof(uint32_t));
+    payload += layout.edgeCount * sizeof(uint32_t);
+    type.name.assign(reinterpret_cast<const char*>(payload), layout.nameLength);
+    for (auto offset : type.edgeOffsets)
+    {
+        if (offset + pointerSize > type.objSize) return false;
+    }
+    return true;
+}
+
+} // namespace internal
+
+/**
+ * @brief   Parses captures, providing access to the captured objects for offline analysis.
+ * 
+ * Object bytes are referenced in place and aligned to their types, so they can be wrapped
+ * directly (see `wrap`). Pointer fields of the wrapped objects hold addresses of the captured 
+ * address space, use `follow` or `find` to resolve them to captured objects.
+ */
+class CaptureReader
+{
+public:
+    using Type = CaptureTypeInfo;
+
+    /**
+     * @brief   A captured object.
+     */
+    struct Object
+    {
+        uint32_t typeId;
+        uint64_t address;
+        const uint8_t* bytes;
+    };
+
+    /**
+     * @brief   Constructor, parsing a capture.
+     * @param   data    The capture, e.g. as read by `readFile`.
+     */
+    explicit CaptureReader(std::vector<uint8_t> data)
+        : m_data{std::move(data)}
+    {
+        m_ok = parse();
+    }
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator = (const CaptureReader&) = delete;
+
+    /**
+     * @brief   Reads a whole capture file.
+     * @param   path    The path of the file.
+     * @param   data    Receives the contents of the file.
+     * @return  @c true if succeeded, else @c false.
+     */
+    static bool readFile(const char* path, std::vector<uint8_t>& data)
+    {
+        auto file = std::fopen(path, "rb");
+        if (!file) return false;
+
+        bool ok = std::fseek(file, 0, SEEK_END) == 0;
+        auto size = ok ? std::ftell(file) : -1;
+        ok = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+        if (ok)
+        {
+            data.resize(static_cast<std::size_t>(size));
+            ok = std::fread(data.data(), 1, data.size(), file) == data.size();
+        }
+        std::fclose(file);
+        return ok;
+    }
+
+    /**
+     * @brief   Determines whether the capture was parsed successfully.
+     * @note    Records preceding a truncated or malformed record are still available.
+     */
+    bool isOk() const { return m_ok; }
+
+    const std::vector<Type>& types() const      { return m_types; }
+    const std::vector<Object>& objects() const  { return m_objects; }
+
+    /**
+     * @brief   Gets the type of an object.
+     * @param   obj The object.
+     * @return  The type.
+     */
+    const Type& typeOf(const Object& obj) const { return m_types[obj.typeId]; }
+
+    /**
+     * @brief   Looks up a type by name.
+     * @param   name    The name of the type.
+     * @return  The ID of the type, or an empty optional if not captured.
+     */
+    zycore::Optional<uint32_t> findType(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < m_types.size(); ++i)
+        {
+            if (m_types[i].name == name) return {zycore::kInPlace, static_cast<uint32_t>(i)};
+        }
+        return zycore::kEmpty;
+    }
+
+    /**
+     * @brief   Looks up a captured object by its address.
+     * @param   address The address of the object in the captured address space.
+     * @param   typeId  The ID of the type, telling apart objects captured at the same address 
+     *                  (e.g. a struct and its first member).
+     * @return  The object, or @c nullptr if not captured.
+     */
+    const Object* find(uint64_t address, uint32_t typeId) const
+    {
+        auto range = m_index.equal_range(address);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (m_objects[it->second].typeId == typeId) return &m_objects[it->second];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief   Looks up a captured object by its address.
+     * @param   address The address of the object in the captured address space.
+     * @return  An object captured at this address, or @c nullptr if not captured.
+     */
+    const Object* find(uint64_t address) const
+    {
+        auto it = m_index.find(address);
+        return it == m_index.end() ? nullptr : &m_objects[it->second];
+    }
+
+    /**
+     * @brief   Follows a pointer field of a captured object.
+     * @param   obj     The object.
+     * @param   edgeIdx The index of the pointer field, in order of `CaptureType::follow` calls.
+     * @return  The object pointed to, or @c nullptr if the pointer is null or wasn't captured.
+     */
+    const Object* follow(const Object& obj, std::size_t edgeIdx) const
+    {
+        uint64_t address = 0;
+        std::memcpy(&address, obj.bytes + typeOf(obj).edgeOffsets[edgeIdx], m_pointerSize);
+        return address ? find(address) : nullptr;
+    }
+
+    /**
+     * @brief   Wraps a captured object.
+     * @tparam  WrapperT    Type of the wrapper.
+     * @param   obj         The object.
+     * @return  The wrapper, valid for the lifetime of the reader.
+     * @warning The object bytes are shared by all wrappers, writes are visible to all of them.
+     */
+    template<typename WrapperT>
+    WrapperT wrap(const Object& obj) const
+    {
+        return wrapper_cast<WrapperT>(static_cast<void*>(const_cast<uint8_t*>(obj.bytes)));
+    }
+private:
+    bool parse()
+    {
+        CaptureFileHeader header;
+        if (m_data.size() < sizeof(header)) return false;
+        std::memcpy(&header, m_data.data(), sizeof(header));
+        if (std::memcmp(header.magic, kCaptureFileMagic, sizeof(header.magic)) != 0
+            || header.version != CaptureFileHeader::kVersion
+            || header.pointerSize > sizeof(uint64_t)) return false;
+        m_pointerSize = header.pointerSize;
+
+        std::size_t pos = sizeof(header);
+        while (pos < m_data.size())
+        {
+            CaptureRecordHeader record;
+            if (m_data.size() - pos < sizeof(record)) return false;
+            std::memcpy(&record, m_data.data() + pos, sizeof(record));
+            auto payloadPos = pos + sizeof(record) + record.padding;
+            if (payloadPos > m_data.size() || m_data.size() - payloadPos < record.size) 
+                return false;
+
+            auto payload = m_data.data() + payloadPos;
+            if (record.kind == CaptureRecordHeader::kType)
+            {
+                Type type;
+                if (record.typeId != m_types.size() 
+                    || !internal::parseCaptureType(payload, record.size, m_pointerSize, type)) 
+                    return false;
+                m_types.push_back(std::move(type));
+            }
+            else if (record.kind == CaptureRecordHeader::kObject)
+            {
+                if (record.typeId >= m_types.size() 
+                    || record.size != m_types[record.typeId].objSize) return false;
+                m_index.emplace(record.address, m_objects.size());
+                m_objects.push_back({record.typeId, record.address, payload});
+            }
+            pos = (payloadPos + record.size + 7) & ~static_cast<std::size_t>(7);
+        }
+        return true;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+    std::vector<Type> m_types;
+    std::vector<Object> m_objects;
+    std::unordered_multimap<uint64_t, std::size_t> m_index;
+    std::size_t m_pointerSize = sizeof(void*);
+    bool m_ok = false;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [MappedCapture]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_MAPPED_FILE
+
+/**
+ * @brief   Maps a capture file, wrapping the captured objects in place.
+ * 
+ * Only the type records and the index of the capture are read on opening, objects are looked 
+ * up in the index by binary search. The file is mapped copy-on-write: when an object is 
+ * resolved, the followed pointer fields of all objects reachable from it are translated from 
+ * captured addresses to the mapped objects, so pointer fields of the regular wrapper 
+ * definitions (e.g. `Field<CustomString*>`) can be dereferenced within the mapping. Pointers to
+ * objects that weren't captured are translated to @c nullptr. Every object is translated once, 
+ * the file itself is never modified.
+ * 
+ * @code
+ *      MappedCapture capture;
+ *      if (!capture.open("world.capture")) return;
+ *      auto world = capture.wrap<World>(worldAddress);
+ *      if (world) std::printf("%d\n", world.value().player->toStrong().health.get());
+ * @endcode
+ * 
+ * @note    Requires a closed capture, written by a writer with the same pointer size. Resolving
+ *          objects modifies the mapping, so it has to be synchronized if used by several 
+ *          threads.
+ */
+class MappedCapture
+{
+public:
+    using Type = CaptureTypeInfo;
+
+    MappedCapture() = default;
+    MappedCapture(const MappedCapture&) = delete;
+    MappedCapture& operator = (const MappedCapture&) = delete;
+
+    /**
+     * @brief   Maps a capture file.
+     * @param   path    The path of the file.
+     * @return  @c true on success, else @c false.
+     */
+    bool open(const char* path)
+    {
+        close();
+        if (m_file.open(path) && parseIndex()) return true;
+        close();
+        return false;
+    }
+
+    /**
+     * @brief   Unmaps the capture, invalidating all resolved objects.
+     */
+    void close()
+    {
+        m_file.close();
+        m_types.clear();
+        m_entries = nullptr;
+        m_count   = 0;
+    }
+
+    /**
+     * @brief   Determines whether a capture is mapped.
+     */
+    bool isOpen() const { return m_file.isOpen(); }
+
+    const std::vector<Type>& types() const { return m_types; }
+
+    /**
+     * @copydoc CaptureReader::findType
+     */
+    zycore::Optional<uint32_t> findType(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < m_types.size(); ++i)
+        {
+            if (m_types[i].name == name) return {zycore::kInPlace, static_cast<uint32_t>(i)};
+        }
+        return zycore::kEmpty;
+    }
+
+    /**
+     * @brief   Gets the number of captured objects.
+     */
+    std::size_t objectCount() const { return m_count; }
+
+    /**
+     * @brief   Gets the index entry of an object.
+     * @param   idx The index of the object, objects are sorted by address.
+     * @return  The entry.
+     */
+    const CaptureIndexEntry& entry(std::size_t idx) const { return m_entries[idx]; }
+
+    /**
+     * @brief   Resolves a captured object, translating the pointers reachable from it.
+     * @param   address The address of the object in the captured address space.
+     * @return  The mapped object, or @c nullptr if not captured.
+     */
+    void* resolve(uint64_t address) { return resolve(lookup(address)); }
+
+    /**
+     * @brief   Resolves a captured object of a specific type.
+     * @param   address The address of the object in the captured address space.
+     * @param   typeId  The ID of the type, telling apart objects captured at the same address.
+     * @return  The mapped object, or @c nullptr if not captured.
+     */
+    void* resolve(uint64_t address, uint32_t typeId)
+    {
+        auto end = m_entries + m_count;
+        for (auto it = lookup(address); it && it != end && it->address == address; ++it)
+        {
+            if (it->typeId == typeId) return resolve(it);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief   Resolves an object in order of addresses.
+     * @param   idx The index of the object.
+     * @return  The mapped object, or @c nullptr if its record is malformed.
+     */
+    void* resolveAt(std::size_t idx) { return resolve(&m_entries[idx]); }
+
+    /**
+     * @brief   Resolves and wraps a captured object.
+     * @tparam  WrapperT    Type of the wrapper.
+     * @param   address     The address of the object in the captured address space.
+     * @return  The wrapper, or an empty optional if not captured.
+     */
+    template<typename WrapperT>
+    zycore::Optional<WrapperT> wrap(uint64_t address)
+    {
+        auto raw = resolve(address);
+        if (!raw) return zycore::kEmpty;
+        return {zycore::kInPlace, wrapper_cast<WrapperT>(raw)};
+    }
+private:
+    /// Marks object records whose pointers were translated, in the private mapping only.
+    static const uint32_t kTranslatedFlag = 0x80000000;
+
+    uint8_t* base() const { return static_cast<uint8_t*>(m_file.data()); }
+
+    /**
+     * @internal
+     * @brief   Validates a record header and locates its payload.
+     * @return  The payload, or @c nullptr if the record exceeds the file or is of another kind.
+     */
+    uint8_t* payloadOf(uint64_t offset, uint32_t kind, CaptureRecordHeader& header) const
+    {
+        if (offset > m_file.size() || m_file.size() - offset < sizeof(header)) return nullptr;
+        std::memcpy(&header, base() + offset, sizeof(header));
+        auto payloadPos = offset + sizeof(header) + header.padding;
+        if ((header.kind & ~kTranslatedFlag) != kind || payloadPos > m_file.size() 
+            || m_file.size() - payloadPos < header.size) return nullptr;
+        return base() + payloadPos;
+    }
+
+    bool parseIndex()
+    {
+        CaptureFileHeader fileHeader;
+        if (m_file.size() < sizeof(fileHeader)) return false;
+        std::memcpy(&fileHeader, base(), sizeof(fileHeader));
+        if (std::memcmp(fileHeader.magic, kCaptureFileMagic, sizeof(fileHeader.magic)) != 0
+            || fileHeader.version != CaptureFileHeader::kVersion
+            || fileHeader.pointerSize != sizeof(void*)) return false;
+
+        // The footer is the last record, 8 bytes of payload.
+        CaptureRecordHeader header;
+        uint64_t indexOffset;
+        auto footerSize = sizeof(header) + sizeof(indexOffset);
+        if (m_file.size() < sizeof(fileHeader) + footerSize) return false;
+        auto footer = payloadOf(m_file.size() - footerSize, CaptureRecordHeader::kFooter, header);
+        if (!footer || header.size != sizeof(indexOffset)) return false;
+        std::memcpy(&indexOffset, footer, sizeof(indexOffset));
+
+        auto index = payloadOf(indexOffset, CaptureRecordHeader::kIndex, header);
+        uint64_t typeCount;
+        if (!index || header.size < sizeof(typeCount)) return false;
+        std::memcpy(&typeCount, index, sizeof(typeCount));
+        if ((header.size - sizeof(typeCount)) / sizeof(uint64_t) < typeCount) return false;
+        auto entriesSize = header.size - (typeCount + 1) * sizeof(uint64_t);
+        if (entriesSize % sizeof(CaptureIndexEntry)) return false;
+
+        for (uint64_t i = 0; i < typeCount; ++i)
+        {
+            uint64_t typeOffset;
+            std::memcpy(&typeOffset, index + (i + 1) * sizeof(uint64_t), sizeof(typeOffset));
+            Type type;
+            auto payload = payloadOf(typeOffset, CaptureRecordHeader::kType, header);
+            if (!payload || !internal::parseCaptureType(payload, header.size, sizeof(void*), type))
+                return false;
+            m_types.push_back(std::move(type));
+        }
+
+        m_entries = reinterpret_cast<const CaptureIndexEntry*>(
+            index + (typeCount + 1) * sizeof(uint64_t));
+        m_count = entriesSize / sizeof(CaptureIndexEntry);
+        return true;
+    }
+
+    /**
+     * @internal
+     * @brief   Locates the payload of an object record.
+     * @return  The payload, or @c nullptr if the record is malformed.
+     */
+    uint8_t* objectOf(const CaptureIndexEntry& entry, CaptureRecordHeader& header) const
+    {
+        auto payload = payloadOf(entry.recordOffset, CaptureRecordHeader::kObject, header);
+        if (!payload || entry.typeId >= m_types.size() 
+            || header.size != m_types[entry.typeId].objSize) return nullptr;
+        return payload;
+    }
+
+    /**
+     * @internal
+     * @brief   Looks up the first object captured at an address.
+     * @return  The entry, or @c nullptr if not captured.
+     */
+    const CaptureIndexEntry* lookup(uint64_t address) const
+    {
+        auto it = std::lower_bound(m_entries, m_entries + m_count, address, 
+            [](const CaptureIndexEntry& entry, uint64_t addr) { return entry.address < addr; });
+        return it != m_entries + m_count && it->address == address ? it : nullptr;
+    }
+
+    /**
+     * @internal
+     * @brief   Translates the pointers of an object and of all untranslated objects reachable 
+     *          from it.
+     * @return  The payload of the object, or @c nullptr if @p entry is null or malformed.
+     */
+    void* resolve(const CaptureIndexEntry* entry)
+    {
+        CaptureRecordHeader header;
+        auto object = entry ? objectOf(*entry, header) : nullptr;
+        if (!object || (header.kind & kTranslatedFlag)) return object;
+
+        m_pending.clear();
+        m_pending.push_back(entry);
+        while (!m_pending.empty())
+        {
+            auto cur = m_pending.back();
+            m_pending.pop_back();
+            auto bytes = objectOf(*cur, header);
+            if (!bytes || (header.kind & kTranslatedFlag)) continue;
+            header.kind |= kTranslatedFlag;
+            std::memcpy(base() + cur->recordOffset, &header.kind, sizeof(header.kind));
+
+            for (auto offset : m_types[cur->typeId].edgeOffsets)
+            {
+                uint64_t address = 0;
+                std::memcpy(&address, bytes + offset, sizeof(void*));
+                auto target = address ? lookup(address) : nullptr;
+                CaptureRecordHeader targetHeader;
+                void* local = target ? objectOf(*target, targetHeader) : nullptr;
+                std::memcpy(bytes + offset, &local, sizeof(local));
+                if (local) m_pending.push_back(target);
+            }
+        }
+        return object;
+    }
+private:
+    platform::MappedFile m_file;
+    std::vector<Type> m_types;
+    const CaptureIndexEntry* m_entries = nullptr;
+    std::size_t m_count = 0;
+    std::vector<const CaptureIndexEntry*> m_pending;
+};
+
+#endif // REMODEL_HAS_MAPPED_FILE
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_CAPTURE_HPP
@@ -0,0 +1,313 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_COLUMNCACHE_HPP
+#define REMODEL_COLUMNCACHE_HPP
+
+/**     
+ * @file
+ * @brief Contains dense column mirrors of hot fields of many wrapped objects.
+ *        
+ * `gatherFields` copies every selected field on every call. A `ColumnCache` instead keeps its 
+ * columns between ticks and, on refresh, only copies the fields of objects that changed since 
+ * the previous refresh, as detected by a `WatchSet` over the mirrored bytes of each object.
+ *        
+ * @code
+ *      auto cache = mirrorFields(&Entity::health, &Entity::id);
+ *      cache.assign(WrapperSpan<Entity>{world->entities, world->numEntities});
+ *      for (;;)
+ *      {
+ *          cache.refresh();
+ *          analyze(cache.column<0>(), cache.column<1>(), cache.size());
+ *      }
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+#include "Watch.hpp"
+#include "WrapperSpan.hpp"
+#include "InstanceScan.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [ColumnCache]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Structure-of-arrays mirror of selected fields of a set of objects.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldsT     Types of the mirrored fields, members of the wrapper.
+ *          
+ * Row `i` of every column holds the field of the `i`-th assigned object. Only the range from the
+ * first to the end of the last mirrored field of every object is watched, so changes to other 
+ * fields are not reported. The columns reflect the values as of the last refresh.
+ * @note    The fields are required to be located at the same offset in every object (as it is 
+ *          the case with offset-based fields and `StaticField`s). They are resolved by wrapping 
+ *          the first object once.
+ */
+template<typename WrapperT, typename... FieldsT>
+class ColumnCache
+{
+    static_assert(sizeof...(FieldsT) > 0, "at least one field is required");
+    static const std::size_t kFieldCount = sizeof...(FieldsT);
+    using Types = std::tuple<typename FieldsT::RewrittenT...>;
+public:
+    /**
+     * @brief   The type of the values of a column.
+     * @tparam  idxT    The index of the column.
+     */
+    template<std::size_t idxT>
+    using ColumnType = std::tuple_element_t<idxT, Types>;
+
+    /**
+     * @brief   Constructor.
+     * @param   fields  Pointers to the field members, e.g. `&Entity::health`.
+     */
+    explicit ColumnCache(FieldsT WrapperT::*... fields)
+        : m_fields{fields...}
+    {}
+
+    /**
+     * @brief   Sets the placement of the columns allocated by subsequent `assign` calls.
+     * @param   policy  The policy, e.g. huge pages for caches of millions of rows. The memory is
+     *                  faulted in by the thread calling `assign` if NUMA-local.
+     */
+    void setPagePolicy(platform::PagePolicy policy) { m_pagePolicy = policy; }
+
+    /**
+     * @brief   Mirrors the objects of a span, replacing the previous objects.
+     * @param   span    The span.
+     */
+    void assign(const WrapperSpan<WrapperT>& span)
+    {
+        std::vector<void*> objects(span.size());
+        for (std::size_t i = 0; i < objects.size(); ++i) objects[i] = span.data() + i;
+        assign(std::move(objects));
+    }
+
+    /**
+     * @brief   Mirrors the objects of an instance set, replacing the previous objects.
+     * @param   set The instance set.
+     */
+    void assign(const InstanceSet<WrapperT>& set)
+    {
+        assign(std::vector<void*>(set.data(), set.data() + set.size()));
+    }
+
+    /**
+     * @brief   Mirrors objects, replacing the previous objects.
+     * @param   objects The raw pointers of the objects, one per row.
+     */
+    void assign(std::vector<void*> objects)
+    {
+        m_objects = std::move(objects);
+        m_watches.clear();
+        m_changed.clear();
+        resizeColumns(std::index_sequence_for<FieldsT...>{});
+        if (m_objects.empty()) return;
+
+        resolve(m_objects.front(), std::index_sequence_for<FieldsT...>{});
+        std::vector<const void*> ranges(m_objects.size());
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            ranges[i] = static_cast<const uint8_t*>(m_objects[i]) + m_begin;
+        }
+        m_watches.watchRanges(ranges.data(), ranges.size(), m_size);
+
+        for (std::size_t i = 0; i < m_objects.size(); ++i) copyRow(i);
+    }
+
+    /**
+     * @brief   Enables skipping objects on pages not written since the last refresh.
+     * @return  @c true if supported by the platform, else @c false.
+     * @see     WatchSet::enablePageTracking
+     */
+    bool enablePageTracking() { return m_watches.enablePageTracking(); }
+
+    /**
+     * @brief   Updates the rows of all objects whose mirrored fields changed.
+     * @return  The number of updated rows.
+     */
+    std::size_t refresh()
+    {
+        m_watches.poll(m_changed);
+        for (auto row : m_changed) copyRow(row);
+        return m_changed.size();
+    }
+
+    /**
+     * @brief   Gets the rows updated by the last refresh, in ascending order.
+     */
+    const std::vector<std::size_t>& changedRows() const { return m_changed; }
+
+    /**
+     * @brief   Gets the number of rows.
+     */
+    std::size_t size() const { return m_objects.size(); }
+
+    /**
+     * @brief   Gets the raw pointer of the object of a row.
+     * @param   row The row.
+     */
+    void* object(std::size_t row) const { return m_objects[row]; }
+
+    /**
+     * @brief   Gets a column.
+     * @tparam  idxT    The index of the column, in order of the fields passed on construction.
+     * @return  Pointer to the first of `size()` values.
+     */
+    template<std::size_t idxT>
+    const ColumnType<idxT>* column() const 
+    { 
+        return m_objects.empty() ? nullptr : columnData<idxT>();
+    }
+
+    /**
+     * @brief   Gets the column of a field.
+     * @tparam  FieldT  Type of the field.
+     * @param   field   Pointer to the field member, as passed on construction.
+     * @return  Pointer to the first of `size()` values, @c nullptr if the field isn't mirrored
+     *          (or no objects are assigned).
+     */
+    template<typename FieldT>
+    const typename FieldT::RewrittenT* columnOf(FieldT WrapperT::* field) const
+    {
+        const typename FieldT::RewrittenT* result = nullptr;
+        findColumn(field, result, std::index_sequence_for<FieldsT...>{});
+        return result;
+    }
+private:
+    template<typename FieldT, typename ResultT, std::size_t... idxs>
+    void findColumn(FieldT WrapperT::* field, ResultT& result, std::index_sequence<idxs...>) const
+    {
+        (void)std::initializer_list<int>{(matchColumn<idxs>(field, result, std::is_same<
+            std::tuple_element_t<idxs, std::tuple<FieldsT...>>, FieldT>{}), 0)...};
+    }
+
+    template<std::size_t idxT, typename FieldT, typename ResultT>
+    void matchColumn(FieldT WrapperT::* field, ResultT& result, std::true_type) const
+    {
+        if (!result && std::get<idxT>(m_fields) == field) result = column<idxT>();
+    }
+
+    template<std::size_t idxT, typename FieldT, typename ResultT>
+    void matchColumn(FieldT WrapperT::*, ResultT&, std::false_type) const {}
+
+    template<std::size_t idxT>
+    ColumnType<idxT>* columnData() const 
+    {
+        return reinterpret_cast<ColumnType<idxT>*>(
+            static_cast<uint8_t*>(m_storage.data()) + m_columnOffs[idxT]);
+    }
+
+    template<std::size_t... idxs>
+    void resizeColumns(std::index_sequence<idxs...>)
+    {
+        // All columns share one zeroed buffer, each starting on its own cache line.
+        const std::size_t kLine = 64;
+        const std::size_t sizes[] = {sizeof(ColumnType<idxs>) * m_objects.size()...};
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < kFieldCount; ++i)
+        {
+            m_columnOffs[i] = total;
+            total += (sizes[i] + kLine - 1) / kLine * kLine;
+        }
+        m_storage = platform::PageBuffer{};
+        if (!m_objects.empty()) m_storage = platform::PageBuffer{total, m_pagePolicy};
+    }
+
+    template<std::size_t... idxs>
+    void resolve(void* first, std::index_sequence<idxs...>)
+    {
+        auto wrapper = wrapper_cast<WrapperT>(first);
+        auto base    = static_cast<const uint8_t*>(first);
+        std::array<std::ptrdiff_t, kFieldCount> offsets{{reinterpret_cast<const uint8_t*>(
+            (wrapper.*std::get<idxs>(m_fields)).addressOfObj()) - base...}};
+        std::array<std::ptrdiff_t, kFieldCount> ends{{
+            offsets[idxs] + static_cast<std::ptrdiff_t>(sizeof(ColumnType<idxs>))...}};
+
+        m_begin = *std::min_element(offsets.begin(), offsets.end());
+        m_size  = static_cast<std::size_t>(*std::max_element(ends.begin(), ends.end()) - m_begin);
+        for (std::size_t i = 0; i < kFieldCount; ++i) m_offsets[i] = offsets[i] - m_begin;
+    }
+
+    void copyRow(std::size_t row)
+    {
+        // The shadow holds the bytes compared by the last poll, reading them instead of the 
+        // object keeps the row consistent with the change detection.
+        copyRow(row, static_cast<const uint8_t*>(m_watches.shadow(row)), 
+            std::index_sequence_for<FieldsT...>{});
+    }
+
+    template<std::size_t... idxs>
+    void copyRow(std::size_t row, const uint8_t* bytes, std::index_sequence<idxs...>)
+    {
+        (void)std::initializer_list<int>{(std::memcpy(columnData<idxs>() + row, 
+            bytes + m_offsets[idxs], sizeof(ColumnType<idxs>)), 0)...};
+    }
+private:
+    std::tuple<FieldsT WrapperT::*...> m_fields;
+    /// Plain arrays rather than vectors, which would pack `bool` columns into bits.
+    platform::PageBuffer m_storage;
+    platform::PagePolicy m_pagePolicy;
+    std::array<std::size_t, kFieldCount> m_columnOffs{};
+    std::array<std::ptrdiff_t, kFieldCount> m_offsets{};
+    std::ptrdiff_t m_begin = 0;
+    std::size_t m_size = 0;
+    std::vector<void*> m_objects;
+    std::vector<std::size_t> m_changed;
+    WatchSet m_watches;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [mirrorFields]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Creates a column cache mirroring fields of a wrapper.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldsT     Types of the fields.
+ * @param   fields      Pointers to the field members, e.g. `&Entity::health`.
+ * @return  The column cache, without any objects assigned.
+ */
+template<typename WrapperT, typename... FieldsT>
+inline ColumnCache<WrapperT, FieldsT...> mirrorFields(FieldsT WrapperT::*... fields)
+{
+    return ColumnCache<WrapperT, FieldsT...>{fields...};
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_COLUMNCACHE_HPP
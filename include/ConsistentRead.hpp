@@ -0,0 +1,499 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_CONSISTENTREAD_HPP
+#define REMODEL_CONSISTENTREAD_HPP
+
+/**     
+ * @file
+ * @brief Contains lock-free consistent reads of objects other threads are modifying.
+ *        
+ * Reading multiple fields of an object the game thread is mutating one by one can combine 
+ * values of different frames. The functions here copy a whole object or a set of fields and 
+ * retry until the copy is consistent, validated either by a version field of the object 
+ * (seqlock style) or by reading the memory a second time and comparing. The writer is never 
+ * blocked or even aware of the reader.
+ *
+ * @code
+ *      float x, y;
+ *      if (consistentRead(player, versionedBy(player.revision), 
+ *          consistentInto(&Player::x, x), consistentInto(&Player::y, y)))
+ *      {
+ *          draw(x, y);
+ *      }
+ *      
+ *      Player::Compact copy;
+ *      consistentCopy(player, copy.addressOfObj());
+ * @endcode
+ * 
+ * Comparing can't detect a field changing and changing back between two reads (ABA), which is 
+ * harmless unless that is meaningful together with the other fields. Version fields can.
+ * 
+ * For bulk dumps, `FrozenReads` suspends all other threads instead. While it is active, the 
+ * reads of the freezing thread copy once without validating or retrying.
+ */
+
+#include "Remodel.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+namespace remodel
+{
+
+/**
+ * @brief   The default number of attempts of a consistent read before giving up.
+ */
+const unsigned kConsistentReadAttempts = 4096;
+
+/**
+ * @brief   The meaning of version fields.
+ */
+enum class VersionKind
+{
+    /// Odd while the writer is updating the object, incremented before and after (seqlock).
+    SeqLock,
+    /// Changed on every update, without marking updates in progress.
+    Counter,
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [Consistent read guards]                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Whether the calling thread has frozen all others using `FrozenReads`.
+ */
+inline bool& readsFrozen()
+{
+    static thread_local bool frozen = false;
+    return frozen;
+}
+
+/**
+ * @internal
+ * @brief   A range of memory copied by a consistent read.
+ */
+struct ConsistentRange
+{
+    const void* src;
+    void*       dst;
+    std::size_t size;
+};
+
+/**
+ * @internal
+ * @brief   Guard validating a copy by comparing it with the source.
+ *          
+ * Every field was unchanged from its copy until its comparison, including the time the last 
+ * field was copied, so (except for ABA) all copies held their values at that point.
+ */
+struct DoubleReadGuard
+{
+    bool begin(uint64_t& /*token*/) const { return true; }
+
+    bool validate(uint64_t /*token*/, const ConsistentRange* ranges, std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (std::memcmp(ranges[i].src, ranges[i].dst, ranges[i].size)) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * @internal
+ * @brief   Guard validating a copy using a version field.
+ * @tparam  T   The type of the version, an integer.
+ */
+template<typename T>
+class VersionGuard
+{
+    static_assert(std::is_integral<T>::value, "versions have to be integers");
+public:
+    VersionGuard(const T* version, VersionKind kind)
+        : m_version{version}
+        , m_kind{kind}
+    {}
+
+    bool begin(uint64_t& token) const
+    {
+        auto version = load();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        token = static_cast<uint64_t>(version);
+        return m_kind != VersionKind::SeqLock || !(version & 1);
+    }
+
+    bool validate(uint64_t token, const ConsistentRange*, std::size_t) const
+    {
+        return static_cast<uint64_t>(load()) == token;
+    }
+private:
+    T load() const { return *static_cast<const volatile T*>(m_version); }
+private:
+    const T* m_version;
+    VersionKind m_kind;
+};
+
+/**
+ * @internal
+ * @brief   Copies ranges until a guard validates the copy.
+ */
+template<typename GuardT>
+inline bool readConsistent(const ConsistentRange* ranges, std::size_t count, 
+    const GuardT& guard, unsigned maxAttempts)
+{
+    // Nothing else runs, a single copy is consistent. A seqlock held by a suspended writer 
+    // stays held until the threads are thawed.
+    if (readsFrozen())
+    {
+        uint64_t token;
+        if (!guard.begin(token)) return false;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(ranges[i].dst, ranges[i].src, ranges[i].size);
+        }
+        return true;
+    }
+
+    for (unsigned attempt = 0; attempt < maxAttempts; ++attempt)
+    {
+        uint64_t token;
+        if (guard.begin(token))
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::memcpy(ranges[i].dst, ranges[i].src, ranges[i].size);
+            }
+            // Keeps the validating loads behind the copies.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (guard.validate(token, ranges, count)) return true;
+        }
+        if ((attempt & 0x3F) == 0x3F) std::this_thread::yield();
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [ConsistentTarget]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   A field of a wrapper paired with the variable it is read into.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ */
+template<typename WrapperT, typename FieldT>
+class MemberConsistentTarget
+{
+public:
+    using Type = typename FieldT::RewrittenT;
+
+    MemberConsistentTarget(FieldT WrapperT::* field, Type& out)
+        : m_field{field}
+        , m_out{std::addressof(out)}
+    {}
+
+    ConsistentRange range(const WrapperT& wrapper) const
+    {
+        return {(wrapper.*m_field).addressOfObj(), m_out, sizeof(Type)};
+    }
+private:
+    FieldT WrapperT::* m_field;
+    Type* m_out;
+};
+
+/**
+ * @internal
+ * @brief   A field described by a `FieldDesc` paired with the variable it is read into.
+ * @tparam  T       The type of the field.
+ * @tparam  offsT   The offset of the field inside of the wrapped object, in bytes.
+ */
+template<typename T, std::ptrdiff_t offsT>
+class DescConsistentTarget
+{
+    static_assert(!FieldDesc<T, offsT>::kDoExtraDref, 
+        "reference fields can't be read consistently");
+public:
+    using Type = typename FieldDesc<T, offsT>::Type;
+
+    explicit DescConsistentTarget(Type& out)
+        : m_out{std::addressof(out)}
+    {}
+
+    template<typename WrapperT>
+    ConsistentRange range(const WrapperT& wrapper) const
+    {
+        return {static_cast<const uint8_t*>(wrapper.addressOfObj()) + offsT, m_out, sizeof(Type)};
+    }
+private:
+    Type* m_out;
+};
+
+} // namespace internal
+
+/**
+ * @brief   Creates a version guard for `consistentRead` and `consistentCopy`.
+ * @tparam  FieldT  Type of the version field.
+ * @param   version The version field of the wrapper the read operates on.
+ * @param   kind    The meaning of the version.
+ * @return  The guard.
+ */
+template<typename FieldT>
+inline internal::VersionGuard<typename FieldT::RewrittenT> versionedBy(const FieldT& version, 
+    VersionKind kind = VersionKind::SeqLock)
+{
+    return {static_cast<const typename FieldT::RewrittenT*>(version.addressOfObj()), kind};
+}
+
+/**
+ * @brief   Creates a target reading a field member of a wrapper, for `consistentRead`.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ * @param   field       Pointer to the field member, e.g. `&Player::health`.
+ * @param   out         The variable to read into.
+ * @return  The target.
+ */
+template<typename WrapperT, typename FieldT>
+inline internal::MemberConsistentTarget<WrapperT, FieldT> 
+consistentInto(FieldT WrapperT::* field, typename FieldT::RewrittenT& out)
+{
+    return {field, out};
+}
+
+/**
+ * @brief   Creates a target reading a field described by a `FieldDesc`, for `consistentRead`.
+ * @tparam  T       The type of the field.
+ * @tparam  offsT   The offset of the field inside of the wrapped object, in bytes.
+ * @param   desc    The field descriptor.
+ * @param   out     The variable to read into.
+ * @return  The target.
+ */
+template<typename T, std::ptrdiff_t offsT>
+inline internal::DescConsistentTarget<T, offsT> 
+consistentInto(FieldDesc<T, offsT> /*desc*/, typename FieldDesc<T, offsT>::Type& out)
+{
+    return internal::DescConsistentTarget<T, offsT>{out};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [consistentRead]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Reads a set of fields of an object consistently, validated using a version field.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  VersionT    The type of the version.
+ * @tparam  TargetsT    The target types.
+ * @param   wrapper     The wrapper of the object.
+ * @param   guard       The version guard created using `versionedBy`.
+ * @param   targets     The targets created using `consistentInto`.
+ * @return  @c true if the values were read consistently within `kConsistentReadAttempts` 
+ *          attempts, else @c false, leaving the variables in an undefined state.
+ */
+template<typename WrapperT, typename VersionT, typename... TargetsT>
+inline bool consistentRead(const WrapperT& wrapper, internal::VersionGuard<VersionT> guard, 
+    TargetsT... targets)
+{
+    static_assert(sizeof...(TargetsT) > 0, "no fields to read");
+    const internal::ConsistentRange ranges[] = {targets.range(wrapper)...};
+    return internal::readConsistent(ranges, sizeof...(TargetsT), guard, kConsistentReadAttempts);
+}
+
+/**
+ * @brief   Reads a set of fields of an object consistently, validated by comparison.
+ * @copydetails consistentRead(const WrapperT&, internal::VersionGuard<VersionT>, TargetsT...)
+ */
+template<typename WrapperT, typename... TargetsT>
+inline bool consistentRead(const WrapperT& wrapper, TargetsT... targets)
+{
+    static_assert(sizeof...(TargetsT) > 0, "no fields to read");
+    const internal::ConsistentRange ranges[] = {targets.range(wrapper)...};
+    return internal::readConsistent(ranges, sizeof...(TargetsT), internal::DoubleReadGuard{}, 
+        kConsistentReadAttempts);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [consistentCopy]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Copies a whole object consistently, validated using a version field.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @tparam  VersionT    The type of the version.
+ * @param   wrapper     The wrapper of the object.
+ * @param   guard       The version guard created using `versionedBy`.
+ * @param   out         Buffer of `WrapperT::kObjSize` bytes, e.g. of a `WrapperT::Compact`.
+ * @param   maxAttempts The number of attempts before giving up.
+ * @return  @c true if the object was copied consistently, else @c false.
+ */
+template<typename WrapperT, typename VersionT>
+inline bool consistentCopy(const WrapperT& wrapper, internal::VersionGuard<VersionT> guard, 
+    void* out, unsigned maxAttempts = kConsistentReadAttempts)
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "consistentCopy requires usage of AdvancedClassWrapper as base");
+
+    const internal::ConsistentRange range{wrapper.addressOfObj(), out, WrapperT::kObjSize};
+    return internal::readConsistent(&range, 1, guard, maxAttempts);
+}
+
+/**
+ * @brief   Copies a whole object consistently, validated by comparison.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @param   wrapper     The wrapper of the object.
+ * @param   out         Buffer of `WrapperT::kObjSize` bytes, e.g. of a `WrapperT::Compact`.
+ * @param   maxAttempts The number of attempts before giving up.
+ * @return  @c true if the object was copied consistently, else @c false.
+ */
+template<typename WrapperT>
+inline bool consistentCopy(const WrapperT& wrapper, void* out, 
+    unsigned maxAttempts = kConsistentReadAttempts)
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "consistentCopy requires usage of AdvancedClassWrapper as base");
+
+    const internal::ConsistentRange range{wrapper.addressOfObj(), out, WrapperT::kObjSize};
+    return internal::readConsistent(&range, 1, internal::DoubleReadGuard{}, maxAttempts);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [FrozenReads]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_THREAD_FREEZE
+
+/**
+ * @brief   Suspends all other threads for consistent bulk reads, with a bounded freeze window.
+ *          
+ * While frozen, `consistentRead` and `consistentCopy` on the freezing thread copy once instead 
+ * of validating and retrying. Long dumps call `checkpoint` between objects: once the window 
+ * has elapsed, the threads are resumed briefly and frozen again, so the target never stalls 
+ * longer than the window. Reads are consistent per object, not across checkpoints.
+ * 
+ * A writer may be suspended in the middle of an update. Version guards detect this (a held 
+ * seqlock fails the read right away), comparison can't, it sees the half-written object.
+ * 
+ * @code
+ *      FrozenReads frozen{std::chrono::milliseconds{2}};
+ *      if (!frozen.freeze()) return;
+ *      for (auto& entity : entities)
+ *      {
+ *          frozen.checkpoint();
+ *          consistentCopy(entity, dump.next());
+ *      }
+ * @endcode
+ * 
+ * The restrictions of `platform::ThreadFreeze` apply: no allocating or locking while frozen.
+ */
+class FrozenReads
+{
+    platform::ThreadFreeze m_freeze;
+    std::chrono::steady_clock::duration m_window;
+    std::chrono::steady_clock::time_point m_deadline;
+    std::size_t m_refreezes = 0;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   window  The longest time threads are kept suspended at once.
+     */
+    explicit FrozenReads(std::chrono::steady_clock::duration window = std::chrono::milliseconds{5})
+        : m_window{window}
+    {}
+
+    FrozenReads(const FrozenReads&) = delete;
+    FrozenReads& operator = (const FrozenReads&) = delete;
+
+    /**
+     * @brief   Destructor resuming the threads.
+     */
+    ~FrozenReads() { thaw(); }
+
+    /**
+     * @brief   Suspends all threads but the calling one and enables unvalidated reads.
+     * @return  @c true on success (or if already frozen), else @c false.
+     */
+    bool freeze()
+    {
+        if (m_freeze.isFrozen()) return true;
+        if (!m_freeze.freeze()) return false;
+        m_deadline = std::chrono::steady_clock::now() + m_window;
+        internal::readsFrozen() = true;
+        return true;
+    }
+
+    /**
+     * @brief   Resumes the threads and disables unvalidated reads.
+     */
+    void thaw()
+    {
+        if (!m_freeze.isFrozen()) return;
+        internal::readsFrozen() = false;
+        m_freeze.thaw();
+    }
+
+    /**
+     * @brief   Resumes and refreezes the threads if the window has elapsed.
+     * @return  @c true if the threads are frozen afterwards, else @c false (refreezing failed).
+     */
+    bool checkpoint()
+    {
+        if (!m_freeze.isFrozen()) return false;
+        if (std::chrono::steady_clock::now() < m_deadline) return true;
+        thaw();
+        std::this_thread::yield();
+        ++m_refreezes;
+        return freeze();
+    }
+
+    /**
+     * @brief   Determines whether threads are currently suspended.
+     */
+    bool isFrozen() const { return m_freeze.isFrozen(); }
+
+    /**
+     * @brief   The number of times `checkpoint` resumed the threads.
+     */
+    std::size_t refreezes() const { return m_refreezes; }
+};
+
+#endif // ifdef REMODEL_HAS_THREAD_FREEZE
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_CONSISTENTREAD_HPP
@@ -0,0 +1,353 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_DIFF_HPP
+#define REMODEL_DIFF_HPP
+
+/**     
+ * @file
+ * @brief Contains whole-object comparison and copying of wrapped objects.
+ *        
+ * `ObjectDiff` compares two objects of a wrapper type as byte ranges, using SIMD, instead of 
+ * going through the `Field` operators one by one. The declared fields are only used to map 
+ * differing bytes back to fields and to exclude fields from comparisons and copies.
+ *
+ * @code
+ *      ObjectDiff<Entity> diff{&Entity::health, &Entity::position, Entity::lastSeen};
+ *      diff.ignore(2); // timestamps change every tick
+ *      
+ *      std::vector<std::size_t> changed;
+ *      if (diff.changedFields(previous, current, changed)) { ... }
+ *      diff.copy(previous, current);
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define REMODEL_DIFF_SSE2
+#endif
+
+namespace remodel
+{
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Byte-range kernels]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Compares two byte ranges under a mask.
+ * @param   a       The first range.
+ * @param   b       The second range.
+ * @param   mask    Per-byte mask, @c 0xFF for bytes to compare, zero for ignored bytes.
+ * @param   size    The size of the ranges, in bytes.
+ * @param   bits    Receives a bit per byte set for differing bytes, `(size + 63) / 64` words. 
+ *                  If @c nullptr, the comparison stops at the first difference.
+ * @return  @c true if any compared byte differs.
+ */
+inline bool diffBytes(const uint8_t* a, const uint8_t* b, const uint8_t* mask, std::size_t size, 
+    uint64_t* bits)
+{
+    if (bits) std::memset(bits, 0, (size + 63) / 64 * sizeof(uint64_t));
+
+    bool any = false;
+    std::size_t i = 0;
+#   ifdef REMODEL_DIFF_SSE2
+        for (; i + 16 <= size; i += 16)
+        {
+            auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            auto vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+            auto differing = _mm_andnot_si128(_mm_cmpeq_epi8(va, vb), vm);
+            auto lanes = static_cast<uint64_t>(_mm_movemask_epi8(differing));
+            if (!lanes) continue;
+            if (!bits) return true;
+            bits[i / 64] |= lanes << (i % 64);
+            any = true;
+        }
+#   endif
+    for (; i < size; ++i)
+    {
+        if (!((a[i] ^ b[i]) & mask[i])) continue;
+        if (!bits) return true;
+        bits[i / 64] |= uint64_t{1} << (i % 64);
+        any = true;
+    }
+    return any;
+}
+
+/**
+ * @internal
+ * @brief   Copies the bytes selected by a mask, leaving the others untouched.
+ * @param   dst     The destination.
+ * @param   src     The source.
+ * @param   mask    Per-byte mask, @c 0xFF for bytes to copy, zero for bytes to keep.
+ * @param   size    The size of the ranges, in bytes.
+ */
+inline void copyMaskedBytes(uint8_t* dst, const uint8_t* src, const uint8_t* mask, 
+    std::size_t size)
+{
+    std::size_t i = 0;
+#   ifdef REMODEL_DIFF_SSE2
+        for (; i + 16 <= size; i += 16)
+        {
+            auto vd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            auto vs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            auto vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+            auto blended = _mm_or_si128(_mm_and_si128(vm, vs), _mm_andnot_si128(vm, vd));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), blended);
+        }
+#   endif
+    for (; i < size; ++i)
+    {
+        dst[i] = static_cast<uint8_t>((src[i] & mask[i]) | (dst[i] & ~mask[i]));
+    }
+}
+
+/**
+ * @internal
+ * @brief   Determines whether any bit of a range is set.
+ * @param   bits    The bitmap.
+ * @param   begin   The first bit.
+ * @param   count   The number of bits.
+ */
+inline bool anyBitSet(const uint64_t* bits, std::size_t begin, std::size_t count)
+{
+    while (count)
+    {
+        auto shift = begin % 64;
+        auto width = count < 64 - shift ? count : 64 - shift;
+        auto word  = bits[begin / 64] >> shift;
+        if (width < 64) word &= (uint64_t{1} << width) - 1;
+        if (word) return true;
+        begin += width;
+        count -= width;
+    }
+    return false;
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [ObjectDiff]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Compares and copies objects of a wrapper type as a whole.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ *                      
+ * The declared fields are resolved to byte ranges once, on construction. Fields are given as 
+ * pointers to field members (e.g. `&Entity::health`, resolved by wrapping a scratch object, so 
+ * they have to be located at the same offset in every object) or as `FieldDesc`s. Reference 
+ * fields are only supported as `FieldDesc`s, comparing the pointer.
+ */
+template<typename WrapperT>
+class ObjectDiff
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "ObjectDiff requires usage of AdvancedClassWrapper as base");
+public:
+    static const std::size_t kObjSize = WrapperT::kObjSize;
+private:
+    struct Range
+    {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    static const std::size_t kBitWords = (kObjSize + 63) / 64;
+
+    std::vector<Range>   m_fields;
+    std::vector<bool>    m_ignored;
+    std::vector<uint8_t> m_mask;
+    bool                 m_maskAll = true;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   fields  The fields to report changes for, in order of their indices.
+     */
+    template<typename... FieldsT>
+    explicit ObjectDiff(FieldsT... fields)
+        : m_mask(kObjSize, 0xFF)
+    {
+        alignas(16) uint8_t scratch[kObjSize];
+        auto wrapper = wrapper_cast<WrapperT>(static_cast<void*>(scratch));
+        (void)std::initializer_list<int>{(addField(wrapper, scratch, fields), 0)...};
+        m_ignored.resize(m_fields.size(), false);
+    }
+
+    /**
+     * @brief   Gets the number of declared fields.
+     */
+    std::size_t fieldCount() const { return m_fields.size(); }
+
+    /**
+     * @brief   Gets the offset of a declared field, in bytes.
+     */
+    std::size_t fieldOffset(std::size_t fieldIdx) const { return m_fields[fieldIdx].offset; }
+
+    /**
+     * @brief   Gets the size of a declared field, in bytes.
+     */
+    std::size_t fieldSize(std::size_t fieldIdx) const { return m_fields[fieldIdx].size; }
+
+    /**
+     * @brief   Excludes a field from comparisons and copies.
+     * @param   fieldIdx    The index of the field.
+     */
+    void ignore(std::size_t fieldIdx)
+    {
+        m_ignored[fieldIdx] = true;
+        rebuildMask();
+    }
+
+    /**
+     * @brief   Includes a previously ignored field again.
+     * @param   fieldIdx    The index of the field.
+     */
+    void include(std::size_t fieldIdx)
+    {
+        m_ignored[fieldIdx] = false;
+        rebuildMask();
+    }
+
+    /**
+     * @brief   Determines whether a field is ignored.
+     */
+    bool isIgnored(std::size_t fieldIdx) const { return m_ignored[fieldIdx]; }
+
+    /**
+     * @brief   Compares two objects, ignoring the bytes of ignored fields.
+     * @return  @c true if equal, else @c false.
+     */
+    bool equal(const void* a, const void* b) const
+    {
+        if (m_maskAll) return std::memcmp(a, b, kObjSize) == 0;
+        return !internal::diffBytes(static_cast<const uint8_t*>(a), 
+            static_cast<const uint8_t*>(b), m_mask.data(), kObjSize, nullptr);
+    }
+
+    /**
+     * @copydoc equal(const void*, const void*) const
+     */
+    bool equal(const WrapperT& a, const WrapperT& b) const
+    {
+        return equal(a.addressOfObj(), b.addressOfObj());
+    }
+
+    /**
+     * @brief   Determines the declared fields that differ between two objects.
+     * @param   a       The first object.
+     * @param   b       The second object.
+     * @param   changed Receives the indices of the differing fields (in ascending order).
+     * @return  The number of differing fields.
+     */
+    std::size_t changedFields(const void* a, const void* b, std::vector<std::size_t>& changed) const
+    {
+        changed.clear();
+        uint64_t bits[kBitWords];
+        if (!internal::diffBytes(static_cast<const uint8_t*>(a), static_cast<const uint8_t*>(b), 
+            m_mask.data(), kObjSize, bits)) return 0;
+
+        for (std::size_t i = 0; i < m_fields.size(); ++i)
+        {
+            if (internal::anyBitSet(bits, m_fields[i].offset, m_fields[i].size)) 
+                changed.push_back(i);
+        }
+        return changed.size();
+    }
+
+    /**
+     * @copydoc changedFields(const void*, const void*, std::vector<std::size_t>&) const
+     */
+    std::size_t changedFields(const WrapperT& a, const WrapperT& b, 
+        std::vector<std::size_t>& changed) const
+    {
+        return changedFields(a.addressOfObj(), b.addressOfObj(), changed);
+    }
+
+    /**
+     * @brief   Copies an object, leaving ignored fields of the destination untouched.
+     * @param   dst The destination object.
+     * @param   src The source object.
+     */
+    void copy(void* dst, const void* src) const
+    {
+        if (m_maskAll) std::memcpy(dst, src, kObjSize);
+        else internal::copyMaskedBytes(static_cast<uint8_t*>(dst), 
+            static_cast<const uint8_t*>(src), m_mask.data(), kObjSize);
+    }
+
+    /**
+     * @copydoc copy(void*, const void*) const
+     */
+    void copy(WrapperT& dst, const WrapperT& src) const
+    {
+        copy(dst.addressOfObj(), src.addressOfObj());
+    }
+private:
+    template<typename FieldT>
+    void addField(WrapperT& wrapper, const uint8_t* scratch, FieldT WrapperT::* field)
+    {
+        auto addr = reinterpret_cast<const uint8_t*>((wrapper.*field).addressOfObj());
+        m_fields.push_back({static_cast<std::size_t>(addr - scratch), 
+            sizeof(typename FieldT::RewrittenT)});
+    }
+
+    template<typename T, std::ptrdiff_t offsT>
+    void addField(WrapperT&, const uint8_t*, FieldDesc<T, offsT>)
+    {
+        using Desc = FieldDesc<T, offsT>;
+        m_fields.push_back({static_cast<std::size_t>(offsT), 
+            Desc::kDoExtraDref ? sizeof(void*) : sizeof(typename Desc::Type)});
+    }
+
+    void rebuildMask()
+    {
+        std::fill(m_mask.begin(), m_mask.end(), static_cast<uint8_t>(0xFF));
+        m_maskAll = true;
+        for (std::size_t i = 0; i < m_fields.size(); ++i)
+        {
+            if (!m_ignored[i]) continue;
+            std::fill_n(m_mask.begin() + m_fields[i].offset, m_fields[i].size, 
+                static_cast<uint8_t>(0));
+            m_maskAll = false;
+        }
+    }
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_DIFF_HPP
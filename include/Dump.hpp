@@ -0,0 +1,412 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_DUMP_HPP
+#define REMODEL_DUMP_HPP
+
+/**     
+ * @file
+ * @brief Contains a memory accessor serving reads from crash dumps.
+ *        
+ * `DumpMemoryAccessor` maps a Windows minidump or an ELF core file and indexes the memory 
+ * regions it contains, so the regular wrappers run over the dumped objects through 
+ * `RemoteInstance` or the remote containers of StlLayouts.hpp. Dumps are parsed independently 
+ * of the platform, e.g. minidumps can be analysed on Linux.
+ *
+ * @code
+ *      DumpMemoryAccessor dump;
+ *      if (!dump.open("crash.dmp")) return;
+ *      auto stable = wrapper_cast<Stable>(stableAddress).snapshot(dump);
+ *      if (stable.refresh()) std::printf("%d horses\n", stable->numHorses.get());
+ * @endcode
+ * 
+ * Only the headers of the dump are read on opening, region lookups are binary searches over
+ * the index. Memory is read straight from the mapping, so dumps are never loaded as a whole.
+ */
+
+#include "Remodel.hpp"
+#include "Remote.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef REMODEL_HAS_MAPPED_FILE
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [DumpRegion]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A memory region contained in a dump.
+ */
+struct DumpRegion
+{
+    /// The address of the region in the dumped address space.
+    uint64_t address;
+    /// The size of the region, in bytes.
+    uint64_t size;
+    /// The offset of the contents of the region in the dump file.
+    uint64_t fileOffset;
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Reads a little-endian integer from a dump, bounds-checked.
+ * @param   data    The dump.
+ * @param   size    The size of the dump.
+ * @param   offset  The offset of the integer.
+ * @param   value   Receives the integer.
+ * @return  @c true if the integer is located inside the dump, else @c false.
+ */
+template<typename T>
+inline bool readDumpValue(const uint8_t* data, uint64_t size, uint64_t offset, T& value)
+{
+    if (offset > size || size - offset < sizeof(T)) return false;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return true;
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [DumpMemoryAccessor]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Memory accessor for the address space captured in a minidump or an ELF core file.
+ *          
+ * Minidump memory is taken from the `MemoryListStream` and `Memory64ListStream`, core file 
+ * memory from the `PT_LOAD` segments (bytes not contained in the file, like those of 
+ * `p_memsz` exceeding `p_filesz`, are not readable). Only little-endian dumps are supported.
+ * Dumps are read only, writes always fail.
+ */
+class DumpMemoryAccessor
+{
+public:
+    enum class Format
+    {
+        kNone,
+        kMinidump,
+        kElfCore,
+    };
+
+    DumpMemoryAccessor() = default;
+    DumpMemoryAccessor(const DumpMemoryAccessor&) = delete;
+    DumpMemoryAccessor& operator = (const DumpMemoryAccessor&) = delete;
+
+    /**
+     * @brief   Maps a dump and indexes its memory regions.
+     * @param   path    The path of the dump.
+     * @return  @c true on success, else @c false. Fails for unknown formats.
+     */
+    bool open(const char* path)
+    {
+        close();
+        if (!m_file.open(path)) return false;
+        if (parseMinidump())        m_format = Format::kMinidump;
+        else if (parseElfCore())    m_format = Format::kElfCore;
+        else
+        {
+            close();
+            return false;
+        }
+
+        std::sort(m_regions.begin(), m_regions.end(), 
+            [](const DumpRegion& a, const DumpRegion& b) { return a.address < b.address; });
+        return true;
+    }
+
+    /**
+     * @brief   Unmaps the dump.
+     */
+    void close()
+    {
+        m_file.close();
+        m_regions.clear();
+        m_format = Format::kNone;
+    }
+
+    /**
+     * @brief   Determines whether a dump is mapped.
+     */
+    bool isOpen() const { return m_file.isOpen(); }
+
+    /**
+     * @brief   Gets the format of the mapped dump.
+     */
+    Format format() const { return m_format; }
+
+    /**
+     * @brief   Gets the memory regions of the dump, sorted by address.
+     */
+    const std::vector<DumpRegion>& regions() const { return m_regions; }
+
+    /**
+     * @brief   Gets a pointer to dumped memory without copying it.
+     * @param   address The address in the dumped address space.
+     * @param   size    The size of the memory, in bytes.
+     * @return  The memory in the mapping, or @c nullptr if not contained in a single region.
+     */
+    const void* translate(uint64_t address, std::size_t size) const
+    {
+        auto region = find(address);
+        if (!region || region->address + region->size - address < size) return nullptr;
+        return base() + region->fileOffset + (address - region->address);
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the whole range is contained in the dump, else @c false. Ranges may 
+     *          span several adjacent regions.
+     */
+    bool read(const MemoryRange& range)
+    {
+        auto dst = static_cast<uint8_t*>(range.buffer);
+        uint64_t address = range.address;
+        std::size_t left = range.size;
+        auto end = m_regions.data() + m_regions.size();
+        auto region = find(address);
+        if (!region) region = end;
+        while (left)
+        {
+            // Continuing in the next region if the range exceeds the current one.
+            if (region == end || !contains(*region, address)) return false;
+            auto offs  = address - region->address;
+            auto chunk = static_cast<std::size_t>(std::min<uint64_t>(left, region->size - offs));
+            std::memcpy(dst, base() + region->fileOffset + offs, chunk);
+            dst += chunk;
+            address += chunk;
+            left -= chunk;
+            ++region;
+        }
+        return true;
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges are contained in the dump, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        bool ok = true;
+        for (std::size_t i = 0; i < count; ++i) ok &= read(ranges[i]);
+        return ok;
+    }
+
+    /**
+     * @brief   Writes a range of memory, unsupported for dumps.
+     * @return  @c false.
+     */
+    bool write(const MemoryRange&) { return false; }
+private:
+    const uint8_t* base() const { return static_cast<const uint8_t*>(m_file.data()); }
+
+    static bool contains(const DumpRegion& region, uint64_t address)
+    {
+        return address >= region.address && address - region.address < region.size;
+    }
+
+    /**
+     * @internal
+     * @brief   Looks up the region containing an address.
+     * @return  The region, or @c nullptr if not contained in the dump.
+     */
+    const DumpRegion* find(uint64_t address) const
+    {
+        auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address, 
+            [](uint64_t addr, const DumpRegion& region) { return addr < region.address; });
+        if (it == m_regions.begin() || !contains(*--it, address)) return nullptr;
+        return &*it;
+    }
+
+    /**
+     * @internal
+     * @brief   Adds a region, clipped to the contents of the file.
+     */
+    void addRegion(uint64_t address, uint64_t size, uint64_t fileOffset)
+    {
+        if (fileOffset >= m_file.size()) return;
+        size = std::min<uint64_t>(size, m_file.size() - fileOffset);
+        if (size) m_regions.push_back({address, size, fileOffset});
+    }
+
+    bool parseMinidump()
+    {
+        enum : uint32_t
+        {
+            kSignature          = 0x504D444D, // "MDMP"
+            kMemoryListStream   = 5,
+            kMemory64ListStream = 9,
+        };
+
+        auto data = base();
+        uint64_t size = m_file.size();
+        uint32_t signature, numStreams, directoryRva;
+        if (!internal::readDumpValue(data, size, 0, signature) || signature != kSignature
+            || !internal::readDumpValue(data, size, 8, numStreams)
+            || !internal::readDumpValue(data, size, 12, directoryRva)) return false;
+
+        for (uint32_t i = 0; i < numStreams; ++i)
+        {
+            // MINIDUMP_DIRECTORY: StreamType, DataSize, Rva.
+            uint64_t entry = directoryRva + uint64_t{i} * 12;
+            uint32_t type, rva;
+            if (!internal::readDumpValue(data, size, entry, type)
+                || !internal::readDumpValue(data, size, entry + 8, rva)) return false;
+
+            if (type == kMemoryListStream)
+            {
+                // MINIDUMP_MEMORY_LIST, MINIDUMP_MEMORY_DESCRIPTOR: 
+                // StartOfMemoryRange, DataSize, Rva.
+                uint32_t count;
+                if (!internal::readDumpValue(data, size, rva, count)) return false;
+                for (uint32_t k = 0; k < count; ++k)
+                {
+                    uint64_t desc = rva + 4 + uint64_t{k} * 16, address;
+                    uint32_t dataSize, dataRva;
+                    if (!internal::readDumpValue(data, size, desc, address)
+                        || !internal::readDumpValue(data, size, desc + 8, dataSize)
+                        || !internal::readDumpValue(data, size, desc + 12, dataRva)) return false;
+                    addRegion(address, dataSize, dataRva);
+                }
+            }
+            else if (type == kMemory64ListStream)
+            {
+                // MINIDUMP_MEMORY64_LIST: NumberOfMemoryRanges, BaseRva, then 
+                // MINIDUMP_MEMORY_DESCRIPTOR64s (StartOfMemoryRange, DataSize) whose contents
+                // are stored back to back from BaseRva.
+                uint64_t count, offset;
+                if (!internal::readDumpValue(data, size, rva, count)
+                    || !internal::readDumpValue(data, size, rva + 8, offset)
+                    || count > size / 16) return false;
+                for (uint64_t k = 0; k < count; ++k)
+                {
+                    uint64_t desc = rva + 16 + k * 16, address, dataSize;
+                    if (!internal::readDumpValue(data, size, desc, address)
+                        || !internal::readDumpValue(data, size, desc + 8, dataSize)) return false;
+                    addRegion(address, dataSize, offset);
+                    offset += dataSize;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool parseElfCore()
+    {
+        enum : uint32_t
+        {
+            kClass32    = 1,
+            kClass64    = 2,
+            kDataLsb    = 1,
+            kTypeCore   = 4,
+            kPtLoad     = 1,
+            kPnXNum     = 0xFFFF,
+        };
+
+        auto data = base();
+        uint64_t size = m_file.size();
+        uint8_t ident[16];
+        if (!internal::readDumpValue(data, size, 0, ident)
+            || std::memcmp(ident, "\x7F" "ELF", 4) != 0 || ident[5] != kDataLsb
+            || (ident[4] != kClass32 && ident[4] != kClass64)) return false;
+        bool is64 = ident[4] == kClass64;
+
+        // Offsets of e_phoff, e_shoff and e_phnum and of the used Elf_Phdr / Elf_Shdr members 
+        // for ELFCLASS32 and ELFCLASS64.
+        uint16_t type, phnum;
+        uint64_t phoff = 0, shoff = 0;
+        if (!internal::readDumpValue(data, size, 16, type) || type != kTypeCore) return false;
+        if (is64)
+        {
+            if (!internal::readDumpValue(data, size, 32, phoff)
+                || !internal::readDumpValue(data, size, 40, shoff)
+                || !internal::readDumpValue(data, size, 56, phnum)) return false;
+        }
+        else
+        {
+            uint32_t phoff32, shoff32;
+            if (!internal::readDumpValue(data, size, 28, phoff32)
+                || !internal::readDumpValue(data, size, 32, shoff32)
+                || !internal::readDumpValue(data, size, 44, phnum)) return false;
+            phoff = phoff32;
+            shoff = shoff32;
+        }
+
+        // With too many segments for e_phnum, the count is stored in sh_info of section 0.
+        uint64_t count = phnum;
+        if (phnum == kPnXNum)
+        {
+            uint32_t info;
+            if (!internal::readDumpValue(data, size, shoff + (is64 ? 44 : 28), info)) 
+                return false;
+            count = info;
+        }
+
+        uint64_t phentsize = is64 ? 56 : 32;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t phdr = phoff + i * phentsize, offset, address, fileSize;
+            uint32_t segType;
+            if (!internal::readDumpValue(data, size, phdr, segType)) return false;
+            if (segType != kPtLoad) continue;
+            if (is64)
+            {
+                if (!internal::readDumpValue(data, size, phdr + 8, offset)
+                    || !internal::readDumpValue(data, size, phdr + 16, address)
+                    || !internal::readDumpValue(data, size, phdr + 32, fileSize)) return false;
+            }
+            else
+            {
+                uint32_t offset32, address32, fileSize32;
+                if (!internal::readDumpValue(data, size, phdr + 4, offset32)
+                    || !internal::readDumpValue(data, size, phdr + 8, address32)
+                    || !internal::readDumpValue(data, size, phdr + 16, fileSize32)) return false;
+                offset   = offset32;
+                address  = address32;
+                fileSize = fileSize32;
+            }
+            addRegion(address, fileSize, offset);
+        }
+        return true;
+    }
+private:
+    platform::MappedFile m_file;
+    std::vector<DumpRegion> m_regions;
+    Format m_format = Format::kNone;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // ifdef REMODEL_HAS_MAPPED_FILE
+
+#endif // REMODEL_DUMP_HPP
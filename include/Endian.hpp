@@ -0,0 +1,567 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_ENDIAN_HPP
+#define REMODEL_ENDIAN_HPP
+
+/**
+ * @file
+ * @brief Contains fields converting between byte orders on access.
+ *
+ * Wrappers for network traffic or foreign file formats can declare their fields with the byte
+ * order of the wrapped data, making the conversion implicit and removing the need for a separate
+ * copy-and-convert stage.
+ *
+ * @code
+ *      class Ipv4Header : public AdvancedClassWrapper<20>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Ipv4Header)
+ *      public:
+ *          BigEndianField<uint16_t> totalLength{this, 2};
+ *          BigEndianField<uint32_t> srcAddr    {this, 12};
+ *          BigEndianField<uint32_t> dstAddr    {this, 16};
+ *      };
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(ZYCORE_MSVC)
+#   include <stdlib.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#   include <tmmintrin.h>
+#   define REMODEL_ENDIAN_SSSE3
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define REMODEL_ENDIAN_SSE2
+#endif
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [ByteOrder]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Enumeration of byte orders.
+ */
+enum class ByteOrder
+{
+    Little,
+    Big,
+#   if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    Native = Big,
+#   else
+    Native = Little,
+#   endif
+};
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Byte swapping]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Reverses the bytes of integers, compiling to a single `bswap` (or `rol`) instruction.
+ */
+inline uint8_t byteSwap(uint8_t value) { return value; }
+
+#if defined(ZYCORE_MSVC)
+inline uint16_t byteSwap(uint16_t value) { return _byteswap_ushort(value); }
+inline uint32_t byteSwap(uint32_t value) { return _byteswap_ulong(value);  }
+inline uint64_t byteSwap(uint64_t value) { return _byteswap_uint64(value); }
+#else
+inline uint16_t byteSwap(uint16_t value) { return __builtin_bswap16(value); }
+inline uint32_t byteSwap(uint32_t value) { return __builtin_bswap32(value); }
+inline uint64_t byteSwap(uint64_t value) { return __builtin_bswap64(value); }
+#endif
+
+/**
+ * @internal
+ * @brief   Unsigned integer type of a given size.
+ */
+template<std::size_t sizeT> struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { using Type = uint8_t;  };
+template<> struct UnsignedOfSize<2> { using Type = uint16_t; };
+template<> struct UnsignedOfSize<4> { using Type = uint32_t; };
+template<> struct UnsignedOfSize<8> { using Type = uint64_t; };
+
+/**
+ * @internal
+ * @brief   Converts values between a byte order and the native byte order.
+ * @tparam  T       The type of the values, trivially copyable and of 1, 2, 4 or 8 bytes.
+ * @tparam  orderT  The foreign byte order.
+ */
+template<typename T, ByteOrder orderT>
+struct ByteOrderConverter
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "byte order conversion requires trivial types");
+
+    using Bits = typename UnsignedOfSize<sizeof(T)>::Type;
+    static const bool kSwap = orderT != ByteOrder::Native;
+
+    /**
+     * @brief   Loads a value stored in the foreign byte order.
+     */
+    static T load(const void* src)
+    {
+        Bits bits;
+        std::memcpy(&bits, src, sizeof(bits));
+        if (kSwap) bits = byteSwap(bits);
+        T value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief   Stores a value in the foreign byte order.
+     */
+    static void store(void* dst, T value)
+    {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if (kSwap) bits = byteSwap(bits);
+        std::memcpy(dst, &bits, sizeof(bits));
+    }
+};
+
+/**
+ * @internal
+ * @brief   Reverses the bytes of each element of an array.
+ * @tparam  sizeT   The size of the elements, 1, 2, 4 or 8 bytes.
+ * @param   dst     The destination, may equal @c src.
+ * @param   src     The source.
+ * @param   count   The number of elements.
+ */
+template<std::size_t sizeT>
+inline void byteSwapElements(void* dst, const void* src, std::size_t count)
+{
+    using Bits = typename UnsignedOfSize<sizeT>::Type;
+    if (sizeT == 1)
+    {
+        if (dst != src) std::memmove(dst, src, count);
+        return;
+    }
+
+    auto d = static_cast<uint8_t*>(dst);
+    auto s = static_cast<const uint8_t*>(src);
+    std::size_t i = 0;
+
+#   if defined(REMODEL_ENDIAN_SSSE3)
+        const auto shuffle = sizeT == 2
+            ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+            : sizeT == 4
+                ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        for (; (i + 1) * 16 <= count * sizeT; ++i)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 16), _mm_shuffle_epi8(v, shuffle));
+        }
+        i = i * 16 / sizeT;
+#   elif defined(REMODEL_ENDIAN_SSE2)
+        // Reverse the 16 bit words of each element, then the bytes of each word.
+        for (; (i + 1) * 16 <= count * sizeT; ++i)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 16));
+            if (sizeT == 4)
+            {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+            }
+            else if (sizeT == 8)
+            {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+            }
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i * 16), v);
+        }
+        i = i * 16 / sizeT;
+#   endif
+    for (; i < count; ++i)
+    {
+        Bits bits;
+        std::memcpy(&bits, s + i * sizeT, sizeT);
+        bits = byteSwap(bits);
+        std::memcpy(d + i * sizeT, &bits, sizeT);
+    }
+}
+
+/**
+ * @internal
+ * @brief   Converts an array between a byte order and the native byte order.
+ * @tparam  sizeT   The size of the elements, 1, 2, 4 or 8 bytes.
+ * @param   orderT  The foreign byte order.
+ * @param   dst     The destination, may equal @c src.
+ * @param   src     The source.
+ * @param   count   The number of elements.
+ */
+template<std::size_t sizeT, ByteOrder orderT>
+inline void convertElements(void* dst, const void* src, std::size_t count)
+{
+    if (orderT != ByteOrder::Native)
+    {
+        byteSwapElements<sizeT>(dst, src, count);
+    }
+    else if (dst != src)
+    {
+        std::memmove(dst, src, count * sizeT);
+    }
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [convertByteOrder]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Converts an array of values between a byte order and the native byte order.
+ * @tparam  orderT  The foreign byte order. Converting is symmetric, so this works either way.
+ * @tparam  T       The type of the values, trivially copyable and of 1, 2, 4 or 8 bytes.
+ * @param   dst     The destination, may equal @c src for in-place conversion.
+ * @param   src     The source.
+ * @param   count   The number of values.
+ *
+ * Swaps 16 bytes per instruction using SSSE3 (or SSE2) when available.
+ */
+template<ByteOrder orderT, typename T>
+inline void convertByteOrder(T* dst, const T* src, std::size_t count)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "byte order conversion requires trivial types");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+        "byte order conversion requires types of 1, 2, 4 or 8 bytes");
+    internal::convertElements<sizeof(T), orderT>(dst, src, count);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [EndianField]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Field stored in a given byte order, converting on access.
+ * @tparam  T           The type of the field, an arithmetic or enum type.
+ * @tparam  orderT      The byte order of the wrapped data.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ *
+ * Other than `Field`, the stored representation cannot be referenced as a `T`, so operators are
+ * forwarded by value: compound assignments load, apply the operation and store the result. For
+ * `ByteOrder::Native`, the conversion compiles away entirely.
+ */
+template<typename T, ByteOrder orderT, typename PtrGetterT = internal::DefaultPtrGetter>
+class EndianField : public internal::GetterFieldBase<PtrGetterT>
+{
+    using Base      = internal::GetterFieldBase<PtrGetterT>;
+    using Converter = internal::ByteOrderConverter<T, orderT>;
+
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+        "endian fields require arithmetic or enum types");
+
+    template<typename U = T>
+    using EnableArithmetic = std::enable_if_t<
+        std::is_arithmetic<U>::value && !std::is_same<U, bool>::value, T>;
+    template<typename U = T>
+    using EnableIntegral = std::enable_if_t<
+        std::is_integral<U>::value && !std::is_same<U, bool>::value, T>;
+public:
+    static const ByteOrder kByteOrder = orderT;
+
+    /**
+     * @brief   Constructs a field from a parent and a `PtrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
+     */
+    EndianField(ClassWrapper* parent, PtrGetterT ptrGetter)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   offset  The offset of the field inside of the wrapped object, in bytes.
+     */
+    EndianField(ClassWrapper* parent, std::ptrdiff_t offset)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @copydoc Field::Field(Field&&)
+     */
+    EndianField(EndianField&& other) = default;
+
+    /**
+     * @brief   Reads the field, converting it to the native byte order.
+     * @return  The value.
+     */
+    T get() const { return Converter::load(this->crawPtr()); }
+
+    /**
+     * @brief   Writes the field, converting it to the foreign byte order.
+     * @param   value   The value.
+     */
+    void set(T value) { Converter::store(this->rawPtr(), value); }
+
+    /**
+     * @brief   Implicit cast to the value of the field.
+     * @return  The value.
+     */
+    operator T () const { return get(); }
+
+    /**
+     * @brief   Assignment operator writing the field.
+     * @param   rhs The right hand side.
+     * @return  @c rhs.
+     */
+    T operator = (T rhs)
+    {
+        set(rhs);
+        return rhs;
+    }
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  The value assigned.
+     */
+    T operator = (const EndianField& rhs)
+    {
+        return *this = rhs.get();
+    }
+
+    // Compound assignments, returning the value stored.
+#define REMODEL_ENDIAN_COMPOUND(op, enableT)                                                       \
+    template<typename U = T>                                                                       \
+    enableT<U> operator op##= (T rhs)                                                              \
+    {                                                                                              \
+        auto value = static_cast<T>(get() op rhs);                                                 \
+        set(value);                                                                                \
+        return value;                                                                              \
+    }
+
+    REMODEL_ENDIAN_COMPOUND(+,  EnableArithmetic)
+    REMODEL_ENDIAN_COMPOUND(-,  EnableArithmetic)
+    REMODEL_ENDIAN_COMPOUND(*,  EnableArithmetic)
+    REMODEL_ENDIAN_COMPOUND(/,  EnableArithmetic)
+    REMODEL_ENDIAN_COMPOUND(%,  EnableIntegral)
+    REMODEL_ENDIAN_COMPOUND(&,  EnableIntegral)
+    REMODEL_ENDIAN_COMPOUND(|,  EnableIntegral)
+    REMODEL_ENDIAN_COMPOUND(^,  EnableIntegral)
+    REMODEL_ENDIAN_COMPOUND(<<, EnableIntegral)
+    REMODEL_ENDIAN_COMPOUND(>>, EnableIntegral)
+
+#undef REMODEL_ENDIAN_COMPOUND
+
+    template<typename U = T> EnableIntegral<U> operator ++ () { return *this += 1; }
+    template<typename U = T> EnableIntegral<U> operator -- () { return *this -= 1; }
+
+    template<typename U = T>
+    EnableIntegral<U> operator ++ (int)
+    {
+        auto value = get();
+        set(static_cast<T>(value + 1));
+        return value;
+    }
+
+    template<typename U = T>
+    EnableIntegral<U> operator -- (int)
+    {
+        auto value = get();
+        set(static_cast<T>(value - 1));
+        return value;
+    }
+
+    /**
+     * @brief   Obtains a raw pointer to the wrapped object, in the foreign byte order.
+     * @return  The desired pointer.
+     */
+    T* addressOfObj() { return static_cast<T*>(this->rawPtr()); }
+
+    /**
+     * @brief   Obtains a constant raw pointer to the wrapped object, in the foreign byte order.
+     * @return  The desired pointer.
+     */
+    const T* addressOfObj() const { return static_cast<const T*>(this->crawPtr()); }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    EndianField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const EndianField* addressOfWrapper() const { return this; }
+};
+
+/**
+ * @brief   Field stored in big-endian (network) byte order.
+ * @tparam  T   The type of the field.
+ */
+template<typename T>
+using BigEndianField = EndianField<T, ByteOrder::Big>;
+
+/**
+ * @brief   Field stored in little-endian byte order.
+ * @tparam  T   The type of the field.
+ */
+template<typename T>
+using LittleEndianField = EndianField<T, ByteOrder::Little>;
+
+// ---------------------------------------------------------------------------------------------- //
+// [EndianArrayField]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Fixed size array field stored in a given byte order.
+ * @tparam  T           The type of the elements, an arithmetic or enum type.
+ * @tparam  countT      The number of elements.
+ * @tparam  orderT      The byte order of the wrapped data.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ *
+ * Single elements are converted on access, `load` and `store` convert ranges of elements using
+ * `convertByteOrder`.
+ */
+template<typename T, std::size_t countT, ByteOrder orderT,
+    typename PtrGetterT = internal::DefaultPtrGetter>
+class EndianArrayField : public internal::GetterFieldBase<PtrGetterT>
+{
+    using Base      = internal::GetterFieldBase<PtrGetterT>;
+    using Converter = internal::ByteOrderConverter<T, orderT>;
+public:
+    static const std::size_t kCount = countT;
+
+    /**
+     * @brief   Constructs a field from a parent and a `PtrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
+     */
+    EndianArrayField(ClassWrapper* parent, PtrGetterT ptrGetter)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   offset  The offset of the field inside of the wrapped object, in bytes.
+     */
+    EndianArrayField(ClassWrapper* parent, std::ptrdiff_t offset)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+    {}
+
+    EndianArrayField(const EndianArrayField&) = delete;
+    EndianArrayField(EndianArrayField&&) = default;
+    EndianArrayField& operator = (const EndianArrayField&) = delete;
+
+    /**
+     * @brief   Gets the number of elements.
+     * @return  `countT`.
+     */
+    std::size_t size() const { return countT; }
+
+    /**
+     * @brief   Reads an element, converting it to the native byte order.
+     * @param   idx The index of the element.
+     * @return  The value.
+     */
+    T operator [] (std::size_t idx) const { return get(idx); }
+
+    /**
+     * @copydoc operator[]
+     */
+    T get(std::size_t idx) const { return Converter::load(elements() + idx); }
+
+    /**
+     * @brief   Writes an element, converting it to the foreign byte order.
+     * @param   idx     The index of the element.
+     * @param   value   The value.
+     */
+    void set(std::size_t idx, T value) { Converter::store(elements() + idx, value); }
+
+    /**
+     * @brief   Reads a range of elements, converting them to the native byte order.
+     * @param   out     The output array.
+     * @param   first   The index of the first element to read.
+     * @param   count   The number of elements to read, clamped to the end of the array.
+     */
+    void load(T* out, std::size_t first = 0, std::size_t count = countT) const
+    {
+        if (first >= countT) return;
+        convertByteOrder<orderT>(out, elements() + first, std::min(count, countT - first));
+    }
+
+    /**
+     * @brief   Writes a range of elements, converting them to the foreign byte order.
+     * @param   in      The input array.
+     * @param   first   The index of the first element to write.
+     * @param   count   The number of elements to write, clamped to the end of the array.
+     */
+    void store(const T* in, std::size_t first = 0, std::size_t count = countT)
+    {
+        if (first >= countT) return;
+        convertByteOrder<orderT>(elements() + first, in, std::min(count, countT - first));
+    }
+
+    /**
+     * @brief   Obtains a raw pointer to the first element, in the foreign byte order.
+     * @return  The desired pointer.
+     */
+    T* addressOfObj() { return elements(); }
+
+    /**
+     * @brief   Obtains a constant raw pointer to the first element, in the foreign byte order.
+     * @return  The desired pointer.
+     */
+    const T* addressOfObj() const { return elements(); }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    EndianArrayField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const EndianArrayField* addressOfWrapper() const { return this; }
+private:
+    T* elements() const { return static_cast<T*>(const_cast<void*>(this->crawPtr())); }
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_ENDIAN_HPP
@@ -0,0 +1,376 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_FIELDINDEX_HPP
+#define REMODEL_FIELDINDEX_HPP
+
+/**     
+ * @file
+ * @brief Contains hash and sorted indices over a key field of sets of wrapped objects.
+ *        
+ * Indices are kept up to date incrementally: `sync` applies the objects added and removed since 
+ * the last scan (e.g. the candidates of a rescanning `VftableScanner`) and `refresh` re-keys the
+ * objects whose key changed, detected by a `WatchSet` over the key fields. Lookups verify the 
+ * key against the live object, so stale entries are never returned.
+ *        
+ * @code
+ *      auto byId = hashIndexOf(&Entity::id);
+ *      for (;;)
+ *      {
+ *          scanner.rescanProcess();
+ *          byId.sync(scanner.instances<Entity>());
+ *          byId.refresh();
+ *          if (auto player = byId.find(playerId)) { ... }
+ *      }
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+#include "Watch.hpp"
+#include "WrapperSpan.hpp"
+#include "InstanceScan.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldIndex]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Shared implementation of the indices, mapping keys to objects using a multimap.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the key field.
+ * @tparam  MapT        Type of the multimap from keys to raw pointers of objects.
+ */
+template<typename WrapperT, typename FieldT, typename MapT>
+class FieldIndex
+{
+public:
+    using Key = typename FieldT::RewrittenT;
+    static_assert(std::is_trivially_copyable<Key>::value, "keys must be trivially copyable");
+
+    /**
+     * @brief   Constructor.
+     * @param   field   Pointer to the key field member, e.g. `&Entity::id`.
+     * @note    The field is required to be located at the same offset in every object (as it is 
+     *          the case with offset-based fields and `StaticField`s). It is resolved by wrapping 
+     *          the first object once.
+     */
+    explicit FieldIndex(FieldT WrapperT::* field)
+        : m_field{field}
+    {}
+
+    /**
+     * @brief   Indexes the objects of a span, replacing the previous objects.
+     * @param   span    The span.
+     */
+    void assign(const WrapperSpan<WrapperT>& span)
+    {
+        std::vector<void*> objects(span.size());
+        for (std::size_t i = 0; i < objects.size(); ++i) objects[i] = span.data() + i;
+        assign(std::move(objects));
+    }
+
+    /**
+     * @brief   Indexes objects, replacing the previous objects.
+     * @param   objects The raw pointers of the objects, without duplicates.
+     */
+    void assign(std::vector<void*> objects)
+    {
+        std::sort(objects.begin(), objects.end());
+        m_objects.clear();
+        m_keys.clear();
+        m_map.clear();
+        syncSorted(objects.data(), objects.size());
+    }
+
+    /**
+     * @brief   Brings the indexed objects in line with a new set of objects.
+     * @param   set The current objects in ascending order, e.g. as found by a rescan.
+     * @return  The number of objects added, removed or re-keyed.
+     *          
+     * Objects kept are compared with their indexed key, objects not in the set anymore are 
+     * removed without being read.
+     */
+    std::size_t sync(const InstanceSet<WrapperT>& set)
+    {
+        return syncSorted(set.data(), set.size());
+    }
+
+    /**
+     * @brief   Re-keys the objects whose key changed since the last refresh or sync.
+     * @return  The number of re-keyed objects.
+     */
+    std::size_t refresh()
+    {
+        m_watches.poll(m_changed);
+        for (auto row : m_changed)
+        {
+            Key key;
+            std::memcpy(&key, m_watches.shadow(row), sizeof(key));
+            rekey(row, key);
+        }
+        return m_changed.size();
+    }
+
+    /**
+     * @brief   Enables skipping objects on pages not written since the last refresh.
+     * @return  @c true if supported by the platform, else @c false.
+     * @see     WatchSet::enablePageTracking
+     */
+    bool enablePageTracking() { return m_watches.enablePageTracking(); }
+
+    /**
+     * @brief   Finds an object by its key.
+     * @param   key The key.
+     * @return  The raw pointer of an object currently holding the key, @c nullptr if none.
+     * @note    Objects whose key changed to the searched one since the last refresh aren't found.
+     */
+    void* find(const Key& key) const
+    {
+        auto range = m_map.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (liveKey(it->second) == key) return it->second;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief   Finds all objects holding a key.
+     * @param   key     The key.
+     * @param   objects Receives the raw pointers of the objects.
+     * @return  The number of objects found.
+     */
+    std::size_t findAll(const Key& key, std::vector<void*>& objects) const
+    {
+        objects.clear();
+        auto range = m_map.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) collectLive(*it, objects);
+        return objects.size();
+    }
+
+    /**
+     * @brief   Gets the number of indexed objects.
+     */
+    std::size_t size() const { return m_objects.size(); }
+protected:
+    Key liveKey(const void* object) const
+    {
+        Key key;
+        std::memcpy(&key, static_cast<const uint8_t*>(object) + m_offset, sizeof(key));
+        return key;
+    }
+
+    void collectLive(const typename MapT::value_type& entry, std::vector<void*>& objects) const
+    {
+        if (liveKey(entry.second) == entry.first) objects.push_back(entry.second);
+    }
+private:
+    std::size_t syncSorted(void* const* objects, std::size_t count)
+    {
+        if (count && !m_resolved)
+        {
+            auto wrapper = wrapper_cast<WrapperT>(objects[0]);
+            m_offset   = reinterpret_cast<const uint8_t*>((wrapper.*m_field).addressOfObj()) 
+                - static_cast<const uint8_t*>(objects[0]);
+            m_resolved = true;
+        }
+
+        // Merges the sorted old and new objects.
+        std::vector<void*> mergedObjects;
+        std::vector<Key> mergedKeys;
+        mergedObjects.reserve(count);
+        mergedKeys.reserve(count);
+        std::size_t changes = 0, oldIdx = 0;
+        for (std::size_t newIdx = 0; newIdx < count; ++newIdx)
+        {
+            auto object = objects[newIdx];
+            for (; oldIdx < m_objects.size() && m_objects[oldIdx] < object; ++oldIdx, ++changes)
+            {
+                erase(m_keys[oldIdx], m_objects[oldIdx]);
+            }
+
+            auto key = liveKey(object);
+            if (oldIdx < m_objects.size() && m_objects[oldIdx] == object)
+            {
+                if (!(m_keys[oldIdx] == key))
+                {
+                    erase(m_keys[oldIdx], object);
+                    m_map.emplace(key, object);
+                    ++changes;
+                }
+                ++oldIdx;
+            }
+            else
+            {
+                m_map.emplace(key, object);
+                ++changes;
+            }
+            mergedObjects.push_back(object);
+            mergedKeys.push_back(key);
+        }
+        for (; oldIdx < m_objects.size(); ++oldIdx, ++changes)
+        {
+            erase(m_keys[oldIdx], m_objects[oldIdx]);
+        }
+
+        m_objects = std::move(mergedObjects);
+        m_keys    = std::move(mergedKeys);
+
+        std::vector<const void*> ranges(m_objects.size());
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            ranges[i] = static_cast<const uint8_t*>(m_objects[i]) + m_offset;
+        }
+        m_watches.clear();
+        m_watches.watchRanges(ranges.data(), ranges.size(), sizeof(Key));
+        return changes;
+    }
+
+    void rekey(std::size_t row, const Key& key)
+    {
+        erase(m_keys[row], m_objects[row]);
+        m_map.emplace(key, m_objects[row]);
+        m_keys[row] = key;
+    }
+
+    void erase(const Key& key, void* object)
+    {
+        auto range = m_map.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == object)
+            {
+                m_map.erase(it);
+                return;
+            }
+        }
+    }
+protected:
+    MapT m_map;
+private:
+    FieldT WrapperT::* m_field;
+    std::ptrdiff_t m_offset = 0;
+    bool m_resolved = false;
+    /// The indexed objects, sorted, and their keys as of the last refresh or sync.
+    std::vector<void*> m_objects;
+    std::vector<Key> m_keys;
+    std::vector<std::size_t> m_changed;
+    WatchSet m_watches;
+};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [HashIndex] / [SortedIndex]                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Index over a key field of wrapped objects, supporting point lookups in O(1).
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the key field, hashable using `std::hash`.
+ */
+template<typename WrapperT, typename FieldT>
+class HashIndex : public internal::FieldIndex<WrapperT, FieldT, 
+    std::unordered_multimap<typename FieldT::RewrittenT, void*>>
+{
+    using Base = internal::FieldIndex<WrapperT, FieldT, 
+        std::unordered_multimap<typename FieldT::RewrittenT, void*>>;
+public:
+    using Base::Base;
+};
+
+/**
+ * @brief   Index over a key field of wrapped objects, supporting lookups and ordered range 
+ *          queries in O(log n).
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the key field, ordered using `operator <`.
+ */
+template<typename WrapperT, typename FieldT>
+class SortedIndex : public internal::FieldIndex<WrapperT, FieldT, 
+    std::multimap<typename FieldT::RewrittenT, void*>>
+{
+    using Base = internal::FieldIndex<WrapperT, FieldT, 
+        std::multimap<typename FieldT::RewrittenT, void*>>;
+public:
+    using Key = typename Base::Key;
+    using Base::Base;
+
+    /**
+     * @brief   Finds all objects with keys in a half-open range.
+     * @param   first   The first key of the range.
+     * @param   last    The key past the range.
+     * @param   objects Receives the raw pointers of the objects, in ascending key order.
+     * @return  The number of objects found.
+     */
+    std::size_t findRange(const Key& first, const Key& last, std::vector<void*>& objects) const
+    {
+        objects.clear();
+        auto end = this->m_map.lower_bound(last);
+        for (auto it = this->m_map.lower_bound(first); it != end; ++it) 
+        {
+            this->collectLive(*it, objects);
+        }
+        return objects.size();
+    }
+};
+
+/**
+ * @brief   Creates a hash index over a field of a wrapper.
+ * @param   field   Pointer to the key field member, e.g. `&Entity::id`.
+ * @return  The index, without any objects.
+ */
+template<typename WrapperT, typename FieldT>
+inline HashIndex<WrapperT, FieldT> hashIndexOf(FieldT WrapperT::* field)
+{
+    return HashIndex<WrapperT, FieldT>{field};
+}
+
+/**
+ * @brief   Creates a sorted index over a field of a wrapper.
+ * @param   field   Pointer to the key field member, e.g. `&Entity::id`.
+ * @return  The index, without any objects.
+ */
+template<typename WrapperT, typename FieldT>
+inline SortedIndex<WrapperT, FieldT> sortedIndexOf(FieldT WrapperT::* field)
+{
+    return SortedIndex<WrapperT, FieldT>{field};
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_FIELDINDEX_HPP
@@ -0,0 +1,267 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_FOOTPRINT_HPP
+#define REMODEL_FOOTPRINT_HPP
+
+/**     
+ * @file
+ * @brief Contains memory footprint introspection of wrapper types.
+ *        
+ * Every field of a wrapper stores its parent and (unless it is a `StaticField`) its getter, so 
+ * wrappers are usually many times bigger than a pointer. `FootprintTraits` gives the sizes known
+ * at compile time, `measureFootprint` inspects a wrapper instance for the number of fields and 
+ * the getters stored on the heap, and `FootprintReport` tabulates several wrapper types.
+ *
+ * @code
+ *      static_assert(FootprintTraits<Player>::kWrapperSize <= 256, "Player wrapper grew");
+ *      
+ *      FootprintReport report;
+ *      report.add<Player>("Player");
+ *      report.add<Horse>("Horse");
+ *      report.dump(stderr);
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [FootprintTraits]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Gets the size of the wrapped objects, zero for wrappers not declaring it.
+ */
+template<typename WrapperT, typename = void>
+struct WrappedObjSize : std::integral_constant<std::size_t, 0> {};
+
+template<typename WrapperT>
+struct WrappedObjSize<WrapperT, typename WrapperT::IsAdvWrapper> 
+    : std::integral_constant<std::size_t, WrapperT::kObjSize> 
+{};
+
+} // namespace internal
+
+/**
+ * @brief   The footprint of a wrapper type known at compile time.
+ * @tparam  WrapperT    Type of the wrapper.
+ */
+template<typename WrapperT>
+struct FootprintTraits
+{
+    static_assert(std::is_base_of<ClassWrapper, WrapperT>::value, "not a wrapper");
+
+    /// `sizeof` the wrapper.
+    static const std::size_t kWrapperSize = sizeof(WrapperT);
+    /// The size of the wrapped objects, zero unless derived from `AdvancedClassWrapper`.
+    static const std::size_t kObjSize = internal::WrappedObjSize<WrapperT>::value;
+    /// The maximum number of fields, if none stored a getter.
+    static const std::size_t kMaxFieldCount 
+        = (sizeof(WrapperT) - sizeof(ClassWrapper)) / sizeof(internal::FieldBase);
+
+    /**
+     * @brief   Gets the size of the wrapper relative to the wrapped object.
+     * @return  The ratio, zero if the object size isn't known.
+     */
+    static constexpr double sizeRatio() 
+    { 
+        return kObjSize ? static_cast<double>(kWrapperSize) / kObjSize : 0.; 
+    }
+};
+
+template<typename WrapperT> const std::size_t FootprintTraits<WrapperT>::kWrapperSize;
+template<typename WrapperT> const std::size_t FootprintTraits<WrapperT>::kObjSize;
+template<typename WrapperT> const std::size_t FootprintTraits<WrapperT>::kMaxFieldCount;
+
+// ---------------------------------------------------------------------------------------------- //
+// [measureFootprint]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The footprint of a wrapper instance.
+ */
+struct WrapperFootprint
+{
+    /// `sizeof` the wrapper.
+    std::size_t wrapperSize;
+    /// The size of the wrapped objects, zero if unknown.
+    std::size_t objSize;
+    /// The number of fields (and functions) belonging to the wrapper.
+    std::size_t fieldCount;
+    /// The bytes of the wrapper not taken by its raw pointer and the fields' parent pointers,
+    /// mostly getters.
+    std::size_t getterBytes;
+    /// The number of getters stored on the heap, allocating on every copy of the wrapper.
+    std::size_t heapGetters;
+
+    /**
+     * @brief   Gets the size of the wrapper relative to the wrapped object.
+     * @return  The ratio, zero if the object size isn't known.
+     */
+    double sizeRatio() const 
+    { 
+        return objSize ? static_cast<double>(wrapperSize) / objSize : 0.; 
+    }
+};
+
+/**
+ * @brief   Measures the footprint of a wrapper.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @param   wrapper     The wrapper.
+ * @return  The footprint.
+ *          
+ * Fields are recognized by their parent pointer, getters on the heap by their invoker, scanning
+ * the wrapper's memory word by word. Fields of nested wrappers belong to those and aren't 
+ * counted, getter state equal to one of the two (e.g. a getter capturing the wrapper's address) 
+ * is miscounted.
+ */
+template<typename WrapperT>
+inline WrapperFootprint measureFootprint(const WrapperT& wrapper)
+{
+    using Traits = FootprintTraits<WrapperT>;
+    WrapperFootprint result{Traits::kWrapperSize, Traits::kObjSize, 0, 0, 0};
+
+    auto base   = reinterpret_cast<const uint8_t*>(wrapper.addressOfWrapper());
+    auto parent = reinterpret_cast<uintptr_t>(static_cast<const ClassWrapper*>(
+        wrapper.addressOfWrapper()));
+    for (auto offs = sizeof(ClassWrapper); offs + sizeof(uintptr_t) <= sizeof(WrapperT); 
+        offs += alignof(void*))
+    {
+        uintptr_t word;
+        std::memcpy(&word, base + offs, sizeof(word));
+        result.fieldCount  += word == parent;
+        result.heapGetters += word == internal::InlineGetter::heapInvoker();
+    }
+
+    auto fixed = sizeof(ClassWrapper) + result.fieldCount * sizeof(internal::FieldBase);
+    result.getterBytes = fixed < sizeof(WrapperT) ? sizeof(WrapperT) - fixed : 0;
+    return result;
+}
+
+/**
+ * @brief   Measures the footprint of a wrapper type, wrapping a null pointer.
+ * @tparam  WrapperT    Type of the wrapper. Its fields must not access the object on 
+ *                      construction.
+ * @return  The footprint.
+ */
+template<typename WrapperT>
+inline WrapperFootprint measureFootprint()
+{
+    return measureFootprint(wrapper_cast<WrapperT>(nullptr));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [FootprintReport]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Table of the footprints of several wrapper types.
+ */
+class FootprintReport
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        WrapperFootprint footprint;
+    };
+
+    /**
+     * @brief   Adds the footprint of a wrapper type, see `measureFootprint`.
+     * @tparam  WrapperT    Type of the wrapper.
+     * @param   name        The name to report the type as.
+     */
+    template<typename WrapperT>
+    void add(std::string name)
+    {
+        add(std::move(name), measureFootprint<WrapperT>());
+    }
+
+    /**
+     * @brief   Adds a measured footprint.
+     * @param   name        The name to report the type as.
+     * @param   footprint   The footprint.
+     */
+    void add(std::string name, const WrapperFootprint& footprint)
+    {
+        m_entries.push_back({std::move(name), footprint});
+    }
+
+    /**
+     * @brief   Gets the entries, in order of addition.
+     */
+    const std::vector<Entry>& entries() const { return m_entries; }
+
+    /**
+     * @brief   Gets the total size of one wrapper of every type.
+     */
+    std::size_t totalWrapperSize() const
+    {
+        std::size_t total = 0;
+        for (const auto& entry : m_entries) total += entry.footprint.wrapperSize;
+        return total;
+    }
+
+    /**
+     * @brief   Writes the entries as a table.
+     * @param   out The stream to write to.
+     */
+    void dump(std::FILE* out) const
+    {
+        std::fprintf(out, "%10s %10s %8s %8s %8s %8s  %s\n", 
+            "size", "obj size", "ratio", "fields", "getters", "on heap", "wrapper");
+        for (const auto& entry : m_entries)
+        {
+            const auto& fp = entry.footprint;
+            std::fprintf(out, "%10llu %10llu %8.2f %8llu %8llu %8llu  %s\n",
+                static_cast<unsigned long long>(fp.wrapperSize),
+                static_cast<unsigned long long>(fp.objSize), fp.sizeRatio(),
+                static_cast<unsigned long long>(fp.fieldCount),
+                static_cast<unsigned long long>(fp.getterBytes),
+                static_cast<unsigned long long>(fp.heapGetters), entry.name.c_str());
+        }
+    }
+private:
+    std::vector<Entry> m_entries;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_FOOTPRINT_HPP
@@ -0,0 +1,625 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_GATHER_HPP
+#define REMODEL_GATHER_HPP
+
+/**     
+ * @file
+ * @brief Contains batched gathering of fields from arrays of wrapped objects.
+ *        
+ * Reading the same few fields from a large array of objects with `wrapper_cast` constructs a full
+ * wrapper (including all of its fields) per element. `gatherFields` instead resolves the field 
+ * offsets once and copies the selected fields into contiguous output arrays ("structure of 
+ * arrays") in a single streaming pass.
+ *
+ * @code
+ *      std::vector<uint32_t> ids(count);
+ *      std::vector<float>    health(count);
+ *      gatherFields<Entity>(entities, count, 
+ *          gatherInto(Entity::id, ids.data()), gatherInto(&Entity::health, health.data()));
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define REMODEL_GATHER_AVX2
+#endif
+
+namespace remodel
+{
+
+// ============================================================================================== //
+// Gather targets                                                                                 //
+// ============================================================================================== //
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [GatherTarget]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   A field at a fixed offset paired with the output array it is gathered into.
+ * @tparam  T       The type of the gathered field.
+ * @tparam  derefT  If @c true, the field is a reference implemented as pointer.
+ */
+template<typename T, bool derefT>
+class GatherTarget
+{
+public:
+    using Type = T;
+    static const bool kDoExtraDref = derefT;
+
+    /**
+     * @brief   The width of a SIMD-gathered element, 0 if the field is copied element-wise.
+     */
+    static const std::size_t kVectorWidth = 
+        !derefT && std::is_trivially_copyable<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+            ? sizeof(T) : 0;
+
+    /**
+     * @brief   Constructor.
+     * @param   offs    The offset of the field inside of the objects, in bytes.
+     * @param   out     The output array, large enough to hold one element per object.
+     */
+    GatherTarget(std::ptrdiff_t offs, T* out)
+        : m_offs{offs}
+        , m_out{out}
+    {}
+
+    /**
+     * @brief   Resolves the offset of the field, a no-op for fields with known offsets.
+     * @param   first   The first object of the gathered array.
+     */
+    void resolve(const void* /*first*/) {}
+
+    /**
+     * @brief   Gets the offset of the field inside of the objects, in bytes.
+     * @return  The offset.
+     */
+    std::ptrdiff_t offset() const { return m_offs; }
+
+    /**
+     * @brief   Resets an element of the output array to a value-initialized @c T.
+     * @param   idx     The index of the element.
+     */
+    void clear(std::size_t idx) const { m_out[idx] = T{}; }
+
+    /**
+     * @brief   Copies the field of a single object to the output array.
+     * @param   obj     The object.
+     * @param   idx     The index of the object in the gathered array.
+     */
+    void gather(const uint8_t* obj, std::size_t idx) const
+    {
+        auto ptr = obj + m_offs;
+        m_out[idx] = *(derefT ? *reinterpret_cast<const T* const*>(ptr) 
+            : reinterpret_cast<const T*>(ptr));
+    }
+
+#   ifdef REMODEL_GATHER_AVX2
+    /**
+     * @brief   Copies the field of eight consecutive objects to the output array.
+     * @param   block   The first of the eight objects.
+     * @param   stride  The distance between two objects, in bytes.
+     * @param   idx32   The byte offsets of the eight objects relative to @c block.
+     * @param   idx64lo The byte offsets of the first four objects relative to @c block.
+     * @param   idx64hi The byte offsets of the last four objects relative to @c block.
+     * @param   idx     The index of the first object in the gathered array.
+     */
+    void gather8(const uint8_t* block, std::size_t stride, __m256i idx32, __m256i idx64lo, 
+        __m256i idx64hi, std::size_t idx) const
+    {
+        gather8Impl(block, stride, idx32, idx64lo, idx64hi, idx, 
+            std::integral_constant<std::size_t, kVectorWidth>{});
+    }
+private:
+    void gather8Impl(const uint8_t* block, std::size_t stride, __m256i, __m256i, __m256i, 
+        std::size_t idx, std::integral_constant<std::size_t, 0>) const
+    {
+        // Not vectorizable, fall back to element-wise copies.
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            gather(block + i * stride, idx + i);
+        }
+    }
+
+    void gather8Impl(const uint8_t* block, std::size_t, __m256i idx32, __m256i, __m256i, 
+        std::size_t idx, std::integral_constant<std::size_t, 4>) const
+    {
+        auto vals = _mm256_i32gather_epi32(
+            reinterpret_cast<const int*>(block + m_offs), idx32, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_out + idx), vals);
+    }
+
+    void gather8Impl(const uint8_t* block, std::size_t, __m256i, __m256i idx64lo, 
+        __m256i idx64hi, std::size_t idx, std::integral_constant<std::size_t, 8>) const
+    {
+        auto base = reinterpret_cast<const long long*>(block + m_offs);
+        auto lo   = _mm256_i64gather_epi64(base, idx64lo, 1);
+        auto hi   = _mm256_i64gather_epi64(base, idx64hi, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_out + idx    ), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_out + idx + 4), hi);
+    }
+#   endif // ifdef REMODEL_GATHER_AVX2
+protected:
+    std::ptrdiff_t m_offs;
+    T* m_out;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [MemberGatherTarget]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Gather target for a field member of a wrapper, resolving its offset on first use.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ */
+template<typename WrapperT, typename FieldT>
+class MemberGatherTarget : public GatherTarget<typename FieldT::RewrittenT, false>
+{
+    using Base = GatherTarget<typename FieldT::RewrittenT, false>;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   field   The field.
+     * @param   out     The output array, large enough to hold one element per object.
+     */
+    MemberGatherTarget(FieldT WrapperT::* field, typename FieldT::RewrittenT* out)
+        : Base{0, out}
+        , m_field{field}
+    {}
+
+    /**
+     * @brief   Resolves the offset of the field by wrapping the first object.
+     * @param   first   The first object of the gathered array.
+     */
+    void resolve(const void* first)
+    {
+        auto wrapper = wrapper_cast<WrapperT>(const_cast<void*>(first));
+        this->m_offs = reinterpret_cast<const uint8_t*>((wrapper.*m_field).addressOfObj()) 
+            - static_cast<const uint8_t*>(first);
+    }
+private:
+    FieldT WrapperT::* m_field;
+};
+
+/**
+ * @internal
+ * @brief   Invokes a function for each of the arguments, in order.
+ */
+template<typename FuncT, typename... ArgsT>
+inline void forEachArg(FuncT&& func, ArgsT&&... args)
+{
+    (void)std::initializer_list<int>{(func(std::forward<ArgsT>(args)), 0)...};
+}
+
+/**
+ * @internal
+ * @brief   Distance in objects to prefetch ahead while gathering.
+ */
+const std::size_t kGatherPrefetchDistance = 16;
+
+// ---------------------------------------------------------------------------------------------- //
+// [ChainHop]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   A pointer field at a fixed offset followed by `walkPointerChains`.
+ */
+class ChainHop
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   offs        The offset of the pointer inside of the objects, in bytes.
+     * @param   resolved    Whether the offset is already known.
+     */
+    explicit ChainHop(std::ptrdiff_t offs, bool resolved = true)
+        : m_offs{offs}
+        , m_resolved{resolved}
+    {}
+
+    /**
+     * @brief   Resolves the offset of the pointer, a no-op for fields with known offsets.
+     * @param   obj     An object of the chain level.
+     */
+    void resolve(const void* /*obj*/) {}
+
+    /**
+     * @brief   Determines whether the offset is known.
+     * @return  @c true if resolved, else @c false.
+     */
+    bool isResolved() const { return m_resolved; }
+
+    /**
+     * @brief   Gets the offset of the pointer inside of the objects, in bytes.
+     * @return  The offset.
+     */
+    std::ptrdiff_t offset() const { return m_offs; }
+protected:
+    std::ptrdiff_t m_offs;
+    bool m_resolved;
+};
+
+/**
+ * @internal
+ * @brief   Chain hop for a pointer field member of a wrapper, resolving its offset on first use.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ */
+template<typename WrapperT, typename FieldT>
+class MemberChainHop : public ChainHop
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   field   The field.
+     */
+    explicit MemberChainHop(FieldT WrapperT::* field)
+        : ChainHop{0, false}
+        , m_field{field}
+    {}
+
+    /**
+     * @brief   Resolves the offset of the pointer by wrapping an object of the chain level.
+     * @param   obj     The object.
+     */
+    void resolve(const void* obj)
+    {
+        auto wrapper = wrapper_cast<WrapperT>(const_cast<void*>(obj));
+        m_offs = reinterpret_cast<const uint8_t*>((wrapper.*m_field).addressOfObj()) 
+            - static_cast<const uint8_t*>(obj);
+        m_resolved = true;
+    }
+private:
+    FieldT WrapperT::* m_field;
+};
+
+/**
+ * @internal
+ * @brief   Number of chains advanced in lockstep, sized to keep the pointers in L1.
+ */
+const std::size_t kChainBlockSize = 256;
+
+/**
+ * @internal
+ * @brief   Resolves a hop on the first non-null object of a chain level.
+ * @return  @c false if the hop is still unresolved, i.e. all chains of the level are null.
+ */
+template<typename HopT>
+inline bool resolveOnFirst(HopT& hop, const uint8_t* const* cur, std::size_t n)
+{
+    for (std::size_t i = 0; !hop.isResolved() && i < n; ++i)
+    {
+        if (cur[i]) hop.resolve(cur[i]);
+    }
+    return hop.isResolved();
+}
+
+/**
+ * @internal
+ * @brief   Advances a block of chains by one hop, null chains stay null.
+ * @param   cur     The current objects of the chains, replaced by the pointed-to objects.
+ * @param   n       The number of chains in the block.
+ * @param   hop     The hop.
+ */
+template<typename HopT>
+inline void advanceChains(const uint8_t** cur, std::size_t n, HopT& hop)
+{
+    if (!resolveOnFirst(hop, cur, n)) return;
+    auto offs = hop.offset();
+
+    // Issue all misses of the level before the first load blocks on one of them.
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (cur[i]) platform::prefetch(cur[i] + offs);
+    }
+
+    std::size_t i = 0;
+#   ifdef REMODEL_GATHER_AVX2
+    if (sizeof(void*) == 8)
+    {
+        auto zero  = _mm256_setzero_si256();
+        auto ones  = _mm256_set1_epi64x(-1);
+        auto vOffs = _mm256_set1_epi64x(offs);
+        for (; i + 4 <= n; i += 4)
+        {
+            auto ptrs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + i));
+            auto live = _mm256_xor_si256(_mm256_cmpeq_epi64(ptrs, zero), ones);
+
+            // Absolute addresses as indices, masked lanes keep their null pointer.
+            auto next = _mm256_mask_i64gather_epi64(zero, static_cast<const long long*>(nullptr), 
+                _mm256_add_epi64(ptrs, vOffs), live, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cur + i), next);
+        }
+    }
+#   endif // ifdef REMODEL_GATHER_AVX2
+
+    for (; i < n; ++i)
+    {
+        if (cur[i]) std::memcpy(&cur[i], cur[i] + offs, sizeof(cur[i]));
+    }
+}
+
+/**
+ * @internal
+ * @brief   Walks chains block-wise and gathers the final field, see `walkPointerChains`.
+ * @param   root    Function returning the first object of a chain by its index.
+ */
+template<typename RootFuncT, typename TargetT, typename... HopsT>
+inline std::size_t walkChains(RootFuncT&& root, std::size_t count, TargetT& target, 
+    HopsT&... hops)
+{
+    const uint8_t* cur[kChainBlockSize];
+    std::size_t complete = 0;
+    bool targetResolved = false;
+
+    for (std::size_t begin = 0; begin < count; begin += kChainBlockSize)
+    {
+        auto n = std::min(kChainBlockSize, count - begin);
+        for (std::size_t i = 0; i < n; ++i) cur[i] = root(begin + i);
+
+        forEachArg([&](auto& hop) { advanceChains(cur, n, hop); }, hops...);
+
+        for (std::size_t i = 0; !targetResolved && i < n; ++i)
+        {
+            if (cur[i]) target.resolve(cur[i]), targetResolved = true;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (cur[i]) platform::prefetch(cur[i] + target.offset());
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (cur[i]) 
+            {
+                target.gather(cur[i], begin + i);
+                ++complete;
+            }
+            else
+            {
+                target.clear(begin + i);
+            }
+        }
+    }
+
+    return complete;
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [gatherInto]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Creates a gather target for a field described by a `FieldDesc`.
+ * @tparam  T       The type of the field represent.
+ * @tparam  offsT   The offset of the field inside of the wrapped object, in bytes.
+ * @param   desc    The field descriptor.
+ * @param   out     The output array, large enough to hold one element per gathered object.
+ * @return  The gather target, to be passed to `gatherFields`.
+ */
+template<typename T, std::ptrdiff_t offsT>
+inline internal::GatherTarget<typename FieldDesc<T, offsT>::Type, FieldDesc<T, offsT>::kDoExtraDref>
+gatherInto(FieldDesc<T, offsT> /*desc*/, typename FieldDesc<T, offsT>::Type* out)
+{
+    return {offsT, out};
+}
+
+/**
+ * @brief   Creates a gather target for a field member of a wrapper.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ * @param   field       Pointer to the field member, e.g. `&Entity::health`.
+ * @param   out         The output array, large enough to hold one element per gathered object.
+ * @return  The gather target, to be passed to `gatherFields`.
+ * @note    The field is required to be located at the same offset in every object (as it is the
+ *          case with offset-based fields and `StaticField`s). It is resolved by wrapping the 
+ *          first object once.
+ */
+template<typename WrapperT, typename FieldT>
+inline internal::MemberGatherTarget<WrapperT, FieldT> 
+gatherInto(FieldT WrapperT::* field, typename FieldT::RewrittenT* out)
+{
+    return {field, out};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [gatherFields]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Gathers fields from an array of objects into contiguous output arrays.
+ * @tparam  TargetsT    The gather target types.
+ * @param   base        Pointer to the first object.
+ * @param   stride      The distance between two objects, in bytes.
+ * @param   count       The number of objects.
+ * @param   targets     The gather targets created using `gatherInto`.
+ *                      
+ * The objects are visited in a single pass, prefetching ahead. When compiled with AVX2 support, 
+ * 4 and 8 byte fields are copied using SIMD gathers.
+ */
+template<typename... TargetsT>
+inline void gatherFields(const void* base, std::size_t stride, std::size_t count, 
+    TargetsT... targets)
+{
+    static_assert(sizeof...(TargetsT) > 0, "at least one gather target is required");
+    if (!count) return;
+
+    internal::forEachArg([&](auto& target) { target.resolve(base); }, targets...);
+
+    auto bytes = static_cast<const uint8_t*>(base);
+    std::size_t i = 0;
+
+#   ifdef REMODEL_GATHER_AVX2
+    // The gather instructions take 32 bit offsets for 32 bit elements.
+    if (stride <= static_cast<std::size_t>(INT32_MAX / 8))
+    {
+        auto s = static_cast<int>(stride);
+        auto idx32   = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+        auto idx64lo = _mm256_setr_epi64x(0,     s,     2 * s, 3 * s);
+        auto idx64hi = _mm256_setr_epi64x(4 * s, 5 * s, 6 * s, 7 * s);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            auto block = bytes + i * stride;
+            for (std::size_t j = 0; j < 8; ++j)
+            {
+                if (i + j + internal::kGatherPrefetchDistance < count)
+                {
+                    platform::prefetch(
+                        block + (j + internal::kGatherPrefetchDistance) * stride);
+                }
+            }
+
+            internal::forEachArg([&](const auto& target) 
+            {
+                target.gather8(block, stride, idx32, idx64lo, idx64hi, i);
+            }, targets...);
+        }
+    }
+#   endif // ifdef REMODEL_GATHER_AVX2
+
+    for (; i < count; ++i)
+    {
+        auto obj = bytes + i * stride;
+        if (i + internal::kGatherPrefetchDistance < count)
+        {
+            platform::prefetch(obj + internal::kGatherPrefetchDistance * stride);
+        }
+
+        internal::forEachArg([&](const auto& target) { target.gather(obj, i); }, targets...);
+    }
+}
+
+/**
+ * @brief   Gathers fields from an array of wrapped objects into contiguous output arrays.
+ * @tparam  WrapperT    Type of the wrapper, the stride is taken from `WrapperT::kObjSize`.
+ * @tparam  TargetsT    The gather target types.
+ * @param   base        Pointer to the first object.
+ * @param   count       The number of objects.
+ * @param   targets     The gather targets created using `gatherInto`.
+ * @see     gatherFields(const void*, std::size_t, std::size_t, TargetsT...)
+ */
+template<typename WrapperT, typename... TargetsT>
+inline void gatherFields(const void* base, std::size_t count, TargetsT... targets)
+{
+    gatherFields(base, WrapperT::kObjSize, count, targets...);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [walkPointerChains]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Creates a chain hop for a pointer field described by a `FieldDesc`.
+ * @param   desc    The field descriptor.
+ * @return  The hop, to be passed to `walkPointerChains`.
+ */
+template<typename T, std::ptrdiff_t offsT>
+inline internal::ChainHop chainHop(FieldDesc<T, offsT> /*desc*/)
+{
+    static_assert(std::is_pointer<typename FieldDesc<T, offsT>::Type>::value 
+        && !FieldDesc<T, offsT>::kDoExtraDref, "chain hops have to be pointer fields");
+    return internal::ChainHop{offsT};
+}
+
+/**
+ * @brief   Creates a chain hop for a pointer field member of a wrapper.
+ * @param   field   Pointer to the field member, e.g. `&Entity::component`.
+ * @return  The hop, to be passed to `walkPointerChains`.
+ * @note    The field is required to be located at the same offset in every object. It is 
+ *          resolved by wrapping the first object reached at its level once.
+ */
+template<typename WrapperT, typename FieldT>
+inline internal::MemberChainHop<WrapperT, FieldT> chainHop(FieldT WrapperT::* field)
+{
+    static_assert(std::is_pointer<typename FieldT::RewrittenT>::value, 
+        "chain hops have to be pointer fields");
+    return internal::MemberChainHop<WrapperT, FieldT>{field};
+}
+
+/**
+ * @brief   Follows pointer chains starting at many objects and gathers a field at their ends.
+ * @param   roots   The first objects of the chains.
+ * @param   count   The number of chains.
+ * @param   target  The gather target created using `gatherInto` for the field of the last object.
+ * @param   hops    The pointers to follow, in order, created using `chainHop`.
+ * @return  The number of complete chains. Chains running into a null pointer yield a 
+ *          value-initialized element.
+ *          
+ * Following `obj->component->transform->pos` object by object serializes one cache miss per hop.
+ * Instead, blocks of chains are advanced in lockstep, one hop at a time, prefetching the whole 
+ * level before loading it, so the misses of different chains overlap. When compiled with AVX2 
+ * support, four pointers are loaded per SIMD gather.
+ *
+ * @code
+ *      std::vector<float> x(count);
+ *      walkPointerChains(entities, count, gatherInto(&Transform::x, x.data()), 
+ *          chainHop(&Entity::component), chainHop(&Component::transform));
+ * @endcode
+ */
+template<typename TargetT, typename... HopsT>
+inline std::size_t walkPointerChains(const void* const* roots, std::size_t count, 
+    TargetT target, HopsT... hops)
+{
+    return internal::walkChains([&](std::size_t i) 
+    { 
+        return static_cast<const uint8_t*>(roots[i]); 
+    }, count, target, hops...);
+}
+
+/**
+ * @brief   Follows pointer chains starting at the objects of an array.
+ * @param   base    Pointer to the first object.
+ * @param   stride  The distance between two objects, in bytes.
+ * @see     walkPointerChains(const void* const*, std::size_t, TargetT, HopsT...)
+ */
+template<typename TargetT, typename... HopsT>
+inline std::size_t walkPointerChains(const void* base, std::size_t stride, std::size_t count, 
+    TargetT target, HopsT... hops)
+{
+    return internal::walkChains([&](std::size_t i) 
+    { 
+        return static_cast<const uint8_t*>(base) + i * stride; 
+    }, count, target, hops...);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_GATHER_HPP
@@ -0,0 +1,2023 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_HOOK_HPP
+#define REMODEL_HOOK_HPP
+
+/**     
+ * @file
+ * @brief Contains function hooks: inline hooks (detours) for x86 and x86-64 and per-object 
+ *        vftable hooks.
+ *        
+ * `Hook` redirects a function to a detour by overwriting its first instructions with a jump. 
+ * The overwritten instructions are relocated into a trampoline, exposed as `original()`, which 
+ * continues execution behind the patch. Targets can be given as addresses or as `Function` 
+ * wrappers, reusing their `PtrGetter` resolution.
+ *
+ * @code
+ *      Function<int(*)(int)> getHealth{module, 0x1234};
+ *      Hook<int(*)(int)>* healthHook;
+ *      int healthDetour(int id) { return healthHook->original()(id) * 2; }
+ *      // ...
+ *      healthHook = new Hook<int(*)(int)>{getHealth, &healthDetour};
+ *      healthHook->install();
+ * @endcode
+ * 
+ * The patch is a single `jmp rel32`, directly to the detour if it is within +-2 GiB of the 
+ * target, else to an absolute jump placed next to the trampoline. Trampolines are plain code, 
+ * without any locking or type-erasure.
+ * 
+ * `ShadowVfTable` hooks virtual functions of a single object instead, by pointing the object to 
+ * a modified copy of its vftable. No code is patched, so neither page protections nor other 
+ * instances of the class are affected.
+ * 
+ * `NearCodeAllocator` hands out executable memory in `rel32` range of a module, for code caves
+ * reached by 5-byte jumps.
+ * 
+ * `BoundThunk` generates plain function pointers for callbacks, calling a member function on
+ * an object baked into the code, e.g. `bindThunk(horse.visit).get()`.
+ * 
+ * @warning Installing and uninstalling doesn't synchronize with other threads executing the 
+ *          patched bytes.
+ */
+
+#include "Remodel.hpp"
+
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)) \
+    && defined(REMODEL_HAS_CODE_MEMORY)
+#   define REMODEL_HAS_HOOKS
+#endif
+
+namespace remodel
+{
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [X86Instruction]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Kinds of relative branches.
+ */
+enum class X86Branch : uint8_t
+{
+    None,
+    Jmp,
+    Jcc,
+    Call,
+    /// `loop`, `jcxz` and friends, only available with 8-bit displacements.
+    Loop,
+};
+
+/**
+ * @internal
+ * @brief   Properties of a decoded instruction relevant for relocating it or extracting its 
+ *          operands.
+ */
+struct X86Instruction
+{
+    /// The length of the instruction, in bytes.
+    uint8_t   length;
+    /// The offset of a RIP-relative `disp32`, negative if none.
+    int8_t    ripDispOffset;
+    /// The offset of a relative branch displacement, negative if none.
+    int8_t    relOffset;
+    /// The size of the branch displacement, in bytes.
+    uint8_t   relSize;
+    /// The kind of relative branch.
+    X86Branch branch;
+    /// The condition code of conditional jumps.
+    uint8_t   condition;
+    /// Whether execution never continues with the next instruction (`ret`, `jmp`, ...).
+    bool      endsFlow;
+    /// The offset of the memory operand displacement (including RIP-relative), negative if none.
+    int8_t    dispOffset;
+    /// The size of the memory operand displacement, in bytes.
+    uint8_t   dispSize;
+    /// The offset of the immediate (or the `moffs` of `mov al/eax, [moffs]`), negative if none.
+    int8_t    immOffset;
+    /// The size of the immediate, in bytes. For `enter`, only the first immediate is reported.
+    uint8_t   immSize;
+};
+
+/**
+ * @internal
+ * @brief   Decodes the length, relocation properties and operand locations of an instruction.
+ * @param   code    The instruction.
+ * @param   is64    Whether to decode in 64-bit mode.
+ * @param   insn    Receives the instruction properties.
+ * @return  @c true on success, @c false for instructions that aren't supported (EVEX, 3DNow!, 
+ *          16-bit addressing, far branches, 16-bit relative branches).
+ */
+inline bool decodeX86(const uint8_t* code, bool is64, X86Instruction& insn)
+{
+    insn = X86Instruction{0, -1, -1, 0, X86Branch::None, 0, false, -1, 0, -1, 0};
+
+    std::size_t i = 0;
+    bool opSize16 = false;
+    bool addrSize = false;
+    for (;; ++i)
+    {
+        if (i == 14) return false;
+        auto prefix = code[i];
+        if      (prefix == 0x66) opSize16 = true;
+        else if (prefix == 0x67) addrSize = true;
+        else if (prefix != 0xF0 && prefix != 0xF2 && prefix != 0xF3 && prefix != 0x2E 
+            && prefix != 0x36 && prefix != 0x3E && prefix != 0x26 && prefix != 0x64 
+            && prefix != 0x65) break;
+    }
+
+    bool rexW = false;
+    if (is64 && (code[i] & 0xF0) == 0x40)
+    {
+        rexW = (code[i] & 0x08) != 0;
+        ++i;
+    }
+
+    std::size_t immZ = opSize16 ? 2 : 4;
+    std::size_t imm  = 0;
+    std::size_t rel  = 0;
+    bool modrm = false;
+    auto op = code[i++];
+    if (op == 0x0F)
+    {
+        auto op2 = code[i++];
+        if (op2 == 0x38)
+        {
+            ++i;
+            modrm = true;
+        }
+        else if (op2 == 0x3A)
+        {
+            ++i;
+            modrm = true;
+            imm = 1;
+        }
+        else if (op2 == 0x0F)
+        {
+            return false;
+        }
+        else if ((op2 & 0xF0) == 0x80)
+        {
+            rel = 4;
+            insn.branch    = X86Branch::Jcc;
+            insn.condition = op2 & 0x0F;
+        }
+        else if ((op2 >= 0x30 && op2 <= 0x37) || (op2 >= 0xC8 && op2 <= 0xCF) || op2 == 0x05 
+            || op2 == 0x06 || op2 == 0x07 || op2 == 0x08 || op2 == 0x09 || op2 == 0x0B 
+            || op2 == 0x0E || op2 == 0x77 || op2 == 0xA0 || op2 == 0xA1 || op2 == 0xA2 
+            || op2 == 0xA8 || op2 == 0xA9 || op2 == 0xAA)
+        {
+            insn.endsFlow = op2 == 0x0B;
+        }
+        else
+        {
+            modrm = true;
+            if ((op2 >= 0x70 && op2 <= 0x73) || op2 == 0xA4 || op2 == 0xAC || op2 == 0xBA 
+                || (op2 >= 0xC2 && op2 <= 0xC6)) imm = 1;
+        }
+    }
+    else if ((op == 0xC4 || op == 0xC5) && (is64 || (code[i] & 0xC0) == 0xC0))
+    {
+        // VEX, in 32-bit mode only if not encoding LES/LDS with a memory operand.
+        unsigned map = 1;
+        if (op == 0xC4) map = code[i++] & 0x1F;
+        ++i;
+        auto vop = code[i++];
+        modrm = !(map == 1 && vop == 0x77); // vzeroupper/vzeroall
+        if (map == 3) imm = 1;
+        else if (map == 1 && ((vop >= 0x70 && vop <= 0x73) || (vop >= 0xC2 && vop <= 0xC6))) 
+            imm = 1;
+        else if (map != 1 && map != 2) return false;
+    }
+    else if (op < 0x40 && (op & 0x07) < 6)
+    {
+        // The arithmetic group: `r/m, r`, `r, r/m` forms and `al/eax, imm` forms.
+        auto form = op & 0x07;
+        if (form < 4) modrm = true;
+        else imm = form == 4 ? 1 : immZ;
+    }
+    else if (op >= 0x70 && op <= 0x7F)
+    {
+        rel = 1;
+        insn.branch    = X86Branch::Jcc;
+        insn.condition = op & 0x0F;
+    }
+    else
+    {
+        switch (op)
+        {
+            case 0x62:
+                if (is64) return false; // EVEX
+                modrm = true;
+                break;
+            case 0x63: case 0x84: case 0x85: case 0x86: case 0x87: case 0x88: case 0x89: 
+            case 0x8A: case 0x8B: case 0x8C: case 0x8D: case 0x8E: case 0x8F: case 0xD0: 
+            case 0xD1: case 0xD2: case 0xD3: case 0xD8: case 0xD9: case 0xDA: case 0xDB: 
+            case 0xDC: case 0xDD: case 0xDE: case 0xDF: case 0xFE: case 0xFF: case 0xF6: 
+            case 0xF7:
+                modrm = true;
+                break;
+            case 0x69: case 0x81: case 0xC7:
+                modrm = true;
+                imm = immZ;
+                break;
+            case 0x6B: case 0x80: case 0x82: case 0x83: case 0xC0: case 0xC1: case 0xC6:
+                modrm = true;
+                imm = 1;
+                break;
+            case 0x68: case 0xA9:
+                imm = immZ;
+                break;
+            case 0x6A: case 0xA8: case 0xCD: case 0xD4: case 0xD5: 
+            case 0xE4: case 0xE5: case 0xE6: case 0xE7:
+                imm = 1;
+                break;
+            case 0xB0: case 0xB1: case 0xB2: case 0xB3: case 0xB4: case 0xB5: case 0xB6: 
+            case 0xB7:
+                imm = 1;
+                break;
+            case 0xB8: case 0xB9: case 0xBA: case 0xBB: case 0xBC: case 0xBD: case 0xBE: 
+            case 0xBF:
+                imm = rexW ? 8 : immZ;
+                break;
+            case 0xA0: case 0xA1: case 0xA2: case 0xA3:
+                imm = is64 ? (addrSize ? 4 : 8) : (addrSize ? 2 : 4);
+                break;
+            case 0xC2: case 0xCA:
+                imm = 2;
+                insn.endsFlow = true;
+                break;
+            case 0xC3: case 0xCB: case 0xCF:
+                insn.endsFlow = true;
+                break;
+            case 0xC8:
+                imm = 3;
+                break;
+            case 0xE0: case 0xE1: case 0xE2: case 0xE3:
+                rel = 1;
+                insn.branch = X86Branch::Loop;
+                break;
+            case 0xE8:
+                rel = 4;
+                insn.branch = X86Branch::Call;
+                break;
+            case 0xE9: case 0xEB:
+                rel = op == 0xE9 ? 4 : 1;
+                insn.branch   = X86Branch::Jmp;
+                insn.endsFlow = true;
+                break;
+            case 0x9A: case 0xEA:
+                return false;
+            default:
+                break;
+        }
+    }
+
+    if (rel && opSize16) return false;
+
+    if (modrm)
+    {
+        auto modrmByte = code[i++];
+        auto mod = modrmByte >> 6;
+        auto reg = (modrmByte >> 3) & 0x07;
+        auto rm  = modrmByte & 0x07;
+        if (mod != 3)
+        {
+            if (!is64 && addrSize) return false;
+
+            std::size_t disp = mod == 1 ? 1 : mod == 2 ? 4 : 0;
+            if (rm == 4)
+            {
+                auto sib = code[i++];
+                if (mod == 0 && (sib & 0x07) == 5) disp = 4;
+            }
+            else if (mod == 0 && rm == 5)
+            {
+                disp = 4;
+                if (is64) insn.ripDispOffset = static_cast<int8_t>(i);
+            }
+            if (disp)
+            {
+                insn.dispOffset = static_cast<int8_t>(i);
+                insn.dispSize   = static_cast<uint8_t>(disp);
+            }
+            i += disp;
+        }
+
+        if (op == 0xF6 && reg < 2) imm = 1;
+        if (op == 0xF7 && reg < 2) imm = immZ;
+        if (op == 0xFF && (reg == 4 || reg == 5)) insn.endsFlow = true;
+    }
+
+    if (rel)
+    {
+        insn.relOffset = static_cast<int8_t>(i);
+        insn.relSize   = static_cast<uint8_t>(rel);
+        i += rel;
+    }
+    if (imm)
+    {
+        insn.immOffset = static_cast<int8_t>(i);
+        insn.immSize   = static_cast<uint8_t>(imm == 3 ? 2 : imm);
+    }
+    i += imm;
+
+    if (i > 15) return false;
+    insn.length = static_cast<uint8_t>(i);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief   Decodes an instruction used as padding between functions.
+ * @param   code    The instruction.
+ * @param   is64    Whether to decode in 64-bit mode.
+ * @return  The length of the instruction if it is `int3` or a (multi-byte) NOP, else zero.
+ */
+inline std::size_t x86PaddingLength(const uint8_t* code, bool is64)
+{
+    if (code[0] == 0xCC || code[0] == 0x90) return 1;
+
+    // `66 90` and `0F 1F /0`, with any number of operand size and segment prefixes.
+    std::size_t i = 0;
+    while (code[i] == 0x66 || code[i] == 0x2E)
+    {
+        if (++i == 15) return 0;
+    }
+    bool isNop = code[i] == 0x90 
+        || (code[i] == 0x0F && code[i + 1] == 0x1F && ((code[i + 2] >> 3) & 7) == 0);
+    X86Instruction insn;
+    if (!isNop || !decodeX86(code, is64, insn)) return 0;
+    return insn.length;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [Code emission]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Calculates a `rel32` displacement.
+ * @param   from    The address of the end of the instruction.
+ * @param   to      The destination.
+ * @param   rel     Receives the displacement.
+ * @return  @c true if in range, else @c false.
+ */
+inline bool rel32Displacement(uintptr_t from, uintptr_t to, int32_t& rel)
+{
+    auto delta = static_cast<intptr_t>(to - from);
+    if (sizeof(void*) == 8 && (delta < INT32_MIN || delta > INT32_MAX)) return false;
+    rel = static_cast<int32_t>(delta);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief   Emits a `jmp`/`call` (`opcode`) with a `rel32` displacement.
+ * @return  The number of bytes written or zero if the destination is out of range.
+ */
+inline std::size_t emitRel32(uint8_t* out, const uint8_t* opcode, std::size_t opcodeSize, 
+    uintptr_t to)
+{
+    int32_t rel;
+    auto size = opcodeSize + 4;
+    if (!rel32Displacement(reinterpret_cast<uintptr_t>(out) + size, to, rel)) return 0;
+    std::memcpy(out, opcode, opcodeSize);
+    std::memcpy(out + opcodeSize, &rel, sizeof(rel));
+    return size;
+}
+
+/**
+ * @internal
+ * @brief   Emits a jump to an arbitrary address (`jmp rel32`, else `jmp [rip]` on x86-64).
+ * @return  The number of bytes written (at most `kMaxAbsJumpSize`).
+ */
+inline std::size_t emitJump(uint8_t* out, uintptr_t to)
+{
+    const uint8_t kJmp[] = {0xE9};
+    auto size = emitRel32(out, kJmp, sizeof(kJmp), to);
+    if (size) return size;
+
+    const uint8_t kJmpRip[] = {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+    std::memcpy(out, kJmpRip, sizeof(kJmpRip));
+    uint64_t abs = to;
+    std::memcpy(out + sizeof(kJmpRip), &abs, sizeof(abs));
+    return sizeof(kJmpRip) + sizeof(abs);
+}
+
+const std::size_t kMaxAbsJumpSize = 14;
+
+/**
+ * @internal
+ * @brief   Copies an instruction to another address, fixing up relative addressing.
+ * @param   src     The instruction.
+ * @param   insn    The decoded instruction.
+ * @param   out     The destination.
+ * @return  The number of bytes written (at most `insn.length + 4`), zero if not relocatable.
+ */
+inline std::size_t relocateX86(const uint8_t* src, const X86Instruction& insn, uint8_t* out)
+{
+    auto srcEnd = reinterpret_cast<uintptr_t>(src) + insn.length;
+    if (insn.branch != X86Branch::None)
+    {
+        int32_t rel;
+        if (insn.relSize == 1) rel = static_cast<int8_t>(src[insn.relOffset]);
+        else std::memcpy(&rel, src + insn.relOffset, sizeof(rel));
+        auto to = srcEnd + static_cast<intptr_t>(rel);
+
+        // Short forms are widened to `rel32`.
+        const uint8_t kJmp[]  = {0xE9};
+        const uint8_t kCall[] = {0xE8};
+        const uint8_t kJcc[]  = {0x0F, static_cast<uint8_t>(0x80 | insn.condition)};
+        switch (insn.branch)
+        {
+            case X86Branch::Jmp:  return emitRel32(out, kJmp,  sizeof(kJmp),  to);
+            case X86Branch::Call: return emitRel32(out, kCall, sizeof(kCall), to);
+            case X86Branch::Jcc:  return emitRel32(out, kJcc,  sizeof(kJcc),  to);
+            default:              return 0;
+        }
+    }
+
+    std::memcpy(out, src, insn.length);
+    if (insn.ripDispOffset >= 0)
+    {
+        int32_t disp;
+        std::memcpy(&disp, src + insn.ripDispOffset, sizeof(disp));
+        auto to = srcEnd + static_cast<intptr_t>(disp);
+        if (!rel32Displacement(reinterpret_cast<uintptr_t>(out) + insn.length, to, disp)) return 0;
+        std::memcpy(out + insn.ripDispOffset, &disp, sizeof(disp));
+    }
+    return insn.length;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [HookArena]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_HOOKS
+
+/**
+ * @internal
+ * @brief   Allocator for trampolines close to their targets.
+ *          
+ * Memory is never released: after uninstalling, other threads might still be executing a 
+ * trampoline.
+ */
+class HookArena
+{
+    struct Block
+    {
+        uint8_t*    begin;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    static const std::size_t kBlockSize = 64 * 1024;
+
+    std::mutex         m_mutex;
+    std::vector<Block> m_blocks;
+public:
+    /**
+     * @brief   Gets the process-wide instance.
+     */
+    static HookArena& instance()
+    {
+        static HookArena arena;
+        return arena;
+    }
+
+    /**
+     * @brief   Allocates executable memory in `rel32` range of an address.
+     * @param   target  The address.
+     * @param   size    The size of the allocation.
+     * @return  The allocation or @c nullptr on failure.
+     */
+    uint8_t* allocate(const void* target, std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto from = reinterpret_cast<uintptr_t>(target);
+        for (auto& block : m_blocks)
+        {
+            auto begin = reinterpret_cast<uintptr_t>(block.begin);
+            auto span  = begin > from ? begin + block.size - from : from - begin;
+            if (block.size - block.used < size || (sizeof(void*) == 8 && span >= 0x7FFF0000)) 
+                continue;
+
+            auto result = block.begin + block.used;
+            block.used += size;
+            return result;
+        }
+
+        auto memory = static_cast<uint8_t*>(platform::allocateCodeNear(target, kBlockSize));
+        if (!memory) return nullptr;
+        m_blocks.push_back({memory, kBlockSize, size});
+        return memory;
+    }
+};
+
+#endif // ifdef REMODEL_HAS_HOOKS
+
+// ---------------------------------------------------------------------------------------------- //
+// [InlineHook]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Untyped implementation of `Hook`.
+ */
+class InlineHook
+{
+public:
+    /// The size of the patch written to the target.
+    static const std::size_t kPatchSize = 5;
+    /// The maximum number of bytes taken from the target (a patch plus a partial instruction).
+    static const std::size_t kMaxStolen = kPatchSize + 15 - 1;
+private:
+    /// Layout of an arena slot: the relay jump to the detour, followed by the trampoline.
+    static const std::size_t kRelaySize      = 16;
+    static const std::size_t kTrampolineSize = 112;
+
+    uint8_t*    m_target;
+    const void* m_detour;
+    uint8_t*    m_trampoline = nullptr;
+    std::size_t m_stolen     = 0;
+    uint8_t     m_original[kMaxStolen];
+    uint8_t     m_patch[kMaxStolen];
+    /// Offsets of the relocated instructions in the target and in the trampoline.
+    uint8_t     m_targetOffsets[kMaxStolen];
+    uint8_t     m_trampolineOffsets[kMaxStolen];
+    std::size_t m_insnCount  = 0;
+    bool        m_installed  = false;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   target  The function to hook.
+     * @param   detour  The function to redirect to.
+     */
+    InlineHook(void* target, const void* detour)
+        : m_target{static_cast<uint8_t*>(target)}
+        , m_detour{detour}
+    {}
+
+    InlineHook(const InlineHook&) = delete;
+    InlineHook& operator = (const InlineHook&) = delete;
+
+    /**
+     * @brief   Builds the trampoline and the patch, without modifying the target.
+     * @return  @c true on success (or if already prepared), @c false if the target's first 
+     *          instructions can't be relocated, no memory close to the target is available or 
+     *          hooks aren't supported on this platform.
+     */
+    bool prepare()
+    {
+        if (m_trampoline) return true;
+#   ifdef REMODEL_HAS_HOOKS
+        if (!m_target || !m_detour) return false;
+        auto slot = HookArena::instance().allocate(m_target, kRelaySize + kTrampolineSize);
+        if (!slot) return false;
+
+        // Relocate whole instructions until there is room for the patch.
+        const bool kIs64 = sizeof(void*) == 8;
+        auto trampoline = slot + kRelaySize;
+        auto targetAddr = reinterpret_cast<uintptr_t>(m_target);
+        uintptr_t branchTargets[kMaxStolen];
+        std::size_t branchCount = 0;
+        std::size_t stolen  = 0;
+        std::size_t emitted = 0;
+        std::size_t insnCount = 0;
+        while (stolen < kPatchSize)
+        {
+            X86Instruction insn;
+            if (!decodeX86(m_target + stolen, kIs64, insn)) return false;
+            if (emitted + insn.length + 4 + kMaxAbsJumpSize > kTrampolineSize) return false;
+
+            auto size = relocateX86(m_target + stolen, insn, trampoline + emitted);
+            if (!size) return false;
+
+            if (insn.branch != X86Branch::None)
+            {
+                int32_t rel;
+                if (insn.relSize == 1) rel = static_cast<int8_t>(m_target[stolen + insn.relOffset]);
+                else std::memcpy(&rel, m_target + stolen + insn.relOffset, sizeof(rel));
+                branchTargets[branchCount++] = targetAddr + stolen + insn.length + rel;
+            }
+            m_targetOffsets[insnCount]     = static_cast<uint8_t>(stolen);
+            m_trampolineOffsets[insnCount] = static_cast<uint8_t>(emitted);
+            ++insnCount;
+            stolen  += insn.length;
+            emitted += size;
+
+            // Functions shorter than the patch are fine if followed by padding.
+            if (insn.endsFlow && stolen < kPatchSize)
+            {
+                for (auto i = stolen; i < kPatchSize;)
+                {
+                    auto padding = x86PaddingLength(m_target + i, kIs64);
+                    if (!padding) return false;
+                    i += padding;
+                }
+                stolen = kPatchSize;
+            }
+        }
+
+        // Branches into the overwritten bytes can't be redirected.
+        for (std::size_t i = 0; i < branchCount; ++i)
+        {
+            if (branchTargets[i] > targetAddr && branchTargets[i] < targetAddr + stolen) 
+                return false;
+        }
+        emitJump(trampoline + emitted, targetAddr + stolen);
+
+        // Jump to the detour directly if possible, else through the relay.
+        auto detourAddr = reinterpret_cast<uintptr_t>(m_detour);
+        int32_t rel = 0;
+        if (!rel32Displacement(targetAddr + kPatchSize, detourAddr, rel))
+        {
+            emitJump(slot, detourAddr);
+            if (!rel32Displacement(targetAddr + kPatchSize, reinterpret_cast<uintptr_t>(slot), rel))
+                return false;
+        }
+        m_patch[0] = 0xE9;
+        std::memcpy(m_patch + 1, &rel, sizeof(rel));
+        std::memset(m_patch + kPatchSize, 0xCC, stolen - kPatchSize);
+
+        std::memcpy(m_original, m_target, stolen);
+        m_stolen     = stolen;
+        m_insnCount  = insnCount;
+        m_trampoline = trampoline;
+        return true;
+#   else
+        return false;
+#   endif
+    }
+
+    /**
+     * @brief   Prepares the hook if required and patches the target.
+     * @return  @c true on success (or if already installed), else @c false.
+     */
+    bool install()
+    {
+        if (m_installed) return true;
+        if (!prepare()) return false;
+#   ifdef REMODEL_HAS_HOOKS
+        if (!platform::writeCode(m_target, m_patch, m_stolen)) return false;
+        m_installed = true;
+        return true;
+#   else
+        return false;
+#   endif
+    }
+
+    /**
+     * @brief   Restores the original bytes of the target.
+     * @return  @c true on success (or if not installed), else @c false.
+     */
+    bool uninstall()
+    {
+        if (!m_installed) return true;
+#   ifdef REMODEL_HAS_HOOKS
+        if (!platform::writeCode(m_target, m_original, m_stolen)) return false;
+#   endif
+        m_installed = false;
+        return true;
+    }
+
+    /**
+     * @brief   Determines whether the target is currently patched.
+     */
+    bool isInstalled() const { return m_installed; }
+
+#   ifdef REMODEL_HAS_HOOKS
+    /**
+     * @brief   Gets the write installing or uninstalling the hook, for batching the writes of 
+     *          many hooks. Requires the hook to be prepared.
+     * @param   install @c true for the patch, @c false for the original bytes.
+     */
+    platform::CodeWrite codeWrite(bool install) const 
+    { 
+        return {m_target, install ? m_patch : m_original, m_stolen}; 
+    }
+
+    /**
+     * @brief   Records that the write from `codeWrite` was applied.
+     */
+    void markInstalled(bool installed) { m_installed = installed; }
+#   endif
+
+    /**
+     * @brief   Gets the hooked function.
+     */
+    void* target() const { return m_target; }
+
+    /**
+     * @brief   Gets the trampoline, @c nullptr if not prepared.
+     */
+    void* trampoline() const { return m_trampoline; }
+
+    /**
+     * @brief   Moves an instruction pointer out of the bytes about to be patched.
+     * @param   ip  The instruction pointer of a suspended thread.
+     * @return  The matching location in the trampoline if @c ip points to one of the relocated 
+     *          instructions, else @c ip. Requires `prepare`.
+     */
+    uintptr_t relocateInstructionPointer(uintptr_t ip) const
+    {
+        auto targetAddr = reinterpret_cast<uintptr_t>(m_target);
+        for (std::size_t i = 0; i < m_insnCount; ++i)
+        {
+            if (ip == targetAddr + m_targetOffsets[i]) 
+                return reinterpret_cast<uintptr_t>(m_trampoline) + m_trampolineOffsets[i];
+        }
+        return ip;
+    }
+
+    /**
+     * @brief   Gets the bytes written to the target by `install`, valid after `prepare`.
+     */
+    const uint8_t* patchBytes() const { return m_patch; }
+
+    /**
+     * @brief   Gets the original bytes of the target, valid after `prepare`.
+     */
+    const uint8_t* originalBytes() const { return m_original; }
+
+    /**
+     * @brief   Gets the number of bytes patched, valid after `prepare`.
+     */
+    std::size_t patchSize() const { return m_stolen; }
+};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [Hook]                                                                                         //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Inline hook redirecting a function to a detour.
+ * @tparam  FunctionPtrT    The function pointer type of both target and detour.
+ *                  
+ * The hook is uninstalled on destruction. Hooks of the same target have to be uninstalled in 
+ * reverse installation order. `install` and `uninstall` don't suspend other threads, use a 
+ * `HookTransaction` when the target might be executing.
+ */
+template<typename FunctionPtrT>
+class Hook
+{
+    static_assert(std::is_pointer<FunctionPtrT>::value 
+        && std::is_function<typename std::remove_pointer<FunctionPtrT>::type>::value,
+        "hooks require a function pointer type as template parameter");
+
+    internal::InlineHook m_hook;
+public:
+    /**
+     * @brief   Constructor hooking a function at an address.
+     * @param   target  The function to hook.
+     * @param   detour  The function to redirect calls to.
+     */
+    Hook(void* target, FunctionPtrT detour)
+        : m_hook{target, *reinterpret_cast<void**>(&detour)}
+    {}
+
+    /**
+     * @brief   Constructor hooking a function at an address.
+     * @param   target  The function to hook.
+     * @param   detour  The function to redirect calls to.
+     */
+    Hook(uintptr_t target, FunctionPtrT detour)
+        : Hook{reinterpret_cast<void*>(target), detour}
+    {}
+
+    /**
+     * @brief   Constructor hooking a function pointer.
+     * @param   target  The function to hook.
+     * @param   detour  The function to redirect calls to.
+     */
+    Hook(FunctionPtrT target, FunctionPtrT detour)
+        : Hook{*reinterpret_cast<void**>(&target), detour}
+    {}
+
+    /**
+     * @brief   Constructor hooking the function a wrapper resolves to.
+     * @param   target  The function to hook.
+     * @param   detour  The function to redirect calls to.
+     */
+    template<typename PtrGetterT>
+    Hook(const Function<FunctionPtrT, PtrGetterT>& target, FunctionPtrT detour)
+        : Hook{target.get(), detour}
+    {}
+
+    Hook(const Hook&) = delete;
+    Hook& operator = (const Hook&) = delete;
+
+    /**
+     * @brief   Destructor uninstalling the hook.
+     */
+    ~Hook() { m_hook.uninstall(); }
+
+    /**
+     * @brief   Installs the hook.
+     * @return  @c true on success (or if already installed), else @c false.
+     */
+    bool install() { return m_hook.install(); }
+
+    /**
+     * @brief   Uninstalls the hook.
+     * @return  @c true on success (or if not installed), else @c false.
+     */
+    bool uninstall() { return m_hook.uninstall(); }
+
+    /**
+     * @brief   Determines whether the hook is installed.
+     */
+    bool isInstalled() const { return m_hook.isInstalled(); }
+
+    /**
+     * @brief   Gets the hooked function.
+     * @warning Calling this while installed calls the detour.
+     */
+    FunctionPtrT target() const { return (FunctionPtrT)m_hook.target(); }
+
+    /**
+     * @brief   Gets a function calling the original, unhooked code.
+     *          
+     * This is the trampoline once installed (or prepared), else the target itself.
+     */
+    FunctionPtrT original() const
+    {
+        auto trampoline = m_hook.trampoline();
+        return (FunctionPtrT)(trampoline ? trampoline : m_hook.target());
+    }
+
+    /**
+     * @brief   Calls the original, unhooked code, emitting a trace record if enabled.
+     * @param   args    The arguments to pass.
+     * @return  The result of the original.
+     * @see     trace::emit
+     */
+    template<typename... ArgsT>
+    auto callOriginal(ArgsT&&... args) const 
+        -> decltype(std::declval<FunctionPtrT>()(std::forward<ArgsT>(args)...))
+    {
+        trace::emit(trace::CallKind::HookOriginal, m_hook.target(), args...);
+        return original()(std::forward<ArgsT>(args)...);
+    }
+
+    /**
+     * @brief   Gets the untyped implementation.
+     */
+    internal::InlineHook& impl() { return m_hook; }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [HookTransaction]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Installs and uninstalls a set of hooks at once.
+ *          
+ * `commit` prepares all trampolines first, then suspends the other threads a single time for 
+ * patching every target. Threads stopped inside the bytes being overwritten are moved to the 
+ * corresponding instruction in the trampoline. Page protections are changed once per range of 
+ * pages containing targets, not once per hook.
+ * 
+ * @code
+ *      HookTransaction transaction;
+ *      transaction.install(healthHook).install(ammoHook).uninstall(oldHook);
+ *      if (!transaction.commit()) { ... }
+ * @endcode
+ * 
+ * @note    Return addresses into the patched bytes (threads inside a `call` relocated into a 
+ *          trampoline) are not fixed up.
+ * @note    Without `REMODEL_HAS_THREAD_FREEZE`, targets are patched without suspending threads.
+ */
+class HookTransaction
+{
+    struct Entry
+    {
+        internal::InlineHook* hook;
+        bool                  install;
+    };
+
+    std::vector<Entry> m_entries;
+public:
+    /**
+     * @brief   Adds a hook to be installed.
+     * @return  `*this`.
+     */
+    template<typename FunctionPtrT>
+    HookTransaction& install(Hook<FunctionPtrT>& hook) 
+    { 
+        m_entries.push_back({&hook.impl(), true}); 
+        return *this;
+    }
+
+    /**
+     * @brief   Adds a hook to be uninstalled.
+     * @return  `*this`.
+     */
+    template<typename FunctionPtrT>
+    HookTransaction& uninstall(Hook<FunctionPtrT>& hook) 
+    { 
+        m_entries.push_back({&hook.impl(), false}); 
+        return *this;
+    }
+
+    /**
+     * @brief   Gets the number of pending operations.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @brief   Drops all pending operations.
+     */
+    void clear() { m_entries.clear(); }
+
+    /**
+     * @brief   Applies all pending operations.
+     * @return  @c true on success. @c false if a hook couldn't be prepared, threads couldn't 
+     *          be suspended or page protections couldn't be changed, in which case nothing was 
+     *          changed.
+     *          
+     * The pending operations are kept, committing again retries the failed ones.
+     */
+    bool commit()
+    {
+        for (const auto& entry : m_entries)
+        {
+            if (entry.install && !entry.hook->prepare()) return false;
+        }
+
+#       ifdef REMODEL_HAS_THREAD_FREEZE
+            platform::ThreadFreeze freeze;
+            if (!freeze.freeze()) return false;
+            freeze.forEachThread([this](uintptr_t& ip)
+            {
+                for (const auto& entry : m_entries)
+                {
+                    if (entry.install && !entry.hook->isInstalled()) 
+                        ip = entry.hook->relocateInstructionPointer(ip);
+                }
+            });
+#       endif
+
+#       ifdef REMODEL_HAS_HOOKS
+            // All targets are written with a single protection change per page range.
+            std::vector<platform::CodeWrite> writes;
+            std::vector<Entry> applied;
+            for (const auto& entry : m_entries)
+            {
+                if (entry.install == entry.hook->isInstalled()) continue;
+                writes.push_back(entry.hook->codeWrite(entry.install));
+                applied.push_back(entry);
+            }
+            if (!platform::writeCodeBatch(writes.data(), writes.size())) return false;
+            for (const auto& entry : applied) entry.hook->markInstalled(entry.install);
+            return true;
+#       else
+            bool success = true;
+            for (const auto& entry : m_entries)
+            {
+                success &= entry.install ? entry.hook->install() : entry.hook->uninstall();
+            }
+            return success;
+#       endif
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [PatchTransaction]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_CODE_MEMORY
+
+/**
+ * @brief   Applies a set of patches to (usually read-only) code or data at once.
+ *          
+ * The pages of all patches are coalesced into ranges, so page protections are changed once per
+ * range instead of once per patch (see `platform::writeCodeBatch`). The bytes overwritten are 
+ * saved, `revert` restores them in a single batch as well.
+ * 
+ * @code
+ *      PatchTransaction patches;
+ *      patches.write(base + 0x1234, {0x90, 0x90}).write(base + 0x2000, uint32_t{100});
+ *      if (!patches.commit()) { ... }
+ * @endcode
+ * 
+ * @note    Patches must not overlap.
+ */
+class PatchTransaction
+{
+    struct Entry
+    {
+        void*       address;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::vector<Entry>   m_entries;
+    std::vector<uint8_t> m_patched;
+    std::vector<uint8_t> m_original;
+    bool                 m_committed = false;
+public:
+    /**
+     * @brief   Adds a patch.
+     * @param   address The address to patch.
+     * @param   data    The bytes to write, copied.
+     * @param   size    The number of bytes.
+     * @return  `*this`.
+     */
+    PatchTransaction& write(void* address, const void* data, std::size_t size)
+    {
+        m_entries.push_back({address, m_patched.size(), size});
+        auto bytes = static_cast<const uint8_t*>(data);
+        m_patched.insert(m_patched.end(), bytes, bytes + size);
+        return *this;
+    }
+
+    /**
+     * @copydoc write(void*, const void*, std::size_t)
+     */
+    PatchTransaction& write(void* address, std::initializer_list<uint8_t> bytes)
+    {
+        return write(address, bytes.begin(), bytes.size());
+    }
+
+    /**
+     * @brief   Adds a patch writing a value.
+     * @param   address The address to patch.
+     * @param   value   The value to write.
+     * @return  `*this`.
+     */
+    template<typename T>
+    PatchTransaction& write(void* address, const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, 
+            "only trivially copyable values can be patched in");
+        return write(address, &value, sizeof(value));
+    }
+
+    /**
+     * @brief   Gets the number of patches.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @brief   Determines whether the patches are currently applied.
+     */
+    bool isCommitted() const { return m_committed; }
+
+    /**
+     * @brief   Drops all patches, without reverting them.
+     */
+    void clear() 
+    { 
+        m_entries.clear(); 
+        m_patched.clear();
+        m_original.clear();
+        m_committed = false;
+    }
+
+    /**
+     * @brief   Applies all patches.
+     * @return  @c true on success (or if already committed). @c false if page protections 
+     *          couldn't be changed, in which case nothing was written.
+     */
+    bool commit()
+    {
+        if (m_committed) return true;
+
+        m_original.resize(m_patched.size());
+        for (const auto& entry : m_entries)
+            std::memcpy(m_original.data() + entry.offset, entry.address, entry.size);
+        m_committed = apply(m_patched);
+        return m_committed;
+    }
+
+    /**
+     * @brief   Restores the bytes overwritten by `commit`.
+     * @return  @c true on success (or if not committed), else @c false.
+     */
+    bool revert()
+    {
+        if (!m_committed) return true;
+        m_committed = !apply(m_original);
+        return !m_committed;
+    }
+private:
+    bool apply(const std::vector<uint8_t>& bytes) const
+    {
+        std::vector<platform::CodeWrite> writes;
+        writes.reserve(m_entries.size());
+        for (const auto& entry : m_entries)
+            writes.push_back({entry.address, bytes.data() + entry.offset, entry.size});
+        return platform::writeCodeBatch(writes.data(), writes.size());
+    }
+};
+
+#endif // ifdef REMODEL_HAS_CODE_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [NearCodeAllocator]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_CODE_MEMORY
+
+/**
+ * @brief   Allocator for small blocks of executable memory in `rel32` range of a module.
+ *          
+ * Code placed here can be reached from anywhere in the module (and reach anywhere in it) with 
+ * 5-byte `jmp rel32`/`call rel32` instructions, instead of 14-byte absolute jumps clobbering 
+ * more of the patched code. Pages are reserved in 64 KiB blocks next to the module and blocks 
+ * are handed out from them, preferring freed blocks.
+ * 
+ * @code
+ *      NearCodeAllocator caves{Module::getModule("game.exe").value()};
+ *      auto cave = caves.allocate(32);
+ *      // ... emit code into cave, then patch a jmp rel32 to it into the module
+ * @endcode
+ * 
+ * @note    All pages are released on destruction, no thread may still be executing them then.
+ */
+class NearCodeAllocator : public zycore::NonCopyable
+{
+    struct Range
+    {
+        uint8_t*    begin;
+        std::size_t size;
+    };
+
+    static const std::size_t kPageBlockSize = 64 * 1024;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   module  The module to allocate close to.
+     */
+    explicit NearCodeAllocator(const Module& module)
+        : NearCodeAllocator{module.addressOfObj(), module.imageSize()}
+    {}
+
+    /**
+     * @brief   Constructor.
+     * @param   target      The address to allocate close to.
+     * @param   targetSize  The size of the range starting at @c target that must be in range.
+     */
+    explicit NearCodeAllocator(const void* target, std::size_t targetSize = 0)
+        : m_target{target}
+        , m_targetSize{targetSize}
+    {}
+
+    ~NearCodeAllocator()
+    {
+        for (const auto& pages : m_pages) platform::releaseCode(pages.begin, pages.size);
+    }
+
+    /**
+     * @brief   Allocates a block of executable memory.
+     * @param   size        The size of the block.
+     * @param   alignment   The alignment of the block, a power of two.
+     * @return  The block or @c nullptr on failure. The memory is readable, writable and 
+     *          executable.
+     */
+    uint8_t* allocate(std::size_t size, std::size_t alignment = 16)
+    {
+        if (!size || size > kPageBlockSize) return nullptr;
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        // Best fit, so freed blocks are reused before the rest of the pages is cut up.
+        auto best = m_free.end();
+        for (auto it = m_free.begin(); it != m_free.end(); ++it)
+        {
+            auto range = *it;
+            if (carve(range, size, alignment) && (best == m_free.end() || it->size < best->size))
+                best = it;
+        }
+        if (best != m_free.end())
+        {
+            auto block = carve(*best, size, alignment);
+            if (!best->size) m_free.erase(best);
+            return block;
+        }
+
+        auto pages = static_cast<uint8_t*>(
+            platform::allocateCodeNear(m_target, kPageBlockSize, m_targetSize));
+        if (!pages) return nullptr;
+        m_pages.push_back({pages, kPageBlockSize});
+
+        Range rest{pages, kPageBlockSize};
+        auto block = carve(rest, size, alignment);
+        if (rest.size) m_free.push_back(rest);
+        return block;
+    }
+
+    /**
+     * @brief   Returns a block for reuse.
+     * @param   block   The block, as returned by `allocate`.
+     * @param   size    The size passed to `allocate`.
+     */
+    void deallocate(uint8_t* block, std::size_t size)
+    {
+        if (!block) return;
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_free.push_back({block, size});
+    }
+
+    /**
+     * @brief   Determines whether `rel32` displacements from and to an address reach all memory
+     *          of the allocator.
+     * @param   address The address.
+     * @return  @c true if in range, else @c false.
+     */
+    bool reaches(const void* address) const
+    {
+        if (sizeof(void*) == 4) return true;
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto addr = reinterpret_cast<uintptr_t>(address);
+        for (const auto& pages : m_pages)
+        {
+            auto begin = reinterpret_cast<uintptr_t>(pages.begin);
+            auto span  = addr > begin ? addr - begin : begin + pages.size - addr;
+            if (span >= 0x7FFF0000) return false;
+        }
+        return true;
+    }
+private:
+    /// Takes an aligned block from the front of a free range, leaving the rest in the range.
+    static uint8_t* carve(Range& range, std::size_t size, std::size_t alignment)
+    {
+        auto begin   = reinterpret_cast<uintptr_t>(range.begin);
+        auto aligned = (begin + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        auto padding = static_cast<std::size_t>(aligned - begin);
+        if (range.size < padding + size) return nullptr;
+
+        // The padding is lost, code blocks are usually allocated with the same alignment.
+        range.begin += padding + size;
+        range.size  -= padding + size;
+        return reinterpret_cast<uint8_t*>(aligned);
+    }
+private:
+    const void*        m_target;
+    std::size_t        m_targetSize;
+    mutable std::mutex m_mutex;
+    std::vector<Range> m_pages;
+    std::vector<Range> m_free;
+};
+
+#endif // ifdef REMODEL_HAS_CODE_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [BoundThunk]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The ways a thunk passes the bound object to a member function.
+ */
+enum class ThunkAbi
+{
+    /// x86-64 System V: shifts the integer argument registers, the object goes to `rdi`.
+    SysV64,
+    /// x86-64 Microsoft: shifts the first three argument positions, the object goes to `rcx`.
+    Ms64,
+    /// x86 `thiscall` exposed as `stdcall`: stores the object to `ecx`.
+    X86ThisCall,
+    /// x86 `cdecl`: re-pushes the stack arguments behind the object.
+    X86Cdecl,
+    /// x86 `stdcall`: like `X86Cdecl`, additionally popping the arguments on return.
+    X86Stdcall,
+};
+
+/**
+ * @internal
+ * @brief   Describes the thunk of a member function pointer type (taking the object first).
+ */
+template<typename FunctionPtrT>
+struct BoundThunkTraits
+{
+    static const bool kSupported = false;
+};
+
+/**
+ * @internal
+ * @brief   A macro that defines the thunk traits of a calling convention.
+ * @param   targetConv      The calling convention of the member function.
+ * @param   callbackConv    The calling convention of the thunk.
+ * @param   abi             The `ThunkAbi`.
+ */
+#define REMODEL_DEF_THUNK_TRAITS(targetConv, callbackConv, abi)                                    \
+    template<typename RetT, typename... ArgsT>                                                     \
+    struct BoundThunkTraits<RetT (targetConv*)(void*, ArgsT...)>                                   \
+    {                                                                                              \
+        static const bool kSupported = true;                                                       \
+        static const ThunkAbi kAbi = abi;                                                          \
+        using CallbackPtr = RetT (callbackConv*)(ArgsT...);                                        \
+        using ArgsTuple = std::tuple<ArgsT...>;                                                    \
+        using Ret = RetT;                                                                          \
+    }
+
+#if defined(ZYCORE_MSVC) && defined(_M_X64)
+    REMODEL_DEF_THUNK_TRAITS(__cdecl, __cdecl, ThunkAbi::Ms64);
+#elif defined(ZYCORE_MSVC) && defined(_M_IX86)
+    REMODEL_DEF_THUNK_TRAITS(__cdecl, __cdecl, ThunkAbi::X86Cdecl);
+    REMODEL_DEF_THUNK_TRAITS(__stdcall, __stdcall, ThunkAbi::X86Stdcall);
+    REMODEL_DEF_THUNK_TRAITS(__thiscall, __stdcall, ThunkAbi::X86ThisCall);
+#elif defined(ZYCORE_GNUC) && defined(__x86_64__)
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        REMODEL_DEF_THUNK_TRAITS(, , ThunkAbi::Ms64);
+        REMODEL_DEF_THUNK_TRAITS(__attribute__((sysv_abi)), __attribute__((sysv_abi)), 
+            ThunkAbi::SysV64);
+#   else
+        REMODEL_DEF_THUNK_TRAITS(, , ThunkAbi::SysV64);
+        REMODEL_DEF_THUNK_TRAITS(__attribute__((ms_abi)), __attribute__((ms_abi)), 
+            ThunkAbi::Ms64);
+#   endif
+#elif defined(ZYCORE_GNUC) && defined(__i386__)
+    REMODEL_DEF_THUNK_TRAITS(__attribute__((cdecl)), __attribute__((cdecl)), 
+        ThunkAbi::X86Cdecl);
+    REMODEL_DEF_THUNK_TRAITS(__attribute__((stdcall)), __attribute__((stdcall)), 
+        ThunkAbi::X86Stdcall);
+    REMODEL_DEF_THUNK_TRAITS(__attribute__((thiscall)), __attribute__((stdcall)), 
+        ThunkAbi::X86ThisCall);
+#endif
+
+#undef REMODEL_DEF_THUNK_TRAITS
+
+/**
+ * @internal
+ * @brief   Properties of the arguments of a thunk, checked against the limits of its ABI.
+ */
+template<typename ArgsTupleT>
+struct ThunkArgs;
+
+template<typename... ArgsT>
+struct ThunkArgs<std::tuple<ArgsT...>>
+{
+    /// The number of arguments passed in integer registers by the x86-64 ABIs.
+    static constexpr std::size_t intCount()
+    {
+        const bool isInt[] = {false, (std::is_integral<ArgsT>::value || std::is_enum<ArgsT>::value
+            || std::is_pointer<ArgsT>::value || std::is_reference<ArgsT>::value)...};
+        std::size_t count = 0;
+        for (auto flag : isInt) count += flag;
+        return count;
+    }
+
+    /// Whether any argument is of class type, which x86-64 ABIs may split across registers.
+    static constexpr bool hasClass()
+    {
+        const bool isClass[] = {false, std::is_class<std::remove_reference_t<ArgsT>>::value
+            && !std::is_reference<ArgsT>::value...};
+        for (auto flag : isClass) if (flag) return true;
+        return false;
+    }
+
+    /// The size of the arguments on the x86 stack, in bytes.
+    static constexpr std::size_t stackSize()
+    {
+        const std::size_t sizes[] = {0, (sizeof(std::conditional_t<std::is_reference<ArgsT>::value, 
+            void*, ArgsT>) + 3) / 4 * 4 ...};
+        std::size_t size = 0;
+        for (auto cur : sizes) size += cur;
+        return size;
+    }
+
+    static const std::size_t kCount = sizeof...(ArgsT);
+};
+
+/**
+ * @internal
+ * @brief   The size of the code of a thunk, sufficient for 64 bytes of x86 stack arguments.
+ */
+const std::size_t kThunkSize = 128;
+
+/**
+ * @internal
+ * @brief   Emits a thunk calling a member function with a bound object.
+ * @param   abi         The ABI.
+ * @param   out         The destination, at least `kThunkSize` bytes.
+ * @param   target      The member function.
+ * @param   object      The object.
+ * @param   stackSize   The size of the stack arguments for the x86 ABIs.
+ * @return  The number of bytes written.
+ */
+inline std::size_t emitBoundThunk(ThunkAbi abi, uint8_t* out, uintptr_t target, uintptr_t object,
+    std::size_t stackSize)
+{
+    auto cur = out;
+    auto put = [&](std::initializer_list<uint8_t> bytes) 
+    { 
+        for (auto byte : bytes) *cur++ = byte; 
+    };
+    auto putImm = [&](auto imm)
+    {
+        std::memcpy(cur, &imm, sizeof(imm));
+        cur += sizeof(imm);
+    };
+
+    switch (abi)
+    {
+        case ThunkAbi::SysV64:
+            put({0x4D, 0x89, 0xC1});                                // mov r9, r8
+            put({0x49, 0x89, 0xC8});                                // mov r8, rcx
+            put({0x48, 0x89, 0xD1});                                // mov rcx, rdx
+            put({0x48, 0x89, 0xF2});                                // mov rdx, rsi
+            put({0x48, 0x89, 0xFE});                                // mov rsi, rdi
+            put({0x48, 0xBF}); putImm(static_cast<uint64_t>(object));  // mov rdi, object
+            put({0x49, 0xBB}); putImm(static_cast<uint64_t>(target));  // mov r11, target
+            put({0x41, 0xFF, 0xE3});                                // jmp r11
+            break;
+        case ThunkAbi::Ms64:
+            put({0x4D, 0x89, 0xC1});                                // mov r9, r8
+            put({0x49, 0x89, 0xD0});                                // mov r8, rdx
+            put({0x48, 0x89, 0xCA});                                // mov rdx, rcx
+            put({0x0F, 0x28, 0xDA});                                // movaps xmm3, xmm2
+            put({0x0F, 0x28, 0xD1});                                // movaps xmm2, xmm1
+            put({0x0F, 0x28, 0xC8});                                // movaps xmm1, xmm0
+            put({0x48, 0xB9}); putImm(static_cast<uint64_t>(object));  // mov rcx, object
+            put({0x48, 0xB8}); putImm(static_cast<uint64_t>(target));  // mov rax, target
+            put({0xFF, 0xE0});                                      // jmp rax
+            break;
+        case ThunkAbi::X86ThisCall:
+            put({0xB9}); putImm(static_cast<uint32_t>(object));     // mov ecx, object
+            put({0xB8}); putImm(static_cast<uint32_t>(target));     // mov eax, target
+            put({0xFF, 0xE0});                                      // jmp eax
+            break;
+        case ThunkAbi::X86Cdecl:
+        case ThunkAbi::X86Stdcall:
+        {
+            put({0x55, 0x89, 0xE5});                                // push ebp; mov ebp, esp
+            // Keeps the stack 16 byte aligned at the call, as expected by current compilers.
+            auto padding = static_cast<uint8_t>((4 - stackSize) & 15);
+            if (padding) put({0x83, 0xEC, padding});                // sub esp, padding
+            for (auto offs = stackSize; offs >= 4; offs -= 4)
+            {
+                auto disp = static_cast<uint8_t>(4 + offs);
+                put({0xFF, 0x75, disp});                            // push [ebp + disp]
+            }
+            put({0x68}); putImm(static_cast<uint32_t>(object));     // push object
+            put({0xB8}); putImm(static_cast<uint32_t>(target));     // mov eax, target
+            put({0xFF, 0xD0});                                      // call eax
+            put({0x89, 0xEC, 0x5D});                                // mov esp, ebp; pop ebp
+            if (abi == ThunkAbi::X86Stdcall) 
+            {
+                put({0xC2}); putImm(static_cast<uint16_t>(stackSize));  // ret stackSize
+            }
+            else
+            {
+                put({0xC3});                                        // ret
+            }
+            break;
+        }
+    }
+    return static_cast<std::size_t>(cur - out);
+}
+
+#ifdef REMODEL_HAS_HOOKS
+
+/**
+ * @internal
+ * @brief   Recycles the code memory of destroyed thunks.
+ *          
+ * Each thread keeps a few recycled slots of its own, so creating and destroying short-lived 
+ * thunks on concurrent threads doesn't contend on the shared list.
+ */
+class ThunkPool
+{
+    /// The number of slots kept per thread.
+    static const std::size_t kLocalCapacity = 16;
+
+    /**
+     * @brief   The slots kept by a thread, handed back to the shared list on thread exit.
+     */
+    struct LocalCache
+    {
+        uint8_t*    slots[kLocalCapacity];
+        std::size_t count = 0;
+
+        ~LocalCache()
+        {
+            auto& pool = instance();
+            std::lock_guard<std::mutex> lock{pool.m_mutex};
+            pool.m_free.insert(pool.m_free.end(), slots, slots + count);
+        }
+    };
+
+    std::mutex            m_mutex;
+    std::vector<uint8_t*> m_free;
+
+    static LocalCache& localCache()
+    {
+        static thread_local LocalCache cache;
+        return cache;
+    }
+public:
+    /**
+     * @brief   Gets the process-wide instance.
+     */
+    static ThunkPool& instance()
+    {
+        static ThunkPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief   Allocates `kThunkSize` bytes of executable memory.
+     * @param   hint    An address to allocate close to, used when no memory is recycled.
+     * @return  The allocation or @c nullptr on failure.
+     */
+    uint8_t* acquire(const void* hint)
+    {
+        auto& cache = localCache();
+        if (cache.count) return cache.slots[--cache.count];
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (!m_free.empty())
+            {
+                auto slot = m_free.back();
+                m_free.pop_back();
+                return slot;
+            }
+        }
+        return HookArena::instance().allocate(hint, kThunkSize);
+    }
+
+    /**
+     * @brief   Returns memory obtained from `acquire`.
+     */
+    void release(uint8_t* slot)
+    {
+        auto& cache = localCache();
+        if (cache.count < kLocalCapacity)
+        {
+            cache.slots[cache.count++] = slot;
+            return;
+        }
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_free.push_back(slot);
+    }
+};
+
+#endif // ifdef REMODEL_HAS_HOOKS
+
+} // namespace internal
+
+/**
+ * @brief   Plain function pointer calling a member function with a bound object.
+ * @tparam  FunctionPtrT    The member function pointer type, taking the object first, as 
+ *                          returned by `MemberFunction::get`.
+ *          
+ * The thunk is a few instructions of generated code moving the object into the first argument 
+ * and transferring to the member function, so callbacks invoked by the target in tight loops 
+ * don't go through the wrapper. Supported are x86-64 (System V and Microsoft ABI) and x86 
+ * `thiscall` (exposed as `stdcall`), `cdecl` and `stdcall` member functions without class return
+ * values. The x86-64 ABIs additionally limit the arguments, see the assertions.
+ *          
+ * @warning The code is recycled once the thunk is destroyed, it must not be called anymore.
+ */
+template<typename FunctionPtrT>
+class BoundThunk
+{
+    using Traits = internal::BoundThunkTraits<FunctionPtrT>;
+    static_assert(Traits::kSupported, 
+        "bound thunks aren't supported for this calling convention or platform");
+    using Args = internal::ThunkArgs<typename Traits::ArgsTuple>;
+    static_assert(!std::is_class<typename Traits::Ret>::value, 
+        "bound thunks don't support class return values");
+    static_assert(Traits::kAbi != internal::ThunkAbi::SysV64 
+        || (Args::intCount() <= 5 && !Args::hasClass()),
+        "System V thunks support up to 5 integer arguments and no class arguments");
+    static_assert(Traits::kAbi != internal::ThunkAbi::Ms64 
+        || (Args::kCount <= 3 && !Args::hasClass()),
+        "Microsoft x64 thunks support up to 3 arguments and no class arguments");
+    static_assert(Args::stackSize() <= 64, "bound thunks support up to 64 bytes of arguments");
+public:
+    using CallbackPtr = typename Traits::CallbackPtr;
+
+    /**
+     * @brief   Constructor generating the thunk.
+     * @param   target  The member function.
+     * @param   object  The object to bind.
+     */
+    BoundThunk(FunctionPtrT target, void* object)
+    {
+#   ifdef REMODEL_HAS_HOOKS
+        auto targetAddr = reinterpret_cast<void*>(target);
+        m_slot = internal::ThunkPool::instance().acquire(targetAddr);
+        if (!m_slot) return;
+        internal::emitBoundThunk(Traits::kAbi, m_slot, reinterpret_cast<uintptr_t>(targetAddr), 
+            reinterpret_cast<uintptr_t>(object), Args::stackSize());
+#   else
+        (void)target;
+        (void)object;
+#   endif
+    }
+
+    BoundThunk(BoundThunk&& other)
+        : m_slot{other.m_slot}
+    {
+        other.m_slot = nullptr;
+    }
+
+    BoundThunk& operator = (BoundThunk&& other)
+    {
+        std::swap(m_slot, other.m_slot);
+        return *this;
+    }
+
+    BoundThunk(const BoundThunk&) = delete;
+    BoundThunk& operator = (const BoundThunk&) = delete;
+
+    /**
+     * @brief   Destructor, recycling the code.
+     */
+    ~BoundThunk()
+    {
+#   ifdef REMODEL_HAS_HOOKS
+        if (m_slot) internal::ThunkPool::instance().release(m_slot);
+#   endif
+    }
+
+    /**
+     * @brief   Determines whether code memory could be allocated for the thunk.
+     */
+    bool isValid() const { return m_slot != nullptr; }
+
+    /**
+     * @brief   Gets the thunk, @c nullptr if invalid.
+     */
+    CallbackPtr get() const { return reinterpret_cast<CallbackPtr>(m_slot); }
+private:
+    uint8_t* m_slot = nullptr;
+};
+
+/**
+ * @brief   Creates a thunk calling a member function wrapper's function on its object.
+ * @param   func    The member function wrapper, resolved once.
+ * @return  The thunk.
+ * @see     BoundThunk
+ */
+template<typename T, typename PtrGetterT>
+inline BoundThunk<decltype(std::declval<const MemberFunction<T, PtrGetterT>&>().get())> 
+bindThunk(const MemberFunction<T, PtrGetterT>& func)
+{
+    return {func.get(), func.object()};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [CallbackThunk]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Describes the invoker behind a callback thunk of a plain function pointer type.
+ */
+template<typename CallbackPtrT>
+struct CallbackThunkTraits
+{
+    static const bool kSupported = false;
+};
+
+/**
+ * @internal
+ * @brief   A macro that defines the callback thunk traits of a calling convention.
+ * @param   callbackConv    The calling convention of the thunk.
+ * @param   invokerConv     The calling convention of the invoker, receiving the context first.
+ */
+#define REMODEL_DEF_CALLBACK_TRAITS(callbackConv, invokerConv)                                     \
+    template<typename RetT, typename... ArgsT>                                                     \
+    struct CallbackThunkTraits<RetT (callbackConv*)(ArgsT...)>                                     \
+    {                                                                                              \
+        static const bool kSupported = true;                                                       \
+        using InvokerPtr = RetT (invokerConv*)(void*, ArgsT...);                                   \
+                                                                                                   \
+        template<typename FuncT>                                                                   \
+        static RetT invokerConv invoke(void* context, ArgsT... args)                               \
+        {                                                                                          \
+            return (*static_cast<FuncT*>(context))(std::forward<ArgsT>(args)...);                  \
+        }                                                                                          \
+    }
+
+#if defined(ZYCORE_MSVC) && defined(_M_X64)
+    REMODEL_DEF_CALLBACK_TRAITS(__cdecl, __cdecl);
+#elif defined(ZYCORE_MSVC) && defined(_M_IX86)
+    REMODEL_DEF_CALLBACK_TRAITS(__cdecl, __cdecl);
+    REMODEL_DEF_CALLBACK_TRAITS(__stdcall, __thiscall);
+#elif defined(ZYCORE_GNUC) && defined(__x86_64__)
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        REMODEL_DEF_CALLBACK_TRAITS(, );
+        REMODEL_DEF_CALLBACK_TRAITS(__attribute__((sysv_abi)), __attribute__((sysv_abi)));
+#   else
+        REMODEL_DEF_CALLBACK_TRAITS(, );
+        REMODEL_DEF_CALLBACK_TRAITS(__attribute__((ms_abi)), __attribute__((ms_abi)));
+#   endif
+#elif defined(ZYCORE_GNUC) && defined(__i386__)
+    REMODEL_DEF_CALLBACK_TRAITS(__attribute__((cdecl)), __attribute__((cdecl)));
+    REMODEL_DEF_CALLBACK_TRAITS(__attribute__((stdcall)), __attribute__((thiscall)));
+#endif
+
+#undef REMODEL_DEF_CALLBACK_TRAITS
+
+} // namespace internal
+
+/**
+ * @brief   Plain function pointer calling a callable, such as a capturing lambda.
+ * @tparam  CallbackPtrT    The function pointer type expected by the target, e.g. a traversal 
+ *                          routine's visitor.
+ *          
+ * The callable is stored next to a `BoundThunk` style stub passing it as the context to a 
+ * statically generated invoker, letting each caller of a traversal routine keep its own state 
+ * without globals. Code memory comes from the thread's recycled thunks and callables of up to 
+ * about 64 bytes live in the same slot, so creating a thunk doesn't allocate in the steady state. 
+ * The limitations of `BoundThunk` apply to the invoker, i.e. the callback's arguments.
+ *          
+ * @warning The code is recycled once the thunk is destroyed, it must not be called anymore.
+ */
+template<typename CallbackPtrT>
+class CallbackThunk
+{
+    using Traits = internal::CallbackThunkTraits<CallbackPtrT>;
+    static_assert(Traits::kSupported, 
+        "callback thunks aren't supported for this calling convention or platform");
+    using InvokerPtr = typename Traits::InvokerPtr;
+    using InvokerTraits = internal::BoundThunkTraits<InvokerPtr>;
+    static_assert(std::is_same<typename BoundThunk<InvokerPtr>::CallbackPtr, CallbackPtrT>::value,
+        "the invoker's thunk doesn't match the callback type");
+public:
+    using CallbackPtr = CallbackPtrT;
+
+    /**
+     * @brief   Constructor generating the thunk.
+     * @param   func    The callable, invoked with the callback's arguments.
+     */
+    template<typename FuncT>
+    explicit CallbackThunk(FuncT&& func)
+    {
+        using Func = std::decay_t<FuncT>;
+#   ifdef REMODEL_HAS_HOOKS
+        auto invoker = reinterpret_cast<uintptr_t>(&Traits::template invoke<Func>);
+        m_slot = internal::ThunkPool::instance().acquire(reinterpret_cast<void*>(invoker));
+        if (!m_slot) return;
+        auto stackSize = internal::ThunkArgs<typename InvokerTraits::ArgsTuple>::stackSize();
+
+        // Places the callable at the end of the slot, behind the code, if both fit.
+        if (sizeof(Func) <= internal::kThunkSize && alignof(Func) <= internal::kThunkSize)
+        {
+            auto offs = (internal::kThunkSize - sizeof(Func)) & ~(alignof(Func) - 1);
+            auto codeSize = internal::emitBoundThunk(InvokerTraits::kAbi, m_slot, invoker, 
+                reinterpret_cast<uintptr_t>(m_slot + offs), stackSize);
+            if (codeSize <= offs)
+            {
+                m_context = new (m_slot + offs) Func(std::forward<FuncT>(func));
+                m_destroy = [](void* context) { static_cast<Func*>(context)->~Func(); };
+                return;
+            }
+        }
+
+        m_context = new Func(std::forward<FuncT>(func));
+        m_destroy = [](void* context) { delete static_cast<Func*>(context); };
+        internal::emitBoundThunk(InvokerTraits::kAbi, m_slot, invoker, 
+            reinterpret_cast<uintptr_t>(m_context), stackSize);
+#   else
+        (void)func;
+#   endif
+    }
+
+    CallbackThunk(CallbackThunk&& other)
+        : m_slot{other.m_slot}
+        , m_context{other.m_context}
+        , m_destroy{other.m_destroy}
+    {
+        other.m_slot = nullptr;
+        other.m_context = nullptr;
+    }
+
+    CallbackThunk& operator = (CallbackThunk&& other)
+    {
+        std::swap(m_slot, other.m_slot);
+        std::swap(m_context, other.m_context);
+        std::swap(m_destroy, other.m_destroy);
+        return *this;
+    }
+
+    CallbackThunk(const CallbackThunk&) = delete;
+    CallbackThunk& operator = (const CallbackThunk&) = delete;
+
+    /**
+     * @brief   Destructor, destroying the callable and recycling the code.
+     */
+    ~CallbackThunk()
+    {
+        if (m_context) m_destroy(m_context);
+#   ifdef REMODEL_HAS_HOOKS
+        if (m_slot) internal::ThunkPool::instance().release(m_slot);
+#   endif
+    }
+
+    /**
+     * @brief   Determines whether code memory could be allocated for the thunk.
+     */
+    bool isValid() const { return m_slot != nullptr; }
+
+    /**
+     * @brief   Gets the thunk, @c nullptr if invalid.
+     */
+    CallbackPtr get() const { return reinterpret_cast<CallbackPtr>(m_slot); }
+private:
+    using Destroyer = void (*)(void* context);
+
+    uint8_t*  m_slot    = nullptr;
+    void*     m_context = nullptr;
+    Destroyer m_destroy = nullptr;
+};
+
+/**
+ * @brief   Creates a thunk of a given callback type calling a callable.
+ * @tparam  CallbackPtrT    The function pointer type expected by the target.
+ * @param   func            The callable.
+ * @return  The thunk.
+ * @see     CallbackThunk
+ */
+template<typename CallbackPtrT, typename FuncT>
+inline CallbackThunk<CallbackPtrT> makeCallback(FuncT&& func)
+{
+    return CallbackThunk<CallbackPtrT>{std::forward<FuncT>(func)};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [ShadowVfTable]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Per-object virtual function hooks using a copy of the object's vftable.
+ *          
+ * On construction, the object's vftable is copied. Entries can then be replaced using `set` and 
+ * take effect once `attach` points the object to the copy. Entries may be changed while attached.
+ * The RTTI slots preceding the table are copied as well, keeping `typeid` and `dynamic_cast` 
+ * working.
+ * 
+ * The number of entries isn't stored anywhere in the binary and has to be passed in; it may be 
+ * smaller than the real table if no higher index is ever called on the object.
+ * 
+ * @note    `CachedVirtualFunction`s of the object have to be refreshed after attaching and 
+ *          detaching.
+ */
+class ShadowVfTable
+{
+#if defined(ZYCORE_MSVC)
+    /// The complete object locator.
+    static const std::size_t kPrefixSize = 1;
+#else
+    /// Offset-to-top and the `type_info` pointer.
+    static const std::size_t kPrefixSize = 2;
+#endif
+
+    void**             m_vftablePtr;
+    void**             m_original;
+    std::vector<void*> m_table;
+public:
+    /**
+     * @brief   Constructor copying the vftable of an object.
+     * @param   raw             The raw pointer of the object.
+     * @param   entryCount      The number of entries in the vftable.
+     * @param   vftableOffset   Offset of the vftable-pointer in the class.
+     */
+    ShadowVfTable(void* raw, std::size_t entryCount, std::size_t vftableOffset = 0)
+        : m_vftablePtr{reinterpret_cast<void**>(reinterpret_cast<uintptr_t>(raw) + vftableOffset)}
+        , m_original{static_cast<void**>(*m_vftablePtr)}
+        , m_table(m_original - kPrefixSize, m_original + entryCount)
+    {}
+
+    /**
+     * @brief   Constructor copying the vftable of a wrapped object.
+     * @param   wrapper         The wrapper of the object.
+     * @param   entryCount      The number of entries in the vftable.
+     * @param   vftableOffset   Offset of the vftable-pointer in the class.
+     */
+    ShadowVfTable(ClassWrapper& wrapper, std::size_t entryCount, std::size_t vftableOffset = 0)
+        : ShadowVfTable{wrapper.addressOfObj(), entryCount, vftableOffset}
+    {}
+
+    ShadowVfTable(const ShadowVfTable&) = delete;
+    ShadowVfTable& operator = (const ShadowVfTable&) = delete;
+
+    /**
+     * @brief   Destructor detaching the object.
+     */
+    ~ShadowVfTable() { detach(); }
+
+    /**
+     * @brief   Gets the number of entries.
+     */
+    std::size_t size() const { return m_table.size() - kPrefixSize; }
+
+    /**
+     * @brief   Points the object to the shadow table.
+     */
+    void attach() { *m_vftablePtr = shadow(); }
+
+    /**
+     * @brief   Points the object back to its original vftable.
+     * @return  @c true on success, @c false if the object's vftable-pointer was changed by someone 
+     *          else in the meantime (it is left untouched then).
+     */
+    bool detach()
+    {
+        if (*m_vftablePtr != shadow()) return *m_vftablePtr == m_original;
+        *m_vftablePtr = m_original;
+        return true;
+    }
+
+    /**
+     * @brief   Determines whether the object currently uses the shadow table.
+     */
+    bool isAttached() const { return *m_vftablePtr == shadow(); }
+
+    /**
+     * @brief   Replaces an entry.
+     * @param   vftableIdx  Index of the function inside the table.
+     * @param   function    The replacement, receiving the object as first argument.
+     */
+    template<typename FunctionPtrT>
+    void set(std::size_t vftableIdx, FunctionPtrT function)
+    {
+        static_assert(std::is_pointer<FunctionPtrT>::value, "expected a function pointer");
+        m_table[kPrefixSize + vftableIdx] = *reinterpret_cast<void**>(&function);
+    }
+
+    /**
+     * @brief   Restores the original entry.
+     * @param   vftableIdx  Index of the function inside the table.
+     */
+    void restore(std::size_t vftableIdx) 
+    { 
+        m_table[kPrefixSize + vftableIdx] = m_original[vftableIdx]; 
+    }
+
+    /**
+     * @brief   Gets the original function of an entry.
+     * @tparam  FunctionPtrT    The function pointer type to cast to.
+     * @param   vftableIdx      Index of the function inside the table.
+     */
+    template<typename FunctionPtrT = void*>
+    FunctionPtrT original(std::size_t vftableIdx) const
+    {
+        return (FunctionPtrT)m_original[vftableIdx];
+    }
+
+    /**
+     * @brief   Gets the original vftable.
+     */
+    void* const* originalTable() const { return m_original; }
+
+    /**
+     * @brief   Gets the shadow table the object is pointed to.
+     */
+    void* const* shadowTable() const { return shadow(); }
+private:
+    void** shadow() const { return const_cast<void**>(m_table.data()) + kPrefixSize; }
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_HOOK_HPP
@@ -0,0 +1,310 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_IDENTITYMAP_HPP
+#define REMODEL_IDENTITYMAP_HPP
+
+/**     
+ * @file
+ * @brief Contains an identity map interning wrappers by the raw address of their objects.
+ *        
+ * Code paths wrapping the same object independently end up with separate wrappers, each with 
+ * its own cached state, and comparing them requires `addressOfObj` calls. A `WrapperIdentityMap` 
+ * hands out a single shared wrapper per address instead, so wrapper pointers obtained from it 
+ * compare and hash like the objects they wrap.
+ *        
+ * @code
+ *      WrapperIdentityMap<Horse> horses{4096};
+ *      
+ *      void onKick(Horse::Weak* weak)
+ *      {
+ *          Horse* horse = horses.get(weak);
+ *          kicked.insert(horse);       // e.g. std::unordered_set<Horse*>
+ *      }
+ *      
+ *      void onHorseDestroyed(void* raw) { horses.erase(raw); }
+ *      void onFrameEnd()                { horses.advanceEpoch(); }
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [WrapperIdentityMap]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Concurrent map from raw object addresses to shared wrappers.
+ * @tparam  WrapperT    Type of the wrapper.
+ *          
+ * The map is a fixed-capacity open-addressing hash table. Lookups and insertions are lock-free,
+ * racing insertions of the same address agree on one wrapper. Addresses are never removed from
+ * the table, `erase` only detaches the wrapper, so an object allocated at the address later on 
+ * reuses the slot.
+ *
+ * Erased wrappers are not freed immediately, as other threads may still use them. They are 
+ * retired to the current epoch and freed when the epoch is advanced for the second time, so 
+ * wrappers obtained from the map stay valid for the remainder of the epoch they were obtained 
+ * in and the next one, e.g. for the rest of the frame when epochs are advanced once per frame.
+ */
+template<typename WrapperT>
+class WrapperIdentityMap : public zycore::NonCopyable
+{
+    struct Slot
+    {
+        std::atomic<uintptr_t> key;
+        std::atomic<WrapperT*> wrapper;
+    };
+public:
+    /**
+     * @brief   Constructor.
+     * @param   capacity    The maximum number of distinct addresses, the table is kept at most 
+     *                      half full.
+     */
+    explicit WrapperIdentityMap(std::size_t capacity)
+        : m_capacity{capacity}
+    {
+        unsigned bits = 1;
+        while ((std::size_t{1} << bits) < capacity * 2) ++bits;
+
+        m_slots.reset(new Slot[std::size_t{1} << bits]);
+        m_mask  = (std::size_t{1} << bits) - 1;
+        m_shift = 64 - bits;
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            m_slots[i].key.store(0, std::memory_order_relaxed);
+            m_slots[i].wrapper.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief   Destructor, freeing all wrappers. No other thread may access the map anymore.
+     */
+    ~WrapperIdentityMap()
+    {
+        clear();
+    }
+
+    /**
+     * @brief   Gets the wrapper of an object, creating it on first use.
+     * @param   raw The raw pointer of the object.
+     * @return  The wrapper, @c nullptr if @p raw is null or the capacity is exhausted.
+     */
+    WrapperT* get(void* raw)
+    {
+        auto slot = claimSlot(reinterpret_cast<uintptr_t>(raw));
+        if (!slot) return nullptr;
+
+        auto wrapper = slot->wrapper.load(std::memory_order_acquire);
+        if (wrapper) return wrapper;
+
+        // Racing threads create a wrapper each, all but one lose the exchange.
+        std::unique_ptr<WrapperT> created{new WrapperT{wrapper_cast<WrapperT>(raw)}};
+        if (slot->wrapper.compare_exchange_strong(wrapper, created.get(), 
+            std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return created.release();
+        }
+        return wrapper;
+    }
+
+    /**
+     * @brief   Gets the wrapper of an object referenced by a weak wrapper.
+     * @param   weak    The weak wrapper, e.g. passed to a callback.
+     * @copydetails get(void*)
+     */
+    WrapperT* get(WeakWrapper<WrapperT>* weak)
+    {
+        return weak ? get(weak->raw()) : nullptr;
+    }
+
+    /**
+     * @brief   Gets the wrapper of an object without creating it.
+     * @param   raw The raw pointer of the object.
+     * @return  The wrapper, @c nullptr if there is none.
+     */
+    WrapperT* find(const void* raw) const
+    {
+        auto slot = findSlot(reinterpret_cast<uintptr_t>(raw));
+        return slot ? slot->wrapper.load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief   Detaches the wrapper of an object, e.g. when the object is destroyed.
+     * @param   raw The raw pointer of the object.
+     * @return  @c true if a wrapper was detached, else @c false.
+     *          
+     * The wrapper is retired to the current epoch, see the class documentation. The next `get` 
+     * for the address creates a new wrapper.
+     */
+    bool erase(const void* raw)
+    {
+        auto slot = findSlot(reinterpret_cast<uintptr_t>(raw));
+        if (!slot) return false;
+
+        auto wrapper = slot->wrapper.exchange(nullptr, std::memory_order_acq_rel);
+        if (!wrapper) return false;
+
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock{m_retireMutex};
+        m_retired[m_epoch & 1].emplace_back(wrapper);
+        return true;
+    }
+
+    /**
+     * @brief   Detaches all wrappers, e.g. when invalidations were lost.
+     * @return  The number of wrappers detached.
+     * @see     erase
+     */
+    std::size_t eraseAll()
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            auto wrapper = m_slots[i].wrapper.exchange(nullptr, std::memory_order_acq_rel);
+            if (!wrapper) continue;
+
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock{m_retireMutex};
+            m_retired[m_epoch & 1].emplace_back(wrapper);
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief   Advances the epoch, freeing the wrappers erased two epochs ago.
+     * @return  The number of wrappers freed.
+     */
+    std::size_t advanceEpoch()
+    {
+        std::lock_guard<std::mutex> lock{m_retireMutex};
+        ++m_epoch;
+        auto& expired = m_retired[m_epoch & 1];
+        auto count = expired.size();
+        expired.clear();
+        return count;
+    }
+
+    /**
+     * @brief   Frees all wrappers, attached and retired, and forgets all addresses.
+     * @note    Not thread-safe, no other thread may access the map or use its wrappers.
+     */
+    void clear()
+    {
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            delete m_slots[i].wrapper.exchange(nullptr, std::memory_order_relaxed);
+            m_slots[i].key.store(0, std::memory_order_relaxed);
+        }
+        m_retired[0].clear();
+        m_retired[1].clear();
+        m_size.store(0, std::memory_order_relaxed);
+        m_used.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief   Gets the number of attached wrappers.
+     */
+    std::size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the number of distinct addresses ever seen since construction or `clear`.
+     */
+    std::size_t addressCount() const { return m_used.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the maximum number of distinct addresses.
+     */
+    std::size_t capacity() const { return m_capacity; }
+private:
+    std::size_t slotOf(uintptr_t key) const
+    {
+        // Fibonacci hashing, objects are aligned so the low bits carry little information.
+        return static_cast<std::size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) 
+            >> m_shift);
+    }
+
+    Slot* findSlot(uintptr_t key) const
+    {
+        if (!key) return nullptr;
+        for (auto idx = slotOf(key);; idx = (idx + 1) & m_mask)
+        {
+            auto cur = m_slots[idx].key.load(std::memory_order_acquire);
+            if (cur == key) return &m_slots[idx];
+            if (!cur) return nullptr;
+        }
+    }
+
+    Slot* claimSlot(uintptr_t key)
+    {
+        if (!key) return nullptr;
+        for (auto idx = slotOf(key);; idx = (idx + 1) & m_mask)
+        {
+            auto& slot = m_slots[idx];
+            auto cur = slot.key.load(std::memory_order_acquire);
+            if (!cur)
+            {
+                // Keep the table at most half full, so probe sequences stay short and end.
+                if (m_used.fetch_add(1, std::memory_order_relaxed) >= m_capacity)
+                {
+                    m_used.fetch_sub(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                if (slot.key.compare_exchange_strong(cur, key, std::memory_order_acq_rel, 
+                    std::memory_order_acquire))
+                {
+                    return &slot;
+                }
+                m_used.fetch_sub(1, std::memory_order_relaxed);
+            }
+            if (cur == key) return &slot;
+        }
+    }
+private:
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_capacity;
+    std::size_t m_mask;
+    unsigned m_shift;
+    std::atomic<std::size_t> m_size{0};
+    std::atomic<std::size_t> m_used{0};
+
+    std::mutex m_retireMutex;
+    uint64_t m_epoch = 0;
+    std::vector<std::unique_ptr<WrapperT>> m_retired[2];
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_IDENTITYMAP_HPP
@@ -0,0 +1,180 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_INHERITANCE_HPP
+#define REMODEL_INHERITANCE_HPP
+
+/**     
+ * @file
+ * @brief Contains declarative base subobjects for wrappers of classes using multiple inheritance.
+ *        
+ * With multiple inheritance, every base class after the first lives at an offset inside of the 
+ * object, with its own vftable pointer. Virtual functions of that base expect `this` to point 
+ * to the base subobject, not the object. A `BaseSubobject` member declares a base with its 
+ * constant offset and provides a wrapper of the subobject, bound to the adjusted pointer once 
+ * per wrapper. Calls through it pass the adjusted `this` without recomputing it per call.
+ *
+ * @code
+ *      class Flyer : public AdvancedClassWrapper<0x10>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Flyer)
+ *      public:
+ *          VirtualFunction<void (*)(float)> fly{this, 2};
+ *      };
+ *      
+ *      class Bird : public AdvancedClassWrapper<0x40>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Bird)
+ *      public:
+ *          BaseSubobject<Flyer, 0x20> flyer{this};
+ *      };
+ *      
+ *      bird.flyer->fly(2.f);
+ *      Flyer flyer = upcast(bird, &Bird::flyer);
+ *      Bird  same  = downcast(flyer, &Bird::flyer);
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [BaseSubobject]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Wrapper member declaring a base class subobject at a constant offset.
+ * @tparam  BaseWrapperT    The wrapper type of the base class.
+ * @tparam  offsT           The offset of the base subobject inside of the derived object.
+ *                          
+ * The base wrapper is created along with the derived wrapper. When the derived wrapper is 
+ * rebound (e.g. by a `WrapperPool`), the base wrapper is rebound on its next access.
+ */
+template<typename BaseWrapperT, std::ptrdiff_t offsT>
+class BaseSubobject : public internal::GetterFieldBase<StaticOffsGetter<offsT>>
+{
+    using Base = internal::GetterFieldBase<StaticOffsGetter<offsT>>;
+public:
+    using Wrapper = BaseWrapperT;
+    static const std::ptrdiff_t kOffs = offsT;
+
+    /**
+     * @brief   Constructor.
+     * @param   parent  The wrapper of the derived class.
+     */
+    explicit BaseSubobject(ClassWrapper* parent)
+        : Base{parent}
+        , m_boundRaw{this->parentRaw()}
+        , m_base{wrapper_cast<BaseWrapperT>(toBase(m_boundRaw))}
+    {}
+
+    /**
+     * @brief   Gets the wrapper of the base subobject.
+     * @return  The wrapper.
+     */
+    BaseWrapperT& get()
+    {
+        auto raw = this->parentRaw();
+        if (raw != m_boundRaw)
+        {
+            m_base.ClassWrapper::rebind(toBase(raw));
+            m_boundRaw = raw;
+        }
+        return m_base;
+    }
+
+    /**
+     * @brief   Accesses the members of the base wrapper.
+     * @return  The wrapper.
+     */
+    BaseWrapperT* operator -> () { return get().addressOfWrapper(); }
+
+    /**
+     * @brief   Obtains a raw pointer to the base subobject.
+     * @return  The pointer.
+     */
+    void* addressOfObj() { return toBase(this->parentRaw()); }
+
+    /**
+     * @brief   Adjusts a pointer to the derived object to the base subobject.
+     * @param   derived The derived object, may be null.
+     * @return  The base subobject, @c nullptr if @p derived is null.
+     */
+    static void* toBase(void* derived)
+    {
+        return derived ? static_cast<uint8_t*>(derived) + offsT : nullptr;
+    }
+
+    /**
+     * @brief   Adjusts a pointer to the base subobject to the derived object.
+     * @param   base    The base subobject, may be null.
+     * @return  The derived object, @c nullptr if @p base is null.
+     */
+    static void* toDerived(void* base)
+    {
+        return base ? static_cast<uint8_t*>(base) - offsT : nullptr;
+    }
+private:
+    void* m_boundRaw;
+    BaseWrapperT m_base;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [upcast] + [downcast]                                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Creates a wrapper of a base subobject from a wrapper of the derived object.
+ * @param   derived The wrapper of the derived object.
+ * @param   member  The base declaration, e.g. `&Bird::flyer`.
+ * @return  The base wrapper.
+ */
+template<typename DerivedT, typename BaseWrapperT, std::ptrdiff_t offsT>
+inline BaseWrapperT upcast(const DerivedT& derived, 
+    BaseSubobject<BaseWrapperT, offsT> DerivedT::* /*member*/)
+{
+    return wrapper_cast<BaseWrapperT>(BaseSubobject<BaseWrapperT, offsT>::toBase(
+        const_cast<void*>(derived.addressOfObj())));
+}
+
+/**
+ * @brief   Creates a wrapper of the derived object from a wrapper of a base subobject.
+ * @param   base    The wrapper of the base subobject, required to be part of a `DerivedT`.
+ * @param   member  The base declaration, e.g. `&Bird::flyer`.
+ * @return  The derived wrapper.
+ */
+template<typename DerivedT, typename BaseWrapperT, std::ptrdiff_t offsT>
+inline DerivedT downcast(const BaseWrapperT& base, 
+    BaseSubobject<BaseWrapperT, offsT> DerivedT::* /*member*/)
+{
+    return wrapper_cast<DerivedT>(BaseSubobject<BaseWrapperT, offsT>::toDerived(
+        const_cast<void*>(base.addressOfObj())));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_INHERITANCE_HPP
@@ -0,0 +1,790 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_INSTANCESCAN_HPP
+#define REMODEL_INSTANCESCAN_HPP
+
+/**
+ * @file
+ * @brief Contains a scanner locating live instances of polymorphic classes by their vftables.
+ *
+ * Every instance of a polymorphic class starts with a pointer to the vftable of its dynamic type,
+ * so its instances can be found by searching writable memory for that pointer. `VftableScanner`
+ * does so using the vectorized `findPointerValues` on multiple threads. With page tracking
+ * enabled, `rescanProcess` only searches memory written since the previous rescan.
+ *
+ * @code
+ *      VftableScanner scanner;
+ *      scanner.add(module->addressOfObj() + kCatVftableRva);
+ *      scanner.scanProcess();
+ *      for (auto& cat : scanner.instances<Cat>())
+ *      {
+ *          cat.giveGoodie(1);
+ *      }
+ * @endcode
+ *
+ * @warning The results are candidates: any pointer-aligned word equal to a vftable address is 
+ *          reported, including stale copies on stacks or in freed memory. Validate them, e.g. using
+ *          `safeRead` and plausibility checks on their fields. Memory must not be unmapped while a
+ *          scan is running.
+ */
+
+#include "Remodel.hpp"
+#include "Platform.hpp"
+#include "Scanner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [InstanceSetIterator]                                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Random access iterator over an array of object pointers, yielding wrappers.
+ * @tparam  WrapperT    Type of the wrapper.
+ *
+ * Like `WrapperSpanIterator`, each iterator owns a single wrapper that is rebound to the current
+ * object as the iterator moves, so references obtained by dereferencing are only valid until the
+ * iterator is moved or destroyed.
+ *
+ * Since the objects are scattered, hardware prefetchers can't predict them: iterators obtained 
+ * from a set prefetch the object `InstanceSet::prefetchDistance` elements ahead whenever they 
+ * are incremented. This pays off as soon as the loop body is long enough for the out-of-order 
+ * window not to reach the following objects by itself, trivial bodies get slightly slower.
+ */
+template<typename WrapperT>
+class InstanceSetIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = WrapperT;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = WrapperT*;
+    using reference         = WrapperT&;
+
+    /**
+     * @brief   Default constructor, creating a singular iterator.
+     */
+    InstanceSetIterator()
+        : m_cur{nullptr}
+        , m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+    {}
+
+    /**
+     * @brief   Constructs an iterator pointing to an element of a pointer array.
+     * @param   cur The element.
+     */
+    explicit InstanceSetIterator(void* const* cur)
+        : m_cur{cur}
+        , m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+    {}
+
+    /**
+     * @brief   Constructs an iterator pointing to an element of a pointer array, prefetching ahead.
+     * @param   cur         The element.
+     * @param   distance    The prefetch distance in elements, 0 to disable prefetching.
+     * @param   end         The element past the last one, bounding the prefetches.
+     */
+    InstanceSetIterator(void* const* cur, std::size_t distance, void* const* end)
+        : m_cur{cur}
+        , m_end{end}
+        , m_lookahead{static_cast<difference_type>(distance)}
+        , m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+    {}
+
+    /**
+     * @brief   Copy constructor.
+     * @param   other   The iterator to copy from.
+     */
+    InstanceSetIterator(const InstanceSetIterator& other)
+        : m_cur{other.m_cur}
+        , m_end{other.m_end}
+        , m_lookahead{other.m_lookahead}
+        , m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+    {}
+
+    /**
+     * @brief   Assignment operator.
+     * @param   other   The iterator to assign from.
+     * @return  `*this`.
+     */
+    InstanceSetIterator& operator = (const InstanceSetIterator& other)
+    {
+        m_cur       = other.m_cur;
+        m_end       = other.m_end;
+        m_lookahead = other.m_lookahead;
+        return *this;
+    }
+
+    /**
+     * @brief   Gets the raw pointer of the current object.
+     * @return  The raw pointer.
+     */
+    void* raw() const { return *m_cur; }
+
+    reference operator * () const   { rebind(); return m_wrapper; }
+    pointer operator -> () const    { rebind(); return m_wrapper.addressOfWrapper(); }
+
+    /**
+     * @brief   Subscript operator.
+     * @param   n   The offset in elements from the current object.
+     * @return  A new wrapper for the requested object.
+     */
+    value_type operator [] (difference_type n) const { return wrapper_cast<WrapperT>(m_cur[n]); }
+
+    InstanceSetIterator& operator ++ ()     
+    { 
+        ++m_cur; 
+        if (m_lookahead && m_end - m_cur > m_lookahead)
+        {
+            platform::prefetchRange(m_cur[m_lookahead], internal::ObjPrefetchSize<WrapperT>::value);
+        }
+        return *this; 
+    }
+
+    InstanceSetIterator& operator -- ()     { --m_cur; return *this; }
+    InstanceSetIterator operator ++ (int)   { auto tmp = *this; ++*this; return tmp; }
+    InstanceSetIterator operator -- (int)   { auto tmp = *this; --m_cur; return tmp; }
+
+    InstanceSetIterator& operator += (difference_type n) { m_cur += n; return *this; }
+    InstanceSetIterator& operator -= (difference_type n) { m_cur -= n; return *this; }
+    InstanceSetIterator operator + (difference_type n) const 
+    { 
+        auto tmp = *this;
+        return tmp += n; 
+    }
+    InstanceSetIterator operator - (difference_type n) const 
+    { 
+        auto tmp = *this;
+        return tmp -= n; 
+    }
+
+    friend InstanceSetIterator operator + (difference_type n, const InstanceSetIterator& it)
+    {
+        return it + n;
+    }
+
+    difference_type operator - (const InstanceSetIterator& rhs) const { return m_cur - rhs.m_cur; }
+
+    bool operator == (const InstanceSetIterator& rhs) const { return m_cur == rhs.m_cur; }
+    bool operator != (const InstanceSetIterator& rhs) const { return m_cur != rhs.m_cur; }
+    bool operator <  (const InstanceSetIterator& rhs) const { return m_cur <  rhs.m_cur; }
+    bool operator >  (const InstanceSetIterator& rhs) const { return m_cur >  rhs.m_cur; }
+    bool operator <= (const InstanceSetIterator& rhs) const { return m_cur <= rhs.m_cur; }
+    bool operator >= (const InstanceSetIterator& rhs) const { return m_cur >= rhs.m_cur; }
+private:
+    void rebind() const { m_wrapper.ClassWrapper::rebind(*m_cur); }
+private:
+    void* const* m_cur;
+    void* const* m_end = nullptr;
+    difference_type m_lookahead = 0;
+    mutable WrapperT m_wrapper;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [InstanceSet]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Set of objects scattered in memory, iterable like a `WrapperSpan`.
+ * @tparam  WrapperT    Type of the wrapper.
+ *
+ * The raw pointers are kept in ascending order and are available through `data`, e.g. to be
+ * passed to `resolvePtrChains`.
+ */
+template<typename WrapperT>
+class InstanceSet
+{
+public:
+    using iterator = InstanceSetIterator<WrapperT>;
+
+    /**
+     * @brief   Default constructor, creating an empty set.
+     */
+    InstanceSet() = default;
+
+    /**
+     * @brief   Constructor.
+     * @param   raws    The raw pointers of the objects, in ascending order.
+     */
+    explicit InstanceSet(std::vector<void*> raws)
+        : m_raws{std::move(raws)}
+    {}
+
+    iterator begin() const { return iterator{m_raws.data(), m_prefetchDistance, endPtr()}; }
+    iterator end() const { return iterator{endPtr(), m_prefetchDistance, endPtr()}; }
+
+    /**
+     * @brief   Gets the distance in elements iterators prefetch ahead.
+     */
+    std::size_t prefetchDistance() const { return m_prefetchDistance; }
+
+    /**
+     * @brief   Sets the distance in elements iterators prefetch ahead, 0 to disable prefetching.
+     */
+    void setPrefetchDistance(std::size_t distance) { m_prefetchDistance = distance; }
+
+    /**
+     * @brief   Gets the number of objects.
+     * @return  The number of objects.
+     */
+    std::size_t size() const { return m_raws.size(); }
+
+    /**
+     * @brief   Determines whether the set is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return m_raws.empty(); }
+
+    /**
+     * @brief   Gets the raw pointers of the objects.
+     * @return  Pointer to the first of `size()` raw pointers.
+     */
+    void* const* data() const { return m_raws.data(); }
+
+    /**
+     * @brief   Determines whether an object is part of the set.
+     * @param   raw The raw pointer of the object.
+     * @return  @c true if contained, else @c false.
+     */
+    bool contains(const void* raw) const 
+    { 
+        return std::binary_search(m_raws.begin(), m_raws.end(), const_cast<void*>(raw));
+    }
+
+    /**
+     * @brief   Creates a wrapper for an object.
+     * @param   idx The index of the object.
+     * @return  The wrapper.
+     */
+    WrapperT operator [] (std::size_t idx) const { return wrapper_cast<WrapperT>(m_raws[idx]); }
+private:
+    void* const* endPtr() const { return m_raws.data() + m_raws.size(); }
+private:
+    std::vector<void*> m_raws;
+    std::size_t m_prefetchDistance = 8;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [VftableScanner]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Locates candidate instances of polymorphic classes by searching memory for their
+ *          vftable addresses.
+ *
+ * Up to 8 vftables (e.g. of a class and its subclasses) are searched for in a single vectorized
+ * pass, more fall back to a scalar comparison. Multi-threaded scans split the memory into chunks
+ * handed out to the threads on demand, balancing regions of very different sizes. Candidates of
+ * repeated scans accumulate until `reset` is called, except for process scans, which replace 
+ * them.
+ */
+class VftableScanner
+{
+public:
+    /**
+     * @brief   A block of memory.
+     */
+    struct Range
+    {
+        const uint8_t* begin;
+        std::size_t size;
+    };
+
+    /**
+     * @brief   Adds a vftable to search for.
+     * @param   vftable The address of the vftable.
+     * @return  The index of the vftable, to query the candidates with.
+     */
+    std::size_t add(const void* vftable)
+    {
+        m_vftables.push_back(reinterpret_cast<uintptr_t>(vftable));
+        m_candidates.emplace_back();
+        return m_vftables.size() - 1;
+    }
+
+    /**
+     * @brief   Adds the vftable of a known instance to search for.
+     * @param   instance    The instance.
+     * @return  The index of the vftable, to query the candidates with.
+     */
+    std::size_t addOf(const ClassWrapper& instance)
+    {
+        return add(*static_cast<void* const*>(instance.addressOfObj()));
+    }
+
+    /**
+     * @brief   Gets the number of vftables searched for.
+     * @return  The number of vftables.
+     */
+    std::size_t size() const { return m_vftables.size(); }
+
+    /**
+     * @brief   Discards all candidates, the next `rescanProcess` scans all memory again.
+     */
+    void reset()
+    {
+        for (auto& candidates : m_candidates) candidates.clear();
+        m_knownRegions.clear();
+        m_hasBaseline = false;
+    }
+
+    /**
+     * @brief   Enables incremental process rescans, see `rescanProcess`.
+     * @return  @c true if supported by the platform, else @c false.
+     * @note    On Linux, this uses soft-dirty bits, which are reset for the whole process on 
+     *          every rescan (affecting e.g. a `WatchSet` with page tracking as well).
+     */
+    bool enablePageTracking()
+    {
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            if (m_tracker) return true;
+            std::unique_ptr<platform::SoftDirtyTracker> tracker{new platform::SoftDirtyTracker};
+            if (!tracker->isAvailable()) return false;
+            m_tracker     = std::move(tracker);
+            m_hasBaseline = false;
+            return true;
+#       else
+            return false;
+#       endif
+    }
+
+    /**
+     * @brief   Determines whether page tracking is enabled.
+     */
+    bool isPageTrackingEnabled() const
+    {
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            return m_tracker != nullptr;
+#       else
+            return false;
+#       endif
+    }
+
+    /**
+     * @brief   Gets the number of bytes searched by the last scan.
+     * @return  The number of bytes.
+     */
+    std::size_t lastScanSize() const { return m_lastScanSize; }
+
+    /**
+     * @brief   Searches a block of memory.
+     * @param   data        The memory to search.
+     * @param   size        The size of the memory, in bytes.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per
+     *                      hardware thread.
+     */
+    void scan(const void* data, std::size_t size, unsigned threadCount = 1)
+    {
+        scanRanges({{static_cast<const uint8_t*>(data), size}}, threadCount);
+    }
+
+    /**
+     * @brief   Brings the candidates up to date after memory was written.
+     * @param   dirty       The ranges written since the candidates were found, in ascending 
+     *                      order and not overlapping.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per
+     *                      hardware thread.
+     *
+     * Candidates outside of the dirty ranges are re-validated by checking their vftable pointer,
+     * candidates inside are dropped. The dirty ranges are then searched, so the cost depends on
+     * the number of candidates and the amount of dirty memory only. All candidates have to be 
+     * still mapped.
+     */
+    void update(const std::vector<Range>& dirty, unsigned threadCount = 1)
+    {
+        revalidate(dirty, nullptr);
+        scanRanges(dirty, threadCount);
+    }
+
+    /**
+     * @brief   Searches all readable and writable memory of the process, replacing the 
+     *          candidates found before.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per
+     *                      hardware thread.
+     * @return  @c true if the memory regions could be enumerated, else @c false.
+     */
+    bool scanProcess(unsigned threadCount = 0)
+    {
+        std::vector<Range> regions;
+        if (!writableRegions(regions)) return false;
+
+        for (auto& candidates : m_candidates) candidates.clear();
+        scanRanges(regions, threadCount);
+        return true;
+    }
+
+    /**
+     * @brief   Brings the candidates up to date with all readable and writable memory of the 
+     *          process, searching only memory written or mapped since the last rescan.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per
+     *                      hardware thread.
+     * @return  @c true if the memory regions could be enumerated, else @c false.
+     *
+     * The first rescan after enabling page tracking (or after `reset`) searches all memory.
+     * Subsequent ones drop candidates that were unmapped, re-validate the others (see `update`)
+     * and only search the pages that were written since the previous rescan as well as regions
+     * that weren't mapped back then, so the steady state cost is proportional to the churn
+     * rather than to the size of the heap. Without page tracking, every rescan starts over and
+     * searches all memory.
+     *
+     * @note    Pages written between querying and resetting the dirty bits are missed until
+     *          they are written again.
+     */
+    bool rescanProcess(unsigned threadCount = 0)
+    {
+        std::vector<Range> regions;
+        if (!writableRegions(regions)) return false;
+
+#   ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+        if (m_tracker && m_hasBaseline)
+        {
+            std::vector<Range> dirty;
+            if (!collectDirty(regions, dirty)) return false;
+            m_tracker->reset();
+            revalidate(dirty, &regions);
+            scanRanges(dirty, threadCount);
+            m_knownRegions = std::move(regions);
+            return true;
+        }
+        if (m_tracker) m_tracker->reset();
+#   endif
+
+        reset();
+        scanRanges(regions, threadCount);
+        m_hasBaseline  = isPageTrackingEnabled();
+        m_knownRegions = std::move(regions);
+        return true;
+    }
+
+    /**
+     * @brief   Searches the writable data sections of a module, i.e. its global objects.
+     * @param   module      The module.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per
+     *                      hardware thread.
+     * @return  @c true if the sections could be enumerated, else @c false.
+     */
+    bool scanModule(const Module& module, unsigned threadCount = 0)
+    {
+        std::vector<Range> ranges;
+        if (!platform::enumModuleSections(module.addressOfObj(), 
+            [&](const platform::ModuleSection& section)
+        {
+            if (section.kind == platform::SectionKind::Data) 
+            {
+                ranges.push_back({section.begin, section.size});
+            }
+        })) return false;
+
+        scanRanges(std::move(ranges), threadCount);
+        return true;
+    }
+
+    /**
+     * @brief   Gets the candidates found for a vftable.
+     * @param   idx The index of the vftable.
+     * @return  The raw pointers of the candidates, in ascending order.
+     */
+    const std::vector<void*>& candidates(std::size_t idx) const { return m_candidates[idx]; }
+
+    /**
+     * @brief   Gets the candidates found for a vftable as wrappers.
+     * @tparam  WrapperT    Type of the wrapper.
+     * @param   idx         The index of the vftable.
+     * @return  The candidates.
+     */
+    template<typename WrapperT>
+    InstanceSet<WrapperT> instances(std::size_t idx) const
+    {
+        return InstanceSet<WrapperT>{m_candidates[idx]};
+    }
+
+    /**
+     * @brief   Gets the candidates found for all vftables as wrappers.
+     * @tparam  WrapperT    Type of the wrapper, common to all vftables searched for.
+     * @return  The candidates.
+     */
+    template<typename WrapperT>
+    InstanceSet<WrapperT> instances() const
+    {
+        std::vector<void*> all;
+        for (const auto& candidates : m_candidates)
+        {
+            all.insert(all.end(), candidates.begin(), candidates.end());
+        }
+        std::sort(all.begin(), all.end());
+        return InstanceSet<WrapperT>{std::move(all)};
+    }
+private:
+    /**
+     * @internal
+     * @brief   The size of the chunks the memory is split into for multi-threaded scans, a
+     *          multiple of the pointer size.
+     */
+    static const std::size_t kChunkSize = 1024 * 1024;
+
+    /**
+     * @internal
+     * @brief   The amount of stack below the scan loop that is considered the scanner's own, 
+     *          holding copies of the vftables made by the kernels.
+     */
+    static const uintptr_t kOwnStackSize = 64 * 1024;
+
+    /**
+     * @internal
+     * @brief   Scans memory ranges and records the candidates.
+     * @param   ranges      The ranges.
+     * @param   threadCount The maximum number of threads, zero for one per hardware thread.
+     */
+    void scanRanges(const std::vector<Range>& ranges, unsigned threadCount)
+    {
+        m_lastScanSize = 0;
+        if (m_vftables.empty()) return;
+
+        // Split into chunks, keeping chunk boundaries word aligned so no word is skipped.
+        std::vector<Range> chunks;
+        for (const auto& range : ranges)
+        {
+            auto cur = range.begin;
+            auto end = range.begin + range.size;
+            auto alignedCur = (reinterpret_cast<uintptr_t>(cur) + sizeof(void*) - 1)
+                / sizeof(void*) * sizeof(void*);
+            cur = reinterpret_cast<const uint8_t*>(std::min(alignedCur, 
+                reinterpret_cast<uintptr_t>(end)));
+            m_lastScanSize += static_cast<std::size_t>(end - cur);
+            for (; cur < end; cur += kChunkSize)
+            {
+                auto size = std::min(std::size_t{kChunkSize}, static_cast<std::size_t>(end - cur));
+                chunks.push_back({cur, size});
+                if (size < kChunkSize) break;
+            }
+        }
+
+        if (!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        auto workerCount = std::max<std::size_t>(std::min<std::size_t>(threadCount, 
+            chunks.size()), 1);
+
+        std::vector<std::vector<const void*>> matches(workerCount);
+        std::vector<uintptr_t> stackMarks(workerCount);
+        std::atomic<std::size_t> nextChunk{0};
+        auto work = [&](std::size_t worker)
+        {
+            volatile uint8_t mark = 0;
+            stackMarks[worker] = reinterpret_cast<uintptr_t>(&mark);
+            for (;;)
+            {
+                auto idx = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (idx >= chunks.size()) return;
+                findPointerValues(chunks[idx].begin, chunks[idx].size, m_vftables.data(), 
+                    m_vftables.size(), matches[worker]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount - 1);
+        for (std::size_t i = 1; i < workerCount; ++i) threads.emplace_back(work, i);
+        work(0);
+        for (auto& thread : threads) thread.join();
+
+        for (const auto& workerMatches : matches) record(workerMatches, stackMarks);
+        for (auto& candidates : m_candidates)
+        {
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Finds the range containing an address.
+     * @param   ranges  The ranges, in ascending order and not overlapping.
+     * @param   addr    The address.
+     * @return  An iterator to the range, `ranges.end()` if not contained in any.
+     */
+    static std::vector<Range>::const_iterator findRange(const std::vector<Range>& ranges, 
+        const void* addr)
+    {
+        auto ptr = static_cast<const uint8_t*>(addr);
+        auto it  = std::upper_bound(ranges.begin(), ranges.end(), ptr, 
+            [](const uint8_t* lhs, const Range& rhs) { return lhs < rhs.begin; });
+        if (it == ranges.begin()) return ranges.end();
+        --it;
+        return static_cast<std::size_t>(ptr - it->begin) < it->size ? it : ranges.end();
+    }
+
+    /**
+     * @internal
+     * @brief   Drops the candidates that are inside of dirty ranges, unmapped or no longer 
+     *          referring to their vftable.
+     * @param   dirty   The dirty ranges, in ascending order and not overlapping.
+     * @param   mapped  The mapped ranges, in ascending order and not overlapping. If @c nullptr,
+     *                  all candidates are assumed to be mapped.
+     */
+    void revalidate(const std::vector<Range>& dirty, const std::vector<Range>* mapped)
+    {
+        for (std::size_t idx = 0; idx < m_candidates.size(); ++idx)
+        {
+            auto& candidates = m_candidates[idx];
+            auto vftable = m_vftables[idx];
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), 
+                [&](void* candidate)
+            {
+                if (findRange(dirty, candidate) != dirty.end()) return true;
+                if (mapped && findRange(*mapped, candidate) == mapped->end()) return true;
+                return *static_cast<const uintptr_t*>(candidate) != vftable;
+            }), candidates.end());
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Gets the readable and writable regions of the process.
+     * @param   regions Receives the regions, in ascending order.
+     * @return  @c true on success, else @c false.
+     */
+    static bool writableRegions(std::vector<Range>& regions)
+    {
+#   ifdef REMODEL_HAS_REGION_QUERY
+        auto ok = platform::enumWritableRegions([&](const void* begin, std::size_t size)
+        {
+            regions.push_back({static_cast<const uint8_t*>(begin), size});
+        });
+        std::sort(regions.begin(), regions.end(), 
+            [](const Range& lhs, const Range& rhs) { return lhs.begin < rhs.begin; });
+        return ok;
+#   else
+        (void)regions;
+        return false;
+#   endif
+    }
+
+#   ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+    /**
+     * @internal
+     * @brief   Determines the memory to search in an incremental rescan: the dirty pages of 
+     *          regions known from the previous rescan and all memory mapped since.
+     * @param   regions The current regions, in ascending order.
+     * @param   dirty   Receives the memory to search, in ascending order.
+     * @return  @c true on success, else @c false.
+     */
+    bool collectDirty(const std::vector<Range>& regions, std::vector<Range>& dirty) const
+    {
+        auto pageSize = m_tracker->pageSize();
+        auto add = [&](const uint8_t* begin, std::size_t size)
+        {
+            if (!dirty.empty() && dirty.back().begin + dirty.back().size == begin)
+            {
+                dirty.back().size += size;
+                return;
+            }
+            dirty.push_back({begin, size});
+        };
+
+        auto known = m_knownRegions.begin();
+        for (const auto& region : regions)
+        {
+            auto cur = region.begin;
+            auto end = region.begin + region.size;
+            while (cur < end)
+            {
+                while (known != m_knownRegions.end() && known->begin + known->size <= cur) ++known;
+
+                // Memory not known before is searched as a whole.
+                auto knownBegin = known != m_knownRegions.end() ? known->begin : end;
+                if (cur < knownBegin)
+                {
+                    auto gapEnd = std::min(knownBegin, end);
+                    add(cur, static_cast<std::size_t>(gapEnd - cur));
+                    cur = gapEnd;
+                    continue;
+                }
+
+                auto overlapEnd = std::min(known->begin + known->size, end);
+                if (!m_tracker->forEachDirtyPage(cur, static_cast<std::size_t>(overlapEnd - cur),
+                    [&](const uint8_t* page) 
+                { 
+                    auto first = std::max(page, cur);
+                    auto last  = std::min(page + pageSize, overlapEnd);
+                    add(first, static_cast<std::size_t>(last - first));
+                })) return false;
+                cur = overlapEnd;
+            }
+        }
+        return true;
+    }
+#   endif
+
+    /**
+     * @internal
+     * @brief   Assigns matches to the vftables they refer to.
+     * @param   matches     The addresses of words equal to a vftable address.
+     * @param   stackMarks  Addresses on the stacks of the scanning threads, above the kernels.
+     */
+    void record(const std::vector<const void*>& matches, const std::vector<uintptr_t>& stackMarks)
+    {
+        auto ownBegin = reinterpret_cast<uintptr_t>(m_vftables.data());
+        auto ownEnd   = reinterpret_cast<uintptr_t>(m_vftables.data() + m_vftables.size());
+        for (auto match : matches)
+        {
+            // Our own list of vftables and the kernels' copies of it trivially match.
+            auto addr = reinterpret_cast<uintptr_t>(match);
+            if (addr >= ownBegin && addr < ownEnd) continue;
+            if (std::any_of(stackMarks.begin(), stackMarks.end(), 
+                [&](uintptr_t mark) { return addr < mark && mark - addr <= kOwnStackSize; })) 
+            {
+                continue;
+            }
+
+            // The word may have changed since, only record it if it still matches.
+            auto value = *static_cast<const uintptr_t*>(match);
+            auto it = std::find(m_vftables.begin(), m_vftables.end(), value);
+            if (it == m_vftables.end()) continue;
+
+            m_candidates[static_cast<std::size_t>(it - m_vftables.begin())].push_back(
+                const_cast<void*>(match));
+        }
+    }
+private:
+    std::vector<uintptr_t> m_vftables;
+    std::vector<std::vector<void*>> m_candidates;
+    std::vector<Range> m_knownRegions;
+    bool m_hasBaseline = false;
+    std::size_t m_lastScanSize = 0;
+#   ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+    std::unique_ptr<platform::SoftDirtyTracker> m_tracker;
+#   endif
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_INSTANCESCAN_HPP
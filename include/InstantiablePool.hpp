@@ -0,0 +1,472 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_INSTANTIABLEPOOL_HPP
+#define REMODEL_INSTANTIABLEPOOL_HPP
+
+/**     
+ * @file
+ * @brief Contains an arena for creating large numbers of instantiable wrappers and instantiable
+ *        wrappers allocated by the target.
+ *        
+ * @code
+ *      InstantiablePool<Horse> horses;
+ *      auto first = horses.createMany(1000, "Bucephalus");
+ *      for (std::size_t i = first; i < horses.size(); ++i)
+ *      {
+ *          stable->addHorse(horses[i].addressOfObj());
+ *      }
+ *      horses.clear(); // calls `destruct` for every horse
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [InstantiablePool]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Arena owning `Instantiable`s of a wrapper type.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ *                      
+ * Objects are constructed in chunks allocated once per `chunkSize` objects instead of once per 
+ * object, and are only destroyed all at once, by `clear` or on destruction of the pool. Their 
+ * `destruct` routines are called in reverse creation order. Objects never move, the addresses 
+ * of objects and wrapped objects are stable for the lifetime of the pool (or up to `clear`).
+ */
+template<typename WrapperT>
+class InstantiablePool : public zycore::NonCopyable
+{
+public:
+    using Instantiable = internal::InstantiableWrapper<WrapperT>;
+private:
+    /// Slot holding a single instance, aligned for the wrapper's members.
+    using Slot = typename std::aligned_storage<
+        sizeof(Instantiable), 
+        (alignof(Instantiable) > alignof(void*) ? alignof(Instantiable) : alignof(void*))
+        >::type;
+
+    std::size_t        m_chunkSize;
+    std::vector<Slot*> m_chunks;
+    std::size_t        m_size = 0;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   chunkSize   The number of objects allocated at once.
+     */
+    explicit InstantiablePool(std::size_t chunkSize = 256)
+        : m_chunkSize{chunkSize ? chunkSize : 1}
+    {}
+
+    /**
+     * @brief   Destructor destroying all objects.
+     */
+    ~InstantiablePool() 
+    { 
+        clear(); 
+        for (auto chunk : m_chunks) internal::freeAligned(chunk, alignof(Slot));
+    }
+
+    /**
+     * @brief   Constructs a new object.
+     * @param   args    Arguments passed to the `construct` routine.
+     * @return  The new object.
+     */
+    template<typename... ArgsT>
+    Instantiable& create(ArgsT&&... args)
+    {
+        reserve(m_size + 1);
+        auto object = new (slot(m_size)) Instantiable(std::forward<ArgsT>(args)...);
+        ++m_size;
+        return *object;
+    }
+
+    /**
+     * @brief   Constructs multiple objects from the same arguments.
+     * @param   count   The number of objects to create.
+     * @param   args    Arguments passed to the `construct` routine of every object.
+     * @return  The index of the first new object.
+     */
+    template<typename... ArgsT>
+    std::size_t createMany(std::size_t count, const ArgsT&... args)
+    {
+        auto first = m_size;
+        reserve(m_size + count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            new (slot(m_size)) Instantiable(args...);
+            ++m_size;
+        }
+        return first;
+    }
+
+    /**
+     * @brief   Allocates chunks for a total number of objects up-front.
+     * @param   capacity    The number of objects.
+     */
+    void reserve(std::size_t capacity)
+    {
+        while (m_chunks.size() * m_chunkSize < capacity)
+        {
+            m_chunks.push_back(static_cast<Slot*>(
+                internal::allocateAligned(m_chunkSize * sizeof(Slot), alignof(Slot))));
+        }
+    }
+
+    /**
+     * @brief   Destroys all objects, in reverse creation order. Chunks are kept for reuse.
+     */
+    void clear()
+    {
+        while (m_size)
+        {
+            --m_size;
+            (*this)[m_size].~Instantiable();
+        }
+    }
+
+    /**
+     * @brief   Gets the number of objects.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief   Gets the number of objects that fit into the allocated chunks.
+     */
+    std::size_t capacity() const { return m_chunks.size() * m_chunkSize; }
+
+    /**
+     * @brief   Gets an object by creation index.
+     */
+    Instantiable& operator [] (std::size_t idx)
+    {
+        return *reinterpret_cast<Instantiable*>(slot(idx));
+    }
+
+    /**
+     * @copydoc operator[]
+     */
+    const Instantiable& operator [] (std::size_t idx) const
+    {
+        return *reinterpret_cast<const Instantiable*>(
+            const_cast<InstantiablePool*>(this)->slot(idx));
+    }
+private:
+    Slot* slot(std::size_t idx) { return &m_chunks[idx / m_chunkSize][idx % m_chunkSize]; }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [TargetHeap]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Fixed-size blocks from the target's allocator, cached per thread.
+ * @tparam  AllocPtrT   Function pointer type of the allocator, taking the size, e.g. the one of 
+ *                      a `Function` wrapping the target's `malloc` or `operator new`.
+ * @tparam  FreePtrT    Function pointer type of the matching deallocator.
+ *                      
+ * Freed blocks are kept in a cache of the freeing thread and handed out again, so the steady 
+ * state doesn't call into the target. Caches exceeding their capacity spill half of their 
+ * blocks to a shared list other threads refill from, and give their blocks to the shared list 
+ * on thread exit. Blocks in the shared list are returned to the target by `trim` or when the 
+ * heap is destroyed.
+ * 
+ * @note    Blocks are as aligned as the target's allocator returns them.
+ */
+template<typename AllocPtrT = void* (*)(std::size_t), typename FreePtrT = void (*)(void*)>
+class TargetHeap : public zycore::NonCopyable
+{
+    /**
+     * @brief   State shared with the thread caches, which may outlive the heap.
+     */
+    struct Shared
+    {
+        AllocPtrT          alloc;
+        FreePtrT           free;
+        std::size_t        blockSize;
+        std::mutex         mutex;
+        std::vector<void*> blocks;
+        bool               alive = true;
+
+        void give(void* const* first, std::size_t count)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            if (alive)
+            {
+                blocks.insert(blocks.end(), first, first + count);
+                return;
+            }
+            for (std::size_t i = 0; i < count; ++i) free(first[i]);
+        }
+    };
+
+    struct LocalCache
+    {
+        std::shared_ptr<Shared> shared;
+        std::vector<void*>      blocks;
+    };
+
+    struct LocalCaches
+    {
+        std::vector<LocalCache> caches;
+
+        ~LocalCaches()
+        {
+            for (auto& cache : caches) 
+            {
+                cache.shared->give(cache.blocks.data(), cache.blocks.size());
+            }
+        }
+    };
+
+    std::shared_ptr<Shared> m_shared;
+    std::size_t             m_cacheSize;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   alloc       The allocator.
+     * @param   free        The deallocator.
+     * @param   blockSize   The size of the blocks, in bytes.
+     * @param   cacheSize   The maximum number of blocks cached per thread.
+     */
+    TargetHeap(AllocPtrT alloc, FreePtrT free, std::size_t blockSize, std::size_t cacheSize = 64)
+        : m_shared{std::make_shared<Shared>()}
+        , m_cacheSize{cacheSize ? cacheSize : 1}
+    {
+        m_shared->alloc     = alloc;
+        m_shared->free      = free;
+        m_shared->blockSize = blockSize;
+    }
+
+    /**
+     * @brief   Destructor, returning the shared blocks to the target. Blocks still cached by 
+     *          other threads are returned on their exit.
+     */
+    ~TargetHeap()
+    {
+        for (auto it = localCaches().caches.begin(); it != localCaches().caches.end(); ++it)
+        {
+            if (it->shared != m_shared) continue;
+            for (auto block : it->blocks) m_shared->free(block);
+            localCaches().caches.erase(it);
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock{m_shared->mutex};
+        for (auto block : m_shared->blocks) m_shared->free(block);
+        m_shared->blocks.clear();
+        m_shared->alive = false;
+    }
+
+    /**
+     * @brief   Allocates a block.
+     * @return  The block, @c nullptr if the target's allocator failed.
+     */
+    void* allocate()
+    {
+        auto& cache = localCache();
+        if (cache.empty())
+        {
+            std::lock_guard<std::mutex> lock{m_shared->mutex};
+            auto& shared = m_shared->blocks;
+            auto count = std::min(shared.size(), (m_cacheSize + 1) / 2);
+            cache.insert(cache.end(), shared.end() - count, shared.end());
+            shared.resize(shared.size() - count);
+        }
+        if (cache.empty()) return m_shared->alloc(m_shared->blockSize);
+
+        auto block = cache.back();
+        cache.pop_back();
+        return block;
+    }
+
+    /**
+     * @brief   Frees a block, allocated by any thread.
+     * @param   block   The block, may be null.
+     */
+    void deallocate(void* block)
+    {
+        if (!block) return;
+        auto& cache = localCache();
+        cache.push_back(block);
+        if (cache.size() <= m_cacheSize) return;
+
+        auto count = cache.size() / 2;
+        m_shared->give(cache.data() + cache.size() - count, count);
+        cache.resize(cache.size() - count);
+    }
+
+    /**
+     * @brief   Returns the blocks of the shared list to the target.
+     * @return  The number of blocks returned.
+     */
+    std::size_t trim()
+    {
+        std::lock_guard<std::mutex> lock{m_shared->mutex};
+        auto count = m_shared->blocks.size();
+        for (auto block : m_shared->blocks) m_shared->free(block);
+        m_shared->blocks.clear();
+        return count;
+    }
+
+    /**
+     * @brief   Gets the size of the blocks, in bytes.
+     */
+    std::size_t blockSize() const { return m_shared->blockSize; }
+
+    /**
+     * @brief   Gets the number of blocks cached by the calling thread.
+     */
+    std::size_t cachedByThread() const 
+    { 
+        return const_cast<TargetHeap*>(this)->localCache().size(); 
+    }
+private:
+    static LocalCaches& localCaches()
+    {
+        static thread_local LocalCaches caches;
+        return caches;
+    }
+
+    std::vector<void*>& localCache()
+    {
+        auto& caches = localCaches().caches;
+        for (auto& cache : caches) if (cache.shared == m_shared) return cache.blocks;
+        caches.push_back({m_shared, {}});
+        caches.back().blocks.reserve(m_cacheSize + 1);
+        return caches.back().blocks;
+    }
+};
+
+/**
+ * @brief   Creates a heap for a `Function` wrapping the target's allocator.
+ * @param   alloc       The allocator function, e.g. the target's `malloc`.
+ * @param   free        The deallocator function, e.g. the target's `free`.
+ * @param   blockSize   The size of the blocks, in bytes.
+ * @param   cacheSize   The maximum number of blocks cached per thread.
+ * @return  The heap.
+ */
+template<typename AllocT, typename AllocGetterT, typename FreeT, typename FreeGetterT>
+inline std::unique_ptr<TargetHeap<AllocT, FreeT>> makeTargetHeap(
+    const Function<AllocT, AllocGetterT>& alloc, const Function<FreeT, FreeGetterT>& free, 
+    std::size_t blockSize, std::size_t cacheSize = 64)
+{
+    return std::unique_ptr<TargetHeap<AllocT, FreeT>>{
+        new TargetHeap<AllocT, FreeT>{alloc.get(), free.get(), blockSize, cacheSize}};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [TargetInstantiable]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Instantiable wrapper whose object is allocated from a `TargetHeap`.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @tparam  HeapT       Type of the heap.
+ *                      
+ * Objects passed to target functions that free or keep them have to be allocated by the target.
+ * Like `Instantiable`, the wrapper calls the `construct` routine on creation and the `destruct` 
+ * routine on destruction, giving the block back to the heap. Call `release` to pass the 
+ * ownership to the target instead.
+ * 
+ * @code
+ *      auto heap = makeTargetHeap(targetMalloc, targetFree, Horse::kObjSize);
+ *      TargetInstantiable<Horse, decltype(heap)::element_type> horse{*heap, "Bucephalus"};
+ *      stable->adoptHorse(horse.release());
+ * @endcode
+ */
+template<typename WrapperT, typename HeapT = TargetHeap<>>
+class TargetInstantiable 
+    : public WrapperT
+    , public zycore::NonCopyable
+{
+    HeapT* m_heap;
+public:
+    /**
+     * @brief   Target instantiable wrappers own their object and can't be rebound.
+     */
+    void rebind(void* raw) = delete;
+
+    /**
+     * @brief   Constructor, allocating the object and calling the `construct` routine.
+     * @param   heap    The heap, with blocks of at least `WrapperT::kObjSize` bytes.
+     * @param   args    Arguments passed to the `construct` routine.
+     *          
+     * If the allocation fails, the wrapper is invalid and `construct` isn't called.
+     */
+    template<typename... ArgsT>
+    explicit TargetInstantiable(HeapT& heap, ArgsT&&... args)
+        : WrapperT{heap.allocate()}
+        , m_heap{&heap}
+    {
+        assert(heap.blockSize() >= WrapperT::kObjSize);
+        if (!isValid()) return;
+        internal::InstantiableWrapperCtorCaller<
+            WrapperT, internal::HasCustomCtor<WrapperT>::Value, ArgsT...
+            >::Call(this, std::forward<ArgsT>(args)...);
+    }
+
+    /**
+     * @brief   Destructor, calling the `destruct` routine and freeing the object unless released.
+     */
+    ~TargetInstantiable()
+    {
+        if (!isValid()) return;
+        internal::InstantiableWrapperDtorCaller<
+            WrapperT, internal::HasCustomDtor<WrapperT>::Value
+            >::Call(this);
+        m_heap->deallocate(this->addressOfObj());
+    }
+
+    /**
+     * @brief   Determines whether the object was allocated and is still owned.
+     */
+    bool isValid() const { return this->addressOfObj() != nullptr; }
+
+    /**
+     * @brief   Passes the ownership of the object on, e.g. to the target.
+     * @return  The raw pointer of the object. The wrapper is invalid afterwards.
+     */
+    void* release()
+    {
+        auto raw = this->addressOfObj();
+        this->ClassWrapper::rebind(nullptr);
+        return raw;
+    }
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_INSTANTIABLEPOOL_HPP
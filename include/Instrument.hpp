@@ -0,0 +1,532 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_INSTRUMENT_HPP
+#define REMODEL_INSTRUMENT_HPP
+
+/**     
+ * @file
+ * @brief Contains the access counters of the opt-in instrumentation mode.
+ *        
+ * When `REMODEL_INSTRUMENT` is defined (for all translation units, e.g. using the CMake option
+ * of the same name), every `Field`, `StaticField`, `Function`, `MemberFunction` and (cached)
+ * `VirtualFunction` remembers the source location it was declared at. Field accesses and calls 
+ * are counted per declaration in thread-local counters, calls are optionally timed in cycles. 
+ * Without `REMODEL_INSTRUMENT`, wrappers are unchanged and the functions below do nothing.
+ *
+ * @code
+ *      remodel::instrument::setTimingEnabled(true);
+ *      runMod();
+ *      remodel::instrument::dumpStats(stderr);
+ * @endcode
+ * 
+ * Declaration sites are captured using `__builtin_FILE` and `__builtin_LINE` (GCC 4.8, 
+ * clang 9, MSVC 19.26 or newer), their ID is looked up whenever a wrapper is constructed. Some 
+ * compilers (e.g. GCC) report the wrapper's constructor, i.e. the `REMODEL_WRAPPER` line, for
+ * members initialized in-class, so members are further told apart by their offset inside of 
+ * the wrapper.
+ */
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#ifdef REMODEL_INSTRUMENT
+#   include "Platform.hpp"
+#   include <algorithm>
+#   include <atomic>
+#   include <cstring>
+#   include <memory>
+#   include <mutex>
+#   include <string>
+#   include <unordered_map>
+#   include <utility>
+#endif
+
+namespace remodel
+{
+namespace instrument
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Site]                                                                                         //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The kind of an instrumented declaration.
+ */
+enum class SiteKind
+{
+    Field,
+    Function,
+};
+
+/**
+ * @brief   The source location of a declaration.
+ */
+struct Site
+{
+    const char* file;
+    unsigned    line;
+
+#   ifdef REMODEL_INSTRUMENT
+        /**
+         * @brief   Obtains the site of the caller, if used as a default argument, the site of the
+         *          caller of the function having the default argument.
+         * @return  The site.
+         */
+        static Site current(const char* file = __builtin_FILE(), unsigned line = __builtin_LINE())
+        {
+            return Site{file, line};
+        }
+#   endif
+};
+
+/**
+ * @brief   Aggregated statistics of a declaration.
+ */
+struct SiteStats
+{
+    Site     site;
+    SiteKind kind;
+    /// Offset of the member inside of its wrapper, -1 for declarations without parent.
+    std::ptrdiff_t member;
+    /// Number of field accesses or calls.
+    uint64_t accesses;
+    /// Number of calls that were timed, see `setTimingEnabled`.
+    uint64_t timedCalls;
+    /// Sum of the durations of timed calls, in cycles (or nanoseconds on non-x86 platforms).
+    uint64_t cycles;
+};
+
+#ifdef REMODEL_INSTRUMENT
+
+// ---------------------------------------------------------------------------------------------- //
+// [Counters]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Counters of a declaration, written by a single thread only.
+ */
+struct Counter
+{
+    std::atomic<uint64_t> accesses{0};
+    std::atomic<uint64_t> timedCalls{0};
+    std::atomic<uint64_t> cycles{0};
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        // Single writer: a plain load and store suffices, readers merely need untorn values.
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @internal
+ * @brief   Totals of a declaration, accumulated from exited threads.
+ */
+struct Totals
+{
+    uint64_t accesses;
+    uint64_t timedCalls;
+    uint64_t cycles;
+};
+
+class ThreadCounters;
+
+/**
+ * @internal
+ * @brief   Process-wide registry of declaration sites and thread counters.
+ */
+struct Registry
+{
+    struct SiteKey
+    {
+        std::string file;
+        unsigned line;
+        SiteKind kind;
+        std::ptrdiff_t member;
+
+        bool operator == (const SiteKey& rhs) const 
+        { 
+            return line == rhs.line && kind == rhs.kind && member == rhs.member 
+                && file == rhs.file; 
+        }
+    };
+
+    struct SiteKeyHash
+    {
+        std::size_t operator () (const SiteKey& key) const
+        {
+            return std::hash<std::string>{}(key.file) ^ (key.line * 0x9E3779B9u) 
+                ^ (static_cast<std::size_t>(key.member) << 8) ^ static_cast<std::size_t>(key.kind);
+        }
+    };
+
+    std::mutex mutex;
+    std::unordered_map<SiteKey, uint32_t, SiteKeyHash> ids;
+    std::vector<SiteStats> sites;
+    std::vector<Totals> retired;
+    std::vector<ThreadCounters*> threads;
+    std::atomic<bool> timing{false};
+};
+
+/**
+ * @internal
+ * @brief   Gets the registry.
+ */
+inline Registry& registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+/**
+ * @internal
+ * @brief   The counters of the current thread, in chunks that never move once allocated.
+ */
+class ThreadCounters
+{
+public:
+    static const std::size_t kChunkSize = 256;
+
+    ThreadCounters()
+        : m_registry{registry()}
+    {
+        std::lock_guard<std::mutex> lock{m_registry.mutex};
+        m_registry.threads.push_back(this);
+    }
+
+    ~ThreadCounters()
+    {
+        std::lock_guard<std::mutex> lock{m_registry.mutex};
+        forEach([&](uint32_t id, const Counter& counter)
+        {
+            auto& totals = m_registry.retired[id];
+            totals.accesses   += counter.accesses.load(std::memory_order_relaxed);
+            totals.timedCalls += counter.timedCalls.load(std::memory_order_relaxed);
+            totals.cycles     += counter.cycles.load(std::memory_order_relaxed);
+        });
+        auto& threads = m_registry.threads;
+        threads.erase(std::remove(threads.begin(), threads.end(), this), threads.end());
+    }
+
+    /**
+     * @brief   Gets the counter of a site, allocating chunks as required.
+     */
+    Counter& at(uint32_t id)
+    {
+        std::size_t chunk = id / kChunkSize;
+        if (chunk >= m_chunks.size())
+        {
+            // Readers iterate the chunk list while holding the lock, so grow it under the lock.
+            std::lock_guard<std::mutex> lock{m_registry.mutex};
+            while (m_chunks.size() <= chunk) 
+            {
+                m_chunks.emplace_back(new Counter[kChunkSize]);
+            }
+        }
+        return m_chunks[chunk][id % kChunkSize];
+    }
+
+    /**
+     * @brief   Invokes a function for every allocated counter, the registry lock has to be held.
+     */
+    template<typename FuncT>
+    void forEach(FuncT&& func) const
+    {
+        auto count = std::min<std::size_t>(m_chunks.size() * std::size_t{kChunkSize}, 
+            m_registry.sites.size());
+        for (std::size_t id = 0; id < count; ++id)
+        {
+            func(static_cast<uint32_t>(id), m_chunks[id / kChunkSize][id % kChunkSize]);
+        }
+    }
+private:
+    Registry& m_registry;
+    std::vector<std::unique_ptr<Counter[]>> m_chunks;
+};
+
+/**
+ * @internal
+ * @brief   Gets the counters of the current thread.
+ */
+inline ThreadCounters& threadCounters()
+{
+    static thread_local ThreadCounters counters;
+    return counters;
+}
+
+/**
+ * @internal
+ * @brief   Obtains the ID of a declaration, registering it on first use.
+ * @param   site    The site.
+ * @param   kind    The kind of the declaration.
+ * @param   member  The offset of the member inside of its wrapper, -1 if unknown.
+ * @return  The ID.
+ */
+inline uint32_t siteId(Site site, SiteKind kind, std::ptrdiff_t member)
+{
+    // File names are literals, so a per-thread cache keyed by pointer avoids taking the lock.
+    struct CacheKey
+    {
+        const char* file;
+        unsigned line;
+        std::ptrdiff_t member;
+
+        bool operator == (const CacheKey& rhs) const
+        {
+            return file == rhs.file && line == rhs.line && member == rhs.member;
+        }
+    };
+    struct CacheKeyHash
+    {
+        std::size_t operator () (const CacheKey& key) const
+        {
+            return std::hash<const char*>{}(key.file) ^ (key.line * 0x9E3779B9u) 
+                ^ (static_cast<std::size_t>(key.member) << 8);
+        }
+    };
+    static thread_local std::unordered_map<CacheKey, uint32_t, CacheKeyHash> cache[2];
+
+    auto& kindCache = cache[kind == SiteKind::Function];
+    auto cached = kindCache.find(CacheKey{site.file, site.line, member});
+    if (cached != kindCache.end()) return cached->second;
+
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    auto inserted = reg.ids.emplace(Registry::SiteKey{site.file, site.line, kind, member}, 
+        static_cast<uint32_t>(reg.sites.size()));
+    if (inserted.second)
+    {
+        reg.sites.push_back(SiteStats{site, kind, member, 0, 0, 0});
+        reg.retired.push_back(Totals{0, 0, 0});
+    }
+    kindCache.emplace(CacheKey{site.file, site.line, member}, inserted.first->second);
+    return inserted.first->second;
+}
+
+/**
+ * @internal
+ * @brief   Counts a field access.
+ * @param   id  The ID of the declaration.
+ */
+inline void recordAccess(uint32_t id)
+{
+    Counter::add(threadCounters().at(id).accesses, 1);
+}
+
+/**
+ * @internal
+ * @brief   Scope counting a call and, if enabled, timing it.
+ */
+class CallScope
+{
+public:
+    explicit CallScope(uint32_t id)
+        : m_counter{threadCounters().at(id)}
+        , m_start{
+            registry().timing.load(std::memory_order_relaxed) ? platform::readTimestamp() : 0}
+    {
+        Counter::add(m_counter.accesses, 1);
+    }
+
+    CallScope(const CallScope&) = delete;
+    CallScope& operator = (const CallScope&) = delete;
+
+    ~CallScope()
+    {
+        if (!m_start) return;
+        Counter::add(m_counter.cycles, platform::readTimestamp() - m_start);
+        Counter::add(m_counter.timedCalls, 1);
+    }
+private:
+    Counter& m_counter;
+    uint64_t m_start;
+};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [Statistics]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Enables or disables timing of calls, disabled by default.
+ * @param   enabled @c true to enable, @c false to disable.
+ */
+inline void setTimingEnabled(bool enabled)
+{
+    internal::registry().timing.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief   Determines whether calls are timed.
+ * @return  @c true if enabled, else @c false.
+ */
+inline bool isTimingEnabled()
+{
+    return internal::registry().timing.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief   Aggregates the counters of all threads, including exited ones.
+ * @return  The statistics of all declarations that were wrapped at least once, sorted by
+ *          the number of accesses, descending.
+ */
+inline std::vector<SiteStats> collectStats()
+{
+    auto& reg = internal::registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+
+    std::vector<SiteStats> stats = reg.sites;
+    for (std::size_t id = 0; id < stats.size(); ++id)
+    {
+        stats[id].accesses   = reg.retired[id].accesses;
+        stats[id].timedCalls = reg.retired[id].timedCalls;
+        stats[id].cycles     = reg.retired[id].cycles;
+    }
+    for (auto thread : reg.threads)
+    {
+        thread->forEach([&](uint32_t id, const internal::Counter& counter)
+        {
+            stats[id].accesses   += counter.accesses.load(std::memory_order_relaxed);
+            stats[id].timedCalls += counter.timedCalls.load(std::memory_order_relaxed);
+            stats[id].cycles     += counter.cycles.load(std::memory_order_relaxed);
+        });
+    }
+
+    std::stable_sort(stats.begin(), stats.end(), [](const SiteStats& a, const SiteStats& b)
+    {
+        return a.accesses > b.accesses;
+    });
+    return stats;
+}
+
+/**
+ * @brief   Resets all counters to zero.
+ * @note    Increments racing with the reset on other threads may survive it.
+ */
+inline void resetStats()
+{
+    auto& reg = internal::registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    std::fill(reg.retired.begin(), reg.retired.end(), internal::Totals{0, 0, 0});
+    for (auto thread : reg.threads)
+    {
+        thread->forEach([](uint32_t, const internal::Counter& counter)
+        {
+            auto& mutableCounter = const_cast<internal::Counter&>(counter);
+            mutableCounter.accesses.store(0, std::memory_order_relaxed);
+            mutableCounter.timedCalls.store(0, std::memory_order_relaxed);
+            mutableCounter.cycles.store(0, std::memory_order_relaxed);
+        });
+    }
+}
+
+#else // ifdef REMODEL_INSTRUMENT
+
+inline void setTimingEnabled(bool) {}
+inline bool isTimingEnabled() { return false; }
+inline std::vector<SiteStats> collectStats() { return {}; }
+inline void resetStats() {}
+
+#endif // ifdef REMODEL_INSTRUMENT
+
+/**
+ * @brief   Writes the aggregated statistics as a table, hottest declarations first.
+ * @param   out The stream to write to.
+ */
+inline void dumpStats(std::FILE* out)
+{
+    std::fprintf(out, "%14s %12s %12s  %-8s %s\n", 
+        "accesses", "timed calls", "avg cycles", "kind", "declaration [+member offset]");
+    for (const auto& stats : collectStats())
+    {
+        if (!stats.accesses) continue;
+        std::fprintf(out, "%14llu %12llu %12.1f  %-8s %s:%u",
+            static_cast<unsigned long long>(stats.accesses),
+            static_cast<unsigned long long>(stats.timedCalls),
+            stats.timedCalls ? static_cast<double>(stats.cycles) / stats.timedCalls : 0.,
+            stats.kind == SiteKind::Field ? "field" : "function",
+            stats.site.file, stats.site.line);
+        if (stats.member >= 0) std::fprintf(out, " [+0x%llX]", 
+            static_cast<unsigned long long>(stats.member));
+        std::fputc('\n', out);
+    }
+}
+
+// ============================================================================================== //
+
+} // namespace instrument
+} // namespace remodel
+
+// ---------------------------------------------------------------------------------------------- //
+// [Wrapper hooks]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_INSTRUMENT
+/**
+ * @internal
+ * @brief   Trailing constructor parameter capturing the declaration site of a wrapper member.
+ */
+#   define REMODEL_INSTRUMENT_SITE_PARAM                                                           \
+        , ::remodel::instrument::Site instrumentSite = ::remodel::instrument::Site::current()
+/**
+ * @internal
+ * @brief   Forwards the declaration site to a base class constructor.
+ */
+#   define REMODEL_INSTRUMENT_SITE_ARG , instrumentSite
+/**
+ * @internal
+ * @brief   Binds a field (or function) to its declaration site, used in constructor bodies.
+ */
+#   define REMODEL_INSTRUMENT_BIND(kind)                                                           \
+        this->m_instrumentId = ::remodel::instrument::internal::siteId(                            \
+            instrumentSite, ::remodel::instrument::SiteKind::kind, this->memberOffset())
+/**
+ * @internal
+ * @brief   Counts a field access.
+ */
+#   define REMODEL_INSTRUMENT_ACCESS()                                                             \
+        ::remodel::instrument::internal::recordAccess(this->m_instrumentId)
+/**
+ * @internal
+ * @brief   Counts and times a call until the end of the enclosing scope.
+ */
+#   define REMODEL_INSTRUMENT_CALL()                                                               \
+        ::remodel::instrument::internal::CallScope instrumentScope{this->m_instrumentId}
+#else
+#   define REMODEL_INSTRUMENT_SITE_PARAM
+#   define REMODEL_INSTRUMENT_SITE_ARG
+#   define REMODEL_INSTRUMENT_BIND(kind)    (void)0
+#   define REMODEL_INSTRUMENT_ACCESS()      (void)0
+#   define REMODEL_INSTRUMENT_CALL()        (void)0
+#endif // ifdef REMODEL_INSTRUMENT
+
+#endif // REMODEL_INSTRUMENT_HPP
@@ -0,0 +1,424 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_INTRUSIVE_HPP
+#define REMODEL_INTRUSIVE_HPP
+
+/**
+ * @file
+ * @brief Contains iterator adapters for intrusive linked lists and binary trees of wrapped 
+ *        objects.
+ *
+ * @code
+ *      // struct Cat { Cat* next; ... };
+ *      for (auto& cat : IntrusiveList<CatWrapper, offsetof(Cat, next)>{game->firstCat})
+ *      {
+ *          cat.giveGoodie(1);
+ *      }
+ *
+ *      // struct Node { Node* left; Node* right; ... }, iterated in order.
+ *      for (auto& node : IntrusiveTree<NodeWrapper, 0, sizeof(void*)>{map->root})
+ *      {
+ *          sum += node.value;
+ *      }
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+#include "Platform.hpp"
+
+#include <cstring>
+#include <iterator>
+
+namespace remodel
+{
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Loads a link pointer from a node and converts it into the raw pointer of the node it
+ *          refers to.
+ * @param   raw         The raw pointer of the node holding the link.
+ * @param   offs        The offset of the link inside the node.
+ * @param   linkOffs    The offset inside the referenced node the link points to.
+ * @param   sentinel    A link value terminating the structure in addition to @c nullptr.
+ * @return  The raw pointer of the referenced node, @c nullptr if the link is terminal.
+ */
+inline void* followLink(void* raw, std::ptrdiff_t offs, std::ptrdiff_t linkOffs, void* sentinel)
+{
+    void* link;
+    std::memcpy(&link, static_cast<uint8_t*>(raw) + offs, sizeof(link));
+    if (!link || link == sentinel) return nullptr;
+    return static_cast<uint8_t*>(link) - linkOffs;
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [IntrusiveList]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Forward iterator over the nodes of an intrusive singly or doubly linked list.
+ * @tparam  WrapperT    Type of the node wrapper.
+ * @tparam  nextOffsT   The offset of the `next` pointer inside a node.
+ * @tparam  linkOffsT   The offset inside the next node the `next` pointer points to. Zero for
+ *                      lists linking the nodes themselves, the offset of the embedded link
+ *                      structure for lists like `LIST_ENTRY`.
+ *
+ * Like `WrapperSpanIterator`, each iterator owns a single wrapper that is rebound as it moves, so
+ * references obtained by dereferencing are only valid until the iterator is moved. Whenever the
+ * iterator arrives at a node, the following node is prefetched, hiding its latency behind the
+ * work done on the current one.
+ */
+template<typename WrapperT, std::ptrdiff_t nextOffsT, std::ptrdiff_t linkOffsT = 0>
+class IntrusiveListIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = WrapperT;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = WrapperT*;
+    using reference         = WrapperT&;
+
+    /**
+     * @brief   Default constructor, creating an end iterator.
+     */
+    IntrusiveListIterator()
+        : m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+        , m_sentinel{nullptr}
+    {}
+
+    /**
+     * @brief   Constructs an iterator pointing to a node.
+     * @param   raw         The raw pointer of the node, @c nullptr for the end iterator.
+     * @param   sentinel    The link value terminating the list in addition to @c nullptr.
+     */
+    explicit IntrusiveListIterator(void* raw, void* sentinel = nullptr)
+        : m_wrapper{wrapper_cast<WrapperT>(raw)}
+        , m_sentinel{sentinel}
+    {
+        prefetchNext();
+    }
+
+    /**
+     * @brief   Copy constructor.
+     * @param   other   The iterator to copy from.
+     */
+    IntrusiveListIterator(const IntrusiveListIterator& other)
+        : m_wrapper{wrapper_cast<WrapperT>(other.raw())}
+        , m_sentinel{other.m_sentinel}
+    {}
+
+    /**
+     * @brief   Assignment operator, rebinding the wrapper of this iterator.
+     * @param   other   The iterator to assign from.
+     * @return  `*this`.
+     */
+    IntrusiveListIterator& operator = (const IntrusiveListIterator& other)
+    {
+        rebind(other.raw());
+        m_sentinel = other.m_sentinel;
+        return *this;
+    }
+
+    /**
+     * @brief   Gets the raw pointer of the current node.
+     * @return  The raw pointer, @c nullptr for the end iterator.
+     */
+    void* raw() const { return m_wrapper.addressOfObj(); }
+
+    reference operator * () const   { return m_wrapper; }
+    pointer operator -> () const    { return m_wrapper.addressOfWrapper(); }
+
+    IntrusiveListIterator& operator ++ ()
+    {
+        rebind(internal::followLink(raw(), nextOffsT, linkOffsT, m_sentinel));
+        prefetchNext();
+        return *this;
+    }
+
+    IntrusiveListIterator operator ++ (int) { auto tmp = *this; ++*this; return tmp; }
+
+    bool operator == (const IntrusiveListIterator& rhs) const { return raw() == rhs.raw(); }
+    bool operator != (const IntrusiveListIterator& rhs) const { return raw() != rhs.raw(); }
+private:
+    void rebind(void* raw) { m_wrapper.ClassWrapper::rebind(raw); }
+
+    void prefetchNext() const
+    {
+        if (!raw()) return;
+        if (auto next = internal::followLink(raw(), nextOffsT, linkOffsT, m_sentinel))
+        {
+            platform::prefetch(static_cast<uint8_t*>(next) + nextOffsT);
+        }
+    }
+private:
+    mutable WrapperT m_wrapper;
+    void* m_sentinel;
+};
+
+/**
+ * @brief   Range over the nodes of an intrusive linked list.
+ * @tparam  WrapperT    Type of the node wrapper.
+ * @tparam  nextOffsT   The offset of the `next` pointer inside a node.
+ * @tparam  linkOffsT   The offset inside the next node the `next` pointer points to.
+ * @see     IntrusiveListIterator
+ */
+template<typename WrapperT, std::ptrdiff_t nextOffsT, std::ptrdiff_t linkOffsT = 0>
+class IntrusiveList
+{
+public:
+    using iterator = IntrusiveListIterator<WrapperT, nextOffsT, linkOffsT>;
+
+    /**
+     * @brief   Constructor.
+     * @param   first       The raw pointer of the first node, may be @c nullptr.
+     * @param   sentinel    The link value terminating the list in addition to @c nullptr.
+     */
+    explicit IntrusiveList(void* first, void* sentinel = nullptr)
+        : m_first{first}
+        , m_sentinel{sentinel}
+    {}
+
+    /**
+     * @brief   Creates a range over a circular list with a bare head link, like `LIST_ENTRY`.
+     * @param   head    The address of the head link, not part of any node.
+     * @return  The range, ending when a link points back to the head.
+     */
+    static IntrusiveList circular(void* head)
+    {
+        // The head is a bare link, so its next pointer is located relative to the link.
+        auto headNode = static_cast<uint8_t*>(head) - linkOffsT;
+        return IntrusiveList{internal::followLink(headNode, nextOffsT, linkOffsT, head), head};
+    }
+
+    iterator begin() const { return iterator{m_first, m_sentinel}; }
+    iterator end() const { return iterator{}; }
+
+    /**
+     * @brief   Determines whether the list is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !m_first; }
+private:
+    void* m_first;
+    void* m_sentinel;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [IntrusiveTree]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Forward iterator visiting the nodes of an intrusive binary tree in order.
+ * @tparam  WrapperT    Type of the node wrapper.
+ * @tparam  leftOffsT   The offset of the `left` pointer inside a node.
+ * @tparam  rightOffsT  The offset of the `right` pointer inside a node.
+ * @tparam  linkOffsT   The offset inside the child node the child pointers point to, e.g. the
+ *                      offset of an embedded `rb_node`.
+ *
+ * No parent pointers are required (these often carry the node color in their low bits), the
+ * path to the current node is recorded on a fixed size stack inside the iterator instead. Trees
+ * deeper than `kMaxDepth`, which a balanced tree never reaches, are treated as corrupted and
+ * end the iteration. When a node becomes current, its right child is prefetched since it leads
+ * to the successor. As with the list iterator, a single wrapper is rebound as the iterator
+ * moves.
+ */
+template<typename WrapperT, std::ptrdiff_t leftOffsT, std::ptrdiff_t rightOffsT,
+    std::ptrdiff_t linkOffsT = 0>
+class IntrusiveTreeIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = WrapperT;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = WrapperT*;
+    using reference         = WrapperT&;
+
+    static const std::size_t kMaxDepth = 64;
+
+    /**
+     * @brief   Default constructor, creating an end iterator.
+     */
+    IntrusiveTreeIterator()
+        : m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+        , m_nil{nullptr}
+        , m_depth{0}
+    {}
+
+    /**
+     * @brief   Constructs an iterator pointing to the leftmost node of a tree.
+     * @param   root    The raw pointer of the root node, may be @c nullptr or @c nil.
+     * @param   nil     The link value marking absent children in addition to @c nullptr, e.g.
+     *                  the head node of trees using one as shared leaf.
+     */
+    explicit IntrusiveTreeIterator(void* root, void* nil = nullptr)
+        : m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+        , m_nil{nil}
+        , m_depth{0}
+    {
+        if (root != nil) pushLeft(root);
+        settle();
+    }
+
+    /**
+     * @brief   Copy constructor.
+     * @param   other   The iterator to copy from.
+     */
+    IntrusiveTreeIterator(const IntrusiveTreeIterator& other)
+        : m_wrapper{wrapper_cast<WrapperT>(other.raw())}
+        , m_nil{other.m_nil}
+        , m_depth{other.m_depth}
+    {
+        std::copy(other.m_stack, other.m_stack + m_depth, m_stack);
+    }
+
+    /**
+     * @brief   Assignment operator, rebinding the wrapper of this iterator.
+     * @param   other   The iterator to assign from.
+     * @return  `*this`.
+     */
+    IntrusiveTreeIterator& operator = (const IntrusiveTreeIterator& other)
+    {
+        rebind(other.raw());
+        m_nil   = other.m_nil;
+        m_depth = other.m_depth;
+        std::copy(other.m_stack, other.m_stack + m_depth, m_stack);
+        return *this;
+    }
+
+    /**
+     * @brief   Gets the raw pointer of the current node.
+     * @return  The raw pointer, @c nullptr for the end iterator.
+     */
+    void* raw() const { return m_wrapper.addressOfObj(); }
+
+    reference operator * () const   { return m_wrapper; }
+    pointer operator -> () const    { return m_wrapper.addressOfWrapper(); }
+
+    IntrusiveTreeIterator& operator ++ ()
+    {
+        if (!m_depth) return *this;
+        auto current = m_stack[--m_depth];
+        pushLeft(child(current, rightOffsT));
+        settle();
+        return *this;
+    }
+
+    IntrusiveTreeIterator operator ++ (int) { auto tmp = *this; ++*this; return tmp; }
+
+    bool operator == (const IntrusiveTreeIterator& rhs) const { return raw() == rhs.raw(); }
+    bool operator != (const IntrusiveTreeIterator& rhs) const { return raw() != rhs.raw(); }
+private:
+    void rebind(void* raw) { m_wrapper.ClassWrapper::rebind(raw); }
+
+    void* child(void* raw, std::ptrdiff_t offs) const
+    {
+        return internal::followLink(raw, offs, linkOffsT, m_nil);
+    }
+
+    void pushLeft(void* raw)
+    {
+        for (; raw; raw = child(raw, leftOffsT))
+        {
+            if (m_depth == kMaxDepth)
+            {
+                m_depth = 0;
+                return;
+            }
+            m_stack[m_depth++] = raw;
+        }
+    }
+
+    void settle()
+    {
+        if (!m_depth)
+        {
+            rebind(nullptr);
+            return;
+        }
+
+        auto current = m_stack[m_depth - 1];
+        rebind(current);
+        if (auto right = child(current, rightOffsT))
+        {
+            platform::prefetch(static_cast<uint8_t*>(right) + leftOffsT);
+        }
+    }
+private:
+    mutable WrapperT m_wrapper;
+    void* m_nil;
+    std::size_t m_depth;
+    void* m_stack[kMaxDepth];
+};
+
+template<typename WrapperT, std::ptrdiff_t leftOffsT, std::ptrdiff_t rightOffsT,
+    std::ptrdiff_t linkOffsT>
+const std::size_t IntrusiveTreeIterator<WrapperT, leftOffsT, rightOffsT, linkOffsT>::kMaxDepth;
+
+/**
+ * @brief   Range visiting the nodes of an intrusive binary tree in order.
+ * @tparam  WrapperT    Type of the node wrapper.
+ * @tparam  leftOffsT   The offset of the `left` pointer inside a node.
+ * @tparam  rightOffsT  The offset of the `right` pointer inside a node.
+ * @tparam  linkOffsT   The offset inside the child node the child pointers point to.
+ * @see     IntrusiveTreeIterator
+ */
+template<typename WrapperT, std::ptrdiff_t leftOffsT, std::ptrdiff_t rightOffsT,
+    std::ptrdiff_t linkOffsT = 0>
+class IntrusiveTree
+{
+public:
+    using iterator = IntrusiveTreeIterator<WrapperT, leftOffsT, rightOffsT, linkOffsT>;
+
+    /**
+     * @brief   Constructor.
+     * @param   root    The raw pointer of the root node, may be @c nullptr or @c nil.
+     * @param   nil     The link value marking absent children in addition to @c nullptr.
+     */
+    explicit IntrusiveTree(void* root, void* nil = nullptr)
+        : m_root{root}
+        , m_nil{nil}
+    {}
+
+    iterator begin() const { return iterator{m_root, m_nil}; }
+    iterator end() const { return iterator{}; }
+
+    /**
+     * @brief   Determines whether the tree is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !m_root || m_root == m_nil; }
+private:
+    void* m_root;
+    void* m_nil;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_INTRUSIVE_HPP
@@ -0,0 +1,886 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_LAYOUTPROFILE_HPP
+#define REMODEL_LAYOUTPROFILE_HPP
+
+/**     
+ * @file
+ * @brief Contains layout profiles, supplying offsets and RVAs of several target builds at runtime.
+ *        
+ * Every field or function is identified by a dense ID (e.g. an enumerator). A `LayoutProfile`
+ * holds one value per ID for a specific build of the target module, profiles are selected at 
+ * startup by matching the module identity (see `platform::obtainModuleIdentity`). The values of
+ * the selected profile are copied into an immutable snapshot published by a `LayoutTable` that 
+ * fields and functions refer to, so an access is two loads plus an add. Activating another 
+ * profile later swaps the snapshot, existing wrappers pick up the new values right away.
+ * 
+ * @code
+ *      enum : std::size_t { kCatAge, kCatMeow, kIdCount };
+ *      const char* const kNames[] = {"Cat.age", "Cat.meow"};
+ *      
+ *      LayoutTable& catLayout() { static LayoutTable table{kIdCount}; return table; }
+ *      
+ *      class Cat : public ClassWrapper
+ *      {
+ *          REMODEL_WRAPPER(Cat)
+ *      public:
+ *          ProfileField<uint8_t> age{this, ProfileOffsGetter{catLayout(), kCatAge}};
+ *          MemberFunction<void (*)(), ProfileRvaGetter> meow{
+ *              this, ProfileRvaGetter{catLayout(), kCatMeow}};
+ *      };
+ *      
+ *      std::vector<LayoutProfile> profiles;
+ *      loadLayoutProfiles("game.layouts", kNames, kIdCount, profiles);
+ *      if (!catLayout().select(Module::getModule("game.dll").value(), profiles)) 
+ *          return; // unsupported build
+ * @endcode
+ * 
+ * Profile files are plain text, one section per build. Values may be given in any base 
+ * accepted by `strtoll`, lines starting with `#` or `;` are comments.
+ * @code
+ *      [game 1.2.0]
+ *      identity = 5c8e2f1a00a01c00
+ *      Cat.age  = 0x7C
+ *      Cat.meow = 0x1A2B30
+ * @endcode
+ * 
+ * Alternatively, `deriveLayoutProfile` builds a profile for the running build by locating the 
+ * code using each value and decoding the relevant instruction operand.
+ */
+
+#include "Remodel.hpp"
+#include "Hook.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [LayoutProfile]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Offsets and RVAs of one build of a target module, indexed by ID.
+ */
+class LayoutProfile
+{
+public:
+    /**
+     * @brief   The value of IDs not set in the profile.
+     */
+    static const std::ptrdiff_t kUnset = PTRDIFF_MIN;
+
+    /**
+     * @brief   Constructor, creating a profile with all values unset.
+     * @param   name    The name of the profile, e.g. the version of the target.
+     * @param   count   The number of IDs.
+     */
+    LayoutProfile(std::string name, std::size_t count)
+        : m_name{std::move(name)}
+        , m_identity{}
+        , m_values(count, std::ptrdiff_t{kUnset})
+    {}
+
+    /**
+     * @brief   Gets the name of the profile.
+     * @return  The name.
+     */
+    const std::string& name() const { return m_name; }
+
+    /**
+     * @brief   Gets the identity of the module build the profile applies to.
+     * @return  The identity, empty if not set.
+     */
+    const platform::ModuleIdentity& identity() const { return m_identity; }
+
+    /**
+     * @brief   Sets the identity of the module build the profile applies to.
+     * @param   bytes   The identity bytes.
+     * @param   size    The number of bytes, truncated to `ModuleIdentity::kMaxSize`.
+     */
+    void setIdentity(const void* bytes, std::size_t size)
+    {
+        if (size > platform::ModuleIdentity::kMaxSize) size = platform::ModuleIdentity::kMaxSize;
+        std::memcpy(m_identity.bytes, bytes, size);
+        m_identity.size = size;
+    }
+
+    /**
+     * @brief   Sets the identity of the module build the profile applies to.
+     * @param   identity    The identity, as obtained by `platform::obtainModuleIdentity`.
+     */
+    void setIdentity(const platform::ModuleIdentity& identity)
+    {
+        setIdentity(identity.bytes, identity.size);
+    }
+
+    /**
+     * @brief   Determines whether the profile applies to a module build.
+     * @param   identity    The identity of the module.
+     * @return  @c true if the identities are non-empty and equal, else @c false.
+     */
+    bool matches(const platform::ModuleIdentity& identity) const
+    {
+        return m_identity.size && m_identity.size == identity.size
+            && std::memcmp(m_identity.bytes, identity.bytes, identity.size) == 0;
+    }
+
+    /**
+     * @brief   Gets the number of IDs.
+     * @return  The number of IDs.
+     */
+    std::size_t size() const { return m_values.size(); }
+
+    /**
+     * @brief   Gets the value of an ID.
+     * @param   id  The ID.
+     * @return  The value, `kUnset` if not set.
+     */
+    std::ptrdiff_t get(std::size_t id) const { return m_values[id]; }
+
+    /**
+     * @brief   Sets the value of an ID.
+     * @param   id      The ID.
+     * @param   value   The offset or RVA.
+     */
+    void set(std::size_t id, std::ptrdiff_t value) { m_values[id] = value; }
+
+    /**
+     * @brief   Gets the values of the profile.
+     * @return  Pointer to `size()` values.
+     */
+    const std::ptrdiff_t* data() const { return m_values.data(); }
+
+    /**
+     * @brief   Determines whether all IDs are set.
+     * @return  @c true if complete, else @c false.
+     */
+    bool isComplete() const
+    {
+        return std::find(m_values.begin(), m_values.end(), std::ptrdiff_t{kUnset}) 
+            == m_values.end();
+    }
+private:
+    std::string m_name;
+    platform::ModuleIdentity m_identity;
+    std::vector<std::ptrdiff_t> m_values;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [LayoutTable]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Immutable copy of the values of an activated profile, followed by `count` values.
+ */
+struct LayoutSnapshot
+{
+    uintptr_t   moduleBase;
+    bool        active;
+    std::string name;
+    /// The value of `LayoutTable::m_epoch` the snapshot was replaced at, 0 while current.
+    uint64_t    retiredAt;
+
+    const std::ptrdiff_t* values() const 
+    { 
+        return reinterpret_cast<const std::ptrdiff_t*>(this + 1); 
+    }
+
+    static LayoutSnapshot* create(std::size_t count, const std::ptrdiff_t* values, 
+        uintptr_t moduleBase, bool active, std::string name)
+    {
+        auto memory = ::operator new(sizeof(LayoutSnapshot) + count * sizeof(std::ptrdiff_t));
+        auto snapshot = new (memory) LayoutSnapshot{moduleBase, active, std::move(name), 0};
+        std::copy(values, values + count, reinterpret_cast<std::ptrdiff_t*>(snapshot + 1));
+        return snapshot;
+    }
+
+    static void destroy(LayoutSnapshot* snapshot)
+    {
+        snapshot->~LayoutSnapshot();
+        ::operator delete(snapshot);
+    }
+};
+
+/**
+ * @internal
+ * @brief   The epoch a registered reader announced, on its own cache line.
+ */
+struct LayoutReaderRecord
+{
+    /// The epoch the reader entered its read section at, 0 while outside of one.
+    std::atomic<uint64_t> epoch;
+    LayoutReaderRecord*   next;
+    std::atomic<bool>     used;
+    uint8_t               padding[64 - sizeof(std::atomic<uint64_t>) - sizeof(void*) 
+        - sizeof(std::atomic<bool>)];
+};
+
+} // namespace internal
+
+/**
+ * @brief   Table holding the values of the active `LayoutProfile`.
+ *          
+ * The values live in an immutable snapshot published through an atomic pointer. Getters keep 
+ * a pointer to the table, so activating another profile, e.g. after the target updated or to 
+ * correct a wrong offset, takes effect for all existing wrappers. The table can neither be 
+ * copied nor moved and has to outlive all wrappers using it. Until a profile is activated, all 
+ * entries are unset.
+ * 
+ * Reading is wait-free: an access loads the snapshot pointer and the value. Replaced snapshots
+ * are reclaimed based on epochs. Threads reading while another thread may activate a profile
+ * register a `Reader` and access wrappers within a `ReadSection`, snapshots are only freed once 
+ * no section entered before the replacement is left open.
+ * @code
+ *      LayoutTable::Reader reader{catLayout()};    // once per thread
+ *      while (running)
+ *      {
+ *          LayoutTable::ReadSection section{reader};
+ *          tick(cat.age);
+ *      }
+ * @endcode
+ * Unregistered threads may read if no profile is activated concurrently, e.g. when profiles 
+ * are only selected at startup.
+ */
+class LayoutTable : public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   count   The number of IDs.
+     */
+    explicit LayoutTable(std::size_t count)
+        : m_count{count}
+        , m_epoch{1}
+        , m_readers{nullptr}
+    {
+        std::vector<std::ptrdiff_t> unset(count, std::ptrdiff_t{LayoutProfile::kUnset});
+        m_current.store(internal::LayoutSnapshot::create(count, unset.data(), 0, false, {}));
+    }
+
+    /**
+     * @brief   Destructor, freeing all snapshots. No reader may be registered anymore.
+     */
+    ~LayoutTable()
+    {
+        internal::LayoutSnapshot::destroy(m_current.load());
+        for (auto snapshot : m_retired) internal::LayoutSnapshot::destroy(snapshot);
+        for (auto record = m_readers.load(); record;)
+        {
+            auto next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Reader] + [ReadSection]                                                                   //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Registration of a thread reading the table, see the class documentation.
+     */
+    class Reader : public zycore::NonCopyable
+    {
+        friend class LayoutTable;
+
+        const LayoutTable* m_table;
+        internal::LayoutReaderRecord* m_record;
+    public:
+        /**
+         * @brief   Constructor, registering the reader.
+         * @param   table   The table.
+         */
+        explicit Reader(const LayoutTable& table)
+            : m_table{&table}
+            , m_record{table.acquireRecord()}
+        {}
+
+        /**
+         * @brief   Destructor, unregistering the reader.
+         */
+        ~Reader()
+        {
+            m_record->epoch.store(0, std::memory_order_release);
+            m_record->used.store(false, std::memory_order_release);
+        }
+
+        /**
+         * @brief   Enters a read section. Snapshots observed inside are kept until it is left.
+         */
+        void enter()
+        {
+            m_record->epoch.store(
+                m_table->m_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            // Announcing the epoch has to be visible before loading the snapshot pointer.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief   Leaves the read section. Snapshots observed inside may no longer be used.
+         */
+        void leave()
+        {
+            m_record->epoch.store(0, std::memory_order_release);
+        }
+
+        /**
+         * @brief   Leaves and re-enters the read section, for threads staying in one for long.
+         */
+        void quiesce()
+        {
+            leave();
+            enter();
+        }
+    };
+
+    /**
+     * @brief   RAII read section of a `Reader`.
+     */
+    class ReadSection : public zycore::NonCopyable
+    {
+        Reader& m_reader;
+    public:
+        explicit ReadSection(Reader& reader)
+            : m_reader(reader)
+        {
+            m_reader.enter();
+        }
+
+        ~ReadSection()
+        {
+            m_reader.leave();
+        }
+    };
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Activation]                                                                               //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Selects the first complete profile matching the identity of a module.
+     * @param   module      The module the profiles apply to.
+     * @param   profiles    The candidate profiles.
+     * @return  @c true if a profile was selected, else @c false, leaving the table unchanged.
+     */
+    bool select(const Module& module, const std::vector<LayoutProfile>& profiles)
+    {
+        return select(module.addressOfObj(), profiles.data(), profiles.size());
+    }
+
+    /**
+     * @brief   Selects the first complete profile matching the identity of a module.
+     * @param   moduleBase  The base of the module, as returned by `platform::obtainModuleHandle`.
+     * @param   profiles    The candidate profiles.
+     * @param   count       The number of candidate profiles.
+     * @return  @c true if a profile was selected, else @c false, leaving the table unchanged.
+     */
+    bool select(const void* moduleBase, const LayoutProfile* profiles, std::size_t count)
+    {
+        platform::ModuleIdentity identity;
+        if (!platform::obtainModuleIdentity(moduleBase, identity)) return false;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (profiles[i].matches(identity) && activate(profiles[i], moduleBase)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief   Activates a profile without checking the module identity.
+     * @param   profile     The profile, required to be complete and of the table's size.
+     * @param   moduleBase  The base of the module RVAs are relative to.
+     * @return  @c true if activated, else @c false, leaving the table unchanged.
+     *          
+     * Thread-safe. The previous snapshot is retired, and freed as soon as no reader can still
+     * use it (see `reclaim`).
+     */
+    bool activate(const LayoutProfile& profile, const void* moduleBase)
+    {
+        if (profile.size() != m_count || !profile.isComplete()) return false;
+
+        auto snapshot = internal::LayoutSnapshot::create(m_count, profile.data(), 
+            reinterpret_cast<uintptr_t>(moduleBase), true, profile.name());
+
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        auto previous = m_current.exchange(snapshot);
+        previous->retiredAt = m_epoch.fetch_add(1) + 1;
+        m_retired.push_back(previous);
+        reclaimLocked();
+        return true;
+    }
+
+    /**
+     * @brief   Frees retired snapshots no registered reader can still use.
+     * @return  The number of snapshots still retired.
+     */
+    std::size_t reclaim()
+    {
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        reclaimLocked();
+        return m_retired.size();
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Access]                                                                                   //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Determines whether a profile is active.
+     * @return  @c true if active, else @c false.
+     */
+    bool isActive() const { return snapshot()->active; }
+
+    /**
+     * @brief   Gets the name of the active profile.
+     * @return  The name, empty if no profile is active.
+     */
+    std::string activeName() const { return snapshot()->name; }
+
+    /**
+     * @brief   Gets the number of IDs.
+     * @return  The number of IDs.
+     */
+    std::size_t size() const { return m_count; }
+
+    /**
+     * @brief   Gets the base of the module RVAs are relative to.
+     * @return  The module base.
+     */
+    uintptr_t moduleBase() const { return snapshot()->moduleBase; }
+
+    /**
+     * @brief   Gets the value of an ID.
+     * @param   id  The ID.
+     * @return  The value.
+     */
+    std::ptrdiff_t operator [] (std::size_t id) const { return snapshot()->values()[id]; }
+
+    /**
+     * @brief   Resolves the RVA of an ID to an absolute address.
+     * @param   id  The ID.
+     * @return  The absolute address.
+     */
+    uintptr_t address(std::size_t id) const 
+    { 
+        auto current = snapshot();
+        return current->moduleBase + static_cast<uintptr_t>(current->values()[id]); 
+    }
+
+    /**
+     * @brief   Gets the current snapshot.
+     * @return  The snapshot, valid until the read section it was obtained in is left.
+     */
+    const internal::LayoutSnapshot* snapshot() const 
+    { 
+        return m_current.load(std::memory_order_acquire); 
+    }
+private:
+    internal::LayoutReaderRecord* acquireRecord() const
+    {
+        for (auto record = m_readers.load(std::memory_order_acquire); record; 
+            record = record->next)
+        {
+            bool expected = false;
+            if (!record->used.load(std::memory_order_relaxed) 
+                && record->used.compare_exchange_strong(expected, true))
+            {
+                return record;
+            }
+        }
+
+        auto record = new internal::LayoutReaderRecord{};
+        record->used.store(true, std::memory_order_relaxed);
+        record->next = m_readers.load(std::memory_order_relaxed);
+        while (!m_readers.compare_exchange_weak(record->next, record)) {}
+        return record;
+    }
+
+    void reclaimLocked()
+    {
+        // A reader still using a snapshot entered its section before the snapshot was retired.
+        auto oldest = UINT64_MAX;
+        for (auto record = m_readers.load(); record; record = record->next)
+        {
+            auto epoch = record->epoch.load();
+            if (epoch && epoch < oldest) oldest = epoch;
+        }
+
+        auto kept = std::remove_if(m_retired.begin(), m_retired.end(),
+            [&](internal::LayoutSnapshot* snapshot)
+            {
+                if (snapshot->retiredAt > oldest) return false;
+                internal::LayoutSnapshot::destroy(snapshot);
+                return true;
+            });
+        m_retired.erase(kept, m_retired.end());
+    }
+
+    std::size_t m_count;
+    std::atomic<internal::LayoutSnapshot*> m_current;
+    mutable std::atomic<uint64_t> m_epoch;
+    mutable std::atomic<internal::LayoutReaderRecord*> m_readers;
+    std::mutex m_writeMutex;
+    std::vector<internal::LayoutSnapshot*> m_retired;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [ProfileOffsGetter] + [ProfileRvaGetter]                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   `PtrGetter` functor adding the offset of an ID in a `LayoutTable` to the raw address.
+ */
+class ProfileOffsGetter
+{
+    const LayoutTable* m_table;
+    std::size_t m_id;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   table   The table.
+     * @param   id      The ID of the field.
+     */
+    ProfileOffsGetter(const LayoutTable& table, std::size_t id)
+        : m_table{&table}
+        , m_id{id}
+    {}
+
+    void* operator () (void* raw) const
+    {
+        return static_cast<uint8_t*>(raw) + m_table->snapshot()->values()[m_id];
+    }
+};
+
+/**
+ * @brief   `PtrGetter` functor ignoring the raw address, returning the RVA of an ID in a 
+ *          `LayoutTable` relative to the module base of the active profile.
+ */
+class ProfileRvaGetter
+{
+    const LayoutTable* m_table;
+    std::size_t m_id;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   table   The table.
+     * @param   id      The ID of the function or global.
+     */
+    ProfileRvaGetter(const LayoutTable& table, std::size_t id)
+        : m_table{&table}
+        , m_id{id}
+    {}
+
+    void* operator () (void*) const
+    {
+        return reinterpret_cast<void*>(m_table->address(m_id));
+    }
+};
+
+/**
+ * @brief   Field with the offset taken from a `LayoutTable`, see `ProfileOffsGetter`.
+ * @tparam  T   The type of the field represent.
+ */
+template<typename T>
+using ProfileField = Field<T, ProfileOffsGetter>;
+
+// ---------------------------------------------------------------------------------------------- //
+// [loadLayoutProfiles]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Trims whitespace off both ends of a range of characters.
+ */
+inline void trimRange(const char*& begin, const char*& end)
+{
+    while (begin != end && std::strchr(" \t\r", *begin)) ++begin;
+    while (end != begin && std::strchr(" \t\r", end[-1])) --end;
+}
+
+/**
+ * @internal
+ * @brief   Parses a hexadecimal identity.
+ * @return  @c true on success, else @c false.
+ */
+inline bool parseIdentity(const char* begin, const char* end, platform::ModuleIdentity& identity)
+{
+    auto digits = static_cast<std::size_t>(end - begin);
+    if (!digits || digits % 2 || digits / 2 > platform::ModuleIdentity::kMaxSize) return false;
+
+    auto nibble = [](char c)
+    {
+        return c >= '0' && c <= '9' ? c - '0'
+            :  c >= 'a' && c <= 'f' ? c - 'a' + 10
+            :  c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+    };
+    for (std::size_t i = 0; i < digits / 2; ++i)
+    {
+        int hi = nibble(begin[2 * i]), lo = nibble(begin[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        identity.bytes[i] = static_cast<uint8_t>(hi << 4 | lo);
+    }
+    identity.size = digits / 2;
+    return true;
+}
+
+} // namespace internal
+
+/**
+ * @brief   Parses layout profiles from text.
+ * @param   text        The text, see the file documentation for the format.
+ * @param   size        The length of the text.
+ * @param   names       The names of the IDs, indexed by ID.
+ * @param   count       The number of IDs.
+ * @param   profiles    Receives the parsed profiles, appended.
+ * @return  @c true on success, @c false on malformed text or unknown names, leaving `profiles`
+ *          unchanged.
+ */
+inline bool parseLayoutProfiles(const char* text, std::size_t size, const char* const* names,
+    std::size_t count, std::vector<LayoutProfile>& profiles)
+{
+    std::vector<LayoutProfile> parsed;
+    const char* end = text + size;
+    for (const char* line = text; line < end;)
+    {
+        auto lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!lineEnd) lineEnd = end;
+        auto begin = line, last = lineEnd;
+        line = lineEnd + 1;
+
+        internal::trimRange(begin, last);
+        if (begin == last || *begin == '#' || *begin == ';') continue;
+
+        if (*begin == '[')
+        {
+            if (last[-1] != ']' || last - begin < 3) return false;
+            parsed.emplace_back(std::string{begin + 1, last - 1}, count);
+            continue;
+        }
+
+        auto eq = static_cast<const char*>(std::memchr(begin, '=', last - begin));
+        if (!eq || parsed.empty()) return false;
+        auto keyBegin = begin, keyEnd = eq, valueBegin = eq + 1, valueEnd = last;
+        internal::trimRange(keyBegin, keyEnd);
+        internal::trimRange(valueBegin, valueEnd);
+        std::string key{keyBegin, keyEnd}, value{valueBegin, valueEnd};
+
+        if (key == "identity")
+        {
+            platform::ModuleIdentity identity;
+            if (!internal::parseIdentity(valueBegin, valueEnd, identity)) return false;
+            parsed.back().setIdentity(identity);
+            continue;
+        }
+
+        std::size_t id = 0;
+        while (id < count && key != names[id]) ++id;
+        if (id == count || value.empty()) return false;
+
+        char* parsedEnd;
+        auto number = std::strtoll(value.c_str(), &parsedEnd, 0);
+        if (*parsedEnd) return false;
+        parsed.back().set(id, static_cast<std::ptrdiff_t>(number));
+    }
+
+    profiles.insert(profiles.end(), parsed.begin(), parsed.end());
+    return true;
+}
+
+/**
+ * @brief   Loads layout profiles from a file.
+ * @param   path        The path of the file, see the file documentation for the format.
+ * @param   names       The names of the IDs, indexed by ID.
+ * @param   count       The number of IDs.
+ * @param   profiles    Receives the loaded profiles, appended.
+ * @return  @c true on success, @c false if the file can't be read, is malformed or contains 
+ *          unknown names, leaving `profiles` unchanged.
+ */
+inline bool loadLayoutProfiles(const char* path, const char* const* names, std::size_t count, 
+    std::vector<LayoutProfile>& profiles)
+{
+    auto file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    std::string text;
+    char buffer[4096];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) != 0) text.append(buffer, read);
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+
+    return ok && parseLayoutProfiles(text.data(), text.size(), names, count, profiles);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [deriveLayoutProfile]                                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The operand of an x86 instruction a layout value is taken from.
+ */
+enum class OperandKind
+{
+    /// The displacement of the memory operand, e.g. `0x7C` of `mov eax, [rcx+0x7C]`.
+    Displacement,
+    /// The immediate, e.g. `0x10` of `add rcx, 0x10`.
+    Immediate,
+    /// The address a RIP-relative memory operand or a relative branch refers to, as RVA.
+    TargetRva,
+};
+
+/**
+ * @brief   Extracts an operand value from an x86 instruction (x86-64 on 64-bit builds).
+ * @param   insn        The instruction.
+ * @param   kind        The operand to extract.
+ * @param   moduleBase  The base RVAs are relative to, used for `OperandKind::TargetRva`.
+ * @return  The sign-extended value, empty if the instruction can't be decoded or has no such 
+ *          operand.
+ */
+inline zycore::Optional<std::ptrdiff_t> extractOperand(const void* insn, OperandKind kind, 
+    const void* moduleBase = nullptr)
+{
+    auto code = static_cast<const uint8_t*>(insn);
+    internal::X86Instruction decoded;
+    if (!internal::decodeX86(code, sizeof(void*) == 8, decoded)) return zycore::kEmpty;
+
+    auto read = [&](int8_t offset, uint8_t size) -> std::ptrdiff_t
+    {
+        switch (size)
+        {
+            case 1: { int8_t  v; std::memcpy(&v, code + offset, sizeof(v)); return v; }
+            case 2: { int16_t v; std::memcpy(&v, code + offset, sizeof(v)); return v; }
+            case 4: { int32_t v; std::memcpy(&v, code + offset, sizeof(v)); return v; }
+            default:
+            {
+                int64_t v; 
+                std::memcpy(&v, code + offset, sizeof(v)); 
+                return static_cast<std::ptrdiff_t>(v);
+            }
+        }
+    };
+
+    switch (kind)
+    {
+        case OperandKind::Displacement:
+            if (decoded.dispOffset < 0) return zycore::kEmpty;
+            return {zycore::kInPlace, read(decoded.dispOffset, decoded.dispSize)};
+        case OperandKind::Immediate:
+            if (decoded.immOffset < 0) return zycore::kEmpty;
+            return {zycore::kInPlace, read(decoded.immOffset, decoded.immSize)};
+        case OperandKind::TargetRva:
+        {
+            std::ptrdiff_t rel;
+            if (decoded.ripDispOffset >= 0)  rel = read(decoded.ripDispOffset, 4);
+            else if (decoded.relOffset >= 0) rel = read(decoded.relOffset, decoded.relSize);
+            else return zycore::kEmpty;
+            auto next = reinterpret_cast<uintptr_t>(code) + decoded.length;
+            return {zycore::kInPlace, static_cast<std::ptrdiff_t>(
+                next + static_cast<uintptr_t>(rel) - reinterpret_cast<uintptr_t>(moduleBase))};
+        }
+    }
+    return zycore::kEmpty;
+}
+
+/**
+ * @brief   Describes how to derive a layout value from the code accessing it.
+ */
+struct LayoutSignature
+{
+    /// The ID the value is stored for.
+    std::size_t    id;
+    /// IDA-style pattern locating code using the value.
+    const char*    pattern;
+    /// The offset of the instruction from the start of the match.
+    std::ptrdiff_t insnOffset;
+    /// The operand of the instruction holding the value.
+    OperandKind    operand;
+};
+
+/**
+ * @brief   Derives a layout profile from the code of the running target.
+ * @param   module      The module to scan.
+ * @param   signatures  The signatures.
+ * @param   count       The number of signatures.
+ * @param   profile     Receives the values found and the identity of the module. Values of IDs
+ *                      whose signature wasn't found or couldn't be decoded are left unchanged.
+ * @param   threadCount The maximum number of threads to scan with (see `PatternBatch::scan`).
+ * @return  The number of values derived.
+ *          
+ * Field offsets and RVAs shift between builds while the code accessing them stays the same. 
+ * All patterns are resolved in a single pass over the module, then the instructions are 
+ * decoded, e.g. `{kCatAge, "0F B6 41 ?? C3", 0, OperandKind::Displacement}` yields the offset 
+ * of `movzx eax, byte ptr [rcx+0x7C]`. The profile can be activated in a `LayoutTable` 
+ * afterwards, or saved to skip the scan for this build in the future.
+ */
+inline std::size_t deriveLayoutProfile(const Module& module, const LayoutSignature* signatures,
+    std::size_t count, LayoutProfile& profile, unsigned threadCount = 1)
+{
+    PatternBatch batch;
+    for (std::size_t i = 0; i < count; ++i) batch.add(signatures[i].pattern);
+    module.findPatterns(batch, threadCount);
+
+    std::size_t derived = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& signature = signatures[i];
+        if (!batch.isResolved(i) || signature.id >= profile.size()) continue;
+
+        auto value = extractOperand(
+            reinterpret_cast<const void*>(batch.address(i) + signature.insnOffset), 
+            signature.operand, module.addressOfObj());
+        if (!value) continue;
+        profile.set(signature.id, value.value());
+        ++derived;
+    }
+
+    platform::ModuleIdentity identity;
+    if (platform::obtainModuleIdentity(module.addressOfObj(), identity)) 
+        profile.setIdentity(identity);
+    return derived;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_LAYOUTPROFILE_HPP
@@ -0,0 +1,414 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_LIFETIMETRACKER_HPP
+#define REMODEL_LIFETIMETRACKER_HPP
+
+/**     
+ * @file
+ * @brief Contains tracking of object lifetimes through hooked destructors.
+ *        
+ * Caches keyed by object addresses (identity maps, indexes, resolved vftable targets) go stale 
+ * once the target frees an object. A `LifetimeTracker` hooks the destructor of a type and 
+ * publishes the address of every destroyed object to a lock-free queue. A consumer thread 
+ * dispatches the invalidations to the registered caches in batches, so the caches don't need
+ * to revalidate entries on access.
+ *
+ * @code
+ *      MemberFunction<void (*)()> destroy{...};
+ *      LifetimeTracker<decltype(destroy.get())> horseLifetimes{destroy};
+ *      horseLifetimes.attach(horseMap);                    // a WrapperIdentityMap
+ *      horseLifetimes.subscribe([](const void* horse) { stableIndex.remove(horse); });
+ *      horseLifetimes.install();
+ *      // ... once per frame, on the consumer thread:
+ *      horseLifetimes.dispatch();
+ *      horseMap.advanceEpoch();
+ * @endcode
+ * 
+ * Objects destroyed by the wrapper's own `destruct()` routine (e.g. of `Instantiable` wrappers) 
+ * can be reported using `publish` instead. The detour is a static function, so only one tracker 
+ * per destructor type can be installed at a time. Distinguish destructors sharing a signature 
+ * by the tag type.
+ */
+
+#include "Hook.hpp"
+#include "IdentityMap.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [InvalidationQueue]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Bounded lock-free queue of object addresses pushed by any thread, drained by one.
+ * 
+ * Uses the sequence number protocol of `TaskQueue`. Addresses pushed while the queue is full 
+ * are lost, which is recorded, so the consumer can invalidate everything instead.
+ */
+class InvalidationQueue : public zycore::NonCopyable
+{
+    struct Slot
+    {
+        std::atomic<std::size_t> seq;
+        const void* object;
+    };
+public:
+    /**
+     * @brief   Constructor.
+     * @param   capacity    The maximum number of pending addresses, a power of two of at 
+     *                      least 2.
+     */
+    explicit InvalidationQueue(std::size_t capacity = 4096)
+        : m_mask{capacity - 1}
+        , m_slots{new Slot[capacity]}
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief   Pushes an address, callable from any thread.
+     * @param   object  The address.
+     * @return  @c true if pushed, else @c false if the queue is full and the address was lost.
+     */
+    bool push(const void* object)
+    {
+        auto pos = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& slot = m_slots[pos & m_mask];
+            auto  seq  = slot.seq.load(std::memory_order_acquire);
+            auto  diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.object = object;
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                m_lost.store(true, std::memory_order_release);
+                m_lostCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief   Removes pending addresses, called by the consuming thread only.
+     * @param   func        Invoked as `(const void*)` for every address, in order.
+     * @param   maxCount    The maximum number of addresses to remove.
+     * @return  The number of addresses removed.
+     */
+    template<typename FuncT>
+    std::size_t drain(FuncT&& func, std::size_t maxCount = SIZE_MAX)
+    {
+        std::size_t count = 0;
+        for (; count < maxCount; ++count)
+        {
+            auto& slot = m_slots[m_head & m_mask];
+            if (slot.seq.load(std::memory_order_acquire) != m_head + 1) break;
+            func(slot.object);
+            slot.seq.store(m_head + m_mask + 1, std::memory_order_release);
+            ++m_head;
+        }
+        return count;
+    }
+
+    /**
+     * @brief   Determines whether addresses were lost since the last call, resetting the flag.
+     */
+    bool takeLost() { return m_lost.exchange(false, std::memory_order_acq_rel); }
+
+    /**
+     * @brief   Gets the total number of addresses lost because the queue was full.
+     */
+    uint64_t lost() const { return m_lostCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the maximum number of pending addresses.
+     */
+    std::size_t capacity() const { return m_mask + 1; }
+private:
+    const std::size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<bool> m_lost{false};
+    std::atomic<uint64_t> m_lostCount{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::size_t m_head = 0;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [LifetimeTracker]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Implementation of `LifetimeTracker` independent of the calling convention.
+ */
+template<typename FunctionPtrT>
+class LifetimeTrackerBase
+{
+public:
+    /**
+     * @brief   Invoked with the address of a destroyed object.
+     */
+    using DestroyedHandler = std::function<void (const void*)>;
+    /**
+     * @brief   Invoked when invalidations were lost, every entry has to be considered stale.
+     */
+    using LostHandler = std::function<void ()>;
+
+    LifetimeTrackerBase(const LifetimeTrackerBase&) = delete;
+    LifetimeTrackerBase& operator = (const LifetimeTrackerBase&) = delete;
+
+    /**
+     * @brief   Determines whether the hook is installed.
+     */
+    bool isInstalled() const { return m_hook.isInstalled(); }
+
+    /**
+     * @brief   Registers a cache, called by the consuming thread only.
+     * @param   onDestroyed Invoked for every destroyed object.
+     * @param   onLost      Invoked when invalidations were lost because the queue was full.
+     *                      If empty, lost invalidations aren't reported to this cache.
+     * @return  The ID of the registration, to be passed to `unsubscribe`.
+     */
+    std::size_t subscribe(DestroyedHandler onDestroyed, LostHandler onLost = {})
+    {
+        m_listeners.push_back({++m_nextId, std::move(onDestroyed), std::move(onLost)});
+        return m_nextId;
+    }
+
+    /**
+     * @brief   Registers an identity map, erasing the wrappers of destroyed objects.
+     * @param   map The map, required to outlive the registration.
+     * @return  The ID of the registration, to be passed to `unsubscribe`.
+     */
+    template<typename WrapperT>
+    std::size_t attach(WrapperIdentityMap<WrapperT>& map)
+    {
+        return subscribe(
+            [&map](const void* object) { map.erase(object); }, 
+            [&map] { map.eraseAll(); });
+    }
+
+    /**
+     * @brief   Unregisters a cache, called by the consuming thread only.
+     * @param   id  The ID returned by `subscribe` or `attach`.
+     * @return  @c true if unregistered, else @c false if unknown.
+     */
+    bool unsubscribe(std::size_t id)
+    {
+        for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
+        {
+            if (it->id != id) continue;
+            m_listeners.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief   Reports the destruction of an object not passing through the hooked destructor.
+     * @param   object  The object.
+     * @return  @c true if queued, else @c false if the queue is full.
+     */
+    bool publish(const void* object) { return m_queue.push(object); }
+
+    /**
+     * @brief   Dispatches pending invalidations to the caches, called by the consumer only.
+     * @param   maxCount    The maximum number of invalidations to dispatch.
+     * @return  The number of invalidations dispatched.
+     */
+    std::size_t dispatch(std::size_t maxCount = SIZE_MAX)
+    {
+        // Caches are wiped first, the addresses still queued are stale either way.
+        if (m_queue.takeLost())
+        {
+            for (auto& listener : m_listeners) if (listener.onLost) listener.onLost();
+        }
+
+        return m_queue.drain([&](const void* object)
+        {
+            for (auto& listener : m_listeners) listener.onDestroyed(object);
+        }, maxCount);
+    }
+
+    /**
+     * @brief   Gets the total number of invalidations lost because the queue was full.
+     */
+    uint64_t lost() const { return m_queue.lost(); }
+protected:
+    LifetimeTrackerBase(void* target, FunctionPtrT detour, std::size_t capacity)
+        : m_hook{target, detour}
+        , m_queue{capacity}
+    {}
+
+    ~LifetimeTrackerBase() = default;
+
+    Hook<FunctionPtrT> m_hook;
+private:
+    struct Listener
+    {
+        std::size_t id;
+        DestroyedHandler onDestroyed;
+        LostHandler onLost;
+    };
+
+    InvalidationQueue m_queue;
+    std::vector<Listener> m_listeners;
+    std::size_t m_nextId = 0;
+};
+
+} // namespace internal
+
+/**
+ * @brief   Hooks a destructor, publishing the addresses of destroyed objects to caches.
+ * @tparam  FunctionPtrT    The function pointer type of the destructor, taking the object first, 
+ *                          as returned by `MemberFunction::get`. Further arguments (e.g. the 
+ *                          flags of MSVC's deleting destructors) are passed through.
+ * @tparam  TagT            Distinguishes trackers of destructors with the same signature.
+ *                          
+ * The destructor may run on any number of threads, a single consumer dispatches. The address 
+ * is published before the original destructor runs. Only one tracker per instantiation can be 
+ * installed at a time. Uninstall the tracker before destroying it, and not while the 
+ * destructor is executing.
+ */
+template<typename FunctionPtrT, typename TagT = void>
+class LifetimeTracker
+{
+    static_assert(internal::BlackBoxConsts<FunctionPtrT>::kFalse,
+        "lifetime trackers expect a member function pointer type taking the object first");
+};
+
+/**
+ * @internal
+ * @brief   A macro that defines a lifetime tracker for a calling convention.
+ * @param   callingConv The calling convention.
+ */
+#define REMODEL_DEF_LIFETIME_TRACKER(callingConv)                                                  \
+    template<typename RetT, typename... ArgsT, typename TagT>                                      \
+    class LifetimeTracker<RetT (callingConv*)(void*, ArgsT...), TagT>                              \
+        : public internal::LifetimeTrackerBase<RetT (callingConv*)(void*, ArgsT...)>               \
+    {                                                                                              \
+        using FunctionPtr = RetT (callingConv*)(void*, ArgsT...);                                  \
+        using Base = internal::LifetimeTrackerBase<FunctionPtr>;                                   \
+    public:                                                                                        \
+        /* Hooks a destructor at an address. */                                                    \
+        explicit LifetimeTracker(void* target, std::size_t capacity = 4096)                        \
+            : Base{target, &detour, capacity}                                                      \
+        {}                                                                                         \
+                                                                                                   \
+        /* Hooks a destructor. */                                                                  \
+        explicit LifetimeTracker(FunctionPtr target, std::size_t capacity = 4096)                  \
+            : LifetimeTracker{*reinterpret_cast<void**>(&target), capacity}                        \
+        {}                                                                                         \
+                                                                                                   \
+        /* Hooks the destructor a wrapper resolves to. */                                          \
+        template<typename T, typename PtrGetterT>                                                  \
+        explicit LifetimeTracker(const MemberFunction<T, PtrGetterT>& destructor,                  \
+            std::size_t capacity = 4096)                                                           \
+            : LifetimeTracker{destructor.get(), capacity}                                          \
+        {}                                                                                         \
+                                                                                                   \
+        ~LifetimeTracker() { uninstall(); }                                                        \
+                                                                                                   \
+        /* Installs the hook, @c false if failed or another tracker is installed. */               \
+        bool install()                                                                             \
+        {                                                                                          \
+            LifetimeTracker* expected = nullptr;                                                   \
+            if (!active().compare_exchange_strong(expected, this)) return expected == this;        \
+            if (this->m_hook.install()) return true;                                               \
+            active().store(nullptr);                                                               \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        /* Uninstalls the hook. */                                                                 \
+        bool uninstall()                                                                           \
+        {                                                                                          \
+            if (active().load() != this) return true;                                              \
+            if (!this->m_hook.uninstall()) return false;                                           \
+            active().store(nullptr);                                                               \
+            return true;                                                                           \
+        }                                                                                          \
+    private:                                                                                       \
+        static std::atomic<LifetimeTracker*>& active()                                             \
+        {                                                                                          \
+            static std::atomic<LifetimeTracker*> tracker{nullptr};                                 \
+            return tracker;                                                                        \
+        }                                                                                          \
+                                                                                                   \
+        static RetT callingConv detour(void* object, ArgsT... args)                                \
+        {                                                                                          \
+            auto self = active().load(std::memory_order_acquire);                                  \
+            self->publish(object);                                                                 \
+            return self->m_hook.original()(object, std::forward<ArgsT>(args)...);                  \
+        }                                                                                          \
+    }
+
+#if defined(ZYCORE_MSVC) && defined(_M_X64)
+    REMODEL_DEF_LIFETIME_TRACKER(__cdecl);
+#elif defined(ZYCORE_MSVC) && defined(_M_IX86)
+    REMODEL_DEF_LIFETIME_TRACKER(__cdecl);
+    REMODEL_DEF_LIFETIME_TRACKER(__stdcall);
+    REMODEL_DEF_LIFETIME_TRACKER(__thiscall);
+#elif defined(ZYCORE_GNUC) && defined(__x86_64__)
+    // The native ABI is the plain function type, only the foreign one is distinct.
+    REMODEL_DEF_LIFETIME_TRACKER();
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        REMODEL_DEF_LIFETIME_TRACKER(__attribute__((sysv_abi)));
+#   else
+        REMODEL_DEF_LIFETIME_TRACKER(__attribute__((ms_abi)));
+#   endif
+#elif defined(ZYCORE_GNUC) && defined(__i386__)
+    REMODEL_DEF_LIFETIME_TRACKER(__attribute__((cdecl)));
+    REMODEL_DEF_LIFETIME_TRACKER(__attribute__((stdcall)));
+    REMODEL_DEF_LIFETIME_TRACKER(__attribute__((thiscall)));
+#endif
+
+#undef REMODEL_DEF_LIFETIME_TRACKER
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_LIFETIMETRACKER_HPP
@@ -0,0 +1,698 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_MARSHAL_HPP
+#define REMODEL_MARSHAL_HPP
+
+/**     
+ * @file
+ * @brief Contains marshalling of calls to a single thread, e.g. the main thread of the target.
+ *        
+ * Many target functions are only safe to call on the thread owning the data they modify. A 
+ * `TaskQueue` is a bounded lock-free multi-producer single-consumer queue of callables which 
+ * that thread drains in batches from a hook point, e.g. a detour of the per-frame update. 
+ * Callables are stored inside the queue slots, so posting takes neither locks nor allocations 
+ * unless a callable exceeds `TaskQueue::kInlineSize` bytes.
+ * 
+ * Threads awaiting results use `AsyncCall`s instead, which are continued through a 
+ * `ResumeQueue` drained by the awaiting thread, e.g. by `co_await`ing them from coroutines 
+ * returning `AsyncTask` when compiling as C++20.
+ *
+ * @code
+ *      TaskQueue mainThread;
+ *      int updateDetour(void* game) 
+ *      { 
+ *          mainThread.drain(); 
+ *          return updateHook->original()(game); 
+ *      }
+ *      
+ *      // Any other thread.
+ *      mainThread.postCall(stable, &Stable::addHorse, horseId);
+ *      mainThread.post([=] { log(horseId); });
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <exception>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#   include <coroutine>
+#   define REMODEL_HAS_COROUTINES
+#endif
+
+namespace remodel
+{
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [TaskSlot]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   A slot of a `TaskQueue`, one cache line holding a type-erased callable.
+ */
+struct alignas(64) TaskSlot
+{
+    static const std::size_t kStorageSize = 48;
+
+    /// Runs (if requested) and destroys the callable in `storage`.
+    using Ops = void (*)(void* storage, bool run);
+
+    /// Position of the slot in the queue, see `TaskQueue`.
+    std::atomic<std::size_t> seq;
+    Ops ops;
+    alignas(8) uint8_t storage[kStorageSize];
+
+    template<typename FuncT>
+    static void inlineOps(void* storage, bool run)
+    {
+        auto& func = *static_cast<FuncT*>(storage);
+        if (run) func();
+        func.~FuncT();
+    }
+
+    template<typename FuncT>
+    static void heapOps(void* storage, bool run)
+    {
+        std::unique_ptr<FuncT> func{*static_cast<FuncT**>(storage)};
+        if (run) (*func)();
+    }
+
+    template<typename FuncT>
+    using FitsInline = std::integral_constant<bool, sizeof(FuncT) <= kStorageSize 
+        && alignof(FuncT) <= 8>;
+
+    template<typename FuncT>
+    std::enable_if_t<FitsInline<std::decay_t<FuncT>>::value> emplace(FuncT&& func)
+    {
+        using Func = std::decay_t<FuncT>;
+        new (storage) Func(std::forward<FuncT>(func));
+        ops = &inlineOps<Func>;
+    }
+
+    template<typename FuncT>
+    std::enable_if_t<!FitsInline<std::decay_t<FuncT>>::value> emplace(FuncT&& func)
+    {
+        using Func = std::decay_t<FuncT>;
+        *reinterpret_cast<Func**>(storage) = new Func(std::forward<FuncT>(func));
+        ops = &heapOps<Func>;
+    }
+};
+
+static_assert(sizeof(TaskSlot) == 64, "unexpected padding");
+
+/**
+ * @internal
+ * @brief   A marshalled call of a function pointer, resolved when posting.
+ *          
+ * Member functions are bound by passing the object pointer as first argument.
+ */
+template<typename FuncPtrT, typename... ArgsT>
+class BoundCall
+{
+public:
+    explicit BoundCall(FuncPtrT func, ArgsT... args)
+        : m_func{func}
+        , m_args{std::move(args)...}
+    {}
+
+    decltype(auto) operator () () { return invoke(std::index_sequence_for<ArgsT...>{}); }
+private:
+    template<std::size_t... idxs>
+    decltype(auto) invoke(std::index_sequence<idxs...>) 
+    { 
+        return m_func(std::move(std::get<idxs>(m_args))...); 
+    }
+private:
+    FuncPtrT m_func;
+    std::tuple<ArgsT...> m_args;
+};
+
+/**
+ * @internal
+ * @brief   Binds a call of a `MemberFunction` (or `VirtualFunction`) of a wrapped object.
+ */
+template<typename WrapperT, typename FuncT, typename... ArgsT>
+inline auto bindMemberCall(const WrapperT& wrapper, FuncT WrapperT::* member, ArgsT&&... args)
+{
+    auto func = (wrapper.*member).get();
+    return BoundCall<decltype(func), void*, std::decay_t<ArgsT>...>{
+        func, const_cast<void*>(wrapper.addressOfObj()), std::forward<ArgsT>(args)...};
+}
+
+/**
+ * @internal
+ * @brief   Binds a call of a `Function`.
+ */
+template<typename FuncT, typename... ArgsT>
+inline auto bindCall(const FuncT& func, ArgsT&&... args)
+{
+    return BoundCall<decltype(func.get()), std::decay_t<ArgsT>...>{
+        func.get(), std::forward<ArgsT>(args)...};
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [TaskQueue]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Bounded lock-free queue of tasks posted by any thread and run by a single thread.
+ *          
+ * Every slot carries a sequence number telling producers and the consumer whether it is free 
+ * for position `n` (`seq == n`) or holds the task of position `n` (`seq == n + 1`). Producers 
+ * claim positions using a CAS on the shared tail, the consumer owns the head exclusively.
+ */
+class TaskQueue : public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   The maximum size of callables stored without allocation, in bytes.
+     */
+    static const std::size_t kInlineSize = internal::TaskSlot::kStorageSize;
+
+    /**
+     * @brief   Constructor.
+     * @param   capacity    The maximum number of pending tasks, rounded up to a power of two of
+     *                      at least 2.
+     */
+    explicit TaskQueue(std::size_t capacity = 1024)
+        : m_mask{roundCapacity(capacity) - 1}
+        , m_slots{static_cast<internal::TaskSlot*>(internal::allocateAligned(
+            (m_mask + 1) * sizeof(internal::TaskSlot), alignof(internal::TaskSlot)))}
+    {
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            new (&m_slots[i]) internal::TaskSlot;
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief   Destructor, destroying pending tasks without running them.
+     */
+    ~TaskQueue()
+    {
+        for (;;)
+        {
+            auto& slot = m_slots[m_head & m_mask];
+            if (slot.seq.load(std::memory_order_acquire) != m_head + 1) break;
+            slot.ops(slot.storage, false);
+            ++m_head;
+        }
+        internal::freeAligned(m_slots, alignof(internal::TaskSlot));
+    }
+
+    /**
+     * @brief   Posts a task, callable from any thread.
+     * @param   func    The callable, invoked without arguments.
+     * @return  @c true if posted, else @c false if the queue is full.
+     */
+    template<typename FuncT>
+    bool post(FuncT&& func)
+    {
+        auto pos = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& slot = m_slots[pos & m_mask];
+            auto  seq  = slot.seq.load(std::memory_order_acquire);
+            auto  diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.emplace(std::forward<FuncT>(func));
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            // The consumer didn't free the slot of the previous lap yet.
+            else if (diff < 0) return false;
+            else pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief   Posts a call of a `MemberFunction` (or `VirtualFunction`) of a wrapped object.
+     * @param   wrapper The wrapper of the object.
+     * @param   member  Pointer to the function member, e.g. `&Stable::addHorse`.
+     * @param   args    The arguments, stored by value.
+     * @return  @c true if posted, else @c false if the queue is full.
+     * @note    The function is resolved immediately, the object is required to stay alive until 
+     *          the call ran. The wrapper itself isn't accessed anymore.
+     */
+    template<typename WrapperT, typename FuncT, typename... ArgsT>
+    bool postCall(const WrapperT& wrapper, FuncT WrapperT::* member, ArgsT&&... args)
+    {
+        return post(internal::bindMemberCall(wrapper, member, std::forward<ArgsT>(args)...));
+    }
+
+    /**
+     * @brief   Runs pending tasks, called by the consuming thread only.
+     * @param   maxTasks    The maximum number of tasks to run, bounding the time spent.
+     * @return  The number of tasks run.
+     *          
+     * Tasks posted while draining are run by the same call if within `maxTasks`.
+     */
+    std::size_t drain(std::size_t maxTasks = SIZE_MAX)
+    {
+        std::size_t count = 0;
+        for (; count < maxTasks; ++count)
+        {
+            auto& slot = m_slots[m_head & m_mask];
+            if (slot.seq.load(std::memory_order_acquire) != m_head + 1) break;
+            slot.ops(slot.storage, true);
+            slot.seq.store(m_head + m_mask + 1, std::memory_order_release);
+            ++m_head;
+        }
+        return count;
+    }
+
+    /**
+     * @brief   Gets the maximum number of pending tasks.
+     */
+    std::size_t capacity() const { return m_mask + 1; }
+private:
+    static_assert(std::is_trivially_destructible<internal::TaskSlot>::value, 
+        "slots are released without destruction");
+
+    static std::size_t roundCapacity(std::size_t capacity)
+    {
+        std::size_t rounded = 2;
+        while (rounded < capacity) rounded *= 2;
+        return rounded;
+    }
+
+    const std::size_t m_mask;
+    internal::TaskSlot* m_slots;
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::size_t m_head = 0;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FramePool]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Allocator for small, short-lived blocks such as coroutine frames.
+ *          
+ * Freed blocks are cached per thread in power of two size classes and handed out again by the 
+ * same thread, so the steady state takes neither locks nor calls into the heap. Blocks freed 
+ * by another thread than the allocating one simply migrate to that thread's cache.
+ */
+class FramePool
+{
+public:
+    static const std::size_t kMinBlockSize  = 64;
+    static const std::size_t kNumClasses    = 7;
+    static const std::size_t kMaxCached     = 64;
+
+    /**
+     * @brief   Allocates a block.
+     * @param   size    The size, in bytes.
+     * @return  The block, aligned like `::operator new`.
+     */
+    static void* allocate(std::size_t size)
+    {
+        auto cls = sizeClass(size);
+        if (cls == kNumClasses) return ::operator new(size);
+
+        auto& cache = threadCache();
+        if (auto block = cache.heads[cls])
+        {
+            cache.heads[cls] = block->next;
+            --cache.counts[cls];
+            return block;
+        }
+        return ::operator new(kMinBlockSize << cls);
+    }
+
+    /**
+     * @brief   Frees a block.
+     * @param   block   The block.
+     * @param   size    The size passed to `allocate`.
+     */
+    static void deallocate(void* block, std::size_t size)
+    {
+        auto cls = sizeClass(size);
+        auto& cache = threadCache();
+        if (cls == kNumClasses || cache.counts[cls] == kMaxCached)
+        {
+            ::operator delete(block);
+            return;
+        }
+        cache.heads[cls] = new (block) FreeBlock{cache.heads[cls]};
+        ++cache.counts[cls];
+    }
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Cache
+    {
+        FreeBlock* heads[kNumClasses] = {};
+        std::size_t counts[kNumClasses] = {};
+
+        ~Cache()
+        {
+            for (auto head : heads)
+            {
+                while (head)
+                {
+                    auto next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static std::size_t sizeClass(std::size_t size)
+    {
+        std::size_t cls = 0;
+        while (cls < kNumClasses && (kMinBlockSize << cls) < size) ++cls;
+        return cls;
+    }
+
+    static Cache& threadCache()
+    {
+        static thread_local Cache cache;
+        return cache;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [ResumeQueue]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Intrusive node of a `ResumeQueue`.
+ */
+struct ResumeNode
+{
+    std::atomic<ResumeNode*> next{nullptr};
+    void (*resume)(ResumeNode* node) = nullptr;
+};
+
+} // namespace internal
+
+/**
+ * @brief   Unbounded lock-free queue of continuations, run by the thread draining it.
+ *          
+ * The target thread of an `AsyncCall` hands the continuation back through this queue, which 
+ * never fails as the nodes are embedded into the calls themselves. The queue follows Vyukov's 
+ * intrusive MPSC design: producers only exchange the head, the consumer owns the tail.
+ */
+class ResumeQueue : public zycore::NonCopyable
+{
+public:
+    ResumeQueue()
+        : m_head{&m_stub}
+        , m_tail{&m_stub}
+    {}
+
+    /**
+     * @brief   Pushes a node, callable from any thread.
+     */
+    void push(internal::ResumeNode* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Runs pending continuations, called by the consuming thread only.
+     * @param   maxNodes    The maximum number of continuations to run.
+     * @return  The number of continuations run.
+     * @note    A push still in progress ends the batch, it's picked up by the next call.
+     */
+    std::size_t drain(std::size_t maxNodes = SIZE_MAX)
+    {
+        std::size_t count = 0;
+        while (count < maxNodes)
+        {
+            auto node = pop();
+            if (!node) break;
+            node->resume(node);
+            ++count;
+        }
+        return count;
+    }
+private:
+    internal::ResumeNode* pop()
+    {
+        auto tail = m_tail;
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub)
+        {
+            if (!next) return nullptr;
+            m_tail = tail = next;
+            next = tail->next.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+
+        // `tail` is the last node: requeue the stub behind it, unless a push is in progress.
+        if (tail != m_head.load(std::memory_order_acquire)) return nullptr;
+        push(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (!next) return nullptr;
+        m_tail = next;
+        return tail;
+    }
+private:
+    internal::ResumeNode m_stub;
+    alignas(64) std::atomic<internal::ResumeNode*> m_head;
+    alignas(64) internal::ResumeNode* m_tail;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [AsyncCall]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A call marshalled to the thread draining a `TaskQueue`, continued on the thread 
+ *          draining a `ResumeQueue`.
+ * @tparam  CallT   Type of the bound call, see `asyncCall` and `asyncMemberCall`.
+ *          
+ * Started calls are required to stay in place until continued, which happens naturally when 
+ * they are `co_await`ed as the call then lives in the coroutine frame. Without coroutine support, 
+ * calls are started using a continuation function instead.
+ *          
+ * @code
+ *      AsyncTask script(TaskQueue& mainThread, ResumeQueue& worker, Stable& stable) 
+ *      {
+ *          if (auto count = co_await asyncMemberCall(mainThread, worker, stable, 
+ *              &Stable::numHorses)) 
+ *          {
+ *              ...
+ *          }
+ *      }
+ * @endcode
+ */
+template<typename CallT>
+class AsyncCall : private internal::ResumeNode
+{
+public:
+    using RetT = decltype(std::declval<CallT&>()());
+
+    /**
+     * @brief   The result, the return value if the call ran or `zycore::kEmpty` if it couldn't 
+     *          be posted. For functions returning `void`, a `bool`.
+     */
+    using ResultType = std::conditional_t<std::is_void<RetT>::value, bool, zycore::Optional<
+        std::conditional_t<std::is_void<RetT>::value, int, RetT>>>;
+
+    /**
+     * @brief   Continuation function, invoked with the context passed to `start`.
+     */
+    using Continuation = void (*)(void* context);
+
+    AsyncCall(TaskQueue& target, ResumeQueue& resume, CallT call)
+        : m_target{target}
+        , m_resume{resume}
+        , m_call{std::move(call)}
+    {}
+
+    /**
+     * @brief   Move constructor, only valid for calls not started yet.
+     */
+    AsyncCall(AsyncCall&& other)
+        : m_target{other.m_target}
+        , m_resume{other.m_resume}
+        , m_call{std::move(other.m_call)}
+    {}
+
+    AsyncCall(const AsyncCall&) = delete;
+    AsyncCall& operator = (const AsyncCall&) = delete;
+
+    /**
+     * @brief   Posts the call.
+     * @param   cont    The continuation, run by the consumer of the `ResumeQueue`.
+     * @param   context The argument passed to @c cont.
+     * @return  @c true if posted, else @c false if the target queue is full. In that case the 
+     *          continuation isn't run.
+     */
+    bool start(Continuation cont, void* context)
+    {
+        m_cont = cont;
+        m_context = context;
+        this->resume = &resumeThunk;
+        return m_target.post([this] 
+        { 
+            run(std::is_void<RetT>{}); 
+            m_resume.push(this);
+        });
+    }
+
+    /**
+     * @brief   Gets the result, valid once continued.
+     */
+    ResultType& result() { return m_result; }
+
+#ifdef REMODEL_HAS_COROUTINES
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        return start([](void* address) 
+        { 
+            std::coroutine_handle<>::from_address(address).resume(); 
+        }, handle.address());
+    }
+
+    ResultType await_resume() { return m_result; }
+#endif // ifdef REMODEL_HAS_COROUTINES
+private:
+    void run(std::false_type) { m_result = ResultType{zycore::kInPlace, m_call()}; }
+    void run(std::true_type)  { m_call(); m_result = true; }
+
+    static void resumeThunk(internal::ResumeNode* node) 
+    { 
+        auto thiz = static_cast<AsyncCall*>(node);
+        thiz->m_cont(thiz->m_context); 
+    }
+private:
+    TaskQueue& m_target;
+    ResumeQueue& m_resume;
+    CallT m_call;
+    ResultType m_result{};
+    Continuation m_cont = nullptr;
+    void* m_context = nullptr;
+};
+
+/**
+ * @brief   Creates an asynchronous call of a `MemberFunction` (or `VirtualFunction`).
+ * @param   target  The queue drained by the thread running the call.
+ * @param   resume  The queue drained by the thread continuing after the call.
+ * @param   wrapper The wrapper of the object.
+ * @param   member  Pointer to the function member, e.g. `&Stable::addHorse`.
+ * @param   args    The arguments, stored by value.
+ * @return  The call, not started yet.
+ * @see     TaskQueue::postCall
+ */
+template<typename WrapperT, typename FuncT, typename... ArgsT>
+inline auto asyncMemberCall(TaskQueue& target, ResumeQueue& resume, const WrapperT& wrapper, 
+    FuncT WrapperT::* member, ArgsT&&... args)
+{
+    auto call = internal::bindMemberCall(wrapper, member, std::forward<ArgsT>(args)...);
+    return AsyncCall<decltype(call)>{target, resume, std::move(call)};
+}
+
+/**
+ * @brief   Creates an asynchronous call of a `Function`.
+ * @param   target  The queue drained by the thread running the call.
+ * @param   resume  The queue drained by the thread continuing after the call.
+ * @param   func    The function.
+ * @param   args    The arguments, stored by value.
+ * @return  The call, not started yet.
+ */
+template<typename FuncT, typename... ArgsT>
+inline auto asyncCall(TaskQueue& target, ResumeQueue& resume, const FuncT& func, 
+    ArgsT&&... args)
+{
+    auto call = internal::bindCall(func, std::forward<ArgsT>(args)...);
+    return AsyncCall<decltype(call)>{target, resume, std::move(call)};
+}
+
+#ifdef REMODEL_HAS_COROUTINES
+
+// ---------------------------------------------------------------------------------------------- //
+// [AsyncTask]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Return type of fire-and-forget coroutines, their frames allocated by `FramePool`.
+ *          
+ * The coroutine runs eagerly up to its first suspension and destroys itself when finished.
+ */
+class AsyncTask
+{
+public:
+    struct promise_type
+    {
+        static void* operator new (std::size_t size) { return FramePool::allocate(size); }
+
+        static void operator delete (void* frame, std::size_t size) 
+        { 
+            FramePool::deallocate(frame, size); 
+        }
+
+        AsyncTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+#endif // ifdef REMODEL_HAS_COROUTINES
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_MARSHAL_HPP
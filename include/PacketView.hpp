@@ -0,0 +1,304 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_PACKETVIEW_HPP
+#define REMODEL_PACKETVIEW_HPP
+
+/**
+ * @file
+ * @brief Contains bounds-checked, zero-copy views over received packets.
+ *
+ * `wrapper_cast` constructs every field of a wrapper, which easily costs more than parsing a 
+ * small packet. A `PacketView` instead is a trivially copyable pointer and length pair, typed by 
+ * a wrapper declaring its fields as `FieldDesc`s. Reads are checked against the buffer length, 
+ * so truncated or malformed packets yield empty optionals instead of reading past the buffer.
+ *
+ * @code
+ *      class UdpHeader : public AdvancedClassWrapper<8>
+ *      {
+ *          REMODEL_ADV_WRAPPER(UdpHeader)
+ *      public:
+ *          static constexpr FieldDesc<uint16_t, 0> srcPort{};
+ *          static constexpr FieldDesc<uint16_t, 4> length{};
+ *      };
+ *
+ *      PacketView<UdpHeader> udp{buffer, received};
+ *      auto length = udp.get<ByteOrder::Big>(UdpHeader::length);
+ *      if (!length) return; // truncated
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+#include "Endian.hpp"
+
+#include <cstring>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [PacketView]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Bounds-checked view over a packet in a receive buffer.
+ * @tparam  WrapperT    The wrapper describing the packet header, derived from 
+ *                      `AdvancedClassWrapper`. Its fields are accessed using `FieldDesc`s.
+ *                      
+ * The view does not own the buffer. Fields are read by value using unaligned loads, no wrapper
+ * is ever constructed unless `toWrapper` is called.
+ */
+template<typename WrapperT>
+class PacketView
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "PacketView requires usage of AdvancedClassWrapper as base");
+
+    template<typename T>
+    using EnableTrivial = std::enable_if_t<std::is_trivially_copyable<T>::value, 
+        zycore::Optional<T>>;
+public:
+    /**
+     * @brief   The size of the fixed part of the packet (the wrapped header).
+     */
+    static const std::size_t kHeaderSize = WrapperT::kObjSize;
+
+    /**
+     * @brief   Default constructor, creating an empty view.
+     */
+    PacketView() = default;
+
+    /**
+     * @brief   Constructor.
+     * @param   data    The first byte of the packet.
+     * @param   size    The number of valid bytes in the buffer, starting at @c data.
+     */
+    PacketView(const void* data, std::size_t size)
+        : m_data{static_cast<const uint8_t*>(data)}
+        , m_size{data ? size : 0}
+    {}
+
+    /**
+     * @brief   Gets a pointer to the first byte of the packet.
+     * @return  The pointer.
+     */
+    const uint8_t* data() const { return m_data; }
+
+    /**
+     * @brief   Gets the number of valid bytes.
+     * @return  The size, in bytes.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief   Determines whether the whole header is contained in the buffer.
+     * @return  @c true if complete, else @c false.
+     *          
+     * If this holds, all fields inside of the header can be read using `getUnchecked`.
+     */
+    bool isComplete() const { return m_size >= kHeaderSize; }
+
+    /**
+     * @brief   Determines whether a range of bytes is contained in the buffer.
+     * @param   offs    The offset of the range, in bytes.
+     * @param   size    The size of the range, in bytes.
+     * @return  @c true if contained, else @c false.
+     */
+    bool contains(std::size_t offs, std::size_t size) const
+    {
+        return offs <= m_size && size <= m_size - offs;
+    }
+
+    /**
+     * @brief   Determines whether a field is contained in the buffer.
+     * @param   desc    The field descriptor.
+     * @return  @c true if contained, else @c false.
+     */
+    template<typename T, std::ptrdiff_t offsT>
+    bool contains(FieldDesc<T, offsT> /*desc*/) const
+    {
+        static_assert(offsT >= 0, "packet fields require non-negative offsets");
+        return contains(offsT, sizeof(typename FieldDesc<T, offsT>::Type));
+    }
+
+    /**
+     * @brief   Reads a field.
+     * @tparam  orderT  The byte order of the field in the packet.
+     * @param   desc    The field descriptor.
+     * @return  The value if contained in the buffer, else an empty optional.
+     */
+    template<ByteOrder orderT = ByteOrder::Native, typename T, std::ptrdiff_t offsT>
+    zycore::Optional<typename FieldDesc<T, offsT>::Type> get(FieldDesc<T, offsT> desc) const
+    {
+        if (!contains(desc)) return zycore::kEmpty;
+        return {zycore::kInPlace, getUnchecked<orderT>(desc)};
+    }
+
+    /**
+     * @brief   Reads a field without checking the bounds.
+     * @tparam  orderT  The byte order of the field in the packet.
+     * @param   desc    The field descriptor.
+     * @return  The value.
+     * @note    Only valid if `contains(desc)` holds, e.g. for fields of complete headers.
+     */
+    template<ByteOrder orderT = ByteOrder::Native, typename T, std::ptrdiff_t offsT>
+    typename FieldDesc<T, offsT>::Type getUnchecked(FieldDesc<T, offsT> /*desc*/) const
+    {
+        using Type = typename FieldDesc<T, offsT>::Type;
+        static_assert(!FieldDesc<T, offsT>::kDoExtraDref, 
+            "reference fields cannot be read from packets");
+        return load<orderT, Type>(static_cast<std::size_t>(offsT));
+    }
+
+    /**
+     * @brief   Reads a value at a dynamic offset, e.g. from a variable length part.
+     * @tparam  T       The type of the value, trivially copyable.
+     * @tparam  orderT  The byte order of the value in the packet.
+     * @param   offs    The offset of the value, in bytes.
+     * @return  The value if contained in the buffer, else an empty optional.
+     */
+    template<typename T, ByteOrder orderT = ByteOrder::Native>
+    EnableTrivial<T> read(std::size_t offs) const
+    {
+        if (!contains(offs, sizeof(T))) return zycore::kEmpty;
+        return {zycore::kInPlace, load<orderT, T>(offs)};
+    }
+
+    /**
+     * @brief   Gets a view of the bytes following the header.
+     * @tparam  PayloadT    The wrapper describing the payload.
+     * @return  The view, empty if the header is incomplete.
+     */
+    template<typename PayloadT>
+    PacketView<PayloadT> payload() const
+    {
+        return subview<PayloadT>(kHeaderSize);
+    }
+
+    /**
+     * @brief   Gets a view of the bytes starting at an offset.
+     * @tparam  OtherT  The wrapper describing the bytes.
+     * @param   offs    The offset, in bytes.
+     * @return  The view, empty if @c offs is out of bounds.
+     */
+    template<typename OtherT>
+    PacketView<OtherT> subview(std::size_t offs) const
+    {
+        if (offs > m_size) return {};
+        return {m_data + offs, m_size - offs};
+    }
+
+    /**
+     * @brief   Creates a wrapper of the header, for access through its regular fields.
+     * @return  The wrapper if the header is complete, else an empty optional.
+     * @note    The wrapper grants writable access to the buffer.
+     */
+    zycore::Optional<WrapperT> toWrapper() const
+    {
+        if (!isComplete()) return zycore::kEmpty;
+        return {zycore::kInPlace, wrapper_cast<WrapperT>(const_cast<uint8_t*>(m_data))};
+    }
+private:
+    template<ByteOrder orderT, typename T>
+    T load(std::size_t offs) const
+    {
+        return load<orderT, T>(offs, std::integral_constant<bool, 
+            (std::is_arithmetic<T>::value || std::is_enum<T>::value) 
+            && orderT != ByteOrder::Native>{});
+    }
+
+    template<ByteOrder orderT, typename T>
+    T load(std::size_t offs, std::true_type /*convert*/) const
+    {
+        return internal::ByteOrderConverter<T, orderT>::load(m_data + offs);
+    }
+
+    template<ByteOrder orderT, typename T>
+    T load(std::size_t offs, std::false_type /*convert*/) const
+    {
+        static_assert(orderT == ByteOrder::Native, 
+            "byte order conversion requires arithmetic or enum types");
+        T value;
+        std::memcpy(&value, m_data + offs, sizeof(value));
+        return value;
+    }
+private:
+    const uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [forEachPacket]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The number of packets the batch traversal prefetches ahead.
+ */
+const std::size_t kPacketPrefetchDistance = 4;
+
+} // namespace internal
+
+/**
+ * @brief   Invokes a function for each complete packet of a batch.
+ * @tparam  WrapperT    The wrapper describing the packet header.
+ * @tparam  FuncT       The function type, invocable with a `PacketView<WrapperT>`.
+ * @param   packets     Pointers to the first byte of each packet.
+ * @param   sizes       The number of valid bytes of each packet.
+ * @param   count       The number of packets.
+ * @param   func        The function to invoke.
+ * @return  The number of packets @c func was invoked for.
+ *          
+ * Packets too short to contain the header are skipped. The headers of upcoming packets are 
+ * prefetched, so the traversal is bound by the processing done in @c func rather than by 
+ * memory latency.
+ */
+template<typename WrapperT, typename FuncT>
+inline std::size_t forEachPacket(const void* const* packets, const std::size_t* sizes, 
+    std::size_t count, FuncT&& func)
+{
+    std::size_t visited = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i + internal::kPacketPrefetchDistance < count)
+        {
+            platform::prefetch(packets[i + internal::kPacketPrefetchDistance]);
+        }
+
+        PacketView<WrapperT> view{packets[i], sizes[i]};
+        if (!view.isComplete()) continue;
+        func(view);
+        ++visited;
+    }
+    return visited;
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_PACKETVIEW_HPP
@@ -0,0 +1,406 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_PARALLEL_HPP
+#define REMODEL_PARALLEL_HPP
+
+/**     
+ * @file
+ * @brief Contains a work-stealing thread pool and parallel loops over wrapped objects.
+ *        
+ * Every worker starts with an equal share of the elements and takes small batches from the 
+ * front of it. Workers running out of work steal the back half of the share of another worker,
+ * so uneven loop bodies (e.g. objects with long lists hanging off them) still keep all cores 
+ * busy. Each worker owns a single wrapper that is rebound to every element it visits.
+ *        
+ * @code
+ *      parallelForEach(WrapperSpan<Cat>{game->cats, game->numCats}, [](Cat& cat)
+ *      {
+ *          cat.giveGoodie(1);
+ *      });
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+#include "WrapperSpan.hpp"
+#include "InstanceScan.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [StealRange]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @brief   Range of indices owned by one worker, packed into one word so that the owner taking 
+ *          from the front and thieves splitting off the back synchronize using a single CAS.
+ * @internal
+ */
+struct alignas(64) StealRange
+{
+    std::atomic<uint64_t> packed{0};
+
+    static uint64_t pack(uint32_t begin, uint32_t end) 
+    { 
+        return static_cast<uint64_t>(end) << 32 | begin; 
+    }
+
+    /**
+     * @brief   Replaces the range, only valid while it is empty.
+     */
+    void reset(uint32_t begin, uint32_t end)
+    {
+        packed.store(pack(begin, end), std::memory_order_release);
+    }
+
+    /**
+     * @brief   Takes up to `grain` indices from the front.
+     */
+    bool take(uint32_t grain, uint32_t& begin, uint32_t& end)
+    {
+        auto cur = packed.load(std::memory_order_acquire);
+        for (;;)
+        {
+            auto first = static_cast<uint32_t>(cur), last = static_cast<uint32_t>(cur >> 32);
+            if (first >= last) return false;
+            auto next = last - first > grain ? first + grain : last;
+            if (packed.compare_exchange_weak(cur, pack(next, last), std::memory_order_acq_rel))
+            {
+                begin = first;
+                end   = next;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief   Steals the back half of the range, or all of it if no more than `grain` is left.
+     */
+    bool steal(uint32_t grain, uint32_t& begin, uint32_t& end)
+    {
+        auto cur = packed.load(std::memory_order_acquire);
+        for (;;)
+        {
+            auto first = static_cast<uint32_t>(cur), last = static_cast<uint32_t>(cur >> 32);
+            if (first >= last) return false;
+            auto mid = last - first > grain ? first + (last - first) / 2 : first;
+            if (packed.compare_exchange_weak(cur, pack(first, mid), std::memory_order_acq_rel))
+            {
+                begin = mid;
+                end   = last;
+                return true;
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [ParallelPool]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Pool of worker threads running parallel loops using work stealing.
+ *          
+ * The thread starting a loop takes part in it as worker 0 and returns once all elements were 
+ * processed. Loops started by different threads run one after another, loops must not be started
+ * from within loop bodies.
+ */
+class ParallelPool : public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   threadCount The number of workers including the calling thread, zero for one per
+     *                      hardware thread.
+     */
+    explicit ParallelPool(unsigned threadCount = 0)
+    {
+        if (!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        m_ranges = static_cast<internal::StealRange*>(internal::allocateAligned(
+            threadCount * sizeof(internal::StealRange), alignof(internal::StealRange)));
+        for (unsigned i = 0; i < threadCount; ++i) new (&m_ranges[i]) internal::StealRange;
+        m_threadCount = threadCount;
+        m_threads.reserve(threadCount - 1);
+        for (unsigned i = 1; i < threadCount; ++i)
+        {
+            m_threads.emplace_back([this, i] { workerMain(i); });
+        }
+    }
+
+    /**
+     * @brief   Destructor, joining the workers.
+     */
+    ~ParallelPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads) thread.join();
+        internal::freeAligned(m_ranges, alignof(internal::StealRange));
+    }
+
+    /**
+     * @brief   Gets a process-wide pool with one worker per hardware thread.
+     * @return  The pool.
+     */
+    static ParallelPool& shared()
+    {
+        static ParallelPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief   Gets the number of workers, including the thread starting loops.
+     * @return  The number of workers.
+     */
+    unsigned threadCount() const { return m_threadCount; }
+
+    /**
+     * @brief   Runs a loop over indices, split into batches processed by all workers.
+     * @tparam  FuncT   Type of the loop body.
+     * @param   count   The number of indices.
+     * @param   grain   The number of indices taken per batch, zero to choose automatically.
+     * @param   func    The loop body, invoked as `func(begin, end, worker)` for every batch, 
+     *                  `worker` being the index of the invoking worker below `threadCount()`.
+     */
+    template<typename FuncT>
+    void forRange(std::size_t count, std::size_t grain, const FuncT& func)
+    {
+        // Ranges are packed into 32 bit halves, larger loops run in multiple rounds.
+        const std::size_t kMaxRound = UINT32_MAX;
+        for (std::size_t base = 0; base < count; base += kMaxRound)
+        {
+            runRound(base, std::min(count - base, kMaxRound), grain, func);
+        }
+    }
+private:
+    template<typename FuncT>
+    struct Job
+    {
+        ParallelPool* pool;
+        const FuncT* func;
+        std::size_t base;
+        uint32_t grain;
+
+        static void run(void* ctx, unsigned worker)
+        {
+            auto& job = *static_cast<Job*>(ctx);
+            job.pool->work(worker, job.grain, [&](uint32_t begin, uint32_t end)
+            {
+                (*job.func)(job.base + begin, job.base + end, worker);
+            });
+        }
+    };
+
+    template<typename FuncT>
+    void runRound(std::size_t base, std::size_t count, std::size_t grain, const FuncT& func)
+    {
+        auto workers = static_cast<std::size_t>(m_threadCount);
+        if (!grain) grain = std::max<std::size_t>(1, std::min<std::size_t>(
+            256, count / (workers * 16)));
+        grain = std::min<std::size_t>(grain, UINT32_MAX);
+
+        // Not worth waking anybody.
+        if (workers == 1 || count <= grain)
+        {
+            for (std::size_t i = 0; i < count; i += grain)
+            {
+                func(base + i, base + std::min(count, i + grain), 0);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> dispatch{m_dispatchMutex};
+        for (std::size_t i = 0; i < workers; ++i)
+        {
+            m_ranges[i].reset(static_cast<uint32_t>(count * i / workers), 
+                static_cast<uint32_t>(count * (i + 1) / workers));
+        }
+
+        Job<FuncT> job{this, &func, base, static_cast<uint32_t>(grain)};
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_job     = &Job<FuncT>::run;
+            m_context = &job;
+            m_pending.store(m_threadCount - 1, std::memory_order_relaxed);
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        Job<FuncT>::run(&job, 0);
+
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_done.wait(lock, [this] { return !m_pending.load(std::memory_order_acquire); });
+    }
+
+    template<typename BatchT>
+    void work(unsigned worker, uint32_t grain, const BatchT& batch)
+    {
+        auto& own = m_ranges[worker];
+        uint32_t begin, end;
+        for (;;)
+        {
+            while (own.take(grain, begin, end)) batch(begin, end);
+
+            // Our share is exhausted, split off the back half of another one.
+            auto stolen = false;
+            for (unsigned i = 1; i < m_threadCount && !stolen; ++i)
+            {
+                stolen = m_ranges[(worker + i) % m_threadCount].steal(grain, begin, end);
+            }
+            if (!stolen) return;
+            own.reset(begin, end);
+        }
+    }
+
+    void workerMain(unsigned worker)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            void (*job)(void*, unsigned);
+            void* context;
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen    = m_generation;
+                job     = m_job;
+                context = m_context;
+            }
+
+            job(context, worker);
+
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_done.notify_one();
+            }
+        }
+    }
+private:
+    static_assert(std::is_trivially_destructible<internal::StealRange>::value, 
+        "ranges are released without destruction");
+
+    unsigned m_threadCount;
+    internal::StealRange* m_ranges;
+    std::vector<std::thread> m_threads;
+    std::mutex m_dispatchMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    void (*m_job)(void*, unsigned) = nullptr;
+    void* m_context = nullptr;
+    std::atomic<unsigned> m_pending{0};
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [parallelForEach]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Invokes a function for every object of a span on all workers of a pool.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FuncT       Type of the function.
+ * @param   span        The span.
+ * @param   func        The function, invoked as `func(WrapperT&)` concurrently from all workers.
+ * @param   pool        The pool to run on.
+ * @param   grain       The number of objects taken per batch, zero to choose automatically.
+ * @note    The wrapper passed to the function is rebound to the next object afterwards, so it 
+ *          must not be retained.
+ */
+template<typename WrapperT, typename FuncT>
+inline void parallelForEach(const WrapperSpan<WrapperT>& span, const FuncT& func, 
+    ParallelPool& pool = ParallelPool::shared(), std::size_t grain = 0)
+{
+    auto first = reinterpret_cast<uint8_t*>(span.data());
+    pool.forRange(span.size(), grain, [&](std::size_t begin, std::size_t end, unsigned)
+    {
+        auto wrapper = wrapper_cast<WrapperT>(first + begin * WrapperT::kObjSize);
+        for (auto i = begin; i < end; ++i)
+        {
+            wrapper.ClassWrapper::rebind(first + i * WrapperT::kObjSize);
+            func(wrapper);
+        }
+    });
+}
+
+/**
+ * @brief   Invokes a function for every object of an instance set on all workers of a pool.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FuncT       Type of the function.
+ * @param   set         The instance set.
+ * @param   func        The function, invoked as `func(WrapperT&)` concurrently from all workers.
+ * @param   pool        The pool to run on.
+ * @param   grain       The number of objects taken per batch, zero to choose automatically.
+ * @note    The wrapper passed to the function is rebound to the next object afterwards, so it 
+ *          must not be retained. Objects are prefetched `set.prefetchDistance()` elements ahead
+ *          within each batch.
+ */
+template<typename WrapperT, typename FuncT>
+inline void parallelForEach(const InstanceSet<WrapperT>& set, const FuncT& func,
+    ParallelPool& pool = ParallelPool::shared(), std::size_t grain = 0)
+{
+    auto raws     = set.data();
+    auto distance = set.prefetchDistance();
+    pool.forRange(set.size(), grain, [&](std::size_t begin, std::size_t end, unsigned)
+    {
+        auto wrapper = wrapper_cast<WrapperT>(raws[begin]);
+        for (auto i = begin; i < end; ++i)
+        {
+            if (distance && i + distance < end)
+            {
+                platform::prefetchRange(raws[i + distance],
+                    internal::ObjPrefetchSize<WrapperT>::value);
+            }
+            wrapper.ClassWrapper::rebind(raws[i]);
+            func(wrapper);
+        }
+    });
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_PARALLEL_HPP
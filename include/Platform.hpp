@@ -31,10 +31,96 @@
 
 #include "zycore/Config.hpp"
 
+#include <stdint.h>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <type_traits>
+
 #if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
 #   include <Windows.h>
+#   include <TlHelp32.h>
+#   define REMODEL_HAS_PROCESS_MEMORY
+#   define REMODEL_HAS_CODE_MEMORY
+#   if defined(_M_X64) || defined(_M_IX86)
+#       define REMODEL_HAS_THREAD_FREEZE
+#   endif
 #elif defined(ZYCORE_POSIX)
+#   include <arpa/inet.h>
 #   include <dlfcn.h>
+#   include <fcntl.h>
+#   include <netinet/in.h>
+#   include <netinet/tcp.h>
+#   include <poll.h>
+#   include <sys/mman.h>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   define REMODEL_HAS_CODE_MEMORY
+#   if defined(__linux__)
+#       include <link.h>
+#       include <sys/syscall.h>
+#       include <sys/types.h>
+#       include <sys/uio.h>
+#       include <limits.h>
+#       include <fcntl.h>
+#       define REMODEL_HAS_PROCESS_MEMORY
+#       if defined(__has_include)
+#           if __has_include(<linux/io_uring.h>)
+#               include <linux/io_uring.h>
+#               include <sys/syscall.h>
+#               if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#                   define REMODEL_HAS_IO_URING
+#               endif
+#           endif
+#           if __has_include(<linux/hw_breakpoint.h>) && (defined(__x86_64__)                    \
+                || defined(__i386__) || defined(__aarch64__))
+#               include <linux/hw_breakpoint.h>
+#               include <linux/perf_event.h>
+#               include <dirent.h>
+#               include <pthread.h>
+#               include <signal.h>
+#               include <sys/syscall.h>
+#               define REMODEL_HAS_HW_WATCHPOINTS
+#           endif
+#       endif
+#       if defined(__x86_64__) || defined(__i386__)
+#           include <chrono>
+#           include <cerrno>
+#           include <sched.h>
+#           include <signal.h>
+#           include <sys/syscall.h>
+#           include <ucontext.h>
+#           define REMODEL_HAS_THREAD_FREEZE
+#       endif
+#   elif defined(__APPLE__)
+#       include <mach/mach.h>
+#       include <mach/mach_vm.h>
+#       define REMODEL_HAS_PROCESS_MEMORY
+#   endif
+#endif
+
+#if defined(ZYCORE_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+#   include <xmmintrin.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   define REMODEL_HAS_RDTSC
+#   if defined(ZYCORE_MSVC)
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
 #endif
 
 namespace remodel
@@ -46,15 +132,70 @@ namespace platform
 // [obtainModuleHandle]                                                                           //
 // ---------------------------------------------------------------------------------------------- //
 
+#if defined(__linux__)
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Determines whether a loaded ELF object matches a module name.
+ * @param   objectName  The (path) name of the object, empty for the main-module.
+ * @param   moduleName  Name or path of the module or @c nullptr for the main-module.
+ * @return  @c true if the module matches, else @c false.
+ */
+inline bool moduleNameMatches(const char* objectName, const char* moduleName)
+{
+    if (!moduleName) return !objectName || !*objectName;
+    if (!objectName) return false;
+
+    auto baseName = std::strrchr(objectName, '/');
+    return !std::strcmp(objectName, moduleName) 
+        || (baseName && !std::strcmp(baseName + 1, moduleName));
+}
+
+/**
+ * @internal
+ * @brief   Calculates the address of the first byte of a loaded ELF object.
+ * @param   info    The object information provided by `dl_iterate_phdr`.
+ * @return  The address of the first mapped byte.
+ */
+inline uintptr_t elfImageBase(const dl_phdr_info* info)
+{
+    uintptr_t lowest = UINTPTR_MAX;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+    {
+        const auto& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type == PT_LOAD && phdr.p_vaddr < lowest) lowest = phdr.p_vaddr;
+    }
+    return info->dlpi_addr + (lowest == UINTPTR_MAX ? 0 : lowest);
+}
+
+} // namespace internal
+
+#endif // if defined(__linux__)
+
 /**
  * @brief   Obtain the handle of a loaded module (DLL, dylib, SO, ...).
  * @param   moduleName  Name of the module or @c nullptr for the main-module.
  * @return  @c nullptr if the module is not loaded, else a pointer to the module's first byte.
+ * @note    On Linux, modules may be specified by file name or by full path.
  */
 inline void* obtainModuleHandle(const char* moduleName)
 {
 #   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
         return GetModuleHandleA(moduleName);
+#   elif defined(__linux__)
+        struct Search { const char* name; void* result; } search{moduleName, nullptr};
+        dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* data) -> int
+        {
+            auto search = static_cast<Search*>(data);
+            // The main-module is always reported first.
+            if (!internal::moduleNameMatches(info->dlpi_name, search->name)) return 0;
+            search->result = reinterpret_cast<void*>(internal::elfImageBase(info));
+            return 1;
+        }, &search);
+        return search.result;
 #   elif defined(ZYCORE_POSIX)
         return dlopen(moduleName, RTLD_NOLOAD);
 #   else
@@ -62,6 +203,3443 @@ inline void* obtainModuleHandle(const char* moduleName)
 #   endif
 }
 
+// ---------------------------------------------------------------------------------------------- //
+// [RcuCell]                                                                                      //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The assumed size of cache lines, in bytes.
+ */
+const std::size_t kCacheLineSize = 64;
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Gets the reader stripe of the calling thread, assigned round-robin on first use.
+ * @return  The stripe index, to be reduced modulo the number of stripes.
+ */
+inline unsigned threadStripe()
+{
+    static std::atomic<unsigned> next{0};
+    static thread_local const unsigned stripe = next.fetch_add(1, std::memory_order_relaxed);
+    return stripe;
+}
+
+} // namespace internal
+
+/**
+ * @brief   Read-mostly value published by pointer swaps, in the style of RCU.
+ * @tparam  T   The type of the value.
+ *
+ * Readers never block and never write to memory shared with other threads: a `Reader` registers 
+ * in the reader counter of its thread's stripe (a cache line of its own) and then uses the 
+ * current value as a plain immutable object. Writers build a new value, publish it with a single
+ * pointer swap and free the replaced value once all readers that could still observe it have 
+ * left (a two-slot reader count per stripe, as in the "left-right" technique). Writers are 
+ * serialized by a mutex and wait for readers, so updates should be rare compared to reads.
+ *
+ * @code
+ *      RcuCell<std::vector<Entry>> entries;
+ *      
+ *      // Readers, on any number of threads.
+ *      auto reader = entries.read();
+ *      for (const auto& entry : *reader) ...
+ *      
+ *      // Writers, copying the current value.
+ *      entries.update([&](std::vector<Entry>& next) { next.push_back(entry); });
+ * @endcode
+ *
+ * @warning Readers must be short-lived, and a thread holding a `Reader` must not update the same
+ *          cell (it would wait for itself).
+ */
+template<typename T>
+class RcuCell
+{
+    static const unsigned kStripes = 32;
+
+    struct alignas(kCacheLineSize) Stripe
+    {
+        std::atomic<uint32_t> readers[2];
+    };
+public:
+    /**
+     * @brief   Registration of a reader, keeping the value current at registration alive.
+     */
+    class Reader
+    {
+        friend class RcuCell;
+
+        const RcuCell* m_cell;
+        std::atomic<uint32_t>* m_counter;
+        const T* m_value;
+
+        explicit Reader(const RcuCell& cell)
+            : m_cell{&cell}
+            , m_counter{cell.enter()}
+            , m_value{cell.m_value.load(std::memory_order_seq_cst)}
+        {}
+    public:
+        Reader(Reader&& other)
+            : m_cell{other.m_cell}
+            , m_counter{other.m_counter}
+            , m_value{other.m_value}
+        {
+            other.m_cell = nullptr;
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator = (const Reader&) = delete;
+
+        ~Reader() { if (m_cell) m_counter->fetch_sub(1, std::memory_order_release); }
+
+        const T& get() const            { return *m_value; }
+        const T& operator * () const    { return *m_value; }
+        const T* operator -> () const   { return m_value; }
+    };
+
+    /**
+     * @brief   Constructs a cell holding a value.
+     * @param   value   The initial value.
+     */
+    explicit RcuCell(T value = T{})
+        : m_value{new T(std::move(value))}
+    {
+        for (auto& stripe : m_stripes)
+        {
+            stripe.readers[0].store(0, std::memory_order_relaxed);
+            stripe.readers[1].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator = (const RcuCell&) = delete;
+
+    /**
+     * @brief   Destructor. No readers may be registered anymore.
+     */
+    ~RcuCell() { delete m_value.load(); }
+
+    /**
+     * @brief   Registers a reader of the current value.
+     * @return  The reader.
+     */
+    Reader read() const { return Reader{*this}; }
+
+    /**
+     * @brief   Publishes a new value, waiting for the readers of the replaced one.
+     * @param   value   The new value.
+     */
+    void publish(T value)
+    {
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        swap(new T(std::move(value)));
+    }
+
+    /**
+     * @brief   Publishes a modified copy of the current value, waiting for the readers of the 
+     *          replaced one.
+     * @param   func    Function receiving the copy as `T&`. Returning @c false (if it returns 
+     *                  `bool`) discards the copy instead of publishing it.
+     * @return  @c true if published, else @c false.
+     */
+    template<typename FuncT>
+    bool update(FuncT func)
+    {
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        std::unique_ptr<T> next{new T(*m_value.load())};
+        if (!invokeUpdate(func, *next)) return false;
+        swap(next.release());
+        return true;
+    }
+
+    /**
+     * @brief   Gets the number of values published so far.
+     * @return  The version, suitable for validating per-thread caches derived from the value.
+     */
+    uint64_t version() const { return m_version.load(std::memory_order_acquire); }
+private:
+    template<typename FuncT>
+    static auto invokeUpdate(FuncT& func, T& next) 
+        -> std::enable_if_t<std::is_same<decltype(func(next)), bool>::value, bool>
+    {
+        return func(next);
+    }
+
+    template<typename FuncT>
+    static auto invokeUpdate(FuncT& func, T& next)
+        -> std::enable_if_t<!std::is_same<decltype(func(next)), bool>::value, bool>
+    {
+        func(next);
+        return true;
+    }
+
+    std::atomic<uint32_t>* enter() const
+    {
+        auto& stripe = m_stripes[internal::threadStripe() % kStripes];
+        for (;;)
+        {
+            auto slot = m_slot.load();
+            stripe.readers[slot].fetch_add(1);
+            // Re-check: if the slot flipped meanwhile, the writer may not have seen us.
+            if (m_slot.load() == slot) return &stripe.readers[slot];
+            stripe.readers[slot].fetch_sub(1);
+        }
+    }
+
+    /**
+     * @brief   Publishes a value and frees the replaced one. Requires `m_writeMutex`.
+     */
+    void swap(T* next)
+    {
+        auto previous = m_value.load();
+        m_value.store(next);
+        m_version.fetch_add(1, std::memory_order_release);
+
+        // New readers enter the other slot and see `next`. Wait for the ones in the old slot.
+        auto slot = m_slot.load();
+        m_slot.store(slot ^ 1);
+        for (auto& stripe : m_stripes)
+        {
+            while (stripe.readers[slot].load(std::memory_order_acquire)) 
+            {
+                std::this_thread::yield();
+            }
+        }
+        delete previous;
+    }
+private:
+    mutable Stripe m_stripes[kStripes];
+    std::atomic<const T*> m_value;
+    std::atomic<uint32_t> m_slot{0};
+    std::atomic<uint64_t> m_version{0};
+    std::mutex m_writeMutex;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [obtainModuleHandleCached]                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+#if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+
+/**
+ * @internal
+ * @brief   Counter incremented on every module load and unload.
+ */
+inline std::atomic<uint64_t>& moduleLoadCounter()
+{
+    static std::atomic<uint64_t> counter{0};
+    return counter;
+}
+
+/**
+ * @internal
+ * @brief   The `LdrRegisterDllNotification` callback.
+ */
+inline VOID NTAPI onDllNotification(ULONG, const void*, PVOID)
+{
+    ++moduleLoadCounter();
+}
+
+#endif
+
+/**
+ * @internal
+ * @brief   Obtains a value changing whenever a module is loaded or unloaded.
+ * @param   generation  Receives the generation.
+ * @return  @c true if supported, else @c false.
+ *          
+ * On Linux, this is the sum of the load and unload counters reported by `dl_iterate_phdr`. On 
+ * Windows, a `LdrRegisterDllNotification` callback is registered on first use.
+ */
+inline bool obtainModuleGeneration(uint64_t& generation)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        using NotificationFunc = VOID (NTAPI*)(ULONG, const void*, PVOID);
+        using RegisterFunc     = LONG (NTAPI*)(ULONG, NotificationFunc, PVOID, PVOID*);
+        static const bool kRegistered = []
+        {
+            auto registerFunc = reinterpret_cast<RegisterFunc>(
+                GetProcAddress(GetModuleHandleA("ntdll.dll"), "LdrRegisterDllNotification"));
+            PVOID cookie;
+            return registerFunc && registerFunc(0, &onDllNotification, nullptr, &cookie) >= 0;
+        }();
+        generation = moduleLoadCounter();
+        return kRegistered;
+#   elif defined(__linux__)
+        struct Result { uint64_t generation; bool supported; };
+        Result result{0, false};
+        dl_iterate_phdr([](dl_phdr_info* info, std::size_t size, void* data) -> int
+        {
+            // The counters were added to the end of the struct in later glibc versions.
+            auto result = static_cast<Result*>(data);
+            result->supported = size >= offsetof(dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs);
+            if (result->supported) result->generation = info->dlpi_adds + info->dlpi_subs;
+            return 1;
+        }, &result);
+        generation = result.generation;
+        return result.supported;
+#   else
+        (void)generation;
+        return false;
+#   endif
+}
+
+/**
+ * @internal
+ * @brief   Thread-safe cache of module handles, invalidated whenever modules are (un)loaded.
+ *
+ * Lookups of cached modules read an `RcuCell` and don't take any lock of their own.
+ */
+class ModuleHandleCache
+{
+    struct Entry
+    {
+        bool        isMainModule;
+        std::string name;
+        void*       handle;
+    };
+
+    struct State
+    {
+        uint64_t           generation = 0;
+        std::vector<Entry> entries;
+    };
+
+    RcuCell<State> m_state;
+public:
+    /**
+     * @brief   Gets the process-wide instance.
+     */
+    static ModuleHandleCache& instance()
+    {
+        static ModuleHandleCache cache;
+        return cache;
+    }
+
+    /**
+     * @copydoc obtainModuleHandleCached
+     */
+    void* obtain(const char* moduleName)
+    {
+        uint64_t generation;
+        if (!obtainModuleGeneration(generation)) return obtainModuleHandle(moduleName);
+
+        {
+            auto state = m_state.read();
+            if (generation == state->generation)
+            {
+                auto entry = find(*state, moduleName);
+                if (entry) return entry->handle;
+            }
+        }
+
+        // Query outside the cell, then tag the result with the generation read *before* querying,
+        // so modules (un)loaded meanwhile invalidate it on the next lookup.
+        auto handle = obtainModuleHandle(moduleName);
+
+        m_state.update([&](State& next)
+        {
+            if (generation < next.generation) return false;
+            if (generation > next.generation)
+            {
+                next.entries.clear();
+                next.generation = generation;
+            }
+            if (find(next, moduleName)) return false;
+            next.entries.push_back({!moduleName, moduleName ? moduleName : "", handle});
+            return true;
+        });
+        return handle;
+    }
+private:
+    static const Entry* find(const State& state, const char* moduleName)
+    {
+        for (const auto& entry : state.entries)
+        {
+            if (moduleName ? !entry.isMainModule && entry.name == moduleName 
+                           : entry.isMainModule) return &entry;
+        }
+        return nullptr;
+    }
+};
+
+} // namespace internal
+
+/**
+ * @brief   Memoized version of `obtainModuleHandle`.
+ * @param   moduleName  Name of the module or @c nullptr for the main module.
+ * @return  The module handle or @c nullptr if not found.
+ *          
+ * Results (including misses) are cached until a module is loaded or unloaded. Lookups of cached
+ * modules are lock-free reads of an `RcuCell`, avoiding repeated `dlopen`/`GetModuleHandleA` 
+ * calls in hot paths. Falls back to calling `obtainModuleHandle` where load notifications aren't available.
+ */
+inline void* obtainModuleHandleCached(const char* moduleName)
+{
+    return internal::ModuleHandleCache::instance().obtain(moduleName);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [Module headers]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+#if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+
+/**
+ * @internal
+ * @brief   Locates the PE headers of a loaded module.
+ * @param   moduleBase  The module's first byte.
+ * @return  The headers or @c nullptr if the module isn't a valid PE image.
+ */
+inline const IMAGE_NT_HEADERS* peNtHeaders(const void* moduleBase)
+{
+    auto base = static_cast<const uint8_t*>(moduleBase);
+    auto dosHeader = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+    if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE) return nullptr;
+    auto ntHeaders = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dosHeader->e_lfanew);
+    return ntHeaders->Signature == IMAGE_NT_SIGNATURE ? ntHeaders : nullptr;
+}
+
+#elif defined(__linux__)
+
+/**
+ * @internal
+ * @brief   Invokes a function with the `dl_iterate_phdr` information of a loaded ELF object.
+ * @param   moduleBase  The object's first byte.
+ * @param   func        Function invoked with a `const dl_phdr_info*`, if the object is found.
+ * @return  @c true if the object was found, else @c false.
+ */
+template<typename FuncT>
+inline bool withElfObject(const void* moduleBase, FuncT&& func)
+{
+    using FuncPtr = std::remove_reference_t<FuncT>*;
+    struct Search { const void* base; FuncPtr func; bool found; };
+    Search search{moduleBase, &func, false};
+    dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* data) -> int
+    {
+        auto search = static_cast<Search*>(data);
+        if (reinterpret_cast<const void*>(elfImageBase(info)) != search->base) return 0;
+        (*search->func)(static_cast<const dl_phdr_info*>(info));
+        search->found = true;
+        return 1;
+    }, &search);
+    return search.found;
+}
+
+#endif
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [enumModuleSections]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Classification of module sections by their protection.
+ */
+enum class SectionKind
+{
+    /// Executable code (`.text`).
+    Code,
+    /// Read-only data (`.rdata`, `.rodata`), including headers.
+    ReadOnlyData,
+    /// Writable data (`.data`, `.bss`).
+    Data,
+};
+
+/**
+ * @brief   A readable, contiguously mapped part of a loaded module.
+ */
+struct ModuleSection
+{
+    const uint8_t* begin;
+    std::size_t    size;
+    SectionKind    kind;
+    bool           executable;
+    bool           writable;
+
+    /**
+     * @brief   Determines whether a pointer points into the section.
+     * @param   ptr The pointer.
+     * @return  @c true if inside, else @c false.
+     */
+    bool contains(const void* ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        auto base = reinterpret_cast<uintptr_t>(begin);
+        return addr >= base && addr - base < size;
+    }
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Constructs a section, classifying it by its protection.
+ */
+inline ModuleSection makeModuleSection(const void* begin, std::size_t size, bool executable,
+    bool writable)
+{
+    auto kind = executable ? SectionKind::Code 
+        : writable ? SectionKind::Data 
+        : SectionKind::ReadOnlyData;
+    return {static_cast<const uint8_t*>(begin), size, kind, executable, writable};
+}
+
+} // namespace internal
+
+/**
+ * @brief   Enumerates the readable sections (segments) of a loaded module.
+ * @param   moduleBase  The module's first byte, as returned by `obtainModuleHandle`.
+ * @param   func        Function invoked with a `const ModuleSection&` for every section.
+ * @return  @c true if the module was found, else @c false.
+ * @note    On Linux, the (unnamed) loadable segments are enumerated. Not supported (always 
+ *          returning @c false) on other POSIX platforms.
+ */
+template<typename FuncT>
+inline bool enumModuleSections(const void* moduleBase, FuncT&& func)
+{
+    if (!moduleBase) return false;
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto ntHeaders = internal::peNtHeaders(moduleBase);
+        if (!ntHeaders) return false;
+        
+        auto base = static_cast<const uint8_t*>(moduleBase);
+        auto section = IMAGE_FIRST_SECTION(ntHeaders);
+        for (WORD i = 0; i < ntHeaders->FileHeader.NumberOfSections; ++i, ++section)
+        {
+            if (!(section->Characteristics & IMAGE_SCN_MEM_READ)) continue;
+            func(internal::makeModuleSection(
+                base + section->VirtualAddress, 
+                section->Misc.VirtualSize,
+                (section->Characteristics & IMAGE_SCN_MEM_EXECUTE) != 0,
+                (section->Characteristics & IMAGE_SCN_MEM_WRITE) != 0
+                ));
+        }
+        return true;
+#   elif defined(__linux__)
+        return internal::withElfObject(moduleBase, [&](const dl_phdr_info* info)
+        {
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+            {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type != PT_LOAD || !(phdr.p_flags & PF_R)) continue;
+                func(internal::makeModuleSection(
+                    reinterpret_cast<const void*>(info->dlpi_addr + phdr.p_vaddr),
+                    static_cast<std::size_t>(phdr.p_memsz),
+                    (phdr.p_flags & PF_X) != 0,
+                    (phdr.p_flags & PF_W) != 0
+                    ));
+            }
+        });
+#   else
+        (void)func;
+        return false;
+#   endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [obtainModuleSize]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Obtains the size of the address range occupied by a loaded module.
+ * @param   moduleBase  The module's first byte, as returned by `obtainModuleHandle`.
+ * @return  The size in bytes, zero if the module wasn't found or the platform isn't supported.
+ */
+inline std::size_t obtainModuleSize(const void* moduleBase)
+{
+    if (!moduleBase) return 0;
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto ntHeaders = internal::peNtHeaders(moduleBase);
+        return ntHeaders ? ntHeaders->OptionalHeader.SizeOfImage : 0;
+#   elif defined(__linux__)
+        uintptr_t end = 0;
+        internal::withElfObject(moduleBase, [&](const dl_phdr_info* info)
+        {
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+            {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type != PT_LOAD) continue;
+                auto segmentEnd = info->dlpi_addr + phdr.p_vaddr + phdr.p_memsz;
+                if (segmentEnd > end) end = segmentEnd;
+            }
+        });
+        return end ? end - reinterpret_cast<uintptr_t>(moduleBase) : 0;
+#   else
+        return 0;
+#   endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [obtainModuleIdentity]                                                                         //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Bytes identifying a specific build of a module.
+ */
+struct ModuleIdentity
+{
+    static const std::size_t kMaxSize = 32;
+
+    uint8_t     bytes[kMaxSize];
+    std::size_t size;
+};
+
+/**
+ * @brief   Obtains the identity of a loaded module, from its headers.
+ * @param   moduleBase  The module's first byte, as returned by `obtainModuleHandle`.
+ * @param   identity    Receives the identity.
+ * @return  @c true if the module was found and carries an identity, else @c false.
+ *          
+ * On Windows, the identity is the PE timestamp and image size. On Linux, it is the GNU build-id
+ * note, so modules linked without a build-id have no identity. Other platforms aren't supported.
+ */
+inline bool obtainModuleIdentity(const void* moduleBase, ModuleIdentity& identity)
+{
+    identity.size = 0;
+    if (!moduleBase) return false;
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto ntHeaders = internal::peNtHeaders(moduleBase);
+        if (!ntHeaders) return false;
+
+        DWORD fields[] = {
+            ntHeaders->FileHeader.TimeDateStamp, 
+            ntHeaders->OptionalHeader.SizeOfImage
+        };
+        std::memcpy(identity.bytes, fields, sizeof(fields));
+        identity.size = sizeof(fields);
+        return true;
+#   elif defined(__linux__)
+        internal::withElfObject(moduleBase, [&](const dl_phdr_info* info)
+        {
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum && !identity.size; ++i)
+            {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type != PT_NOTE) continue;
+
+                // Notes are a header, followed by name and descriptor, both 4-byte aligned.
+                auto cur = reinterpret_cast<const uint8_t*>(info->dlpi_addr + phdr.p_vaddr);
+                auto end = cur + phdr.p_memsz;
+                while (static_cast<std::size_t>(end - cur) >= sizeof(ElfW(Nhdr)))
+                {
+                    auto note = reinterpret_cast<const ElfW(Nhdr)*>(cur);
+                    auto name = cur + sizeof(ElfW(Nhdr));
+                    auto desc = name + ((note->n_namesz + 3) & ~3u);
+                    cur = desc + ((note->n_descsz + 3) & ~3u);
+                    if (cur > end) break;
+
+                    if (note->n_type != NT_GNU_BUILD_ID || note->n_namesz != 4 
+                        || std::memcmp(name, "GNU", 4) != 0) continue;
+
+                    std::size_t size = note->n_descsz;
+                    if (size > ModuleIdentity::kMaxSize) size = ModuleIdentity::kMaxSize;
+                    std::memcpy(identity.bytes, desc, size);
+                    identity.size = size;
+                    break;
+                }
+            }
+        });
+        return identity.size != 0;
+#   else
+        return false;
+#   endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [ExportIndex]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Hash index over the exported symbols of a loaded module.
+ *          
+ * Built once from the PE export directory or the ELF dynamic symbol table (sized using `DT_HASH` 
+ * or `DT_GNU_HASH`), lookups are then O(1) without calling `GetProcAddress`/`dlsym`. Names
+ * aren't copied but point into the module's string table, so the index is only valid while the
+ * module stays loaded.
+ */
+class ExportIndex
+{
+    struct Slot
+    {
+        const char* name;
+        uint32_t    hash;
+        uintptr_t   address;
+    };
+
+    std::vector<Slot> m_slots;
+    std::size_t       m_size = 0;
+public:
+    /**
+     * @brief   Builds the index of a module.
+     * @param   moduleBase  The module's first byte, as returned by `obtainModuleHandle`.
+     * @note    The index is empty for unknown modules and on platforms other than Windows and 
+     *          Linux.
+     */
+    explicit ExportIndex(const void* moduleBase)
+    {
+        m_slots.resize(64);
+        if (moduleBase) build(moduleBase);
+    }
+
+    /**
+     * @brief   Looks up an exported symbol.
+     * @param   name    The name of the symbol.
+     * @return  The address of the symbol or @c nullptr if not exported.
+     */
+    void* find(const char* name) const
+    {
+        auto hash = hashName(name);
+        auto mask = m_slots.size() - 1;
+        for (auto i = hash & mask; m_slots[i].name; i = (i + 1) & mask)
+        {
+            const auto& slot = m_slots[i];
+            if (slot.hash == hash && !std::strcmp(slot.name, name)) 
+                return reinterpret_cast<void*>(slot.address);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief   Gets the number of indexed symbols.
+     * @return  The number of symbols.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief   Invokes a function for every indexed symbol, in no particular order.
+     * @param   func    The function, called with the name (`const char*`) and the address 
+     *                  (`void*`).
+     */
+    template<typename FuncT>
+    void forEach(FuncT&& func) const
+    {
+        for (const auto& slot : m_slots) 
+        {
+            if (slot.name) func(slot.name, reinterpret_cast<void*>(slot.address));
+        }
+    }
+private:
+    static uint32_t hashName(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name; ++name) hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+        return hash;
+    }
+
+    void insert(const char* name, uintptr_t address)
+    {
+        // Keep the load factor at or below 1/2.
+        if ((m_size + 1) * 2 > m_slots.size())
+        {
+            std::vector<Slot> old(m_slots.size() * 2);
+            old.swap(m_slots);
+            m_size = 0;
+            for (const auto& slot : old) if (slot.name) insert(slot.name, slot.address);
+        }
+
+        auto hash = hashName(name);
+        auto mask = m_slots.size() - 1;
+        auto i = hash & mask;
+        for (; m_slots[i].name; i = (i + 1) & mask)
+        {
+            if (m_slots[i].hash == hash && !std::strcmp(m_slots[i].name, name)) return;
+        }
+        m_slots[i] = {name, hash, address};
+        ++m_size;
+    }
+
+    void build(const void* moduleBase)
+    {
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto ntHeaders = internal::peNtHeaders(moduleBase);
+        if (!ntHeaders) return;
+        const auto& dir = ntHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+        if (!dir.VirtualAddress || !dir.Size) return;
+
+        auto base      = static_cast<const uint8_t*>(moduleBase);
+        auto exports   = reinterpret_cast<const IMAGE_EXPORT_DIRECTORY*>(base + dir.VirtualAddress);
+        auto names     = reinterpret_cast<const DWORD*>(base + exports->AddressOfNames);
+        auto ordinals  = reinterpret_cast<const WORD*>(base + exports->AddressOfNameOrdinals);
+        auto functions = reinterpret_cast<const DWORD*>(base + exports->AddressOfFunctions);
+        for (DWORD i = 0; i < exports->NumberOfNames; ++i)
+        {
+            auto name = reinterpret_cast<const char*>(base + names[i]);
+            auto rva  = functions[ordinals[i]];
+
+            // Forwarded exports point to a "module.symbol" string inside the export directory.
+            uintptr_t address;
+            if (rva >= dir.VirtualAddress && rva < dir.VirtualAddress + dir.Size)
+            {
+                address = reinterpret_cast<uintptr_t>(GetProcAddress(
+                    static_cast<HMODULE>(const_cast<void*>(moduleBase)), name));
+            }
+            else
+            {
+                address = reinterpret_cast<uintptr_t>(base + rva);
+            }
+            if (address) insert(name, address);
+        }
+#   elif defined(__linux__)
+        internal::withElfObject(moduleBase, [&](const dl_phdr_info* info)
+        {
+            const ElfW(Dyn)* dynamic = nullptr;
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+            {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type == PT_DYNAMIC)
+                {
+                    dynamic = reinterpret_cast<const ElfW(Dyn)*>(info->dlpi_addr + phdr.p_vaddr);
+                }
+            }
+            if (!dynamic) return;
+
+            // glibc relocates these entries in place, other loaders (and the vDSO) don't.
+            auto fixup = [&](ElfW(Addr) ptr)
+            {
+                return ptr < info->dlpi_addr ? ptr + info->dlpi_addr : ptr;
+            };
+            const ElfW(Sym)*    symtab  = nullptr;
+            const char*         strtab  = nullptr;
+            const uint32_t*     hash    = nullptr;
+            const uint32_t*     gnuHash = nullptr;
+            const ElfW(Versym)* versym  = nullptr;
+            for (auto dyn = dynamic; dyn->d_tag != DT_NULL; ++dyn)
+            {
+                auto ptr = fixup(dyn->d_un.d_ptr);
+                switch (dyn->d_tag)
+                {
+                    case DT_SYMTAB:   symtab  = reinterpret_cast<const ElfW(Sym)*>(ptr);    break;
+                    case DT_STRTAB:   strtab  = reinterpret_cast<const char*>(ptr);         break;
+                    case DT_HASH:     hash    = reinterpret_cast<const uint32_t*>(ptr);     break;
+                    case DT_GNU_HASH: gnuHash = reinterpret_cast<const uint32_t*>(ptr);     break;
+                    case DT_VERSYM:   versym  = reinterpret_cast<const ElfW(Versym)*>(ptr); break;
+                    default: break;
+                }
+            }
+            if (!symtab || !strtab || (!hash && !gnuHash)) return;
+
+            auto count = hash ? hash[1] : gnuHashSymbolCount(gnuHash);
+            void* handle = nullptr;
+            for (uint32_t i = 1; i < count; ++i)
+            {
+                const auto& sym = symtab[i];
+                // The `st_info` encoding is identical for ELF32 and ELF64.
+                auto type = ELF32_ST_TYPE(sym.st_info);
+                auto bind = ELF32_ST_BIND(sym.st_info);
+                if (sym.st_shndx == SHN_UNDEF || type == STT_TLS || bind == STB_LOCAL) continue;
+                // Skip non-default versions of versioned symbols (`name@VERSION`).
+                if (versym && (versym[i] & 0x8000)) continue;
+
+                auto name = strtab + sym.st_name;
+                if (!*name) continue;
+                if (type == STT_GNU_IFUNC)
+                {
+                    // Resolved by the loader, ask it for the selected implementation.
+                    if (!handle) handle = dlopen(info->dlpi_name, RTLD_NOW | RTLD_NOLOAD);
+                    auto address = handle ? dlsym(handle, name) : nullptr;
+                    if (address) insert(name, reinterpret_cast<uintptr_t>(address));
+                    continue;
+                }
+                insert(name, info->dlpi_addr + sym.st_value);
+            }
+            if (handle) dlclose(handle);
+        });
+#   else
+        (void)moduleBase;
+#   endif
+    }
+
+#   if defined(__linux__)
+    /**
+     * @internal
+     * @brief   Calculates the number of dynamic symbols from a `DT_GNU_HASH` table.
+     */
+    static uint32_t gnuHashSymbolCount(const uint32_t* gnuHash)
+    {
+        auto bucketCount = gnuHash[0];
+        auto symOffset   = gnuHash[1];
+        auto bloomSize   = gnuHash[2];
+        auto buckets = gnuHash + 4 + bloomSize * (sizeof(ElfW(Addr)) / sizeof(uint32_t));
+        auto chains  = buckets + bucketCount;
+
+        uint32_t last = 0;
+        for (uint32_t i = 0; i < bucketCount; ++i) if (buckets[i] > last) last = buckets[i];
+        if (last < symOffset) return symOffset;
+
+        // The chain of the highest bucket ends with the last symbol, marked by the lowest bit.
+        while (!(chains[last - symOffset] & 1)) ++last;
+        return last + 1;
+    }
+#   endif
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Thread-safe cache of export indices, invalidated whenever modules are (un)loaded.
+ */
+class ExportIndexCache
+{
+    struct Entry
+    {
+        const void*                        moduleBase;
+        std::shared_ptr<const ExportIndex> index;
+    };
+
+    struct State
+    {
+        uint64_t           generation = 0;
+        std::vector<Entry> entries;
+    };
+
+    RcuCell<State> m_state;
+public:
+    /**
+     * @brief   Gets the process-wide instance.
+     */
+    static ExportIndexCache& instance()
+    {
+        static ExportIndexCache cache;
+        return cache;
+    }
+
+    /**
+     * @copydoc obtainExportIndex
+     */
+    std::shared_ptr<const ExportIndex> obtain(const void* moduleBase)
+    {
+        uint64_t generation;
+        bool cacheable = obtainModuleGeneration(generation);
+        if (cacheable)
+        {
+            auto state = m_state.read();
+            if (generation == state->generation)
+            {
+                for (const auto& entry : state->entries)
+                {
+                    if (entry.moduleBase == moduleBase) return entry.index;
+                }
+            }
+        }
+
+        // Built outside the cell, see `ModuleHandleCache::obtain`.
+        auto index = std::make_shared<const ExportIndex>(moduleBase);
+        if (!cacheable) return index;
+
+        m_state.update([&](State& next)
+        {
+            if (generation < next.generation) return false;
+            if (generation > next.generation)
+            {
+                next.entries.clear();
+                next.generation = generation;
+            }
+            next.entries.push_back({moduleBase, index});
+            return true;
+        });
+        return index;
+    }
+};
+
+} // namespace internal
+
+/**
+ * @brief   Obtains the export index of a loaded module, building it on first use.
+ * @param   moduleBase  The module's first byte, as returned by `obtainModuleHandle`.
+ * @return  The index, shared and reused until a module is loaded or unloaded.
+ */
+inline std::shared_ptr<const ExportIndex> obtainExportIndex(const void* moduleBase)
+{
+    return internal::ExportIndexCache::instance().obtain(moduleBase);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [prefetch]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Hints the CPU to fetch the cache line containing an address for reading.
+ * @param   addr    The address to prefetch. Invalid addresses are fine, this never faults.
+ */
+inline void prefetch(const void* addr)
+{
+#   if defined(ZYCORE_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+        _mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+#   elif defined(ZYCORE_GNUC)
+        __builtin_prefetch(addr);
+#   else
+        (void)addr;
+#   endif
+}
+
+/**
+ * @brief   Hints the CPU to fetch all cache lines spanned by a memory range for reading.
+ * @param   addr    The start of the range. Invalid addresses are fine, this never faults.
+ * @param   size    The size of the range, in bytes.
+ */
+inline void prefetchRange(const void* addr, std::size_t size)
+{
+    auto line = reinterpret_cast<uintptr_t>(addr) & ~(uintptr_t{kCacheLineSize} - 1);
+    auto end  = reinterpret_cast<uintptr_t>(addr) + size;
+    for (; line < end; line += kCacheLineSize)
+    {
+        prefetch(reinterpret_cast<const void*>(line));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [readTimestamp]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Whether `readTimestamp` counts cycles (the x86 time stamp counter) or nanoseconds.
+ */
+#ifdef REMODEL_HAS_RDTSC
+    const bool kTimestampIsCycles = true;
+#else
+    const bool kTimestampIsCycles = false;
+#endif
+
+/**
+ * @brief   Reads a cheap, monotonic timestamp, e.g. for timing short sections of code.
+ * @return  The time stamp counter on x86 (not serializing), else a steady clock in nanoseconds.
+ */
+inline uint64_t readTimestamp()
+{
+#   ifdef REMODEL_HAS_RDTSC
+        return __rdtsc();
+#   else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#   endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [MemoryRange]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A range of memory in another process paired with a local buffer.
+ */
+struct MemoryRange
+{
+    uintptr_t   address;
+    void*       buffer;
+    std::size_t size;
+};
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [ProcessHandle]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+/**
+ * @brief   Handle identifying a process, requires `PROCESS_VM_READ` and `PROCESS_VM_WRITE`.
+ */
+using ProcessHandle = HANDLE;
+#   elif defined(__APPLE__)
+/**
+ * @brief   Handle identifying a process: its task port, e.g. obtained using `task_for_pid`.
+ */
+using ProcessHandle = task_t;
+#   else
+/**
+ * @brief   Handle identifying a process.
+ */
+using ProcessHandle = pid_t;
+#   endif
+
+/**
+ * @brief   Obtains the handle of the current process.
+ * @return  The handle.
+ */
+inline ProcessHandle currentProcess()
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        return GetCurrentProcess();
+#   elif defined(__APPLE__)
+        return mach_task_self();
+#   else
+        return getpid();
+#   endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [readProcessMemory] + [writeProcessMemory]                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Reads memory of another process.
+ * @param   process The process to read from.
+ * @param   range   The range to read and the buffer to read into.
+ * @return  @c true if the whole range was read, else @c false.
+ */
+inline bool readProcessMemory(ProcessHandle process, const MemoryRange& range)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        SIZE_T read = 0;
+        return ReadProcessMemory(process, reinterpret_cast<LPCVOID>(range.address), 
+            range.buffer, range.size, &read) && read == range.size;
+#   elif defined(__APPLE__)
+        mach_vm_size_t read = 0;
+        return mach_vm_read_overwrite(process, range.address, range.size, 
+            reinterpret_cast<mach_vm_address_t>(range.buffer), &read) == KERN_SUCCESS 
+            && read == range.size;
+#   else
+        iovec local {range.buffer,                          range.size};
+        iovec remote{reinterpret_cast<void*>(range.address), range.size};
+        return process_vm_readv(process, &local, 1, &remote, 1, 0) 
+            == static_cast<ssize_t>(range.size);
+#   endif
+}
+
+/**
+ * @brief   Reads multiple ranges of memory of another process, using as few calls as possible.
+ * @param   process The process to read from.
+ * @param   ranges  The ranges to read and the buffers to read into.
+ * @param   count   The number of ranges.
+ * @return  @c true if all ranges were read completely, else @c false.
+ */
+inline bool readProcessMemory(ProcessHandle process, const MemoryRange* ranges, std::size_t count)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        bool success = true;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            success &= readProcessMemory(process, ranges[i]);
+        }
+        return success;
+#   elif defined(__APPLE__)
+        // There is no vectored read, so ranges close to each other are coalesced into a single
+        // `mach_vm_read_overwrite` through a scratch buffer, in address order.
+        const uintptr_t   kMaxGap  = 4096;
+        const std::size_t kMaxSpan = 256 * 1024;
+
+        std::vector<std::size_t> order(count);
+        for (std::size_t i = 0; i < count; ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs)
+        {
+            return ranges[lhs].address < ranges[rhs].address;
+        });
+
+        bool success = true;
+        std::vector<uint8_t> scratch;
+        for (std::size_t first = 0; first < count;)
+        {
+            auto begin = ranges[order[first]].address;
+            auto end   = begin + ranges[order[first]].size;
+            auto last  = first + 1;
+            for (; last < count; ++last)
+            {
+                const auto& next = ranges[order[last]];
+                auto nextEnd = std::max(end, next.address + next.size);
+                if (next.address > end + kMaxGap || nextEnd - begin > kMaxSpan) break;
+                end = nextEnd;
+            }
+
+            if (last - first == 1)
+            {
+                success &= readProcessMemory(process, ranges[order[first]]);
+            }
+            else
+            {
+                scratch.resize(end - begin);
+                if (readProcessMemory(process, MemoryRange{begin, scratch.data(), scratch.size()}))
+                {
+                    for (auto i = first; i < last; ++i)
+                    {
+                        const auto& range = ranges[order[i]];
+                        std::memcpy(range.buffer, &scratch[range.address - begin], range.size);
+                    }
+                }
+                else
+                {
+                    // The span includes unmapped memory, read the ranges one by one.
+                    for (auto i = first; i < last; ++i)
+                    {
+                        success &= readProcessMemory(process, ranges[order[i]]);
+                    }
+                }
+            }
+            first = last;
+        }
+        return success;
+#   else
+        const std::size_t kMaxIovecs = 128;
+        static_assert(kMaxIovecs <= IOV_MAX, "unsupported platform");
+
+        iovec local [kMaxIovecs];
+        iovec remote[kMaxIovecs];
+
+        bool success = true;
+        for (std::size_t chunk = 0; chunk < count; chunk += kMaxIovecs)
+        {
+            std::size_t num   = count - chunk < kMaxIovecs ? count - chunk : kMaxIovecs;
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < num; ++i)
+            {
+                const auto& range = ranges[chunk + i];
+                local [i] = {range.buffer,                          range.size};
+                remote[i] = {reinterpret_cast<void*>(range.address), range.size};
+                total += range.size;
+            }
+
+            // Transfers stop at the first faulting range, fall back to single reads then.
+            if (process_vm_readv(process, local, num, remote, num, 0) 
+                != static_cast<ssize_t>(total))
+            {
+                for (std::size_t i = 0; i < num; ++i)
+                {
+                    success &= readProcessMemory(process, ranges[chunk + i]);
+                }
+            }
+        }
+        return success;
+#   endif
+}
+
+/**
+ * @brief   Writes memory of another process.
+ * @param   process The process to write to.
+ * @param   range   The range to write and the buffer holding the data.
+ * @return  @c true if the whole range was written, else @c false.
+ */
+inline bool writeProcessMemory(ProcessHandle process, const MemoryRange& range)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        SIZE_T written = 0;
+        return WriteProcessMemory(process, reinterpret_cast<LPVOID>(range.address), 
+            range.buffer, range.size, &written) && written == range.size;
+#   elif defined(__APPLE__)
+        return mach_vm_write(process, range.address, reinterpret_cast<vm_offset_t>(range.buffer), 
+            static_cast<mach_msg_type_number_t>(range.size)) == KERN_SUCCESS;
+#   else
+        iovec local {range.buffer,                          range.size};
+        iovec remote{reinterpret_cast<void*>(range.address), range.size};
+        return process_vm_writev(process, &local, 1, &remote, 1, 0) 
+            == static_cast<ssize_t>(range.size);
+#   endif
+}
+
+/**
+ * @brief   Writes multiple ranges of memory of another process, using as few calls as possible.
+ * @param   process The process to write to.
+ * @param   ranges  The ranges to write and the buffers holding the data.
+ * @param   count   The number of ranges.
+ * @return  @c true if all ranges were written completely, else @c false.
+ *          
+ * Ranges are written in order.
+ */
+inline bool writeProcessMemory(ProcessHandle process, const MemoryRange* ranges, 
+    std::size_t count)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32) || defined(__APPLE__)
+        bool success = true;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            success &= writeProcessMemory(process, ranges[i]);
+        }
+        return success;
+#   else
+        const std::size_t kMaxIovecs = 128;
+        static_assert(kMaxIovecs <= IOV_MAX, "unsupported platform");
+
+        iovec local [kMaxIovecs];
+        iovec remote[kMaxIovecs];
+
+        bool success = true;
+        for (std::size_t chunk = 0; chunk < count; chunk += kMaxIovecs)
+        {
+            std::size_t num   = count - chunk < kMaxIovecs ? count - chunk : kMaxIovecs;
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < num; ++i)
+            {
+                const auto& range = ranges[chunk + i];
+                local [i] = {range.buffer,                          range.size};
+                remote[i] = {reinterpret_cast<void*>(range.address), range.size};
+                total += range.size;
+            }
+
+            auto written = process_vm_writev(process, local, num, remote, num, 0);
+            if (written == static_cast<ssize_t>(total)) continue;
+
+            // Transfers stop at the first faulting range, continue with single writes from the
+            // first range not written completely.
+            std::size_t done = 0, i = 0;
+            for (; i < num && written > 0 && done + ranges[chunk + i].size 
+                <= static_cast<std::size_t>(written); ++i) done += ranges[chunk + i].size;
+            for (; i < num; ++i) success &= writeProcessMemory(process, ranges[chunk + i]);
+        }
+        return success;
+#   endif
+}
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [Code memory]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_CODE_MEMORY
+
+/**
+ * @brief   Gets the size of a memory page.
+ * @return  The page size, in bytes.
+ */
+inline std::size_t pageSize()
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#   else
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#   endif
+}
+
+/**
+ * @brief   Allocates readable, writable and executable memory close to an address.
+ * @param   target      The address to allocate close to.
+ * @param   size        The size of the allocation, rounded up to whole pages.
+ * @param   targetSize  The size of the range starting at @c target that must be in range, e.g.
+ *                      the image of a module.
+ * @return  The allocation or @c nullptr on failure. On 64-bit targets, every byte of the 
+ *          allocation is within +-2 GiB of every byte of the target range, in range of `rel32` 
+ *          displacements.
+ */
+inline void* allocateCodeNear(const void* target, std::size_t size, std::size_t targetSize = 0)
+{
+    auto pages = pageSize();
+    size = (size + pages - 1) / pages * pages;
+
+    auto allocate = [&](uintptr_t hint) -> void*
+    {
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            return VirtualAlloc(reinterpret_cast<void*>(hint), size, MEM_RESERVE | MEM_COMMIT,
+                PAGE_EXECUTE_READWRITE);
+#       else
+            auto result = mmap(reinterpret_cast<void*>(hint), size, 
+                PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            return result == MAP_FAILED ? nullptr : result;
+#       endif
+    };
+    auto release = [&](void* ptr)
+    {
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            VirtualFree(ptr, 0, MEM_RELEASE);
+#       else
+            munmap(ptr, size);
+#       endif
+    };
+
+    if (sizeof(void*) == 4) return allocate(0);
+
+    // Probe 1 MiB steps away from the target, alternating downwards and upwards. On POSIX, the
+    // address is only a hint, so results out of range are released again.
+    const uintptr_t kStep  = 1024 * 1024;
+    const uintptr_t kRange = 0x7FFF0000;
+    auto from   = reinterpret_cast<uintptr_t>(target);
+    auto to     = from + targetSize;
+    auto lower  = from & ~(kStep - 1);
+    auto upper  = (to + kStep - 1) & ~(kStep - 1);
+    for (uintptr_t distance = kStep; distance < kRange; distance += kStep)
+    {
+        for (int direction = 0; direction < 2; ++direction)
+        {
+            uintptr_t hint = direction ? upper + distance : lower - distance;
+            if (direction ? hint < upper : hint > lower) continue;
+
+            auto result = allocate(hint);
+            if (!result) continue;
+
+            // Every byte of the allocation must be in range of every byte of the target range.
+            auto addr = reinterpret_cast<uintptr_t>(result);
+            auto span = (addr + size > to ? addr + size : to) - (addr < from ? addr : from);
+            if (span < kRange) return result;
+            release(result);
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief   Releases memory obtained from `allocateCodeNear`.
+ * @param   code    The allocation.
+ * @param   size    The size passed to `allocateCodeNear`.
+ */
+inline void releaseCode(void* code, std::size_t size)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        (void)size;
+        VirtualFree(code, 0, MEM_RELEASE);
+#   else
+        auto pages = pageSize();
+        munmap(code, (size + pages - 1) / pages * pages);
+#   endif
+}
+
+/**
+ * @brief   Writes to (usually read-only) code memory of the current process.
+ * @param   address The address to write to.
+ * @param   data    The data to write.
+ * @param   size    The size of the data, in bytes.
+ * @return  @c true on success, else @c false.
+ *          
+ * The affected pages are made writable for the duration of the write. Afterwards, the original 
+ * protection is restored on Windows, while POSIX pages (not having a query) are left readable 
+ * and executable.
+ */
+inline bool writeCode(void* address, const void* data, std::size_t size)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        DWORD oldProtection;
+        if (!VirtualProtect(address, size, PAGE_EXECUTE_READWRITE, &oldProtection)) return false;
+        std::memcpy(address, data, size);
+        VirtualProtect(address, size, oldProtection, &oldProtection);
+        FlushInstructionCache(GetCurrentProcess(), address, size);
+        return true;
+#   else
+        auto pages = pageSize();
+        auto begin = reinterpret_cast<uintptr_t>(address) & ~(pages - 1);
+        auto end   = reinterpret_cast<uintptr_t>(address) + size;
+        auto span  = static_cast<std::size_t>(end - begin);
+        auto pagesPtr = reinterpret_cast<void*>(begin);
+        if (mprotect(pagesPtr, span, PROT_READ | PROT_WRITE | PROT_EXEC)) return false;
+        std::memcpy(address, data, size);
+        mprotect(pagesPtr, span, PROT_READ | PROT_EXEC);
+        __builtin___clear_cache(static_cast<char*>(address), static_cast<char*>(address) + size);
+        return true;
+#   endif
+}
+
+/**
+ * @brief   A write to code memory, see `writeCodeBatch`.
+ */
+struct CodeWrite
+{
+    void*       address;
+    const void* data;
+    std::size_t size;
+};
+
+/**
+ * @brief   Applies many writes to (usually read-only) code memory of the current process.
+ * @param   writes  The writes, in any order.
+ * @param   count   The number of writes.
+ * @return  @c true on success. @c false if the protection of a page couldn't be changed, in 
+ *          which case nothing was written.
+ *          
+ * Like `writeCode`, but the pages of all writes are coalesced into ranges first and the 
+ * protection is changed once per range (on Windows, once per region of equal protection within 
+ * a range) rather than once per write.
+ */
+inline bool writeCodeBatch(const CodeWrite* writes, std::size_t count)
+{
+    if (!count) return true;
+
+    struct PageRange
+    {
+        uintptr_t begin;
+        uintptr_t end;
+    };
+
+    auto pages = pageSize();
+    std::vector<PageRange> ranges;
+    ranges.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto address = reinterpret_cast<uintptr_t>(writes[i].address);
+        ranges.push_back({address & ~(pages - 1), 
+            (address + writes[i].size + pages - 1) & ~(pages - 1)});
+    }
+    std::sort(ranges.begin(), ranges.end(), 
+        [](const PageRange& a, const PageRange& b) { return a.begin < b.begin; });
+    std::size_t merged = 0;
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+    {
+        if (ranges[i].begin <= ranges[merged].end)
+            ranges[merged].end = std::max(ranges[merged].end, ranges[i].end);
+        else
+            ranges[++merged] = ranges[i];
+    }
+    ranges.resize(merged + 1);
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        struct Changed
+        {
+            void*  begin;
+            SIZE_T size;
+            DWORD  protection;
+        };
+
+        // Ranges may span regions of different protections, each is restored on its own.
+        std::vector<Changed> changed;
+        bool success = true;
+        for (std::size_t i = 0; i < ranges.size() && success; ++i)
+        {
+            for (auto cur = ranges[i].begin; cur < ranges[i].end;)
+            {
+                MEMORY_BASIC_INFORMATION info;
+                if (!VirtualQuery(reinterpret_cast<void*>(cur), &info, sizeof(info))) 
+                {
+                    success = false;
+                    break;
+                }
+                auto end = std::min(ranges[i].end, 
+                    reinterpret_cast<uintptr_t>(info.BaseAddress) + info.RegionSize);
+                Changed region{reinterpret_cast<void*>(cur), static_cast<SIZE_T>(end - cur), 0};
+                if (!VirtualProtect(region.begin, region.size, PAGE_EXECUTE_READWRITE, 
+                    &region.protection))
+                {
+                    success = false;
+                    break;
+                }
+                changed.push_back(region);
+                cur = end;
+            }
+        }
+        if (success)
+        {
+            for (std::size_t i = 0; i < count; ++i) 
+                std::memcpy(writes[i].address, writes[i].data, writes[i].size);
+        }
+        for (auto& region : changed)
+        {
+            VirtualProtect(region.begin, region.size, region.protection, &region.protection);
+        }
+        if (success)
+        {
+            for (const auto& range : ranges)
+            {
+                FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<void*>(range.begin), 
+                    range.end - range.begin);
+            }
+        }
+        return success;
+#   else
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            if (!mprotect(reinterpret_cast<void*>(ranges[i].begin), 
+                ranges[i].end - ranges[i].begin, PROT_READ | PROT_WRITE | PROT_EXEC)) continue;
+            while (i--)
+            {
+                mprotect(reinterpret_cast<void*>(ranges[i].begin), 
+                    ranges[i].end - ranges[i].begin, PROT_READ | PROT_EXEC);
+            }
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) 
+            std::memcpy(writes[i].address, writes[i].data, writes[i].size);
+        for (const auto& range : ranges)
+        {
+            mprotect(reinterpret_cast<void*>(range.begin), range.end - range.begin, 
+                PROT_READ | PROT_EXEC);
+            __builtin___clear_cache(reinterpret_cast<char*>(range.begin), 
+                reinterpret_cast<char*>(range.end));
+        }
+        return true;
+#   endif
+}
+
+#endif // ifdef REMODEL_HAS_CODE_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [PageBuffer]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The pages backing a `PageBuffer`.
+ */
+enum class PageKind
+{
+    /// Regular pages (or the heap, without NUMA placement).
+    Default,
+    /// 2 MiB pages, reserved (`hugetlbfs`) or transparent ones.
+    Huge2M,
+    /// 1 GiB pages if reserved, else as `Huge2M`.
+    Huge1G,
+};
+
+/**
+ * @brief   Placement of the memory of a `PageBuffer`.
+ */
+struct PagePolicy
+{
+    /// The pages requested. Falls back to smaller pages if unavailable.
+    PageKind pages = PageKind::Default;
+    /// Places the memory on the NUMA node of the constructing thread.
+    bool numaLocal = false;
+};
+
+/**
+ * @brief   Zero-initialized buffer for large, long-lived data, optionally backed by huge pages.
+ *          
+ * Huge pages cut TLB misses when scanning buffers of hundreds of megabytes. With `numaLocal`, 
+ * all pages are faulted in on construction, so construct on the worker thread using the buffer.
+ * On Linux, reserved huge pages are tried first, falling back to transparent huge pages. On 
+ * Windows, large pages require the `SeLockMemoryPrivilege`, 1 GiB pages aren't supported.
+ */
+class PageBuffer
+{
+    void*       m_data      = nullptr;
+    std::size_t m_size      = 0;
+    std::size_t m_mapped    = 0;
+    std::size_t m_pageSize  = 0;
+    bool        m_heap      = false;
+public:
+    /**
+     * @brief   Default constructor, creating an empty buffer.
+     */
+    PageBuffer() = default;
+
+    /**
+     * @brief   Allocates a buffer.
+     * @param   size    The size, in bytes.
+     * @param   policy  The placement of the memory.
+     * @throws  std::bad_alloc  If the allocation fails.
+     */
+    explicit PageBuffer(std::size_t size, PagePolicy policy = {})
+        : m_size{size}
+    {
+        if (!size) return;
+        if (policy.pages == PageKind::Default && !policy.numaLocal)
+        {
+            m_data = std::calloc(size, 1);
+            if (!m_data) throw std::bad_alloc{};
+            m_heap = true;
+            return;
+        }
+
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            ULONG node = 0;
+            PROCESSOR_NUMBER processor;
+            GetCurrentProcessorNumberEx(&processor);
+            USHORT nodeNumber;
+            if (policy.numaLocal && GetNumaProcessorNodeEx(&processor, &nodeNumber)) 
+            {
+                node = nodeNumber;
+            }
+            auto allocate = [&](DWORD flags, std::size_t granularity) -> bool
+            {
+                m_mapped = (size + granularity - 1) / granularity * granularity;
+                m_data   = policy.numaLocal 
+                    ? VirtualAllocExNuma(GetCurrentProcess(), nullptr, m_mapped, flags, 
+                        PAGE_READWRITE, node)
+                    : VirtualAlloc(nullptr, m_mapped, flags, PAGE_READWRITE);
+                m_pageSize = granularity;
+                return m_data != nullptr;
+            };
+            auto large = GetLargePageMinimum();
+            if (!(policy.pages != PageKind::Default && large 
+                && allocate(MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, large))
+                && !allocate(MEM_RESERVE | MEM_COMMIT, pageSize()))
+            {
+                throw std::bad_alloc{};
+            }
+#       elif defined(ZYCORE_POSIX)
+            auto allocate = [&](int flags, std::size_t granularity) -> bool
+            {
+                m_mapped = (size + granularity - 1) / granularity * granularity;
+                auto data = mmap(nullptr, m_mapped, PROT_READ | PROT_WRITE, 
+                    MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+                m_data     = data == MAP_FAILED ? nullptr : data;
+                m_pageSize = granularity;
+                return m_data != nullptr;
+            };
+
+            bool mapped = false;
+#           if defined(__linux__) && defined(MAP_HUGETLB)
+                // `MAP_HUGE_SHIFT` is 26, the page size is encoded as its log2.
+                const int kHugeShift = 26;
+                if (policy.pages == PageKind::Huge1G)
+                {
+                    mapped = allocate(MAP_HUGETLB | (30 << kHugeShift), std::size_t{1} << 30);
+                }
+                if (!mapped && policy.pages != PageKind::Default)
+                {
+                    mapped = allocate(MAP_HUGETLB | (21 << kHugeShift), std::size_t{1} << 21);
+                }
+#           endif
+            if (!mapped)
+            {
+                if (!allocate(0, pageSize())) throw std::bad_alloc{};
+#               if defined(__linux__) && defined(MADV_HUGEPAGE)
+                    if (policy.pages != PageKind::Default) 
+                    {
+                        madvise(m_data, m_mapped, MADV_HUGEPAGE);
+                    }
+#               endif
+            }
+
+#           if defined(__linux__) && defined(SYS_mbind)
+                // `MPOL_LOCAL`: pages are placed on the node of the thread faulting them in.
+                const int kMpolLocal = 4;
+                if (policy.numaLocal) 
+                {
+                    syscall(SYS_mbind, m_data, m_mapped, kMpolLocal, nullptr, 0, 0);
+                }
+#           endif
+            if (policy.numaLocal)
+            {
+                auto bytes = static_cast<volatile uint8_t*>(m_data);
+                for (std::size_t offs = 0; offs < m_mapped; offs += m_pageSize) bytes[offs] = 0;
+            }
+#       else
+            m_data = std::calloc(size, 1);
+            if (!m_data) throw std::bad_alloc{};
+            m_heap = true;
+#       endif
+    }
+
+    PageBuffer(PageBuffer&& other) noexcept
+    {
+        swap(other);
+    }
+
+    PageBuffer& operator = (PageBuffer&& other) noexcept
+    {
+        PageBuffer{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    PageBuffer(const PageBuffer&) = delete;
+    PageBuffer& operator = (const PageBuffer&) = delete;
+
+    /**
+     * @brief   Destructor, freeing the memory.
+     */
+    ~PageBuffer()
+    {
+        if (!m_data) return;
+        if (m_heap)
+        {
+            std::free(m_data);
+            return;
+        }
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            VirtualFree(m_data, 0, MEM_RELEASE);
+#       elif defined(ZYCORE_POSIX)
+            munmap(m_data, m_mapped);
+#       endif
+    }
+
+    void swap(PageBuffer& other) noexcept
+    {
+        std::swap(m_data,     other.m_data);
+        std::swap(m_size,     other.m_size);
+        std::swap(m_mapped,   other.m_mapped);
+        std::swap(m_pageSize, other.m_pageSize);
+        std::swap(m_heap,     other.m_heap);
+    }
+
+    /**
+     * @brief   Gets the memory.
+     */
+    void* data() const { return m_data; }
+
+    /**
+     * @brief   Gets the size requested on construction, in bytes.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief   Gets the size of the pages that were mapped, 0 if allocated from the heap.
+     *          
+     * Reports the small page size for transparent huge pages, which the kernel may or may not 
+     * provide.
+     */
+    std::size_t mappedPageSize() const { return m_pageSize; }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [ThreadFreeze]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_THREAD_FREEZE
+
+/// The signal used to park threads on Linux, taken from the range reserved for applications.
+#   if defined(__linux__) && !defined(REMODEL_FREEZE_SIGNAL)
+#       define REMODEL_FREEZE_SIGNAL (SIGRTMIN + 6)
+#   endif
+
+namespace internal
+{
+
+/// The maximum number of threads that can be frozen at once.
+const std::size_t kMaxFrozenThreads = 1024;
+
+/**
+ * @internal
+ * @brief   Serializes freezes, threads freezing each other would deadlock.
+ */
+inline std::mutex& threadFreezeMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+#   if defined(__linux__)
+
+/**
+ * @internal
+ * @brief   State shared with the signal handler parking threads.
+ *          
+ * The handler must neither lock nor allocate, so slots are static. Signals carry the generation 
+ * they were sent for, late deliveries of earlier generations are ignored.
+ */
+struct FreezeState
+{
+    struct Slot
+    {
+        std::atomic<pid_t>       tid;
+        std::atomic<ucontext_t*> context;
+    };
+
+    std::atomic<int>         generation{0};
+    std::atomic<bool>        released{false};
+    std::atomic<unsigned>    parked{0};
+    std::atomic<std::size_t> count{0};
+    Slot                     slots[kMaxFrozenThreads];
+};
+
+inline FreezeState& freezeState()
+{
+    static FreezeState state;
+    return state;
+}
+
+inline void onFreezeSignal(int, siginfo_t* info, void* context)
+{
+    auto& state = freezeState();
+    if (info->si_code != SI_QUEUE || info->si_value.sival_int != state.generation.load()) return;
+
+    auto savedErrno = errno;
+    auto tid = static_cast<pid_t>(syscall(SYS_gettid));
+    for (std::size_t i = 0, count = state.count.load(); i < count; ++i)
+    {
+        auto& slot = state.slots[i];
+        if (slot.tid.load() != tid) continue;
+
+        state.parked.fetch_add(1);
+        slot.context.store(static_cast<ucontext_t*>(context));
+        while (!state.released.load()) sched_yield();
+        state.parked.fetch_sub(1);
+        break;
+    }
+    errno = savedErrno;
+}
+
+/**
+ * @internal
+ * @brief   Entry as returned by `getdents64`.
+ */
+struct LinuxDirent64
+{
+    uint64_t       ino;
+    int64_t        off;
+    unsigned short reclen;
+    unsigned char  type;
+    char           name[1];
+};
+
+#   endif // if defined(__linux__)
+
+} // namespace internal
+
+/**
+ * @brief   Suspends all other threads of the current process.
+ *          
+ * While frozen, the instruction pointers of the suspended threads can be inspected and changed. 
+ * Threads are resumed by `thaw` or on destruction.
+ * 
+ * Suspended threads may hold arbitrary locks, including the heap's: code running while threads 
+ * are frozen must not allocate or lock.
+ *
+ * On Linux, threads are parked in a handler of `REMODEL_FREEZE_SIGNAL`. Freezing fails if a 
+ * thread doesn't pick up the signal within a second, e.g. because it blocks the signal.
+ */
+class ThreadFreeze
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+    struct Thread
+    {
+        DWORD  id;
+        HANDLE handle;
+    };
+
+    std::vector<Thread> m_threads;
+#   else
+    struct sigaction m_oldAction;
+#   endif
+    std::unique_lock<std::mutex> m_lock;
+    bool m_frozen = false;
+public:
+    /**
+     * @brief   Default constructor.
+     */
+    ThreadFreeze() 
+        : m_lock{internal::threadFreezeMutex(), std::defer_lock}
+    {
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            m_threads.reserve(internal::kMaxFrozenThreads);
+#       endif
+    }
+
+    ThreadFreeze(const ThreadFreeze&) = delete;
+    ThreadFreeze& operator = (const ThreadFreeze&) = delete;
+
+    /**
+     * @brief   Destructor resuming the threads.
+     */
+    ~ThreadFreeze() { thaw(); }
+
+    /**
+     * @brief   Suspends all threads but the calling one.
+     * @return  @c true on success (or if already frozen), else @c false. On failure, all threads
+     *          are running.
+     */
+    bool freeze()
+    {
+        if (m_frozen) return true;
+        m_lock.lock();
+        m_frozen = true;
+
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            // Repeat until no new threads show up, they might have been created meanwhile.
+            auto pid  = GetCurrentProcessId();
+            auto self = GetCurrentThreadId();
+            for (bool found = true; found;)
+            {
+                found = false;
+                auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+                if (snapshot == INVALID_HANDLE_VALUE) return thaw(), false;
+
+                THREADENTRY32 entry;
+                entry.dwSize = sizeof(entry);
+                for (auto ok = Thread32First(snapshot, &entry); ok; 
+                    ok = Thread32Next(snapshot, &entry))
+                {
+                    if (entry.th32OwnerProcessID != pid || entry.th32ThreadID == self) continue;
+
+                    bool known = false;
+                    for (const auto& thread : m_threads) known |= thread.id == entry.th32ThreadID;
+                    if (known) continue;
+                    if (m_threads.size() == internal::kMaxFrozenThreads) 
+                    {
+                        CloseHandle(snapshot);
+                        return thaw(), false;
+                    }
+
+                    auto handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT 
+                        | THREAD_SET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, 
+                        entry.th32ThreadID);
+                    if (!handle) continue;
+                    if (SuspendThread(handle) == static_cast<DWORD>(-1))
+                    {
+                        CloseHandle(handle);
+                        continue;
+                    }
+                    m_threads.push_back({entry.th32ThreadID, handle});
+                    found = true;
+                }
+                CloseHandle(snapshot);
+            }
+            return true;
+#       else
+            auto& state = internal::freezeState();
+            auto generation = state.generation.fetch_add(1) + 1;
+            state.released.store(false);
+            state.count.store(0);
+
+            struct sigaction action;
+            std::memset(&action, 0, sizeof(action));
+            action.sa_sigaction = &internal::onFreezeSignal;
+            action.sa_flags     = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            if (sigaction(REMODEL_FREEZE_SIGNAL, &action, &m_oldAction)) 
+            {
+                m_frozen = false;
+                m_lock.unlock();
+                return false;
+            }
+
+            // Enumerate using raw syscalls, `opendir` allocates. Repeat until no new threads 
+            // show up, they might have been created meanwhile.
+            auto pid  = getpid();
+            auto self = static_cast<pid_t>(syscall(SYS_gettid));
+            for (bool found = true; found;)
+            {
+                found = false;
+                auto dir = open("/proc/self/task", O_RDONLY | O_DIRECTORY);
+                if (dir < 0) return thaw(), false;
+
+                alignas(8) char buffer[4096];
+                for (long read; (read = syscall(SYS_getdents64, dir, buffer, sizeof(buffer))) > 0;)
+                {
+                    for (long offset = 0; offset < read;)
+                    {
+                        auto entry = reinterpret_cast<const internal::LinuxDirent64*>(
+                            buffer + offset);
+                        offset += entry->reclen;
+
+                        pid_t tid = 0;
+                        for (auto c = entry->name; *c >= '0' && *c <= '9'; ++c) 
+                            tid = tid * 10 + (*c - '0');
+                        if (!tid || tid == self) continue;
+
+                        auto count = state.count.load();
+                        bool known = false;
+                        for (std::size_t i = 0; i < count; ++i) 
+                            known |= state.slots[i].tid.load() == tid;
+                        if (known) continue;
+                        if (count == internal::kMaxFrozenThreads)
+                        {
+                            close(dir);
+                            return thaw(), false;
+                        }
+
+                        auto& slot = state.slots[count];
+                        slot.tid.store(tid);
+                        slot.context.store(nullptr);
+                        state.count.store(count + 1);
+
+                        siginfo_t info;
+                        std::memset(&info, 0, sizeof(info));
+                        info.si_signo = REMODEL_FREEZE_SIGNAL;
+                        info.si_code  = SI_QUEUE;
+                        info.si_pid   = pid;
+                        info.si_uid   = getuid();
+                        info.si_value.sival_int = generation;
+                        if (syscall(SYS_rt_tgsigqueueinfo, pid, tid, REMODEL_FREEZE_SIGNAL, &info))
+                        {
+                            slot.tid.store(0);
+                        }
+                        found = true;
+                    }
+                }
+                close(dir);
+            }
+
+            // Wait for every thread to be parked, dropping threads that exited.
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+            for (std::size_t i = 0, count = state.count.load(); i < count; ++i)
+            {
+                auto& slot = state.slots[i];
+                while (slot.tid.load() && !slot.context.load())
+                {
+                    if (syscall(SYS_tgkill, pid, slot.tid.load(), 0)) slot.tid.store(0);
+                    else if (std::chrono::steady_clock::now() > deadline) return thaw(), false;
+                    else sched_yield();
+                }
+            }
+            return true;
+#       endif
+    }
+
+    /**
+     * @brief   Resumes the suspended threads.
+     */
+    void thaw()
+    {
+        if (!m_frozen) return;
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            for (const auto& thread : m_threads)
+            {
+                ResumeThread(thread.handle);
+                CloseHandle(thread.handle);
+            }
+            m_threads.clear();
+#       else
+            auto& state = internal::freezeState();
+            state.generation.fetch_add(1);
+            state.released.store(true);
+            while (state.parked.load()) sched_yield();
+            sigaction(REMODEL_FREEZE_SIGNAL, &m_oldAction, nullptr);
+            state.count.store(0);
+#       endif
+        m_frozen = false;
+        m_lock.unlock();
+    }
+
+    /**
+     * @brief   Determines whether threads are currently suspended.
+     */
+    bool isFrozen() const { return m_frozen; }
+
+    /**
+     * @brief   Invokes a function for the instruction pointer of every suspended thread.
+     * @param   func    The function, called with a `uintptr_t&`. Changes to the instruction 
+     *                  pointer are applied to the thread.
+     */
+    template<typename FuncT>
+    void forEachThread(FuncT&& func)
+    {
+        if (!m_frozen) return;
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            for (const auto& thread : m_threads)
+            {
+                CONTEXT context;
+                context.ContextFlags = CONTEXT_CONTROL;
+                if (!GetThreadContext(thread.handle, &context)) continue;
+#               if defined(_M_X64)
+                    auto& reg = context.Rip;
+#               else
+                    auto& reg = context.Eip;
+#               endif
+                auto ip = static_cast<uintptr_t>(reg);
+                func(ip);
+                if (ip == reg) continue;
+                reg = ip;
+                SetThreadContext(thread.handle, &context);
+            }
+#       else
+            auto& state = internal::freezeState();
+            for (std::size_t i = 0, count = state.count.load(); i < count; ++i)
+            {
+                auto& slot = state.slots[i];
+                if (!slot.tid.load()) continue;
+#               if defined(__x86_64__)
+                    auto& reg = slot.context.load()->uc_mcontext.gregs[REG_RIP];
+#               else
+                    auto& reg = slot.context.load()->uc_mcontext.gregs[REG_EIP];
+#               endif
+                auto ip = static_cast<uintptr_t>(reg);
+                func(ip);
+                reg = static_cast<greg_t>(ip);
+            }
+#       endif
+    }
+};
+
+#endif // ifdef REMODEL_HAS_THREAD_FREEZE
+
+// ---------------------------------------------------------------------------------------------- //
+// [SoftDirtyTracker]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(__linux__)
+#   define REMODEL_HAS_PAGE_DIRTY_TRACKING
+
+/**
+ * @brief   Page-level write tracking using the soft-dirty bits of Linux.
+ *          
+ * The kernel marks pages written since the last `reset` in `/proc/self/pagemap`. Resetting 
+ * affects the whole process (including other users of the bits, e.g. checkpointing tools).
+ * Availability is verified on construction since kernels without `CONFIG_MEM_SOFT_DIRTY` report 
+ * all pages as clean.
+ */
+class SoftDirtyTracker
+{
+    int         m_pagemap   = -1;
+    int         m_clearRefs = -1;
+    std::size_t m_pageSize;
+public:
+    /**
+     * @brief   Constructor, verifying availability.
+     */
+    SoftDirtyTracker()
+        : m_pageSize{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))}
+    {
+        m_pagemap   = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        m_clearRefs = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+        if (m_pagemap < 0 || m_clearRefs < 0) 
+        {
+            close();
+            return;
+        }
+
+        // Write to a fresh page after a reset, it has to show up as dirty.
+        auto probe = mmap(nullptr, m_pageSize, PROT_READ | PROT_WRITE, 
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (probe == MAP_FAILED) 
+        {
+            close();
+            return;
+        }
+        *static_cast<volatile uint8_t*>(probe) = 1;
+        bool dirty = false;
+        auto works = reset() && isDirty(probe, dirty) && !dirty;
+        *static_cast<volatile uint8_t*>(probe) = 2;
+        works = works && isDirty(probe, dirty) && dirty;
+        munmap(probe, m_pageSize);
+        if (!works) close();
+    }
+
+    SoftDirtyTracker(const SoftDirtyTracker&) = delete;
+    SoftDirtyTracker& operator = (const SoftDirtyTracker&) = delete;
+
+    /**
+     * @brief   Destructor.
+     */
+    ~SoftDirtyTracker() { close(); }
+
+    /**
+     * @brief   Determines whether tracking is supported.
+     */
+    bool isAvailable() const { return m_pagemap >= 0; }
+
+    /**
+     * @brief   Gets the page size, in bytes.
+     */
+    std::size_t pageSize() const { return m_pageSize; }
+
+    /**
+     * @brief   Marks all pages of the process clean.
+     * @return  @c true on success, else @c false.
+     */
+    bool reset()
+    {
+        return m_clearRefs >= 0 && write(m_clearRefs, "4", 1) == 1;
+    }
+
+    /**
+     * @brief   Queries whether a page was written since the last `reset`.
+     * @param   address An address within the page.
+     * @param   dirty   Receives the result.
+     * @return  @c true on success, else @c false.
+     */
+    bool isDirty(const void* address, bool& dirty) const
+    {
+        uint64_t entry;
+        auto offset = static_cast<off_t>(reinterpret_cast<uintptr_t>(address) / m_pageSize 
+            * sizeof(entry));
+        if (m_pagemap < 0 || pread(m_pagemap, &entry, sizeof(entry), offset) != sizeof(entry)) 
+            return false;
+        dirty = (entry >> 55) & 1;
+        return true;
+    }
+
+    /**
+     * @brief   Enumerates the pages of a range written since the last `reset`.
+     * @param   begin   The first byte of the range.
+     * @param   size    The size of the range, in bytes.
+     * @param   func    Function invoked with the first byte of every dirty page, in ascending
+     *                  order.
+     * @return  @c true on success, else @c false.
+     *
+     * The page map is read in batches rather than issuing one read per page like `isDirty`.
+     */
+    template<typename FuncT>
+    bool forEachDirtyPage(const void* begin, std::size_t size, FuncT&& func) const
+    {
+        if (m_pagemap < 0) return false;
+
+        const std::size_t kBatch = 512;
+        uint64_t entries[kBatch];
+        auto first = reinterpret_cast<uintptr_t>(begin) / m_pageSize;
+        auto last  = (reinterpret_cast<uintptr_t>(begin) + size + m_pageSize - 1) / m_pageSize;
+        for (auto page = first; page < last; page += kBatch)
+        {
+            auto count = static_cast<std::size_t>(last - page < kBatch ? last - page : kBatch);
+            auto bytes = static_cast<ssize_t>(count * sizeof(uint64_t));
+            if (pread(m_pagemap, entries, static_cast<std::size_t>(bytes), 
+                static_cast<off_t>(page * sizeof(uint64_t))) != bytes) return false;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (!((entries[i] >> 55) & 1)) continue;
+                func(reinterpret_cast<const uint8_t*>((page + i) * m_pageSize));
+            }
+        }
+        return true;
+    }
+private:
+    void close()
+    {
+        if (m_pagemap >= 0) ::close(m_pagemap);
+        if (m_clearRefs >= 0) ::close(m_clearRefs);
+        m_pagemap = m_clearRefs = -1;
+    }
+};
+
+#endif // if defined(__linux__)
+
+// ---------------------------------------------------------------------------------------------- //
+// [WriteWatchpoint]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_HW_WATCHPOINTS
+
+/// The signal watchpoints notify with, taken from the range reserved for applications.
+#   ifndef REMODEL_WATCHPOINT_SIGNAL
+#       define REMODEL_WATCHPOINT_SIGNAL (SIGRTMIN + 7)
+#   endif
+
+/**
+ * @brief   The number of watchpoints the hardware supports at once (the debug registers of x86).
+ */
+const std::size_t kMaxWriteWatchpoints = 4;
+
+/**
+ * @brief   Thread waiting for notifications of `WriteWatchpoint`s.
+ *          
+ * Construct it on the waiting thread, which blocks `REMODEL_WATCHPOINT_SIGNAL` for itself. 
+ * Notifications are queued signals directed at that thread only, other threads are unaffected.
+ */
+class WatchpointListener
+{
+    pid_t    m_tid;
+    sigset_t m_set;
+public:
+    /**
+     * @brief   Constructor, to be called on the waiting thread.
+     */
+    WatchpointListener()
+        : m_tid{static_cast<pid_t>(syscall(SYS_gettid))}
+    {
+        sigemptyset(&m_set);
+        sigaddset(&m_set, REMODEL_WATCHPOINT_SIGNAL);
+        pthread_sigmask(SIG_BLOCK, &m_set, nullptr);
+    }
+
+    WatchpointListener(const WatchpointListener&) = delete;
+    WatchpointListener& operator = (const WatchpointListener&) = delete;
+
+    /**
+     * @brief   Destructor, discarding pending notifications.
+     */
+    ~WatchpointListener()
+    {
+        siginfo_t info;
+        timespec  timeout{0, 0};
+        while (sigtimedwait(&m_set, &info, &timeout) > 0) {}
+    }
+
+    /**
+     * @brief   Gets the ID of the waiting thread.
+     */
+    pid_t thread() const { return m_tid; }
+
+    /**
+     * @brief   Waits for a notification.
+     * @param   timeoutMs   The maximum time to wait, in milliseconds, negative to wait forever.
+     * @return  The descriptor of the notifying watchpoint (see `WriteWatchpoint::owns`), -1 on
+     *          timeout or if woken by `wake`.
+     */
+    int wait(long timeoutMs)
+    {
+        siginfo_t info;
+        int result;
+        if (timeoutMs < 0)
+        {
+            result = sigwaitinfo(&m_set, &info);
+        }
+        else
+        {
+            timespec timeout{timeoutMs / 1000, timeoutMs % 1000 * 1000000};
+            result = sigtimedwait(&m_set, &info, &timeout);
+        }
+        return result > 0 && info.si_code == POLL_IN ? info.si_fd : -1;
+    }
+
+    /**
+     * @brief   Wakes the waiting thread, may be called from any thread.
+     */
+    void wake() const
+    {
+        syscall(SYS_tgkill, getpid(), m_tid, REMODEL_WATCHPOINT_SIGNAL);
+    }
+};
+
+/**
+ * @brief   Hardware breakpoint notifying a `WatchpointListener` of writes to a memory range.
+ *          
+ * Uses `perf_event_open` breakpoints, armed for every thread of the process and inherited by 
+ * the threads they create. Threads created by threads that existed before arming are not 
+ * watched unless re-armed. Writes by the kernel (e.g. `read` into the range) are not reported.
+ */
+class WriteWatchpoint
+{
+    std::vector<int> m_fds;
+public:
+    WriteWatchpoint() = default;
+    WriteWatchpoint(const WriteWatchpoint&) = delete;
+    WriteWatchpoint& operator = (const WriteWatchpoint&) = delete;
+
+    WriteWatchpoint(WriteWatchpoint&& other) noexcept
+        : m_fds{std::move(other.m_fds)}
+    {
+        other.m_fds.clear();
+    }
+
+    /**
+     * @brief   Destructor, disarming the watchpoint.
+     */
+    ~WriteWatchpoint() { disarm(); }
+
+    /**
+     * @brief   Determines whether the hardware can watch a range.
+     * @param   address The begin of the range.
+     * @param   size    The size of the range, in bytes.
+     * @return  @c true if the size is 1, 2, 4 or 8 and the range is aligned to it, else @c false.
+     */
+    static bool supportsRange(const void* address, std::size_t size)
+    {
+        return (size == 1 || size == 2 || size == 4 || size == 8) 
+            && reinterpret_cast<uintptr_t>(address) % size == 0;
+    }
+
+    /**
+     * @brief   Arms the watchpoint.
+     * @param   address     The begin of the range, see `supportsRange`.
+     * @param   size        The size of the range, in bytes.
+     * @param   listener    The listener to notify.
+     * @return  @c true on success, else @c false, e.g. if the debug registers are exhausted or
+     *          breakpoints aren't permitted (see `perf_event_paranoid`).
+     */
+    bool arm(const void* address, std::size_t size, const WatchpointListener& listener)
+    {
+        disarm();
+        if (!supportsRange(address, size)) return false;
+
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_BREAKPOINT;
+        attr.bp_type        = HW_BREAKPOINT_W;
+        attr.bp_addr        = reinterpret_cast<uintptr_t>(address);
+        attr.bp_len         = size;
+        attr.sample_period  = 1;
+        attr.inherit        = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        auto dir = opendir("/proc/self/task");
+        if (!dir) return false;
+        bool success = true;
+        while (auto entry = readdir(dir))
+        {
+            auto tid = static_cast<pid_t>(std::atoi(entry->d_name));
+            if (tid <= 0) continue;
+
+            auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 
+                PERF_FLAG_FD_CLOEXEC));
+            if (fd < 0)
+            {
+                // Threads exiting meanwhile are fine, anything else isn't.
+                if (errno == ESRCH) continue;
+                success = false;
+                break;
+            }
+            m_fds.push_back(fd);
+
+            f_owner_ex owner{F_OWNER_TID, listener.thread()};
+            if (fcntl(fd, F_SETOWN_EX, &owner) || fcntl(fd, F_SETSIG, REMODEL_WATCHPOINT_SIGNAL)
+                || fcntl(fd, F_SETFL, O_ASYNC))
+            {
+                success = false;
+                break;
+            }
+        }
+        closedir(dir);
+
+        if (!success || m_fds.empty()) disarm();
+        return !m_fds.empty();
+    }
+
+    /**
+     * @brief   Disarms the watchpoint.
+     */
+    void disarm()
+    {
+        for (auto fd : m_fds) ::close(fd);
+        m_fds.clear();
+    }
+
+    /**
+     * @brief   Determines whether the watchpoint is armed.
+     */
+    bool isArmed() const { return !m_fds.empty(); }
+
+    /**
+     * @brief   Determines whether a descriptor returned by `WatchpointListener::wait` belongs to 
+     *          this watchpoint.
+     * @param   fd  The descriptor.
+     */
+    bool owns(int fd) const
+    {
+        return std::find(m_fds.begin(), m_fds.end(), fd) != m_fds.end();
+    }
+};
+
+#endif // ifdef REMODEL_HAS_HW_WATCHPOINTS
+
+// ---------------------------------------------------------------------------------------------- //
+// [ProcMemRing]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_HAS_IO_URING
+
+/**
+ * @brief   Batched access to the memory of a process through `/proc/PID/mem` and io_uring.
+ *          
+ * Batches of reads are queued into a submission ring and handed to the kernel with a single 
+ * `io_uring_enter` per ring-full, instead of one system call per range. The kernel executes the 
+ * queued reads concurrently. Single ranges use plain `pread`/`pwrite` on the same file. If the 
+ * ring can't be set up (e.g. io_uring disabled via `kernel.io_uring_disabled`), batches fall back 
+ * to `pread` per range.
+ *          
+ * Opening the file is subject to the same ptrace access checks as `process_vm_readv`.
+ */
+class ProcMemRing
+{
+    int         m_mem       = -1;
+    int         m_ring      = -1;
+    void*       m_sqMap     = MAP_FAILED;
+    void*       m_cqMap     = MAP_FAILED;
+    std::size_t m_sqMapSize = 0;
+    std::size_t m_cqMapSize = 0;
+    void*       m_sqes      = MAP_FAILED;
+    std::size_t m_sqesSize  = 0;
+    unsigned    m_entries   = 0;
+
+    unsigned*       m_sqTail  = nullptr;
+    unsigned        m_sqMask  = 0;
+    unsigned*       m_sqArray = nullptr;
+    unsigned*       m_cqHead  = nullptr;
+    const unsigned* m_cqTail  = nullptr;
+    unsigned        m_cqMask  = 0;
+    const io_uring_cqe* m_cqes = nullptr;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   process The process to access.
+     * @param   entries The size of the submission ring, the number of reads per system call.
+     */
+    explicit ProcMemRing(ProcessHandle process, unsigned entries = 256)
+    {
+        auto path = "/proc/" + std::to_string(process) + "/mem";
+        m_mem = open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (m_mem < 0) m_mem = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_mem >= 0) setupRing(entries);
+    }
+
+    ProcMemRing(const ProcMemRing&) = delete;
+    ProcMemRing& operator = (const ProcMemRing&) = delete;
+
+    /**
+     * @brief   Destructor.
+     */
+    ~ProcMemRing()
+    {
+        closeRing();
+        if (m_mem >= 0) close(m_mem);
+    }
+
+    /**
+     * @brief   Determines whether the memory file of the process could be opened.
+     */
+    bool isOpen() const { return m_mem >= 0; }
+
+    /**
+     * @brief   Determines whether batches are submitted through io_uring.
+     */
+    bool hasRing() const { return m_ring >= 0; }
+
+    /**
+     * @brief   Reads a range of memory.
+     * @param   range   The range to read and the buffer to read into.
+     * @return  @c true if the whole range was read, else @c false.
+     */
+    bool read(const MemoryRange& range)
+    {
+        return m_mem >= 0 && pread(m_mem, range.buffer, range.size, 
+            static_cast<off_t>(range.address)) == static_cast<ssize_t>(range.size);
+    }
+
+    /**
+     * @brief   Reads multiple ranges of memory.
+     * @param   ranges  The ranges to read and the buffers to read into.
+     * @param   count   The number of ranges.
+     * @return  @c true if all ranges were read completely, else @c false. Ranges not affected 
+     *          by failures are read regardless.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        if (m_ring < 0)
+        {
+            bool success = true;
+            for (std::size_t i = 0; i < count; ++i) success &= read(ranges[i]);
+            return success;
+        }
+
+        bool success = true;
+        for (std::size_t chunk = 0; chunk < count; chunk += m_entries)
+        {
+            auto num = static_cast<unsigned>(std::min<std::size_t>(count - chunk, m_entries));
+            success &= readChunk(ranges + chunk, num);
+        }
+        return success;
+    }
+
+    /**
+     * @brief   Writes a range of memory.
+     * @param   range   The range to write and the buffer holding the data.
+     * @return  @c true if the whole range was written, else @c false.
+     */
+    bool write(const MemoryRange& range)
+    {
+        return m_mem >= 0 && pwrite(m_mem, range.buffer, range.size, 
+            static_cast<off_t>(range.address)) == static_cast<ssize_t>(range.size);
+    }
+private:
+    void setupRing(unsigned entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        m_ring = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_ring < 0) return;
+
+        m_entries   = params.sq_entries;
+        m_sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) m_sqMapSize = m_cqMapSize = std::max(m_sqMapSize, m_cqMapSize);
+
+        m_sqMap = mmap(nullptr, m_sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, 
+            m_ring, IORING_OFF_SQ_RING);
+        if (m_sqMap != MAP_FAILED && !single)
+        {
+            m_cqMap = mmap(nullptr, m_cqMapSize, PROT_READ | PROT_WRITE, 
+                MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_CQ_RING);
+        }
+        auto cqMap = single ? m_sqMap : m_cqMap;
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, 
+            m_ring, IORING_OFF_SQES);
+        if (m_sqMap == MAP_FAILED || cqMap == MAP_FAILED || m_sqes == MAP_FAILED)
+        {
+            closeRing();
+            return;
+        }
+
+        auto sq  = static_cast<uint8_t*>(m_sqMap);
+        auto cq  = static_cast<uint8_t*>(cqMap);
+        m_sqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sqMask  = *reinterpret_cast<const unsigned*>(sq + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_cqHead  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cqTail  = reinterpret_cast<const unsigned*>(cq + params.cq_off.tail);
+        m_cqMask  = *reinterpret_cast<const unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes    = reinterpret_cast<const io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    void closeRing()
+    {
+        if (m_sqes != MAP_FAILED) munmap(m_sqes, m_sqesSize);
+        if (m_cqMap != MAP_FAILED) munmap(m_cqMap, m_cqMapSize);
+        if (m_sqMap != MAP_FAILED) munmap(m_sqMap, m_sqMapSize);
+        if (m_ring >= 0) close(m_ring);
+        m_sqes = m_cqMap = m_sqMap = MAP_FAILED;
+        m_ring = -1;
+    }
+
+    bool readChunk(const MemoryRange* ranges, unsigned count)
+    {
+        // The ring is only used by this thread, it's the kernel we synchronize with.
+        auto sqes = static_cast<io_uring_sqe*>(m_sqes);
+        auto tail = *m_sqTail;
+        for (unsigned i = 0; i < count; ++i, ++tail)
+        {
+            auto idx = tail & m_sqMask;
+            auto& sqe = sqes[idx];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = IORING_OP_READ;
+            sqe.fd        = m_mem;
+            sqe.addr      = reinterpret_cast<uintptr_t>(ranges[i].buffer);
+            sqe.len       = static_cast<uint32_t>(ranges[i].size);
+            sqe.off       = ranges[i].address;
+            sqe.user_data = i;
+            m_sqArray[idx] = idx;
+        }
+        __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+        bool success = true;
+        unsigned toSubmit = count;
+        unsigned completed = 0;
+        while (completed < count)
+        {
+            auto ret = syscall(__NR_io_uring_enter, m_ring, toSubmit, count - completed, 
+                IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (ret < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN) continue;
+                // The ring is left in an unknown state, continue without it.
+                closeRing();
+                for (unsigned i = 0; i < count; ++i) success &= read(ranges[i]);
+                return success;
+            }
+            toSubmit -= static_cast<unsigned>(ret);
+
+            auto head = *m_cqHead;
+            auto cqTail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+            for (; head != cqTail; ++head, ++completed)
+            {
+                const auto& cqe = m_cqes[head & m_cqMask];
+                success &= cqe.res == static_cast<int32_t>(ranges[cqe.user_data].size);
+            }
+            __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+        }
+        return success;
+    }
+};
+
+#endif // ifdef REMODEL_HAS_IO_URING
+
+// ---------------------------------------------------------------------------------------------- //
+// [Readable regions]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32) || defined(__linux__) || defined(__APPLE__)
+#   define REMODEL_HAS_REGION_QUERY
+
+namespace internal
+{
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+/**
+ * @internal
+ * @brief   Determines whether a memory region returned by `VirtualQuery` is readable.
+ */
+inline bool isReadableRegion(const MEMORY_BASIC_INFORMATION& info)
+{
+    if (info.State != MEM_COMMIT || (info.Protect & (PAGE_GUARD | PAGE_NOACCESS))) return false;
+    return (info.Protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ 
+        | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
+}
+
+/**
+ * @internal
+ * @brief   Determines whether a readable memory region returned by `VirtualQuery` is writable.
+ */
+inline bool isWritableRegion(const MEMORY_BASIC_INFORMATION& info)
+{
+    return (info.Protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE 
+        | PAGE_EXECUTE_WRITECOPY)) != 0;
+}
+#   elif defined(__APPLE__)
+/**
+ * @internal
+ * @brief   Invokes a function for every readable region of a task, using `mach_vm_region`.
+ * @param   task    The task.
+ * @param   func    Function invoked with the first and the past-the-end address of the region
+ *                  and whether it is writable. Returning @c false stops the enumeration.
+ * @return  @c true if the regions could be queried, else @c false.
+ */
+template<typename FuncT>
+inline bool enumMachRegions(task_t task, FuncT&& func)
+{
+    mach_vm_address_t addr = 0;
+    for (bool first = true;; first = false)
+    {
+        mach_vm_size_t size = 0;
+        vm_region_basic_info_data_64_t info;
+        mach_msg_type_number_t infoCount = VM_REGION_BASIC_INFO_COUNT_64;
+        mach_port_t object = MACH_PORT_NULL;
+        auto result = mach_vm_region(task, &addr, &size, VM_REGION_BASIC_INFO_64, 
+            reinterpret_cast<vm_region_info_t>(&info), &infoCount, &object);
+        if (object != MACH_PORT_NULL) mach_port_deallocate(mach_task_self(), object);
+        // Queries past the last region fail with `KERN_INVALID_ADDRESS`.
+        if (result != KERN_SUCCESS) return !first || result == KERN_INVALID_ADDRESS;
+
+        bool readable = (info.protection & VM_PROT_READ) != 0;
+        bool writable = (info.protection & VM_PROT_WRITE) != 0;
+        auto begin = static_cast<uintptr_t>(addr);
+        auto end   = static_cast<uintptr_t>(addr + size);
+        if (readable && end > begin && !func(begin, end, writable)) return true;
+        if (end <= begin) return true;
+        addr += size;
+    }
+}
+
+/**
+ * @internal
+ * @brief   Invokes a function for every readable region of the current process.
+ * @copydetails enumMachRegions
+ */
+template<typename FuncT>
+inline bool enumMappings(FuncT&& func)
+{
+    return enumMachRegions(mach_task_self(), std::forward<FuncT>(func));
+}
+#   else
+/**
+ * @internal
+ * @brief   Invokes a function for every readable mapping listed in a `/proc/PID/maps` file.
+ * @param   func    Function invoked with the first and the past-the-end address of the mapping
+ *                  and whether it is writable. Returning @c false stops the enumeration.
+ * @param   path    The path of the maps file.
+ * @return  @c true if the maps could be read, else @c false.
+ */
+template<typename FuncT>
+inline bool enumProcMaps(FuncT&& func, const char* path = "/proc/self/maps")
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // Read everything first, so mappings created by our own allocations can't shift the file.
+    std::string maps;
+    char chunk[4096];
+    for (;;)
+    {
+        auto read = ::read(fd, chunk, sizeof(chunk));
+        if (read < 0 && errno == EINTR) continue;
+        if (read <= 0) break;
+        maps.append(chunk, static_cast<std::size_t>(read));
+    }
+    ::close(fd);
+
+    const char* cur = maps.c_str();
+    while (*cur)
+    {
+        char* next;
+        auto begin = static_cast<uintptr_t>(std::strtoull(cur, &next, 16));
+        auto end   = static_cast<uintptr_t>(std::strtoull(next + 1, &next, 16));
+        bool readable = next[0] == ' ' && next[1] == 'r';
+        bool writable = readable && next[2] == 'w';
+
+        auto eol = std::strchr(next, '\n');
+        cur = eol ? eol + 1 : next + std::strlen(next);
+        if (readable && end > begin && !func(begin, end, writable)) break;
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief   Invokes a function for every readable mapping of the current process.
+ * @copydetails enumProcMaps
+ */
+template<typename FuncT>
+inline bool enumMappings(FuncT&& func)
+{
+    return enumProcMaps(std::forward<FuncT>(func));
+}
+#   endif
+
+} // namespace internal
+
+/**
+ * @brief   Enumerates the readable memory regions of the current process.
+ * @param   func    Function invoked with the first byte and the size of every region.
+ * @return  @c true on success, else @c false.
+ */
+template<typename FuncT>
+inline bool enumReadableRegions(FuncT&& func)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        MEMORY_BASIC_INFORMATION info;
+        auto addr = static_cast<const uint8_t*>(nullptr);
+        while (VirtualQuery(addr, &info, sizeof(info)) == sizeof(info))
+        {
+            if (internal::isReadableRegion(info)) func(info.BaseAddress, info.RegionSize);
+            auto next = static_cast<const uint8_t*>(info.BaseAddress) + info.RegionSize;
+            if (next <= addr) break;
+            addr = next;
+        }
+        return true;
+#   else
+        return internal::enumMappings([&](uintptr_t begin, uintptr_t end, bool /*writable*/)
+        {
+            func(reinterpret_cast<const void*>(begin), static_cast<std::size_t>(end - begin));
+            return true;
+        });
+#   endif
+}
+
+/**
+ * @brief   Enumerates the readable and writable memory regions of the current process, i.e. 
+ *          the ones heap objects and module data live in.
+ * @param   func    Function invoked with the first byte and the size of every region.
+ * @return  @c true on success, else @c false.
+ */
+template<typename FuncT>
+inline bool enumWritableRegions(FuncT&& func)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        MEMORY_BASIC_INFORMATION info;
+        auto addr = static_cast<const uint8_t*>(nullptr);
+        while (VirtualQuery(addr, &info, sizeof(info)) == sizeof(info))
+        {
+            if (internal::isReadableRegion(info) && internal::isWritableRegion(info))
+            {
+                func(info.BaseAddress, info.RegionSize);
+            }
+            auto next = static_cast<const uint8_t*>(info.BaseAddress) + info.RegionSize;
+            if (next <= addr) break;
+            addr = next;
+        }
+        return true;
+#   else
+        return internal::enumMappings([&](uintptr_t begin, uintptr_t end, bool writable)
+        {
+            if (writable) 
+            {
+                func(reinterpret_cast<const void*>(begin), static_cast<std::size_t>(end - begin));
+            }
+            return true;
+        });
+#   endif
+}
+
+/**
+ * @brief   Queries the readable memory region containing an address.
+ * @param   ptr     The address.
+ * @param   begin   Receives the first byte of the region.
+ * @param   size    Receives the size of the region.
+ * @return  @c true if the address is readable, else @c false.
+ * @note    A single `VirtualQuery` on Windows, a scan of `/proc/self/maps` on Linux and of the 
+ *          regions of the task on macOS.
+ */
+inline bool queryReadableRegion(const void* ptr, const void*& begin, std::size_t& size)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        MEMORY_BASIC_INFORMATION info;
+        if (VirtualQuery(ptr, &info, sizeof(info)) != sizeof(info)) return false;
+        if (!internal::isReadableRegion(info)) return false;
+        begin = info.BaseAddress;
+        size  = info.RegionSize;
+        return true;
+#   else
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        bool found = false;
+        internal::enumMappings([&](uintptr_t first, uintptr_t end, bool /*writable*/)
+        {
+            if (addr < first || addr >= end) return true;
+            begin = reinterpret_cast<const void*>(first);
+            size  = static_cast<std::size_t>(end - first);
+            found = true;
+            return false;
+        });
+        return found;
+#   endif
+}
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+/**
+ * @brief   Enumerates the readable memory regions of another process.
+ * @param   process The process.
+ * @param   func    Function invoked with the first byte, the size and whether it is writable 
+ *                  for every region, in ascending order.
+ * @return  @c true on success, else @c false.
+ * @note    Uses `VirtualQueryEx` on Windows, `/proc/PID/maps` on Linux and `mach_vm_region` on 
+ *          macOS.
+ */
+template<typename FuncT>
+inline bool enumProcessRegions(ProcessHandle process, FuncT&& func)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        MEMORY_BASIC_INFORMATION info;
+        auto addr = static_cast<const uint8_t*>(nullptr);
+        while (VirtualQueryEx(process, addr, &info, sizeof(info)) == sizeof(info))
+        {
+            if (internal::isReadableRegion(info))
+            {
+                func(reinterpret_cast<uintptr_t>(info.BaseAddress), info.RegionSize, 
+                    internal::isWritableRegion(info));
+            }
+            auto next = static_cast<const uint8_t*>(info.BaseAddress) + info.RegionSize;
+            if (next <= addr) break;
+            addr = next;
+        }
+        return true;
+#   else
+        auto forward = [&](uintptr_t begin, uintptr_t end, bool writable)
+        {
+            func(begin, static_cast<std::size_t>(end - begin), writable);
+            return true;
+        };
+#       if defined(__APPLE__)
+            return internal::enumMachRegions(process, forward);
+#       else
+            auto path = "/proc/" + std::to_string(process) + "/maps";
+            return internal::enumProcMaps(forward, path.c_str());
+#       endif
+#   endif
+}
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+#endif // REMODEL_HAS_REGION_QUERY
+
+// ---------------------------------------------------------------------------------------------- //
+// [SharedMemory]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32) || defined(ZYCORE_POSIX)
+#   define REMODEL_HAS_SHARED_MEMORY
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Converts a segment name to the form expected by the platform.
+ */
+inline std::string sharedMemoryName(const char* name)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        return name;
+#   else
+        return name[0] == '/' ? std::string{name} : '/' + std::string{name};
+#   endif
+}
+
+} // namespace internal
+
+/**
+ * @brief   Named shared memory segment (`CreateFileMapping`, `shm_open`), mapped on creation.
+ *          
+ * Names are local to the machine. On POSIX systems, the creator removes the name when closing
+ * the segment, mappings of other processes stay valid.
+ */
+class SharedMemory
+{
+    void*       m_data      = nullptr;
+    std::size_t m_size      = 0;
+    bool        m_owner     = false;
+    std::string m_name;
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+    HANDLE      m_mapping   = nullptr;
+#   endif
+public:
+    SharedMemory() = default;
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator = (const SharedMemory&) = delete;
+
+    /**
+     * @brief   Destructor, unmapping the segment.
+     */
+    ~SharedMemory() { close(); }
+
+    /**
+     * @brief   Creates a zero-filled segment, mapped for reading and writing.
+     * @param   name    The name of the segment.
+     * @param   size    The size of the segment, in bytes.
+     * @return  @c true on success, else @c false. Fails if a segment of that name exists.
+     */
+    bool create(const char* name, std::size_t size)
+    {
+        close();
+        m_name = internal::sharedMemoryName(name);
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto size64 = static_cast<uint64_t>(size);
+        m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 
+            static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), m_name.c_str());
+        if (m_mapping && GetLastError() == ERROR_ALREADY_EXISTS)
+        {
+            close();
+            return false;
+        }
+        return map(FILE_MAP_READ | FILE_MAP_WRITE, size, true);
+#   else
+        auto fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) return false;
+        m_owner = true;
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            close();
+            return false;
+        }
+        return map(fd, PROT_READ | PROT_WRITE, size);
+#   endif
+    }
+
+    /**
+     * @brief   Opens an existing segment, mapped for reading only.
+     * @param   name    The name of the segment.
+     * @return  @c true on success, else @c false.
+     */
+    bool open(const char* name)
+    {
+        close();
+        m_name = internal::sharedMemoryName(name);
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        m_mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, m_name.c_str());
+        return map(FILE_MAP_READ, 0, false);
+#   else
+        auto fd = shm_open(m_name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        return map(fd, PROT_READ, static_cast<std::size_t>(info.st_size));
+#   endif
+    }
+
+    /**
+     * @brief   Unmaps the segment, removing its name if created by this instance.
+     */
+    void close()
+    {
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        m_mapping = nullptr;
+#   else
+        if (m_data) munmap(m_data, m_size);
+        if (m_owner) shm_unlink(m_name.c_str());
+#   endif
+        m_data  = nullptr;
+        m_size  = 0;
+        m_owner = false;
+    }
+
+    /**
+     * @brief   Determines whether a segment is mapped.
+     */
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief   Gets the mapping of the segment.
+     */
+    void* data() const { return m_data; }
+
+    /**
+     * @brief   Gets the size of the segment, in bytes.
+     */
+    std::size_t size() const { return m_size; }
+private:
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+    bool map(DWORD access, std::size_t size, bool owner)
+    {
+        m_data = m_mapping ? MapViewOfFile(m_mapping, access, 0, 0, size) : nullptr;
+        MEMORY_BASIC_INFORMATION info;
+        if (!m_data || VirtualQuery(m_data, &info, sizeof(info)) != sizeof(info))
+        {
+            close();
+            return false;
+        }
+        // Views of existing segments are rounded up to whole pages.
+        m_size  = size ? size : info.RegionSize;
+        m_owner = owner;
+        return true;
+    }
+#   else
+    bool map(int fd, int protection, std::size_t size)
+    {
+        auto data = size ? mmap(nullptr, size, protection, MAP_SHARED, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+        m_data = data;
+        m_size = size;
+        return true;
+    }
+#   endif
+};
+
+#endif // REMODEL_HAS_SHARED_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [MappedFile]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32) || defined(ZYCORE_POSIX)
+#   define REMODEL_HAS_MAPPED_FILE
+
+/**
+ * @brief   File mapped copy-on-write (`FILE_MAP_COPY`, `MAP_PRIVATE`).
+ *          
+ * The mapping is readable and writable, but writes only modify private copies of the touched 
+ * pages and never reach the file.
+ */
+class MappedFile
+{
+    void*       m_data      = nullptr;
+    std::size_t m_size      = 0;
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+    /**
+     * @brief   Destructor, unmapping the file.
+     */
+    ~MappedFile() { close(); }
+
+    /**
+     * @brief   Maps a file.
+     * @param   path    The path of the file.
+     * @return  @c true on success, else @c false. Fails for empty files.
+     */
+    bool open(const char* path)
+    {
+        close();
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        auto mapping = GetFileSizeEx(file, &size) && size.QuadPart
+            ? CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr) : nullptr;
+        CloseHandle(file);
+        if (!mapping) return false;
+        m_data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!m_data) return false;
+        m_size = static_cast<std::size_t>(size.QuadPart);
+#   else
+        auto fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        auto size = fstat(fd, &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+        auto data = size 
+            ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (data == MAP_FAILED) return false;
+        m_data = data;
+        m_size = size;
+#   endif
+        return true;
+    }
+
+    /**
+     * @brief   Unmaps the file, discarding all writes.
+     */
+    void close()
+    {
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        if (m_data) UnmapViewOfFile(m_data);
+#   else
+        if (m_data) munmap(m_data, m_size);
+#   endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    /**
+     * @brief   Determines whether a file is mapped.
+     */
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief   Gets the mapping of the file.
+     */
+    void* data() const { return m_data; }
+
+    /**
+     * @brief   Gets the size of the file, in bytes.
+     */
+    std::size_t size() const { return m_size; }
+};
+
+#endif // REMODEL_HAS_MAPPED_FILE
+
+// ---------------------------------------------------------------------------------------------- //
+// [TcpSocket]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(ZYCORE_POSIX)
+#   define REMODEL_HAS_TCP_SOCKETS
+
+/**
+ * @brief   Non-blocking IPv4 TCP socket.
+ *          
+ * Sockets are switched to non-blocking mode once listening or connected; `send` and `receive`
+ * transfer what is possible without waiting and `waitReadable` waits for incoming data.
+ */
+class TcpSocket
+{
+    int m_fd = -1;
+public:
+    TcpSocket() = default;
+
+    TcpSocket(TcpSocket&& other)
+        : m_fd{other.m_fd}
+    {
+        other.m_fd = -1;
+    }
+
+    TcpSocket& operator = (TcpSocket&& other)
+    {
+        std::swap(m_fd, other.m_fd);
+        return *this;
+    }
+
+    TcpSocket(const TcpSocket&) = delete;
+    TcpSocket& operator = (const TcpSocket&) = delete;
+
+    /**
+     * @brief   Destructor, closing the socket.
+     */
+    ~TcpSocket() { close(); }
+
+    /**
+     * @brief   Listens for connections.
+     * @param   host    The dotted IPv4 address of the interface, e.g. "0.0.0.0" for all.
+     * @param   port    The port, zero for any free port.
+     * @return  @c true on success, else @c false.
+     */
+    bool listen(const char* host, uint16_t port)
+    {
+        sockaddr_in addr;
+        if (!open(host, port, addr)) return false;
+        int reuse = 1;
+        setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (::bind(m_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+            || ::listen(m_fd, SOMAXCONN) != 0 || !makeNonBlocking())
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Accepts a pending connection of a listening socket.
+     * @param   client  Receives the connection.
+     * @return  @c true if a connection was accepted, @c false if none is pending.
+     */
+    bool accept(TcpSocket& client)
+    {
+        auto fd = ::accept(m_fd, nullptr, nullptr);
+        if (fd < 0) return false;
+        client.close();
+        client.m_fd = fd;
+        client.configureStream();
+        return client.makeNonBlocking();
+    }
+
+    /**
+     * @brief   Connects to a listening socket, waiting for the connection.
+     * @param   host    The dotted IPv4 address of the peer.
+     * @param   port    The port.
+     * @return  @c true on success, else @c false.
+     */
+    bool connect(const char* host, uint16_t port)
+    {
+        sockaddr_in addr;
+        if (!open(host, port, addr)) return false;
+        if (::connect(m_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+            || !makeNonBlocking())
+        {
+            close();
+            return false;
+        }
+        configureStream();
+        return true;
+    }
+
+    /**
+     * @brief   Sends data without waiting.
+     * @return  The number of bytes sent, zero if the send buffer is full, -1 on errors.
+     */
+    std::ptrdiff_t send(const void* data, std::size_t size)
+    {
+#   ifdef MSG_NOSIGNAL
+        auto sent = ::send(m_fd, data, size, MSG_NOSIGNAL);
+#   else
+        auto sent = ::send(m_fd, data, size, 0);
+#   endif
+        if (sent >= 0) return sent;
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    }
+
+    /**
+     * @brief   Receives data without waiting.
+     * @return  The number of bytes received, zero if none are available, -1 on errors and
+     *          once the peer closed the connection.
+     */
+    std::ptrdiff_t receive(void* buffer, std::size_t size)
+    {
+        auto received = ::recv(m_fd, buffer, size, 0);
+        if (received > 0) return received;
+        if (received == 0) return -1;
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    }
+
+    /**
+     * @brief   Waits for incoming data, connections or the peer closing the connection.
+     * @param   timeoutMs   The maximum time to wait, in milliseconds.
+     * @return  @c true if readable, @c false on timeout.
+     */
+    bool waitReadable(int timeoutMs)
+    {
+        pollfd entry{m_fd, POLLIN, 0};
+        return ::poll(&entry, 1, timeoutMs) > 0;
+    }
+
+    /**
+     * @brief   Gets the local port, e.g. the one chosen by `listen` for port zero.
+     */
+    uint16_t localPort() const
+    {
+        sockaddr_in addr{};
+        socklen_t size = sizeof(addr);
+        if (getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &size) != 0) return 0;
+        return ntohs(addr.sin_port);
+    }
+
+    /**
+     * @brief   Determines whether the socket is open.
+     */
+    bool isOpen() const { return m_fd >= 0; }
+
+    /**
+     * @brief   Closes the socket.
+     */
+    void close()
+    {
+        if (m_fd >= 0) ::close(m_fd);
+        m_fd = -1;
+    }
+private:
+    bool open(const char* host, uint16_t port, sockaddr_in& addr)
+    {
+        close();
+        addr = sockaddr_in{};
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(port);
+        if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) return false;
+        m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        return m_fd >= 0;
+    }
+
+    bool makeNonBlocking()
+    {
+        auto flags = fcntl(m_fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    void configureStream()
+    {
+        // Messages are batched by the callers, waiting for more data only adds latency.
+        int enable = 1;
+        setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#   ifdef SO_NOSIGPIPE
+        setsockopt(m_fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#   endif
+    }
+};
+
+#endif // REMODEL_HAS_TCP_SOCKETS
+
 // ---------------------------------------------------------------------------------------------- //
 
 }
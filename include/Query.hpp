@@ -0,0 +1,402 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_QUERY_HPP
+#define REMODEL_QUERY_HPP
+
+/**     
+ * @file
+ * @brief Contains predicates over fields, evaluated by scans over whole sets of objects.
+ *        
+ * Predicates are built from `column`s, constants, comparisons and logical operators. At the 
+ * start of a scan the fields are resolved to a base address and stride, afterwards blocks of 
+ * rows are evaluated one operator at a time into byte masks using tight loops the compiler can 
+ * vectorize. No wrappers are created per object.
+ *        
+ * @code
+ *      auto query = column(&Horse::age) > 5 && column(&Horse::hatesKittehz);
+ *      std::vector<uint32_t> selection;
+ *      selectRows(WrapperSpan<Horse>{stable->horses, stable->numHorses}, query, selection);
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+#include "WrapperSpan.hpp"
+#include "ColumnCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace remodel
+{
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [QueryExpr]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Base of all query predicates.
+ *          
+ * Predicates implement `bind(source)`, returning @c false if the source lacks a field, and
+ * `evaluate(begin, count, mask)`, storing 1 for every matching row and 0 for every other one.
+ */
+struct QueryExpr {};
+
+/**
+ * @internal
+ * @brief   Base of all query operands, implementing `load(row)`.
+ */
+struct QueryOperand {};
+
+template<typename T>
+using IsQueryExpr = std::is_base_of<QueryExpr, std::decay_t<T>>;
+
+template<typename T>
+using IsQueryOperand = std::is_base_of<QueryOperand, std::decay_t<T>>;
+
+/**
+ * @internal
+ * @brief   The number of rows evaluated per block, sized for the masks to stay in L1.
+ */
+const std::size_t kQueryBlockSize = 1024;
+
+// ---------------------------------------------------------------------------------------------- //
+// [QueryColumn]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Operand loading a field of every row, also a predicate matching non-zero values.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ */
+template<typename WrapperT, typename FieldT>
+class QueryColumn : public QueryExpr, public QueryOperand
+{
+public:
+    using ValueType = typename FieldT::RewrittenT;
+    static_assert(std::is_arithmetic<ValueType>::value || std::is_enum<ValueType>::value,
+        "only fields of arithmetic and enumeration types can be queried");
+
+    explicit QueryColumn(FieldT WrapperT::* field)
+        : m_field{field}
+    {}
+
+    bool bind(const WrapperSpan<WrapperT>& span)
+    {
+        auto first   = span.data();
+        auto wrapper = wrapper_cast<WrapperT>(first);
+        m_base   = reinterpret_cast<const uint8_t*>((wrapper.*m_field).addressOfObj());
+        m_stride = WrapperT::kObjSize;
+        return true;
+    }
+
+    template<typename... FieldsT>
+    bool bind(const ColumnCache<WrapperT, FieldsT...>& cache)
+    {
+        m_base   = reinterpret_cast<const uint8_t*>(cache.columnOf(m_field));
+        m_stride = sizeof(ValueType);
+        return m_base != nullptr;
+    }
+
+    ValueType load(std::size_t row) const
+    {
+        ValueType value;
+        std::memcpy(&value, m_base + row * m_stride, sizeof(value));
+        return value;
+    }
+
+    void evaluate(std::size_t begin, std::size_t count, uint8_t* mask) const
+    {
+        for (std::size_t i = 0; i < count; ++i) mask[i] = load(begin + i) != ValueType{};
+    }
+private:
+    FieldT WrapperT::* m_field;
+    const uint8_t* m_base = nullptr;
+    std::size_t m_stride = 0;
+};
+
+/**
+ * @internal
+ * @brief   Operand yielding the same value for every row.
+ */
+template<typename T>
+class QueryConstant : public QueryOperand
+{
+public:
+    explicit QueryConstant(T value)
+        : m_value{value}
+    {}
+
+    template<typename SourceT>
+    bool bind(const SourceT&) { return true; }
+
+    T load(std::size_t) const { return m_value; }
+private:
+    T m_value;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [QueryCompare] / [QueryLogic]                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Predicate comparing two operands.
+ */
+template<typename LhsT, typename RhsT, typename OpT>
+class QueryCompare : public QueryExpr
+{
+public:
+    QueryCompare(LhsT lhs, RhsT rhs)
+        : m_lhs{lhs}
+        , m_rhs{rhs}
+    {}
+
+    template<typename SourceT>
+    bool bind(const SourceT& source) { return m_lhs.bind(source) && m_rhs.bind(source); }
+
+    void evaluate(std::size_t begin, std::size_t count, uint8_t* mask) const
+    {
+        OpT op;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mask[i] = op(m_lhs.load(begin + i), m_rhs.load(begin + i));
+        }
+    }
+private:
+    LhsT m_lhs;
+    RhsT m_rhs;
+};
+
+/**
+ * @internal
+ * @brief   Predicate combining the masks of two predicates.
+ * @tparam  isAndT  @c true for conjunctions, @c false for disjunctions.
+ */
+template<typename LhsT, typename RhsT, bool isAndT>
+class QueryLogic : public QueryExpr
+{
+public:
+    QueryLogic(LhsT lhs, RhsT rhs)
+        : m_lhs{lhs}
+        , m_rhs{rhs}
+    {}
+
+    template<typename SourceT>
+    bool bind(const SourceT& source) { return m_lhs.bind(source) && m_rhs.bind(source); }
+
+    void evaluate(std::size_t begin, std::size_t count, uint8_t* mask) const
+    {
+        uint8_t rhs[kQueryBlockSize];
+        m_lhs.evaluate(begin, count, mask);
+        m_rhs.evaluate(begin, count, rhs);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mask[i] = isAndT ? mask[i] & rhs[i] : mask[i] | rhs[i];
+        }
+    }
+private:
+    LhsT m_lhs;
+    RhsT m_rhs;
+};
+
+/**
+ * @internal
+ * @brief   Predicate negating another one.
+ */
+template<typename ExprT>
+class QueryNot : public QueryExpr
+{
+public:
+    explicit QueryNot(ExprT expr)
+        : m_expr{expr}
+    {}
+
+    template<typename SourceT>
+    bool bind(const SourceT& source) { return m_expr.bind(source); }
+
+    void evaluate(std::size_t begin, std::size_t count, uint8_t* mask) const
+    {
+        m_expr.evaluate(begin, count, mask);
+        for (std::size_t i = 0; i < count; ++i) mask[i] ^= 1;
+    }
+private:
+    ExprT m_expr;
+};
+
+/**
+ * @internal
+ * @brief   Converts an operand or a scalar compared with an operand into an operand.
+ */
+template<typename OtherT, typename T, typename = void>
+struct QueryOperandOf
+{
+    using Type = QueryConstant<typename OtherT::ValueType>;
+    static Type make(const T& value) 
+    { 
+        return Type{static_cast<typename OtherT::ValueType>(value)}; 
+    }
+};
+
+template<typename OtherT, typename T>
+struct QueryOperandOf<OtherT, T, std::enable_if_t<IsQueryOperand<T>::value>>
+{
+    using Type = T;
+    static const Type& make(const T& operand) { return operand; }
+};
+
+template<typename OpT, typename LhsT, typename RhsT>
+inline auto makeCompare(const LhsT& lhs, const RhsT& rhs)
+{
+    using Lhs = QueryOperandOf<RhsT, LhsT>;
+    using Rhs = QueryOperandOf<LhsT, RhsT>;
+    return QueryCompare<typename Lhs::Type, typename Rhs::Type, OpT>{
+        Lhs::make(lhs), Rhs::make(rhs)};
+}
+
+/**
+ * @internal
+ * @brief   Enables the comparison operators if one side is an operand and the other side is an
+ *          operand or a scalar.
+ */
+template<typename LhsT, typename RhsT>
+using EnableQueryCompare = std::enable_if_t<
+    (IsQueryOperand<LhsT>::value && (IsQueryOperand<RhsT>::value 
+        || std::is_arithmetic<RhsT>::value || std::is_enum<RhsT>::value))
+    || (IsQueryOperand<RhsT>::value && (std::is_arithmetic<LhsT>::value 
+        || std::is_enum<LhsT>::value))>;
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [column]                                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Creates a query operand for a field member of a wrapper.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the field.
+ * @param   field       Pointer to the field member, e.g. `&Horse::age`.
+ * @return  The operand, to be compared or used as predicate matching non-zero values.
+ * @note    The field is required to be located at the same offset in every object (as it is the
+ *          case with offset-based fields and `StaticField`s). Fields of arithmetic and 
+ *          enumeration types can be queried.
+ */
+template<typename WrapperT, typename FieldT>
+inline internal::QueryColumn<WrapperT, FieldT> column(FieldT WrapperT::* field)
+{
+    return internal::QueryColumn<WrapperT, FieldT>{field};
+}
+
+#define REMODEL_DEF_QUERY_COMPARE(op, func)                                                        \
+    template<typename LhsT, typename RhsT, typename = internal::EnableQueryCompare<LhsT, RhsT>>    \
+    inline auto operator op (const LhsT& lhs, const RhsT& rhs)                                     \
+    {                                                                                              \
+        return internal::makeCompare<func>(lhs, rhs);                                              \
+    }
+
+REMODEL_DEF_QUERY_COMPARE(==, std::equal_to<>)
+REMODEL_DEF_QUERY_COMPARE(!=, std::not_equal_to<>)
+REMODEL_DEF_QUERY_COMPARE(< , std::less<>)
+REMODEL_DEF_QUERY_COMPARE(<=, std::less_equal<>)
+REMODEL_DEF_QUERY_COMPARE(> , std::greater<>)
+REMODEL_DEF_QUERY_COMPARE(>=, std::greater_equal<>)
+
+#undef REMODEL_DEF_QUERY_COMPARE
+
+template<typename LhsT, typename RhsT, typename = std::enable_if_t<
+    internal::IsQueryExpr<LhsT>::value && internal::IsQueryExpr<RhsT>::value>>
+inline internal::QueryLogic<LhsT, RhsT, true> operator && (const LhsT& lhs, const RhsT& rhs)
+{
+    return {lhs, rhs};
+}
+
+template<typename LhsT, typename RhsT, typename = std::enable_if_t<
+    internal::IsQueryExpr<LhsT>::value && internal::IsQueryExpr<RhsT>::value>>
+inline internal::QueryLogic<LhsT, RhsT, false> operator || (const LhsT& lhs, const RhsT& rhs)
+{
+    return {lhs, rhs};
+}
+
+template<typename ExprT, typename = std::enable_if_t<internal::IsQueryExpr<ExprT>::value>>
+inline internal::QueryNot<ExprT> operator ! (const ExprT& expr)
+{
+    return internal::QueryNot<ExprT>{expr};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [selectRows]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Selects the rows of a span or column cache matching a predicate.
+ * @tparam  SourceT     The source type, `WrapperSpan` or `ColumnCache` of the queried wrapper.
+ * @tparam  PredT       Type of the predicate.
+ * @param   source      The source.
+ * @param   predicate   The predicate.
+ * @param   selection   Receives the indices of the matching rows, in ascending order.
+ * @return  @c true on success, @c false if a queried field isn't mirrored by the column cache.
+ * @note    Row indices are 32 bit for denser selection vectors, sources are required to hold 
+ *          less than 2^32 rows.
+ */
+template<typename SourceT, typename PredT>
+inline bool selectRows(const SourceT& source, PredT predicate, std::vector<uint32_t>& selection)
+{
+    static_assert(internal::IsQueryExpr<PredT>::value, "not a query predicate");
+    selection.clear();
+    auto count = source.size();
+    if (!count) return true;
+    if (!predicate.bind(source)) return false;
+
+    selection.resize(count);
+    auto out = selection.data();
+    std::size_t selected = 0;
+    uint8_t mask[internal::kQueryBlockSize];
+    for (std::size_t begin = 0; begin < count; begin += internal::kQueryBlockSize)
+    {
+        auto blockSize = std::min(count - begin, internal::kQueryBlockSize);
+        predicate.evaluate(begin, blockSize, mask);
+        for (std::size_t i = 0; i < blockSize; ++i)
+        {
+            // Stores unconditionally and only advances on matches, avoiding the branch.
+            out[selected] = static_cast<uint32_t>(begin + i);
+            selected += mask[i];
+        }
+    }
+    selection.resize(selected);
+    return true;
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_QUERY_HPP
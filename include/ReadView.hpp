@@ -0,0 +1,205 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_READVIEW_HPP
+#define REMODEL_READVIEW_HPP
+
+/**     
+ * @file
+ * @brief Contains read-only views of wrapped objects whose field loads are plain memory reads.
+ *        
+ * Reading a `Field` computes its address through the type-erased getter, an indirect call the 
+ * optimizer can't see through. It has to assume the call changed memory, so a value read twice 
+ * is loaded twice and loops over many objects aren't vectorized. A `ReadView` reads fields at 
+ * offsets known up-front through a `const` pointer instead, so loads can be combined, hoisted 
+ * and vectorized like loads from a native struct.
+ *
+ * @code
+ *      // Offset-based fields are resolved once, static offsets need no resolution at all.
+ *      auto health = readField(&Entity::health, firstEntity);
+ *      
+ *      float total = 0.f;
+ *      for (std::size_t i = 0; i < count; ++i)
+ *      {
+ *          ReadView<Entity> entity{entities + i * Entity::kObjSize};
+ *          if (entity[Entity::alive]) total += entity[health];
+ *      }
+ * @endcode
+ * 
+ * Views never write and don't observe concurrent writes reliably. Use them while the target is
+ * paused or on data that doesn't change, e.g. snapshots.
+ */
+
+#include "Remodel.hpp"
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [ReadField]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A field at an offset resolved once, read through `ReadView`s.
+ * @tparam  WrapperT    Type of the wrapper declaring the field.
+ * @tparam  T           The type of the field.
+ */
+template<typename WrapperT, typename T>
+class ReadField
+{
+    std::ptrdiff_t m_offs;
+public:
+    using Type = T;
+
+    /**
+     * @brief   Constructor.
+     * @param   offs    The offset of the field inside of the objects, in bytes.
+     */
+    constexpr explicit ReadField(std::ptrdiff_t offs)
+        : m_offs{offs}
+    {}
+
+    /**
+     * @brief   Gets the offset of the field inside of the objects, in bytes.
+     */
+    constexpr std::ptrdiff_t offset() const { return m_offs; }
+};
+
+/**
+ * @brief   Resolves the offset of a field member of a wrapper for reads through `ReadView`s.
+ * @param   field   Pointer to the field member, e.g. `&Entity::health`.
+ * @param   sample  A wrapper of any object of the type.
+ * @return  The resolved field.
+ * @note    The field is required to be located at the same offset in every object (as it is the
+ *          case with offset-based fields and `StaticField`s).
+ */
+template<typename WrapperT, typename FieldT>
+inline ReadField<WrapperT, typename FieldT::RewrittenT> readField(FieldT WrapperT::* field, 
+    const WrapperT& sample)
+{
+    auto& wrapper = const_cast<WrapperT&>(sample);
+    return ReadField<WrapperT, typename FieldT::RewrittenT>{
+        reinterpret_cast<const uint8_t*>((wrapper.*field).addressOfObj()) 
+            - static_cast<const uint8_t*>(wrapper.addressOfObj())};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [ReadView]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Read-only view of a wrapped object, reading fields as plain memory loads.
+ * @tparam  WrapperT    Type of the wrapper of the object.
+ *                      
+ * Views consist of nothing but the object pointer and are meant to be created on the fly. 
+ * Fields are selected by `FieldDesc`s, `StaticField` members or `ReadField`s.
+ */
+template<typename WrapperT>
+class ReadView
+{
+    const uint8_t* m_raw;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   raw The raw pointer of the object.
+     */
+    explicit ReadView(const void* raw)
+        : m_raw{static_cast<const uint8_t*>(raw)}
+    {}
+
+    /**
+     * @brief   Creates a view of the object of a wrapper.
+     * @param   wrapper The wrapper.
+     */
+    explicit ReadView(const WrapperT& wrapper)
+        : ReadView{wrapper.addressOfObj()}
+    {}
+
+    /**
+     * @brief   Reads a field described by a `FieldDesc`.
+     * @param   desc    The field descriptor.
+     * @return  A constant reference to the field.
+     */
+    template<typename T, std::ptrdiff_t offsT>
+    const typename FieldDesc<T, offsT>::Type& operator [] (FieldDesc<T, offsT> /*desc*/) const
+    {
+        return FieldDesc<T, offsT>::get(static_cast<const void*>(m_raw));
+    }
+
+    /**
+     * @brief   Reads a `StaticField` member.
+     * @param   field   Pointer to the field member, e.g. `&Entity::alive`.
+     * @return  A constant reference to the field.
+     */
+    template<typename T, std::ptrdiff_t offsT>
+    const typename FieldDesc<T, offsT>::Type& operator [] (
+        StaticField<T, offsT> WrapperT::* /*field*/) const
+    {
+        return FieldDesc<T, offsT>::get(static_cast<const void*>(m_raw));
+    }
+
+    /**
+     * @brief   Reads a field resolved using `readField`.
+     * @param   field   The field.
+     * @return  A constant reference to the field.
+     */
+    template<typename T>
+    const T& operator [] (const ReadField<WrapperT, T>& field) const
+    {
+        return *reinterpret_cast<const T*>(m_raw + field.offset());
+    }
+
+    /**
+     * @brief   Obtains a raw pointer to the object.
+     * @return  The pointer.
+     */
+    const void* addressOfObj() const { return m_raw; }
+};
+
+/**
+ * @brief   Creates a read-only view of the object of a wrapper.
+ * @param   wrapper The wrapper.
+ * @return  The view.
+ */
+template<typename WrapperT>
+inline ReadView<WrapperT> readView(const WrapperT& wrapper)
+{
+    return ReadView<WrapperT>{wrapper};
+}
+
+/**
+ * @brief   Creates a read-only view of an object referenced by a weak wrapper.
+ * @param   weak    The weak wrapper.
+ * @return  The view.
+ */
+template<typename WrapperT>
+inline ReadView<WrapperT> readView(WeakWrapper<WrapperT>* weak)
+{
+    return ReadView<WrapperT>{static_cast<const void*>(weak)};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_READVIEW_HPP
@@ -0,0 +1,948 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_RECORDING_HPP
+#define REMODEL_RECORDING_HPP
+
+/**
+ * @file
+ * @brief Contains recording of object state into compressed delta streams.
+ *
+ * A `StateRecorder` copies registered objects into a queue on every `capture`, which is all the
+ * recording thread pays for. A background thread compares every object with its state in the
+ * previous recorded frame using the SIMD kernels of Diff.hpp, encodes the changed byte ranges
+ * and compresses the frame into the file. Frames are recorded in full every few frames, so
+ * players can start at any keyframe.
+ *
+ * @code
+ *      StateRecorder recorder{"session.rec"};
+ *      recorder.add(world);
+ *      recorder.add(players.data(), players.size() * sizeof(players[0]));
+ *      recorder.start();
+ *
+ *      // Every tick, on the game thread:
+ *      recorder.capture(tick);
+ *
+ *      // Later:
+ *      StateReplay replay;
+ *      if (replay.open("session.rec"))
+ *      {
+ *          while (replay.next()) inspect(replay.tick(), wrapper_cast<World>(replay.object(0)));
+ *      }
+ * @endcode
+ *
+ * The file is a `RecordingFileHeader` followed by the sizes of the objects as 64 bit integers
+ * and the frames, each a `RecordingFrameHeader` followed by the frame compressed in the LZ4 block
+ * format. A decompressed frame holds the tick and a flags byte, followed by the changed objects:
+ * the distance to the previous changed object plus one, then `(skip, copy)` pairs of byte
+ * counts, each followed by `copy` new bytes and terminated by a zero copy. A zero distance ends
+ * the frame. All integers in frames are LEB128 encoded. The byte order is native.
+ *
+ * Queued frames are dropped (and counted) while the background thread falls behind, deltas are 
+ * always relative to the previous recorded frame.
+ */
+
+#include "Diff.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace remodel
+{
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Varint]                                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Appends an unsigned LEB128 integer.
+ */
+inline void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @internal
+ * @brief   Reads an unsigned LEB128 integer.
+ * @param   cur     The position, advanced past the integer.
+ * @param   end     The end of the input.
+ * @param   value   Receives the integer.
+ * @return  @c true on success, @c false if truncated or too long.
+ */
+inline bool getVarint(const uint8_t*& cur, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; cur != end && shift < 64; shift += 7)
+    {
+        auto byte = *cur++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [LZ4 blocks]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/// The number of entries of the match finder's hash table.
+const std::size_t kLzHashSize = 1 << 12;
+
+/**
+ * @internal
+ * @brief   Gets the maximum compressed size of a block.
+ */
+inline std::size_t lzBound(std::size_t size) { return size + size / 255 + 16; }
+
+/**
+ * @internal
+ * @brief   Compresses a block in the LZ4 block format.
+ * @param   src     The input.
+ * @param   size    The size of the input.
+ * @param   dst     The output, at least `lzBound(size)` bytes.
+ * @param   table   Scratch space of `kLzHashSize` entries.
+ * @return  The compressed size.
+ *
+ * Greedy matching through a single-entry hash table, favouring speed over ratio like the
+ * reference implementation's fast mode.
+ */
+inline std::size_t lzCompress(const uint8_t* src, std::size_t size, uint8_t* dst, uint32_t* table)
+{
+    const std::size_t kMinMatch = 4, kLastLiterals = 5, kMatchLimit = 12;
+
+    auto read32 = [&](std::size_t pos)
+    {
+        uint32_t value;
+        std::memcpy(&value, src + pos, sizeof(value));
+        return value;
+    };
+    auto hash = [&](std::size_t pos) { return (read32(pos) * 2654435761U) >> 20; };
+    auto putLength = [&](uint8_t*& op, std::size_t length)
+    {
+        for (; length >= 255; length -= 255) *op++ = 255;
+        *op++ = static_cast<uint8_t>(length);
+    };
+
+    auto op = dst;
+    auto emit = [&](std::size_t anchor, std::size_t litLen, std::size_t offset, std::size_t len)
+    {
+        auto token = op++;
+        *token = static_cast<uint8_t>((litLen < 15 ? litLen : 15) << 4);
+        if (litLen >= 15) putLength(op, litLen - 15);
+        std::memcpy(op, src + anchor, litLen);
+        op += litLen;
+        if (!len) return;
+        *op++ = static_cast<uint8_t>(offset);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+        len -= kMinMatch;
+        *token |= static_cast<uint8_t>(len < 15 ? len : 15);
+        if (len >= 15) putLength(op, len - 15);
+    };
+
+    std::size_t anchor = 0;
+    if (size > kMatchLimit)
+    {
+        std::fill(table, table + kLzHashSize, 0);
+        for (std::size_t i = 0; i + kMatchLimit < size;)
+        {
+            auto h = hash(i);
+            std::size_t candidate = table[h];
+            table[h] = static_cast<uint32_t>(i);
+            if (candidate >= i || i - candidate > 0xFFFF || read32(candidate) != read32(i))
+            {
+                ++i;
+                continue;
+            }
+
+            auto len = kMinMatch;
+            while (i + len < size - kLastLiterals && src[candidate + len] == src[i + len]) ++len;
+            emit(anchor, i - anchor, i - candidate, len);
+            i += len;
+            anchor = i;
+            table[hash(i - 2)] = static_cast<uint32_t>(i - 2);
+        }
+    }
+    emit(anchor, size - anchor, 0, 0);
+    return static_cast<std::size_t>(op - dst);
+}
+
+/**
+ * @internal
+ * @brief   Decompresses a block in the LZ4 block format.
+ * @param   src     The compressed block.
+ * @param   size    The size of the compressed block.
+ * @param   dst     The output.
+ * @param   rawSize The size of the output.
+ * @return  @c true if the block decompressed to exactly @c rawSize bytes, else @c false.
+ */
+inline bool lzDecompress(const uint8_t* src, std::size_t size, uint8_t* dst, std::size_t rawSize)
+{
+    auto ip = src, ipEnd = src + size;
+    auto op = dst, opEnd = dst + rawSize;
+    auto getLength = [&](std::size_t& length)
+    {
+        if (length != 15) return true;
+        for (;;)
+        {
+            if (ip == ipEnd) return false;
+            auto byte = *ip++;
+            length += byte;
+            if (byte != 255) return true;
+        }
+    };
+
+    while (ip != ipEnd)
+    {
+        auto token = *ip++;
+        std::size_t litLen = token >> 4;
+        if (!getLength(litLen) || litLen > static_cast<std::size_t>(ipEnd - ip) 
+            || litLen > static_cast<std::size_t>(opEnd - op))
+        {
+            return false;
+        }
+        std::memcpy(op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+        if (ip == ipEnd) break;
+
+        if (ipEnd - ip < 2) return false;
+        std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        std::size_t len = token & 15;
+        if (!offset || offset > static_cast<std::size_t>(op - dst) || !getLength(len)) 
+        {
+            return false;
+        }
+        len += 4;
+        if (len > static_cast<std::size_t>(opEnd - op)) return false;
+        for (auto match = op - offset; len; --len) *op++ = *match++;
+    }
+    return op == opEnd;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [Object deltas]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Finds the next bit of a value at or after a position in a bitmap.
+ * @param   bits    The bitmap.
+ * @param   pos     The first bit to consider.
+ * @param   size    The number of bits.
+ * @param   set     The value to find.
+ * @return  The position, @c size if none.
+ */
+inline std::size_t findBit(const uint64_t* bits, std::size_t pos, std::size_t size, bool set)
+{
+    while (pos < size)
+    {
+        auto word = (set ? bits[pos / 64] : ~bits[pos / 64]) >> (pos % 64);
+        if (!word)
+        {
+            pos = (pos / 64 + 1) * 64;
+            continue;
+        }
+        for (; !(word & 1); word >>= 1) ++pos;
+        break;
+    }
+    return pos < size ? pos : size;
+}
+
+/**
+ * @internal
+ * @brief   Appends the changed byte ranges of an object, as `(skip, copy)` pairs and new bytes.
+ * @param   out     The output.
+ * @param   prev    The previous state.
+ * @param   cur     The current state.
+ * @param   mask    @c 0xFF bytes, at least @c size.
+ * @param   bits    Scratch space for `(size + 63) / 64` words.
+ * @param   size    The size of the object.
+ * @return  @c true if anything changed and was appended, else @c false.
+ *
+ * Ranges separated by fewer unchanged bytes than their encoding takes are merged.
+ */
+inline bool appendObjectDelta(std::vector<uint8_t>& out, const uint8_t* prev, const uint8_t* cur,
+    const uint8_t* mask, uint64_t* bits, std::size_t size)
+{
+    const std::size_t kMergeGap = 4;
+    if (!diffBytes(prev, cur, mask, size, bits)) return false;
+
+    std::size_t pos = 0;
+    for (;;)
+    {
+        auto first = findBit(bits, pos, size, true);
+        if (first == size) break;
+        auto last = findBit(bits, first, size, false);
+        while (last < size)
+        {
+            auto next = findBit(bits, last, size, true);
+            if (next == size || next - last > kMergeGap) break;
+            last = findBit(bits, next, size, false);
+        }
+        putVarint(out, first - pos);
+        putVarint(out, last - first);
+        out.insert(out.end(), cur + first, cur + last);
+        pos = last;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [Frames]                                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/// The flag of keyframes, in the flags byte of a frame.
+const uint8_t kFrameFlagKeyframe = 1;
+
+/**
+ * @internal
+ * @brief   Single-producer single-consumer queue of captured frames of equal size.
+ */
+class FrameQueue
+{
+public:
+    /**
+     * @brief   Allocates the slots, while neither side is running.
+     * @param   depth       The number of slots.
+     * @param   frameSize   The size of a frame, in bytes.
+     */
+    void reset(std::size_t depth, std::size_t frameSize)
+    {
+        m_depth = depth ? depth : 1;
+        m_frameSize = frameSize;
+        m_frames.assign(m_depth * frameSize, 0);
+        m_ticks.assign(m_depth, 0);
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_cachedTail = 0;
+    }
+
+    /**
+     * @brief   Gets the next free slot, called by the producer.
+     * @return  The slot or @c nullptr if the queue is full.
+     */
+    uint8_t* acquire()
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail >= m_depth)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail >= m_depth) return nullptr;
+        }
+        return m_frames.data() + head % m_depth * m_frameSize;
+    }
+
+    /**
+     * @brief   Publishes the slot returned by `acquire`, called by the producer.
+     * @param   tick    The tick of the frame.
+     */
+    void commit(uint64_t tick)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        m_ticks[head % m_depth] = tick;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Removes all published frames, called by the consumer.
+     * @param   func    Invoked with each frame and its tick, in order.
+     * @return  The number of frames.
+     */
+    template<typename FuncT>
+    std::size_t consume(FuncT func)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto head = m_head.load(std::memory_order_acquire);
+        for (auto cur = tail; cur != head; ++cur)
+        {
+            func(static_cast<const uint8_t*>(m_frames.data() + cur % m_depth * m_frameSize), 
+                m_ticks[cur % m_depth]);
+            m_tail.store(cur + 1, std::memory_order_release);
+        }
+        return static_cast<std::size_t>(head - tail);
+    }
+private:
+    // Written by the producer.
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    uint64_t m_cachedTail = 0;
+
+    // Written by the consumer.
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+
+    std::size_t m_depth = 1;
+    std::size_t m_frameSize = 0;
+    std::vector<uint8_t> m_frames;
+    std::vector<uint64_t> m_ticks;
+};
+
+/**
+ * @internal
+ * @brief   Encodes frames of a set of objects as changes to the previously encoded frame.
+ */
+class FrameEncoder
+{
+public:
+    /**
+     * @brief   Sets the objects, stored back to back in frames.
+     * @param   sizes   The sizes of the objects.
+     */
+    void reset(const std::vector<std::size_t>& sizes)
+    {
+        m_sizes = sizes;
+        std::size_t frameSize = 0, maxSize = 0;
+        for (auto size : sizes)
+        {
+            frameSize += size;
+            maxSize = std::max(maxSize, size);
+        }
+        m_previous.assign(frameSize, 0);
+        m_mask.assign(maxSize, 0xFF);
+        m_bits.resize((maxSize + 63) / 64);
+    }
+
+    /**
+     * @brief   Encodes a frame, which becomes the base of the next delta.
+     * @param   frame       The objects.
+     * @param   tick        The tick of the frame.
+     * @param   keyframe    Whether to encode the objects in full.
+     * @return  The encoded frame, valid until the next call.
+     */
+    const std::vector<uint8_t>& encode(const uint8_t* frame, uint64_t tick, bool keyframe)
+    {
+        m_raw.clear();
+        putVarint(m_raw, tick);
+        m_raw.push_back(keyframe ? kFrameFlagKeyframe : 0);
+
+        std::size_t next = 0, offset = 0;
+        for (std::size_t i = 0; i < m_sizes.size(); offset += m_sizes[i++])
+        {
+            auto size = m_sizes[i];
+            auto cur  = frame + offset;
+            auto mark = m_raw.size();
+            putVarint(m_raw, i - next + 1);
+            if (keyframe)
+            {
+                putVarint(m_raw, 0);
+                putVarint(m_raw, size);
+                m_raw.insert(m_raw.end(), cur, cur + size);
+            }
+            else if (!appendObjectDelta(m_raw, m_previous.data() + offset, cur, m_mask.data(), 
+                m_bits.data(), size))
+            {
+                m_raw.resize(mark);
+                continue;
+            }
+            putVarint(m_raw, 0);
+            putVarint(m_raw, 0);
+            next = i + 1;
+        }
+        putVarint(m_raw, 0);
+        if (frame != m_previous.data()) std::memcpy(m_previous.data(), frame, m_previous.size());
+        return m_raw;
+    }
+
+    /**
+     * @brief   Gets the last encoded frame.
+     */
+    const uint8_t* previous() const { return m_previous.data(); }
+
+    /**
+     * @brief   Gets the size of a frame, in bytes.
+     */
+    std::size_t frameSize() const { return m_previous.size(); }
+private:
+    std::vector<std::size_t> m_sizes;
+    std::vector<uint8_t> m_previous;
+    std::vector<uint8_t> m_mask;
+    std::vector<uint64_t> m_bits;
+    std::vector<uint8_t> m_raw;
+};
+
+/**
+ * @internal
+ * @brief   Applies encoded frames to the state of a set of objects.
+ */
+class FrameDecoder
+{
+public:
+    /**
+     * @brief   Sets the objects and zeroes their state.
+     * @param   sizes   The sizes of the objects.
+     */
+    void reset(const std::vector<std::size_t>& sizes)
+    {
+        m_offsets.clear();
+        std::size_t offset = 0;
+        for (auto size : sizes)
+        {
+            m_offsets.push_back(offset);
+            offset += size;
+        }
+        m_offsets.push_back(offset);
+        m_state.assign(offset, 0);
+        m_tick = 0;
+        m_keyframe = false;
+    }
+
+    /**
+     * @brief   Applies an encoded frame.
+     * @param   cur     The frame.
+     * @param   end     The end of the frame.
+     * @return  @c true on success, @c false for corrupt frames, which may be partially applied.
+     */
+    bool apply(const uint8_t* cur, const uint8_t* end)
+    {
+        uint64_t tick, distance;
+        if (!getVarint(cur, end, tick) || cur == end) return false;
+        m_tick = tick;
+        m_keyframe = (*cur++ & kFrameFlagKeyframe) != 0;
+
+        std::size_t next = 0;
+        for (;;)
+        {
+            if (!getVarint(cur, end, distance)) return false;
+            if (!distance) return true;
+            if (distance > count() - next) return false;
+            auto idx = next + static_cast<std::size_t>(distance) - 1;
+            next = idx + 1;
+
+            auto dst = object(idx);
+            std::size_t pos = 0, size = objectSize(idx);
+            for (;;)
+            {
+                uint64_t skip, copy;
+                if (!getVarint(cur, end, skip) || !getVarint(cur, end, copy)
+                    || skip > size - pos || copy > size - pos - skip
+                    || copy > static_cast<uint64_t>(end - cur))
+                {
+                    return false;
+                }
+                if (!copy) break;
+                pos += static_cast<std::size_t>(skip);
+                std::memcpy(dst + pos, cur, static_cast<std::size_t>(copy));
+                pos += static_cast<std::size_t>(copy);
+                cur += copy;
+            }
+        }
+    }
+
+    std::size_t count() const { return m_offsets.size() - 1; }
+    uint8_t* object(std::size_t idx) { return m_state.data() + m_offsets[idx]; }
+    std::size_t objectSize(std::size_t idx) const { return m_offsets[idx + 1] - m_offsets[idx]; }
+    uint64_t tick() const { return m_tick; }
+    bool isKeyframe() const { return m_keyframe; }
+private:
+    std::vector<std::size_t> m_offsets{0};
+    std::vector<uint8_t> m_state;
+    uint64_t m_tick = 0;
+    bool m_keyframe = false;
+};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [Recording file layout]                                                                        //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The header of a recording file.
+ */
+struct RecordingFileHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t objectCount;
+};
+
+static_assert(sizeof(RecordingFileHeader) == 16, "unexpected padding");
+
+/**
+ * @brief   The header of a recorded frame.
+ */
+struct RecordingFrameHeader
+{
+    uint32_t compressedSize;
+    uint32_t rawSize;
+};
+
+static_assert(sizeof(RecordingFrameHeader) == 8, "unexpected padding");
+
+const char kRecordingFileMagic[8] = {'R', 'M', 'D', 'L', 'R', 'E', 'C', 'D'};
+
+// ---------------------------------------------------------------------------------------------- //
+// [StateRecorder]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Records the state of objects into a delta-encoded, compressed file.
+ *
+ * Objects are registered before `start`. `capture` is called from a single thread and never
+ * blocks: it copies the objects into a free queue slot, or drops the frame if there is none.
+ */
+class StateRecorder
+{
+public:
+    /**
+     * @brief   Constructor, creating the file.
+     * @param   path                The path of the file, replaced if existing.
+     * @param   queueDepth          The number of frames captured ahead of the encoder.
+     * @param   keyframeInterval    The number of recorded frames per keyframe.
+     * @param   interval            The time between encoder wakeups.
+     */
+    explicit StateRecorder(const char* path, std::size_t queueDepth = 16, 
+        std::size_t keyframeInterval = 256, 
+        std::chrono::milliseconds interval = std::chrono::milliseconds{5})
+        : m_file{std::fopen(path, "wb")}
+        , m_queueDepth{queueDepth}
+        , m_keyframeInterval{keyframeInterval ? keyframeInterval : 1}
+        , m_interval{interval}
+        , m_ok{m_file != nullptr}
+    {}
+
+    StateRecorder(const StateRecorder&) = delete;
+    StateRecorder& operator = (const StateRecorder&) = delete;
+
+    /**
+     * @brief   Destructor, stopping the recorder.
+     */
+    ~StateRecorder() { stop(); }
+
+    /**
+     * @brief   Registers an object, before `start`.
+     * @param   object  The object.
+     * @param   size    The size of the object, in bytes.
+     */
+    void add(const void* object, std::size_t size)
+    {
+        m_objects.push_back(static_cast<const uint8_t*>(object));
+        m_sizes.push_back(size);
+    }
+
+    /**
+     * @brief   Registers the object a wrapper points to, before `start`.
+     * @param   wrapper The wrapper, derived from `AdvancedClassWrapper`.
+     */
+    template<typename WrapperT>
+    void add(const WrapperT& wrapper)
+    {
+        add(wrapper.addressOfObj(), WrapperT::kObjSize);
+    }
+
+    /**
+     * @brief   Writes the file header and starts the background thread.
+     * @return  @c true on success, else @c false.
+     */
+    bool start()
+    {
+        if (!m_ok || m_thread.joinable()) return false;
+
+        RecordingFileHeader header{};
+        std::memcpy(header.magic, kRecordingFileMagic, sizeof(header.magic));
+        header.version     = RecordingFileHeader::kVersion;
+        header.objectCount = static_cast<uint32_t>(m_objects.size());
+        m_ok = std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+        for (auto size : m_sizes)
+        {
+            uint64_t size64 = size;
+            m_ok &= std::fwrite(&size64, sizeof(size64), 1, m_file) == 1;
+        }
+        if (!m_ok) return false;
+
+        m_encoder.reset(m_sizes);
+        m_queue.reset(m_queueDepth, m_encoder.frameSize());
+        m_table.resize(internal::kLzHashSize);
+        m_thread = std::thread{[this] { run(); }};
+        m_capturing.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief   Captures the registered objects.
+     * @param   tick    The tick (or time) of the frame, recorded with it.
+     * @return  @c true if queued, @c false if dropped or not started.
+     */
+    bool capture(uint64_t tick)
+    {
+        if (!m_capturing.load(std::memory_order_acquire)) return false;
+
+        auto slot = m_queue.acquire();
+        if (!slot)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            std::memcpy(slot, m_objects[i], m_sizes[i]);
+            slot += m_sizes[i];
+        }
+        m_queue.commit(tick);
+        return true;
+    }
+
+    /**
+     * @brief   Stops the background thread, encodes the queued frames and closes the file.
+     * @return  @c true if all frames were written, else @c false.
+     */
+    bool stop()
+    {
+        m_capturing.store(false, std::memory_order_release);
+        if (m_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_stop = true;
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+        }
+        if (m_file)
+        {
+            encodePending();
+            m_ok &= std::fclose(m_file) == 0;
+            m_file = nullptr;
+        }
+        return m_ok;
+    }
+
+    /**
+     * @brief   Determines whether the file was created and all writes succeeded so far.
+     */
+    bool isOk() const { return m_ok; }
+
+    /**
+     * @brief   Gets the number of frames written.
+     */
+    uint64_t recorded() const { return m_recorded.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the number of frames dropped because the queue was full.
+     */
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the size of the written frames as full snapshots, in bytes.
+     */
+    uint64_t rawBytes() const { return recorded() * m_encoder.frameSize(); }
+
+    /**
+     * @brief   Gets the size of the written frames, in bytes.
+     */
+    uint64_t writtenBytes() const { return m_written.load(std::memory_order_relaxed); }
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        while (!m_stop)
+        {
+            m_wakeup.wait_for(lock, m_interval, [this] { return m_stop; });
+            lock.unlock();
+            encodePending();
+            lock.lock();
+        }
+    }
+
+    void encodePending()
+    {
+        m_queue.consume([this](const uint8_t* frame, uint64_t tick)
+        {
+            const auto& raw = m_encoder.encode(frame, tick, m_sinceKeyframe == 0);
+            m_packed.resize(internal::lzBound(raw.size()));
+            RecordingFrameHeader header;
+            header.compressedSize = static_cast<uint32_t>(
+                internal::lzCompress(raw.data(), raw.size(), m_packed.data(), m_table.data()));
+            header.rawSize = static_cast<uint32_t>(raw.size());
+            m_ok &= std::fwrite(&header, sizeof(header), 1, m_file) == 1
+                && std::fwrite(m_packed.data(), 1, header.compressedSize, m_file) 
+                    == header.compressedSize;
+
+            m_written.fetch_add(sizeof(header) + header.compressedSize, std::memory_order_relaxed);
+            m_recorded.fetch_add(1, std::memory_order_relaxed);
+            if (++m_sinceKeyframe == m_keyframeInterval) m_sinceKeyframe = 0;
+        });
+    }
+private:
+    std::FILE* m_file;
+    std::size_t m_queueDepth;
+    std::size_t m_keyframeInterval;
+    std::chrono::milliseconds m_interval;
+    bool m_ok;
+    bool m_stop = false;
+    std::vector<const uint8_t*> m_objects;
+    std::vector<std::size_t> m_sizes;
+    std::atomic<bool> m_capturing{false};
+    std::atomic<uint64_t> m_dropped{0};
+    internal::FrameQueue m_queue;
+
+    // Used by the encoder.
+    internal::FrameEncoder m_encoder;
+    std::atomic<uint64_t> m_recorded{0};
+    std::atomic<uint64_t> m_written{0};
+    std::size_t m_sinceKeyframe = 0;
+    std::vector<uint8_t> m_packed;
+    std::vector<uint32_t> m_table;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::thread m_thread;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [StateReplay]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Reconstructs the recorded state of objects, frame by frame.
+ *
+ * Objects are zero until the first keyframe.
+ */
+class StateReplay
+{
+public:
+    StateReplay() = default;
+    StateReplay(const StateReplay&) = delete;
+    StateReplay& operator = (const StateReplay&) = delete;
+
+    /**
+     * @brief   Destructor, closing the file.
+     */
+    ~StateReplay() { close(); }
+
+    /**
+     * @brief   Opens a recording.
+     * @param   path    The path of the file.
+     * @return  @c true on success, else @c false.
+     */
+    bool open(const char* path)
+    {
+        close();
+        m_file = std::fopen(path, "rb");
+        if (!m_file) return false;
+
+        RecordingFileHeader header;
+        if (std::fread(&header, sizeof(header), 1, m_file) != 1
+            || std::memcmp(header.magic, kRecordingFileMagic, sizeof(header.magic))
+            || header.version != RecordingFileHeader::kVersion)
+        {
+            close();
+            return false;
+        }
+
+        std::vector<std::size_t> sizes;
+        for (uint32_t i = 0; i < header.objectCount; ++i)
+        {
+            uint64_t size;
+            if (std::fread(&size, sizeof(size), 1, m_file) != 1)
+            {
+                close();
+                return false;
+            }
+            sizes.push_back(static_cast<std::size_t>(size));
+        }
+        m_decoder.reset(sizes);
+        return true;
+    }
+
+    /**
+     * @brief   Closes the recording.
+     */
+    void close()
+    {
+        if (m_file) std::fclose(m_file);
+        m_file = nullptr;
+        m_decoder.reset({});
+    }
+
+    /**
+     * @brief   Applies the next frame.
+     * @return  @c true on success, @c false at the end of the file or for corrupt frames.
+     */
+    bool next()
+    {
+        RecordingFrameHeader header;
+        if (!m_file || std::fread(&header, sizeof(header), 1, m_file) != 1) return false;
+        m_packed.resize(header.compressedSize);
+        m_raw.resize(header.rawSize);
+        return std::fread(m_packed.data(), 1, m_packed.size(), m_file) == m_packed.size()
+            && internal::lzDecompress(m_packed.data(), m_packed.size(), m_raw.data(), m_raw.size())
+            && m_decoder.apply(m_raw.data(), m_raw.data() + m_raw.size());
+    }
+
+    /**
+     * @brief   Gets the number of recorded objects.
+     */
+    std::size_t objectCount() const { return m_decoder.count(); }
+
+    /**
+     * @brief   Gets the state of an object in the current frame.
+     * @param   idx The index of the object, in the order of registration.
+     */
+    void* object(std::size_t idx) { return m_decoder.object(idx); }
+
+    /**
+     * @brief   Gets the size of an object.
+     * @param   idx The index of the object, in the order of registration.
+     */
+    std::size_t objectSize(std::size_t idx) const { return m_decoder.objectSize(idx); }
+
+    /**
+     * @brief   Gets the tick of the current frame.
+     */
+    uint64_t tick() const { return m_decoder.tick(); }
+
+    /**
+     * @brief   Determines whether the current frame is a keyframe.
+     */
+    bool isKeyframe() const { return m_decoder.isKeyframe(); }
+private:
+    std::FILE* m_file = nullptr;
+    internal::FrameDecoder m_decoder;
+    std::vector<uint8_t> m_raw;
+    std::vector<uint8_t> m_packed;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_RECORDING_HPP
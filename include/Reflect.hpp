@@ -0,0 +1,346 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_REFLECT_HPP
+#define REMODEL_REFLECT_HPP
+
+/**     
+ * @file
+ * @brief Contains opt-in compile-time reflection of the fields of wrappers.
+ *        
+ * Wrappers list their fields with `REMODEL_REFLECT`. Generic tools then iterate over them with
+ * `forEachField`, which unrolls into one call per field at compile time, each receiving a 
+ * `ReflectedField` describing the name, value type, size and (for `StaticField`s) offset as
+ * constants.
+ *
+ * @code
+ *      class Horse : public AdvancedClassWrapper<0x20>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Horse)
+ *      public:
+ *          StaticField<int,   0x10> speed{this};
+ *          StaticField<float, 0x14> weight{this};
+ *          REMODEL_REFLECT(&Horse::speed, &Horse::weight)
+ *      };
+ *      
+ *      forEachField(horse, [](auto info, auto& field)
+ *      {
+ *          typename decltype(info)::Type value = field;
+ *          std::cout << decltype(info)::name() << " = " << value << '\n';
+ *      });
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [REMODEL_REFLECT]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Declares the reflected fields of a wrapper.
+ * @param   ... Pointers to the field members, e.g. `&Horse::speed`. The names are taken from the
+ *              member names.
+ *              
+ * Intended to be used inside of wrapper declarations, after the fields.
+ */
+#define REMODEL_REFLECT(...)                                                                       \
+    public:                                                                                        \
+        static constexpr auto reflectMembers() { return std::make_tuple(__VA_ARGS__); }            \
+        static constexpr const char* reflectNames() { return #__VA_ARGS__; }                       \
+    private:
+
+namespace internal
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [ReflectedName]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   A range of the stringified member pointer list of `REMODEL_REFLECT`.
+ */
+struct ReflectNameRange
+{
+    std::size_t begin;
+    std::size_t size;
+};
+
+/**
+ * @internal
+ * @brief   Finds the member name of an entry of the stringified member pointer list.
+ * @param   list    The list, e.g. `"&Horse::speed, &Horse::weight"`.
+ * @param   idx     The index of the entry.
+ * @return  The range of the name, following the last `::` (or `&`) of the entry.
+ */
+constexpr ReflectNameRange findReflectName(const char* list, std::size_t idx)
+{
+    std::size_t pos = 0;
+    for (; idx; ++pos) if (list[pos] == ',') --idx;
+
+    std::size_t begin = pos;
+    std::size_t end   = pos;
+    for (; list[pos] && list[pos] != ','; ++pos)
+    {
+        auto c = list[pos];
+        bool isIdent = c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') 
+            || (c >= '0' && c <= '9');
+        if (!isIdent) continue;
+        // Starts a new identifier if the previous character wasn't part of one.
+        if (end != pos) begin = pos;
+        end = pos + 1;
+    }
+    return {begin, end - begin};
+}
+
+/**
+ * @internal
+ * @brief   Null-terminated string of a size known at compile time.
+ */
+template<std::size_t sizeT>
+struct ReflectString
+{
+    char data[sizeT + 1];
+};
+
+/**
+ * @internal
+ * @brief   Storage of the null-terminated name of a reflected field.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  idxT        The index of the field.
+ */
+template<typename WrapperT, std::size_t idxT>
+struct ReflectedName
+{
+    static constexpr ReflectNameRange kRange = findReflectName(WrapperT::reflectNames(), idxT);
+
+    static constexpr ReflectString<kRange.size> make()
+    {
+        ReflectString<kRange.size> result{};
+        for (std::size_t i = 0; i < kRange.size; ++i) 
+        {
+            result.data[i] = WrapperT::reflectNames()[kRange.begin + i];
+        }
+        return result;
+    }
+
+    static constexpr ReflectString<kRange.size> kName = make();
+};
+
+template<typename WrapperT, std::size_t idxT>
+constexpr ReflectNameRange ReflectedName<WrapperT, idxT>::kRange;
+
+template<typename WrapperT, std::size_t idxT>
+constexpr ReflectString<ReflectedName<WrapperT, idxT>::kRange.size> 
+    ReflectedName<WrapperT, idxT>::kName;
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldStaticOffset]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Obtains the compile-time offset of a field, -1 if it has none.
+ */
+template<typename FieldT, typename = void>
+struct FieldStaticOffset : std::integral_constant<std::ptrdiff_t, -1> {};
+
+template<typename FieldT>
+struct FieldStaticOffset<FieldT, decltype(void(FieldT::kOffs))> 
+    : std::integral_constant<std::ptrdiff_t, FieldT::kOffs> {};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [ReflectedField]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Compile-time description of a reflected field.
+ * @tparam  WrapperT    Type of the wrapper, declaring its fields using `REMODEL_REFLECT`.
+ * @tparam  idxT        The index of the field in the `REMODEL_REFLECT` list.
+ *          
+ * Instances are empty, all information is exposed as static members for use in generic code.
+ */
+template<typename WrapperT, std::size_t idxT>
+struct ReflectedField
+{
+private:
+    using Members = decltype(WrapperT::reflectMembers());
+    using MemberPtr = std::tuple_element_t<idxT, Members>;
+
+    template<typename MemberPtrT>
+    struct FieldOf;
+
+    template<typename FieldT>
+    struct FieldOf<FieldT WrapperT::*> { using Type = FieldT; };
+public:
+    using Wrapper = WrapperT;
+    /// The type of the field member, e.g. `StaticField<int, 0x10>`.
+    using FieldType = typename FieldOf<MemberPtr>::Type;
+    /// The type of the value the field represents.
+    using Type = typename FieldType::RewrittenT;
+
+    /// The index of the field.
+    static const std::size_t kIndex = idxT;
+    /// The size of the represented value, in bytes.
+    static const std::size_t kSize = sizeof(Type);
+    /// Whether the field is located at a compile-time offset.
+    static const bool kHasStaticOffset = internal::FieldStaticOffset<FieldType>::value >= 0;
+    /// The offset in the wrapped object for `StaticField`s, else -1.
+    static const std::ptrdiff_t kOffset = internal::FieldStaticOffset<FieldType>::value;
+
+    /**
+     * @brief   Gets the name of the field member.
+     * @return  The null-terminated name.
+     */
+    static constexpr const char* name() 
+    { 
+        return internal::ReflectedName<WrapperT, idxT>::kName.data; 
+    }
+
+    /**
+     * @brief   Gets the length of the name of the field member.
+     * @return  The length, in characters.
+     */
+    static constexpr std::size_t nameLength()
+    {
+        return internal::ReflectedName<WrapperT, idxT>::kRange.size;
+    }
+
+    /**
+     * @brief   Gets the pointer to the field member.
+     * @return  The member pointer.
+     */
+    static constexpr MemberPtr member() { return std::get<idxT>(WrapperT::reflectMembers()); }
+
+    /**
+     * @brief   Gets the field of a wrapper.
+     * @param   wrapper The wrapper.
+     * @return  The field.
+     */
+    static FieldType& of(WrapperT& wrapper) { return wrapper.*member(); }
+
+    /**
+     * @copydoc of
+     */
+    static const FieldType& of(const WrapperT& wrapper) { return wrapper.*member(); }
+
+    /**
+     * @brief   Calculates the offset of the field in the object wrapped by a wrapper.
+     * @param   wrapper The wrapper.
+     * @return  The offset, in bytes.
+     *          
+     * Equal to `kOffset` for `StaticField`s, else the field's `PtrGetter` is evaluated.
+     */
+    static std::ptrdiff_t offsetIn(WrapperT& wrapper)
+    {
+        return static_cast<const uint8_t*>(addressOfObj(wrapper.*member()))
+            - static_cast<const uint8_t*>(addressOfObj(wrapper));
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [forEachField]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Determines whether a wrapper declares its fields using `REMODEL_REFLECT`.
+ * @tparam  WrapperT    Type of the wrapper.
+ */
+template<typename WrapperT, typename = void>
+struct IsReflected : std::false_type {};
+
+template<typename WrapperT>
+struct IsReflected<WrapperT, decltype(void(WrapperT::reflectMembers()))> : std::true_type {};
+
+/**
+ * @brief   Gets the number of reflected fields of a wrapper.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @return  The number of fields.
+ */
+template<typename WrapperT>
+constexpr std::size_t reflectedFieldCount()
+{
+    static_assert(IsReflected<WrapperT>::value, "wrapper doesn't use REMODEL_REFLECT");
+    return std::tuple_size<decltype(WrapperT::reflectMembers())>::value;
+}
+
+namespace internal
+{
+
+template<typename WrapperT, typename FuncT, std::size_t... idxs>
+inline void forEachFieldInfo(FuncT& func, std::index_sequence<idxs...>)
+{
+    (void)std::initializer_list<int>{(func(ReflectedField<WrapperT, idxs>{}), 0)...};
+}
+
+template<typename WrapperT, typename FuncT, std::size_t... idxs>
+inline void forEachFieldOf(WrapperT& wrapper, FuncT& func, std::index_sequence<idxs...>)
+{
+    (void)std::initializer_list<int>{(func(ReflectedField<std::remove_const_t<WrapperT>, idxs>{}, 
+        ReflectedField<std::remove_const_t<WrapperT>, idxs>::of(wrapper)), 0)...};
+}
+
+} // namespace internal
+
+/**
+ * @brief   Calls a function for every reflected field of a wrapper type.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @param   func        The function, called with a `ReflectedField` in declaration order.
+ *                      The calls are unrolled, so generic lambdas see every field's types.
+ */
+template<typename WrapperT, typename FuncT>
+inline void forEachField(FuncT&& func)
+{
+    internal::forEachFieldInfo<WrapperT>(func, 
+        std::make_index_sequence<reflectedFieldCount<WrapperT>()>{});
+}
+
+/**
+ * @brief   Calls a function for every reflected field of a wrapper.
+ * @param   wrapper     The wrapper.
+ * @param   func        The function, called with a `ReflectedField` and the field itself in 
+ *                      declaration order.
+ */
+template<typename WrapperT, typename FuncT>
+inline void forEachField(WrapperT& wrapper, FuncT&& func)
+{
+    internal::forEachFieldOf(wrapper, func, 
+        std::make_index_sequence<reflectedFieldCount<std::remove_const_t<WrapperT>>()>{});
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_REFLECT_HPP
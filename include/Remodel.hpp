@@ -171,6 +171,82 @@
 ///         return 0;
 ///     }
 /// @endcode
+/// `Instantiable`s hold the complete wrapper next to the object. When keeping many objects 
+/// around, use `Compact` instead, which is no larger than the object itself and creates wrappers 
+/// on demand via `wrapper()`.
+///
+/// @subsection static_fields Fields with compile-time offsets
+/// `Field` stores a type-erased `PtrGetter` that is invoked on every access. When the offset of a
+/// field is known at compile-time (which is the case for the vast majority of fields), 
+/// `StaticField` can be used instead. Accesses then compile down to a plain `base + offset` load 
+/// or store, which pays off when reading fields of thousands of objects in hot loops.
+/// @code
+///     class Cat : public AdvancedClassWrapper<6>
+///     {
+///        REMODEL_ADV_WRAPPER(Cat)
+///     public:
+///        StaticField<uint8_t, 0> age{this};
+///        StaticField<Flea*,   2> fleas{this};
+///     };
+/// @endcode
+///
+/// @subsection field_descs Zero-storage field descriptors
+/// Every `Field` member is constructed along with its wrapper. For wrappers with many fields, 
+/// declaring the fields as `static constexpr` `FieldDesc` members instead makes the wrapper a 
+/// single pointer and `wrapper_cast` essentially free. Fields are then accessed using `->*`.
+/// @code
+///     class Cat : public AdvancedClassWrapper<6>
+///     {
+///        REMODEL_ADV_WRAPPER(Cat)
+///     public:
+///        static constexpr FieldDesc<uint8_t, 0> age{};
+///        static constexpr FieldDesc<Flea*,   2> fleas{};
+///     };
+///
+///     auto cat = wrapper_cast<Cat>(catPtr);
+///     cat->*Cat::age += 1;
+/// @endcode
+///
+/// @subsection shared_getters Shared getters
+/// Fields that cannot use compile-time offsets (e.g. when using custom `PtrGetter`s) can still 
+/// avoid constructing a getter with every wrapper. `REMODEL_SHARED_GETTER` builds the getter
+/// once, on creation of the first wrapper, and `SharedField` refers to it from then on.
+/// @code
+///     class Cat : public AdvancedClassWrapper<6>
+///     {
+///        REMODEL_ADV_WRAPPER(Cat)
+///     public:
+///        SharedField<uint8_t> age{this, REMODEL_SHARED_GETTER(OffsGetter{0})};
+///     };
+/// @endcode
+///
+/// @subsection inline_getters Inline getter types
+/// The type-erased default `PtrGetter` of `Field`, `Function` and `MemberFunction` may allocate 
+/// for larger callables and can't be inlined. Passing the getter type as template argument 
+/// stores the getter within the field instead, stateless getters taking no space at all.
+/// @code
+///     const auto kLegs = [](void* raw) -> void* { return *static_cast<uint8_t**>(raw) + 8; };
+///
+///     class Cat : public AdvancedClassWrapper<6>
+///     {
+///        REMODEL_ADV_WRAPPER(Cat)
+///     public:
+///        Field<uint8_t, decltype(kLegs)> legs{this, kLegs};
+///     };
+/// @endcode
+///
+/// To share the getters of all fields and functions of a wrapper, a table built on first use can
+/// be declared using `REMODEL_GETTER_TABLE`:
+/// @code
+///     class Dog : public ClassWrapper
+///     {
+///        REMODEL_WRAPPER(Dog)
+///        REMODEL_GETTER_TABLE(getters, OffsGetter{124}, VfTableGetter{1})
+///     public:
+///        SharedField<uint8_t> age{this, getters()[0]};
+///        MemberFunction<void (*)(int), SharedGetter> giveGoodie{this, getters()[1]};
+///     };
+/// @endcode
 ///
 /// @subsection cust_cdtors Custom con and destructors
 ///
@@ -273,24 +349,267 @@
 /// a pointer to a wrapped entity to a function or receive one in a callback without using `void*`
 /// everywhere, thus keeping your code type-safe. You can create a strong wrapper from a weak one
 /// via `myWeakWrapper.toStrong()`.
+/// 
+/// @section concurrency Concurrency
+/// Wrappers are plain objects pointing at the wrapped object, `wrapper_cast` and field accesses 
+/// don't touch any state shared with other threads. The rules are thus those of the wrapped 
+/// memory itself plus the following:
+/// - A wrapper instance (including its fields and their getters) may be used by multiple threads 
+///   concurrently as long as none of them rebinds, moves or assigns it. Caching getters such as 
+///   `CachedVfTableGetter` update themselves on use and thus belong to a single thread, give 
+///   each thread a wrapper of its own (wrappers are cheap to create).
+/// - Concurrent accesses to the *wrapped* object are data races unless the target synchronizes
+///   them, use `AtomicField` or `consistentRead` for fields written by other threads.
+/// - Process-wide state is read without locks. `LazyBinding`s publish their address with a single
+///   atomic store, `Global::instance()` is constant-initialized. The module handle and export
+///   index caches and `ReadableRegionMap` publish immutable tables through 
+///   `platform::RcuCell`: readers only touch a reader counter on a cache line private to their 
+///   thread's stripe, writers (module loads, region map misses) copy the table, swap it in and
+///   wait for the readers of the old one.
+/// - `WrapperIdentityMap` lookups are lock-free, removed wrappers are reclaimed by epochs.
+/// 
+/// Use `platform::RcuCell` for state of your own that is read on many threads and rarely updated,
+/// and its `version()` to validate per-thread (`thread_local`) caches derived from it.
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdint.h>
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "zycore/Operators.hpp"
 #include "zycore/Utils.hpp"
 #include "zycore/Optional.hpp"
 
+#include "RemodelFwd.hpp"
 #include "Platform.hpp"
+#include "Scanner.hpp"
+#include "Instrument.hpp"
+#include "Trace.hpp"
 
 namespace remodel
 {
 
+// Defined in Remote.hpp.
+class LocalMemoryAccessor;
+template<typename WrapperT, typename AccessorT> class RemoteInstance;
+
 namespace internal
 {
     class FieldBase;
     using namespace zycore;
+
+    /**
+     * @internal
+     * @brief   Type-erased `PtrGetter` type used when no concrete getter type is specified.
+     *          
+     * Unlike `std::function`, getters of up to two pointers in size that are trivially copyable
+     * (e.g. `OffsGetter`, `AbsGetter`, `VfTableGetter` or lambdas capturing a few values) are 
+     * stored in an inline buffer without ever allocating, copying them is a plain memory copy 
+     * and calling them costs a single indirect call. Bigger getters (e.g. `PtrChainGetter`) are 
+     * stored on the heap. Default constructed getters and getters moved-from heap storage return 
+     * @c nullptr.
+     */
+    class InlineGetter
+    {
+        enum class ManageOp
+        {
+            kCall,
+            kClone,
+            kDestroy,
+        };
+
+        using Invoke = void* (*)(void* storage, void* raw);
+        using Manage = void* (*)(ManageOp op, void* obj, void* raw);
+
+        struct HeapState
+        {
+            void* obj;
+            Manage manage;
+        };
+    public:
+        static const std::size_t kInlineSize = 2 * sizeof(void*);
+
+        /**
+         * @brief   Determines whether a callable type is stored inline.
+         * @tparam  FuncT   The callable type.
+         *                  
+         * Triviality is checked via the copy constructor and destructor rather than 
+         * `std::is_trivially_copyable`, which GCC may report as @c false for closure types whose
+         * implicit members have not been declared yet. Inline getters are never assigned.
+         */
+        template<typename FuncT>
+        struct FitsInline
+            : std::integral_constant<bool,
+                sizeof(FuncT) <= kInlineSize 
+                && alignof(FuncT) <= alignof(void*)
+                && std::is_trivially_copy_constructible<FuncT>::value
+                && std::is_trivially_destructible<FuncT>::value>
+        {};
+
+        /**
+         * @brief   Default constructor, creating a getter returning @c nullptr.
+         */
+        InlineGetter() = default;
+
+        /**
+         * @brief   Constructor.
+         * @tparam  FuncT   Type of the callable, taking a `void*` and returning a pointer.
+         * @param   func    The callable.
+         */
+        template<typename FuncT, typename DecayedT = std::decay_t<FuncT>, 
+            typename = std::enable_if_t<!std::is_same<DecayedT, InlineGetter>::value 
+                && std::is_convertible<
+                    decltype(std::declval<DecayedT&>()(std::declval<void*>())), void*>::value>>
+        InlineGetter(FuncT&& func)
+        {
+            emplace<DecayedT>(std::forward<FuncT>(func), FitsInline<DecayedT>{});
+        }
+
+        InlineGetter(const InlineGetter& other)
+            : m_invoke{other.m_invoke}
+        {
+            copyWords(other);
+            if (isHeap())
+            {
+                m_storage.heap.obj = 
+                    m_storage.heap.manage(ManageOp::kClone, m_storage.heap.obj, nullptr);
+            }
+        }
+
+        InlineGetter(InlineGetter&& other) noexcept
+            : m_invoke{other.m_invoke}
+        {
+            copyWords(other);
+            if (isHeap()) other.m_invoke = &invokeNull;
+        }
+
+        ~InlineGetter()
+        {
+            if (isHeap())
+            {
+                m_storage.heap.manage(ManageOp::kDestroy, m_storage.heap.obj, nullptr);
+            }
+        }
+
+        InlineGetter& operator = (const InlineGetter& other)
+        {
+            return *this = InlineGetter{other};
+        }
+
+        InlineGetter& operator = (InlineGetter&& other) noexcept
+        {
+            if (this != &other)
+            {
+                this->~InlineGetter();
+                new (this) InlineGetter{std::move(other)};
+            }
+            return *this;
+        }
+
+        /**
+         * @brief   Determines whether the getter is stored in the inline buffer.
+         * @return  @c true if inline, @c false if stored on the heap.
+         */
+        bool storedInline() const { return !isHeap(); }
+
+        /**
+         * @brief   Gets the invoker of heap-stored getters, identifying them in raw memory.
+         * @return  The invoker's address.
+         * @see     measureFootprint
+         */
+        static uintptr_t heapInvoker() { return reinterpret_cast<uintptr_t>(&invokeHeap); }
+
+        /**
+         * @brief   Calls the getter.
+         * @param   raw The raw base pointer.
+         * @return  The pointer calculated by the getter.
+         */
+        void* operator () (void* raw) const
+        {
+            return m_invoke(&m_storage, raw);
+        }
+    private:
+        bool isHeap() const { return m_invoke == &invokeHeap; }
+
+        // Copying word by word rather than as a whole lets the loads be forwarded from the
+        // (usually narrower) stores that constructed the getter just before.
+        void copyWords(const InlineGetter& other)
+        {
+            m_storage.words[0] = other.m_storage.words[0];
+            m_storage.words[1] = other.m_storage.words[1];
+        }
+
+        template<typename FuncT, typename ArgT>
+        void emplace(ArgT&& func, std::true_type /* inline */)
+        {
+            new (&m_storage.words) FuncT(std::forward<ArgT>(func));
+            m_invoke = &invokeInline<FuncT>;
+        }
+
+        template<typename FuncT, typename ArgT>
+        void emplace(ArgT&& func, std::false_type /* inline */)
+        {
+            m_storage.heap.obj    = new FuncT(std::forward<ArgT>(func));
+            m_storage.heap.manage = &manageHeap<FuncT>;
+            m_invoke              = &invokeHeap;
+        }
+
+        static void* invokeNull(void*, void*) 
+        { 
+            return nullptr; 
+        }
+
+        template<typename FuncT>
+        static void* invokeInline(void* storage, void* raw)
+        {
+            return (*static_cast<FuncT*>(storage))(raw);
+        }
+
+        static void* invokeHeap(void* storage, void* raw)
+        {
+            auto& heap = *static_cast<HeapState*>(storage);
+            return heap.manage(ManageOp::kCall, heap.obj, raw);
+        }
+
+        template<typename FuncT>
+        static void* manageHeap(ManageOp op, void* obj, void* raw)
+        {
+            auto func = static_cast<FuncT*>(obj);
+            switch (op)
+            {
+                case ManageOp::kCall:       return (*func)(raw);
+                case ManageOp::kClone:      return new FuncT(*func);
+                case ManageOp::kDestroy:    delete func; return nullptr;
+            }
+            return nullptr;
+        }
+    private:
+        union Storage
+        {
+            void* words[kInlineSize / sizeof(void*)];
+            HeapState heap;
+        };
+
+        Invoke m_invoke = &invokeNull;
+        mutable Storage m_storage{};
+    };
+
+    /**
+     * @internal
+     * @brief   Determines whether a wrapper is the `Global` singleton.
+     * @param   wrapper The wrapper.
+     * @return  @c true if it is, else @c false.
+     */
+    inline bool isGlobalWrapper(const ClassWrapper* wrapper);
 } // namespace internal
 
 // We require that data-pointers are equal in size to code-pointers.
@@ -306,6 +625,9 @@ static_assert(sizeof(void(*)()) == sizeof(void*), "unsupported platform");
 
 /**
  * @brief   Base class for class wrappers.
+ *          
+ * Wrappers are value types and not polymorphic: the destructor is non-virtual, so wrappers must
+ * not be destroyed through pointers to their bases.
  */
 class ClassWrapper
 {
@@ -318,15 +640,15 @@ protected:
      * @brief   Constructor.
      * @param   raw The raw pointer of the wrapped object.
      */
-    explicit ClassWrapper(void* raw)
+    constexpr explicit ClassWrapper(void* raw)
         : m_raw{raw}
     {}
-public:
+
     /**
      * @brief   Destructor.
      */
-    virtual ~ClassWrapper() = default;
-
+    ~ClassWrapper() = default;
+public:
     /**
      * @brief   Copy constructor.
      * @param   other   The instance to copy from.
@@ -335,6 +657,19 @@ public:
         : m_raw{other.m_raw}
     {}
 
+    /**
+     * @brief   Move constructor.
+     * @param   other   The instance to move from.
+     *                  
+     * Unlike copies, which construct all fields of the wrapper anew, wrappers declared using
+     * `REMODEL_WRAPPER` or `REMODEL_ADV_WRAPPER` are moved by moving their fields, getter state
+     * included. Fields that aren't movable (e.g. `TrailingArrayField`) make the wrapper fall 
+     * back to copying.
+     */
+    ClassWrapper(ClassWrapper&& other) noexcept
+        : m_raw{other.m_raw}
+    {}
+
     /**
      * @brief   Assignment operator.
      * @param   other   The instance to assign from.
@@ -366,6 +701,30 @@ public:
      */
     const void* addressOfObj() const { return m_raw; }
 
+    /**
+     * @brief   Points this wrapper to another object.
+     * @param   raw The raw pointer of the new object.
+     *              
+     * This is a lot cheaper than creating a new wrapper since the fields are not reconstructed,
+     * making it the tool of choice when visiting many objects of the same type. Fields resolve 
+     * through the wrapper on every access and getters caching results key them on the object, 
+     * so rebound wrappers behave exactly like freshly created ones. Should a wrapper declare a 
+     * member named `rebind` itself, use `wrapper.ClassWrapper::rebind(raw)`.
+     * @see     WrapperPool
+     */
+    void rebind(void* raw) { m_raw = raw; }
+
+    /**
+     * @brief   Hints the CPU to fetch the first cache line of the wrapped object.
+     */
+    void prefetch() const { platform::prefetch(m_raw); }
+
+    /**
+     * @brief   Hints the CPU to fetch the beginning of the wrapped object.
+     * @param   size    The number of bytes to fetch, rounded to whole cache lines.
+     */
+    void prefetch(std::size_t size) const { platform::prefetchRange(m_raw, size); }
+
     // addressOfWrapper is implemented in the REMODEL_WRAPPER/REMODEL_ADV_WRAPPER macro.
 };
 
@@ -376,6 +735,37 @@ public:
 namespace internal
 {
 
+/**
+ * @internal
+ * @brief   Allocates memory with an alignment `operator new` doesn't guarantee before C++17.
+ * @param   size        The size of the allocation, in bytes.
+ * @param   alignment   The alignment, a power of two.
+ * @return  The allocation, to be released using `freeAligned`.
+ */
+inline void* allocateAligned(std::size_t size, std::size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t)) return ::operator new(size);
+
+    // Over-allocate and keep the original pointer right in front of the aligned block.
+    auto raw     = static_cast<uint8_t*>(::operator new(size + alignment + sizeof(void*)));
+    auto aligned = reinterpret_cast<uintptr_t>(raw + sizeof(void*) + alignment - 1) 
+        & ~static_cast<uintptr_t>(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+/**
+ * @internal
+ * @brief   Releases memory allocated by `allocateAligned`.
+ * @param   ptr         The allocation.
+ * @param   alignment   The alignment passed to `allocateAligned`.
+ */
+inline void freeAligned(void* ptr, std::size_t alignment)
+{
+    if (!ptr) return;
+    ::operator delete(alignment <= alignof(std::max_align_t) ? ptr : static_cast<void**>(ptr)[-1]);
+}
+
 /**
  * @internal
  * @brief   TMP helper type implementation that does nothing when called.
@@ -433,54 +823,56 @@ struct InstantiableWrapperDtorCaller<WrapperT, true>
     }
 };
 
+/**
+ * @internal
+ * @brief   TMP tool determining if a wrapper defines a custom `construct` routine.
+ * @tparam  WrapperT    Type of the wrapper.
+ */
+template<typename WrapperT>
+class HasCustomCtor
+{
+    struct Yep {};
+    struct Nope {};
+    template<typename C> static Yep  test(decltype(&C::construct));
+    template<typename C> static Nope test(...                    );
+public:
+    static const bool Value = std::is_same<decltype(test<WrapperT>(nullptr)), Yep>::value;
+};
+
+/**
+ * @internal
+ * @brief   TMP tool determining if a wrapper defines a custom `destruct` routine.
+ * @tparam  WrapperT    Type of the wrapper.
+ */
+template<typename WrapperT>
+class HasCustomDtor
+{
+    struct Yep {};
+    struct Nope {};
+    template<typename C> static Yep  test(decltype(&C::destruct));
+    template<typename C> static Nope test(...                   );
+public:
+    static const bool Value = std::is_same<decltype(test<WrapperT>(nullptr)), Yep>::value;
+};
+
 /**
  * @brief   Template making wrapper types instantiable.
  * @tparam  WrapperT    Wrapepr type.
+ *                      
+ * The object storage is aligned to `WrapperT::kObjAlign`, also when allocated using `new`.
  */
-#pragma pack(push, 1)
 template<typename WrapperT>
 class InstantiableWrapper 
     : public WrapperT
     , public NonCopyable
 {
-    uint8_t m_data[WrapperT::kObjSize];
-
-    /**
-     * @internal
-     * @brief   Marker type.
-     */
-    struct Yep {};
-
-    /**
-     * @internal
-     * @brief   Marker type.
-     */
-    struct Nope {};
-
+    alignas(WrapperT::kObjAlign) uint8_t m_data[WrapperT::kObjSize];
+public:
     /**
-     * @internal
-     * @brief   TMP tool determining if we should use default-construction for the wrapper.
+     * @brief   Instantiable wrappers own their object and can't be rebound.
      */
-    class HasCustomCtor
-    {
-        template<typename C> static Yep  test(decltype(&C::construct));
-        template<typename C> static Nope test(...                    );
-    public:
-        static const bool Value = std::is_same<decltype(test<WrapperT>(nullptr)), Yep>::value;
-    };
+    void rebind(void* raw) = delete;
 
-    /**
-     * @internal
-     * @brief   TMP tool determining if we should use default-destruction for the wrapper.
-     */
-    class HasCustomDtor
-    {
-        template<typename C> static Yep  test(decltype(&C::destruct));
-        template<typename C> static Nope test(...                   );
-    public:
-        static const bool Value = std::is_same<decltype(test<WrapperT>(nullptr)), Yep>::value;
-    };
-public:
     /**
      * @brief   Constructor.
      * @tparam  ArgsT   Constructor argument types.
@@ -494,7 +886,7 @@ public:
         : WrapperT{&m_data}
     {
         InstantiableWrapperCtorCaller<
-            WrapperT, HasCustomCtor::Value, ArgsT...
+            WrapperT, HasCustomCtor<WrapperT>::Value, ArgsT...
             >::Call(this, std::forward<ArgsT>(args)...);
     }
 
@@ -506,20 +898,124 @@ public:
      */
     ~InstantiableWrapper()
     {
-        InstantiableWrapperDtorCaller<WrapperT, HasCustomDtor::Value>::Call(this);
+        InstantiableWrapperDtorCaller<WrapperT, HasCustomDtor<WrapperT>::Value>::Call(this);
+    }
+
+    static void* operator new (std::size_t size) 
+    { 
+        return allocateAligned(size, alignof(InstantiableWrapper)); 
+    }
+
+    static void operator delete (void* ptr) { freeAligned(ptr, alignof(InstantiableWrapper)); }
+
+    static void* operator new (std::size_t, void* place) { return place; }
+    static void operator delete (void*, void*) {}
+};
+
+/**
+ * @brief   Template making wrapper types instantiable, storing nothing but the object.
+ * @tparam  WrapperT    Wrapper type.
+ *                      
+ * Unlike `InstantiableWrapper`, which embeds a full wrapper (with all its fields), instances are 
+ * exactly `WrapperT::kObjSize` bytes large and arrays of them are laid out like arrays of the 
+ * wrapped class. Wrappers are created on demand using `wrapper`, so accesses pay for the 
+ * construction of the wrapper's fields.
+ * 
+ * The `construct` and `destruct` routines are called on a temporary wrapper.
+ */
+template<typename WrapperT>
+class CompactInstantiableWrapper : public NonCopyable
+{
+    alignas(WrapperT::kObjAlign) uint8_t m_data[WrapperT::kObjSize];
+public:
+    /**
+     * @brief   Constructor.
+     * @tparam  ArgsT   Constructor argument types.
+     * @param   args    Arguments passed to the `construct` routine.
+     */
+    template<typename... ArgsT>
+    explicit CompactInstantiableWrapper(ArgsT&&... args)
+    {
+        auto view = wrapper();
+        InstantiableWrapperCtorCaller<
+            WrapperT, HasCustomCtor<WrapperT>::Value, ArgsT...
+            >::Call(view.addressOfWrapper(), std::forward<ArgsT>(args)...);
+    }
+
+    /**
+     * @brief   Destructor, calling the `destruct` routine.
+     */
+    ~CompactInstantiableWrapper()
+    {
+        auto view = wrapper();
+        InstantiableWrapperDtorCaller<
+            WrapperT, HasCustomDtor<WrapperT>::Value
+            >::Call(view.addressOfWrapper());
+    }
+
+    /**
+     * @brief   Creates a wrapper for the object.
+     * @return  The wrapper.
+     */
+    WrapperT wrapper() { return wrapper_cast<WrapperT>(&m_data); }
+
+    /**
+     * @brief   Gets a weak wrapper for the object, without creating a wrapper.
+     * @return  The weak wrapper.
+     */
+    typename WrapperT::Weak* weakPtr() 
+    { 
+        return reinterpret_cast<typename WrapperT::Weak*>(m_data); 
+    }
+
+    /**
+     * @brief   Obtains a raw pointer to the object.
+     * @return  The desired pointer.
+     */
+    void* addressOfObj() { return m_data; }
+
+    /**
+     * @copydoc addressOfObj
+     */
+    const void* addressOfObj() const { return m_data; }
+
+    static void* operator new (std::size_t size) 
+    { 
+        return allocateAligned(size, alignof(CompactInstantiableWrapper)); 
+    }
+
+    static void* operator new[] (std::size_t size) 
+    { 
+        return allocateAligned(size, alignof(CompactInstantiableWrapper)); 
     }
+
+    static void operator delete (void* ptr) 
+    { 
+        freeAligned(ptr, alignof(CompactInstantiableWrapper)); 
+    }
+
+    static void operator delete[] (void* ptr) 
+    { 
+        freeAligned(ptr, alignof(CompactInstantiableWrapper)); 
+    }
+
+    static void* operator new (std::size_t, void* place) { return place; }
+    static void operator delete (void*, void*) {}
 };
-#pragma pack(pop)
 
 } // namespace internal
 
 /**
  * @brief   Advanced version of the base class for wrappers.
  * @tparam  objSizeT    The size of the wrapped class, in bytes.
+ * @tparam  objAlignT   The alignment of the wrapped class, honoured by `Instantiable` storage 
+ *                      and `Weak` wrappers. Required for SIMD or atomic members of instances.
  */
-template<std::size_t objSizeT>
+template<std::size_t objSizeT, std::size_t objAlignT>
 class AdvancedClassWrapper : public ClassWrapper
 {
+    static_assert(objAlignT && !(objAlignT & (objAlignT - 1)), "alignment must be a power of two");
+    static_assert(objSizeT % objAlignT == 0, "size must be a multiple of the alignment");
 protected:
     explicit AdvancedClassWrapper(void* raw)
         : ClassWrapper{raw}
@@ -527,19 +1023,51 @@ protected:
 public:
     using IsAdvWrapper = void;
 
-    static const std::size_t kObjSize = objSizeT;
+    static const std::size_t kObjSize  = objSizeT;
+    static const std::size_t kObjAlign = objAlignT;
 
     AdvancedClassWrapper(const AdvancedClassWrapper& other)
         : ClassWrapper{other}
     {}
 
+    AdvancedClassWrapper(AdvancedClassWrapper&& other) noexcept
+        : ClassWrapper{std::move(other)}
+    {}
+
     AdvancedClassWrapper& operator = (const AdvancedClassWrapper& other)
     { 
         this->ClassWrapper::operator = (other); 
         return *this; 
     }
+
+    using ClassWrapper::prefetch;
+
+    /**
+     * @brief   Hints the CPU to fetch all cache lines spanned by the wrapped object.
+     */
+    void prefetch() const { platform::prefetchRange(m_raw, kObjSize); }
 };
 
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The number of bytes prefetched per object of a wrapper type by iteration adapters.
+ */
+template<typename WrapperT, typename = void>
+struct ObjPrefetchSize : std::integral_constant<std::size_t, platform::kCacheLineSize> {};
+
+/**
+ * @internal
+ * @brief   The number of bytes prefetched per object of advanced wrapper types (manual SFINAE).
+ */
+template<typename WrapperT>
+struct ObjPrefetchSize<WrapperT, typename WrapperT::IsAdvWrapper> 
+    : std::integral_constant<std::size_t, WrapperT::kObjSize> {};
+
+} // namespace internal
+
 /**
  * @internal
  * @brief   Macro forwarding constructors and implementing other wrapper logic required.
@@ -555,6 +1083,7 @@ public:
     public:                                                                                        \
         classname(const classname& other)                                                          \
             : base(other) /* MSVC12 requires parentheses here */ {}                                \
+        classname(classname&& other) = default;                                                    \
         classname& operator = (const classname& other)                                             \
             { this->base::operator = (other); return *this; }                                      \
         /* allow field access via -> (required to allow -> on wrapped struct fields) */            \
@@ -579,10 +1108,18 @@ public:
 #define REMODEL_ADV_WRAPPER(classname)                                                             \
     REMODEL_WRAPPER_IMPL(classname, AdvancedClassWrapper)                                          \
     public:                                                                                        \
-        using Instantiable = internal::InstantiableWrapper<classname>;                             \
-        using Weak = WeakWrapper<classname>;                                                       \
+        using Instantiable = ::remodel::internal::InstantiableWrapper<classname>;                  \
+        using Compact = ::remodel::internal::CompactInstantiableWrapper<classname>;                \
+        using Weak = ::remodel::WeakWrapper<classname>;                                            \
     public:                                                                                        \
         Weak* weakPtr() { return reinterpret_cast<Weak*>(this->addressOfObj()); }                  \
+        /* snapshots require Remote.hpp to be included */                                          \
+        template<typename AccessorT = ::remodel::LocalMemoryAccessor>                              \
+        ::remodel::RemoteInstance<classname, AccessorT> snapshot() const                           \
+            { return ::remodel::RemoteInstance<classname, AccessorT>::of(*this); }                 \
+        template<typename AccessorT>                                                               \
+        ::remodel::RemoteInstance<classname, AccessorT> snapshot(AccessorT& accessor) const        \
+            { return ::remodel::RemoteInstance<classname, AccessorT>::of(*this, accessor); }       \
     private:
 
 // ============================================================================================== //
@@ -671,7 +1208,7 @@ public:
         : m_offs{offs}
     {}
 
-    void* operator () (void* raw)
+    void* operator () (void* raw) const
     {
         return reinterpret_cast<void*>(
             reinterpret_cast<uintptr_t>(raw) + m_offs
@@ -679,6 +1216,31 @@ public:
     }
 };
 
+// ---------------------------------------------------------------------------------------------- //
+// [StaticOffsGetter]                                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   `PtrGetter` functor adding a compile-time offset to the passed raw address.
+ * @tparam  offsT   The offset to apply to the raw pointer.
+ *                  
+ * Other than `OffsGetter`, this getter is stateless, allowing fields using it to compile down to
+ * a plain `base + offset` access.
+ */
+template<std::ptrdiff_t offsT>
+class StaticOffsGetter
+{
+public:
+    static const std::ptrdiff_t kOffs = offsT;
+
+    void* operator () (void* raw) const
+    {
+        return reinterpret_cast<void*>(
+            reinterpret_cast<uintptr_t>(raw) + offsT
+            );
+    }
+};
+
 // ---------------------------------------------------------------------------------------------- //
 // [AbsGetter]                                                                                    //
 // ---------------------------------------------------------------------------------------------- //
@@ -688,14 +1250,14 @@ public:
  */
 class AbsGetter
 {
-    void* m_ptr;
+    uintptr_t m_ptr;
 public:
     /**
      * @brief   Constructor.
      * @param   ptr The pointer to return on calls (ignoring the raw pointer).
      */
     explicit AbsGetter(void* ptr)
-        : m_ptr{ptr}
+        : m_ptr{reinterpret_cast<uintptr_t>(ptr)}
     {}
 
     /**
@@ -703,11 +1265,48 @@ public:
      * @param   ptr The pointer to return on calls (ignoring the raw pointer) in `uint` 
      *              representation.
      */
-    explicit AbsGetter(uintptr_t ptr)
-        : AbsGetter{reinterpret_cast<void*>(ptr)}
+    constexpr explicit AbsGetter(uintptr_t ptr)
+        : m_ptr{ptr}
+    {}
+
+    void* operator () (void*) const
+    {
+        return reinterpret_cast<void*>(m_ptr);
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [ModuleRelGetter]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   `PtrGetter` functor ignoring the passed raw address, always returning a fixed address
+ *          relative to the base of a module.
+ *          
+ * The module base is resolved once on construction, so many getters can be created from a 
+ * single `Module` lookup without recalculating `base + rva` at every construction site.
+ */
+class ModuleRelGetter
+{
+    void* m_ptr;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   module  The module the address is relative to.
+     * @param   rva     The address relative to the module base.
+     */
+    ModuleRelGetter(const Module& module, uintptr_t rva);
+
+    /**
+     * @brief   Constructor.
+     * @param   moduleBase  The base of the module, as returned by `platform::obtainModuleHandle`.
+     * @param   rva         The address relative to the module base.
+     */
+    ModuleRelGetter(const void* moduleBase, uintptr_t rva)
+        : m_ptr{reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(moduleBase) + rva)}
     {}
 
-    void* operator () (void*)
+    void* operator () (void*) const
     {
         return m_ptr;
     }
@@ -735,7 +1334,7 @@ public:
         , m_vftableOffset{vftableOffset}
     {}
 
-    void* operator () (void* raw)
+    void* operator () (void* raw) const
     {
         return reinterpret_cast<void*>(
             *reinterpret_cast<uintptr_t*>(
@@ -748,556 +1347,3253 @@ public:
     }
 };
 
-// ============================================================================================== //
-// Helper class(es) to create wrappers from raw pointers                                          //
-// ============================================================================================== //
-
 // ---------------------------------------------------------------------------------------------- //
-// [WrapperPtr]                                                                                   //
+// [CachedVfTableGetter]                                                                          //
 // ---------------------------------------------------------------------------------------------- //
 
-namespace internal
+/**
+ * @brief   `PtrGetter` functor obtaining a function address using the virtual function table,
+ *          caching the result.
+ *          
+ * The function address is resolved once and reused for as long as the getter is invoked with 
+ * the same object. Changes of the object's vftable are only picked up after `invalidate` was
+ * called. The cache is not synchronized, instances must not be shared between threads.
+ */
+class CachedVfTableGetter
+{
+    std::size_t   m_vftableIdx;
+    std::size_t   m_vftableOffset;
+    mutable void* m_cachedRaw    = nullptr;
+    mutable void* m_cachedTarget = nullptr;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   vftableIdx      Index of the function inside the table.
+     * @param   vftableOffset   Offset of the vftable-pointer in the class.
+     */
+    explicit CachedVfTableGetter(std::size_t vftableIdx, std::size_t vftableOffset = 0)
+        : m_vftableIdx   {vftableIdx}
+        , m_vftableOffset{vftableOffset}
+    {}
+
+    /**
+     * @brief   Gets the offset of the vftable-pointer in the class.
+     * @return  The offset.
+     */
+    std::size_t vftableOffset() const { return m_vftableOffset; }
+
+    /**
+     * @brief   Reads the vftable-pointer of an object.
+     * @param   raw The raw pointer of the object.
+     * @return  The vftable.
+     */
+    void* vftable(void* raw) const
+    {
+        return *reinterpret_cast<void**>(reinterpret_cast<uintptr_t>(raw) + m_vftableOffset);
+    }
+
+    /**
+     * @brief   Resolves and caches the function address from an already obtained vftable.
+     * @param   raw     The raw pointer of the object.
+     * @param   vftable The vftable of the object.
+     */
+    void resolve(void* raw, void* vftable) const
+    {
+        m_cachedTarget = static_cast<void**>(vftable)[m_vftableIdx];
+        m_cachedRaw    = raw;
+    }
+
+    /**
+     * @brief   Drops the cached function address.
+     */
+    void invalidate() { m_cachedRaw = nullptr; }
+
+    void* operator () (void* raw) const
+    {
+        if (raw != m_cachedRaw)
+        {
+            resolve(raw, vftable(raw));
+        }
+        return m_cachedTarget;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [LazyGetter]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
 {
 
 /**
  * @internal
- * @brief   Weak wrapper fall-through capturing invalid instantiations.
- * @tparam  WrapperT    Wrapper type.
+ * @brief   Converts the result of a `LazyBinding` resolver to an address.
  */
-template<typename WrapperT, typename = void>
-class WeakWrapperImpl
+inline void* toResolvedAddress(void* address) { return address; }
+inline void* toResolvedAddress(uintptr_t address) { return reinterpret_cast<void*>(address); }
+inline void* toResolvedAddress(const zycore::Optional<uintptr_t>& address)
 {
-    static_assert(BlackBoxConsts<WrapperT>::kFalse,
-        "WeakWrapper can only be created for AdvancedClassWrappers");
-};
+    return address.hasValue() ? reinterpret_cast<void*>(address.value()) : nullptr;
+}
+
+} // namespace internal
 
-#pragma pack(push, 1)
 /**
- * @internal
- * @brief   Weak wrapper implementation capturing correct instantiations.
- * @tparam  WrapperT    Wrapper type derived from `AdvancedClassWrapper`.
+ * @brief   An address resolved on first use, shared by all `LazyGetter`s referring to it.
+ *          
+ * Resolving every function at startup (e.g. by signature) costs time for functions that may 
+ * never be called. A binding runs its resolver on the first request instead, publishes the 
+ * result and returns it from then on, at the cost of a single acquire load.
+ * 
+ * @code
+ *      static LazyBinding getHealthAddr{[] 
+ *      { 
+ *          return Module::getModule(nullptr).value().findPattern("55 8B EC ?? 8B 45"); 
+ *      }};
+ *      Function<int(*)(int)> getHealth{getHealthAddr};
+ * @endcode
+ * 
+ * Failed resolutions (@c nullptr) are not published and retried on the next request. If several
+ * threads make the first request concurrently, each may run the resolver, the first result 
+ * published is used by all of them.
+ * 
+ * @note    Bindings must outlive the wrappers using them, usually they have static storage.
  */
-template<typename WrapperT>
-class WeakWrapperImpl<WrapperT, typename WrapperT::IsAdvWrapper /* manual SFINAE */>
+class LazyBinding : public zycore::NonCopyable
 {
-    uint8_t m_dummy[WrapperT::kObjSize];
-protected:
+    internal::InlineGetter     m_resolver;
+    mutable std::atomic<void*> m_address{nullptr};
+public:
     /**
-     * @brief   Default constructor.
+     * @brief   Constructor.
+     * @param   resolver    Callable without arguments, returning the address as `void*`,
+     *                      `uintptr_t` or `zycore::Optional<uintptr_t>`.
      */
-    WeakWrapperImpl() = default;
-public:
+    template<typename ResolverT>
+    explicit LazyBinding(ResolverT resolver)
+        : m_resolver{[resolver](void*) -> void* 
+        { 
+            return internal::toResolvedAddress(resolver()); 
+        }}
+    {}
+
     /**
-     * @brief   Gets the raw pointer 
-     * @return  The raw pointer.
+     * @brief   Gets the address, resolving it on the first call.
+     * @return  The address, @c nullptr if resolving failed.
      */
-    void* raw() { return this; }
+    void* address() const
+    {
+        auto address = m_address.load(std::memory_order_acquire);
+        return address ? address : resolve();
+    }
 
     /**
-     * @brief   Converts this weak wrapper to a strong ("normal") one.
-     * @return  A strong wrapper.
+     * @brief   Determines whether the address was resolved already.
      */
-    WrapperT toStrong() { return wrapper_cast<WrapperT>(this); }
+    bool isResolved() const { return m_address.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief   Drops the resolved address, e.g. after the module was reloaded.
+     * @note    Not synchronized with concurrent calls through the binding.
+     */
+    void reset() { m_address.store(nullptr, std::memory_order_release); }
+private:
+    void* resolve() const
+    {
+        auto address = m_resolver(nullptr);
+        if (!address) return nullptr;
+
+        void* expected = nullptr;
+        if (!m_address.compare_exchange_strong(expected, address, std::memory_order_acq_rel)) 
+            return expected;
+        return address;
+    }
 };
-#pragma pack(pop)
- 
-} // namespace internal
 
 /**
- * @brief   Weak wrapper helper type.
- * @tparam  WrapperT    Type of the strong wrapper to create a weak wrapper for.
- *                      
- * Other than with normal wrappers, the `this` pointer of this class points to the actual object
- * which allows creation of raw pointers to weak wrappers which is useful when defining functions
- * that take pointers to wrapped types. Weak wrappers can then be evolved to strong wrappers
- * with a simple `toStrong` invocation.
+ * @brief   `PtrGetter` functor obtaining an address from a `LazyBinding`, resolving it on first 
+ *          use.
+ *          
+ * The address doesn't depend on the object, for member functions it is shared by all instances.
  */
-template<typename WrapperT>
-struct WeakWrapper final : internal::WeakWrapperImpl<WrapperT> {};
-
-// Verify assumptions about this class.
-static_assert(std::is_trivial<WeakWrapper<AdvancedClassWrapper<sizeof(int)>>>::value, 
-    "internal library error");
-static_assert(sizeof(int) == sizeof(WeakWrapper<AdvancedClassWrapper<sizeof(int)>>), 
-    "internal library error");
+class LazyGetter
+{
+    const LazyBinding* m_binding;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   binding The binding, must outlive the getter.
+     */
+    explicit LazyGetter(const LazyBinding& binding)
+        : m_binding{&binding}
+    {}
 
-// ============================================================================================== //
-// Abstract field object implementation                                                           //
-// ============================================================================================== //
+    void* operator () (void* /*raw*/) const
+    {
+        return m_binding->address();
+    }
+};
 
 // ---------------------------------------------------------------------------------------------- //
-// [FieldBase]                                                                                    //
+// [PtrChainGetter]                                                                               //
 // ---------------------------------------------------------------------------------------------- //
 
 namespace internal
-{ 
+{
 
 /**
  * @internal
- * @brief   Base class for all kinds of wrapper-fields.
+ * @brief   Follows a pointer chain: dereferences `p + offs` for all but the last offset, then
+ *          adds the last one.
+ * @param   raw     The start of the chain.
+ * @param   offsets The offsets.
+ * @param   count   The number of offsets, at least one.
+ * @return  The final address or @c nullptr if a null pointer was encountered on the way.
  */
-class FieldBase
+inline void* walkPtrChain(void* raw, const std::ptrdiff_t* offsets, std::size_t count)
 {
-protected:
+    auto ptr = reinterpret_cast<uintptr_t>(raw);
+    for (std::size_t i = 0; i + 1 < count; ++i)
+    {
+        if (!ptr) return nullptr;
+        ptr = *reinterpret_cast<const uintptr_t*>(ptr + offsets[i]);
+    }
+    if (!ptr) return nullptr;
+    return reinterpret_cast<void*>(ptr + offsets[count - 1]);
+}
+
+} // namespace internal
+
+/**
+ * @brief   `PtrGetter` functor following a chain of pointers with compile-time offsets.
+ * @tparam  offsetsT    The offsets. The pointer at `raw + offsets[0]` is loaded, then the one at
+ *                      `thatPtr + offsets[1]` and so on, the last offset is added to the final
+ *                      pointer without loading from it.
+ *
+ * `base -> +0x10 -> +0x48 -> +0x8 -> field` is expressed as `StaticPtrChainGetter<0x10, 0x48,
+ * 0x8>`. A trailing zero offset makes the last hop a load as well, as required for function
+ * addresses (e.g. `<0x10, 0, 3 * sizeof(void*), 0>` for the 4th virtual function of the object
+ * at `raw + 0x10`). A null pointer anywhere along the chain yields @c nullptr.
+ */
+template<std::ptrdiff_t... offsetsT>
+class StaticPtrChainGetter
+{
+    static_assert(sizeof...(offsetsT) > 0, "pointer chains require at least one offset");
+public:
+    static const std::size_t kLength = sizeof...(offsetsT);
+
     /**
-     * @brief   Definition of the prototype for pointer-getters.
+     * @brief   Gets the offsets.
+     * @return  Pointer to the first of `length()` offsets.
      */
-    using PtrGetter = std::function<void*(void* rawBasePtr)>;
+    static const std::ptrdiff_t* offsets()
+    {
+        static const std::ptrdiff_t kOffsets[] = {offsetsT...};
+        return kOffsets;
+    }
 
     /**
-     * @brief   Constructor.
-     * @param   parent      If non-null, the parent.
-     * @param   ptrGetter   A `PtrGetter` calculating the actual offset of the proxied object.
+     * @brief   Gets the number of offsets.
+     * @return  `kLength`.
      */
-    FieldBase(ClassWrapper* parent, PtrGetter ptrGetter)
-        : m_ptrGetter{ptrGetter}
-        , m_parent{parent}
-    {}
+    static std::size_t length() { return kLength; }
+
+    void* operator () (void* raw) const
+    {
+        const std::ptrdiff_t kOffsets[] = {offsetsT...};
+        return internal::walkPtrChain(raw, kOffsets, kLength);
+    }
+};
+
+/**
+ * @brief   Caching policies of `PtrChainGetter`.
+ */
+enum class ChainCachePolicy
+{
+    /// Walk the whole chain on every access.
+    None,
+    /// Cache the result until invoked with a different object or `invalidate` is called.
+    PerObject,
+    /// Like `PerObject`, and additionally invalidate whenever a generation counter changes.
+    Generation,
+};
 
+/**
+ * @brief   `PtrGetter` functor following a chain of pointers with runtime offsets, optionally
+ *          caching the result.
+ *
+ * Offsets are interpreted as with `StaticPtrChainGetter`, at most `kMaxLength` are supported.
+ * Chains can either start at the raw pointer passed (fields and member functions) or at a fixed
+ * base pointer (e.g. a global, for `Function`s).
+ *
+ * With caching enabled, the resolved address is reused for as long as the getter is invoked with
+ * the same object, so intermediate objects being replaced are only picked up after `invalidate`
+ * was called (or the generation counter was incremented by whoever replaces them). The cache is
+ * not synchronized, instances must not be shared between threads.
+ *
+ * @code
+ *      Field<float, PtrChainGetter> health{this, PtrChainGetter{{0x10, 0x48, 0x8}}};
+ *      Function<void(*)(), PtrChainGetter> tick{
+ *          PtrChainGetter{globalGamePtr, {0, 0x30, 0}, ChainCachePolicy::PerObject}};
+ * @endcode
+ */
+class PtrChainGetter
+{
+public:
+    static const std::size_t kMaxLength = 8;
+private:
+    std::ptrdiff_t                   m_offsets[kMaxLength];
+    std::size_t                      m_length;
+    void*                            m_base;
+    ChainCachePolicy                 m_policy;
+    const std::atomic<uint64_t>*     m_generation;
+    mutable bool                     m_cacheValid      = false;
+    mutable void*                    m_cachedRaw       = nullptr;
+    mutable void*                    m_cachedTarget    = nullptr;
+    mutable uint64_t                 m_cachedGeneration = 0;
+public:
     /**
-     * @brief   Deleted copy constructor.
+     * @brief   Constructs a getter for chains starting at the raw pointer passed.
+     * @param   offsets     The offsets, at least one and at most `kMaxLength`. Longer chains are
+     *                      rejected, yielding @c nullptr on every invocation.
+     * @param   policy      The caching policy.
+     * @param   generation  For `ChainCachePolicy::Generation`, the counter invalidating the
+     *                      cache, required to outlive the getter.
      */
-    FieldBase(const FieldBase&) = delete;
+    explicit PtrChainGetter(std::initializer_list<std::ptrdiff_t> offsets,
+        ChainCachePolicy policy = ChainCachePolicy::None,
+        const std::atomic<uint64_t>* generation = nullptr)
+        : PtrChainGetter{nullptr, offsets, policy, generation}
+    {}
 
     /**
-     * @brief   Deleted assignment operator.
-     * @note    This is just here as an assertation so internal code cannot copy fields by 
-     *          accident. The concrete implementation hides this operator in favor of an operator
-     *          that copies the data wrapped by one proxy object to another (emulating normal
-     *          assignment semantics).
+     * @brief   Constructs a getter for chains starting at a fixed base, ignoring the raw pointer.
+     * @param   base        The start of the chain.
+     * @copydetails PtrChainGetter(std::initializer_list<std::ptrdiff_t>, ChainCachePolicy,
+     *              const std::atomic<uint64_t>*)
      */
-    FieldBase& operator = (const FieldBase&) = delete;
+    PtrChainGetter(void* base, std::initializer_list<std::ptrdiff_t> offsets,
+        ChainCachePolicy policy = ChainCachePolicy::None,
+        const std::atomic<uint64_t>* generation = nullptr)
+        : m_length{offsets.size() <= kMaxLength ? offsets.size() : 0}
+        , m_base{base}
+        , m_policy{generation ? policy :
+            policy == ChainCachePolicy::Generation ? ChainCachePolicy::PerObject : policy}
+        , m_generation{generation}
+    {
+        std::copy_n(offsets.begin(), m_length, m_offsets);
+    }
 
     /**
-     * @brief   Gets a pointer to the parent of this field.
-     * @return  The parent.
+     * @brief   Determines whether the chain was accepted on construction.
+     * @return  @c true if valid, else @c false.
      */
-    ClassWrapper* parent() { return m_parent; }
+    bool isValid() const { return m_length != 0; }
 
     /**
-     * @brief   Gets a constant pointer to the parent of this field.
-     * @return  The parent.
+     * @brief   Gets the offsets.
+     * @return  Pointer to the first of `length()` offsets.
      */
-    const ClassWrapper* parent() const { return m_parent; }
+    const std::ptrdiff_t* offsets() const { return m_offsets; }
 
     /**
-     * @brief   Gets the `PtrGetter` used for address calculation.
-     * @return  The used `PtrGetter`.
+     * @brief   Gets the number of offsets.
+     * @return  The number of offsets, zero if the chain was rejected.
      */
-    const PtrGetter& ptrGetter() const { return m_ptrGetter; }
+    std::size_t length() const { return m_length; }
 
     /**
-     * @brief   Obtains a pointer to the raw object using the `PtrGetter`.
-     * @return  The requested pointer.
+     * @brief   Gets the fixed base of the chain.
+     * @return  The base or @c nullptr if the chains start at the raw pointer passed.
      */
-    void* rawPtr()
-    {
-        return this->m_ptrGetter(this->m_parent ? this->m_parent->m_raw : nullptr);
-    }
+    void* base() const { return m_base; }
 
     /**
-     * @brief   Obtains a constant pointer to the raw object using the `PtrGetter`.
-     * @return  The requested pointer.
+     * @brief   Drops the cached address.
      */
-    const void* crawPtr() const
+    void invalidate() { m_cacheValid = false; }
+
+    void* operator () (void* raw) const
     {
-        return this->m_ptrGetter(this->m_parent ? this->m_parent->m_raw : nullptr);
+        if (!m_length) return nullptr;
+        if (m_base) raw = m_base;
+        if (m_policy == ChainCachePolicy::None)
+        {
+            return internal::walkPtrChain(raw, m_offsets, m_length);
+        }
+
+        uint64_t generation = m_generation
+            ? m_generation->load(std::memory_order_acquire) : 0;
+        if (!m_cacheValid || raw != m_cachedRaw || generation != m_cachedGeneration)
+        {
+            m_cachedTarget     = internal::walkPtrChain(raw, m_offsets, m_length);
+            m_cachedRaw        = raw;
+            m_cachedGeneration = generation;
+            // Don't cache broken chains, they are likely still under construction.
+            m_cacheValid       = m_cachedTarget != nullptr;
+        }
+        return m_cachedTarget;
     }
-public:
-    /**   
-     * @brief   Destructor.
-     */
-    virtual ~FieldBase() = default;
-protected:
-    PtrGetter     m_ptrGetter;
-    ClassWrapper* m_parent;
 };
 
-// ============================================================================================== //
-// Concrete field object implementation                                                           //
-// ============================================================================================== //
-
-/*
- * +-----------------------------+-------------------------------------------------+-----------+
- * | type                        | example(s)                                      | supported |
- * +-----------------------------+-------------------------------------------------+-----------+
- * | arithmetic types            | int, float, bool, size_t                        | yes       |
- * | trivial structs/classes     | struct A { int b; };                            | yes       |
- * | non-trivial structs/classes | struct A { virtual void b() {} };               | no        |
- * | enums                       | enum A { B = 0 };                               | yes       |
- * | enum classes                | enum class A { B = 0 };                         | yes       |
- * | wrapped classes             | struct A : ClassWrapper { REMODEL_WRAPPER(A) }; | yes       |
- * | functions                   | void a();                                       | yes       |
- * | virtual functions           | virtual void a();                               | yes       |
- * +-----------------------------+-------------------------------------------------+-----------+
+/**
+ * @brief   Follows the same pointer chain from many objects.
+ * @tparam  GetterT The getter type, `StaticPtrChainGetter` or `PtrChainGetter`.
+ * @param   getter  The getter providing the offsets. Caching and fixed bases are ignored.
+ * @param   raws    The starts of the chains.
+ * @param   out     Receives the final addresses, @c nullptr for broken chains. May equal
+ *                  @c raws.
+ * @param   count   The number of chains.
  *
- * +-----------+-----------+--------------------------------------+
- * | qualifier | supported | notes                                |
- * + ----------+-----------+--------------------------------------+
- * | *         | yes       |                                      |
- * | &         | yes       | expects implementation of ref as ptr |
- * | &&        | no        | doesn't make any sense to wrap       |
- * | []        | yes       |                                      |
- * | [N]       | yes       |                                      |
- * +-----------+-----------+--------------------------------------+
+ * Every chain is walked to its end before the next one is started, as the out-of-order core
+ * already overlaps the loads of independent chains. It only lacks the addresses of chains that
+ * are not yet in its window, so the first hop of a chain a few positions ahead is prefetched.
+ * Resolving one level for all chains before moving on to the next turned out slower.
  */
+template<typename GetterT>
+inline void resolvePtrChains(const GetterT& getter, void* const* raws, void** out,
+    std::size_t count)
+{
+    const std::size_t kLookahead = 16;
+    auto offsets = getter.offsets();
+    auto length  = getter.length();
+    if (!length)
+    {
+        std::fill_n(out, count, nullptr);
+        return;
+    }
 
-#define REMODEL_FIELDIMPL_FORWARD_CTORS                                                            \
-    public:                                                                                        \
-        FieldImpl(ClassWrapper *parent, PtrGetter ptrGetter)                                       \
-            : FieldBase{parent, ptrGetter}                                                         \
-        {}                                                                                         \
-                                                                                                   \
-        explicit FieldImpl(const FieldImpl& other)                                                 \
-            : FieldBase{other}                                                                     \
-        {}                                                                                         \
-    private:
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i + kLookahead < count && raws[i + kLookahead])
+        {
+            platform::prefetch(static_cast<uint8_t*>(raws[i + kLookahead]) + offsets[0]);
+        }
+        out[i] = internal::walkPtrChain(raws[i], offsets, length);
+    }
+}
 
 // ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] fall-through implementation                                                        //
+// [SharedGetter]                                                                                 //
 // ---------------------------------------------------------------------------------------------- //
 
 /**
- * @internal
- * @brief   Fall-through field implementation capturing unsupported types.
- * @tparam  T   The wrapped type.
+ * @brief   `PtrGetter` functor forwarding to a getter shared by all instances of a wrapper type.
+ *          
+ * Creating a field with a `SharedGetter` just stores a pointer rather than constructing a new
+ * type-erased getter. Use `REMODEL_SHARED_GETTER` to create instances.
  */
-template<typename T, typename = void>
-class FieldImpl
+class SharedGetter
 {
-    static_assert(BlackBoxConsts<T>::kFalse, "this types is not supported for wrapping");
+    const internal::DefaultPtrGetter* m_getter;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   getter  The shared getter, has to outlive all fields using it.
+     */
+    explicit SharedGetter(const internal::DefaultPtrGetter& getter)
+        : m_getter{&getter}
+    {}
+
+    /**
+     * @brief   Gets the shared getter.
+     * @return  The shared getter.
+     */
+    const internal::DefaultPtrGetter& getter() const { return *m_getter; }
+
+    void* operator () (void* raw) const
+    {
+        return (*m_getter)(raw);
+    }
 };
 
+/**
+ * @brief   Creates a `SharedGetter` from a `PtrGetter` expression that is evaluated only once.
+ * @param   ... The `PtrGetter` expression, e.g. `OffsGetter{0x10}`.
+ *              
+ * The expression is evaluated when the first wrapper containing the field is created, all
+ * further wrappers of the same type share the resulting getter.
+ */
+#define REMODEL_SHARED_GETTER(...)                                                                 \
+    ::remodel::SharedGetter{[]() -> const ::remodel::internal::DefaultPtrGetter& {                 \
+        static const ::remodel::internal::DefaultPtrGetter getter{__VA_ARGS__};                    \
+        return getter;                                                                             \
+    }()}
+
 // ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] for arithmetic types + enums                                                       //
+// [GetterTable]                                                                                  //
 // ---------------------------------------------------------------------------------------------- //
 
 /**
- * @internal
- * @brief   Field implementation capturing arithmetic types and enums.
- * @tparam  T   The wrapped type.
+ * @brief   Table of `PtrGetter`s shared by all instances of a wrapper type.
+ * @tparam  sizeT   The amount of getters in the table.
+ *                  
+ * Tables are usually declared using `REMODEL_GETTER_TABLE`, with fields and functions referring
+ * to their entries by index.
  */
-template<typename T>
-class FieldImpl<T, std::enable_if_t<
-        std::is_arithmetic<T>::value 
-        // Enum classes do not implicitly convert to int, enums do. We use that for filtering.
-        || (std::is_enum<T>::value && std::is_convertible<T, int>::value)
-    >>
-    : public FieldBase
-    , public operators::ForwardByFlags<
-        FieldImpl<T>, 
-        T, 
-        (operators::ARITHMETIC | operators::BITWISE | operators::COMMA | operators::COMPARE) 
-            & ~(std::is_floating_point<T>::value ? operators::BITWISE_NOT : 0)
-            & ~(std::is_unsigned<T>::value ? operators::UNARY_MINUS : 0)
-            & ~(std::is_enum<T>::value ? operators::INCREMENT | operators::DECREMENT : 0)
-            & ~(std::is_same<T, bool>::value ? 
-                operators::INCREMENT | operators::DECREMENT | operators::BITWISE_NOT : 0
-                )
-    >
+template<std::size_t sizeT>
+class GetterTable
 {
-    REMODEL_FIELDIMPL_FORWARD_CTORS
-};
+    internal::DefaultPtrGetter m_getters[sizeT];
+public:
+    static const std::size_t kSize = sizeT;
 
-// ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] for arrays                                                                         //
-// ---------------------------------------------------------------------------------------------- //
+    /**
+     * @brief   Constructor.
+     * @tparam  GettersT    The getter types.
+     * @param   getters     The getters to store in the table.
+     */
+    template<typename... GettersT>
+    explicit GetterTable(GettersT&&... getters)
+        : m_getters{internal::DefaultPtrGetter{std::forward<GettersT>(getters)}...}
+    {
+        static_assert(sizeof...(GettersT) == sizeT, "getter count mismatch");
+    }
+
+    /**
+     * @brief   Obtains a `SharedGetter` referring to an entry of the table.
+     * @param   idx The index of the entry.
+     * @return  The `SharedGetter`.
+     */
+    SharedGetter operator [] (std::size_t idx) const
+    {
+        return SharedGetter{m_getters[idx]};
+    }
+};
 
 /**
- * @internal
- * @brief   Field implementation capturing arrays.
- * @tparam  T   The wrapped type.
+ * @brief   Creates a `GetterTable` from a list of `PtrGetter`s.
+ * @tparam  GettersT    The getter types.
+ * @param   getters     The getters to store in the table.
+ * @return  The table.
  */
-template<typename T>
-class FieldImpl<T, std::enable_if_t<std::is_array<T>::value>>
-    : public FieldBase
-    , public operators::ForwardByFlags<
-        FieldImpl<T>,
-        T,
-        operators::ARRAY_SUBSCRIPT 
-            | operators::INDIRECTION 
-            | operators::SUBTRACT
-            | operators::ADD
-            | operators::COMMA
-            | (std::is_class<T>::value ? operators::STRUCT_DEREFERENCE : 0)
-    >
+template<typename... GettersT>
+inline GetterTable<sizeof...(GettersT)> makeGetterTable(GettersT&&... getters)
 {
-    REMODEL_FIELDIMPL_FORWARD_CTORS
-    static_assert(!std::is_base_of<ClassWrapper, T>::value, "internal library error");
-};
+    return GetterTable<sizeof...(GettersT)>{std::forward<GettersT>(getters)...};
+}
+
+/**
+ * @brief   Declares a static function returning a `GetterTable` that is built only once.
+ * @param   name    The name of the function.
+ * @param   ...     The `PtrGetter` expressions to store in the table.
+ *                  
+ * Intended to be used inside of wrapper declarations, sharing the getters among all instances.
+ * @code
+ *      class Dog : public ClassWrapper
+ *      {
+ *          REMODEL_WRAPPER(Dog)
+ *          REMODEL_GETTER_TABLE(getters, OffsGetter{124}, VfTableGetter{1})
+ *      public:
+ *          SharedField<uint8_t> age{this, getters()[0]};
+ *          MemberFunction<void (*)(int), SharedGetter> giveGoodie{this, getters()[1]};
+ *      };
+ * @endcode
+ */
+#define REMODEL_GETTER_TABLE(name, ...)                                                            \
+    static const decltype(::remodel::makeGetterTable(__VA_ARGS__))& name()                        \
+    {                                                                                              \
+        static const auto table = ::remodel::makeGetterTable(__VA_ARGS__);                         \
+        return table;                                                                              \
+    }
+
+// ============================================================================================== //
+// Helper class(es) to create wrappers from raw pointers                                          //
+// ============================================================================================== //
 
 // ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] for structs/classes                                                                //
+// [WrapperPtr]                                                                                   //
 // ---------------------------------------------------------------------------------------------- //
 
+namespace internal
+{
+
 /**
  * @internal
- * @brief   Field implementation capturing `class` and `struct` types.
- * @tparam  T   The wrapped type.
+ * @brief   Weak wrapper fall-through capturing invalid instantiations.
+ * @tparam  WrapperT    Wrapper type.
  */
-template<typename T>
-class FieldImpl<T, std::enable_if_t<std::is_class<T>::value>>
-    : public FieldBase
-    , public operators::Comma<FieldImpl<T>, T>
+template<typename WrapperT, typename = void>
+class WeakWrapperImpl
 {
-    REMODEL_FIELDIMPL_FORWARD_CTORS
-    static_assert(std::is_trivial<T>::value, "wrapping is only supported for trivial types");
-    static_assert(!std::is_base_of<ClassWrapper, T>::value, "internal library error");
-public:
-    // C++ does not allow overloading the dot operator (yet), so we provide an -> operator behaving
-    // like the dot operator instead plus a more verbose syntax using the get() function.
-    T& get()                            { return this->valueRef(); }
-    const T& get() const                { return this->valueCRef(); }
-    T* operator -> ()                   { return &get(); }
-    const T* operator -> () const       { return &get(); }
+    static_assert(BlackBoxConsts<WrapperT>::kFalse,
+        "WeakWrapper can only be created for AdvancedClassWrappers");
 };
 
-// ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] for enums/enum classes                                                             //
-// ---------------------------------------------------------------------------------------------- //
-
 /**
  * @internal
- * @brief   Field implementation capturing `enum class` types.
- * @tparam  T   The wrapped type.
+ * @brief   Weak wrapper implementation capturing correct instantiations.
+ * @tparam  WrapperT    Wrapper type derived from `AdvancedClassWrapper`.
  */
-template<typename T>
-class FieldImpl<T, std::enable_if_t<
-        // Enum classes do not implicitly convert to int, enums do. We use that for filtering.
-        std::is_enum<T>::value && !std::is_convertible<T, int>::value
-    >>
-    : public FieldBase
-    , public operators::Comma<FieldImpl<T>, T>
+template<typename WrapperT>
+class WeakWrapperImpl<WrapperT, typename WrapperT::IsAdvWrapper /* manual SFINAE */>
 {
-    REMODEL_FIELDIMPL_FORWARD_CTORS
+    alignas(WrapperT::kObjAlign) uint8_t m_dummy[WrapperT::kObjSize];
+protected:
+    /**
+     * @brief   Default constructor.
+     */
+    WeakWrapperImpl() = default;
 public:
-    // Nothing to do here!
+    /**
+     * @brief   Gets the raw pointer 
+     * @return  The raw pointer.
+     */
+    void* raw() { return this; }
+
+    /**
+     * @brief   Converts this weak wrapper to a strong ("normal") one.
+     * @return  A strong wrapper.
+     */
+    WrapperT toStrong() { return wrapper_cast<WrapperT>(this); }
+
+    /**
+     * @brief   Accesses a field described by a `FieldDesc`, without creating a strong wrapper.
+     * @param   desc    The field descriptor.
+     * @return  A reference to the field.
+     */
+    template<typename T, std::ptrdiff_t offsT>
+    typename FieldDesc<T, offsT>::Type& get(FieldDesc<T, offsT> /*desc*/)
+    {
+        return FieldDesc<T, offsT>::get(raw());
+    }
+
+    /**
+     * @copydoc get(FieldDesc<T, offsT>)
+     */
+    template<typename T, std::ptrdiff_t offsT>
+    const typename FieldDesc<T, offsT>::Type& get(FieldDesc<T, offsT> /*desc*/) const
+    {
+        return FieldDesc<T, offsT>::get(static_cast<const void*>(this));
+    }
+
+    /**
+     * @brief   Accesses a `StaticField` member of the wrapper, without creating a strong wrapper.
+     * @param   field   The member, e.g. `&Cat::age`.
+     * @return  A reference to the field.
+     *          
+     * The offset is taken from the type of the member, the access compiles to a plain load or 
+     * store, just like one through a pointer to a native struct. Loops over `Weak*` arrays (e.g. 
+     * `WrapperSpan::data()`) thus don't pay for any wrapper:
+     * 
+     * @code
+     *      Cat::Weak* cats = ...;
+     *      for (std::size_t i = 0; i < count; ++i) cats[i].get(&Cat::age) += 1;
+     * @endcode
+     */
+    template<typename T, std::ptrdiff_t offsT, typename OwnerT>
+    typename FieldDesc<T, offsT>::Type& get(StaticField<T, offsT> OwnerT::* /*field*/)
+    {
+        static_assert(std::is_base_of<OwnerT, WrapperT>::value, 
+            "the field is not a member of the wrapper");
+        return FieldDesc<T, offsT>::get(raw());
+    }
+
+    /**
+     * @copydoc get(StaticField<T, offsT> OwnerT::*)
+     */
+    template<typename T, std::ptrdiff_t offsT, typename OwnerT>
+    const typename FieldDesc<T, offsT>::Type& get(StaticField<T, offsT> OwnerT::* /*field*/) const
+    {
+        static_assert(std::is_base_of<OwnerT, WrapperT>::value, 
+            "the field is not a member of the wrapper");
+        return FieldDesc<T, offsT>::get(static_cast<const void*>(this));
+    }
+
+    /**
+     * @brief   Hints the CPU to fetch all cache lines spanned by the object.
+     */
+    void prefetch() const { platform::prefetchRange(this, WrapperT::kObjSize); }
 };
+ 
+} // namespace internal
+
+/**
+ * @brief   Weak wrapper helper type.
+ * @tparam  WrapperT    Type of the strong wrapper to create a weak wrapper for.
+ *                      
+ * Other than with normal wrappers, the `this` pointer of this class points to the actual object
+ * which allows creation of raw pointers to weak wrappers which is useful when defining functions
+ * that take pointers to wrapped types. Weak wrappers can then be evolved to strong wrappers
+ * with a simple `toStrong` invocation. Fields with compile-time offsets (`StaticField` members, 
+ * `FieldDesc`s) can be accessed through `get` directly. As weak wrappers have the size of the
+ * wrapped object, `Weak*` pointer arithmetic steps from object to object.
+ */
+template<typename WrapperT>
+struct WeakWrapper final : internal::WeakWrapperImpl<WrapperT> {};
+
+// Verify assumptions about this class.
+static_assert(std::is_trivial<WeakWrapper<AdvancedClassWrapper<sizeof(int)>>>::value, 
+    "internal library error");
+static_assert(sizeof(int) == sizeof(WeakWrapper<AdvancedClassWrapper<sizeof(int)>>), 
+    "internal library error");
+static_assert(alignof(WeakWrapper<AdvancedClassWrapper<16, 16>>) == 16, "internal library error");
+
+// ============================================================================================== //
+// Abstract field object implementation                                                           //
+// ============================================================================================== //
 
 // ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] for pointers                                                                       //
+// [FieldBase]                                                                                    //
 // ---------------------------------------------------------------------------------------------- //
 
+namespace internal
+{ 
+
 /**
  * @internal
- * @brief   Field implementation capturing pointers.
- * @tparam  T   The wrapped type.
+ * @brief   Base class for all kinds of wrapper-fields.
  */
-template<typename T>
-// We capture pointers with enable_if to maintain the CV-qualifiers on the pointer itself.
-class FieldImpl<T, std::enable_if_t<std::is_pointer<T>::value>>
-    : public FieldBase
-    , public operators::ForwardByFlags<
-        FieldImpl<T>,
-        T,
-        operators::ARRAY_SUBSCRIPT 
-            // Indirection operator is forwarded through implicit conversion operator.
-            // Explicit implementation disabled due to decltype bug in MSVC.
-            //| (std::is_void<std::remove_pointer_t<T>>::value ? 0 : operators::INDIRECTION)
-            | operators::SUBTRACT
-            | operators::ADD
-            | operators::COMMA
-            | (std::is_class<std::remove_pointer_t<T>>::value ? operators::STRUCT_DEREFERENCE : 0)
-    >
+class FieldBase
 {
-    REMODEL_FIELDIMPL_FORWARD_CTORS
-};
+protected:
+    /**
+     * @brief   Constructor.
+     * @param   parent      If non-null, the parent.
+     */
+    constexpr explicit FieldBase(ClassWrapper* parent)
+        : m_parent{parent}
+    {}
 
-// ---------------------------------------------------------------------------------------------- //
-// [FieldImpl] for rvalue-references                                                              //
-// ---------------------------------------------------------------------------------------------- //
+    /**
+     * @brief   Deleted copy constructor.
+     */
+    FieldBase(const FieldBase&) = delete;
+
+    /**
+     * @brief   Move constructor, used when moving the parent wrapper.
+     * @param   other   The field to move from.
+     *                  
+     * Fields are members of their parent (or of an object holding it), so the parent moved by 
+     * the same distance as the field and the field is retargeted accordingly, no matter how 
+     * deeply wrappers are nested. Fields with `Global` (or no) parent keep it. Fields with 
+     * other parents must not be moved without them.
+     */
+    FieldBase(FieldBase&& other) noexcept
+        : m_parent{other.m_parent}
+#       ifdef REMODEL_INSTRUMENT
+            , m_instrumentId{other.m_instrumentId}
+#       endif
+    {
+        if (m_parent && !isGlobalWrapper(m_parent))
+        {
+            m_parent = reinterpret_cast<ClassWrapper*>(reinterpret_cast<char*>(m_parent) 
+                + (reinterpret_cast<char*>(this) - reinterpret_cast<char*>(&other)));
+        }
+    }
+
+    /**
+     * @brief   Deleted assignment operator.
+     * @note    This is just here as an assertation so internal code cannot copy fields by 
+     *          accident. The concrete implementation hides this operator in favor of an operator
+     *          that copies the data wrapped by one proxy object to another (emulating normal
+     *          assignment semantics).
+     */
+    FieldBase& operator = (const FieldBase&) = delete;
+
+    /**
+     * @brief   Gets a pointer to the parent of this field.
+     * @return  The parent.
+     */
+    ClassWrapper* parent() { return m_parent; }
+
+    /**
+     * @brief   Gets a constant pointer to the parent of this field.
+     * @return  The parent.
+     */
+    const ClassWrapper* parent() const { return m_parent; }
+
+    /**
+     * @brief   Obtains the raw pointer of the parent wrapper.
+     * @return  The parent's raw pointer or @c nullptr if this field has no parent.
+     */
+    void* parentRaw() const
+    {
+        return this->m_parent ? this->m_parent->m_raw : nullptr;
+    }
+
+#   ifdef REMODEL_INSTRUMENT
+        /**
+         * @brief   Gets the offset of this field inside of its parent wrapper.
+         * @return  The offset, -1 if this field has no parent.
+         */
+        std::ptrdiff_t memberOffset() const
+        {
+            return m_parent ? reinterpret_cast<const char*>(this) 
+                - reinterpret_cast<const char*>(m_parent) : -1;
+        }
+#   endif
+
+    /**   
+     * @brief   Destructor.
+     */
+    ~FieldBase() = default;
+protected:
+    ClassWrapper* m_parent;
+#   ifdef REMODEL_INSTRUMENT
+        /// The ID of the declaration site, see `Instrument.hpp`.
+        uint32_t m_instrumentId = 0;
+#   endif
+};
 
 /**
  * @internal
- * @brief   Field implementation capturing rvalue-references.
- * @tparam  T   The wrapped type.
- * @warning Wrapping rvalue-references is not supported. If you shoud ever find any real-world
- *          use case for wrapping rvalue-references, feel free to contact me.
+ * @brief   Stores a `PtrGetter` as a member.
+ * @tparam  PtrGetterT  Type of the `PtrGetter`.
  */
-template<typename T>
-class FieldImpl<T&&>
+template<typename PtrGetterT, bool isEmptyT = std::is_empty<PtrGetterT>::value 
+    && !std::is_final<PtrGetterT>::value>
+class GetterStorage
 {
-    static_assert(BlackBoxConsts<T>::kFalse, "rvalue-reference-fields are not supported");
-};
-
-#undef REMODEL_FIELDIMPL_FORWARD_CTORS
+protected:
+    constexpr explicit GetterStorage(PtrGetterT ptrGetter)
+        : m_ptrGetter(std::move(ptrGetter)) // Parentheses: getters may be aggregates.
+    {}
 
-// ---------------------------------------------------------------------------------------------- //
-// [RewriteWrappers] + helper types                                                               //
-// ---------------------------------------------------------------------------------------------- //
+    PtrGetterT& ptrGetterRef()              { return m_ptrGetter; }
+    const PtrGetterT& ptrGetterRef() const  { return m_ptrGetter; }
+private:
+    PtrGetterT m_ptrGetter;
+};
 
-// Step 3: Implementation capturing simple wrapper types.
-template<typename BaseTypeT, typename QualifierStackT, typename = void>
-struct RewriteWrappersStep3
+/**
+ * @internal
+ * @brief   Stores a stateless `PtrGetter` (e.g. a capture-less lambda) as a base, taking no space.
+ * @tparam  PtrGetterT  Type of the `PtrGetter`.
+ */
+template<typename PtrGetterT>
+class GetterStorage<PtrGetterT, true> : private PtrGetterT
 {
-    static_assert(BlackBoxConsts<QualifierStackT>::kFalse,
-        "using wrapped types in fields requires usage of AdvancedClassWrapper as base");
+protected:
+    constexpr explicit GetterStorage(PtrGetterT ptrGetter)
+        : PtrGetterT(std::move(ptrGetter))
+    {}
+
+    PtrGetterT& ptrGetterRef()              { return *this; }
+    const PtrGetterT& ptrGetterRef() const  { return *this; }
 };
 
-// Step 3: Implementation capturing advanced wrapper types (manual SFINAE).
-template<typename BaseTypeT, typename QualifierStackT>
+/**
+ * @internal
+ * @brief   Field base storing a `PtrGetter` used for address calculation.
+ * @tparam  PtrGetterT  Type of the `PtrGetter`.
+ *                      
+ * Besides the type-erased default, any callable type taking and returning `void*` can be used,
+ * e.g. lambdas or custom functors. These are stored inline (stateless ones taking no space at 
+ * all) and their calls can be inlined into the field accesses.
+ */
+template<typename PtrGetterT = DefaultPtrGetter>
+class GetterFieldBase 
+    : public FieldBase
+    , private GetterStorage<PtrGetterT>
+{
+    using Storage = GetterStorage<PtrGetterT>;
+protected:
+    /**
+     * @brief   Definition of the prototype for pointer-getters.
+     */
+    using PtrGetter = PtrGetterT;
+
+    /**
+     * @brief   Constructor.
+     * @param   parent      If non-null, the parent.
+     * @param   ptrGetter   A `PtrGetter` calculating the actual offset of the proxied object.
+     */
+    constexpr GetterFieldBase(ClassWrapper* parent, PtrGetter ptrGetter)
+        : FieldBase{parent}
+        , Storage{std::move(ptrGetter)}
+    {}
+
+    /**
+     * @brief   Gets the `PtrGetter` used for address calculation.
+     * @return  The used `PtrGetter`.
+     */
+    const PtrGetter& ptrGetter() const { return this->ptrGetterRef(); }
+
+    /**
+     * @brief   Gets the `PtrGetter` used for address calculation, e.g. to update its state.
+     * @return  The used `PtrGetter`.
+     */
+    PtrGetter& mutablePtrGetter() { return this->ptrGetterRef(); }
+
+    /**
+     * @brief   Obtains a pointer to the raw object using the `PtrGetter`.
+     * @return  The requested pointer.
+     */
+    void* rawPtr()
+    {
+        return this->ptrGetterRef()(this->parentRaw());
+    }
+
+    /**
+     * @brief   Obtains a constant pointer to the raw object using the `PtrGetter`.
+     * @return  The requested pointer.
+     */
+    const void* crawPtr() const
+    {
+        return this->ptrGetterRef()(this->parentRaw());
+    }
+};
+
+/**
+ * @internal
+ * @brief   Field base specialization for compile-time offsets.
+ * @tparam  offsT   The offset of the field.
+ *                  
+ * Fields with compile-time offsets are always members of a wrapper, so the parent is never null
+ * and no getter state has to be stored at all.
+ */
+template<std::ptrdiff_t offsT>
+class GetterFieldBase<StaticOffsGetter<offsT>> : public FieldBase
+{
+protected:
+    using PtrGetter = StaticOffsGetter<offsT>;
+
+    /**
+     * @brief   Constructor.
+     * @param   parent  The parent, must not be null.
+     */
+    explicit GetterFieldBase(ClassWrapper* parent)
+        : FieldBase{parent}
+    {}
+
+    /**
+     * @copydoc GetterFieldBase::ptrGetter
+     */
+    PtrGetter ptrGetter() const { return PtrGetter{}; }
+
+    /**
+     * @copydoc GetterFieldBase::rawPtr
+     */
+    void* rawPtr()
+    {
+        return PtrGetter{}(this->m_parent->addressOfObj());
+    }
+
+    /**
+     * @copydoc GetterFieldBase::crawPtr
+     */
+    const void* crawPtr() const
+    {
+        return PtrGetter{}(this->m_parent->addressOfObj());
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [StaticOperatorForwarder]                                                                      //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Statically dispatched counterpart of `operators::AbstractOperatorForwarder`.
+ * @tparam  DerivedT    The class implementing `valueRef` and `valueCRef` (CRTP).
+ * @tparam  T           The wrapped type.
+ *                      
+ * Fields using a concrete `PtrGetter` type forward their operators through this class instead
+ * of the virtual zycore forwarders, so no vftable is required and accesses can be fully inlined.
+ */
+template<typename DerivedT, typename T>
+class StaticOperatorForwarder
+{
+protected:
+    /**
+     * @brief   Obtains a reference to the wrapped object from the derived class.
+     * @return  The reference to the wrapped object.
+     */
+    T& valueRef() { return static_cast<DerivedT*>(this)->valueRef(); }
+
+    /**
+     * @copydoc valueRef
+     */
+    const T& valueCRef() const { return static_cast<const DerivedT*>(this)->valueCRef(); }
+};
+
+/**
+ * @internal
+ * @brief   Statically dispatched counterpart of `operators::Comma`.
+ * @tparam  DerivedT    The class implementing `valueRef` and `valueCRef` (CRTP).
+ * @tparam  T           The wrapped type.
+ * @note    The built-in comma operator already behaves as desired for all types wrapped using 
+ *          this class, so nothing is forwarded here.
+ */
+template<typename DerivedT, typename T>
+class StaticComma : public StaticOperatorForwarder<DerivedT, T> {};
+
+// Binary and compound assignment operators, constrained on one of the flags in `flagMask`.
+#define REMODEL_STATIC_FORWARD_BINARY(op, flagMask)                                                \
+    template<typename RhsT, unsigned flags2T = flagsT,                                             \
+        typename = std::enable_if_t<(flags2T & (flagMask)) != 0>>                                  \
+    auto operator op (RhsT&& rhs)                                                                  \
+        -> decltype(std::declval<T&>() op std::forward<RhsT>(rhs))                                 \
+    {                                                                                              \
+        return this->valueRef() op std::forward<RhsT>(rhs);                                        \
+    }                                                                                              \
+                                                                                                   \
+    template<typename RhsT, unsigned flags2T = flagsT,                                             \
+        typename = std::enable_if_t<(flags2T & (flagMask)) != 0>>                                  \
+    auto operator op (RhsT&& rhs) const                                                            \
+        -> decltype(std::declval<const T&>() op std::forward<RhsT>(rhs))                           \
+    {                                                                                              \
+        return this->valueCRef() op std::forward<RhsT>(rhs);                                       \
+    }
+
+// Prefix unary operators not modifying the wrapped object.
+#define REMODEL_STATIC_FORWARD_UNARY(op, flagMask)                                                 \
+    template<typename U = T, unsigned flags2T = flagsT,                                            \
+        typename = std::enable_if_t<(flags2T & (flagMask)) != 0>>                                  \
+    auto operator op () const -> decltype(op std::declval<const U&>())                            \
+    {                                                                                              \
+        return op this->valueCRef();                                                               \
+    }
+
+// Increment and decrement operators, prefix and postfix.
+#define REMODEL_STATIC_FORWARD_INCDEC(op, flagMask)                                                \
+    template<typename U = T, unsigned flags2T = flagsT,                                            \
+        typename = std::enable_if_t<(flags2T & (flagMask)) != 0>>                                  \
+    auto operator op () -> decltype(op std::declval<U&>())                                         \
+    {                                                                                              \
+        return op this->valueRef();                                                                \
+    }                                                                                              \
+                                                                                                   \
+    template<typename U = T, unsigned flags2T = flagsT,                                            \
+        typename = std::enable_if_t<(flags2T & (flagMask)) != 0>>                                  \
+    auto operator op (int) -> decltype(std::declval<U&>() op)                                      \
+    {                                                                                              \
+        return this->valueRef() op;                                                                \
+    }
+
+/**
+ * @internal
+ * @brief   Statically dispatched counterpart of `operators::ForwardByFlags`.
+ * @tparam  DerivedT    The class implementing `valueRef` and `valueCRef` (CRTP).
+ * @tparam  T           The wrapped type.
+ * @tparam  flagsT      The operators to forward, a combination of the `operators` flags.
+ */
+template<typename DerivedT, typename T, unsigned flagsT>
+class StaticForwardByFlags : public StaticOperatorForwarder<DerivedT, T>
+{
+    static const unsigned kOtherArithmetic = operators::ARITHMETIC 
+        & ~(operators::ADD | operators::SUBTRACT | operators::UNARY_MINUS 
+            | operators::INCREMENT | operators::DECREMENT);
+    static const unsigned kBinaryBitwise = operators::BITWISE & ~operators::BITWISE_NOT;
+public:
+    REMODEL_STATIC_FORWARD_BINARY(+,   operators::ADD)
+    REMODEL_STATIC_FORWARD_BINARY(+=,  operators::ADD)
+    REMODEL_STATIC_FORWARD_BINARY(-,   operators::SUBTRACT)
+    REMODEL_STATIC_FORWARD_BINARY(-=,  operators::SUBTRACT)
+    REMODEL_STATIC_FORWARD_BINARY(*,   kOtherArithmetic)
+    REMODEL_STATIC_FORWARD_BINARY(*=,  kOtherArithmetic)
+    REMODEL_STATIC_FORWARD_BINARY(/,   kOtherArithmetic)
+    REMODEL_STATIC_FORWARD_BINARY(/=,  kOtherArithmetic)
+    REMODEL_STATIC_FORWARD_BINARY(%,   kOtherArithmetic)
+    REMODEL_STATIC_FORWARD_BINARY(%=,  kOtherArithmetic)
+    REMODEL_STATIC_FORWARD_BINARY(&,   kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(&=,  kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(|,   kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(|=,  kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(^,   kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(^=,  kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(<<,  kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(<<=, kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(>>,  kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(>>=, kBinaryBitwise)
+    REMODEL_STATIC_FORWARD_BINARY(==,  operators::COMPARE)
+    REMODEL_STATIC_FORWARD_BINARY(!=,  operators::COMPARE)
+    REMODEL_STATIC_FORWARD_BINARY(<,   operators::COMPARE)
+    REMODEL_STATIC_FORWARD_BINARY(<=,  operators::COMPARE)
+    REMODEL_STATIC_FORWARD_BINARY(>,   operators::COMPARE)
+    REMODEL_STATIC_FORWARD_BINARY(>=,  operators::COMPARE)
+
+    REMODEL_STATIC_FORWARD_UNARY(-, operators::UNARY_MINUS)
+    REMODEL_STATIC_FORWARD_UNARY(+, operators::ARITHMETIC)
+    REMODEL_STATIC_FORWARD_UNARY(~, operators::BITWISE_NOT)
+
+    REMODEL_STATIC_FORWARD_INCDEC(++, operators::INCREMENT)
+    REMODEL_STATIC_FORWARD_INCDEC(--, operators::DECREMENT)
+
+    template<typename IdxT, unsigned flags2T = flagsT, 
+        typename = std::enable_if_t<(flags2T & operators::ARRAY_SUBSCRIPT) != 0>>
+    auto operator [] (IdxT&& idx) -> decltype(std::declval<T&>()[std::forward<IdxT>(idx)])
+    {
+        return this->valueRef()[std::forward<IdxT>(idx)];
+    }
+
+    template<typename IdxT, unsigned flags2T = flagsT, 
+        typename = std::enable_if_t<(flags2T & operators::ARRAY_SUBSCRIPT) != 0>>
+    auto operator [] (IdxT&& idx) const 
+        -> decltype(std::declval<const T&>()[std::forward<IdxT>(idx)])
+    {
+        return this->valueCRef()[std::forward<IdxT>(idx)];
+    }
+
+    template<typename U = T, unsigned flags2T = flagsT, 
+        typename = std::enable_if_t<(flags2T & operators::INDIRECTION) != 0>>
+    auto operator * () -> decltype(*std::declval<U&>())
+    {
+        return *this->valueRef();
+    }
+
+    template<typename U = T, unsigned flags2T = flagsT, 
+        typename = std::enable_if_t<(flags2T & operators::INDIRECTION) != 0>>
+    auto operator * () const -> decltype(*std::declval<const U&>())
+    {
+        return *this->valueCRef();
+    }
+
+    template<typename U = T, unsigned flags2T = flagsT, 
+        typename = std::enable_if_t<(flags2T & operators::STRUCT_DEREFERENCE) != 0>>
+    std::decay_t<U> operator -> ()
+    {
+        return this->valueRef();
+    }
+
+    template<typename U = T, unsigned flags2T = flagsT, 
+        typename = std::enable_if_t<(flags2T & operators::STRUCT_DEREFERENCE) != 0>>
+    std::decay_t<const U> operator -> () const
+    {
+        return this->valueCRef();
+    }
+};
+
+#undef REMODEL_STATIC_FORWARD_BINARY
+#undef REMODEL_STATIC_FORWARD_UNARY
+#undef REMODEL_STATIC_FORWARD_INCDEC
+
+/**
+ * @internal
+ * @brief   Determines whether fields using a `PtrGetter` type dispatch their operators statically.
+ * @tparam  PtrGetterT  Type of the `PtrGetter`.
+ *                      
+ * Only the type-erased `DefaultPtrGetter` keeps using the virtual zycore forwarders, all concrete
+ * getter types use the `Static*` forwarders above.
+ */
+template<typename PtrGetterT>
+struct UsesStaticDispatch
+    : std::integral_constant<bool, !std::is_same<PtrGetterT, DefaultPtrGetter>::value>
+{};
+
+/**
+ * @internal
+ * @brief   Selects the `ForwardByFlags` implementation for a field.
+ * @tparam  ImplT       The `FieldImpl` (base for the virtual forwarder).
+ * @tparam  DerivedT    The class implementing `valueRef` and `valueCRef`.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used by the field.
+ * @tparam  T           The wrapped type.
+ * @tparam  flagsT      The operators to forward.
+ */
+template<typename ImplT, typename DerivedT, typename PtrGetterT, typename T, unsigned flagsT>
+using FieldForwardByFlags = std::conditional_t<
+    UsesStaticDispatch<PtrGetterT>::value,
+    StaticForwardByFlags<DerivedT, T, flagsT>,
+    operators::ForwardByFlags<ImplT, T, flagsT>
+>;
+
+/**
+ * @internal
+ * @brief   Selects the `Comma` implementation for a field.
+ * @copydetails FieldForwardByFlags
+ */
+template<typename ImplT, typename DerivedT, typename PtrGetterT, typename T>
+using FieldComma = std::conditional_t<
+    UsesStaticDispatch<PtrGetterT>::value,
+    StaticComma<DerivedT, T>,
+    operators::Comma<ImplT, T>
+>;
+
+// ============================================================================================== //
+// Concrete field object implementation                                                           //
+// ============================================================================================== //
+
+/*
+ * +-----------------------------+-------------------------------------------------+-----------+
+ * | type                        | example(s)                                      | supported |
+ * +-----------------------------+-------------------------------------------------+-----------+
+ * | arithmetic types            | int, float, bool, size_t                        | yes       |
+ * | trivial structs/classes     | struct A { int b; };                            | yes       |
+ * | non-trivial structs/classes | struct A { virtual void b() {} };               | no        |
+ * | enums                       | enum A { B = 0 };                               | yes       |
+ * | enum classes                | enum class A { B = 0 };                         | yes       |
+ * | wrapped classes             | struct A : ClassWrapper { REMODEL_WRAPPER(A) }; | yes       |
+ * | functions                   | void a();                                       | yes       |
+ * | virtual functions           | virtual void a();                               | yes       |
+ * +-----------------------------+-------------------------------------------------+-----------+
+ *
+ * +-----------+-----------+--------------------------------------+
+ * | qualifier | supported | notes                                |
+ * + ----------+-----------+--------------------------------------+
+ * | *         | yes       |                                      |
+ * | &         | yes       | expects implementation of ref as ptr |
+ * | &&        | no        | doesn't make any sense to wrap       |
+ * | []        | yes       |                                      |
+ * | [N]       | yes       |                                      |
+ * +-----------+-----------+--------------------------------------+
+ */
+
+#define REMODEL_FIELDIMPL_FORWARD_CTORS                                                            \
+    public:                                                                                        \
+        constexpr FieldImpl(ClassWrapper *parent, PtrGetterT ptrGetter)                            \
+            : GetterFieldBase<PtrGetterT>{parent, ptrGetter}                                       \
+        {}                                                                                         \
+                                                                                                   \
+        explicit FieldImpl(ClassWrapper *parent)                                                   \
+            : GetterFieldBase<PtrGetterT>{parent}                                                  \
+        {}                                                                                         \
+                                                                                                   \
+        explicit FieldImpl(const FieldImpl& other)                                                 \
+            : GetterFieldBase<PtrGetterT>{other}                                                   \
+        {}                                                                                         \
+                                                                                                   \
+        FieldImpl(FieldImpl&& other) = default;                                                    \
+    private:
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] fall-through implementation                                                        //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Fall-through field implementation capturing unsupported types.
+ * @tparam  T           The wrapped type.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ * @tparam  DerivedT    The field class deriving from this (CRTP, for static dispatch).
+ */
+template<typename T, typename PtrGetterT, typename DerivedT, typename = void>
+class FieldImpl
+{
+    static_assert(BlackBoxConsts<T>::kFalse, "this types is not supported for wrapping");
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] for arithmetic types + enums                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Field implementation capturing arithmetic types and enums.
+ * @tparam  T           The wrapped type.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ * @tparam  DerivedT    The field class deriving from this (CRTP, for static dispatch).
+ */
+template<typename T, typename PtrGetterT, typename DerivedT>
+class FieldImpl<T, PtrGetterT, DerivedT, std::enable_if_t<
+        std::is_arithmetic<T>::value 
+        // Enum classes do not implicitly convert to int, enums do. We use that for filtering.
+        || (std::is_enum<T>::value && std::is_convertible<T, int>::value)
+    >>
+    : public GetterFieldBase<PtrGetterT>
+    , public FieldForwardByFlags<
+        FieldImpl<T, PtrGetterT, DerivedT>, 
+        DerivedT,
+        PtrGetterT,
+        T, 
+        (operators::ARITHMETIC | operators::BITWISE | operators::COMMA | operators::COMPARE) 
+            & ~(std::is_floating_point<T>::value ? operators::BITWISE_NOT : 0)
+            & ~(std::is_unsigned<T>::value ? operators::UNARY_MINUS : 0)
+            & ~(std::is_enum<T>::value ? operators::INCREMENT | operators::DECREMENT : 0)
+            & ~(std::is_same<T, bool>::value ? 
+                operators::INCREMENT | operators::DECREMENT | operators::BITWISE_NOT : 0
+                )
+    >
+{
+    REMODEL_FIELDIMPL_FORWARD_CTORS
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] for arrays                                                                         //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Field implementation capturing arrays.
+ * @tparam  T           The wrapped type.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ * @tparam  DerivedT    The field class deriving from this (CRTP, for static dispatch).
+ */
+template<typename T, typename PtrGetterT, typename DerivedT>
+class FieldImpl<T, PtrGetterT, DerivedT, std::enable_if_t<std::is_array<T>::value>>
+    : public GetterFieldBase<PtrGetterT>
+    , public FieldForwardByFlags<
+        FieldImpl<T, PtrGetterT, DerivedT>,
+        DerivedT,
+        PtrGetterT,
+        T,
+        operators::ARRAY_SUBSCRIPT 
+            | operators::INDIRECTION 
+            | operators::SUBTRACT
+            | operators::ADD
+            | operators::COMMA
+            | (std::is_class<T>::value ? operators::STRUCT_DEREFERENCE : 0)
+    >
+{
+    REMODEL_FIELDIMPL_FORWARD_CTORS
+    static_assert(!std::is_base_of<ClassWrapper, T>::value, "internal library error");
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] for structs/classes                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Field implementation capturing `class` and `struct` types.
+ * @tparam  T           The wrapped type.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ * @tparam  DerivedT    The field class deriving from this (CRTP, for static dispatch).
+ */
+template<typename T, typename PtrGetterT, typename DerivedT>
+class FieldImpl<T, PtrGetterT, DerivedT, std::enable_if_t<std::is_class<T>::value>>
+    : public GetterFieldBase<PtrGetterT>
+    , public FieldComma<FieldImpl<T, PtrGetterT, DerivedT>, DerivedT, PtrGetterT, T>
+{
+    REMODEL_FIELDIMPL_FORWARD_CTORS
+    static_assert(std::is_trivial<T>::value, "wrapping is only supported for trivial types");
+    static_assert(!std::is_base_of<ClassWrapper, T>::value, "internal library error");
+public:
+    // C++ does not allow overloading the dot operator (yet), so we provide an -> operator behaving
+    // like the dot operator instead plus a more verbose syntax using the get() function.
+    T& get()                            { return this->valueRef(); }
+    const T& get() const                { return this->valueCRef(); }
+    T* operator -> ()                   { return &get(); }
+    const T* operator -> () const       { return &get(); }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] for enums/enum classes                                                             //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Field implementation capturing `enum class` types.
+ * @tparam  T           The wrapped type.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ * @tparam  DerivedT    The field class deriving from this (CRTP, for static dispatch).
+ */
+template<typename T, typename PtrGetterT, typename DerivedT>
+class FieldImpl<T, PtrGetterT, DerivedT, std::enable_if_t<
+        // Enum classes do not implicitly convert to int, enums do. We use that for filtering.
+        std::is_enum<T>::value && !std::is_convertible<T, int>::value
+    >>
+    : public GetterFieldBase<PtrGetterT>
+    , public FieldComma<FieldImpl<T, PtrGetterT, DerivedT>, DerivedT, PtrGetterT, T>
+{
+    REMODEL_FIELDIMPL_FORWARD_CTORS
+public:
+    // Nothing to do here!
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] for pointers                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Field implementation capturing pointers.
+ * @tparam  T           The wrapped type.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ * @tparam  DerivedT    The field class deriving from this (CRTP, for static dispatch).
+ */
+template<typename T, typename PtrGetterT, typename DerivedT>
+// We capture pointers with enable_if to maintain the CV-qualifiers on the pointer itself.
+class FieldImpl<T, PtrGetterT, DerivedT, std::enable_if_t<std::is_pointer<T>::value>>
+    : public GetterFieldBase<PtrGetterT>
+    , public FieldForwardByFlags<
+        FieldImpl<T, PtrGetterT, DerivedT>,
+        DerivedT,
+        PtrGetterT,
+        T,
+        operators::ARRAY_SUBSCRIPT 
+            // Indirection operator is forwarded through implicit conversion operator.
+            // Explicit implementation disabled due to decltype bug in MSVC.
+            //| (std::is_void<std::remove_pointer_t<T>>::value ? 0 : operators::INDIRECTION)
+            | operators::SUBTRACT
+            | operators::ADD
+            | operators::COMMA
+            | (std::is_class<std::remove_pointer_t<T>>::value ? operators::STRUCT_DEREFERENCE : 0)
+    >
+{
+    REMODEL_FIELDIMPL_FORWARD_CTORS
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldImpl] for rvalue-references                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @internal
+ * @brief   Field implementation capturing rvalue-references.
+ * @tparam  T   The wrapped type.
+ * @warning Wrapping rvalue-references is not supported. If you shoud ever find any real-world
+ *          use case for wrapping rvalue-references, feel free to contact me.
+ */
+template<typename T, typename PtrGetterT, typename DerivedT>
+class FieldImpl<T&&, PtrGetterT, DerivedT>
+{
+    static_assert(BlackBoxConsts<T>::kFalse, "rvalue-reference-fields are not supported");
+};
+
+#undef REMODEL_FIELDIMPL_FORWARD_CTORS
+
+// ---------------------------------------------------------------------------------------------- //
+// [RewriteWrappers] + helper types                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+// Step 3: Implementation capturing simple wrapper types.
+template<typename BaseTypeT, typename QualifierStackT, typename = void>
+struct RewriteWrappersStep3
+{
+    static_assert(BlackBoxConsts<QualifierStackT>::kFalse,
+        "using wrapped types in fields requires usage of AdvancedClassWrapper as base");
+};
+
+// Step 3: Implementation capturing advanced wrapper types (manual SFINAE).
+template<typename BaseTypeT, typename QualifierStackT>
 struct RewriteWrappersStep3<BaseTypeT, QualifierStackT, typename BaseTypeT::IsAdvWrapper>
 {
-    // Rewrite wrapper type with WrapperPtr.
-    using Type = ApplyQualifierStack<
-        WeakWrapper<BaseTypeT>,
-        BaseTypeT, 
-        QualifierStackT
-        >;
+    // Rewrite wrapper type with WrapperPtr.
+    using Type = ApplyQualifierStack<
+        WeakWrapper<BaseTypeT>,
+        BaseTypeT, 
+        QualifierStackT
+        >;
+};
+
+// Step 2: Implementation capturing non-wrapper types.
+template<typename BaseTypeT, typename QualifierStackT, typename = void>
+struct RewriteWrappersStep2
+{
+    // Nothing to do, just reassemble type.
+    using Type = ApplyQualifierStack<BaseTypeT, BaseTypeT, QualifierStackT>;
+};
+
+// Step 2: Implementation capturing wrapper types.
+template<typename BaseTypeT, typename QualifierStackT>
+struct RewriteWrappersStep2<
+    BaseTypeT, 
+    QualifierStackT, 
+    std::enable_if_t<std::is_base_of<ClassWrapper, BaseTypeT>::value>
+> : RewriteWrappersStep3<BaseTypeT, QualifierStackT> {};
+
+/**
+ * @internal
+ * @brief   Rewrites wrapper types to the corresponding `WeakWrapper` type.
+ */
+// Step 1: Dissect type into base-type and qualifier-stack.
+template<typename T>
+using RewriteWrappers = typename RewriteWrappersStep2<
+    typename AnalyzeQualifiers<T>::BaseType,
+    typename AnalyzeQualifiers<T>::QualifierStack
+>::Type;
+
+} // namespace internal
+
+// ============================================================================================== //
+// Remodeling classes                                                                             //
+// ============================================================================================== //
+
+// ---------------------------------------------------------------------------------------------- //
+// [Field]                                                                                        //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Implementation shared by all field types.
+ * @tparam  T           The type of the field represent.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ */
+template<typename T, typename PtrGetterT>
+class BasicField : public FieldImpl<
+    RewriteWrappers<std::remove_reference_t<T>>, 
+    PtrGetterT, 
+    BasicField<T, PtrGetterT>
+>
+{
+public:
+    using RewrittenT = RewriteWrappers<std::remove_reference_t<T>>;
+protected:
+    using CompleteProxy = FieldImpl<RewrittenT, PtrGetterT, BasicField>;
+    static const bool kDoExtraDref = std::is_reference<T>::value;
+
+    friend class StaticOperatorForwarder<BasicField, RewrittenT>;
+protected: // Implementation of (Static|Abstract)OperatorForwarder
+    // No `override` here: with static dispatch, these hide the forwarder's functions instead.
+
+    /**
+     * @brief   Obtains a reference to the wrapped object.
+     * @return  The reference to the wrapped object.
+     */
+    RewrittenT& valueRef()
+    { 
+        REMODEL_INSTRUMENT_ACCESS();
+        return *static_cast<RewrittenT*>(
+            kDoExtraDref ? *reinterpret_cast<RewrittenT**>(this->rawPtr()) : this->rawPtr()
+            );
+    }
+
+    /**
+     * @copydoc valueRef
+     */
+    const RewrittenT& valueCRef() const
+    { 
+        REMODEL_INSTRUMENT_ACCESS();
+        return *static_cast<const RewrittenT*>(
+            kDoExtraDref 
+                ? *reinterpret_cast<const RewrittenT**>(const_cast<void*>(this->crawPtr()))
+                : this->crawPtr()
+            );
+    }
+protected:
+    /**
+     * @brief   Constructor forwarding its arguments to the `FieldImpl`.
+     * @tparam  ArgsT   Argument types.
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   args    Further arguments passed to the `FieldImpl`.
+     */
+    template<typename... ArgsT>
+    constexpr explicit BasicField(ClassWrapper* parent, ArgsT&&... args)
+        : CompleteProxy(parent, std::forward<ArgsT>(args)...) // MSVC12 requires parentheses here
+    {}
+
+    BasicField(BasicField&& other) = default;
+public:
+    /**
+     * @brief   Implicit cast to a reference to the wrapped field.
+     * @return  The desired reference.
+     */
+    operator RewrittenT& () { return this->valueRef(); }
+    
+    /**
+     * @brief   Implicit cast to a constant reference to the wrapped field.
+     * @return  The desired reference.
+     */
+    operator const RewrittenT& () const { return this->valueCRef(); }    
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  `*this`.
+     */
+    RewrittenT& operator = (const BasicField& rhs)
+    {
+        return this->valueRef() = rhs.valueCRef();
+    }
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  `*this`.
+     */
+    RewrittenT& operator = (const RewrittenT& rhs)
+    {
+        return this->valueRef() = rhs;
+    }
+
+    /**
+     * @brief   Obtains a raw pointer to the wrapped object.
+     * @return  The desired pointer.
+     */
+    RewrittenT* addressOfObj()               { return &this->valueRef(); }
+
+    /**
+     * @brief   Obtains a constant raw pointer to the wrapped object.
+     * @return  The desired pointer.
+     */
+    const RewrittenT* addressOfObj() const   { return &this->valueCRef(); }
+
+    /**
+     * @brief   Hints the CPU to fetch the wrapped field into the cache.
+     * @note    Unlike accesses, prefetches aren't counted by the instrumentation.
+     */
+    void prefetch() const { platform::prefetchRange(valueAddr(), sizeof(RewrittenT)); }
+
+    /**
+     * @brief   Reads the wrapped pointer and hints the CPU to fetch the object it points to.
+     *          
+     * The whole object is fetched, for pointers to wrapped types `kObjSize` bytes, allowing 
+     * walks of object graphs to request the next hop while still working on the current one.
+     */
+    template<typename PtrT = RewrittenT>
+    std::enable_if_t<std::is_pointer<PtrT>::value> prefetchPointee() const
+    {
+        using Pointee = std::remove_cv_t<std::remove_pointer_t<PtrT>>;
+        platform::prefetchRange(*static_cast<const PtrT*>(valueAddr()), 
+            std::is_void<Pointee>::value ? 1 : sizeof(std::conditional_t<
+                std::is_void<Pointee>::value, char, Pointee>));
+    }
+private:
+    const void* valueAddr() const
+    {
+        return kDoExtraDref 
+            ? *reinterpret_cast<const void* const*>(this->crawPtr()) 
+            : this->crawPtr();
+    }
+};
+
+} // namespace internal
+
+/**
+ * @brief   Class representing a field (attribute, member variable) of a wrapper class.
+ * @tparam  T           The type of the field represent.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation. Defaults to a 
+ *                      type-erased getter accepting any callable.
+ */
+template<typename T, typename PtrGetterT>
+class Field : public internal::BasicField<T, PtrGetterT>
+{
+    using Base = internal::BasicField<T, PtrGetterT>;
+public:
+    using typename Base::RewrittenT;
+    using Base::operator =;
+
+    /**
+     * @brief   Constructs a field from a parent and a `PtrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
+     * @see     Global
+     * @see     Module
+     */
+    Field(ClassWrapper* parent, typename Base::PtrGetter ptrGetter REMODEL_INSTRUMENT_SITE_PARAM)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+    {
+        REMODEL_INSTRUMENT_BIND(Field);
+    }
+
+    /**
+     * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
+     * @see     Global
+     * @see     Module
+     */
+    Field(ClassWrapper* parent, std::ptrdiff_t offset REMODEL_INSTRUMENT_SITE_PARAM)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+    {
+        REMODEL_INSTRUMENT_BIND(Field);
+    }
+
+    /**
+     * @brief   Move constructor, used when moving the parent wrapper.
+     * @param   other   The field to move from.
+     * @see     ClassWrapper
+     */
+    Field(Field&& other) = default;
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  `*this`.
+     */
+    RewrittenT& operator = (const Field& rhs)
+    {
+        return this->valueRef() = rhs.valueCRef();
+    }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    Field* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const Field* addressOfWrapper() const { return this; }
+};
+
+/**
+ * @brief   Field using a `SharedGetter`, see `REMODEL_SHARED_GETTER`.
+ * @tparam  T   The type of the field represent.
+ */
+template<typename T>
+using SharedField = Field<T, SharedGetter>;
+
+// ---------------------------------------------------------------------------------------------- //
+// [StaticField]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Field variant with the offset being a compile-time constant.
+ * @tparam  T       The type of the field represent.
+ * @tparam  offsT   The offset of the field inside of the wrapped object, in bytes.
+ *                  
+ * Other than `Field`, no type-erased `PtrGetter` is stored and invoked on access: reads and writes
+ * compile down to a single load or store at `base + offsT`. Behaves like a `Field` constructed 
+ * from an offset in every other regard.
+ */
+template<typename T, std::ptrdiff_t offsT>
+class StaticField : public internal::BasicField<T, StaticOffsGetter<offsT>>
+{
+    using Base = internal::BasicField<T, StaticOffsGetter<offsT>>;
+public:
+    using typename Base::RewrittenT;
+    using Base::operator =;
+
+    static const std::ptrdiff_t kOffs = offsT;
+
+    /**
+     * @brief   Constructs a field from its parent.
+     * @param   parent  The class wrapper that is the parent of this object.
+     */
+    explicit StaticField(ClassWrapper* parent REMODEL_INSTRUMENT_SITE_PARAM)
+        : Base(parent) // MSVC12 requires parentheses here
+    {
+        REMODEL_INSTRUMENT_BIND(Field);
+    }
+
+    /**
+     * @copydoc Field::Field(Field&&)
+     */
+    StaticField(StaticField&& other) = default;
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  `*this`.
+     */
+    RewrittenT& operator = (const StaticField& rhs)
+    {
+        return this->valueRef() = rhs.valueCRef();
+    }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    StaticField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const StaticField* addressOfWrapper() const { return this; }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [AtomicField]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Atomic operations on plain objects, equivalent to C++20's `std::atomic_ref`.
+ * @tparam  T   The type of the objects, trivially copyable and of 1, 2, 4 or 8 bytes.
+ */
+template<typename T>
+struct AtomicRef
+{
+    static_assert(std::is_trivially_copyable<T>::value, "atomic fields require trivial types");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+        "atomic fields require types of 1, 2, 4 or 8 bytes");
+
+#   if defined(ZYCORE_GNUC)
+    static int order(std::memory_order order) { return static_cast<int>(order); }
+
+    static T load(const T* ptr, std::memory_order mo)
+    {
+        T result;
+        __atomic_load(const_cast<T*>(ptr), &result, order(mo));
+        return result;
+    }
+
+    static void store(T* ptr, T value, std::memory_order mo)
+    {
+        __atomic_store(ptr, &value, order(mo));
+    }
+
+    static T exchange(T* ptr, T value, std::memory_order mo)
+    {
+        T result;
+        __atomic_exchange(ptr, &value, &result, order(mo));
+        return result;
+    }
+
+    static bool compareExchange(T* ptr, T& expected, T desired, bool weak,
+        std::memory_order success, std::memory_order failure)
+    {
+        return __atomic_compare_exchange(ptr, &expected, &desired, weak,
+            order(success), order(failure));
+    }
+
+    static T fetchAdd(T* ptr, T value, std::memory_order mo)
+    {
+        return __atomic_fetch_add(ptr, value, order(mo));
+    }
+
+    static T fetchSub(T* ptr, T value, std::memory_order mo)
+    {
+        return __atomic_fetch_sub(ptr, value, order(mo));
+    }
+
+    static T fetchAnd(T* ptr, T value, std::memory_order mo)
+    {
+        return __atomic_fetch_and(ptr, value, order(mo));
+    }
+
+    static T fetchOr(T* ptr, T value, std::memory_order mo)
+    {
+        return __atomic_fetch_or(ptr, value, order(mo));
+    }
+
+    static T fetchXor(T* ptr, T value, std::memory_order mo)
+    {
+        return __atomic_fetch_xor(ptr, value, order(mo));
+    }
+#   else
+    // Lock-free `std::atomic`s of these sizes are layout compatible with the plain type.
+    static_assert(sizeof(std::atomic<T>) == sizeof(T), "unsupported platform");
+
+    static std::atomic<T>* view(const T* ptr)
+    {
+        return reinterpret_cast<std::atomic<T>*>(const_cast<T*>(ptr));
+    }
+
+    static T load(const T* ptr, std::memory_order mo) { return view(ptr)->load(mo); }
+    static void store(T* ptr, T value, std::memory_order mo) { view(ptr)->store(value, mo); }
+
+    static T exchange(T* ptr, T value, std::memory_order mo)
+    {
+        return view(ptr)->exchange(value, mo);
+    }
+
+    static bool compareExchange(T* ptr, T& expected, T desired, bool weak,
+        std::memory_order success, std::memory_order failure)
+    {
+        return weak ? view(ptr)->compare_exchange_weak(expected, desired, success, failure)
+            : view(ptr)->compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    static T fetchAdd(T* ptr, T value, std::memory_order mo)
+    {
+        return view(ptr)->fetch_add(value, mo);
+    }
+
+    static T fetchSub(T* ptr, T value, std::memory_order mo)
+    {
+        return view(ptr)->fetch_sub(value, mo);
+    }
+
+    static T fetchAnd(T* ptr, T value, std::memory_order mo)
+    {
+        return view(ptr)->fetch_and(value, mo);
+    }
+
+    static T fetchOr(T* ptr, T value, std::memory_order mo)
+    {
+        return view(ptr)->fetch_or(value, mo);
+    }
+
+    static T fetchXor(T* ptr, T value, std::memory_order mo)
+    {
+        return view(ptr)->fetch_xor(value, mo);
+    }
+#   endif
+};
+
+/**
+ * @internal
+ * @brief   Derives the failure order of a compare-exchange from the success order.
+ */
+inline std::memory_order casFailureOrder(std::memory_order order)
+{
+    return order == std::memory_order_acq_rel ? std::memory_order_acquire
+        : order == std::memory_order_release ? std::memory_order_relaxed : order;
+}
+
+} // namespace internal
+
+/**
+ * @brief   Field accessed exclusively through atomic operations.
+ * @tparam  T           The type of the field represent, trivially copyable and of 1, 2, 4 or 8
+ *                      bytes.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
+ *
+ * Mirrors the interface of `std::atomic`, operating on the wrapped location. The location has to
+ * be naturally aligned (see the alignment parameter of `AdvancedClassWrapper`). Arithmetic and
+ * bitwise operations are only available for integral types.
+ */
+template<typename T, typename PtrGetterT = internal::DefaultPtrGetter>
+class AtomicField : public internal::GetterFieldBase<PtrGetterT>
+{
+    using Base   = internal::GetterFieldBase<PtrGetterT>;
+    using Atomic = internal::AtomicRef<T>;
+
+    template<typename U = T>
+    using EnableIntegral = std::enable_if_t<
+        std::is_integral<U>::value && !std::is_same<U, bool>::value, U>;
+public:
+    /**
+     * @brief   Constructs a field from a parent and a `PtrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
+     */
+    AtomicField(ClassWrapper* parent, PtrGetterT ptrGetter)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   offset  The offset of the field inside of the wrapped object, in bytes.
+     */
+    AtomicField(ClassWrapper* parent, std::ptrdiff_t offset)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+    {}
+
+    AtomicField(const AtomicField&) = delete;
+    AtomicField(AtomicField&&) = default;
+    AtomicField& operator = (const AtomicField&) = delete;
+
+    /**
+     * @brief   Atomically reads the field.
+     */
+    T load(std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return Atomic::load(ptr(), order);
+    }
+
+    /**
+     * @brief   Atomically writes the field.
+     */
+    void store(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        Atomic::store(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Atomically replaces the field, returning the previous value.
+     */
+    T exchange(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::exchange(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Replaces the field if it equals @c expected, else loads it into @c expected.
+     * @return  @c true if replaced, else @c false.
+     */
+    bool compareExchangeStrong(T& expected, T desired,
+        std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::compareExchange(ptr(), expected, desired, false, order,
+            internal::casFailureOrder(order));
+    }
+
+    /**
+     * @copydoc compareExchangeStrong
+     * @param   success The memory order on success.
+     * @param   failure The memory order on failure.
+     */
+    bool compareExchangeStrong(T& expected, T desired, std::memory_order success,
+        std::memory_order failure)
+    {
+        return Atomic::compareExchange(ptr(), expected, desired, false, success, failure);
+    }
+
+    /**
+     * @brief   Like `compareExchangeStrong`, but may fail spuriously. Cheaper in loops on some
+     *          architectures.
+     */
+    bool compareExchangeWeak(T& expected, T desired,
+        std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::compareExchange(ptr(), expected, desired, true, order,
+            internal::casFailureOrder(order));
+    }
+
+    /**
+     * @copydoc compareExchangeWeak
+     * @param   success The memory order on success.
+     * @param   failure The memory order on failure.
+     */
+    bool compareExchangeWeak(T& expected, T desired, std::memory_order success,
+        std::memory_order failure)
+    {
+        return Atomic::compareExchange(ptr(), expected, desired, true, success, failure);
+    }
+
+    /**
+     * @brief   Atomic addition, returning the previous value.
+     */
+    template<typename U = T>
+    EnableIntegral<U> fetchAdd(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::fetchAdd(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Atomic subtraction, returning the previous value.
+     */
+    template<typename U = T>
+    EnableIntegral<U> fetchSub(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::fetchSub(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Atomic bitwise and, returning the previous value.
+     */
+    template<typename U = T>
+    EnableIntegral<U> fetchAnd(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::fetchAnd(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Atomic bitwise or, returning the previous value.
+     */
+    template<typename U = T>
+    EnableIntegral<U> fetchOr(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::fetchOr(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Atomic bitwise xor, returning the previous value.
+     */
+    template<typename U = T>
+    EnableIntegral<U> fetchXor(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return Atomic::fetchXor(ptr(), value, order);
+    }
+
+    /**
+     * @brief   Sequentially consistent load.
+     */
+    operator T () const { return load(); }
+
+    /**
+     * @brief   Sequentially consistent store.
+     * @return  @c value.
+     */
+    T operator = (T value)
+    {
+        store(value);
+        return value;
+    }
+
+    template<typename U = T> EnableIntegral<U> operator ++ ()    { return fetchAdd(1) + 1; }
+    template<typename U = T> EnableIntegral<U> operator -- ()    { return fetchSub(1) - 1; }
+    template<typename U = T> EnableIntegral<U> operator ++ (int) { return fetchAdd(1); }
+    template<typename U = T> EnableIntegral<U> operator -- (int) { return fetchSub(1); }
+    template<typename U = T> EnableIntegral<U> operator += (T v) { return fetchAdd(v) + v; }
+    template<typename U = T> EnableIntegral<U> operator -= (T v) { return fetchSub(v) - v; }
+    template<typename U = T> EnableIntegral<U> operator &= (T v) { return fetchAnd(v) & v; }
+    template<typename U = T> EnableIntegral<U> operator |= (T v) { return fetchOr(v) | v; }
+    template<typename U = T> EnableIntegral<U> operator ^= (T v) { return fetchXor(v) ^ v; }
+
+    /**
+     * @brief   Obtains a raw pointer to the wrapped object.
+     * @return  The desired pointer.
+     */
+    T* addressOfObj() { return ptr(); }
+
+    /**
+     * @brief   Obtains a constant raw pointer to the wrapped object.
+     * @return  The desired pointer.
+     */
+    const T* addressOfObj() const { return ptr(); }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    AtomicField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const AtomicField* addressOfWrapper() const { return this; }
+private:
+    T* ptr() const { return static_cast<T*>(const_cast<void*>(this->crawPtr())); }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [BitField]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Field representing a range of bits inside of an integral storage unit.
+ * @tparam  T           The type of the storage unit, an integral or enum type. Values are
+ *                      sign-extended if the (underlying) type is signed.
+ * @tparam  bitOffsT    The index of the lowest bit of the field inside of the storage unit.
+ * @tparam  bitWidthT   The number of bits of the field.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used to calculate the address of the storage unit.
+ *
+ * Bits are not addressable, so other than `Field`, operators are forwarded by value: compound
+ * assignments read the storage unit, apply the operation to the extracted value and insert the
+ * result again. Extraction and insertion compile down to constant shifts and masks.
+ *
+ * @code
+ *      BitField<uint32_t, 0, 1>  isAlive{this, offsetof(Unit, flags)};
+ *      BitField<uint32_t, 1, 7>  level  {this, offsetof(Unit, flags)};
+ * @endcode
+ */
+template<typename T, unsigned bitOffsT, unsigned bitWidthT,
+    typename PtrGetterT = internal::DefaultPtrGetter>
+class BitField : public internal::GetterFieldBase<PtrGetterT>
+{
+    using Base = internal::GetterFieldBase<PtrGetterT>;
+
+    template<typename U>
+    struct Underlying { using Type = std::underlying_type_t<U>; };
+    template<typename U>
+    struct Identity { using Type = U; };
+
+    using UnderlyingT = typename std::conditional_t<
+        std::is_enum<T>::value, Underlying<T>, Identity<T>>::Type;
+
+    static_assert(std::is_integral<UnderlyingT>::value, "bit fields require integral types");
+    static_assert(bitWidthT > 0, "bit fields require at least one bit");
+    static_assert(bitOffsT + bitWidthT <= sizeof(T) * 8, "bit field exceeds its storage unit");
+
+    template<typename U = UnderlyingT>
+    using EnableArithmetic = std::enable_if_t<!std::is_same<U, bool>::value, T>;
+public:
+    /**
+     * @brief   The unsigned type the storage unit is accessed as.
+     */
+    using Storage = std::make_unsigned_t<std::conditional_t<
+        std::is_same<UnderlyingT, bool>::value, uint8_t, UnderlyingT>>;
+
+    /**
+     * @brief   The type of the values extracted.
+     */
+    using ValueType = T;
+
+    static const unsigned kBitOffs  = bitOffsT;
+    static const unsigned kBitWidth = bitWidthT;
+    static const unsigned kUnitBits = sizeof(Storage) * 8;
+
+    /**
+     * @brief   The bits of the field, unshifted.
+     */
+    static constexpr Storage kValueMask
+        = static_cast<Storage>(static_cast<Storage>(~Storage{0}) >> (kUnitBits - bitWidthT));
+
+    /**
+     * @brief   The bits of the field inside of the storage unit.
+     */
+    static constexpr Storage kMask = static_cast<Storage>(kValueMask << bitOffsT);
+
+    /**
+     * @brief   Extracts the value of the field from a storage unit.
+     * @param   unit    The storage unit.
+     * @return  The value.
+     */
+    static T extract(Storage unit)
+    {
+        return extract(unit, std::is_signed<UnderlyingT>{});
+    }
+
+    /**
+     * @brief   Inserts a value into a storage unit, leaving the other bits unchanged.
+     * @param   unit    The storage unit.
+     * @param   value   The value, truncated to `kBitWidth` bits.
+     * @return  The updated storage unit.
+     */
+    static Storage insert(Storage unit, T value)
+    {
+        return static_cast<Storage>((unit & static_cast<Storage>(~kMask))
+            | ((static_cast<Storage>(value) << bitOffsT) & kMask));
+    }
+
+    /**
+     * @brief   Constructs a field from a parent and a `PtrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the address of the storage unit.
+     */
+    BitField(ClassWrapper* parent, PtrGetterT ptrGetter)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   offset  The offset of the storage unit inside of the wrapped object, in bytes.
+     */
+    BitField(ClassWrapper* parent, std::ptrdiff_t offset)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @copydoc Field::Field(Field&&)
+     */
+    BitField(BitField&& other) = default;
+
+    /**
+     * @brief   Reads the value of the field.
+     * @return  The value.
+     */
+    T get() const { return extract(*unit()); }
+
+    /**
+     * @brief   Writes the value of the field.
+     * @param   value   The value, truncated to `kBitWidth` bits.
+     */
+    void set(T value)
+    {
+        auto ptr = unit();
+        *ptr = insert(*ptr, value);
+    }
+
+    /**
+     * @brief   Implicit cast to the value of the field.
+     * @return  The value.
+     */
+    operator T () const { return get(); }
+
+    /**
+     * @brief   Assignment operator writing the field.
+     * @param   rhs The right hand side.
+     * @return  @c rhs.
+     */
+    T operator = (T rhs)
+    {
+        set(rhs);
+        return rhs;
+    }
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  The value assigned.
+     */
+    T operator = (const BitField& rhs)
+    {
+        return *this = rhs.get();
+    }
+
+    // Compound assignments, returning the value stored (after truncation).
+#define REMODEL_BITFIELD_COMPOUND(op)                                                              \
+    template<typename U = UnderlyingT>                                                             \
+    EnableArithmetic<U> operator op##= (T rhs)                                                     \
+    {                                                                                              \
+        set(static_cast<T>(get() op rhs));                                                         \
+        return get();                                                                              \
+    }
+
+    REMODEL_BITFIELD_COMPOUND(+)
+    REMODEL_BITFIELD_COMPOUND(-)
+    REMODEL_BITFIELD_COMPOUND(*)
+    REMODEL_BITFIELD_COMPOUND(/)
+    REMODEL_BITFIELD_COMPOUND(%)
+    REMODEL_BITFIELD_COMPOUND(&)
+    REMODEL_BITFIELD_COMPOUND(|)
+    REMODEL_BITFIELD_COMPOUND(^)
+    REMODEL_BITFIELD_COMPOUND(<<)
+    REMODEL_BITFIELD_COMPOUND(>>)
+
+#undef REMODEL_BITFIELD_COMPOUND
+
+    template<typename U = UnderlyingT> EnableArithmetic<U> operator ++ () { return *this += 1; }
+    template<typename U = UnderlyingT> EnableArithmetic<U> operator -- () { return *this -= 1; }
+
+    template<typename U = UnderlyingT>
+    EnableArithmetic<U> operator ++ (int)
+    {
+        auto value = get();
+        *this += 1;
+        return value;
+    }
+
+    template<typename U = UnderlyingT>
+    EnableArithmetic<U> operator -- (int)
+    {
+        auto value = get();
+        *this -= 1;
+        return value;
+    }
+
+    /**
+     * @brief   Obtains a raw pointer to the storage unit containing the field.
+     * @return  The desired pointer.
+     */
+    T* addressOfObj() { return static_cast<T*>(this->rawPtr()); }
+
+    /**
+     * @brief   Obtains a constant raw pointer to the storage unit containing the field.
+     * @return  The desired pointer.
+     */
+    const T* addressOfObj() const { return static_cast<const T*>(this->crawPtr()); }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    BitField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const BitField* addressOfWrapper() const { return this; }
+private:
+    Storage* unit() const
+    {
+        return static_cast<Storage*>(const_cast<void*>(this->crawPtr()));
+    }
+
+    static T extract(Storage unit, std::false_type /*isSigned*/)
+    {
+        return static_cast<T>((unit >> bitOffsT) & kValueMask);
+    }
+
+    static T extract(Storage unit, std::true_type /*isSigned*/)
+    {
+        // Move the field to the top, then arithmetically shift it back down to sign-extend.
+        using Signed = std::make_signed_t<Storage>;
+        auto top = static_cast<Storage>(unit << (kUnitBits - bitOffsT - bitWidthT));
+        return static_cast<T>(static_cast<Signed>(top) >> (kUnitBits - bitWidthT));
+    }
 };
 
-// Step 2: Implementation capturing non-wrapper types.
-template<typename BaseTypeT, typename QualifierStackT, typename = void>
-struct RewriteWrappersStep2
+template<typename T, unsigned bitOffsT, unsigned bitWidthT, typename PtrGetterT>
+constexpr typename BitField<T, bitOffsT, bitWidthT, PtrGetterT>::Storage
+BitField<T, bitOffsT, bitWidthT, PtrGetterT>::kValueMask;
+
+template<typename T, unsigned bitOffsT, unsigned bitWidthT, typename PtrGetterT>
+constexpr typename BitField<T, bitOffsT, bitWidthT, PtrGetterT>::Storage
+BitField<T, bitOffsT, bitWidthT, PtrGetterT>::kMask;
+
+// ---------------------------------------------------------------------------------------------- //
+// [TrailingArrayField]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Non-owning view over a contiguous array, similar to C++20's `std::span`.
+ * @tparam  T   The type of the elements.
+ */
+template<typename T>
+class ArrayView
 {
-    // Nothing to do, just reassemble type.
-    using Type = ApplyQualifierStack<BaseTypeT, BaseTypeT, QualifierStackT>;
+public:
+    using iterator = T*;
+
+    /**
+     * @brief   Default constructor, creating an empty view.
+     */
+    ArrayView() = default;
+
+    /**
+     * @brief   Constructor.
+     * @param   data    Pointer to the first element.
+     * @param   size    The number of elements.
+     */
+    ArrayView(T* data, std::size_t size)
+        : m_data{data}
+        , m_size{size}
+    {}
+
+    /**
+     * @brief   Gets a pointer to the first element.
+     * @return  The pointer.
+     */
+    T* data() const { return m_data; }
+
+    /**
+     * @brief   Gets the number of elements.
+     * @return  The number of elements.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief   Determines whether the view is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !m_size; }
+
+    /**
+     * @brief   Gets an iterator to the first element.
+     * @return  The iterator.
+     */
+    iterator begin() const { return m_data; }
+
+    /**
+     * @brief   Gets an iterator past the last element.
+     * @return  The iterator.
+     */
+    iterator end() const { return m_data + m_size; }
+
+    /**
+     * @brief   Accesses an element.
+     * @param   idx The index of the element, less than `size()`.
+     * @return  A reference to the element.
+     */
+    T& operator [] (std::size_t idx) const { return m_data[idx]; }
+private:
+    T* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+/**
+ * @brief   Field representing an array trailing the wrapped object, sized by another field.
+ * @tparam  T               The type of the elements. Wrapper types are rewritten to their
+ *                          `WeakWrapper` type, just like with `Field`.
+ * @tparam  LengthFieldT    Type of the field holding the number of elements, e.g. a `Field`,
+ *                          `StaticField`, `BitField` or `EndianField` of an integral type.
+ * @tparam  PtrGetterT      Type of the `PtrGetter` used to calculate the address of the first
+ *                          element.
+ *
+ * The length is read anew on every access, no elements are ever copied. The length field has to
+ * be declared before the array field inside of the wrapper.
+ *
+ * @code
+ *      class Inventory : public AdvancedClassWrapper<8>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Inventory)
+ *      public:
+ *          Field<uint32_t>                                count{this, 4};
+ *          TrailingArrayField<Item, Field<uint32_t>>      items{this, 8, count};
+ *      };
+ *
+ *      for (auto& item : inventory.items.view()) item.toStrong().durability = 100;
+ * @endcode
+ */
+template<typename T, typename LengthFieldT, typename PtrGetterT = internal::DefaultPtrGetter>
+class TrailingArrayField : public internal::GetterFieldBase<PtrGetterT>
+{
+    using Base = internal::GetterFieldBase<PtrGetterT>;
+public:
+    using RewrittenT = internal::RewriteWrappers<T>;
+
+    /**
+     * @brief   Constructs a field from a parent and a `PtrGetter`.
+     * @param   parent      The class wrapper that is the parent of this object.
+     * @param   ptrGetter   The function used to calculate the address of the first element.
+     * @param   length      The field holding the number of elements.
+     */
+    TrailingArrayField(ClassWrapper* parent, PtrGetterT ptrGetter, const LengthFieldT& length)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+        , m_length{length}
+    {}
+
+    /**
+     * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   offset  The offset of the first element inside of the wrapped object, in bytes.
+     * @param   length  The field holding the number of elements.
+     */
+    TrailingArrayField(ClassWrapper* parent, std::ptrdiff_t offset, const LengthFieldT& length)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+        , m_length{length}
+    {}
+
+    TrailingArrayField(const TrailingArrayField&) = delete;
+    TrailingArrayField& operator = (const TrailingArrayField&) = delete;
+
+    /**
+     * @brief   Gets the number of elements, as stored in the length field.
+     * @return  The number of elements.
+     */
+    std::size_t size() const { return static_cast<std::size_t>(m_length); }
+
+    /**
+     * @brief   Determines whether the array is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !size(); }
+
+    /**
+     * @brief   Creates a view over the elements.
+     * @return  The view.
+     */
+    ArrayView<RewrittenT> view() { return {addressOfObj(), size()}; }
+
+    /**
+     * @copydoc view
+     */
+    ArrayView<const RewrittenT> view() const { return {addressOfObj(), size()}; }
+
+    /**
+     * @brief   Creates a view over the elements, clamped to a maximum number of elements.
+     * @param   maxSize The maximum number of elements, e.g. derived from the size of a buffer.
+     * @return  The view.
+     */
+    ArrayView<RewrittenT> view(std::size_t maxSize)
+    {
+        return {addressOfObj(), std::min(size(), maxSize)};
+    }
+
+    /**
+     * @copydoc view(std::size_t)
+     */
+    ArrayView<const RewrittenT> view(std::size_t maxSize) const
+    {
+        return {addressOfObj(), std::min(size(), maxSize)};
+    }
+
+    /**
+     * @brief   Accesses an element.
+     * @param   idx The index of the element, less than `size()`.
+     * @return  A reference to the element.
+     */
+    RewrittenT& operator [] (std::size_t idx) { return addressOfObj()[idx]; }
+
+    /**
+     * @copydoc operator[]
+     */
+    const RewrittenT& operator [] (std::size_t idx) const { return addressOfObj()[idx]; }
+
+    /**
+     * @brief   Obtains a raw pointer to the first element.
+     * @return  The desired pointer.
+     */
+    RewrittenT* addressOfObj() { return static_cast<RewrittenT*>(this->rawPtr()); }
+
+    /**
+     * @brief   Obtains a constant raw pointer to the first element.
+     * @return  The desired pointer.
+     */
+    const RewrittenT* addressOfObj() const
+    {
+        return static_cast<const RewrittenT*>(this->crawPtr());
+    }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    TrailingArrayField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const TrailingArrayField* addressOfWrapper() const { return this; }
+private:
+    const LengthFieldT& m_length;
 };
 
-// Step 2: Implementation capturing wrapper types.
-template<typename BaseTypeT, typename QualifierStackT>
-struct RewriteWrappersStep2<
-    BaseTypeT, 
-    QualifierStackT, 
-    std::enable_if_t<std::is_base_of<ClassWrapper, BaseTypeT>::value>
-> : RewriteWrappersStep3<BaseTypeT, QualifierStackT> {};
+// ---------------------------------------------------------------------------------------------- //
+// [StridedField]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Copies elements spaced by a stride, one `memcpy` of known size per element.
+ * @tparam  sizeT   The size of an element, in bytes.
+ * @param   dst     The destination, receiving the elements densely packed.
+ * @param   src     The address of the first element.
+ * @param   stride  The distance between two elements, in bytes.
+ * @param   count   The number of elements.
+ */
+template<std::size_t sizeT>
+inline void copyStridedScalar(uint8_t* dst, const uint8_t* src, std::ptrdiff_t stride,
+    std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, dst += sizeT, src += stride)
+    {
+        std::memcpy(dst, src, sizeT);
+    }
+}
+
+#ifdef REMODEL_SCANNER_X86
+#   if defined(ZYCORE_MSVC)
+#       define REMODEL_STRIDED_TARGET(isa)
+#   else
+#       define REMODEL_STRIDED_TARGET(isa) __attribute__((target(isa)))
+#   endif
+
+/**
+ * @internal
+ * @brief   AVX2 kernel for 4 byte elements, gathering 8 elements at once.
+ * @copydetails copyStridedScalar
+ * @return  The number of elements copied, the remainder is left to `copyStridedScalar`.
+ */
+REMODEL_STRIDED_TARGET("avx2")
+inline std::size_t copyStridedAvx2(uint8_t* dst, const uint8_t* src, std::ptrdiff_t stride,
+    std::size_t count, std::integral_constant<std::size_t, 4>)
+{
+    auto offs = _mm256_mullo_epi32(
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto elems = _mm256_i32gather_epi32(
+            reinterpret_cast<const int*>(src + static_cast<std::ptrdiff_t>(i) * stride), offs, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), elems);
+    }
+    return i;
+}
+
+/**
+ * @internal
+ * @brief   AVX2 kernel for 8 byte elements, gathering 4 elements at once.
+ * @copydetails copyStridedScalar
+ * @return  The number of elements copied, the remainder is left to `copyStridedScalar`.
+ */
+REMODEL_STRIDED_TARGET("avx2")
+inline std::size_t copyStridedAvx2(uint8_t* dst, const uint8_t* src, std::ptrdiff_t stride,
+    std::size_t count, std::integral_constant<std::size_t, 8>)
+{
+    auto offs = _mm_mullo_epi32(
+        _mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(static_cast<int>(stride)));
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        auto elems = _mm256_i32gather_epi64(
+            reinterpret_cast<const long long*>(src + static_cast<std::ptrdiff_t>(i) * stride), 
+            offs, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 8), elems);
+    }
+    return i;
+}
+
+#   undef REMODEL_STRIDED_TARGET
+#endif // REMODEL_SCANNER_X86
 
 /**
  * @internal
- * @brief   Rewrites wrapper types to the corresponding `WeakWrapper` type.
+ * @brief   Copies elements spaced by a stride, picking the fastest way for the element size.
+ * @copydetails copyStridedScalar
+ *
+ * Densely packed elements are copied in one go. 4 and 8 byte elements are gathered with AVX2 if
+ * supported by the CPU and the offsets of a batch fit 32 bit.
  */
-// Step 1: Dissect type into base-type and qualifier-stack.
-template<typename T>
-using RewriteWrappers = typename RewriteWrappersStep2<
-    typename AnalyzeQualifiers<T>::BaseType,
-    typename AnalyzeQualifiers<T>::QualifierStack
->::Type;
+template<std::size_t sizeT>
+inline void copyStrided(uint8_t* dst, const uint8_t* src, std::ptrdiff_t stride, 
+    std::size_t count)
+{
+    if (stride == static_cast<std::ptrdiff_t>(sizeT)) 
+    {
+        if (count) std::memcpy(dst, src, sizeT * count);
+        return;
+    }
+
+#   ifdef REMODEL_SCANNER_X86
+        const std::ptrdiff_t kMaxGatherStride = INT32_MAX / 8;
+        if ((sizeT == 4 || sizeT == 8) && bestScanKernel() == ScanKernel::Avx2 
+            && stride <= kMaxGatherStride && stride >= -kMaxGatherStride)
+        {
+            auto done = copyStridedAvx2(dst, src, stride, count, 
+                std::integral_constant<std::size_t, sizeT == 4 ? 4 : 8>{});
+            dst   += done * sizeT;
+            src   += static_cast<std::ptrdiff_t>(done) * stride;
+            count -= done;
+        }
+#   endif
+
+    copyStridedScalar<sizeT>(dst, src, stride, count);
+}
 
 } // namespace internal
 
-// ============================================================================================== //
-// Remodeling classes                                                                             //
-// ============================================================================================== //
+/**
+ * @brief   Random access iterator over elements spaced by a stride.
+ * @tparam  T   The type of the elements.
+ */
+template<typename T>
+class StridedIterator
+{
+    using BytePtr = std::conditional_t<std::is_const<T>::value, const uint8_t*, uint8_t*>;
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::remove_cv_t<T>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
 
-// ---------------------------------------------------------------------------------------------- //
-// [Field]                                                                                        //
-// ---------------------------------------------------------------------------------------------- //
+    /**
+     * @brief   Default constructor, creating a singular iterator.
+     */
+    StridedIterator() = default;
+
+    /**
+     * @brief   Constructor.
+     * @param   elem    Pointer to the element.
+     * @param   stride  The distance between two elements, in bytes.
+     */
+    StridedIterator(T* elem, std::ptrdiff_t stride)
+        : m_elem{reinterpret_cast<BytePtr>(elem)}
+        , m_stride{stride}
+    {}
+
+    reference operator * () const { return *reinterpret_cast<T*>(m_elem); }
+    pointer operator -> () const { return reinterpret_cast<T*>(m_elem); }
+    reference operator [] (difference_type n) const { return *(*this + n); }
+
+    StridedIterator& operator ++ () { m_elem += m_stride; return *this; }
+    StridedIterator& operator -- () { m_elem -= m_stride; return *this; }
+    StridedIterator operator ++ (int) { auto prev = *this; ++*this; return prev; }
+    StridedIterator operator -- (int) { auto prev = *this; --*this; return prev; }
+    StridedIterator& operator += (difference_type n) { m_elem += n * m_stride; return *this; }
+    StridedIterator& operator -= (difference_type n) { m_elem -= n * m_stride; return *this; }
+
+    StridedIterator operator + (difference_type n) const { return StridedIterator{*this} += n; }
+    StridedIterator operator - (difference_type n) const { return StridedIterator{*this} -= n; }
+    friend StridedIterator operator + (difference_type n, const StridedIterator& it) 
+    { 
+        return it + n; 
+    }
+
+    difference_type operator - (const StridedIterator& other) const
+    {
+        return (m_elem - other.m_elem) / m_stride;
+    }
+
+    bool operator == (const StridedIterator& other) const { return m_elem == other.m_elem; }
+    bool operator != (const StridedIterator& other) const { return m_elem != other.m_elem; }
+    bool operator <  (const StridedIterator& other) const { return other - *this > 0; }
+    bool operator >  (const StridedIterator& other) const { return other < *this; }
+    bool operator <= (const StridedIterator& other) const { return !(other < *this); }
+    bool operator >= (const StridedIterator& other) const { return !(*this < other); }
+private:
+    BytePtr m_elem = nullptr;
+    std::ptrdiff_t m_stride = 0;
+};
 
 /**
- * @brief   Class representing a field (attribute, member variable) of a wrapper class.
- * @tparam  T   The type of the field represent.
+ * @brief   Non-owning view over elements spaced by a stride, e.g. one member of an array of 
+ *          records.
+ * @tparam  T   The type of the elements.
  */
 template<typename T>
-class Field : public internal::FieldImpl<internal::RewriteWrappers<std::remove_reference_t<T>>>
+class StridedView
 {
 public:
-    using RewrittenT = internal::RewriteWrappers<std::remove_reference_t<T>>;
-protected:
-    using CompleteProxy = internal::FieldImpl<RewrittenT>;
-    static const bool kDoExtraDref = std::is_reference<T>::value;
-protected: // Implementation of AbstractOperatorForwarder
+    using iterator = StridedIterator<T>;
+
     /**
-     * @brief   Obtains a reference to the wrapped object.
-     * @return  The reference to the wrapped object.
+     * @brief   Default constructor, creating an empty view.
      */
-    RewrittenT& valueRef() override
-    { 
-        return *static_cast<RewrittenT*>(
-            kDoExtraDref ? *reinterpret_cast<RewrittenT**>(this->rawPtr()) : this->rawPtr()
-            );
+    StridedView() = default;
+
+    /**
+     * @brief   Constructor.
+     * @param   first   Pointer to the first element.
+     * @param   stride  The distance between two elements, in bytes. May be negative.
+     * @param   size    The number of elements.
+     */
+    StridedView(T* first, std::ptrdiff_t stride, std::size_t size)
+        : m_first{first}
+        , m_stride{stride}
+        , m_size{size}
+    {}
+
+    /**
+     * @brief   Gets a pointer to the first element.
+     * @return  The pointer.
+     */
+    T* data() const { return m_first; }
+
+    /**
+     * @brief   Gets the distance between two elements.
+     * @return  The stride, in bytes.
+     */
+    std::ptrdiff_t stride() const { return m_stride; }
+
+    /**
+     * @brief   Gets the number of elements.
+     * @return  The number of elements.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief   Determines whether the view is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !m_size; }
+
+    /**
+     * @brief   Gets an iterator to the first element.
+     * @return  The iterator.
+     */
+    iterator begin() const { return {m_first, m_stride}; }
+
+    /**
+     * @brief   Gets an iterator past the last element.
+     * @return  The iterator.
+     */
+    iterator end() const { return begin() + static_cast<std::ptrdiff_t>(m_size); }
+
+    /**
+     * @brief   Accesses an element.
+     * @param   idx The index of the element, less than `size()`.
+     * @return  A reference to the element.
+     */
+    T& operator [] (std::size_t idx) const { return begin()[static_cast<std::ptrdiff_t>(idx)]; }
+
+    /**
+     * @brief   Copies the elements into a densely packed buffer.
+     * @param   out         The buffer.
+     * @param   maxCount    The capacity of the buffer, in elements.
+     * @return  The number of elements copied.
+     */
+    std::size_t copyTo(std::remove_cv_t<T>* out, std::size_t maxCount) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, 
+            "copyTo requires trivially copyable elements");
+
+        auto count = std::min(m_size, maxCount);
+        internal::copyStrided<sizeof(T)>(reinterpret_cast<uint8_t*>(out), 
+            reinterpret_cast<const uint8_t*>(m_first), m_stride, count);
+        return count;
     }
 
     /**
-     * @copydoc valueRef
+     * @brief   Copies the elements into a vector.
+     * @return  The vector.
      */
-    const RewrittenT& valueCRef() const override
-    { 
-        return *static_cast<const RewrittenT*>(
-            kDoExtraDref 
-                ? *reinterpret_cast<const RewrittenT**>(const_cast<void*>(this->crawPtr()))
-                : this->crawPtr()
-            );
+    std::vector<std::remove_cv_t<T>> copy() const
+    {
+        std::vector<std::remove_cv_t<T>> out(m_size);
+        copyTo(out.data(), out.size());
+        return out;
     }
+private:
+    T* m_first = nullptr;
+    std::ptrdiff_t m_stride = 0;
+    std::size_t m_size = 0;
+};
+
+/**
+ * @brief   Field representing elements spaced by a fixed stride, such as one member of an 
+ *          embedded array of records or a column of a matrix.
+ * @tparam  T           The type of the elements. Wrapper types are rewritten to their 
+ *                      `WeakWrapper` type, just like with `Field`.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used to calculate the address of the first 
+ *                      element.
+ *
+ * Only the selected elements are touched, so extracting a column needs neither a wrapper per 
+ * record nor a copy of the whole array. Multi-dimensional arrays are addressed by picking the 
+ * stride of the dimension to walk.
+ *
+ * @code
+ *      struct Unit { uint32_t id; float health; uint8_t rest[16]; };   // 24 bytes
+ *
+ *      class World : public AdvancedClassWrapper<0x10 + 64 * sizeof(Unit)>
+ *      {
+ *          REMODEL_ADV_WRAPPER(World)
+ *      public:
+ *          StridedField<float> health{this, 0x10 + offsetof(Unit, health), sizeof(Unit), 64};
+ *          StridedField<float> matrixCol{this, 0x4, 4 * sizeof(float), 4}; // float[4][4]
+ *      };
+ *
+ *      float health[64];
+ *      world.health.copyTo(health, 64);
+ * @endcode
+ */
+template<typename T, typename PtrGetterT = internal::DefaultPtrGetter>
+class StridedField : public internal::GetterFieldBase<PtrGetterT>
+{
+    using Base = internal::GetterFieldBase<PtrGetterT>;
 public:
+    using RewrittenT = internal::RewriteWrappers<T>;
+
     /**
      * @brief   Constructs a field from a parent and a `PtrGetter`.
      * @param   parent      The class wrapper that is the parent of this object.
-     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
-     * @see     Global
-     * @see     Module
+     * @param   ptrGetter   The function used to calculate the address of the first element.
+     * @param   stride      The distance between two elements, in bytes.
+     * @param   count       The number of elements.
      */
-    Field(ClassWrapper* parent, typename CompleteProxy::PtrGetter ptrGetter)
-        : CompleteProxy{parent, ptrGetter}
+    StridedField(ClassWrapper* parent, PtrGetterT ptrGetter, std::ptrdiff_t stride, 
+            std::size_t count)
+        : Base(parent, ptrGetter) // MSVC12 requires parentheses here
+        , m_stride{stride}
+        , m_count{count}
     {}
 
     /**
      * @brief   Convenience constructs defaulting to an `OffsGetter` as `ptrGetter`.
-     * @param   parent      The class wrapper that is the parent of this object.
-     * @param   ptrGetter   The function used to calculate the final address of the wrapped field.
-     * @see     Global
-     * @see     Module
+     * @param   parent  The class wrapper that is the parent of this object.
+     * @param   offset  The offset of the first element inside of the wrapped object, in bytes.
+     * @param   stride  The distance between two elements, in bytes.
+     * @param   count   The number of elements.
      */
-    Field(ClassWrapper* parent, std::ptrdiff_t offset)
-        : CompleteProxy{parent, OffsGetter{offset}}
+    StridedField(ClassWrapper* parent, std::ptrdiff_t offset, std::ptrdiff_t stride, 
+            std::size_t count)
+        : Base(parent, OffsGetter{offset}) // MSVC12 requires parentheses here
+        , m_stride{stride}
+        , m_count{count}
     {}
 
+    StridedField(const StridedField&) = delete;
+    StridedField& operator = (const StridedField&) = delete;
+
     /**
-     * @brief   Implicit cast to a reference to the wrapped field.
-     * @return  The desired reference.
+     * @brief   Gets the distance between two elements.
+     * @return  The stride, in bytes.
      */
-    operator RewrittenT& () { return this->valueRef(); }
-    
+    std::ptrdiff_t stride() const { return m_stride; }
+
     /**
-     * @brief   Implicit cast to a constant reference to the wrapped field.
-     * @return  The desired reference.
+     * @brief   Gets the number of elements.
+     * @return  The number of elements.
      */
-    operator const RewrittenT& () const { return this->valueCRef(); }    
+    std::size_t size() const { return m_count; }
 
     /**
-     * @brief   Assignment operator simulating normal copy semantics for fields.
-     * @param   rhs The right hand side.
-     * @return  `*this`.
+     * @brief   Determines whether the field has no elements.
+     * @return  @c true if empty, else @c false.
      */
-    RewrittenT& operator = (const Field& rhs)
-    {
-        return this->valueRef() = rhs.valueCRef();
-    }
+    bool empty() const { return !m_count; }
 
     /**
-     * @brief   Assignment operator simulating normal copy semantics for fields.
-     * @param   rhs The right hand side.
-     * @return  `*this`.
+     * @brief   Creates a view over the elements.
+     * @return  The view.
      */
-    RewrittenT& operator = (const RewrittenT& rhs)
+    StridedView<RewrittenT> view() { return {addressOfObj(), m_stride, m_count}; }
+
+    /**
+     * @copydoc view
+     */
+    StridedView<const RewrittenT> view() const { return {addressOfObj(), m_stride, m_count}; }
+
+    /**
+     * @brief   Accesses an element.
+     * @param   idx The index of the element, less than `size()`.
+     * @return  A reference to the element.
+     */
+    RewrittenT& operator [] (std::size_t idx) { return view()[idx]; }
+
+    /**
+     * @copydoc operator[]
+     */
+    const RewrittenT& operator [] (std::size_t idx) const { return view()[idx]; }
+
+    /**
+     * @copydoc StridedView::copyTo
+     */
+    std::size_t copyTo(std::remove_cv_t<RewrittenT>* out, std::size_t maxCount) const
     {
-        return this->valueRef() = rhs;
+        return view().copyTo(out, maxCount);
     }
 
     /**
-     * @brief   Obtains a raw pointer to the wrapped object.
+     * @brief   Obtains a raw pointer to the first element.
      * @return  The desired pointer.
      */
-    RewrittenT* addressOfObj()               { return &this->valueRef(); }
+    RewrittenT* addressOfObj() { return static_cast<RewrittenT*>(this->rawPtr()); }
 
     /**
-     * @brief   Obtains a constant raw pointer to the wrapped object.
+     * @brief   Obtains a constant raw pointer to the first element.
      * @return  The desired pointer.
      */
-    const RewrittenT* addressOfObj() const   { return &this->valueCRef(); }
+    const RewrittenT* addressOfObj() const
+    {
+        return static_cast<const RewrittenT*>(this->crawPtr());
+    }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    StridedField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const StridedField* addressOfWrapper() const { return this; }
+private:
+    std::ptrdiff_t m_stride;
+    std::size_t m_count;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [FieldDesc]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Zero-storage field descriptor.
+ * @tparam  T       The type of the field represent.
+ * @tparam  offsT   The offset of the field inside of the wrapped object, in bytes.
+ *                  
+ * Descriptors are declared once per wrapper type as `static constexpr` members instead of being
+ * instantiated with every wrapper. Accesses go through the `m_raw` pointer of the wrapper using
+ * `->*`, yielding a plain reference to the wrapped field.
+ * 
+ * @code
+ *      class Cat : public AdvancedClassWrapper<6>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Cat)
+ *      public:
+ *          static constexpr FieldDesc<uint8_t, 0> age{};
+ *      };
+ *      
+ *      auto cat = wrapper_cast<Cat>(catPtr);
+ *      ++(cat->*Cat::age);
+ * @endcode
+ */
+template<typename T, std::ptrdiff_t offsT>
+struct FieldDesc
+{
+    using Type = internal::RewriteWrappers<std::remove_reference_t<T>>;
+
+    static const std::ptrdiff_t kOffs = offsT;
+    static const bool kDoExtraDref = std::is_reference<T>::value;
+
+    /**
+     * @brief   Obtains a reference to the field of an object.
+     * @param   raw The raw pointer of the object.
+     * @return  The reference to the field.
+     */
+    static Type& get(void* raw)
+    {
+        auto ptr = StaticOffsGetter<offsT>{}(raw);
+        return *static_cast<Type*>(kDoExtraDref ? *reinterpret_cast<Type**>(ptr) : ptr);
+    }
+
+    /**
+     * @brief   Obtains a constant reference to the field of an object.
+     * @copydetails get(void*)
+     */
+    static const Type& get(const void* raw)
+    {
+        return get(const_cast<void*>(raw));
+    }
+};
+
+/**
+ * @brief   Accesses the field described by a `FieldDesc` of a wrapped object.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  T           The type of the field represent.
+ * @tparam  offsT       The offset of the field inside of the wrapped object, in bytes.
+ * @param   wrapper     The wrapper.
+ * @param   desc        The field descriptor.
+ * @return  A reference to the field, constant if the wrapper is constant.
+ */
+template<typename WrapperT, typename T, std::ptrdiff_t offsT>
+inline std::enable_if_t<
+    std::is_base_of<ClassWrapper, std::decay_t<WrapperT>>::value,
+    zycore::CloneConst<std::remove_reference_t<WrapperT>, typename FieldDesc<T, offsT>::Type>&
+> operator ->* (WrapperT&& wrapper, FieldDesc<T, offsT> /*desc*/)
+{
+    return FieldDesc<T, offsT>::get(wrapper.addressOfObj());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [validateLayout] + helper classes                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Type occupying the storage of a field of type `T` in the wrapped object.
+ * @tparam  T   The type of the field.
+ *              
+ * Reference fields are stored as pointers, wrapper types are rewritten to their `Weak` variant.
+ */
+template<typename T>
+using FieldStorage = std::conditional_t<
+    std::is_reference<T>::value, void*, RewriteWrappers<T>
+>;
+
+/**
+ * @internal
+ * @brief   Compile-time layout of a field with constant offset.
+ * @tparam  FieldT  The field type (`StaticField` or `FieldDesc`).
+ */
+template<typename FieldT>
+struct FieldLayout
+{
+    static_assert(BlackBoxConsts<FieldT>::kFalse,
+        "layout validation requires fields with compile-time offsets (StaticField, FieldDesc)");
+};
+
+template<typename FieldT>
+struct FieldLayout<const FieldT> : FieldLayout<FieldT> {};
+
+/**
+ * @internal
+ * @brief   Layout of fields described by a triplet of offset, size and alignment.
+ */
+template<std::ptrdiff_t offsT, std::size_t sizeT, std::size_t alignT>
+struct BasicFieldLayout
+{
+    static const std::ptrdiff_t kOffs  = offsT;
+    static const std::size_t    kSize  = sizeT;
+    static const std::size_t    kAlign = alignT;
+    static const std::ptrdiff_t kEnd   = offsT + static_cast<std::ptrdiff_t>(sizeT);
+};
+
+template<std::ptrdiff_t offsT, std::size_t sizeT, std::size_t alignT>
+const std::ptrdiff_t BasicFieldLayout<offsT, sizeT, alignT>::kOffs;
+template<std::ptrdiff_t offsT, std::size_t sizeT, std::size_t alignT>
+const std::size_t BasicFieldLayout<offsT, sizeT, alignT>::kSize;
+template<std::ptrdiff_t offsT, std::size_t sizeT, std::size_t alignT>
+const std::size_t BasicFieldLayout<offsT, sizeT, alignT>::kAlign;
+template<std::ptrdiff_t offsT, std::size_t sizeT, std::size_t alignT>
+const std::ptrdiff_t BasicFieldLayout<offsT, sizeT, alignT>::kEnd;
+
+template<typename T, std::ptrdiff_t offsT>
+struct FieldLayout<StaticField<T, offsT>> 
+    : BasicFieldLayout<offsT, sizeof(FieldStorage<T>), alignof(FieldStorage<T>)> {};
+
+template<typename T, std::ptrdiff_t offsT>
+struct FieldLayout<FieldDesc<T, offsT>> 
+    : BasicFieldLayout<offsT, sizeof(FieldStorage<T>), alignof(FieldStorage<T>)> {};
+
+/**
+ * @internal
+ * @brief   Determines whether a field lies within the bounds of the wrapped object.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      The field type.
+ */
+template<typename WrapperT, typename FieldT>
+constexpr bool fieldFits()
+{
+    return FieldLayout<FieldT>::kOffs >= 0 
+        && FieldLayout<FieldT>::kEnd <= static_cast<std::ptrdiff_t>(WrapperT::kObjSize);
+}
+
+/**
+ * @internal
+ * @brief   Determines whether the offset of a field is a multiple of the field's alignment.
+ * @tparam  FieldT  The field type.
+ */
+template<typename FieldT>
+constexpr bool fieldAligned()
+{
+    return FieldLayout<FieldT>::kOffs % static_cast<std::ptrdiff_t>(FieldLayout<FieldT>::kAlign) 
+        == 0;
+}
+
+/**
+ * @internal
+ * @brief   Determines whether two fields may legally share the object.
+ * @tparam  LhsT    The first field type.
+ * @tparam  RhsT    The second field type.
+ *                  
+ * Fields are compatible when they are disjoint or cover exactly the same bytes. The latter is
+ * permitted to allow aliases like differently typed views of a union member.
+ */
+template<typename LhsT, typename RhsT>
+constexpr bool fieldsCompatible()
+{
+    using L = FieldLayout<LhsT>;
+    using R = FieldLayout<RhsT>;
+    return L::kEnd <= R::kOffs || R::kEnd <= L::kOffs 
+        || (L::kOffs == R::kOffs && L::kSize == R::kSize);
+}
+
+/**
+ * @internal
+ * @brief   Validates a single field, reporting violations through `static_assert`.
+ * @tparam  WrapperT        Type of the wrapper.
+ * @tparam  FieldT          The field type.
+ * @tparam  checkAlignT     Whether the alignment of the field is checked.
+ */
+template<typename WrapperT, typename FieldT, bool checkAlignT>
+struct FieldLayoutCheck
+{
+    static_assert(FieldLayout<FieldT>::kOffs >= 0, "field has a negative offset");
+    static_assert(fieldFits<WrapperT, FieldT>(), "field exceeds the size of the wrapped object");
+    static_assert(!checkAlignT || fieldAligned<FieldT>(), "field offset is misaligned");
+    static const bool kValid = true;
+};
+
+/**
+ * @internal
+ * @brief   Validates a pair of fields, reporting partial overlaps through `static_assert`.
+ * @tparam  LhsT    The first field type.
+ * @tparam  RhsT    The second field type.
+ */
+template<typename LhsT, typename RhsT>
+struct FieldOverlapCheck
+{
+    static_assert(fieldsCompatible<LhsT, RhsT>(), "fields overlap");
+    static const bool kValid = true;
+};
+
+/**
+ * @internal
+ * @brief   Compile-time conjunction of a list of booleans.
+ */
+template<bool... valuesT>
+struct AllOf : std::is_same<
+    std::integer_sequence<bool, true, valuesT...>, 
+    std::integer_sequence<bool, valuesT..., true>
+> {};
 
-    /**
-     * @brief   Obtains a pointer to the wrapper object.
-     * @return  `this`.
-     */
-    Field<T>* addressOfWrapper()             { return this; }
+/**
+ * @internal
+ * @brief   Checks every field of a list against all fields following it.
+ * @tparam  FieldsT The field types.
+ */
+template<typename... FieldsT>
+struct FieldOverlapChecks : std::true_type {};
 
-    /**
-     * @brief   Obtains a constant pointer to the wrapper object.
-     * @return  `this`.
-     */
-    const Field<T>* addressOfWrapper() const { return this; }
+template<typename FirstT, typename... RestT>
+struct FieldOverlapChecks<FirstT, RestT...> : std::integral_constant<bool, 
+    AllOf<FieldOverlapCheck<FirstT, RestT>::kValid...>::value 
+    && FieldOverlapChecks<RestT...>::value
+> {};
+
+/**
+ * @internal
+ * @brief   Validates the layout of a list of fields of a wrapper.
+ * @tparam  WrapperT        Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @tparam  checkAlignT     Whether alignment of the fields is checked.
+ * @tparam  FieldsT         The field types.
+ */
+template<typename WrapperT, bool checkAlignT, typename... FieldsT>
+struct LayoutCheck : std::integral_constant<bool,
+    AllOf<FieldLayoutCheck<WrapperT, FieldsT, checkAlignT>::kValid...>::value
+    && FieldOverlapChecks<FieldsT...>::value
+>
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "layout validation requires usage of AdvancedClassWrapper as base");
 };
 
+} // namespace internal
+
+/**
+ * @brief   Validates the field layout of a wrapper at compile time.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @tparam  FieldsT     The types of the fields to validate, `StaticField` or `FieldDesc`.
+ * @return  Always @c true, violations fail compilation.
+ * 
+ * Every field is required to lie within `kObjSize`, to be located at an offset that is a
+ * multiple of its alignment and to not partially overlap any other field. Fields covering
+ * exactly the same bytes are considered aliases and accepted. Wrappers using `Field` can be
+ * validated by listing equivalent `FieldDesc` types.
+ * 
+ * @code
+ *      class Cat : public AdvancedClassWrapper<8>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Cat)
+ *      public:
+ *          StaticField<uint32_t, 0> id{this};
+ *          static constexpr FieldDesc<uint16_t, 4> age{};
+ *      };
+ *      
+ *      static_assert(validateLayout<Cat, decltype(Cat::id), decltype(Cat::age)>(), "");
+ * @endcode
+ */
+template<typename WrapperT, typename... FieldsT>
+constexpr bool validateLayout()
+{
+    return internal::LayoutCheck<WrapperT, true, FieldsT...>::value;
+}
+
+/**
+ * @brief   Validates the field layout of a packed wrapper at compile time.
+ * @copydetails validateLayout()
+ * @note    Alignment of the fields is not checked, as required for packed structures.
+ */
+template<typename WrapperT, typename... FieldsT>
+constexpr bool validatePackedLayout()
+{
+    return internal::LayoutCheck<WrapperT, false, FieldsT...>::value;
+}
+
 // ---------------------------------------------------------------------------------------------- //
 // [Function]                                                                                     //
 // ---------------------------------------------------------------------------------------------- //
@@ -1305,12 +4601,59 @@ public:
 namespace internal
 {
 
+/**
+ * @internal
+ * @brief   Determines how a wrapper's call operator takes an argument of a prototype.
+ * @tparam  T   The parameter type of the wrapped function.
+ *          
+ * Scalars, references and small trivially copyable types are taken as declared. Other class 
+ * types are taken by `const T&` (or `T&&` if move-only), so they are copied (moved) exactly once,
+ * directly into the parameter of the wrapped function, instead of once into the call operator 
+ * and again into the call.
+ */
+template<typename T>
+struct CallParam
+{
+    static const bool kAsDeclared = !std::is_class<T>::value 
+        || (std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void*));
+
+    using Type = std::conditional_t<kAsDeclared, T, 
+        std::conditional_t<std::is_copy_constructible<T>::value, const T&, T&&>>;
+};
+
+template<typename T>
+struct CallParam<T&>
+{
+    using Type = T&;
+};
+
+template<typename T>
+struct CallParam<T&&>
+{
+    using Type = T&&;
+};
+
+/**
+ * @internal
+ * @brief   The type a wrapper's call operator takes an argument of type @c T by.
+ */
+template<typename T>
+using CallParamT = typename CallParam<T>::Type;
+
+/**
+ * @internal
+ * @brief   Tag selecting the constructors of `Function` and `MemberFunction` that resolve the 
+ *          address from a getter ignoring the raw pointer once, calling it directly afterwards.
+ */
+struct FixedPtrTag {};
+
 /**
  * @internal
  * @brief   Fall-through implementation for non-fptr types.
- * @tparam  T   Invalid template argument.
+ * @tparam  T           Invalid template argument.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
  */
-template<typename T> 
+template<typename T, typename PtrGetterT> 
 class FunctionImpl
 {
     static_assert(BlackBoxConsts<T>::kFalse,
@@ -1323,26 +4666,33 @@ class FunctionImpl
  * @param   callingConv The calling convention.
  */
 #define REMODEL_DEF_FUNCTION(callingConv)                                                          \
-    template<typename RetT, typename... ArgsT>                                                     \
-    class FunctionImpl<RetT (callingConv*)(ArgsT...)>                                              \
-        : public internal::FieldBase                                                               \
+    template<typename PtrGetterT, typename RetT, typename... ArgsT>                                \
+    class FunctionImpl<RetT (callingConv*)(ArgsT...), PtrGetterT>                                  \
+        : public internal::GetterFieldBase<PtrGetterT>                                             \
     {                                                                                              \
     protected:                                                                                     \
         using FunctionPtr = RetT(callingConv*)(ArgsT...);                                          \
     public:                                                                                        \
-        explicit FunctionImpl(PtrGetter ptrGetter)                                                 \
-            : FieldBase{nullptr, ptrGetter}                                                        \
+        explicit FunctionImpl(PtrGetterT ptrGetter, void* fixedPtr = nullptr)                      \
+            : GetterFieldBase<PtrGetterT>{nullptr, ptrGetter}                                      \
+            , m_fixedPtr{fixedPtr}                                                                 \
         {}                                                                                         \
                                                                                                    \
         FunctionPtr get() const                                                                    \
         {                                                                                          \
-            return (FunctionPtr)this->crawPtr();                                                   \
+            return (FunctionPtr)(m_fixedPtr ? m_fixedPtr : this->crawPtr());                       \
         }                                                                                          \
                                                                                                    \
-        RetT operator () (ArgsT... args) const                                                     \
+        RetT operator () (CallParamT<ArgsT>... args) const                                         \
         {                                                                                          \
-            return get()(args...);                                                                 \
+            REMODEL_INSTRUMENT_CALL();                                                             \
+            auto func = get();                                                                     \
+            REMODEL_TRACE_CALL(Function, func, args...);                                           \
+            return func(std::forward<CallParamT<ArgsT>>(args)...);                                 \
         }                                                                                          \
+    private:                                                                                       \
+        /* Address known on construction, bypassing the (type-erased) PtrGetter on calls. */       \
+        void* m_fixedPtr;                                                                          \
     }
 
 /**
@@ -1351,27 +4701,34 @@ class FunctionImpl
  * @param   callingConv The calling convention.
  */
 #define REMODEL_DEF_VARARG_FUNCTION(callingConv)                                                   \
-    template<typename RetT, typename... ArgsT>                                                     \
-    class FunctionImpl<RetT (callingConv*)(ArgsT..., ...)>                                         \
-        : public internal::FieldBase                                                               \
+    template<typename PtrGetterT, typename RetT, typename... ArgsT>                                \
+    class FunctionImpl<RetT (callingConv*)(ArgsT..., ...), PtrGetterT>                             \
+        : public internal::GetterFieldBase<PtrGetterT>                                             \
     {                                                                                              \
     protected:                                                                                     \
         using FunctionPtr = RetT(callingConv*)(ArgsT..., ...);                                     \
     public:                                                                                        \
-        explicit FunctionImpl(PtrGetter ptrGetter)                                                 \
-            : FieldBase{nullptr, ptrGetter}                                                        \
+        explicit FunctionImpl(PtrGetterT ptrGetter, void* fixedPtr = nullptr)                      \
+            : GetterFieldBase<PtrGetterT>{nullptr, ptrGetter}                                      \
+            , m_fixedPtr{fixedPtr}                                                                 \
         {}                                                                                         \
                                                                                                    \
         FunctionPtr get() const                                                                    \
         {                                                                                          \
-            return (FunctionPtr)this->crawPtr();                                                   \
+            return (FunctionPtr)(m_fixedPtr ? m_fixedPtr : this->crawPtr());                       \
         }                                                                                          \
                                                                                                    \
         template<typename... VarArgsT>                                                             \
-        RetT operator () (ArgsT... args, VarArgsT... va) const                                     \
+        RetT operator () (CallParamT<ArgsT>... args, VarArgsT... va) const                         \
         {                                                                                          \
-            return get()(args..., va...);                                                          \
+            REMODEL_INSTRUMENT_CALL();                                                             \
+            auto func = get();                                                                     \
+            REMODEL_TRACE_CALL(Function, func, args..., va...);                                    \
+            return func(std::forward<CallParamT<ArgsT>>(args)..., va...);                          \
         }                                                                                          \
+    private:                                                                                       \
+        /* Address known on construction, bypassing the (type-erased) PtrGetter on calls. */       \
+        void* m_fixedPtr;                                                                          \
     }
 
 #ifdef ZYCORE_MSVC
@@ -1383,9 +4740,22 @@ class FunctionImpl
     REMODEL_DEF_VARARG_FUNCTION(__cdecl);
 #elif defined(ZYCORE_GNUC)
     REMODEL_DEF_FUNCTION(__attribute__((cdecl)));
-    //REMODEL_DEF_FUNCTION(__attribute__((stdcall)));
-    //REMODEL_DEF_FUNCTION(__attribute__((fastcall)));
-    //REMODEL_DEF_FUNCTION(__attribute__((thiscall)));
+#   if defined(__i386__)
+        REMODEL_DEF_FUNCTION(__attribute__((stdcall)));
+        REMODEL_DEF_FUNCTION(__attribute__((fastcall)));
+        REMODEL_DEF_FUNCTION(__attribute__((thiscall)));
+#   elif defined(__x86_64__)
+        // The native ABI is the plain (cdecl) function type, only the foreign one is distinct.
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            REMODEL_DEF_FUNCTION(__attribute__((sysv_abi)));
+#       else
+            REMODEL_DEF_FUNCTION(__attribute__((ms_abi)));
+#       endif
+#   endif
+#   if defined(__clang__) && (defined(__i386__) || (defined(__x86_64__) \
+        && (defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32))))
+        REMODEL_DEF_FUNCTION(__attribute__((vectorcall)));
+#   endif
     REMODEL_DEF_VARARG_FUNCTION(__attribute__((cdecl)));
 #endif
 
@@ -1396,37 +4766,78 @@ class FunctionImpl
 
 /**
  * @brief   Function wrapper template.
- * @tparam  T   A function pointer definition equal to the prototype of the wrapped function.
+ * @tparam  T           A function pointer definition equal to the prototype of the wrapped 
+ *                      function.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation. Defaults to a 
+ *                      type-erased getter accepting any callable.
  */
-template<typename T>
-struct Function : internal::FunctionImpl<T>
+template<typename T, typename PtrGetterT>
+struct Function : internal::FunctionImpl<T, PtrGetterT>
 {
     /**
      * @brief   Constructs an instance with a custom `PtrGetter`.
      * @param   ptrGetter   The `PtrGetter` to use for address calculation.
      */
-    explicit Function(typename Function<T>::PtrGetter ptrGetter)
-        : internal::FunctionImpl<T>(ptrGetter) // MSVC12 requires parentheses here
-    {}
+    explicit Function(PtrGetterT ptrGetter REMODEL_INSTRUMENT_SITE_PARAM)
+        : internal::FunctionImpl<T, PtrGetterT>(ptrGetter) // MSVC12 requires parentheses here
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
 
     /**
      * @brief   Constructs an instance from a pointer to the function in `uint` representation.
      * @param   ptrGetter   The absolute address of the function in `uint` representation.
      */
-    explicit Function(uintptr_t absAddress)
-        : Function{AbsGetter{absAddress}}
-    {}
+    explicit Function(uintptr_t absAddress REMODEL_INSTRUMENT_SITE_PARAM)
+        : Function{AbsGetter{absAddress}, internal::FixedPtrTag{}}
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
 
     /**
      * @brief   Constructs an instance from a raw pointer to the function.
      * @param   ptr     The function pointer of the function to wrap.
      */
-    explicit Function(T ptr)
+    explicit Function(T ptr REMODEL_INSTRUMENT_SITE_PARAM)
     // This cast magic is required because the C++ standard does not permit casting code pointers
     // into data pointers as it doesn't require those to be the same size. remodel, however, makes
     // that assumption (which is validated by a static_cast to reject unsupported platforms), so
     // we can safely bypass the restriction using an extra level of pointers.
-        : Function{AbsGetter{*reinterpret_cast<void**>(&ptr)}}
+        : Function{AbsGetter{*reinterpret_cast<void**>(&ptr)}, internal::FixedPtrTag{}}
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
+
+    /**
+     * @brief   Constructs an instance from an address relative to a module.
+     * @param   module  The module containing the function.
+     * @param   rva     The address of the function relative to the module base.
+     */
+    Function(const Module& module, uintptr_t rva REMODEL_INSTRUMENT_SITE_PARAM)
+        : Function{ModuleRelGetter{module, rva}, internal::FixedPtrTag{}}
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
+
+    /**
+     * @brief   Constructs an instance resolving the address on the first call (see `LazyBinding`).
+     * @param   binding The binding providing the address, must outlive the instance.
+     */
+    explicit Function(const LazyBinding& binding REMODEL_INSTRUMENT_SITE_PARAM)
+        // MSVC12 requires parentheses here
+        : internal::FunctionImpl<T, PtrGetterT>(LazyGetter{binding})
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
+private:
+    /**
+     * @brief   Constructs an instance from a getter returning a fixed address.
+     * @param   ptrGetter   The getter, called once to obtain the address called on invocation.
+     */
+    template<typename FixedGetterT>
+    Function(FixedGetterT ptrGetter, internal::FixedPtrTag)
+        // MSVC12 requires parentheses here
+        : internal::FunctionImpl<T, PtrGetterT>(ptrGetter, ptrGetter(nullptr))
     {}
 };
 
@@ -1440,9 +4851,10 @@ namespace internal
 /**
  * @internal
  * @brief   Fall-through implementation for non-fptr types.
- * @tparam  T   Invalid template argument.
+ * @tparam  T           Invalid template argument.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation.
  */
-template<typename T> 
+template<typename T, typename PtrGetterT> 
 class MemberFunctionImpl
 {
     static_assert(BlackBoxConsts<T>::kFalse,
@@ -1455,26 +4867,40 @@ class MemberFunctionImpl
  * @param   callingConv The calling convention.
  */
 #define REMODEL_DEF_MEMBER_FUNCTION(callingConv)                                                   \
-    template<typename RetT, typename... ArgsT>                                                     \
-    class MemberFunctionImpl<RetT (callingConv*)(ArgsT...)>                                        \
-        : public internal::FieldBase                                                               \
+    template<typename PtrGetterT, typename RetT, typename... ArgsT>                                \
+    class MemberFunctionImpl<RetT (callingConv*)(ArgsT...), PtrGetterT>                            \
+        : public internal::GetterFieldBase<PtrGetterT>                                             \
     {                                                                                              \
     protected:                                                                                     \
         using FunctionPtr = RetT(callingConv*)(void* thiz, ArgsT... args);                         \
     public:                                                                                        \
-        MemberFunctionImpl(ClassWrapper* parent, PtrGetter ptrGetter)                              \
-            : FieldBase{parent, ptrGetter}                                                         \
+        MemberFunctionImpl(ClassWrapper* parent, PtrGetterT ptrGetter, void* fixedPtr = nullptr)   \
+            : GetterFieldBase<PtrGetterT>{parent, ptrGetter}                                       \
+            , m_fixedPtr{fixedPtr}                                                                 \
         {}                                                                                         \
                                                                                                    \
         FunctionPtr get() const                                                                    \
         {                                                                                          \
-            return (FunctionPtr)this->crawPtr();                                                   \
+            return (FunctionPtr)(m_fixedPtr ? m_fixedPtr : this->crawPtr());                       \
+        }                                                                                          \
+                                                                                                   \
+        /* The object the function is called on. */                                                \
+        void* object() const                                                                       \
+        {                                                                                          \
+            return addressOfObj(*this->m_parent);                                                  \
         }                                                                                          \
                                                                                                    \
-        RetT operator () (ArgsT... args) const                                                     \
+        RetT operator () (CallParamT<ArgsT>... args) const                                         \
         {                                                                                          \
-            return get()(addressOfObj(*this->m_parent), args...);                                  \
+            REMODEL_INSTRUMENT_CALL();                                                             \
+            auto func = get();                                                                     \
+            auto thiz = addressOfObj(*this->m_parent);                                             \
+            REMODEL_TRACE_CALL(MemberFunction, func, thiz, args...);                               \
+            return func(thiz, std::forward<CallParamT<ArgsT>>(args)...);                           \
         }                                                                                          \
+    private:                                                                                       \
+        /* Address known on construction, bypassing the (type-erased) PtrGetter on calls. */       \
+        void* m_fixedPtr;                                                                          \
     }
 
 /**
@@ -1484,27 +4910,35 @@ class MemberFunctionImpl
  * @param   callingConv The calling convention.
  */
 #define REMODEL_DEF_VARARG_MEMBER_FUNCTION(callingConv)                                            \
-    template<typename RetT, typename... ArgsT>                                                     \
-    class MemberFunctionImpl<RetT (callingConv*)(ArgsT..., ...)>                                   \
-        : public internal::FieldBase                                                               \
+    template<typename PtrGetterT, typename RetT, typename... ArgsT>                                \
+    class MemberFunctionImpl<RetT (callingConv*)(ArgsT..., ...), PtrGetterT>                       \
+        : public internal::GetterFieldBase<PtrGetterT>                                             \
     {                                                                                              \
     protected:                                                                                     \
         using FunctionPtr = RetT(callingConv*)(void* thiz, ArgsT... args, ...);                    \
     public:                                                                                        \
-        MemberFunctionImpl(ClassWrapper* parent, PtrGetter ptrGetter)                              \
-            : FieldBase{parent, ptrGetter}                                                         \
+        MemberFunctionImpl(ClassWrapper* parent, PtrGetterT ptrGetter, void* fixedPtr = nullptr)   \
+            : GetterFieldBase<PtrGetterT>{parent, ptrGetter}                                       \
+            , m_fixedPtr{fixedPtr}                                                                 \
         {}                                                                                         \
                                                                                                    \
         FunctionPtr get() const                                                                    \
         {                                                                                          \
-            return (FunctionPtr)this->crawPtr();                                                   \
+            return (FunctionPtr)(m_fixedPtr ? m_fixedPtr : this->crawPtr());                       \
         }                                                                                          \
                                                                                                    \
         template<typename... VarArgsT>                                                             \
-        RetT operator () (ArgsT... args, VarArgsT... va) const                                     \
+        RetT operator () (CallParamT<ArgsT>... args, VarArgsT... va) const                         \
         {                                                                                          \
-            return get()(addressOfObj(*this->m_parent), args..., va...);                           \
+            REMODEL_INSTRUMENT_CALL();                                                             \
+            auto func = get();                                                                     \
+            auto thiz = addressOfObj(*this->m_parent);                                             \
+            REMODEL_TRACE_CALL(MemberFunction, func, thiz, args..., va...);                        \
+            return func(thiz, std::forward<CallParamT<ArgsT>>(args)..., va...);                    \
         }                                                                                          \
+    private:                                                                                       \
+        /* Address known on construction, bypassing the (type-erased) PtrGetter on calls. */       \
+        void* m_fixedPtr;                                                                          \
     }
 
 #ifdef ZYCORE_MSVC
@@ -1516,9 +4950,22 @@ class MemberFunctionImpl
     REMODEL_DEF_VARARG_MEMBER_FUNCTION(__cdecl);
 #elif defined(ZYCORE_GNUC)
     REMODEL_DEF_MEMBER_FUNCTION(__attribute__((cdecl)));
-    //REMODEL_DEF_MEMBER_FUNCTION(__attribute__((stdcall)));
-    //REMODEL_DEF_MEMBER_FUNCTION(__attribute__((fastcall)));
-    //REMODEL_DEF_MEMBER_FUNCTION(__attribute__((thiscall)));
+#   if defined(__i386__)
+        REMODEL_DEF_MEMBER_FUNCTION(__attribute__((stdcall)));
+        REMODEL_DEF_MEMBER_FUNCTION(__attribute__((fastcall)));
+        REMODEL_DEF_MEMBER_FUNCTION(__attribute__((thiscall)));
+#   elif defined(__x86_64__)
+        // The native ABI is the plain (cdecl) function type, only the foreign one is distinct.
+#       if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+            REMODEL_DEF_MEMBER_FUNCTION(__attribute__((sysv_abi)));
+#       else
+            REMODEL_DEF_MEMBER_FUNCTION(__attribute__((ms_abi)));
+#       endif
+#   endif
+#   if defined(__clang__) && (defined(__i386__) || (defined(__x86_64__) \
+        && (defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32))))
+        REMODEL_DEF_MEMBER_FUNCTION(__attribute__((vectorcall)));
+#   endif
     REMODEL_DEF_VARARG_MEMBER_FUNCTION(__attribute__((cdecl)));
 #endif
 
@@ -1529,19 +4976,26 @@ class MemberFunctionImpl
 
 /**
  * @brief   Member function wrapper template.
- * @tparam  T   A function pointer definition equal to the prototype of the wrapped function.
+ * @tparam  T           A function pointer definition equal to the prototype of the wrapped 
+ *                      function.
+ * @tparam  PtrGetterT  Type of the `PtrGetter` used for address calculation. Defaults to a 
+ *                      type-erased getter accepting any callable.
  */
-template<typename T>
-struct MemberFunction : internal::MemberFunctionImpl<T>
+template<typename T, typename PtrGetterT>
+struct MemberFunction : internal::MemberFunctionImpl<T, PtrGetterT>
 {
     /**
      * @brief   Constructs an instance with a custom `PtrGetter`.
      * @param   parent      The class wrapper instance this member-function belongs to.
      * @param   ptrGetter   The `PtrGetter` to use for address calculation.
      */
-    explicit MemberFunction(ClassWrapper* parent, typename MemberFunction::PtrGetter ptrGetter)
-        : internal::MemberFunctionImpl<T>(parent, ptrGetter) // MSVC12 requires parentheses here
-    {}
+    explicit MemberFunction(ClassWrapper* parent, PtrGetterT ptrGetter 
+            REMODEL_INSTRUMENT_SITE_PARAM)
+        // MSVC12 requires parentheses here
+        : internal::MemberFunctionImpl<T, PtrGetterT>(parent, ptrGetter)
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
 
     /**
      * @brief   Constructs an instance from a pointer to the member-function in `uint`
@@ -1549,17 +5003,58 @@ struct MemberFunction : internal::MemberFunctionImpl<T>
      * @param   parent      The class wrapper instance this member-function belongs to.
      * @param   ptrGetter   A pointer to the member-function to wrap in `uint` representation.
      */
-    explicit MemberFunction(ClassWrapper* parent, uintptr_t absAddress)
-        : MemberFunction{parent, AbsGetter{absAddress}}
-    {}
+    explicit MemberFunction(ClassWrapper* parent, uintptr_t absAddress 
+            REMODEL_INSTRUMENT_SITE_PARAM)
+        : MemberFunction{parent, AbsGetter{absAddress}, internal::FixedPtrTag{}}
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
 
     /**
      * @brief   Constructs an instance from a raw pointer to the member-function.
      * @param   parent      The class wrapper instance this member-function belongs to.
      * @param   ptrGetter   A raw pointer to the member-function.
      */
-    explicit MemberFunction(ClassWrapper* parent, void* absAddress)
-        : MemberFunction{parent, AbsGetter{absAddress}}
+    explicit MemberFunction(ClassWrapper* parent, void* absAddress REMODEL_INSTRUMENT_SITE_PARAM)
+        : MemberFunction{parent, AbsGetter{absAddress}, internal::FixedPtrTag{}}
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
+
+    /**
+     * @brief   Constructs an instance from an address relative to a module.
+     * @param   parent  The class wrapper instance this member-function belongs to.
+     * @param   module  The module containing the member-function.
+     * @param   rva     The address of the member-function relative to the module base.
+     */
+    MemberFunction(ClassWrapper* parent, const Module& module, uintptr_t rva 
+            REMODEL_INSTRUMENT_SITE_PARAM)
+        : MemberFunction{parent, ModuleRelGetter{module, rva}, internal::FixedPtrTag{}}
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
+
+    /**
+     * @brief   Constructs an instance resolving the address on the first call (see `LazyBinding`).
+     * @param   parent  The class wrapper instance this member-function belongs to.
+     * @param   binding The binding providing the address, must outlive the instance.
+     */
+    MemberFunction(ClassWrapper* parent, const LazyBinding& binding REMODEL_INSTRUMENT_SITE_PARAM)
+        // MSVC12 requires parentheses here
+        : internal::MemberFunctionImpl<T, PtrGetterT>(parent, LazyGetter{binding})
+    {
+        REMODEL_INSTRUMENT_BIND(Function);
+    }
+private:
+    /**
+     * @brief   Constructs an instance from a getter returning a fixed address.
+     * @param   parent      The class wrapper instance this member-function belongs to.
+     * @param   ptrGetter   The getter, called once to obtain the address called on invocation.
+     */
+    template<typename FixedGetterT>
+    MemberFunction(ClassWrapper* parent, FixedGetterT ptrGetter, internal::FixedPtrTag)
+        // MSVC12 requires parentheses here
+        : internal::MemberFunctionImpl<T, PtrGetterT>(parent, ptrGetter, ptrGetter(nullptr))
     {}
 };
 
@@ -1580,13 +5075,90 @@ struct VirtualFunction : MemberFunction<T>
      * @param   vftableIdx      Index of the function inside the table.
      * @param   vftableOffset   Offset of the vftable-pointer in the class.
      */
-    explicit VirtualFunction(
-            ClassWrapper* parent, std::size_t vftableIdx, std::size_t vftableOffset = 0)
-        : MemberFunction<T>(parent, VfTableGetter{vftableIdx, vftableOffset})
+    explicit VirtualFunction(ClassWrapper* parent, std::size_t vftableIdx, 
+            std::size_t vftableOffset = 0 REMODEL_INSTRUMENT_SITE_PARAM)
+        : MemberFunction<T>(
+            parent, VfTableGetter{vftableIdx, vftableOffset} REMODEL_INSTRUMENT_SITE_ARG)
+        // MSVC12 requires parentheses here
+    {}
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [CachedVirtualFunction]                                                                        //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   `VirtualFunction` variant resolving the function address only once per object.
+ * @tparam  T   A function pointer definition equal to the prototype of the wrapped function.
+ * @see     CachedVfTableGetter
+ * @see     refreshVirtualFunctions
+ */
+template<typename T>
+struct CachedVirtualFunction : MemberFunction<T, CachedVfTableGetter>
+{
+    /**
+     * @brief   Constructs an instance from a vftable index.
+     * @param   parent          The class wrapper instance this member-function belongs to.
+     * @param   vftableIdx      Index of the function inside the table.
+     * @param   vftableOffset   Offset of the vftable-pointer in the class.
+     */
+    explicit CachedVirtualFunction(ClassWrapper* parent, std::size_t vftableIdx, 
+            std::size_t vftableOffset = 0 REMODEL_INSTRUMENT_SITE_PARAM)
+        : MemberFunction<T, CachedVfTableGetter>(
+            parent, CachedVfTableGetter{vftableIdx, vftableOffset} REMODEL_INSTRUMENT_SITE_ARG)
         // MSVC12 requires parentheses here
     {}
+
+    /**
+     * @brief   Obtains the location of the vftable-pointer of the object this function belongs to.
+     * @return  The location of the vftable-pointer.
+     */
+    void* const* vftablePtr() const
+    {
+        return reinterpret_cast<void* const*>(
+            reinterpret_cast<uintptr_t>(this->parentRaw()) + this->ptrGetter().vftableOffset()
+            );
+    }
+
+    /**
+     * @brief   Reads the vftable-pointer of the object this function belongs to.
+     * @return  The vftable.
+     */
+    void* vftable() const { return *vftablePtr(); }
+
+    /**
+     * @brief   Re-resolves the function address, e.g. after the object's vftable changed.
+     */
+    void refresh() { refresh(vftable()); }
+
+    /**
+     * @brief   Re-resolves the function address from an already obtained vftable.
+     * @param   vftable The vftable of the object this function belongs to.
+     */
+    void refresh(void* vftable) { this->mutablePtrGetter().resolve(this->parentRaw(), vftable); }
 };
 
+/**
+ * @brief   Re-resolves multiple `CachedVirtualFunction`s, reading the vftable only once.
+ * @tparam  FirstT      Type of the first function.
+ * @tparam  FunctionsT  Types of the other functions.
+ * @param   first       The first function.
+ * @param   functions   The other functions. 
+ *                      
+ * Functions belonging to another object or using a different vftable than the first function
+ * are resolved using their own vftable.
+ */
+template<typename FirstT, typename... FunctionsT>
+inline void refreshVirtualFunctions(FirstT& first, FunctionsT&... functions)
+{
+    auto vftable = first.vftable();
+    first.refresh(vftable);
+    (void)std::initializer_list<int>{(
+        functions.refresh(
+            first.vftablePtr() == functions.vftablePtr() ? vftable : functions.vftable()
+            ), 0)...};
+}
+
 // ============================================================================================== //
 // Classes that may be used to place objects in a global or module level space                    //
 // ============================================================================================== //
@@ -1607,11 +5179,12 @@ class Global
     /**
      * @brief   Default constructor.
      */
-    Global() : ClassWrapper{nullptr} {}
+    constexpr Global() : ClassWrapper{nullptr} {}
 public:
     /**
      * @brief   Gets the instance of the singleton.
      * @return  The instance.
+     * @note    The instance is constant-initialized, so no initialization guard is checked.
      */
     static Global* instance()
     {
@@ -1620,6 +5193,71 @@ public:
     }
 };
 
+namespace internal
+{
+
+inline bool isGlobalWrapper(const ClassWrapper* wrapper)
+{
+    return wrapper == Global::instance();
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [GlobalField]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Field representing a global variable at a fixed absolute address.
+ * @tparam  T   The type of the global.
+ *              
+ * Behaves like `Field<T, AbsGetter>` with `Global::instance()` as parent, but the constructor is
+ * `constexpr`: globals declared at namespace scope are constant-initialized, running no dynamic
+ * initializer at load time and never allocating. Accesses load the address and dereference it.
+ * @code
+ *      GlobalField<uint32_t> g_frameCount{0x140A1B2C0};
+ * @endcode
+ * With `REMODEL_INSTRUMENT`, accesses are counted but not attributed to a declaration site.
+ */
+template<typename T>
+class GlobalField : public internal::BasicField<T, AbsGetter>
+{
+    using Base = internal::BasicField<T, AbsGetter>;
+public:
+    using typename Base::RewrittenT;
+    using Base::operator =;
+
+    /**
+     * @brief   Constructor.
+     * @param   address The absolute address of the global.
+     */
+    constexpr explicit GlobalField(uintptr_t address)
+        : Base(nullptr, AbsGetter{address}) // MSVC12 requires parentheses here
+    {}
+
+    /**
+     * @brief   Assignment operator simulating normal copy semantics for fields.
+     * @param   rhs The right hand side.
+     * @return  `*this`.
+     */
+    RewrittenT& operator = (const GlobalField& rhs)
+    {
+        return this->valueRef() = rhs.valueCRef();
+    }
+
+    /**
+     * @brief   Obtains a pointer to the wrapper object.
+     * @return  `this`.
+     */
+    GlobalField* addressOfWrapper()             { return this; }
+
+    /**
+     * @brief   Obtains a constant pointer to the wrapper object.
+     * @return  `this`.
+     */
+    const GlobalField* addressOfWrapper() const { return this; }
+};
+
 // ---------------------------------------------------------------------------------------------- //
 // [Module]                                                                                       //
 // ---------------------------------------------------------------------------------------------- //
@@ -1635,17 +5273,191 @@ public:
      * @brief   Gets a module by it's name (e.g. `ntdll.dll`).
      * @param   moduleName  The name of the desired module.
      * @return  If found, the module, else an empty optional.
+     * @note    Lookups are memoized until modules are (un)loaded, see 
+     *          `platform::obtainModuleHandleCached`.
      */
     static zycore::Optional<Module> getModule(const char* moduleName)
     {
-        auto modulePtr = platform::obtainModuleHandle(moduleName);
+        auto modulePtr = platform::obtainModuleHandleCached(moduleName);
         if (!modulePtr) return zycore::kEmpty;
         return {zycore::kInPlace, wrapper_cast<Module>(modulePtr)};
     }
+
+    /**
+     * @brief   Searches the readable sections of the module for a byte pattern.
+     * @param   pattern The pattern.
+     * @return  If found, the address of the first match, else an empty optional.
+     *          
+     * The result is an absolute address, usable with @c AbsGetter, e.g.
+     * @code
+     *      auto addr = Module::getModule("game.dll").value().findPattern("48 8B 05 ?? ?? C3");
+     *      if (addr) Function<int(*)()> func{addr.value()};
+     * @endcode
+     */
+    zycore::Optional<uintptr_t> findPattern(const Pattern& pattern) const
+    {
+        return findPatternIn(pattern, nullptr);
+    }
+
+    /**
+     * @brief   Searches the sections of a kind (e.g. only code) for a byte pattern.
+     * @param   pattern The pattern.
+     * @param   kind    The kind of sections to search.
+     * @return  If found, the address of the first match, else an empty optional.
+     */
+    zycore::Optional<uintptr_t> findPattern(const Pattern& pattern, 
+        platform::SectionKind kind) const
+    {
+        return findPatternIn(pattern, &kind);
+    }
+
+    /**
+     * @brief   Searches the readable sections of the module for an IDA-style byte pattern.
+     * @param   pattern The pattern, see @c Pattern.
+     * @return  If found, the address of the first match, else an empty optional.
+     */
+    zycore::Optional<uintptr_t> findPattern(const char* pattern) const
+    {
+        return findPattern(Pattern{pattern});
+    }
+
+    /**
+     * @brief   Resolves the unresolved patterns of a batch in a single pass over the readable 
+     *          sections of the module.
+     * @param   batch       The batch, receiving the results.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per 
+     *                      hardware thread (see `PatternBatch::scan`).
+     * @return  @c true if all patterns of the batch are resolved, else @c false.
+     */
+    bool findPatterns(PatternBatch& batch, unsigned threadCount = 1) const
+    {
+        return findPatternsIn(batch, nullptr, threadCount);
+    }
+
+    /**
+     * @brief   Resolves the unresolved patterns of a batch in a single pass over the sections of
+     *          a kind (e.g. only code).
+     * @param   batch       The batch, receiving the results.
+     * @param   kind        The kind of sections to search.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per 
+     *                      hardware thread (see `PatternBatch::scan`).
+     * @return  @c true if all patterns of the batch are resolved, else @c false.
+     */
+    bool findPatterns(PatternBatch& batch, platform::SectionKind kind, 
+        unsigned threadCount = 1) const
+    {
+        return findPatternsIn(batch, &kind, threadCount);
+    }
+
+    /**
+     * @brief   Looks up an exported symbol of the module.
+     * @param   name    The name of the symbol.
+     * @return  If exported, the address of the symbol, else an empty optional.
+     *          
+     * The export table is indexed on the first lookup and the index is shared until modules are
+     * (un)loaded, see `platform::obtainExportIndex`.
+     */
+    zycore::Optional<uintptr_t> exportAddress(const char* name) const
+    {
+        auto address = platform::obtainExportIndex(addressOfObj())->find(name);
+        if (!address) return zycore::kEmpty;
+        return {zycore::kInPlace, reinterpret_cast<uintptr_t>(address)};
+    }
+
+    /**
+     * @brief   Gets the size of the address range occupied by the module.
+     * @return  The size in bytes, zero if unknown.
+     */
+    std::size_t imageSize() const
+    {
+        return platform::obtainModuleSize(addressOfObj());
+    }
+
+    /**
+     * @brief   Gets the readable sections of the module.
+     * @return  The sections, ordered as in the module's headers.
+     */
+    std::vector<platform::ModuleSection> sections() const
+    {
+        std::vector<platform::ModuleSection> result;
+        platform::enumModuleSections(addressOfObj(), 
+            [&](const platform::ModuleSection& section) { result.push_back(section); });
+        return result;
+    }
+
+    /**
+     * @brief   Gets the section a pointer points into.
+     * @param   ptr The pointer.
+     * @return  If inside a readable section of the module, the section, else an empty optional.
+     */
+    zycore::Optional<platform::ModuleSection> sectionOf(const void* ptr) const
+    {
+        platform::ModuleSection result{};
+        platform::enumModuleSections(addressOfObj(), 
+            [&](const platform::ModuleSection& section)
+        {
+            if (!result.begin && section.contains(ptr)) result = section;
+        });
+        if (!result.begin) return zycore::kEmpty;
+        return {zycore::kInPlace, result};
+    }
+private:
+    /**
+     * @internal
+     * @brief   Invokes a function for the readable sections of a kind (or all, if @c nullptr).
+     */
+    template<typename FuncT>
+    void enumSections(const platform::SectionKind* kind, FuncT&& func) const
+    {
+        platform::enumModuleSections(addressOfObj(), 
+            [&](const platform::ModuleSection& section)
+        {
+            if (!kind || section.kind == *kind) func(section);
+        });
+    }
+
+    /**
+     * @internal
+     * @copydoc findPattern(const Pattern&, platform::SectionKind) const
+     */
+    zycore::Optional<uintptr_t> findPatternIn(const Pattern& pattern, 
+        const platform::SectionKind* kind) const
+    {
+        const uint8_t* match = nullptr;
+        enumSections(kind, [&](const platform::ModuleSection& section)
+        {
+            if (!match) match = remodel::findPattern(section.begin, section.size, pattern);
+        });
+        if (!match) return zycore::kEmpty;
+        return {zycore::kInPlace, reinterpret_cast<uintptr_t>(match)};
+    }
+
+    /**
+     * @internal
+     * @copydoc findPatterns(PatternBatch&, platform::SectionKind, unsigned) const
+     */
+    bool findPatternsIn(PatternBatch& batch, const platform::SectionKind* kind,
+        unsigned threadCount) const
+    {
+        enumSections(kind, [&](const platform::ModuleSection& section)
+        {
+            batch.scan(section.begin, section.size, threadCount);
+        });
+        return batch.allResolved();
+    }
 };
 
+// Requires the complete `Module` type, thus defined here.
+inline ModuleRelGetter::ModuleRelGetter(const Module& module, uintptr_t rva)
+    : ModuleRelGetter{module.addressOfObj(), rva}
+{}
+
 // ============================================================================================== //
 
 } // namespace remodel
 
+#ifdef REMODEL_EXTERN_TEMPLATES
+#   include "RemodelExtern.hpp"
+#endif
+
 #endif // REMODEL_REMODEL_HPP
@@ -0,0 +1,87 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_REMODELEXTERN_HPP
+#define REMODEL_REMODELEXTERN_HPP
+
+/**     
+ * @file
+ * @brief Contains explicit instantiations of commonly wrapped field types.
+ *        
+ * With `REMODEL_EXTERN_TEMPLATES` defined (the `remodel_compiled` CMake target does so), 
+ * `Remodel.hpp` includes this file, declaring the field classes below as `extern template` so 
+ * every translation unit stops instantiating them over and over again. `src/RemodelInstances.cpp` 
+ * includes it a second time with `REMODEL_TEMPLATE_INSTANTIATION` defined to `template`, providing
+ * the single definition of each. Without the define, remodel stays purely header-only.
+ *
+ * Only classes whose members are valid for all their types are instantiated as a whole. Arrays 
+ * cannot be assigned, so `Field<T[N]>` just gets its reference accessors instantiated. Operators 
+ * forwarded by zycore are member templates and thus still instantiated on use.
+ */
+
+#include "Remodel.hpp"
+
+#ifndef REMODEL_TEMPLATE_INSTANTIATION
+#   define REMODEL_TEMPLATE_INSTANTIATION extern template
+#endif
+
+// ============================================================================================== //
+// [Type lists]                                                                                   //
+// ============================================================================================== //
+
+#define REMODEL_EXTERN_SCALAR_TYPES(x)                                                            \
+    x(bool) x(char) x(signed char) x(unsigned char) x(short) x(unsigned short) x(int)             \
+    x(unsigned int) x(long) x(unsigned long) x(long long) x(unsigned long long) x(float)          \
+    x(double)
+
+#define REMODEL_EXTERN_POINTER_TYPES(x)                                                           \
+    x(void*) x(const void*) x(char*) x(const char*)
+
+#define REMODEL_EXTERN_ARRAY_TYPES(x)                                                             \
+    x(float, 2) x(float, 3) x(float, 4) x(float, 16) x(char, 16) x(char, 32) x(char, 64)
+
+// ============================================================================================== //
+// [Instantiations]                                                                               //
+// ============================================================================================== //
+
+#define REMODEL_INSTANTIATE_FIELD(type)                                                           \
+    REMODEL_TEMPLATE_INSTANTIATION                                                                \
+        class ::remodel::internal::BasicField<type, ::remodel::internal::DefaultPtrGetter>;       \
+    REMODEL_TEMPLATE_INSTANTIATION class ::remodel::Field<type>;
+
+#define REMODEL_INSTANTIATE_ARRAY_FIELD(type, count)                                              \
+    REMODEL_TEMPLATE_INSTANTIATION type (&::remodel::internal::BasicField<                        \
+        type[count], ::remodel::internal::DefaultPtrGetter>::valueRef())[count];                  \
+    REMODEL_TEMPLATE_INSTANTIATION const type (&::remodel::internal::BasicField<                  \
+        type[count], ::remodel::internal::DefaultPtrGetter>::valueCRef() const)[count];
+
+REMODEL_EXTERN_SCALAR_TYPES(REMODEL_INSTANTIATE_FIELD)
+REMODEL_EXTERN_POINTER_TYPES(REMODEL_INSTANTIATE_FIELD)
+REMODEL_EXTERN_ARRAY_TYPES(REMODEL_INSTANTIATE_ARRAY_FIELD)
+
+#undef REMODEL_INSTANTIATE_ARRAY_FIELD
+#undef REMODEL_INSTANTIATE_FIELD
+
+// ============================================================================================== //
+
+#endif // REMODEL_REMODELEXTERN_HPP
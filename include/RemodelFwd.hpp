@@ -0,0 +1,72 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_REMODELFWD_HPP
+#define REMODEL_REMODELFWD_HPP
+
+/**     
+ * @file
+ * @brief Contains forward declarations of the core classes of the library.
+ *        
+ * Headers only naming wrappers, fields or functions (in signatures, as pointers or references)
+ * can include this file instead of `Remodel.hpp` and leave the full definitions to the 
+ * translation units actually accessing them. Default template arguments are declared here 
+ * rather than on the definitions, so both headers can be included in any order.
+ */
+
+#include <cstddef>
+
+namespace remodel
+{
+
+// ============================================================================================== //
+// [Forward declarations]                                                                         //
+// ============================================================================================== //
+
+class ClassWrapper;
+template<std::size_t objSizeT, std::size_t objAlignT = 1> class AdvancedClassWrapper;
+
+namespace internal
+{
+    class InlineGetter;
+    using DefaultPtrGetter = InlineGetter;
+} // namespace internal
+
+template<typename T, typename PtrGetterT = internal::DefaultPtrGetter> class Field;
+template<typename T, std::ptrdiff_t offsT> class StaticField;
+template<typename T, std::ptrdiff_t offsT> struct FieldDesc;
+
+template<typename T, typename PtrGetterT = internal::DefaultPtrGetter> struct Function;
+template<typename T, typename PtrGetterT = internal::DefaultPtrGetter> struct MemberFunction;
+template<typename T> struct VirtualFunction;
+
+class Module;
+class Global;
+
+template<typename WrapperT> inline WrapperT wrapper_cast(void* raw);
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_REMODELFWD_HPP
@@ -0,0 +1,1435 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_REMOTE_HPP
+#define REMODEL_REMOTE_HPP
+
+/**     
+ * @file
+ * @brief Contains support for wrapping objects living in other processes.
+ *        
+ * Fields dereference their pointers directly, so wrappers only work on objects in the current 
+ * address space. `RemoteInstance` makes the same wrapper definitions usable with objects of 
+ * another process by keeping a local snapshot of the whole object: the snapshot is read and 
+ * written back in one go per object (or one go for many objects using `refreshAll`) instead of 
+ * issuing one read per field access.
+ *
+ * @code
+ *      ProcessMemoryAccessor process{processHandle};
+ *      auto dog = wrapper_cast<Dog>(dogAddress).snapshot(process);
+ *      if (dog.refresh())
+ *      {
+ *          dog->age += 1;
+ *          dog.commit();
+ *      }
+ * @endcode
+ * 
+ * Snapshots are also fetched lazily on the first field access after construction or after
+ * `invalidate` was called. Arrays of remote objects are iterated with `RemoteSpan`, reading many
+ * objects per transfer.
+ *
+ * @warning Pointers read from a snapshot are addresses in the other process. Construct a new
+ *          `RemoteInstance` to follow them instead of dereferencing them. Wrapped functions can't
+ *          be called on remote objects directly, see `RemoteCallQueue` for queueing such calls.
+ */
+
+#include "Remodel.hpp"
+#include "WrapperSpan.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace remodel
+{
+
+// ============================================================================================== //
+// Memory accessors                                                                               //
+// ============================================================================================== //
+
+/*
+ * Memory accessors are the policy `RemoteInstance` uses to transfer memory. They are required
+ * to provide the following functions:
+ * 
+ * bool read(const MemoryRange& range);
+ * bool read(const MemoryRange* ranges, std::size_t count);
+ * bool write(const MemoryRange& range);
+ * 
+ * Accessors able to write several ranges at once additionally provide the following function,
+ * writing the ranges in order. It is used in place of single writes where available.
+ * 
+ * bool write(const MemoryRange* ranges, std::size_t count);
+ */
+
+using platform::MemoryRange;
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Determines whether an accessor provides batched writes.
+ */
+template<typename AccessorT, typename = void>
+struct HasBatchedWrite : std::false_type {};
+
+template<typename AccessorT>
+struct HasBatchedWrite<AccessorT, decltype((void)std::declval<AccessorT&>().write(
+    std::declval<const MemoryRange*>(), std::size_t{}))> : std::true_type {};
+
+/**
+ * @internal
+ * @brief   Writes several ranges through an accessor, in one go if supported.
+ * @return  @c true if all ranges were written, else @c false.
+ */
+template<typename AccessorT>
+inline std::enable_if_t<HasBatchedWrite<AccessorT>::value, bool> writeRanges(
+    AccessorT& accessor, const MemoryRange* ranges, std::size_t count)
+{
+    return !count || accessor.write(ranges, count);
+}
+
+template<typename AccessorT>
+inline std::enable_if_t<!HasBatchedWrite<AccessorT>::value, bool> writeRanges(
+    AccessorT& accessor, const MemoryRange* ranges, std::size_t count)
+{
+    bool success = true;
+    for (std::size_t i = 0; i < count; ++i) success &= accessor.write(ranges[i]);
+    return success;
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [LocalMemoryAccessor]                                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Memory accessor for the current address space.
+ *          
+ * Mostly useful for working on snapshots of local objects and for testing.
+ */
+class LocalMemoryAccessor
+{
+public:
+    /**
+     * @brief   Reads a range of memory.
+     * @param   range   The range to read and the buffer to read into.
+     * @return  @c true.
+     */
+    bool read(const MemoryRange& range)
+    {
+        std::memcpy(range.buffer, reinterpret_cast<const void*>(range.address), range.size);
+        return true;
+    }
+
+    /**
+     * @brief   Reads multiple ranges of memory.
+     * @param   ranges  The ranges to read and the buffers to read into.
+     * @param   count   The number of ranges.
+     * @return  @c true.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            read(ranges[i]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Writes a range of memory.
+     * @param   range   The range to write and the buffer holding the data.
+     * @return  @c true.
+     */
+    bool write(const MemoryRange& range)
+    {
+        std::memcpy(reinterpret_cast<void*>(range.address), range.buffer, range.size);
+        return true;
+    }
+};
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+// ---------------------------------------------------------------------------------------------- //
+// [ProcessMemoryAccessor]                                                                        //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Memory accessor for another process (`ReadProcessMemory`, `process_vm_readv`, 
+ *          `mach_vm_read_overwrite`).
+ */
+class ProcessMemoryAccessor
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   process The process to access. The handle is not owned by the accessor.
+     */
+    explicit ProcessMemoryAccessor(platform::ProcessHandle process)
+        : m_process{process}
+    {}
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the whole range was read, else @c false.
+     */
+    bool read(const MemoryRange& range)
+    {
+        return platform::readProcessMemory(m_process, range);
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges were read completely, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        return platform::readProcessMemory(m_process, ranges, count);
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::write
+     * @return  @c true if the whole range was written, else @c false.
+     */
+    bool write(const MemoryRange& range)
+    {
+        return platform::writeProcessMemory(m_process, range);
+    }
+
+    /**
+     * @brief   Writes multiple ranges of memory in order.
+     * @param   ranges  The ranges to write and the buffers holding the data.
+     * @param   count   The number of ranges.
+     * @return  @c true if all ranges were written completely, else @c false.
+     */
+    bool write(const MemoryRange* ranges, std::size_t count)
+    {
+        return platform::writeProcessMemory(m_process, ranges, count);
+    }
+
+    /**
+     * @brief   Gets the handle of the accessed process.
+     * @return  The handle.
+     */
+    platform::ProcessHandle process() const { return m_process; }
+private:
+    platform::ProcessHandle m_process;
+};
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+#ifdef REMODEL_HAS_IO_URING
+
+// ---------------------------------------------------------------------------------------------- //
+// [UringMemoryAccessor]                                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Memory accessor for another process on Linux, batching reads through io_uring.
+ *          
+ * Batched reads (e.g. by `RemoteInstance::refreshAll` or `PageCacheAccessor`) are submitted 
+ * hundreds per system call and executed concurrently by the kernel, so scans over many remote 
+ * objects pipeline their I/O. See `platform::ProcMemRing`.
+ * 
+ * @note    For resident memory `ProcessMemoryAccessor` is faster, as `process_vm_readv` already 
+ *          transfers a batch per call without the kernel's worker threads. The ring pays off 
+ *          when reads block, e.g. on swapped out or not yet faulted in file-backed pages, as 
+ *          these are waited for concurrently, and where `process_vm_readv` is filtered.
+ */
+class UringMemoryAccessor
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   process The process to access.
+     * @param   entries The number of reads submitted per system call.
+     */
+    explicit UringMemoryAccessor(platform::ProcessHandle process, unsigned entries = 256)
+        : m_ring{process, entries}
+    {}
+
+    /**
+     * @brief   Determines whether the memory of the process could be opened.
+     */
+    bool isValid() const { return m_ring.isOpen(); }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the whole range was read, else @c false.
+     */
+    bool read(const MemoryRange& range) { return m_ring.read(range); }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges were read completely, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count) { return m_ring.read(ranges, count); }
+
+    /**
+     * @copydoc LocalMemoryAccessor::write
+     * @return  @c true if the whole range was written, else @c false.
+     */
+    bool write(const MemoryRange& range) { return m_ring.write(range); }
+
+    /**
+     * @brief   Determines whether batches are submitted through io_uring.
+     */
+    bool hasRing() const { return m_ring.hasRing(); }
+private:
+    platform::ProcMemRing m_ring;
+};
+
+#endif // ifdef REMODEL_HAS_IO_URING
+
+// ---------------------------------------------------------------------------------------------- //
+// [PageCacheAccessor]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Memory accessor caching whole pages read through another accessor.
+ * @tparam  AccessorT   Type of the underlying accessor.
+ *                      
+ * Reads are served from cached pages, the missing pages of a call are fetched with a single
+ * batched read of the underlying accessor (one `process_vm_readv` scatter list for 
+ * `ProcessMemoryAccessor`). Wrappers touching the same few pages repeatedly thus issue a few 
+ * page fetches instead of one transfer per read.
+ * 
+ * Cached pages don't see changes made by the accessed process. Pages are dropped all at once 
+ * by `invalidate` (e.g. once per tick), per range, or when exceeding a maximum age. Writes are 
+ * passed through and update the cached pages. If the cache is full, pages are replaced in 
+ * order of their fetches.
+ * 
+ * Ranges of pages that can't be fetched as a whole (e.g. in a dump containing parts of pages)
+ * are read from the underlying accessor directly.
+ */
+template<typename AccessorT>
+class PageCacheAccessor
+{
+public:
+    static const std::size_t kPageSize = 4096;
+    static const std::size_t kDefaultMaxPages = 1024;
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief   Constructor.
+     * @param   inner       The underlying accessor. Must outlive this instance.
+     * @param   maxPages    The maximum number of cached pages.
+     */
+    explicit PageCacheAccessor(AccessorT& inner, std::size_t maxPages = kDefaultMaxPages)
+        : m_inner{&inner}
+        , m_data(maxPages * kPageSize)
+        , m_slots(maxPages)
+    {
+        m_index.reserve(maxPages);
+    }
+
+    PageCacheAccessor(const PageCacheAccessor&) = delete;
+    PageCacheAccessor& operator = (const PageCacheAccessor&) = delete;
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the whole range was read, else @c false.
+     */
+    bool read(const MemoryRange& range) { return read(&range, 1); }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges were read completely, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        auto now = m_maxAge.count() ? Clock::now() : Clock::time_point{};
+
+        // Fetching all missing pages in one go. A call exceeding the capacity of the cache 
+        // bypasses it.
+        m_fetches.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            forEachPage(ranges[i], [&](uintptr_t page)
+            {
+                if (lookup(page, now) || m_fetches.size() == m_slots.size()) return;
+                auto slot = allocate(page, now);
+                m_fetches.push_back({page * kPageSize, &m_data[slot * kPageSize], kPageSize});
+            });
+            if (m_fetches.size() == m_slots.size())
+            {
+                invalidateFetches();
+                return m_inner->read(ranges, count);
+            }
+        }
+        fetch();
+
+        bool success = true;
+        for (std::size_t i = 0; i < count; ++i) success &= copyOut(ranges[i], now);
+        return success;
+    }
+
+    /**
+     * @brief   Writes a range of memory through the underlying accessor, updating cached pages.
+     * @param   range   The range to write and the buffer holding the data.
+     * @return  @c true if the whole range was written, else @c false.
+     */
+    bool write(const MemoryRange& range)
+    {
+        if (!m_inner->write(range))
+        {
+            invalidate(range.address, range.size);
+            return false;
+        }
+        update(range);
+        return true;
+    }
+
+    /**
+     * @brief   Writes multiple ranges of memory in order, in one go if supported by the 
+     *          underlying accessor.
+     * @param   ranges  The ranges to write and the buffers holding the data.
+     * @param   count   The number of ranges.
+     * @return  @c true if all ranges were written completely, else @c false.
+     */
+    bool write(const MemoryRange* ranges, std::size_t count)
+    {
+        bool success = internal::writeRanges(*m_inner, ranges, count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (success) update(ranges[i]);
+            else invalidate(ranges[i].address, ranges[i].size);
+        }
+        return success;
+    }
+
+    /**
+     * @brief   Drops all cached pages.
+     */
+    void invalidate() 
+    { 
+        m_index.clear(); 
+        m_next = 0;
+    }
+
+    /**
+     * @brief   Drops the cached pages overlapping a range of memory.
+     * @param   address The address of the range.
+     * @param   size    The size of the range, in bytes.
+     */
+    void invalidate(uintptr_t address, std::size_t size)
+    {
+        forEachPage(MemoryRange{address, nullptr, size}, [&](uintptr_t page)
+        {
+            m_index.erase(page);
+        });
+    }
+
+    /**
+     * @brief   Sets the maximum age of cached pages, older pages are fetched again.
+     * @param   age The maximum age, zero to keep pages until invalidated.
+     */
+    void setMaxAge(Clock::duration age) { m_maxAge = age; }
+
+    /**
+     * @brief   Gets the number of batched reads issued to the underlying accessor.
+     */
+    uint64_t fetchCount() const { return m_fetchCount; }
+
+    /**
+     * @brief   Gets the number of pages fetched.
+     */
+    uint64_t pagesFetched() const { return m_pagesFetched; }
+
+    /**
+     * @brief   Gets the underlying accessor.
+     */
+    AccessorT& inner() const { return *m_inner; }
+private:
+    struct Slot
+    {
+        uintptr_t page;
+        Clock::time_point fetched;
+    };
+
+    /**
+     * @internal
+     * @brief   Copies written data into the cached pages.
+     */
+    void update(const MemoryRange& range)
+    {
+        auto src = static_cast<const uint8_t*>(range.buffer);
+        forEachPage(range, [&](uintptr_t page)
+        {
+            auto it = m_index.find(page);
+            if (it == m_index.end()) return;
+            auto begin = std::max(range.address, page * kPageSize);
+            auto end   = std::min(range.address + range.size, (page + 1) * kPageSize);
+            std::memcpy(&m_data[it->second * kPageSize + begin % kPageSize], 
+                src + (begin - range.address), end - begin);
+        });
+    }
+
+    template<typename FuncT>
+    static void forEachPage(const MemoryRange& range, FuncT&& func)
+    {
+        if (!range.size) return;
+        auto last = (range.address + range.size - 1) / kPageSize;
+        for (auto page = range.address / kPageSize; page <= last; ++page) func(page);
+    }
+
+    /**
+     * @internal
+     * @brief   Looks up the slot of a cached page, dropping it if too old.
+     */
+    const uint8_t* lookup(uintptr_t page, Clock::time_point now)
+    {
+        auto it = m_index.find(page);
+        if (it == m_index.end()) return nullptr;
+        if (m_maxAge.count() && now - m_slots[it->second].fetched > m_maxAge)
+        {
+            m_index.erase(it);
+            return nullptr;
+        }
+        return &m_data[it->second * kPageSize];
+    }
+
+    std::size_t allocate(uintptr_t page, Clock::time_point now)
+    {
+        auto slot = m_next;
+        m_next = (m_next + 1) % m_slots.size();
+        auto it = m_index.find(m_slots[slot].page);
+        if (it != m_index.end() && it->second == slot) m_index.erase(it);
+        m_slots[slot] = {page, now};
+        m_index[page] = slot;
+        return slot;
+    }
+
+    void invalidateFetches()
+    {
+        for (const auto& range : m_fetches) m_index.erase(range.address / kPageSize);
+    }
+
+    void fetch()
+    {
+        if (m_fetches.empty()) return;
+        ++m_fetchCount;
+        m_pagesFetched += m_fetches.size();
+        if (m_inner->read(m_fetches.data(), m_fetches.size())) return;
+
+        // Finding the pages that failed, the data of the others is valid.
+        for (const auto& range : m_fetches)
+        {
+            if (!m_inner->read(range)) m_index.erase(range.address / kPageSize);
+        }
+    }
+
+    bool copyOut(const MemoryRange& range, Clock::time_point now)
+    {
+        auto dst = static_cast<uint8_t*>(range.buffer);
+        bool cached = true;
+        forEachPage(range, [&](uintptr_t page)
+        {
+            auto data = cached ? lookup(page, now) : nullptr;
+            if (!data)
+            {
+                cached = false;
+                return;
+            }
+            auto begin = std::max(range.address, page * kPageSize);
+            auto end   = std::min(range.address + range.size, (page + 1) * kPageSize);
+            std::memcpy(dst + (begin - range.address), data + begin % kPageSize, end - begin);
+        });
+
+        // Pages that couldn't be fetched or were replaced by pages fetched by the same call.
+        return cached || m_inner->read(range);
+    }
+private:
+    AccessorT* m_inner;
+    std::vector<uint8_t> m_data;
+    std::vector<Slot> m_slots;
+    std::unordered_map<uintptr_t, std::size_t> m_index;
+    std::vector<MemoryRange> m_fetches;
+    std::size_t m_next = 0;
+    Clock::duration m_maxAge{};
+    uint64_t m_fetchCount = 0;
+    uint64_t m_pagesFetched = 0;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [WriteCombiningAccessor]                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Memory accessor buffering writes, flushing them through another accessor in one go.
+ * @tparam  AccessorT   Type of the underlying accessor.
+ *                      
+ * Written ranges are collected until `flush` is called (e.g. after committing all remote 
+ * objects of a tick). Overlapping and adjacent ranges are coalesced, later writes replacing 
+ * the bytes of earlier ones. The coalesced ranges are written with a single batched write 
+ * (one `process_vm_writev` for `ProcessMemoryAccessor`) in order of their first writes: writes
+ * to separate parts of an object reach the target in the order they were issued, bytes written
+ * again are written along with the range they were first written with. Call `flush` in between
+ * writes to enforce their order.
+ * 
+ * Reads see the buffered writes. Write failures are only reported by `flush`.
+ */
+template<typename AccessorT>
+class WriteCombiningAccessor
+{
+public:
+    static const std::size_t kDefaultMaxPending = 64 * 1024;
+
+    /**
+     * @brief   Constructor.
+     * @param   inner       The underlying accessor. Must outlive this instance.
+     * @param   maxPending  The number of buffered bytes exceeding which writes are flushed.
+     */
+    explicit WriteCombiningAccessor(AccessorT& inner, std::size_t maxPending = kDefaultMaxPending)
+        : m_inner{&inner}
+        , m_maxPending{maxPending}
+    {}
+
+    WriteCombiningAccessor(const WriteCombiningAccessor&) = delete;
+    WriteCombiningAccessor& operator = (const WriteCombiningAccessor&) = delete;
+
+    /**
+     * @brief   Destructor, flushing the buffered writes.
+     */
+    ~WriteCombiningAccessor() { flush(); }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the whole range was read, else @c false.
+     */
+    bool read(const MemoryRange& range)
+    {
+        if (!m_inner->read(range)) return false;
+        overlay(range);
+        return true;
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges were read completely, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        bool success = m_inner->read(ranges, count);
+        for (std::size_t i = 0; i < count; ++i) overlay(ranges[i]);
+        return success;
+    }
+
+    /**
+     * @brief   Buffers a write.
+     * @param   range   The range to write and the buffer holding the data.
+     * @return  @c true, unless exceeding the buffer limit caused a failing flush.
+     */
+    bool write(const MemoryRange& range)
+    {
+        if (!range.size) return true;
+
+        auto begin = range.address, end = range.address + range.size;
+        auto src = static_cast<const uint8_t*>(range.buffer);
+
+        // The first segment overlapping or adjacent to the range.
+        auto first = m_segments.upper_bound(begin);
+        if (first != m_segments.begin() && std::prev(first)->first + 
+            std::prev(first)->second.size >= begin) --first;
+
+        if (first != m_segments.end() && first->first <= begin 
+            && first->first + first->second.size >= end)
+        {
+            // Contained in a single segment.
+            std::memcpy(&m_arena[first->second.offset + (begin - first->first)], src, 
+                range.size);
+            return true;
+        }
+
+        auto last = first;
+        auto mergedBegin = begin, mergedEnd = end;
+        auto seq = m_nextSeq++;
+        for (; last != m_segments.end() && last->first <= end; ++last)
+        {
+            mergedBegin = std::min(mergedBegin, last->first);
+            mergedEnd   = std::max(mergedEnd, last->first + last->second.size);
+            seq         = std::min(seq, last->second.seq);
+        }
+
+        // Merged segments are appended to the arena, their previous bytes are released when
+        // flushing.
+        Segment merged{m_arena.size(), mergedEnd - mergedBegin, seq};
+        m_arena.resize(merged.offset + merged.size);
+        for (auto it = first; it != last; ++it)
+        {
+            std::memcpy(&m_arena[merged.offset + (it->first - mergedBegin)], 
+                &m_arena[it->second.offset], it->second.size);
+            m_pending -= it->second.size;
+        }
+        std::memcpy(&m_arena[merged.offset + (begin - mergedBegin)], src, range.size);
+        m_pending += merged.size;
+        m_segments.erase(first, last);
+        m_segments.emplace(mergedBegin, merged);
+
+        return (m_pending <= m_maxPending && m_arena.size() <= 2 * m_maxPending) || flush();
+    }
+
+    /**
+     * @brief   Buffers multiple writes, in order.
+     * @param   ranges  The ranges to write and the buffers holding the data.
+     * @param   count   The number of ranges.
+     * @return  @c true, unless exceeding the buffer limit caused a failing flush.
+     */
+    bool write(const MemoryRange* ranges, std::size_t count)
+    {
+        bool success = true;
+        for (std::size_t i = 0; i < count; ++i) success &= write(ranges[i]);
+        return success;
+    }
+
+    /**
+     * @brief   Writes the buffered ranges through the underlying accessor.
+     * @return  @c true if all ranges were written, else @c false. The buffered writes are 
+     *          discarded in either case.
+     */
+    bool flush()
+    {
+        if (m_segments.empty()) return true;
+
+        m_order.clear();
+        for (const auto& segment : m_segments) m_order.push_back(&segment);
+        std::sort(m_order.begin(), m_order.end(), [](const Entry* a, const Entry* b)
+        {
+            return a->second.seq < b->second.seq;
+        });
+        m_ranges.clear();
+        for (auto entry : m_order)
+        {
+            m_ranges.push_back({entry->first, &m_arena[entry->second.offset], 
+                entry->second.size});
+        }
+
+        ++m_flushCount;
+        bool success = internal::writeRanges(*m_inner, m_ranges.data(), m_ranges.size());
+        m_segments.clear();
+        m_arena.clear();
+        m_pending = 0;
+        return success;
+    }
+
+    /**
+     * @brief   Gets the number of buffered, coalesced ranges.
+     */
+    std::size_t pendingRanges() const { return m_segments.size(); }
+
+    /**
+     * @brief   Gets the number of buffered bytes.
+     */
+    std::size_t pendingBytes() const { return m_pending; }
+
+    /**
+     * @brief   Gets the number of flushes that wrote ranges.
+     */
+    uint64_t flushCount() const { return m_flushCount; }
+
+    /**
+     * @brief   Gets the underlying accessor.
+     */
+    AccessorT& inner() const { return *m_inner; }
+private:
+    struct Segment
+    {
+        /// The offset of the bytes in the arena.
+        std::size_t offset;
+        std::size_t size;
+        /// The order of the first write.
+        uint64_t seq;
+    };
+
+    using Map   = std::map<uintptr_t, Segment>;
+    using Entry = typename Map::value_type;
+
+    /**
+     * @internal
+     * @brief   Copies buffered writes over data read from the underlying accessor.
+     */
+    void overlay(const MemoryRange& range)
+    {
+        auto begin = range.address, end = range.address + range.size;
+        auto it = m_segments.upper_bound(begin);
+        if (it != m_segments.begin()) --it;
+        for (; it != m_segments.end() && it->first < end; ++it)
+        {
+            auto segBegin = std::max(begin, it->first);
+            auto segEnd   = std::min(end, it->first + it->second.size);
+            if (segBegin >= segEnd) continue;
+            std::memcpy(static_cast<uint8_t*>(range.buffer) + (segBegin - begin), 
+                &m_arena[it->second.offset + (segBegin - it->first)], segEnd - segBegin);
+        }
+    }
+private:
+    AccessorT* m_inner;
+    std::size_t m_maxPending;
+    std::size_t m_pending = 0;
+    uint64_t m_nextSeq = 0;
+    uint64_t m_flushCount = 0;
+    Map m_segments;
+    std::vector<uint8_t> m_arena;
+    std::vector<const Entry*> m_order;
+    std::vector<MemoryRange> m_ranges;
+};
+
+// ============================================================================================== //
+// Remote objects                                                                                 //
+// ============================================================================================== //
+
+// ---------------------------------------------------------------------------------------------- //
+// [RemoteInstance]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Local snapshot of an object of another address space, accessed through a wrapper.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @tparam  AccessorT   Type of the memory accessor.
+ */
+template<typename WrapperT, typename AccessorT>
+class RemoteInstance
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "RemoteInstance requires usage of AdvancedClassWrapper as base");
+public:
+    static const std::size_t kObjSize = WrapperT::kObjSize;
+
+    /**
+     * @brief   Bytes of unchanged data tolerated between two changes written back in one go.
+     */
+    static const std::size_t kCommitMergeGap = 16;
+
+    /**
+     * @brief   Constructor. The object is read on first access or when calling `refresh`.
+     * @param   accessor    The memory accessor used for transfers. Must outlive this instance.
+     * @param   address     The address of the object in the accessed address space.
+     */
+    RemoteInstance(AccessorT& accessor, uintptr_t address)
+        : m_accessor{&accessor}
+        , m_address{address}
+        , m_data{}
+        , m_pristine{}
+        , m_valid{false}
+        , m_wrapper{wrapper_cast<WrapperT>(&m_data)}
+    {}
+
+    /**
+     * @copydoc RemoteInstance(AccessorT&, uintptr_t)
+     */
+    RemoteInstance(AccessorT& accessor, const void* address)
+        : RemoteInstance{accessor, reinterpret_cast<uintptr_t>(address)}
+    {}
+
+    /**
+     * @brief   Copy constructor, copying the snapshot.
+     * @param   other   The instance to copy from.
+     */
+    RemoteInstance(const RemoteInstance& other)
+        : m_accessor{other.m_accessor}
+        , m_address{other.m_address}
+        , m_data(other.m_data)
+        , m_pristine(other.m_pristine)
+        , m_valid{other.m_valid}
+        , m_wrapper{wrapper_cast<WrapperT>(&m_data)}
+    {}
+
+    /**
+     * @brief   Assignment operator, copying the snapshot.
+     * @param   other   The instance to assign from.
+     * @return  `*this`.
+     */
+    RemoteInstance& operator = (const RemoteInstance& other)
+    {
+        m_accessor = other.m_accessor;
+        m_address  = other.m_address;
+        m_data     = other.m_data;
+        m_pristine = other.m_pristine;
+        m_valid    = other.m_valid;
+        return *this;
+    }
+
+    /**
+     * @brief   Creates a snapshot of a wrapped object, reading it immediately.
+     * @param   wrapper     The wrapper, pointing into the accessed address space.
+     * @param   accessor    The memory accessor used for transfers. Must outlive the snapshot.
+     * @return  The snapshot, check `isValid` to see whether the read succeeded.
+     */
+    static RemoteInstance of(const WrapperT& wrapper, AccessorT& accessor)
+    {
+        RemoteInstance nrvo{accessor, wrapper.addressOfObj()};
+        nrvo.refresh();
+        return nrvo;
+    }
+
+    /**
+     * @brief   Creates a snapshot of a wrapped object using a default-constructed accessor.
+     * @copydetails of(const WrapperT&, AccessorT&)
+     */
+    static RemoteInstance of(const WrapperT& wrapper)
+    {
+        static AccessorT accessor;
+        return of(wrapper, accessor);
+    }
+
+    /**
+     * @brief   Reads the whole object into the snapshot, discarding uncommitted changes.
+     * @return  @c true if the object was read, else @c false.
+     */
+    bool refresh()
+    {
+        return fetch();
+    }
+
+    /**
+     * @brief   Marks the snapshot as outdated, discarding uncommitted changes.
+     *          
+     * The object is read again on the next access.
+     */
+    void invalidate() { m_valid = false; }
+
+    /**
+     * @brief   Determines whether the snapshot holds data read from the object.
+     * @return  @c true if the last read succeeded and the snapshot wasn't invalidated since.
+     */
+    bool isValid() const { return m_valid; }
+
+    /**
+     * @brief   Refreshes multiple instances using a single batched read where supported.
+     * @param   instances   The instances to refresh.
+     * @param   count       The number of instances.
+     * @return  @c true if all objects were read, else @c false.
+     * @note    All instances are required to use the same accessor.
+     */
+    static bool refreshAll(RemoteInstance* instances, std::size_t count)
+    {
+        if (!count) return true;
+
+        std::vector<MemoryRange> ranges(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ranges[i] = {instances[i].m_address, &instances[i].m_data, kObjSize};
+        }
+
+        bool success = instances->m_accessor->read(ranges.data(), count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            instances[i].m_pristine = instances[i].m_data;
+            instances[i].m_valid    = success;
+        }
+        return success;
+    }
+
+    /**
+     * @brief   Writes changes made to the snapshot back to the object.
+     * @return  @c true if all changes were written, else @c false.
+     *          
+     * Only changed bytes are written, with nearby changes being merged into a single range. 
+     * The ranges are written in one call for accessors supporting batched writes. Fails if the 
+     * snapshot is not valid.
+     */
+    bool commit()
+    {
+        if (!m_valid) return false;
+
+        auto data     = reinterpret_cast<const uint8_t*>(&m_data);
+        auto pristine = reinterpret_cast<const uint8_t*>(&m_pristine);
+
+        // Collecting the runs, issued in batches for accessors supporting batched writes.
+        const std::size_t kBatchSize = 16;
+        MemoryRange batch[kBatchSize];
+        std::size_t batched = 0;
+
+        bool success = true;
+        std::size_t i = 0;
+        while (i < kObjSize)
+        {
+            if (data[i] == pristine[i])
+            {
+                ++i;
+                continue;
+            }
+
+            // Extend the run until more than kCommitMergeGap unchanged bytes follow.
+            std::size_t begin = i, end = i + 1;
+            for (std::size_t j = end; j < kObjSize && j - end <= kCommitMergeGap; ++j)
+            {
+                if (data[j] != pristine[j]) end = j + 1;
+            }
+
+            batch[batched++] = {m_address + begin, const_cast<uint8_t*>(data + begin), end - begin};
+            if (batched == kBatchSize)
+            {
+                success &= internal::writeRanges(*m_accessor, batch, batched);
+                batched = 0;
+            }
+            i = end;
+        }
+        success &= internal::writeRanges(*m_accessor, batch, batched);
+
+        if (success) m_pristine = m_data;
+        return success;
+    }
+
+    /**
+     * @brief   Determines whether the snapshot has changes not yet written back.
+     * @return  @c true if there are uncommitted changes, else @c false.
+     */
+    bool isDirty() const
+    {
+        return std::memcmp(&m_data, &m_pristine, kObjSize) != 0;
+    }
+
+    /**
+     * @brief   Gets the address of the object in the accessed address space.
+     * @return  The address.
+     */
+    uintptr_t remoteAddress() const { return m_address; }
+
+    /**
+     * @brief   Gets the wrapper operating on the snapshot, reading the object if required.
+     * @return  The wrapper.
+     */
+    WrapperT& get()                         { fetchIfInvalid(); return m_wrapper; }
+
+    /**
+     * @copydoc get
+     */
+    const WrapperT& get() const             { fetchIfInvalid(); return m_wrapper; }
+
+    WrapperT* operator -> ()                { return get().addressOfWrapper(); }
+    const WrapperT* operator -> () const    { return get().addressOfWrapper(); }
+private:
+    bool fetch() const
+    {
+        return refreshAll(const_cast<RemoteInstance*>(this), 1);
+    }
+
+    void fetchIfInvalid() const
+    {
+        if (!m_valid) fetch();
+    }
+private:
+    using Storage = std::aligned_storage_t<kObjSize, 
+        (WrapperT::kObjAlign > alignof(std::max_align_t) 
+            ? WrapperT::kObjAlign : alignof(std::max_align_t))>;
+
+    AccessorT* m_accessor;
+    uintptr_t m_address;
+    // The snapshot is a cache of the object, so even constant instances may update it.
+    mutable Storage m_data;
+    mutable Storage m_pristine;
+    mutable bool m_valid;
+    WrapperT m_wrapper;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [RemoteSpan]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Ways a `RemoteSpan` reads its windows of objects.
+ */
+enum class RemoteReadMode
+{
+    /// Windows are read on demand, blocking when the iteration enters a new window.
+    Blocking,
+    /// The next window is read by a worker thread while the current one is processed.
+    DoubleBuffered,
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Reads the objects of a `RemoteSpan` window by window, see `RemoteSpan::iterator`.
+ */
+template<typename WrapperT, typename AccessorT>
+class RemoteSpanReader : public zycore::NonCopyable
+{
+    static const std::size_t kObjSize = WrapperT::kObjSize;
+    static const std::size_t kAlign = WrapperT::kObjAlign > alignof(std::max_align_t) 
+        ? WrapperT::kObjAlign : alignof(std::max_align_t);
+
+    struct Window
+    {
+        std::vector<uint8_t> storage;
+        uint8_t* data = nullptr;
+        std::vector<uint8_t> valid;
+        std::size_t first = 0;
+        std::size_t count = 0;
+    };
+public:
+    RemoteSpanReader(AccessorT& accessor, uintptr_t address, std::size_t count, 
+            std::size_t window, RemoteReadMode mode)
+        : m_accessor{&accessor}
+        , m_address{address}
+        , m_count{count}
+        , m_window{std::max<std::size_t>(window, 1)}
+        , m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+    {
+        for (auto& buffer : m_buffers)
+        {
+            buffer.storage.resize(m_window * kObjSize + kAlign);
+            buffer.data = buffer.storage.data() + (kAlign - 
+                reinterpret_cast<uintptr_t>(buffer.storage.data()) % kAlign) % kAlign;
+            buffer.valid.resize(m_window);
+        }
+
+        fill(m_buffers[0], 0);
+        if (mode == RemoteReadMode::DoubleBuffered && m_window < m_count)
+        {
+            m_thread = std::thread{[this] { run(); }};
+            request(m_window);
+        }
+        rebind(0);
+    }
+
+    ~RemoteSpanReader()
+    {
+        if (!m_thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stop = true;
+        }
+        m_wakeup.notify_all();
+        m_thread.join();
+    }
+
+    /**
+     * @brief   Moves to the next object, switching windows if required.
+     */
+    void next()
+    {
+        if (++m_idx >= m_count) return;
+        if (m_idx >= current().first + current().count)
+        {
+            if (m_thread.joinable())
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_wakeup.wait(lock, [this] { return !m_pending; });
+                m_current ^= 1;
+                lock.unlock();
+
+                auto following = current().first + current().count;
+                if (following < m_count) request(following);
+            }
+            else
+            {
+                fill(current(), m_idx);
+            }
+        }
+        rebind(m_idx);
+    }
+
+    std::size_t index() const { return m_idx; }
+    WrapperT& wrapper() { return m_wrapper; }
+    bool isValid() const { return m_idx < m_count && current().valid[m_idx - current().first]; }
+    std::size_t windowReads() const { return m_windowReads; }
+private:
+    Window& current() { return m_buffers[m_current]; }
+    const Window& current() const { return m_buffers[m_current]; }
+
+    void rebind(std::size_t idx)
+    {
+        if (idx >= m_count) return;
+        m_wrapper.ClassWrapper::rebind(current().data + (idx - current().first) * kObjSize);
+    }
+
+    void fill(Window& window, std::size_t first)
+    {
+        window.first = first;
+        window.count = std::min(m_window, m_count - first);
+        ++m_windowReads;
+
+        MemoryRange range{m_address + first * kObjSize, window.data, window.count * kObjSize};
+        if (m_accessor->read(&range, 1))
+        {
+            std::fill_n(window.valid.begin(), window.count, uint8_t{1});
+            return;
+        }
+
+        // Some objects aren't readable, finding out which ones in a single batch.
+        std::vector<MemoryRange> ranges(window.count);
+        for (std::size_t i = 0; i < window.count; ++i)
+        {
+            ranges[i] = {range.address + i * kObjSize, window.data + i * kObjSize, kObjSize};
+        }
+        if (m_accessor->read(ranges.data(), ranges.size()))
+        {
+            std::fill_n(window.valid.begin(), window.count, uint8_t{1});
+            return;
+        }
+        for (std::size_t i = 0; i < window.count; ++i)
+        {
+            window.valid[i] = m_accessor->read(&ranges[i], 1);
+        }
+    }
+
+    void request(std::size_t first)
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_pendingFirst = first;
+            m_pending = true;
+        }
+        m_wakeup.notify_all();
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        for (;;)
+        {
+            m_wakeup.wait(lock, [this] { return m_stop || m_pending; });
+            if (m_stop) return;
+
+            // The consumer only touches the current window until the pending one is read.
+            auto& window = m_buffers[m_current ^ 1];
+            auto first = m_pendingFirst;
+            lock.unlock();
+            fill(window, first);
+            lock.lock();
+
+            m_pending = false;
+            m_wakeup.notify_all();
+        }
+    }
+private:
+    AccessorT* m_accessor;
+    uintptr_t m_address;
+    std::size_t m_count;
+    std::size_t m_window;
+    std::size_t m_idx = 0;
+    std::atomic<std::size_t> m_windowReads{0};
+    Window m_buffers[2];
+    unsigned m_current = 0;
+    WrapperT m_wrapper;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::size_t m_pendingFirst = 0;
+    bool m_pending = false;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+} // namespace internal
+
+/**
+ * @brief   Array of objects of another address space, read window by window while iterating.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @tparam  AccessorT   Type of the memory accessor.
+ *          
+ * Iterating a `WrapperSpan` of remote objects through `RemoteInstance`s costs a round-trip per 
+ * object. Iterators of a `RemoteSpan` instead read `window` objects in a single transfer and 
+ * hand out wrappers on the local copies. In `RemoteReadMode::DoubleBuffered` mode, a worker 
+ * thread reads the next window while the current one is processed, so a sequential walk runs at 
+ * the bandwidth of the transport as long as processing a window doesn't take longer than reading
+ * one.
+ *
+ * @code
+ *      ProcessMemoryAccessor process{processHandle};
+ *      auto cats = RemoteSpan<Cat, ProcessMemoryAccessor>::of(
+ *          WrapperSpan<Cat>{game.cats, game.numCats}, process, 256, 
+ *          RemoteReadMode::DoubleBuffered);
+ *      for (auto it = cats.begin(); it != cats.end(); ++it) 
+ *      {
+ *          if (it.isValid()) total += it->goodies;
+ *      }
+ * @endcode
+ *
+ * Windows that fail to read as a whole are retried per object, `iterator::isValid` tells whether 
+ * the current object was read. Changes made through the wrappers stay local. 
+ * 
+ * @warning In double-buffered mode, the accessor is used by the worker thread while iterating, 
+ *          it must not be used by other threads at the same time.
+ */
+template<typename WrapperT, typename AccessorT>
+class RemoteSpan
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "RemoteSpan requires usage of AdvancedClassWrapper as base");
+
+    using Reader = internal::RemoteSpanReader<WrapperT, AccessorT>;
+public:
+    /**
+     * @brief   Number of objects read per transfer by default.
+     */
+    static const std::size_t kDefaultWindow = 64;
+
+    /**
+     * @brief   Input iterator over the objects of a `RemoteSpan`.
+     *          
+     * Iterators obtained by `begin` own the windows read so far, copies share them and advance 
+     * together. References obtained by dereferencing are only valid until the iterator is moved.
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = WrapperT;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = WrapperT*;
+        using reference         = WrapperT&;
+
+        iterator() = default;
+
+        reference operator * () const   { return m_reader->wrapper(); }
+        pointer operator -> () const    { return m_reader->wrapper().addressOfWrapper(); }
+
+        iterator& operator ++ ()        { m_reader->next(); return *this; }
+        iterator operator ++ (int)      { auto tmp = *this; ++*this; return tmp; }
+
+        bool operator == (const iterator& rhs) const { return index() == rhs.index(); }
+        bool operator != (const iterator& rhs) const { return index() != rhs.index(); }
+
+        /**
+         * @brief   Determines whether the current object was read.
+         * @return  @c true if read, @c false if its memory couldn't be read.
+         */
+        bool isValid() const { return m_reader->isValid(); }
+
+        /**
+         * @brief   Gets the index of the current object.
+         * @return  The index.
+         */
+        std::size_t index() const { return m_reader ? m_reader->index() : m_end; }
+
+        /**
+         * @brief   Gets the number of windows read so far, including the one being prefetched.
+         * @return  The number of transfers, not counting retries per object.
+         */
+        std::size_t windowReads() const { return m_reader ? m_reader->windowReads() : 0; }
+    private:
+        friend class RemoteSpan;
+
+        explicit iterator(std::size_t end)
+            : m_end{end}
+        {}
+
+        iterator(std::shared_ptr<Reader> reader, std::size_t end)
+            : m_reader{std::move(reader)}
+            , m_end{end}
+        {}
+    private:
+        std::shared_ptr<Reader> m_reader;
+        std::size_t m_end = 0;
+    };
+
+    /**
+     * @brief   Constructor.
+     * @param   accessor    The memory accessor used for transfers. Must outlive the iterators.
+     * @param   address     The address of the first object in the accessed address space.
+     * @param   count       The number of objects.
+     * @param   window      The number of objects read per transfer.
+     * @param   mode        Whether the next window is read while the current one is processed.
+     */
+    RemoteSpan(AccessorT& accessor, uintptr_t address, std::size_t count, 
+            std::size_t window = kDefaultWindow, RemoteReadMode mode = RemoteReadMode::Blocking)
+        : m_accessor{&accessor}
+        , m_address{address}
+        , m_count{count}
+        , m_window{window}
+        , m_mode{mode}
+    {}
+
+    /**
+     * @brief   Creates a remote span from a span of objects in the accessed address space.
+     * @param   span        The span, pointing into the accessed address space.
+     * @param   accessor    The memory accessor used for transfers. Must outlive the iterators.
+     * @param   window      The number of objects read per transfer.
+     * @param   mode        Whether the next window is read while the current one is processed.
+     * @return  The remote span.
+     */
+    static RemoteSpan of(const WrapperSpan<WrapperT>& span, AccessorT& accessor, 
+        std::size_t window = kDefaultWindow, RemoteReadMode mode = RemoteReadMode::Blocking)
+    {
+        return {accessor, reinterpret_cast<uintptr_t>(span.data()), span.size(), window, mode};
+    }
+
+    /**
+     * @brief   Starts iterating, reading the first window (and requesting the second one in 
+     *          double-buffered mode).
+     * @return  The iterator.
+     */
+    iterator begin() const 
+    { 
+        if (!m_count) return end();
+        return {std::make_shared<Reader>(*m_accessor, m_address, m_count, m_window, m_mode), 
+            m_count}; 
+    }
+
+    /**
+     * @brief   Gets an iterator past the last object.
+     * @return  The iterator.
+     */
+    iterator end() const { return iterator{m_count}; }
+
+    /**
+     * @brief   Gets the number of objects.
+     * @return  The number of objects.
+     */
+    std::size_t size() const { return m_count; }
+
+    /**
+     * @brief   Determines whether the span is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !m_count; }
+
+    /**
+     * @brief   Gets the address of the first object in the accessed address space.
+     * @return  The address.
+     */
+    uintptr_t remoteAddress() const { return m_address; }
+private:
+    AccessorT* m_accessor;
+    uintptr_t m_address;
+    std::size_t m_count;
+    std::size_t m_window;
+    RemoteReadMode m_mode;
+};
+
+template<typename WrapperT, typename AccessorT>
+const std::size_t RemoteSpan<WrapperT, AccessorT>::kDefaultWindow;
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_REMOTE_HPP
@@ -0,0 +1,563 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_REMOTECALL_HPP
+#define REMODEL_REMOTECALL_HPP
+
+/**     
+ * @file
+ * @brief Contains batched calls of functions in other processes through a shared call queue.
+ *        
+ * Calling a function in another process usually means creating a remote thread per call. 
+ * Instead, a `CallQueueWorker` running inside the target (e.g. on a thread of an injected 
+ * library) executes calls from a ring of call slots, and a `RemoteCallQueue` in the controlling 
+ * process fills that ring using a memory accessor. Calls are written and their results read 
+ * in bulk, one transfer per contiguous run of slots, so hundreds of calls share the same few 
+ * context switches.
+ *
+ * @code
+ *      // Target, the address is handed to the controller out of band (e.g. an exported global).
+ *      CallQueueWorker worker;
+ *      worker.run(stopFlag);
+ *      
+ *      // Controller.
+ *      ProcessMemoryAccessor process{processHandle};
+ *      RemoteCallQueue<ProcessMemoryAccessor> queue{process, workerAddress};
+ *      if (queue.attach())
+ *      {
+ *          std::vector<CallFuture<int>> healths;
+ *          for (auto id : ids) healths.push_back(queue.call(getHealth, id));
+ *          queue.flush();
+ *          for (auto& health : healths) if (health.wait()) use(health.get().value());
+ *      }
+ * @endcode
+ * 
+ * Calls pass up to `kMaxCallArgs` integer or pointer arguments in a `cdecl` compatible way 
+ * (the native convention on x64) and return an integer or pointer. Injecting the worker is 
+ * left to the application.
+ */
+
+#include "Remote.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Call queue layout]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The maximum number of arguments of a queued call.
+ */
+const std::size_t kMaxCallArgs = 6;
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The header of a call queue, followed by `capacity` `CallSlot`s.
+ *          
+ * Each counter is written by one side only and lives on its own cache line. Slot `n % capacity`
+ * holds call number `n`.
+ */
+struct CallQueueHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char                  magic[8];
+    uint32_t              version;
+    uint32_t              capacity;
+    uint8_t               pad0[48];
+    /// The number of calls written, advanced by the controller after writing the slots.
+    std::atomic<uint64_t> submitted;
+    uint8_t               pad1[56];
+    /// The number of calls executed, advanced by the worker after writing the results.
+    std::atomic<uint64_t> completed;
+    uint8_t               pad2[56];
+};
+
+static_assert(sizeof(CallQueueHeader) == 192, "unexpected padding");
+static_assert(sizeof(std::atomic<uint64_t>) == 8, "atomics have to match the plain layout");
+
+const std::size_t kCallSubmittedOffs = 64;
+const std::size_t kCallCompletedOffs = 128;
+const char kCallQueueMagic[8] = {'R', 'M', 'D', 'L', 'C', 'A', 'L', 'L'};
+
+/**
+ * @internal
+ * @brief   A queued call, one cache line.
+ */
+struct CallSlot
+{
+    uint64_t function;
+    uint64_t args[kMaxCallArgs];
+    uint64_t result;
+};
+
+static_assert(sizeof(CallSlot) == 64, "unexpected padding");
+
+/**
+ * @internal
+ * @brief   Determines whether a type is passed in an integer register by queued calls.
+ */
+template<typename T>
+using IsCallWord = std::integral_constant<bool, (std::is_integral<T>::value 
+    || std::is_enum<T>::value || std::is_pointer<T>::value) && sizeof(T) <= sizeof(uintptr_t)>;
+
+/**
+ * @internal
+ * @brief   Converts between values and slot words.
+ */
+template<typename T>
+inline std::enable_if_t<!std::is_pointer<T>::value, uint64_t> toCallWord(T value)
+{
+    static_assert(IsCallWord<T>::value, "queued calls only support integer and pointer arguments");
+    return static_cast<uintptr_t>(value);
+}
+
+template<typename T>
+inline std::enable_if_t<std::is_pointer<T>::value, uint64_t> toCallWord(T value)
+{
+    return reinterpret_cast<uintptr_t>(value);
+}
+
+// Narrowing, the upper bits of the return register are undefined for smaller types.
+template<typename T>
+inline std::enable_if_t<std::is_integral<T>::value, T> fromCallWord(uint64_t word)
+{
+    return static_cast<T>(static_cast<uintptr_t>(word));
+}
+
+template<>
+inline bool fromCallWord<bool>(uint64_t word)
+{
+    return static_cast<uint8_t>(word) != 0;
+}
+
+template<typename T>
+inline std::enable_if_t<std::is_enum<T>::value, T> fromCallWord(uint64_t word)
+{
+    return static_cast<T>(fromCallWord<std::underlying_type_t<T>>(word));
+}
+
+template<typename T>
+inline std::enable_if_t<std::is_pointer<T>::value, T> fromCallWord(uint64_t word)
+{
+    return reinterpret_cast<T>(static_cast<uintptr_t>(word));
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [CallQueueWorker]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Owner and executor of a call queue, running inside the process the calls target.
+ */
+class CallQueueWorker : public zycore::NonCopyable
+{
+    using Thunk = uintptr_t (*)(uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t);
+    static_assert(kMaxCallArgs == 6, "thunk doesn't match the number of arguments");
+public:
+    /**
+     * @brief   Constructor.
+     * @param   capacity    The number of call slots, a power of two.
+     */
+    explicit CallQueueWorker(uint32_t capacity = 256)
+        : m_storage{new uint64_t[(sizeof(internal::CallQueueHeader) 
+            + capacity * sizeof(internal::CallSlot)) / sizeof(uint64_t)]()}
+        , m_header{new (m_storage.get()) internal::CallQueueHeader{}}
+        , m_slots{reinterpret_cast<internal::CallSlot*>(m_header + 1)}
+    {
+        std::memcpy(m_header->magic, internal::kCallQueueMagic, sizeof(m_header->magic));
+        m_header->version  = internal::CallQueueHeader::kVersion;
+        m_header->capacity = capacity;
+    }
+
+    /**
+     * @brief   Gets the address of the queue, to be passed to the controller.
+     * @return  The address.
+     */
+    uintptr_t address() const { return reinterpret_cast<uintptr_t>(m_header); }
+
+    /**
+     * @brief   Executes all submitted calls.
+     * @return  The number of calls executed.
+     */
+    std::size_t runPending()
+    {
+        auto completed = m_header->completed.load(std::memory_order_relaxed);
+        auto submitted = m_header->submitted.load(std::memory_order_acquire);
+        for (auto cur = completed; cur != submitted; ++cur)
+        {
+            auto& slot = m_slots[cur & (m_header->capacity - 1)];
+            auto  a    = slot.args;
+            auto  func = reinterpret_cast<Thunk>(static_cast<uintptr_t>(slot.function));
+            slot.result = func(
+                static_cast<uintptr_t>(a[0]), static_cast<uintptr_t>(a[1]), 
+                static_cast<uintptr_t>(a[2]), static_cast<uintptr_t>(a[3]), 
+                static_cast<uintptr_t>(a[4]), static_cast<uintptr_t>(a[5]));
+            // Publishing one by one, so long batches already report their first results.
+            m_header->completed.store(cur + 1, std::memory_order_release);
+        }
+        return static_cast<std::size_t>(submitted - completed);
+    }
+
+    /**
+     * @brief   Executes calls until stopped.
+     * @param   stop        Flag requesting the worker to return.
+     * @param   idleSleep   The time to sleep after finding the queue empty.
+     */
+    void run(const std::atomic<bool>& stop, 
+        std::chrono::microseconds idleSleep = std::chrono::microseconds{100})
+    {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (!runPending()) std::this_thread::sleep_for(idleSleep);
+        }
+    }
+private:
+    std::unique_ptr<uint64_t[]> m_storage;
+    internal::CallQueueHeader* m_header;
+    internal::CallSlot* m_slots;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [CallFuture]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The state shared between a queue and the future of a call.
+ */
+struct CallState
+{
+    bool     done   = false;
+    uint64_t result = 0;
+};
+
+/**
+ * @internal
+ * @brief   Type-erased interface of `RemoteCallQueue` used by futures.
+ */
+class CallQueueBase
+{
+public:
+    /**
+     * @brief   Collects finished calls and submits pending ones into the freed slots.
+     * @return  @c true if the transfers succeeded, else @c false.
+     */
+    virtual bool progress() = 0;
+protected:
+    ~CallQueueBase() = default;
+};
+
+} // namespace internal
+
+/**
+ * @brief   The result of a queued call.
+ * @tparam  RetT    The return type, an integer, a pointer or `void`.
+ * @note    Futures must not outlive the queue they were created by.
+ */
+template<typename RetT>
+class CallFuture
+{
+    static_assert(
+        internal::IsCallWord<std::conditional_t<std::is_void<RetT>::value, int, RetT>>::value,
+        "queued calls only support integer and pointer return values");
+public:
+    CallFuture(internal::CallQueueBase* queue, std::shared_ptr<internal::CallState> state)
+        : m_queue{queue}
+        , m_state{std::move(state)}
+    {}
+
+    /**
+     * @brief   Determines whether the call finished, without transferring anything.
+     * @return  @c true if finished, else @c false.
+     */
+    bool isReady() const { return m_state && m_state->done; }
+
+    /**
+     * @brief   Waits for the call to finish, driving the queue meanwhile.
+     * @param   timeout The maximum time to wait.
+     * @return  @c true if finished, else @c false on timeout or failed transfers.
+     */
+    bool wait(std::chrono::milliseconds timeout = std::chrono::milliseconds{1000}) const
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!isReady())
+        {
+            if (!m_state || !m_queue->progress()) return false;
+            if (isReady()) break;
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Gets the result of a finished call.
+     * @return  The result, empty if not finished yet.
+     */
+    template<typename T = RetT, std::enable_if_t<!std::is_void<T>::value, int> = 0>
+    zycore::Optional<T> get() const
+    {
+        if (!isReady()) return zycore::kEmpty;
+        return {zycore::kInPlace, internal::fromCallWord<T>(m_state->result)};
+    }
+private:
+    internal::CallQueueBase* m_queue;
+    std::shared_ptr<internal::CallState> m_state;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [RemoteCallQueue]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Controller side of a call queue, submitting calls to a `CallQueueWorker`.
+ * @tparam  AccessorT   Type of the memory accessor reaching the worker's address space.
+ *          
+ * `call` only records calls locally. They are transferred by `flush` (or while waiting for a 
+ * future), as many as there are free slots, and their results are collected by `poll`. 
+ * Not thread-safe, use one queue (and worker) per controlling thread.
+ */
+template<typename AccessorT>
+class RemoteCallQueue 
+    : public internal::CallQueueBase
+    , public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   Constructor. Call `attach` before queueing calls.
+     * @param   accessor    The memory accessor used for transfers. Must outlive this queue.
+     * @param   address     The address of the worker's queue, see `CallQueueWorker::address`.
+     */
+    RemoteCallQueue(AccessorT& accessor, uintptr_t address)
+        : m_accessor{&accessor}
+        , m_address{address}
+    {}
+
+    /**
+     * @brief   Reads and validates the header of the worker's queue.
+     * @return  @c true if the address holds a compatible queue, else @c false.
+     */
+    bool attach()
+    {
+        internal::CallQueueHeader header;
+        if (!m_accessor->read(MemoryRange{m_address, &header, sizeof(header)})) return false;
+        if (std::memcmp(header.magic, internal::kCallQueueMagic, sizeof(header.magic))
+            || header.version != internal::CallQueueHeader::kVersion
+            || !header.capacity || (header.capacity & (header.capacity - 1)))
+        {
+            return false;
+        }
+
+        m_capacity  = header.capacity;
+        m_submitted = header.submitted.load(std::memory_order_relaxed);
+        m_completed = header.completed.load(std::memory_order_relaxed);
+        m_inFlight.clear();
+        m_pending.clear();
+        return m_submitted == m_completed;
+    }
+
+    /**
+     * @brief   Determines whether `attach` succeeded.
+     */
+    bool isAttached() const { return m_capacity != 0; }
+
+    /**
+     * @brief   Queues a call of a function at an address of the target.
+     * @tparam  RetT    The return type of the function.
+     * @param   function    The address of the function in the target.
+     * @param   args        The arguments, at most `kMaxCallArgs` integers or pointers.
+     * @return  The future of the call.
+     */
+    template<typename RetT, typename... ArgsT>
+    CallFuture<RetT> call(uintptr_t function, const ArgsT&... args)
+    {
+        static_assert(sizeof...(ArgsT) <= kMaxCallArgs, "too many arguments for a queued call");
+
+        Pending pending{internal::CallSlot{function, {internal::toCallWord(args)...}, 0}, 
+            std::make_shared<internal::CallState>()};
+        auto state = pending.state;
+        m_pending.push_back(std::move(pending));
+        return CallFuture<RetT>{this, std::move(state)};
+    }
+
+    /**
+     * @brief   Queues a call of the function a `Function` wrapper resolves to in the target.
+     * @param   function    The wrapper, the return type is taken from its function pointer type.
+     * @param   args        The arguments, at most `kMaxCallArgs` integers or pointers.
+     * @return  The future of the call.
+     */
+    template<typename FuncT, typename... ArgsT>
+    auto call(const FuncT& function, const ArgsT&... args)
+        -> CallFuture<decltype(function.get()(args...))>
+    {
+        auto ptr = function.get();
+        static_assert(sizeof(ptr) == sizeof(void*), "unsupported function pointer size");
+        return call<decltype(function.get()(args...))>(
+            reinterpret_cast<uintptr_t>(*reinterpret_cast<void* const*>(&ptr)), args...);
+    }
+
+    /**
+     * @brief   Transfers queued calls to the worker, as many as there are free slots.
+     * @return  @c true if the transfers succeeded, else @c false.
+     */
+    bool flush()
+    {
+        if (!isAttached()) return false;
+
+        auto freeSlots = static_cast<std::size_t>(m_capacity - (m_submitted - m_completed));
+        auto count = std::min(freeSlots, m_pending.size());
+        if (!count) return true;
+
+        // Contiguous runs of slots, split at most once by wrapping around.
+        m_slotBuffer.clear();
+        for (std::size_t i = 0; i < count; ++i) m_slotBuffer.push_back(m_pending[i].slot);
+        auto first = static_cast<std::size_t>(m_submitted & (m_capacity - 1));
+        auto run   = std::min(count, m_capacity - first);
+        if (!writeSlots(first, m_slotBuffer.data(), run)) return false;
+        if (run != count && !writeSlots(0, m_slotBuffer.data() + run, count - run)) return false;
+
+        auto submitted = m_submitted + count;
+        if (!m_accessor->write(MemoryRange{m_address + internal::kCallSubmittedOffs, 
+            &submitted, sizeof(submitted)}))
+        {
+            return false;
+        }
+        m_submitted = submitted;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_inFlight.push_back(std::move(m_pending.front().state));
+            m_pending.pop_front();
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Collects the results of calls the worker finished.
+     * @return  @c true if the transfers succeeded, else @c false.
+     */
+    bool poll()
+    {
+        if (!isAttached()) return false;
+        if (m_submitted == m_completed) return true;
+
+        uint64_t completed;
+        if (!m_accessor->read(MemoryRange{m_address + internal::kCallCompletedOffs, 
+            &completed, sizeof(completed)}))
+        {
+            return false;
+        }
+        auto count = static_cast<std::size_t>(completed - m_completed);
+        if (!count) return true;
+        if (count > m_inFlight.size()) return false;
+
+        m_results.resize(count);
+        m_ranges.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto idx = static_cast<std::size_t>((m_completed + i) & (m_capacity - 1));
+            m_ranges.push_back(MemoryRange{slotAddress(idx) + offsetof(internal::CallSlot, result),
+                &m_results[i], sizeof(uint64_t)});
+        }
+        if (!m_accessor->read(m_ranges.data(), m_ranges.size())) return false;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_inFlight.front()->result = m_results[i];
+            m_inFlight.front()->done   = true;
+            m_inFlight.pop_front();
+        }
+        m_completed = completed;
+        return true;
+    }
+
+    /**
+     * @copydoc internal::CallQueueBase::progress
+     */
+    bool progress() override { return poll() && flush(); }
+
+    /**
+     * @brief   Gets the number of calls not transferred yet.
+     */
+    std::size_t pending() const { return m_pending.size(); }
+
+    /**
+     * @brief   Gets the number of calls transferred, but not collected yet.
+     */
+    std::size_t inFlight() const { return m_inFlight.size(); }
+private:
+    struct Pending
+    {
+        internal::CallSlot slot;
+        std::shared_ptr<internal::CallState> state;
+    };
+
+    uintptr_t slotAddress(std::size_t idx) const
+    {
+        return m_address + sizeof(internal::CallQueueHeader) + idx * sizeof(internal::CallSlot);
+    }
+
+    bool writeSlots(std::size_t first, internal::CallSlot* slots, std::size_t count)
+    {
+        return m_accessor->write(
+            MemoryRange{slotAddress(first), slots, count * sizeof(internal::CallSlot)});
+    }
+private:
+    AccessorT* m_accessor;
+    uintptr_t m_address;
+    std::size_t m_capacity = 0;
+    uint64_t m_submitted = 0;
+    uint64_t m_completed = 0;
+    std::deque<Pending> m_pending;
+    std::deque<std::shared_ptr<internal::CallState>> m_inFlight;
+    // Reused transfer buffers.
+    std::vector<internal::CallSlot> m_slotBuffer;
+    std::vector<uint64_t> m_results;
+    std::vector<MemoryRange> m_ranges;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_REMOTECALL_HPP
@@ -0,0 +1,862 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_RESOLVER_HPP
+#define REMODEL_RESOLVER_HPP
+
+/**     
+ * @file
+ * @brief Contains a resolver running all startup resolutions as one dependency graph.
+ *        
+ * Every address or offset the wrappers need is declared as a node of a `Resolver`: how it is
+ * resolved and which other nodes it depends on. `run` then resolves modules first, populates 
+ * all cacheable nodes from a cache file keyed by the identities of the modules and resolves the
+ * rest on a pool of threads, starting every node as soon as its dependencies are done. Patterns
+ * of a module share a single pass over it (see `PatternBatch`), failures skip all dependents.
+ * 
+ * @code
+ *      Resolver& resolver() { static Resolver r; return r; }
+ *      
+ *      const ResolveId kGame      = resolver().module("game.dll");
+ *      const ResolveId kCreateCat = resolver().pattern(kGame, "40 53 48 83 EC 20 8B D9 E8");
+ *      const ResolveId kCatAge    = resolver().operand(kCreateCat, 0x1C, OperandKind::Displacement);
+ *      
+ *      class Cat : public ClassWrapper
+ *      {
+ *          REMODEL_WRAPPER(Cat)
+ *      public:
+ *          Field<uint8_t, ResolvedOffsGetter> age{this, ResolvedOffsGetter{resolver(), kCatAge}};
+ *      };
+ *      
+ *      Function<Cat::Weak*(*)(int), ResolvedAddrGetter> createCat{
+ *          ResolvedAddrGetter{resolver(), kCreateCat}};
+ *      
+ *      std::unique_ptr<Hook<Cat::Weak*(*)(int)>> createHook;
+ *      const ResolveId kCreateHook = resolver().hook(kCreateCat, [](uintptr_t target)
+ *      {
+ *          createHook.reset(new Hook<Cat::Weak*(*)(int)>{target, &onCreateCat});
+ *          return createHook->install();
+ *      });
+ *      
+ *      if (!resolver().run("game.resolve")) 
+ *          return; // unsupported build, see resolver().failed(...)
+ * @endcode
+ * 
+ * Nodes are identified by dense IDs in declaration order. As dependencies have to be declared
+ * before their dependents, the graph can't contain cycles. `report` breaks the time spent down
+ * by `ResolveStage`.
+ */
+
+#include "Remodel.hpp"
+#include "LayoutProfile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [ResolveStage] + [ResolveReport]                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The stages of resolution, used to group nodes in the `ResolveReport`.
+ */
+enum class ResolveStage
+{
+    /// Module base addresses, resolved before anything else and never cached.
+    Module,
+    /// Addresses found by scanning for byte patterns.
+    Signature,
+    /// Offsets and addresses decoded from instructions located by other nodes.
+    Derived,
+    /// Addresses of virtual function tables.
+    Vftable,
+    /// Hooks installed on resolved addresses, never cached and run one at a time.
+    Hook,
+    /// Anything else.
+    Custom,
+};
+
+const std::size_t kResolveStageCount = 6;
+
+/**
+ * @brief   Gets the name of a stage.
+ * @param   stage   The stage.
+ * @return  The name.
+ */
+inline const char* resolveStageName(ResolveStage stage)
+{
+    static const char* const kNames[kResolveStageCount] = {
+        "module", "signature", "derived", "vftable", "hook", "custom"
+    };
+    return kNames[static_cast<std::size_t>(stage)];
+}
+
+/**
+ * @brief   Statistics of one stage of a `Resolver::run`.
+ */
+struct ResolveStageReport
+{
+    /// The number of nodes of the stage.
+    std::size_t total    = 0;
+    /// The number of nodes resolved, including those taken from the cache.
+    std::size_t resolved = 0;
+    /// The number of nodes taken from the cache, including cached failures.
+    std::size_t cached   = 0;
+    /// The number of nodes whose resolution failed.
+    std::size_t failed   = 0;
+    /// The number of nodes not attempted due to a failed dependency.
+    std::size_t skipped  = 0;
+    /// The time spent resolving nodes of the stage, summed over all threads.
+    std::chrono::nanoseconds busy{0};
+};
+
+/**
+ * @brief   Statistics of a `Resolver::run`.
+ */
+struct ResolveReport
+{
+    /// The statistics of every stage, indexed by `ResolveStage`.
+    ResolveStageReport stages[kResolveStageCount];
+    /// The time the run took.
+    std::chrono::nanoseconds wall{0};
+    /// Whether the cache file matched the modules and declarations.
+    bool cacheHit = false;
+
+    const ResolveStageReport& operator [] (ResolveStage stage) const 
+    { 
+        return stages[static_cast<std::size_t>(stage)]; 
+    }
+
+    ResolveStageReport& operator [] (ResolveStage stage) 
+    { 
+        return stages[static_cast<std::size_t>(stage)]; 
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [Resolver cache file format]                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The header of a resolver cache file, followed by `count` `int64_t` values, one per 
+ *          node, relative to the module of the node if any. All values are in native byte order.
+ */
+struct ResolverCacheHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t declarationsHash;
+};
+
+static_assert(sizeof(ResolverCacheHeader) == 24, "unexpected padding");
+
+const char kResolverCacheMagic[8] = {'R', 'M', 'D', 'L', 'R', 'S', 'L', 'V'};
+
+/// Cached value of nodes that are not cached, e.g. hooks.
+const int64_t kResolverCacheNotCached = INT64_MIN;
+/// Cached value of nodes whose resolution failed.
+const int64_t kResolverCacheFailed    = INT64_MIN + 1;
+
+/**
+ * @internal
+ * @brief   Incremental FNV-1a hash.
+ */
+class Fnv1a
+{
+    uint64_t m_hash = 0xCBF29CE484222325;
+public:
+    void mix(const void* data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_hash ^= static_cast<const uint8_t*>(data)[i];
+            m_hash *= 0x100000001B3;
+        }
+    }
+
+    template<typename T>
+    void mixValue(const T& value) { mix(&value, sizeof(value)); }
+
+    void mixString(const std::string& str)
+    {
+        mixValue(static_cast<uint32_t>(str.size()));
+        mix(str.data(), str.size());
+    }
+
+    uint64_t value() const { return m_hash; }
+};
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [Resolver]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The ID of a node of a `Resolver`.
+ */
+using ResolveId = std::size_t;
+
+/**
+ * @brief   Graph of resolutions run in dependency order, see the file documentation.
+ *          
+ * Nodes are declared from one thread before `run`, the resolver has to outlive all wrappers 
+ * using it. Values may be read from any thread after `run` returned, and by nodes from the
+ * values of their dependencies while running.
+ */
+class Resolver : public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   Function resolving a node, storing the value and returning @c true on success.
+     *          Invoked on a worker thread, values of dependencies are read using `value`.
+     */
+    using ResolveFunc = std::function<bool(const Resolver& resolver, uintptr_t& value)>;
+
+    /**
+     * @brief   Function installing a hook on a resolved address, returning @c true on success.
+     */
+    using HookFunc = std::function<bool(uintptr_t target)>;
+
+    static const ResolveId kNoNode = static_cast<ResolveId>(-1);
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Declaration]                                                                              //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Declares a node.
+     * @param   stage       The stage the node is reported in.
+     * @param   key         Text identifying how the node resolves, e.g. a pattern. Changing the 
+     *                      key (or the dependencies) of any node invalidates the cache.
+     * @param   deps        The nodes the node depends on, all declared before.
+     * @param   func        The function resolving the node.
+     * @param   module      The module node the value is an address in, it is then cached 
+     *                      relative to the module base. `kNoNode` for offsets and the like.
+     * @param   cacheable   Whether the value can be taken from the cache. Nodes with side 
+     *                      effects, e.g. installing hooks, must not be cacheable.
+     * @return  The ID of the node.
+     */
+    ResolveId add(ResolveStage stage, std::string key, std::initializer_list<ResolveId> deps,
+        ResolveFunc func, ResolveId module = kNoNode, bool cacheable = true)
+    {
+        assert(stage != ResolveStage::Module || !cacheable);
+        assert(module == kNoNode || m_nodes[module].stage == ResolveStage::Module);
+        Node node;
+        node.stage     = stage;
+        node.key       = std::move(key);
+        node.deps      = deps;
+        node.func      = std::move(func);
+        node.module    = module;
+        node.cacheable = cacheable;
+        return addNode(std::move(node));
+    }
+
+    /**
+     * @brief   Declares a module, resolving to its base address.
+     * @param   moduleName  The name of the module, @c nullptr for the main module.
+     * @return  The ID of the node.
+     */
+    ResolveId module(const char* moduleName)
+    {
+        std::string name = moduleName ? moduleName : std::string{};
+        Node node;
+        node.stage     = ResolveStage::Module;
+        node.key       = moduleName ? name : std::string{"<main>"};
+        node.cacheable = false;
+        node.func      = [name, moduleName](const Resolver&, uintptr_t& value)
+        {
+            auto module = Module::getModule(moduleName ? name.c_str() : nullptr);
+            if (!module) return false;
+            value = reinterpret_cast<uintptr_t>(module.value().addressOfObj());
+            return true;
+        };
+        return addNode(std::move(node));
+    }
+
+    /**
+     * @brief   Declares a pattern, resolving to the address of its first match in a module.
+     * @param   module  The module node to scan.
+     * @param   pattern The IDA-style pattern, see `Pattern`.
+     * @return  The ID of the node.
+     *          
+     * All patterns of a module are resolved in a single pass, which is skipped when all of them
+     * are taken from the cache.
+     */
+    ResolveId pattern(ResolveId module, const char* pattern)
+    {
+        assert(m_nodes[module].stage == ResolveStage::Module);
+        auto& scan = m_scans[module];
+        if (!scan)
+        {
+            scan.reset(new ModuleScan);
+            Node node;
+            node.stage     = ResolveStage::Signature;
+            node.key       = "scan";
+            node.deps      = {module};
+            node.cacheable = false;
+            node.auxiliary = true;
+            auto state = scan.get();
+            node.func = [state, module](const Resolver& resolver, uintptr_t&)
+            {
+                wrapper_cast<Module>(resolver.value(module)).findPatterns(state->batch);
+                return true;
+            };
+            scan->node = addNode(std::move(node));
+        }
+
+        auto state = scan.get();
+        auto idx   = state->batch.add(pattern);
+        Node node;
+        node.stage  = ResolveStage::Signature;
+        node.key    = pattern;
+        node.deps   = {scan->node};
+        node.module = module;
+        node.func   = [state, idx](const Resolver&, uintptr_t& value)
+        {
+            value = state->batch.address(idx);
+            return value != 0;
+        };
+        return addNode(std::move(node));
+    }
+
+    /**
+     * @brief   Declares an operand of an instruction located by another node.
+     * @param   code        The node locating the code, e.g. a pattern.
+     * @param   insnOffset  The offset of the instruction from the address of `code`.
+     * @param   kind        The operand. `OperandKind::TargetRva` resolves to the absolute 
+     *                      address referred to, the others to the sign-extended value.
+     * @return  The ID of the node.
+     */
+    ResolveId operand(ResolveId code, std::ptrdiff_t insnOffset, OperandKind kind)
+    {
+        Node node;
+        node.stage  = ResolveStage::Derived;
+        node.key    = std::to_string(insnOffset) + ":" + std::to_string(static_cast<int>(kind));
+        node.deps   = {code};
+        node.module = kind == OperandKind::TargetRva ? m_nodes[code].module : kNoNode;
+        node.func   = [code, insnOffset, kind](const Resolver& resolver, uintptr_t& value)
+        {
+            auto insn = reinterpret_cast<const void*>(resolver.value(code) + insnOffset);
+            auto operand = extractOperand(insn, kind);
+            if (!operand) return false;
+            value = static_cast<uintptr_t>(operand.value());
+            return true;
+        };
+        return addNode(std::move(node));
+    }
+
+    /**
+     * @brief   Declares a hook, installed once its target is resolved.
+     * @param   target  The node resolving to the function to hook.
+     * @param   install The function installing the hook. Hooks are installed one at a time, 
+     *                  but concurrently to the resolution of unrelated nodes.
+     * @return  The ID of the node, resolving to the target address.
+     */
+    ResolveId hook(ResolveId target, HookFunc install)
+    {
+        Node node;
+        node.stage     = ResolveStage::Hook;
+        node.key       = "hook";
+        node.deps      = {target};
+        node.cacheable = false;
+        node.func      = [this, target, install](const Resolver& resolver, uintptr_t& value)
+        {
+            value = resolver.value(target);
+            std::lock_guard<std::mutex> lock{m_hookMutex};
+            return install(value);
+        };
+        return addNode(std::move(node));
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Running]                                                                                  //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Resolves all nodes.
+     * @param   cachePath   The path of the cache file, @c nullptr to not use a cache. Created 
+     *                      or replaced unless all nodes were taken from it. Caching requires 
+     *                      all modules to have an identity (see `platform::obtainModuleIdentity`).
+     * @param   threadCount The number of threads including the calling one, zero for one per
+     *                      hardware thread.
+     * @return  @c true if all nodes were resolved, else @c false.
+     *          
+     * Intended to run once at startup, running again resolves all nodes anew (and thus also 
+     * invokes hook functions again). Not thread-safe.
+     */
+    bool run(const char* cachePath = nullptr, unsigned threadCount = 0)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto count = m_nodes.size();
+        m_values.assign(count, 0);
+        m_states.reset(new std::atomic<uint8_t>[count]);
+        for (std::size_t i = 0; i < count; ++i) m_states[i].store(kPending);
+        m_report = ResolveReport{};
+
+        // Modules first, as the cache is keyed by their identities.
+        for (ResolveId id = 0; id < count; ++id)
+        {
+            if (m_nodes[id].stage == ResolveStage::Module) execute(id);
+        }
+
+        uint64_t hash = 0;
+        bool cacheable = cachePath && declarationsHash(hash);
+        std::size_t pending = 0;
+        for (ResolveId id = 0; id < count; ++id) 
+        {
+            if (m_states[id].load() == kPending && !m_nodes[id].auxiliary) ++pending;
+        }
+        if (cacheable && pending) 
+        {
+            m_report.cacheHit = loadCache(cachePath, hash, pending);
+        }
+
+        schedule(threadCount);
+        if (cacheable && pending) storeCache(cachePath, hash);
+
+        for (ResolveId id = 0; id < count; ++id)
+        {
+            const auto& node = m_nodes[id];
+            if (node.auxiliary) continue;
+            auto& stage = m_report[node.stage];
+            ++stage.total;
+            switch (m_states[id].load())
+            {
+                case kResolved: ++stage.resolved; break;
+                case kFailed:   ++stage.failed;   break;
+                default:        ++stage.skipped;  break;
+            }
+        }
+        m_report.wall = std::chrono::steady_clock::now() - start;
+        return allResolved();
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Results]                                                                                  //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Gets the number of nodes.
+     * @return  The number of nodes.
+     */
+    std::size_t size() const { return m_nodes.size(); }
+
+    /**
+     * @brief   Gets the value of a node.
+     * @param   id  The ID of the node.
+     * @return  The value, zero unless resolved.
+     */
+    uintptr_t value(ResolveId id) const { return m_values[id]; }
+
+    /**
+     * @brief   Determines whether a node was resolved.
+     * @param   id  The ID of the node.
+     * @return  @c true if resolved, else @c false.
+     */
+    bool isResolved(ResolveId id) const 
+    { 
+        return m_states && m_states[id].load(std::memory_order_acquire) == kResolved; 
+    }
+
+    /**
+     * @brief   Determines whether all nodes were resolved by the last run.
+     * @return  @c true if resolved, else @c false.
+     */
+    bool allResolved() const
+    {
+        for (ResolveId id = 0; id < m_nodes.size(); ++id) if (!isResolved(id)) return false;
+        return true;
+    }
+
+    /**
+     * @brief   Gets the key of a node, e.g. to report failures.
+     * @param   id  The ID of the node.
+     * @return  The key.
+     */
+    const std::string& key(ResolveId id) const { return m_nodes[id].key; }
+
+    /**
+     * @brief   Gets the stage of a node.
+     * @param   id  The ID of the node.
+     * @return  The stage.
+     */
+    ResolveStage stage(ResolveId id) const { return m_nodes[id].stage; }
+
+    /**
+     * @brief   Gets the nodes that failed to resolve in the last run, not including those 
+     *          skipped due to a failed dependency.
+     * @return  The IDs of the nodes.
+     */
+    std::vector<ResolveId> failed() const
+    {
+        std::vector<ResolveId> result;
+        for (ResolveId id = 0; id < m_nodes.size(); ++id)
+        {
+            if (m_states && m_states[id].load() == kFailed) result.push_back(id);
+        }
+        return result;
+    }
+
+    /**
+     * @brief   Gets the statistics of the last run.
+     * @return  The statistics.
+     */
+    const ResolveReport& report() const { return m_report; }
+private:
+    enum : uint8_t { kPending, kResolved, kFailed, kSkipped };
+
+    struct Node
+    {
+        ResolveStage           stage;
+        std::string            key;
+        std::vector<ResolveId> deps;
+        std::vector<ResolveId> dependents;
+        ResolveFunc            func;
+        ResolveId              module    = kNoNode;
+        bool                   cacheable = true;
+        /// Auxiliary nodes only run if a pending node depends on them and aren't reported.
+        bool                   auxiliary = false;
+    };
+
+    struct ModuleScan
+    {
+        ResolveId    node;
+        PatternBatch batch;
+    };
+
+    ResolveId addNode(Node node)
+    {
+        auto id = m_nodes.size();
+        for (auto dep : node.deps)
+        {
+            assert(dep < id && "dependencies have to be declared first");
+            m_nodes[dep].dependents.push_back(id);
+        }
+        m_nodes.push_back(std::move(node));
+        return id;
+    }
+
+    /**
+     * @brief   Resolves a node whose dependencies are done, recording the time spent.
+     */
+    void execute(ResolveId id)
+    {
+        const auto& node = m_nodes[id];
+        for (auto dep : node.deps)
+        {
+            if (m_states[dep].load(std::memory_order_acquire) != kResolved)
+            {
+                m_states[id].store(kSkipped, std::memory_order_release);
+                return;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        uintptr_t value = 0;
+        bool resolved = node.func && node.func(*this, value);
+        m_values[id] = resolved ? value : 0;
+        m_states[id].store(resolved ? kResolved : kFailed, std::memory_order_release);
+        auto busy = std::chrono::steady_clock::now() - start;
+
+        std::lock_guard<std::mutex> lock{m_reportMutex};
+        m_report[node.stage].busy += busy;
+    }
+
+    /**
+     * @brief   Runs all pending nodes (and the auxiliary nodes they need) on `threadCount` 
+     *          threads, starting every node once its last dependency is done.
+     */
+    void schedule(unsigned threadCount)
+    {
+        // Declaration order is a topological order, so dependents are visited before their
+        // dependencies when walking backwards.
+        auto count = m_nodes.size();
+        std::vector<uint8_t> needed(count, 0);
+        for (auto id = count; id-- > 0;)
+        {
+            if (m_states[id].load() != kPending) continue;
+            if (!m_nodes[id].auxiliary) { needed[id] = 1; continue; }
+            for (auto dependent : m_nodes[id].dependents) needed[id] |= needed[dependent];
+        }
+
+        std::unique_ptr<std::atomic<std::size_t>[]> waiting{new std::atomic<std::size_t>[count]};
+        std::vector<ResolveId> ready;
+        std::size_t outstanding = 0;
+        for (ResolveId id = 0; id < count; ++id)
+        {
+            std::size_t deps = 0;
+            for (auto dep : m_nodes[id].deps) deps += needed[dep];
+            waiting[id].store(deps, std::memory_order_relaxed);
+            if (!needed[id]) continue;
+            ++outstanding;
+            if (!deps) ready.push_back(id);
+        }
+        if (!outstanding) return;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        auto worker = [&]
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            for (;;)
+            {
+                wake.wait(lock, [&] { return !ready.empty() || !outstanding; });
+                if (!outstanding) return;
+                auto id = ready.back();
+                ready.pop_back();
+
+                lock.unlock();
+                execute(id);
+                lock.lock();
+
+                for (auto dependent : m_nodes[id].dependents)
+                {
+                    if (needed[dependent] && waiting[dependent].fetch_sub(1) == 1) 
+                    {
+                        ready.push_back(dependent);
+                        wake.notify_one();
+                    }
+                }
+                if (!--outstanding) wake.notify_all();
+            }
+        };
+
+        if (!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        auto helpers = static_cast<unsigned>(std::min<std::size_t>(threadCount, outstanding)) - 1;
+        std::vector<std::thread> threads;
+        threads.reserve(helpers);
+        for (unsigned i = 0; i < helpers; ++i) threads.emplace_back(worker);
+        worker();
+        for (auto& thread : threads) thread.join();
+    }
+
+    // ------------------------------------------------------------------------------------------ //
+    // [Cache]                                                                                    //
+    // ------------------------------------------------------------------------------------------ //
+
+    /**
+     * @brief   Hashes the declarations and the identities of all modules.
+     * @return  @c true on success, @c false if a module is unresolved or has no identity.
+     */
+    bool declarationsHash(uint64_t& hash) const
+    {
+        internal::Fnv1a fnv;
+        for (ResolveId id = 0; id < m_nodes.size(); ++id)
+        {
+            const auto& node = m_nodes[id];
+            fnv.mixValue(static_cast<uint32_t>(node.stage));
+            fnv.mixString(node.key);
+            fnv.mixValue(static_cast<uint64_t>(node.module));
+            fnv.mixValue(static_cast<uint32_t>(node.deps.size()));
+            for (auto dep : node.deps) fnv.mixValue(static_cast<uint64_t>(dep));
+
+            if (node.stage != ResolveStage::Module) continue;
+            platform::ModuleIdentity identity;
+            if (!isResolved(id) || !platform::obtainModuleIdentity(
+                reinterpret_cast<const void*>(m_values[id]), identity))
+            {
+                return false;
+            }
+            fnv.mixValue(static_cast<uint32_t>(identity.size));
+            fnv.mix(identity.bytes, identity.size);
+        }
+        hash = fnv.value();
+        return true;
+    }
+
+    /**
+     * @brief   Takes the values of all cacheable nodes from a cache file.
+     * @param   pending Decremented by the number of nodes taken from the cache.
+     * @return  @c true on a cache hit, else @c false, leaving all nodes pending.
+     */
+    bool loadCache(const char* path, uint64_t hash, std::size_t& pending)
+    {
+        auto file = std::fopen(path, "rb");
+        if (!file) return false;
+
+        internal::ResolverCacheHeader header;
+        std::vector<int64_t> values(m_nodes.size());
+        bool hit = std::fread(&header, sizeof(header), 1, file) == 1
+            && std::memcmp(header.magic, internal::kResolverCacheMagic, sizeof(header.magic)) == 0
+            && header.version == internal::ResolverCacheHeader::kVersion
+            && header.count == values.size()
+            && header.declarationsHash == hash
+            && std::fread(values.data(), sizeof(int64_t), values.size(), file) == values.size()
+            && std::fgetc(file) == EOF;
+        std::fclose(file);
+        if (!hit) return false;
+
+        for (ResolveId id = 0; id < m_nodes.size(); ++id)
+        {
+            const auto& node = m_nodes[id];
+            auto value = values[id];
+            if (!node.cacheable || value == internal::kResolverCacheNotCached) continue;
+
+            if (value == internal::kResolverCacheFailed)
+            {
+                m_states[id].store(kFailed);
+            }
+            else
+            {
+                auto base = node.module == kNoNode ? 0 : m_values[node.module];
+                m_values[id] = base + static_cast<uintptr_t>(value);
+                m_states[id].store(kResolved);
+            }
+            ++m_report[node.stage].cached;
+            --pending;
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Writes the values of all cacheable nodes to a cache file.
+     */
+    bool storeCache(const char* path, uint64_t hash) const
+    {
+        internal::ResolverCacheHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, internal::kResolverCacheMagic, sizeof(header.magic));
+        header.version          = internal::ResolverCacheHeader::kVersion;
+        header.count            = static_cast<uint32_t>(m_nodes.size());
+        header.declarationsHash = hash;
+
+        std::vector<int64_t> values(m_nodes.size(), internal::kResolverCacheNotCached);
+        for (ResolveId id = 0; id < m_nodes.size(); ++id)
+        {
+            const auto& node = m_nodes[id];
+            if (!node.cacheable) continue;
+            switch (m_states[id].load())
+            {
+                case kResolved:
+                {
+                    auto base = node.module == kNoNode ? 0 : m_values[node.module];
+                    values[id] = static_cast<int64_t>(m_values[id] - base);
+                    break;
+                }
+                case kFailed:
+                    values[id] = internal::kResolverCacheFailed;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        auto file = std::fopen(path, "wb");
+        if (!file) return false;
+        bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+            && std::fwrite(values.data(), sizeof(int64_t), values.size(), file) == values.size();
+        written &= std::fclose(file) == 0;
+        return written;
+    }
+private:
+    std::vector<Node> m_nodes;
+    std::map<ResolveId, std::unique_ptr<ModuleScan>> m_scans;
+    std::vector<uintptr_t> m_values;
+    std::unique_ptr<std::atomic<uint8_t>[]> m_states;
+    ResolveReport m_report;
+    std::mutex m_reportMutex;
+    std::mutex m_hookMutex;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [ResolvedOffsGetter] + [ResolvedAddrGetter]                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   `PtrGetter` functor adding the value of a `Resolver` node to the raw address.
+ */
+class ResolvedOffsGetter
+{
+    const Resolver* m_resolver;
+    ResolveId m_id;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   resolver    The resolver.
+     * @param   id          The node resolving to the offset of the field.
+     */
+    ResolvedOffsGetter(const Resolver& resolver, ResolveId id)
+        : m_resolver{&resolver}
+        , m_id{id}
+    {}
+
+    void* operator () (void* raw) const
+    {
+        return static_cast<uint8_t*>(raw) + static_cast<std::ptrdiff_t>(m_resolver->value(m_id));
+    }
+};
+
+/**
+ * @brief   `PtrGetter` functor ignoring the raw address, returning the value of a `Resolver` 
+ *          node as absolute address.
+ */
+class ResolvedAddrGetter
+{
+    const Resolver* m_resolver;
+    ResolveId m_id;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   resolver    The resolver.
+     * @param   id          The node resolving to the address of the function or global.
+     */
+    ResolvedAddrGetter(const Resolver& resolver, ResolveId id)
+        : m_resolver{&resolver}
+        , m_id{id}
+    {}
+
+    void* operator () (void*) const
+    {
+        return reinterpret_cast<void*>(m_resolver->value(m_id));
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_RESOLVER_HPP
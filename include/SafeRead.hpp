@@ -0,0 +1,490 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SAFEREAD_HPP
+#define REMODEL_SAFEREAD_HPP
+
+/**
+ * @file
+ * @brief Contains reads through untrusted pointers, validated against a map of readable memory.
+ *
+ * Following a dangling pointer read from a wrapped object crashes the process. Instead of 
+ * guarding every access with SEH or `sigsetjmp`, `ReadableRegionMap` caches the readable regions
+ * of the process (or of selected modules) and validates pointers with a lock-free binary search, 
+ * returning empty optionals for invalid ones.
+ *
+ * @code
+ *      // Field<CustomString*> name;
+ *      auto name = safeDeref(player.name);
+ *      if (!name) return; // dangling
+ *      auto length = name.value().length.get();
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [ReadableRegionMap]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Thread-safe, sorted map of readable memory regions with lock-free lookups.
+ *
+ * The regions are kept in immutable, sorted interval arrays. Updates build a new array and
+ * publish it with a new generation through a `platform::RcuCell`, lookups perform a binary search 
+ * without taking any lock or performing any system call. A lookup costs one atomic increment and
+ * decrement of a reader counter private to the calling thread's stripe plus the search, so 
+ * lookups scale with the number of threads. Chains of lookups (e.g. following pointers
+ * through several wrappers) can hold a `Reader` to pay for the reader registration only once.
+ *
+ * If enabled, lookups missing the map query the region around the address once (`VirtualQuery`
+ * on Windows, a scan of `/proc/self/maps` on Linux) and insert it, so regions mapped after
+ * building the map are picked up incrementally.
+ *
+ * @warning Regions unmapped after they were inserted are not detected until the next `refresh`.
+ *          Memory released to an allocator usually stays mapped, so reads through dangling
+ *          pointers into such memory succeed (yielding garbage) rather than fault.
+ */
+class ReadableRegionMap
+{
+    struct Snapshot
+    {
+        uint64_t               generation;
+        std::vector<uintptr_t> begins;  // sorted, disjoint
+        std::vector<uintptr_t> ends;
+
+        bool find(uintptr_t addr, std::size_t size) const
+        {
+            auto it = std::upper_bound(begins.begin(), begins.end(), addr);
+            if (it == begins.begin()) return false;
+            auto end = ends[static_cast<std::size_t>(it - begins.begin()) - 1];
+            return addr < end && size <= end - addr;
+        }
+    };
+
+    struct Region
+    {
+        uintptr_t begin;
+        uintptr_t end;
+    };
+
+    platform::RcuCell<Snapshot>  m_snapshot;
+    std::mutex                   m_writeMutex;
+    std::atomic<bool>            m_queryOnMiss{true};
+    uint64_t                     m_moduleGeneration = 0;
+public:
+    /**
+     * @brief   Registration of a reader, keeping the current regions alive.
+     *
+     * Lookups through a `Reader` are plain binary searches. Updates of the map block until all
+     * readers registered before the update have been destroyed, so readers should be short-lived
+     * and must not be held by a thread updating the map (including `isReadable` misses).
+     */
+    class Reader
+    {
+        friend class ReadableRegionMap;
+
+        platform::RcuCell<Snapshot>::Reader m_snapshot;
+
+        explicit Reader(const ReadableRegionMap& map)
+            : m_snapshot{map.m_snapshot.read()}
+        {}
+    public:
+        Reader(Reader&&) = default;
+        Reader(const Reader&) = delete;
+        Reader& operator = (const Reader&) = delete;
+
+        /**
+         * @copydoc ReadableRegionMap::contains
+         */
+        bool contains(const void* ptr, std::size_t size) const
+        {
+            return m_snapshot->find(reinterpret_cast<uintptr_t>(ptr), size);
+        }
+
+        /**
+         * @copydoc ReadableRegionMap::generation
+         */
+        uint64_t generation() const { return m_snapshot->generation; }
+    };
+
+    /**
+     * @brief   Constructs an empty map.
+     */
+    ReadableRegionMap()
+        : m_snapshot{Snapshot{0, {}, {}}}
+    {}
+
+    ReadableRegionMap(const ReadableRegionMap&) = delete;
+    ReadableRegionMap& operator = (const ReadableRegionMap&) = delete;
+
+    /**
+     * @brief   Gets the process-wide instance, built from all readable regions on first use.
+     * @return  The instance.
+     */
+    static ReadableRegionMap& process()
+    {
+        static ReadableRegionMap* map = []
+        {
+            // Leaked deliberately, usable in destructors. The stripes of the snapshot cell are 
+            // over-aligned, which `new` doesn't honor before C++17.
+            auto result = new (internal::allocateAligned(sizeof(ReadableRegionMap), 
+                alignof(ReadableRegionMap))) ReadableRegionMap;
+            result->refresh();
+            return result;
+        }();
+        return *map;
+    }
+
+    /**
+     * @brief   Rebuilds the map from all readable regions of the process.
+     * @return  @c true on success, @c false if regions can't be enumerated on this platform.
+     */
+    bool refresh()
+    {
+        std::vector<Region> regions;
+        uint64_t moduleGeneration = 0;
+        platform::internal::obtainModuleGeneration(moduleGeneration);
+#       ifdef REMODEL_HAS_REGION_QUERY
+            bool ok = platform::enumReadableRegions([&](const void* begin, std::size_t size)
+            {
+                auto first = reinterpret_cast<uintptr_t>(begin);
+                regions.push_back({first, first + size});
+            });
+#       else
+            bool ok = false;
+#       endif
+
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        m_moduleGeneration = moduleGeneration;
+        publish(std::move(regions));
+        return ok;
+    }
+
+    /**
+     * @brief   Rebuilds the map if modules were loaded or unloaded since the last `refresh`.
+     * @return  @c true if rebuilt, else @c false.
+     * @note    Only module (un)loads are detected, other mappings are picked up on misses.
+     */
+    bool refreshIfStale()
+    {
+        uint64_t moduleGeneration;
+        if (!platform::internal::obtainModuleGeneration(moduleGeneration)) return false;
+        {
+            std::lock_guard<std::mutex> lock{m_writeMutex};
+            if (moduleGeneration == m_moduleGeneration) return false;
+        }
+        return refresh();
+    }
+
+    /**
+     * @brief   Adds the readable sections of a module.
+     * @param   module  The module.
+     * @return  @c true if the module's sections could be enumerated, else @c false.
+     */
+    bool addModule(const Module& module)
+    {
+        std::vector<Region> regions;
+        bool ok = platform::enumModuleSections(module.addressOfObj(),
+            [&](const platform::ModuleSection& section)
+        {
+            auto first = reinterpret_cast<uintptr_t>(section.begin);
+            regions.push_back({first, first + section.size});
+        });
+        insert(std::move(regions));
+        return ok;
+    }
+
+    /**
+     * @brief   Adds a range known to be readable.
+     * @param   begin   The first byte of the range.
+     * @param   size    The size of the range, in bytes.
+     */
+    void addRange(const void* begin, std::size_t size)
+    {
+        if (!size) return;
+        auto first = reinterpret_cast<uintptr_t>(begin);
+        insert({{first, first + size}});
+    }
+
+    /**
+     * @brief   Removes all regions.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        publish({});
+    }
+
+    /**
+     * @brief   Enables or disables querying regions on lookups missing the map (default: on).
+     * @param   enable  @c true to enable, @c false to disable.
+     *
+     * Disable for maps restricted to certain modules or ranges, or if misses are frequent and
+     * made up entirely of bad pointers: every miss costs a system call (on Linux, one read of
+     * `/proc/self/maps`).
+     */
+    void setQueryOnMiss(bool enable) { m_queryOnMiss = enable; }
+
+    /**
+     * @brief   Gets the generation of the regions, incremented by every update.
+     * @return  The generation.
+     *
+     * Validation results derived from the map can be cached alongside the generation, they
+     * remain valid for as long as the generation stays the same.
+     */
+    uint64_t generation() const { return reader().generation(); }
+
+    /**
+     * @brief   Gets the number of (merged) regions.
+     * @return  The number of regions.
+     */
+    std::size_t regionCount() const
+    {
+        auto guard = reader();
+        return guard.m_snapshot->begins.size();
+    }
+
+    /**
+     * @brief   Registers a reader for a chain of lookups.
+     * @return  The reader.
+     */
+    Reader reader() const { return Reader{*this}; }
+
+    /**
+     * @brief   Determines whether a range is readable according to the map, without querying.
+     * @param   ptr     The first byte of the range.
+     * @param   size    The size of the range, in bytes.
+     * @return  @c true if the whole range lies inside of a single region, else @c false.
+     */
+    bool contains(const void* ptr, std::size_t size) const
+    {
+        return reader().contains(ptr, size);
+    }
+
+    /**
+     * @brief   Determines whether a range is readable, querying the region on a miss if enabled.
+     * @param   ptr     The first byte of the range.
+     * @param   size    The size of the range, in bytes.
+     * @return  @c true if readable, else @c false.
+     */
+    bool isReadable(const void* ptr, std::size_t size)
+    {
+        if (!ptr) return false;
+        if (contains(ptr, size)) return true;
+        if (!m_queryOnMiss) return false;
+
+#       ifdef REMODEL_HAS_REGION_QUERY
+            // Ranges may span adjacent regions of different protection, query each of them.
+            auto addr = reinterpret_cast<uintptr_t>(ptr);
+            auto end  = addr + size;
+            if (end < addr) return false;
+            std::vector<Region> regions;
+            do
+            {
+                const void* begin;
+                std::size_t regionSize;
+                if (!platform::queryReadableRegion(reinterpret_cast<const void*>(addr),
+                    begin, regionSize)) return false;
+                regions.push_back({reinterpret_cast<uintptr_t>(begin),
+                    reinterpret_cast<uintptr_t>(begin) + regionSize});
+                addr = regions.back().end;
+            } while (addr < end);
+            insert(std::move(regions));
+            return contains(ptr, size);
+#       else
+            return false;
+#       endif
+    }
+
+    /**
+     * @brief   Reads a value through an untrusted pointer.
+     * @tparam  T   The type of the value, trivially copyable.
+     * @param   ptr The pointer.
+     * @return  The value if readable, else an empty optional.
+     */
+    template<typename T>
+    zycore::Optional<T> read(const void* ptr)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "safe reads require trivial types");
+        if (!isReadable(ptr, sizeof(T))) return zycore::kEmpty;
+        zycore::Optional<T> result{zycore::kInPlace};
+        std::memcpy(&result.value(), ptr, sizeof(T));
+        return result;
+    }
+
+    /**
+     * @brief   Wraps an object behind an untrusted pointer.
+     * @tparam  WrapperT    The wrapper type, derived from `AdvancedClassWrapper`.
+     * @param   ptr         The pointer.
+     * @return  The wrapper if all `WrapperT::kObjSize` bytes are readable, else an empty optional.
+     * @note    Only the object itself is validated, pointers read through the wrapper are not.
+     */
+    template<typename WrapperT>
+    zycore::Optional<WrapperT> wrap(void* ptr)
+    {
+        if (!isReadable(ptr, WrapperT::kObjSize)) return zycore::kEmpty;
+        return {zycore::kInPlace, wrapper_cast<WrapperT>(ptr)};
+    }
+private:
+    /**
+     * @brief   Merges regions into the current ones and publishes the result.
+     */
+    void insert(std::vector<Region> regions)
+    {
+        std::lock_guard<std::mutex> lock{m_writeMutex};
+        {
+            auto current = m_snapshot.read();
+            for (std::size_t i = 0; i < current->begins.size(); ++i)
+            {
+                regions.push_back({current->begins[i], current->ends[i]});
+            }
+        }
+        publish(std::move(regions));
+    }
+
+    /**
+     * @brief   Sorts, merges and publishes regions, then reclaims the replaced snapshot.
+     *          Requires `m_writeMutex`.
+     */
+    void publish(std::vector<Region> regions)
+    {
+        std::sort(regions.begin(), regions.end(),
+            [](const Region& a, const Region& b) { return a.begin < b.begin; });
+
+        Snapshot next;
+        for (const auto& region : regions)
+        {
+            if (!next.ends.empty() && region.begin <= next.ends.back())
+            {
+                next.ends.back() = std::max(next.ends.back(), region.end);
+                continue;
+            }
+            next.begins.push_back(region.begin);
+            next.ends.push_back(region.end);
+        }
+
+        next.generation = m_snapshot.read()->generation + 1;
+        m_snapshot.publish(std::move(next));
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [safeRead] + [safeWrap] + [safeDeref]                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Dereferences an untrusted pointer to a trivially copyable type.
+ */
+template<typename T>
+struct SafeDeref
+{
+    using Type = std::remove_cv_t<T>;
+
+    static zycore::Optional<Type> deref(ReadableRegionMap& map, T* ptr)
+    {
+        return map.read<Type>(ptr);
+    }
+};
+
+/**
+ * @internal
+ * @brief   Dereferences an untrusted (rewritten) pointer to a wrapped object.
+ */
+template<typename WrapperT>
+struct SafeDeref<WeakWrapper<WrapperT>>
+{
+    using Type = WrapperT;
+
+    static zycore::Optional<Type> deref(ReadableRegionMap& map, WeakWrapper<WrapperT>* ptr)
+    {
+        return map.wrap<WrapperT>(ptr);
+    }
+};
+
+} // namespace internal
+
+/**
+ * @brief   Reads a value through an untrusted pointer, validated by the process-wide map.
+ * @tparam  T   The type of the value, trivially copyable.
+ * @param   ptr The pointer.
+ * @return  The value if readable, else an empty optional.
+ * @see     ReadableRegionMap::read
+ */
+template<typename T>
+inline zycore::Optional<T> safeRead(const void* ptr)
+{
+    return ReadableRegionMap::process().read<T>(ptr);
+}
+
+/**
+ * @brief   Wraps an object behind an untrusted pointer, validated by the process-wide map.
+ * @tparam  WrapperT    The wrapper type, derived from `AdvancedClassWrapper`.
+ * @param   ptr         The pointer.
+ * @return  The wrapper if the object is readable, else an empty optional.
+ * @see     ReadableRegionMap::wrap
+ */
+template<typename WrapperT>
+inline zycore::Optional<WrapperT> safeWrap(void* ptr)
+{
+    return ReadableRegionMap::process().wrap<WrapperT>(ptr);
+}
+
+/**
+ * @brief   Follows a pointer field, validating the pointer first.
+ * @tparam  FieldT  Type of the field, e.g. `Field<int*>` or `Field<CustomString*>`.
+ * @param   field   The field holding the untrusted pointer.
+ * @param   map     The map used for validation.
+ * @return  If readable, a copy of the pointee or, for pointers to wrapped types, a strong wrapper
+ *          of it. Else an empty optional.
+ */
+template<typename FieldT>
+inline auto safeDeref(const FieldT& field, ReadableRegionMap& map = ReadableRegionMap::process())
+    -> zycore::Optional<typename internal::SafeDeref<
+        std::remove_pointer_t<typename FieldT::RewrittenT>>::Type>
+{
+    using PtrT = typename FieldT::RewrittenT;
+    static_assert(std::is_pointer<PtrT>::value, "safeDeref requires pointer fields");
+    PtrT ptr = field;
+    return internal::SafeDeref<std::remove_pointer_t<PtrT>>::deref(map, ptr);
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_SAFEREAD_HPP
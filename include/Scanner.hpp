@@ -0,0 +1,968 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SCANNER_HPP
+#define REMODEL_SCANNER_HPP
+
+/**     
+ * @file
+ * @brief Contains a byte-pattern (signature) scanner.
+ *        
+ * Patterns are specified in IDA-style notation, e.g. `48 8B 05 ?? ?? ?? ?? 48 85 C0`, with `?` 
+ * or `??` denoting a wildcard byte. On x86 CPUs, candidates are filtered using SSE2/AVX2 
+ * (selected at run-time) by comparing the first and the last non-wildcard byte of the pattern
+ * at 16/32 positions at once, only verifying the full pattern for hits. `PatternBatch` resolves
+ * many patterns in a single pass over the data.
+ */
+
+#include "zycore/Config.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   define REMODEL_SCANNER_X86
+#   if defined(ZYCORE_MSVC)
+#       include <intrin.h>
+#       define REMODEL_SCANNER_TARGET(isa)
+#   else
+#       include <immintrin.h>
+#       define REMODEL_SCANNER_TARGET(isa) __attribute__((target(isa)))
+#   endif
+#endif
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Pattern]                                                                                      //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A byte pattern with wildcards.
+ */
+class Pattern
+{
+public:
+    /**
+     * @brief   Parses a pattern in IDA-style notation.
+     * @param   pattern Whitespace separated hex bytes and `?`/`??` wildcards.
+     * @note    Malformed patterns and patterns consisting of wildcards only are invalid.
+     */
+    explicit Pattern(const char* pattern)
+    {
+        m_valid = pattern != nullptr;
+        while (m_valid && *pattern)
+        {
+            if (*pattern == ' ' || *pattern == '\t')
+            {
+                ++pattern;
+                continue;
+            }
+            
+            std::size_t len = 0;
+            while (pattern[len] && pattern[len] != ' ' && pattern[len] != '\t') ++len;
+
+            if ((len == 1 && pattern[0] == '?') || (len == 2 && !strncmp(pattern, "??", 2)))
+            {
+                push(0, false);
+            }
+            else if (len == 2 && hexValue(pattern[0]) >= 0 && hexValue(pattern[1]) >= 0)
+            {
+                push(static_cast<uint8_t>(hexValue(pattern[0]) << 4 | hexValue(pattern[1])), true);
+            }
+            else
+            {
+                m_valid = false;
+            }
+            pattern += len;
+        }
+        finalize();
+    }
+
+    /**
+     * @brief   Constructs a pattern from bytes and a code-style mask.
+     * @param   bytes   The bytes of the pattern, as many as there are characters in the mask.
+     * @param   mask    The mask, an `x` for every byte to compare and a `?` for wildcards.
+     */
+    Pattern(const void* bytes, const char* mask)
+    {
+        m_valid = bytes != nullptr && mask != nullptr;
+        for (std::size_t i = 0; m_valid && mask[i]; ++i)
+        {
+            m_valid = mask[i] == 'x' || mask[i] == '?';
+            push(static_cast<const uint8_t*>(bytes)[i], mask[i] == 'x');
+        }
+        finalize();
+    }
+
+    /**
+     * @brief   Determines whether the pattern is valid.
+     * @return  @c true if valid, else @c false.
+     */
+    bool isValid() const { return m_valid; }
+
+    /**
+     * @brief   Gets the length of the pattern, in bytes.
+     * @return  The length.
+     */
+    std::size_t size() const { return m_bytes.size(); }
+
+    /**
+     * @brief   Gets the bytes of the pattern, zero for wildcards.
+     * @return  The bytes.
+     */
+    const uint8_t* bytes() const { return m_bytes.data(); }
+
+    /**
+     * @brief   Gets the mask of the pattern, `0xFF` for bytes to compare and zero for wildcards.
+     * @return  The mask.
+     */
+    const uint8_t* mask() const { return m_mask.data(); }
+
+    /**
+     * @brief   Gets the index of the first non-wildcard byte.
+     * @return  The index.
+     */
+    std::size_t firstAnchor() const { return m_firstAnchor; }
+
+    /**
+     * @brief   Gets the index of the last non-wildcard byte.
+     * @return  The index.
+     */
+    std::size_t lastAnchor() const { return m_lastAnchor; }
+
+    /**
+     * @brief   Determines whether the pattern matches the data at a location.
+     * @param   data    The data, at least `size()` bytes.
+     * @return  @c true if the pattern matches, else @c false.
+     */
+    bool matches(const uint8_t* data) const
+    {
+        for (std::size_t i = 0; i < m_bytes.size(); ++i)
+        {
+            if ((data[i] & m_mask[i]) != m_bytes[i]) return false;
+        }
+        return true;
+    }
+private:
+    static int hexValue(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    void push(uint8_t byte, bool compare)
+    {
+        m_bytes.push_back(compare ? byte : 0);
+        m_mask.push_back(compare ? 0xFF : 0);
+    }
+
+    void finalize()
+    {
+        m_firstAnchor = m_lastAnchor = 0;
+        bool anyAnchor = false;
+        for (std::size_t i = 0; i < m_mask.size(); ++i)
+        {
+            if (!m_mask[i]) continue;
+            if (!anyAnchor) m_firstAnchor = i;
+            m_lastAnchor = i;
+            anyAnchor = true;
+        }
+        m_valid &= anyAnchor;
+    }
+private:
+    std::vector<uint8_t> m_bytes;
+    std::vector<uint8_t> m_mask;
+    std::size_t m_firstAnchor;
+    std::size_t m_lastAnchor;
+    bool m_valid;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [ScanKernel]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Implementations of the pattern scanner.
+ */
+enum class ScanKernel
+{
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Determines the best scan kernel supported by the CPU.
+ * @return  The kernel.
+ */
+inline ScanKernel detectScanKernel()
+{
+#   if defined(REMODEL_SCANNER_X86) && defined(ZYCORE_MSVC)
+        int regs[4];
+        __cpuid(regs, 0);
+        int maxLeaf = regs[0];
+
+        __cpuid(regs, 1);
+        bool sse2    = (regs[3] & (1 << 26)) != 0;
+        bool osxsave = (regs[2] & (1 << 27)) != 0;
+        bool avx     = (regs[2] & (1 << 28)) != 0;
+
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+        {
+            __cpuidex(regs, 7, 0);
+            avx2 = (regs[1] & (1 << 5)) != 0;
+        }
+        return avx2 ? ScanKernel::Avx2 : sse2 ? ScanKernel::Sse2 : ScanKernel::Scalar;
+#   elif defined(REMODEL_SCANNER_X86)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? ScanKernel::Avx2 
+            : __builtin_cpu_supports("sse2") ? ScanKernel::Sse2 
+            : ScanKernel::Scalar;
+#   else
+        return ScanKernel::Scalar;
+#   endif
+}
+
+/**
+ * @internal
+ * @brief   Scalar scan kernel, searching for the first anchor using `memchr`.
+ * @param   begin   The begin of the searched data.
+ * @param   end     The end of the searched data.
+ * @param   pattern The pattern (valid).
+ * @return  The first match or @c nullptr.
+ */
+inline const uint8_t* scanScalar(const uint8_t* begin, const uint8_t* end, const Pattern& pattern)
+{
+    auto len = pattern.size();
+    if (static_cast<std::size_t>(end - begin) < len) return nullptr;
+
+    auto lastStart = end - len;
+    auto anchorIdx = pattern.firstAnchor();
+    auto anchor    = pattern.bytes()[anchorIdx];
+    for (auto cur = begin; cur <= lastStart;)
+    {
+        auto hit = static_cast<const uint8_t*>(
+            std::memchr(cur + anchorIdx, anchor, static_cast<std::size_t>(lastStart - cur) + 1));
+        if (!hit) return nullptr;
+
+        auto candidate = hit - anchorIdx;
+        if (pattern.matches(candidate)) return candidate;
+        cur = candidate + 1;
+    }
+    return nullptr;
+}
+
+#ifdef REMODEL_SCANNER_X86
+
+/**
+ * @internal
+ * @brief   Counts the trailing zero bits of a non-zero value.
+ */
+inline unsigned countTrailingZeros(uint32_t value)
+{
+#   ifdef ZYCORE_MSVC
+        unsigned long idx;
+        _BitScanForward(&idx, value);
+        return idx;
+#   else
+        return static_cast<unsigned>(__builtin_ctz(value));
+#   endif
+}
+
+/**
+ * @internal
+ * @brief   Verifies the candidates of a block, see `scanSse2` and `scanAvx2`.
+ */
+inline const uint8_t* verifyCandidates(const uint8_t* block, uint32_t candidates, 
+    const Pattern& pattern)
+{
+    while (candidates)
+    {
+        auto candidate = block + countTrailingZeros(candidates);
+        if (pattern.matches(candidate)) return candidate;
+        candidates &= candidates - 1;
+    }
+    return nullptr;
+}
+
+/**
+ * @internal
+ * @brief   SSE2 scan kernel, filtering 16 positions at once.
+ * @copydetails scanScalar
+ */
+REMODEL_SCANNER_TARGET("sse2")
+inline const uint8_t* scanSse2(const uint8_t* begin, const uint8_t* end, const Pattern& pattern)
+{
+    const std::size_t kBlock = 16;
+    auto len   = pattern.size();
+    auto first = pattern.firstAnchor();
+    auto last  = pattern.lastAnchor();
+    auto vFirst = _mm_set1_epi8(static_cast<char>(pattern.bytes()[first]));
+    auto vLast  = _mm_set1_epi8(static_cast<char>(pattern.bytes()[last ]));
+
+    auto cur = begin;
+    // All positions of the block need to be valid starts, which also keeps the loads in bounds.
+    for (; static_cast<std::size_t>(end - cur) >= len + kBlock - 1; cur += kBlock)
+    {
+        auto eqFirst = _mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + first)), vFirst);
+        auto eqLast  = _mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + last)), vLast);
+        auto candidates = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast)));
+        if (auto match = verifyCandidates(cur, candidates, pattern)) return match;
+    }
+    return scanScalar(cur, end, pattern);
+}
+
+/**
+ * @internal
+ * @brief   AVX2 scan kernel, filtering 32 positions at once.
+ * @copydetails scanScalar
+ */
+REMODEL_SCANNER_TARGET("avx2")
+inline const uint8_t* scanAvx2(const uint8_t* begin, const uint8_t* end, const Pattern& pattern)
+{
+    const std::size_t kBlock = 32;
+    auto len   = pattern.size();
+    auto first = pattern.firstAnchor();
+    auto last  = pattern.lastAnchor();
+    auto vFirst = _mm256_set1_epi8(static_cast<char>(pattern.bytes()[first]));
+    auto vLast  = _mm256_set1_epi8(static_cast<char>(pattern.bytes()[last ]));
+
+    auto cur = begin;
+    // All positions of the block need to be valid starts, which also keeps the loads in bounds.
+    for (; static_cast<std::size_t>(end - cur) >= len + kBlock - 1; cur += kBlock)
+    {
+        auto eqFirst = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + first)), vFirst);
+        auto eqLast  = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + last)), vLast);
+        auto candidates = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(eqFirst, eqLast)));
+        if (auto match = verifyCandidates(cur, candidates, pattern)) return match;
+    }
+    return scanScalar(cur, end, pattern);
+}
+
+#endif // ifdef REMODEL_SCANNER_X86
+
+} // namespace internal
+
+/**
+ * @brief   Gets the best scan kernel supported by the CPU.
+ * @return  The kernel, detected once on first use.
+ */
+inline ScanKernel bestScanKernel()
+{
+    static const ScanKernel kKernel = internal::detectScanKernel();
+    return kKernel;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [findPattern]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Searches data for the first occurrence of a pattern using a specific kernel.
+ * @param   data    The data to search.
+ * @param   size    The size of the data, in bytes.
+ * @param   pattern The pattern.
+ * @param   kernel  The kernel to use, must be supported by the CPU.
+ * @return  The first match or @c nullptr if not found or the pattern is invalid.
+ */
+inline const uint8_t* findPattern(const void* data, std::size_t size, const Pattern& pattern,
+    ScanKernel kernel)
+{
+    if (!pattern.isValid()) return nullptr;
+
+    auto begin = static_cast<const uint8_t*>(data);
+    auto end   = begin + size;
+    switch (kernel)
+    {
+#   ifdef REMODEL_SCANNER_X86
+        case ScanKernel::Avx2: return internal::scanAvx2(begin, end, pattern);
+        case ScanKernel::Sse2: return internal::scanSse2(begin, end, pattern);
+#   endif
+        default: return internal::scanScalar(begin, end, pattern);
+    }
+}
+
+/**
+ * @brief   Searches data for the first occurrence of a pattern.
+ * @copydetails findPattern(const void*, std::size_t, const Pattern&, ScanKernel)
+ */
+inline const uint8_t* findPattern(const void* data, std::size_t size, const Pattern& pattern)
+{
+    return findPattern(data, size, pattern, bestScanKernel());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [findPointerValues]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The maximum number of values the vectorized pointer kernels compare against.
+ */
+const std::size_t kMaxVectorPointerValues = 8;
+
+/**
+ * @internal
+ * @brief   Scalar pointer scan kernel.
+ * @param   begin   The first word of the searched data.
+ * @param   end     The end of the searched data.
+ * @param   values  The values to search for.
+ * @param   count   The number of values.
+ * @param   matches Receives the addresses of all words equal to one of the values.
+ */
+inline void findPointerValuesScalar(const uintptr_t* begin, const uintptr_t* end, 
+    const uintptr_t* values, std::size_t count, std::vector<const void*>& matches)
+{
+    for (auto cur = begin; cur < end; ++cur)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (*cur != values[i]) continue;
+            matches.push_back(cur);
+            break;
+        }
+    }
+}
+
+#ifdef REMODEL_SCANNER_X86
+
+/**
+ * @internal
+ * @brief   Compares the pointer-sized lanes of two vectors for equality. SSE2 lacks 64-bit 
+ *          compares, they are composed of the 32-bit compares of both halves.
+ */
+REMODEL_SCANNER_TARGET("sse2")
+inline __m128i cmpEqPointers(__m128i a, __m128i b)
+{
+    auto eq = _mm_cmpeq_epi32(a, b);
+    return sizeof(uintptr_t) == 4 ? eq 
+        : _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/**
+ * @internal
+ * @brief   Compares the pointer-sized lanes of two vectors for equality.
+ */
+REMODEL_SCANNER_TARGET("avx2")
+inline __m256i cmpEqPointers(__m256i a, __m256i b)
+{
+    return sizeof(uintptr_t) == 4 ? _mm256_cmpeq_epi32(a, b) : _mm256_cmpeq_epi64(a, b);
+}
+
+/**
+ * @internal
+ * @brief   SSE2 pointer scan kernel, filtering 64 bytes at once.
+ * @copydetails findPointerValuesScalar
+ */
+REMODEL_SCANNER_TARGET("sse2")
+inline void findPointerValuesSse2(const uintptr_t* begin, const uintptr_t* end, 
+    const uintptr_t* values, std::size_t count, std::vector<const void*>& matches)
+{
+    const std::size_t kWords = 64 / sizeof(uintptr_t);
+    const std::size_t kVecWords = 16 / sizeof(uintptr_t);
+
+    __m128i vValues[kMaxVectorPointerValues];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vValues[i] = sizeof(uintptr_t) == 4 ? _mm_set1_epi32(static_cast<int>(values[i]))
+            : _mm_set1_epi64x(static_cast<long long>(values[i]));
+    }
+
+    auto cur = begin;
+    for (; static_cast<std::size_t>(end - cur) >= kWords; cur += kWords)
+    {
+        auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + kVecWords));
+        auto v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + kVecWords * 2));
+        auto v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + kVecWords * 3));
+
+        auto hits = _mm_setzero_si128();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            hits = _mm_or_si128(hits, _mm_or_si128(
+                _mm_or_si128(cmpEqPointers(v0, vValues[i]), cmpEqPointers(v1, vValues[i])),
+                _mm_or_si128(cmpEqPointers(v2, vValues[i]), cmpEqPointers(v3, vValues[i]))));
+        }
+        if (_mm_movemask_epi8(hits)) 
+        {
+            findPointerValuesScalar(cur, cur + kWords, values, count, matches);
+        }
+    }
+    findPointerValuesScalar(cur, end, values, count, matches);
+}
+
+/**
+ * @internal
+ * @brief   AVX2 pointer scan kernel, filtering 128 bytes at once.
+ * @copydetails findPointerValuesScalar
+ */
+REMODEL_SCANNER_TARGET("avx2")
+inline void findPointerValuesAvx2(const uintptr_t* begin, const uintptr_t* end, 
+    const uintptr_t* values, std::size_t count, std::vector<const void*>& matches)
+{
+    const std::size_t kWords = 128 / sizeof(uintptr_t);
+    const std::size_t kVecWords = 32 / sizeof(uintptr_t);
+
+    __m256i vValues[kMaxVectorPointerValues];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vValues[i] = sizeof(uintptr_t) == 4 ? _mm256_set1_epi32(static_cast<int>(values[i]))
+            : _mm256_set1_epi64x(static_cast<long long>(values[i]));
+    }
+
+    auto cur = begin;
+    for (; static_cast<std::size_t>(end - cur) >= kWords; cur += kWords)
+    {
+        auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + kVecWords));
+        auto v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + kVecWords * 2));
+        auto v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + kVecWords * 3));
+
+        auto hits = _mm256_setzero_si256();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            hits = _mm256_or_si256(hits, _mm256_or_si256(
+                _mm256_or_si256(cmpEqPointers(v0, vValues[i]), cmpEqPointers(v1, vValues[i])),
+                _mm256_or_si256(cmpEqPointers(v2, vValues[i]), cmpEqPointers(v3, vValues[i]))));
+        }
+        if (!_mm256_testz_si256(hits, hits)) 
+        {
+            findPointerValuesScalar(cur, cur + kWords, values, count, matches);
+        }
+    }
+    findPointerValuesScalar(cur, end, values, count, matches);
+}
+
+#endif // ifdef REMODEL_SCANNER_X86
+
+} // namespace internal
+
+/**
+ * @brief   Searches data for pointer-sized, pointer-aligned words equal to any of some values, 
+ *          e.g. for references to a vftable, using a specific kernel.
+ * @param   data    The data to search. Words only partially inside are skipped.
+ * @param   size    The size of the data, in bytes.
+ * @param   values  The values to search for.
+ * @param   count   The number of values. For more than 8 values, the scalar kernel is used.
+ * @param   matches Receives the addresses of all matching words, in ascending order.
+ * @param   kernel  The kernel to use, must be supported by the CPU.
+ */
+inline void findPointerValues(const void* data, std::size_t size, const uintptr_t* values,
+    std::size_t count, std::vector<const void*>& matches, ScanKernel kernel)
+{
+    if (!count) return;
+
+    const auto kAlign = sizeof(uintptr_t);
+    auto addr  = reinterpret_cast<uintptr_t>(data);
+    auto first = (addr + kAlign - 1) / kAlign * kAlign;
+    auto last  = (addr + size) / kAlign * kAlign;
+    if (last <= first) return;
+
+    auto begin = reinterpret_cast<const uintptr_t*>(first);
+    auto end   = reinterpret_cast<const uintptr_t*>(last);
+    if (count > internal::kMaxVectorPointerValues) kernel = ScanKernel::Scalar;
+    switch (kernel)
+    {
+#   ifdef REMODEL_SCANNER_X86
+        case ScanKernel::Avx2: 
+            return internal::findPointerValuesAvx2(begin, end, values, count, matches);
+        case ScanKernel::Sse2: 
+            return internal::findPointerValuesSse2(begin, end, values, count, matches);
+#   endif
+        default: 
+            return internal::findPointerValuesScalar(begin, end, values, count, matches);
+    }
+}
+
+/**
+ * @brief   Searches data for pointer-sized, pointer-aligned words equal to any of some values.
+ * @copydetails findPointerValues(const void*, std::size_t, const uintptr_t*, std::size_t, 
+ *              std::vector<const void*>&, ScanKernel)
+ */
+inline void findPointerValues(const void* data, std::size_t size, const uintptr_t* values,
+    std::size_t count, std::vector<const void*>& matches)
+{
+    findPointerValues(data, size, values, count, matches, bestScanKernel());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [PatternBatch]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Resolves many patterns in a single pass over the data.
+ *          
+ * Every pattern is bucketed by a pair of adjacent non-wildcard bytes (or a single byte, if it
+ * has no such pair). The pass then tests the byte pair at each position against an 8 KiB bitmap
+ * of all bucketed pairs and, for positions passing it, only verifies the patterns in the
+ * matching bucket. The cost of a pass therefore hardly depends on the number of patterns.
+ *          
+ * Like @c findPattern, the first match of every pattern is recorded. Subsequent calls to 
+ * @c scan (e.g. for further sections of a module) only search for still unresolved patterns.
+ */
+class PatternBatch
+{
+public:
+    /**
+     * @brief   Adds a pattern to the batch.
+     * @param   pattern The pattern. Invalid patterns are accepted, but never resolved.
+     * @return  The index of the pattern, to query the result with.
+     */
+    std::size_t add(Pattern pattern)
+    {
+        m_patterns.push_back(std::move(pattern));
+        m_results.push_back(0);
+        m_built = false;
+        return m_patterns.size() - 1;
+    }
+
+    /**
+     * @brief   Adds an IDA-style pattern to the batch.
+     * @copydetails add(Pattern)
+     */
+    std::size_t add(const char* pattern)
+    {
+        return add(Pattern{pattern});
+    }
+
+    /**
+     * @brief   Gets the number of patterns in the batch.
+     * @return  The number of patterns.
+     */
+    std::size_t size() const { return m_patterns.size(); }
+
+    /**
+     * @brief   Gets a pattern of the batch.
+     * @param   idx The index of the pattern.
+     * @return  The pattern.
+     */
+    const Pattern& pattern(std::size_t idx) const { return m_patterns[idx]; }
+
+    /**
+     * @brief   Determines whether a pattern was found.
+     * @param   idx The index of the pattern.
+     * @return  @c true if resolved, else @c false.
+     */
+    bool isResolved(std::size_t idx) const { return m_results[idx] != 0; }
+
+    /**
+     * @brief   Determines whether all patterns of the batch were found.
+     * @return  @c true if all resolved, else @c false.
+     */
+    bool allResolved() const
+    {
+        for (auto result : m_results) if (!result) return false;
+        return true;
+    }
+
+    /**
+     * @brief   Gets the address of the first match of a pattern.
+     * @param   idx The index of the pattern.
+     * @return  The address (e.g. to construct a @c Function or @c AbsGetter from), zero if 
+     *          unresolved.
+     */
+    uintptr_t address(std::size_t idx) const { return m_results[idx]; }
+
+    /**
+     * @brief   Sets the result of a pattern, e.g. when restoring results from a cache.
+     * @param   idx     The index of the pattern.
+     * @param   address The address of the match, zero for unresolved.
+     */
+    void setAddress(std::size_t idx, uintptr_t address) { m_results[idx] = address; }
+
+    /**
+     * @brief   Discards all results.
+     */
+    void reset()
+    {
+        std::fill(m_results.begin(), m_results.end(), 0);
+    }
+
+    /**
+     * @brief   Searches data for all still unresolved patterns.
+     * @param   data        The data to search.
+     * @param   size        The size of the data, in bytes.
+     * @param   threadCount The maximum number of threads to scan with, zero for one per 
+     *                      hardware thread. Fewer threads are used for small data.
+     *          
+     * For multiple threads, the data is split into chunks, each scanned by one thread. Patterns
+     * are verified against the whole data, so matches straddling chunk boundaries are found by
+     * the chunk containing their bucketed bytes. Per pattern, the match of the lowest chunk wins,
+     * yielding the same results as a single-threaded scan.
+     */
+    void scan(const void* data, std::size_t size, unsigned threadCount = 1)
+    {
+        if (!m_built) build();
+        if (!size) return;
+
+        if (!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        auto chunkCount = static_cast<std::size_t>(threadCount);
+        chunkCount = std::max<std::size_t>(std::min(chunkCount, size / kMinChunkSize), 1);
+
+        auto begin = static_cast<const uint8_t*>(data);
+        auto end   = begin + size;
+        if (chunkCount == 1)
+        {
+            scanChunk(begin, end, begin, end, m_results);
+            return;
+        }
+
+        std::vector<std::vector<uintptr_t>> chunkResults(chunkCount, m_results);
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        auto chunkSize = size / chunkCount;
+        for (std::size_t i = 1; i < chunkCount; ++i)
+        {
+            auto chunkBegin = begin + i * chunkSize;
+            auto chunkEnd   = i + 1 == chunkCount ? end : chunkBegin + chunkSize;
+            threads.emplace_back([this, begin, end, chunkBegin, chunkEnd, i, &chunkResults]
+            {
+                scanChunk(begin, end, chunkBegin, chunkEnd, chunkResults[i]);
+            });
+        }
+        scanChunk(begin, end, begin, begin + chunkSize, chunkResults[0]);
+        for (auto& thread : threads) thread.join();
+
+        for (std::size_t idx = 0; idx < m_results.size(); ++idx)
+        {
+            for (std::size_t i = 0; i < chunkCount && !m_results[idx]; ++i)
+            {
+                m_results[idx] = chunkResults[i][idx];
+            }
+        }
+    }
+private:
+    /**
+     * @internal
+     * @brief   A pattern in a bucket, along with the offset of the bucketed bytes.
+     */
+    struct Entry
+    {
+        uint32_t patternIdx;
+        uint32_t anchorOffset;
+    };
+
+    /**
+     * @internal
+     * @brief   The minimum amount of data, in bytes, a thread is spawned for.
+     */
+    static const std::size_t kMinChunkSize = 256 * 1024;
+
+    /**
+     * @internal
+     * @brief   Searches a chunk of the data for the patterns unresolved in @c results.
+     * @param   begin       The begin of the whole data.
+     * @param   end         The end of the whole data.
+     * @param   chunkBegin  The begin of the chunk, the first position bucketed bytes are 
+     *                      looked up at.
+     * @param   chunkEnd    The end of the chunk.
+     * @param   results     The results, updated with the first matches in the chunk.
+     */
+    void scanChunk(const uint8_t* begin, const uint8_t* end, const uint8_t* chunkBegin,
+        const uint8_t* chunkEnd, std::vector<uintptr_t>& results) const
+    {
+        std::size_t pending = 0;
+        for (std::size_t i = 0; i < m_patterns.size(); ++i)
+        {
+            pending += m_patterns[i].isValid() && !results[i];
+        }
+
+        auto cur = chunkBegin;
+        for (; cur < chunkEnd && cur + 1 < end && pending; ++cur)
+        {
+            auto pair = static_cast<std::size_t>(cur[0] << 8 | cur[1]);
+            if (!(m_pairFilter[pair / 64] & uint64_t{1} << pair % 64)) continue;
+
+            pending -= visit(m_byteEntries, m_byteBuckets, cur[0], begin, end, cur, results);
+            pending -= visit(m_pairEntries, m_pairBuckets, pair, begin, end, cur, results);
+        }
+        // The last byte has no pair, only single byte buckets can match there.
+        if (pending && cur == end - 1)
+        {
+            visit(m_byteEntries, m_byteBuckets, *cur, begin, end, cur, results);
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Verifies the patterns of a bucket at a position.
+     * @return  The number of newly resolved patterns.
+     */
+    std::size_t visit(const std::vector<Entry>& entries, const std::vector<uint32_t>& buckets,
+        std::size_t bucket, const uint8_t* begin, const uint8_t* end, const uint8_t* cur,
+        std::vector<uintptr_t>& results) const
+    {
+        std::size_t resolved = 0;
+        for (auto i = buckets[bucket]; i < buckets[bucket + 1]; ++i)
+        {
+            const auto& entry = entries[i];
+            if (results[entry.patternIdx]) continue;
+            if (static_cast<std::size_t>(cur - begin) < entry.anchorOffset) continue;
+
+            const auto& pattern = m_patterns[entry.patternIdx];
+            auto start = cur - entry.anchorOffset;
+            if (static_cast<std::size_t>(end - start) < pattern.size()) continue;
+            if (!pattern.matches(start)) continue;
+
+            results[entry.patternIdx] = reinterpret_cast<uintptr_t>(start);
+            ++resolved;
+        }
+        return resolved;
+    }
+
+    /**
+     * @internal
+     * @brief   Determines the bytes to bucket a pattern by.
+     * @param   pattern The pattern (valid).
+     * @param   offset  Receives the offset of the bytes in the pattern.
+     * @return  @c true if a pair of adjacent bytes was chosen, @c false for a single byte.
+     */
+    static bool chooseAnchor(const Pattern& pattern, std::size_t& offset)
+    {
+        // Prefer pairs of bytes that are less common in images (padding, zero-fill).
+        auto common = [](uint8_t byte) { return byte == 0x00 || byte == 0xFF || byte == 0xCC; };
+        int bestScore = 3;
+        for (std::size_t i = 0; i + 1 < pattern.size(); ++i)
+        {
+            if (!pattern.mask()[i] || !pattern.mask()[i + 1]) continue;
+            int score = common(pattern.bytes()[i]) + common(pattern.bytes()[i + 1]);
+            if (score < bestScore)
+            {
+                bestScore = score;
+                offset    = i;
+            }
+        }
+        if (bestScore < 3) return true;
+
+        offset = pattern.firstAnchor();
+        return false;
+    }
+
+    /**
+     * @internal
+     * @brief   Builds the buckets and the pair filter.
+     */
+    void build()
+    {
+        m_byteBuckets.assign(256 + 1, 0);
+        m_pairBuckets.assign(65536 + 1, 0);
+        m_pairFilter.assign(65536 / 64, 0);
+        auto setFilter = [&](std::size_t pair) 
+        { 
+            m_pairFilter[pair / 64] |= uint64_t{1} << pair % 64; 
+        };
+
+        // Count the bucket sizes, then lay out entries contiguously (prefix sums).
+        std::vector<std::size_t> offsets(m_patterns.size());
+        std::vector<bool> isPair(m_patterns.size());
+        for (std::size_t i = 0; i < m_patterns.size(); ++i)
+        {
+            const auto& pattern = m_patterns[i];
+            if (!pattern.isValid()) continue;
+
+            isPair[i] = chooseAnchor(pattern, offsets[i]);
+            auto lead = pattern.bytes()[offsets[i]];
+            if (isPair[i])
+            {
+                auto pair = static_cast<std::size_t>(lead << 8 | pattern.bytes()[offsets[i] + 1]);
+                ++m_pairBuckets[pair + 1];
+                setFilter(pair);
+            }
+            else
+            {
+                ++m_byteBuckets[lead + 1];
+                for (std::size_t second = 0; second < 256; ++second) setFilter(lead << 8 | second);
+            }
+        }
+        for (std::size_t i = 1; i < m_byteBuckets.size(); ++i) 
+        {
+            m_byteBuckets[i] += m_byteBuckets[i - 1];
+        }
+        for (std::size_t i = 1; i < m_pairBuckets.size(); ++i) 
+        {
+            m_pairBuckets[i] += m_pairBuckets[i - 1];
+        }
+
+        m_byteEntries.resize(m_byteBuckets.back());
+        m_pairEntries.resize(m_pairBuckets.back());
+        std::vector<uint32_t> byteFill(m_byteBuckets.begin(), m_byteBuckets.end() - 1);
+        std::vector<uint32_t> pairFill(m_pairBuckets.begin(), m_pairBuckets.end() - 1);
+        for (std::size_t i = 0; i < m_patterns.size(); ++i)
+        {
+            const auto& pattern = m_patterns[i];
+            if (!pattern.isValid()) continue;
+
+            Entry entry{static_cast<uint32_t>(i), static_cast<uint32_t>(offsets[i])};
+            auto lead = pattern.bytes()[offsets[i]];
+            if (isPair[i])
+            {
+                m_pairEntries[pairFill[lead << 8 | pattern.bytes()[offsets[i] + 1]]++] = entry;
+            }
+            else
+            {
+                m_byteEntries[byteFill[lead]++] = entry;
+            }
+        }
+        m_built = true;
+    }
+private:
+    std::vector<Pattern> m_patterns;
+    std::vector<uintptr_t> m_results;
+    std::vector<uint32_t> m_byteBuckets;
+    std::vector<uint32_t> m_pairBuckets;
+    std::vector<Entry> m_byteEntries;
+    std::vector<Entry> m_pairEntries;
+    std::vector<uint64_t> m_pairFilter;
+    bool m_built = false;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#undef REMODEL_SCANNER_TARGET
+
+#endif // REMODEL_SCANNER_HPP
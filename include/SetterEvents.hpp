@@ -0,0 +1,389 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SETTEREVENTS_HPP
+#define REMODEL_SETTEREVENTS_HPP
+
+/**     
+ * @file
+ * @brief Contains event streams published by hooked setters, pushing changes instead of polling.
+ *        
+ * A `SetterEventStream` hooks a member function (typically a setter). After the original ran, 
+ * the detour appends an event holding the object pointer and the argument values to a lock-free 
+ * single-producer single-consumer ring. A consumer drains the events in batches, e.g. to 
+ * forward deltas to a backend.
+ *
+ * @code
+ *      MemberFunction<void (*)(int)> setHealth{...};
+ *      SetterEventStream<decltype(setHealth.get())> healthEvents{setHealth};
+ *      healthEvents.install();
+ *      // ... consumer thread:
+ *      healthEvents.drainLatest([](const auto& event) 
+ *      { 
+ *          sendHealth(event.object, std::get<0>(event.args)); 
+ *      });
+ * @endcode
+ * 
+ * The detour is a static function, so only one stream per setter type can be installed at a 
+ * time. Distinguish setters sharing a signature by the tag type.
+ */
+
+#include "Hook.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [EventRing]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Lock-free single-producer single-consumer ring of events.
+ * @tparam  EventT      The event type, default constructible and copy assignable.
+ * @tparam  capacityT   The number of events, a power of two.
+ *                      
+ * Events are dropped (and counted) while the ring is full.
+ */
+template<typename EventT, std::size_t capacityT>
+class EventRing
+{
+    static_assert(capacityT && !(capacityT & (capacityT - 1)), "capacity must be a power of two");
+public:
+    static const std::size_t kCapacity = capacityT;
+
+    EventRing()
+        : m_events{new EventT[capacityT]}
+    {}
+
+    EventRing(const EventRing&) = delete;
+    EventRing& operator = (const EventRing&) = delete;
+
+    /**
+     * @brief   Appends an event, called by the producer only.
+     * @param   event   The event.
+     * @return  @c true on success, @c false if the ring is full.
+     */
+    bool push(const EventT& event)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == capacityT)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == capacityT)
+            {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, 
+                    std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_events[head & (capacityT - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief   Removes all published events, called by the consumer only.
+     * @param   func    Invoked with contiguous runs of events as `(const EventT*, size_t)`.
+     * @return  The number of events drained.
+     */
+    template<typename FuncT>
+    std::size_t drain(FuncT&& func)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto head = m_head.load(std::memory_order_acquire);
+        for (auto cur = tail; cur != head;)
+        {
+            auto idx = cur & (capacityT - 1);
+            auto run = std::min<std::size_t>(head - cur, capacityT - idx);
+            func(static_cast<const EventT*>(&m_events[idx]), run);
+            cur += run;
+        }
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /**
+     * @brief   Determines whether the ring holds published events.
+     */
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief   Gets the number of events dropped because the ring was full.
+     */
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+private:
+    std::unique_ptr<EventT[]> m_events;
+    // Producer and consumer indices on separate cache lines, avoiding false sharing.
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+    std::atomic<uint64_t> m_dropped{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [SetterEvent]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A call of a hooked setter.
+ * @tparam  ArgsT   The argument types of the setter, stored decayed (by value).
+ */
+template<typename... ArgsT>
+struct SetterEvent
+{
+    /// The object the setter was called on.
+    void* object;
+    /// The argument values.
+    std::tuple<std::decay_t<ArgsT>...> args;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [SetterEventStream]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Implementation of `SetterEventStream` independent of the calling convention.
+ */
+template<typename FunctionPtrT, typename EventT, std::size_t capacityT>
+class SetterEventStreamBase
+{
+public:
+    using Event = EventT;
+
+    SetterEventStreamBase(const SetterEventStreamBase&) = delete;
+    SetterEventStreamBase& operator = (const SetterEventStreamBase&) = delete;
+
+    /**
+     * @brief   Determines whether the hook is installed.
+     */
+    bool isInstalled() const { return m_hook.isInstalled(); }
+
+    /**
+     * @brief   Removes all published events in order, called by the consumer only.
+     * @param   func    Invoked with contiguous runs of events as `(const Event*, size_t)`.
+     * @return  The number of events drained.
+     */
+    template<typename FuncT>
+    std::size_t drain(FuncT&& func) { return m_ring.drain(std::forward<FuncT>(func)); }
+
+    /**
+     * @brief   Removes all published events, reporting only the latest one of every object.
+     * @param   func    Invoked as `(const Event&)` once per object, in order of the objects' 
+     *                  last calls.
+     * @return  The number of events drained.
+     *          
+     * Suited for setters whose latest call per object determines the state, collapsing a batch
+     * into one delta per object.
+     */
+    template<typename FuncT>
+    std::size_t drainLatest(FuncT&& func)
+    {
+        m_batch.clear();
+        auto count = m_ring.drain([&](const Event* events, std::size_t run) 
+        {
+            m_batch.insert(m_batch.end(), events, events + run);
+        });
+
+        m_seen.clear();
+        auto firstLatest = m_batch.size();
+        for (auto i = m_batch.size(); i-- > 0;)
+        {
+            // Moves the latest events to the back, keeping their relative order.
+            if (!m_seen.insert(m_batch[i].object).second) continue;
+            std::swap(m_batch[--firstLatest], m_batch[i]);
+        }
+        for (auto i = firstLatest; i < m_batch.size(); ++i) func(m_batch[i]);
+        return count;
+    }
+
+    /**
+     * @brief   Determines whether events are waiting to be drained.
+     */
+    bool empty() const { return m_ring.empty(); }
+
+    /**
+     * @brief   Gets the number of events dropped because the ring was full.
+     */
+    uint64_t dropped() const { return m_ring.dropped(); }
+protected:
+    SetterEventStreamBase(void* target, FunctionPtrT detour)
+        : m_hook{target, detour}
+    {}
+
+    ~SetterEventStreamBase() = default;
+
+    /**
+     * @internal
+     * @brief   Publishes an event once the original returned.
+     */
+    class Publisher
+    {
+        SetterEventStreamBase& m_stream;
+        Event m_event;
+    public:
+        template<typename... ArgsT>
+        Publisher(SetterEventStreamBase& stream, void* object, const ArgsT&... args)
+            : m_stream(stream)
+            , m_event{object, std::make_tuple(args...)}
+        {}
+
+        ~Publisher() { m_stream.m_ring.push(m_event); }
+    };
+
+    Hook<FunctionPtrT> m_hook;
+private:
+    EventRing<Event, capacityT> m_ring;
+    std::vector<Event> m_batch;
+    std::unordered_set<void*> m_seen;
+};
+
+} // namespace internal
+
+/**
+ * @brief   Hooks a setter, publishing an event for every call after the original ran.
+ * @tparam  FunctionPtrT    The function pointer type of the setter, taking the object first, as 
+ *                          returned by `MemberFunction::get`.
+ * @tparam  TagT            Distinguishes streams of setters with the same signature.
+ * @tparam  capacityT       The number of events buffered, a power of two.
+ *                          
+ * The setter may be called from a single thread at a time (the producer) while one consumer 
+ * drains. Only one stream per instantiation can be installed at a time. Uninstall the stream 
+ * before destroying it, and not while the setter is executing.
+ */
+template<typename FunctionPtrT, typename TagT = void, std::size_t capacityT = 1024>
+class SetterEventStream
+{
+    static_assert(internal::BlackBoxConsts<FunctionPtrT>::kFalse,
+        "setter event streams expect a member function pointer type taking the object first");
+};
+
+/**
+ * @internal
+ * @brief   A macro that defines a setter event stream for a calling convention.
+ * @param   callingConv The calling convention.
+ */
+#define REMODEL_DEF_SETTER_EVENT_STREAM(callingConv)                                               \
+    template<typename RetT, typename... ArgsT, typename TagT, std::size_t capacityT>               \
+    class SetterEventStream<RetT (callingConv*)(void*, ArgsT...), TagT, capacityT>                 \
+        : public internal::SetterEventStreamBase<                                                  \
+            RetT (callingConv*)(void*, ArgsT...), SetterEvent<ArgsT...>, capacityT>                \
+    {                                                                                              \
+        using FunctionPtr = RetT (callingConv*)(void*, ArgsT...);                                  \
+        using Base = internal::SetterEventStreamBase<                                              \
+            FunctionPtr, SetterEvent<ArgsT...>, capacityT>;                                        \
+    public:                                                                                        \
+        /* Hooks a setter at an address. */                                                        \
+        explicit SetterEventStream(void* target)                                                   \
+            : Base{target, &detour}                                                                \
+        {}                                                                                         \
+                                                                                                   \
+        /* Hooks a setter. */                                                                      \
+        explicit SetterEventStream(FunctionPtr target)                                             \
+            : SetterEventStream{*reinterpret_cast<void**>(&target)}                                \
+        {}                                                                                         \
+                                                                                                   \
+        /* Hooks the setter a wrapper resolves to. */                                              \
+        template<typename T, typename PtrGetterT>                                                  \
+        explicit SetterEventStream(const MemberFunction<T, PtrGetterT>& setter)                    \
+            : SetterEventStream{setter.get()}                                                      \
+        {}                                                                                         \
+                                                                                                   \
+        ~SetterEventStream() { uninstall(); }                                                      \
+                                                                                                   \
+        /* Installs the hook, @c false if failed or another stream is installed. */                \
+        bool install()                                                                             \
+        {                                                                                          \
+            SetterEventStream* expected = nullptr;                                                 \
+            if (!active().compare_exchange_strong(expected, this)) return expected == this;        \
+            if (this->m_hook.install()) return true;                                               \
+            active().store(nullptr);                                                               \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        /* Uninstalls the hook. */                                                                 \
+        bool uninstall()                                                                           \
+        {                                                                                          \
+            if (active().load() != this) return true;                                              \
+            if (!this->m_hook.uninstall()) return false;                                           \
+            active().store(nullptr);                                                               \
+            return true;                                                                           \
+        }                                                                                          \
+    private:                                                                                       \
+        static std::atomic<SetterEventStream*>& active()                                           \
+        {                                                                                          \
+            static std::atomic<SetterEventStream*> stream{nullptr};                                \
+            return stream;                                                                         \
+        }                                                                                          \
+                                                                                                   \
+        static RetT callingConv detour(void* object, ArgsT... args)                                \
+        {                                                                                          \
+            auto self = active().load(std::memory_order_acquire);                                  \
+            typename Base::Publisher publisher{*self, object, args...};                            \
+            return self->m_hook.original()(object, std::forward<ArgsT>(args)...);                  \
+        }                                                                                          \
+    }
+
+#if defined(ZYCORE_MSVC) && defined(_M_X64)
+    REMODEL_DEF_SETTER_EVENT_STREAM(__cdecl);
+#elif defined(ZYCORE_MSVC) && defined(_M_IX86)
+    REMODEL_DEF_SETTER_EVENT_STREAM(__cdecl);
+    REMODEL_DEF_SETTER_EVENT_STREAM(__stdcall);
+    REMODEL_DEF_SETTER_EVENT_STREAM(__thiscall);
+#elif defined(ZYCORE_GNUC) && defined(__x86_64__)
+    // The native ABI is the plain function type, only the foreign one is distinct.
+    REMODEL_DEF_SETTER_EVENT_STREAM();
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        REMODEL_DEF_SETTER_EVENT_STREAM(__attribute__((sysv_abi)));
+#   else
+        REMODEL_DEF_SETTER_EVENT_STREAM(__attribute__((ms_abi)));
+#   endif
+#elif defined(ZYCORE_GNUC) && defined(__i386__)
+    REMODEL_DEF_SETTER_EVENT_STREAM(__attribute__((cdecl)));
+    REMODEL_DEF_SETTER_EVENT_STREAM(__attribute__((stdcall)));
+    REMODEL_DEF_SETTER_EVENT_STREAM(__attribute__((thiscall)));
+#endif
+
+#undef REMODEL_DEF_SETTER_EVENT_STREAM
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_SETTEREVENTS_HPP
@@ -0,0 +1,373 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SHAREDSNAPSHOT_HPP
+#define REMODEL_SHAREDSNAPSHOT_HPP
+
+/**     
+ * @file
+ * @brief Contains a shared memory transport for reading wrapped objects of another process.
+ *        
+ * An agent inside the target registers objects with a `SnapshotPublisher` and periodically 
+ * copies them into a shared memory segment, each object guarded by a sequence lock. Readers 
+ * in other processes use `SharedSnapshotAccessor` as memory accessor of `RemoteInstance`, so the 
+ * same wrapper definitions work on the published copies without a single system call.
+ *
+ * @code
+ *      // Agent inside the target.
+ *      SnapshotPublisher publisher;
+ *      publisher.add(player);
+ *      publisher.create("game-snapshots");
+ *      // ... periodically:
+ *      publisher.publish();
+ *      
+ *      // Reader.
+ *      SharedSnapshotAccessor snapshots;
+ *      if (snapshots.open("game-snapshots"))
+ *      {
+ *          RemoteInstance<Player, SharedSnapshotAccessor> remote{snapshots, playerAddress};
+ *          if (remote.refresh()) show(remote->health);
+ *      }
+ * @endcode
+ * 
+ * Objects are addressed by their address in the target, so reads of unpublished memory (e.g.
+ * following pointers to other objects) fail instead of returning stale data.
+ */
+
+#include "Remote.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef REMODEL_HAS_SHARED_MEMORY
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Snapshot segment layout]                                                                      //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The header of a snapshot segment, followed by `count` `SnapshotEntry`s sorted by 
+ *          address, followed by the objects.
+ */
+struct SnapshotHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+};
+
+/**
+ * @internal
+ * @brief   The directory entry of a published object.
+ */
+struct SnapshotEntry
+{
+    uint64_t address;
+    uint64_t size;
+    /// Offset of the sequence counter from the start of the segment, followed by the object.
+    uint64_t offset;
+};
+
+const char kSnapshotMagic[8] = {'R', 'M', 'D', 'L', 'S', 'N', 'A', 'P'};
+
+/**
+ * @internal
+ * @brief   The sequence counters are placed on their own cache lines, the objects behind them.
+ */
+const std::size_t kSnapshotAlign = 64;
+
+/**
+ * @internal
+ * @brief   The sequence counter of a published object, odd while being written.
+ */
+using SnapshotSeq = std::atomic<uint64_t>;
+
+static_assert(sizeof(SnapshotSeq) == 8, "unexpected atomic size");
+
+inline std::size_t alignSnapshot(std::size_t offset)
+{
+    return (offset + kSnapshotAlign - 1) & ~(kSnapshotAlign - 1);
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [SnapshotPublisher]                                                                            //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Copies local objects into a shared memory segment for `SharedSnapshotAccessor`s.
+ *          
+ * Objects are registered before creating the segment. `publish` is not thread-safe, call it 
+ * from a single thread. Readers never block the publisher.
+ */
+class SnapshotPublisher
+{
+public:
+    /**
+     * @brief   Registers an object.
+     * @param   object  The object.
+     * @param   size    The size of the object, in bytes.
+     */
+    void add(const void* object, std::size_t size)
+    {
+        m_objects.push_back(Object{object, size, 0});
+    }
+
+    /**
+     * @brief   Registers the object a wrapper points to.
+     * @param   wrapper The wrapper, derived from `AdvancedClassWrapper`.
+     */
+    template<typename WrapperT>
+    void add(const WrapperT& wrapper)
+    {
+        add(wrapper.addressOfObj(), WrapperT::kObjSize);
+    }
+
+    /**
+     * @brief   Creates the segment and publishes all registered objects once.
+     * @param   name    The name of the segment.
+     * @return  @c true on success, else @c false, e.g. because of overlapping objects.
+     */
+    bool create(const char* name)
+    {
+        std::sort(m_objects.begin(), m_objects.end(), [](const Object& a, const Object& b)
+        { 
+            return a.object < b.object; 
+        });
+        for (std::size_t i = 1; i < m_objects.size(); ++i)
+        {
+            auto prev = static_cast<const uint8_t*>(m_objects[i - 1].object);
+            if (prev + m_objects[i - 1].size > m_objects[i].object) return false;
+        }
+
+        auto offset = internal::alignSnapshot(sizeof(internal::SnapshotHeader) 
+            + m_objects.size() * sizeof(internal::SnapshotEntry));
+        for (auto& object : m_objects)
+        {
+            object.offset = offset;
+            offset = internal::alignSnapshot(
+                offset + sizeof(internal::SnapshotSeq) + object.size);
+        }
+        if (!m_segment.create(name, offset)) return false;
+
+        auto base   = static_cast<uint8_t*>(m_segment.data());
+        auto header = reinterpret_cast<internal::SnapshotHeader*>(base);
+        auto dir    = reinterpret_cast<internal::SnapshotEntry*>(header + 1);
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            new (base + m_objects[i].offset) internal::SnapshotSeq{0};
+            dir[i] = internal::SnapshotEntry{
+                reinterpret_cast<uintptr_t>(m_objects[i].object), m_objects[i].size, 
+                m_objects[i].offset};
+        }
+        publish();
+
+        // Publishing the header last, so readers never see a partially initialized segment.
+        header->count   = static_cast<uint32_t>(m_objects.size());
+        header->version = internal::SnapshotHeader::kVersion;
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header->magic, internal::kSnapshotMagic, sizeof(header->magic));
+        return true;
+    }
+
+    /**
+     * @brief   Copies all registered objects into the segment.
+     */
+    void publish()
+    {
+        auto base = static_cast<uint8_t*>(m_segment.data());
+        if (!base) return;
+
+        for (const auto& object : m_objects)
+        {
+            auto& seq = *reinterpret_cast<internal::SnapshotSeq*>(base + object.offset);
+            auto cur = seq.load(std::memory_order_relaxed);
+            seq.store(cur + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(base + object.offset + sizeof(seq), object.object, object.size);
+            seq.store(cur + 2, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief   Gets the number of registered objects.
+     */
+    std::size_t size() const { return m_objects.size(); }
+
+    /**
+     * @brief   Gets the segment.
+     */
+    const platform::SharedMemory& segment() const { return m_segment; }
+private:
+    struct Object
+    {
+        const void* object;
+        std::size_t size;
+        std::size_t offset;
+    };
+
+    std::vector<Object> m_objects;
+    platform::SharedMemory m_segment;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [SharedSnapshotAccessor]                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Read-only memory accessor serving reads from a snapshot segment.
+ *          
+ * A read succeeds if it lies within a single published object. It copies the object part while
+ * no publish is in progress, retrying (and eventually giving up) otherwise.
+ */
+class SharedSnapshotAccessor
+{
+public:
+    /**
+     * @brief   The number of attempts per read before giving up.
+     */
+    static const unsigned kMaxAttempts = 1u << 16;
+
+    /**
+     * @brief   Opens and validates a segment.
+     * @param   name    The name of the segment.
+     * @return  @c true if the segment holds published objects, else @c false.
+     */
+    bool open(const char* name)
+    {
+        m_count = 0;
+        if (!m_segment.open(name)) return false;
+
+        auto header = static_cast<const internal::SnapshotHeader*>(m_segment.data());
+        if (m_segment.size() < sizeof(*header)
+            || std::memcmp(header->magic, internal::kSnapshotMagic, sizeof(header->magic)))
+        {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->version != internal::SnapshotHeader::kVersion) return false;
+
+        auto count = static_cast<std::size_t>(header->count);
+        m_entries = reinterpret_cast<const internal::SnapshotEntry*>(header + 1);
+        if ((m_segment.size() - sizeof(*header)) / sizeof(internal::SnapshotEntry) < count) 
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& entry = m_entries[i];
+            if (entry.offset > m_segment.size() 
+                || m_segment.size() - entry.offset < sizeof(internal::SnapshotSeq) + entry.size)
+            {
+                return false;
+            }
+        }
+        m_count = count;
+        return true;
+    }
+
+    /**
+     * @brief   Gets the number of published objects.
+     */
+    std::size_t size() const { return m_count; }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the range lies within a published object, else @c false.
+     */
+    bool read(const MemoryRange& range)
+    {
+        auto end = m_entries + m_count;
+        auto it  = std::upper_bound(m_entries, end, static_cast<uint64_t>(range.address),
+            [](uint64_t address, const internal::SnapshotEntry& entry) 
+            { 
+                return address < entry.address; 
+            });
+        if (it == m_entries) return false;
+
+        auto& entry = *(it - 1);
+        auto  offs  = static_cast<uint64_t>(range.address) - entry.address;
+        if (offs > entry.size || entry.size - offs < range.size) return false;
+
+        auto base = static_cast<const uint8_t*>(m_segment.data()) + entry.offset;
+        auto& seq = *reinterpret_cast<const internal::SnapshotSeq*>(base);
+        auto data = base + sizeof(seq) + offs;
+        for (unsigned attempt = 0; attempt < kMaxAttempts; ++attempt)
+        {
+            auto before = seq.load(std::memory_order_acquire);
+            if (!(before & 1))
+            {
+                std::memcpy(range.buffer, data, range.size);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq.load(std::memory_order_relaxed) == before) return true;
+            }
+            if ((attempt & 0xFF) == 0xFF) std::this_thread::yield();
+        }
+        return false;
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges were read, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        bool success = true;
+        for (std::size_t i = 0; i < count; ++i) success &= read(ranges[i]);
+        return success;
+    }
+
+    /**
+     * @brief   Writing is not supported, snapshots are read-only.
+     * @return  @c false.
+     */
+    bool write(const MemoryRange&) { return false; }
+private:
+    platform::SharedMemory m_segment;
+    const internal::SnapshotEntry* m_entries = nullptr;
+    std::size_t m_count = 0;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // ifdef REMODEL_HAS_SHARED_MEMORY
+
+#endif // REMODEL_SHAREDSNAPSHOT_HPP
@@ -0,0 +1,225 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SIGNATURECACHE_HPP
+#define REMODEL_SIGNATURECACHE_HPP
+
+/**     
+ * @file
+ * @brief Contains a persistent cache of resolved pattern addresses.
+ *        
+ * Scanning for signatures on every launch is wasted work while the target module is unchanged.
+ * The cache stores the results of a `PatternBatch` as module relative addresses, keyed by the 
+ * identity of the module (PE timestamp and image size, or ELF build-id) and a hash of the 
+ * patterns. When both match, the batch is populated without scanning.
+ *
+ * @code
+ *      PatternBatch batch;
+ *      auto createIdx = batch.add("40 53 48 83 EC 20 8B D9 E8");
+ *      auto game = Module::getModule("game.dll");
+ *      if (game && resolvePatternsCached(game.value(), batch, "game.sigcache"))
+ *      {
+ *          Function<void*(*)(int)> create{batch.address(createIdx)};
+ *      }
+ * @endcode
+ * 
+ * The file is a fixed-size header followed by one 64-bit RVA per pattern, so it can be read in 
+ * one go (or mapped) and validated by comparing the header and the size.
+ */
+
+#include "Remodel.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Signature cache file format]                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   The header of a signature cache file, followed by `count` `int64_t` RVAs, -1 for
+ *          unresolved patterns. All values are in native byte order.
+ */
+struct SignatureCacheHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t patternsHash;
+    uint32_t identitySize;
+    uint8_t  identity[platform::ModuleIdentity::kMaxSize];
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SignatureCacheHeader) == 64, "unexpected padding");
+
+const char kSignatureCacheMagic[8] = {'R', 'M', 'D', 'L', 'S', 'I', 'G', 'C'};
+
+/**
+ * @internal
+ * @brief   Hashes the patterns of a batch (FNV-1a), so changed patterns invalidate the cache.
+ */
+inline uint64_t hashPatterns(const PatternBatch& batch)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    auto mix = [&](const void* data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<const uint8_t*>(data)[i];
+            hash *= 0x100000001B3;
+        }
+    };
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const auto& pattern = batch.pattern(i);
+        auto size = static_cast<uint32_t>(pattern.size());
+        mix(&size, sizeof(size));
+        mix(pattern.bytes(), pattern.size());
+        mix(pattern.mask(), pattern.size());
+    }
+    return hash;
+}
+
+/**
+ * @internal
+ * @brief   Builds the expected header for a module and batch.
+ * @return  @c true if the module has an identity, else @c false.
+ */
+inline bool makeSignatureCacheHeader(const Module& module, const PatternBatch& batch,
+    SignatureCacheHeader& header)
+{
+    platform::ModuleIdentity identity;
+    if (!platform::obtainModuleIdentity(module.addressOfObj(), identity)) return false;
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kSignatureCacheMagic, sizeof(header.magic));
+    header.version      = SignatureCacheHeader::kVersion;
+    header.count        = static_cast<uint32_t>(batch.size());
+    header.patternsHash = hashPatterns(batch);
+    header.identitySize = static_cast<uint32_t>(identity.size);
+    std::memcpy(header.identity, identity.bytes, identity.size);
+    return true;
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [Signature cache]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Populates a batch from a cache file.
+ * @param   path    The path of the cache file.
+ * @param   module  The module the batch is resolved in.
+ * @param   batch   The batch receiving the results.
+ * @return  @c true on a cache hit, @c false if the file is missing, malformed or was written for
+ *          another build of the module or other patterns. The batch is unchanged on misses.
+ */
+inline bool loadSignatureCache(const char* path, const Module& module, PatternBatch& batch)
+{
+    internal::SignatureCacheHeader expected;
+    if (!internal::makeSignatureCacheHeader(module, batch, expected)) return false;
+
+    auto file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    internal::SignatureCacheHeader header;
+    std::vector<int64_t> rvas(batch.size());
+    bool hit = std::fread(&header, sizeof(header), 1, file) == 1
+        && std::memcmp(&header, &expected, sizeof(header)) == 0
+        && std::fread(rvas.data(), sizeof(int64_t), rvas.size(), file) == rvas.size()
+        && std::fgetc(file) == EOF;
+    std::fclose(file);
+    if (!hit) return false;
+
+    auto base = reinterpret_cast<uintptr_t>(module.addressOfObj());
+    for (std::size_t i = 0; i < rvas.size(); ++i)
+    {
+        batch.setAddress(i, rvas[i] < 0 ? 0 : base + static_cast<uintptr_t>(rvas[i]));
+    }
+    return true;
+}
+
+/**
+ * @brief   Writes the results of a batch to a cache file.
+ * @param   path    The path of the cache file, replaced if existing.
+ * @param   module  The module the batch was resolved in.
+ * @param   batch   The batch.
+ * @return  @c true if written, @c false if the module has no identity or writing failed.
+ */
+inline bool storeSignatureCache(const char* path, const Module& module, const PatternBatch& batch)
+{
+    internal::SignatureCacheHeader header;
+    if (!internal::makeSignatureCacheHeader(module, batch, header)) return false;
+
+    auto base = reinterpret_cast<uintptr_t>(module.addressOfObj());
+    std::vector<int64_t> rvas(batch.size());
+    for (std::size_t i = 0; i < rvas.size(); ++i)
+    {
+        rvas[i] = batch.isResolved(i) ? static_cast<int64_t>(batch.address(i) - base) : -1;
+    }
+
+    auto file = std::fopen(path, "wb");
+    if (!file) return false;
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(rvas.data(), sizeof(int64_t), rvas.size(), file) == rvas.size();
+    written &= std::fclose(file) == 0;
+    return written;
+}
+
+/**
+ * @brief   Resolves a batch in a module, using a cache file if possible.
+ * @param   module      The module.
+ * @param   batch       The batch, receiving the results.
+ * @param   path        The path of the cache file. Created or replaced on cache misses.
+ * @param   threadCount The maximum number of threads to scan with on misses (see 
+ *                      `PatternBatch::scan`).
+ * @return  @c true if all patterns of the batch are resolved, else @c false.
+ */
+inline bool resolvePatternsCached(const Module& module, PatternBatch& batch, const char* path,
+    unsigned threadCount = 1)
+{
+    if (loadSignatureCache(path, module, batch)) return batch.allResolved();
+
+    batch.reset();
+    module.findPatterns(batch, threadCount);
+    storeSignatureCache(path, module, batch);
+    return batch.allResolved();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_SIGNATURECACHE_HPP
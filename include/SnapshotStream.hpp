@@ -0,0 +1,627 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SNAPSHOTSTREAM_HPP
+#define REMODEL_SNAPSHOTSTREAM_HPP
+
+/**     
+ * @file
+ * @brief Contains streaming of wrapped objects to subscribers on other machines.
+ *        
+ * An agent inside the target registers objects with a `SnapshotServer` and calls `publish` 
+ * every tick, which only copies the objects into a queue. A background thread encodes the 
+ * changes since the previous frame like `StateRecorder` does, compresses them and sends them to 
+ * all subscribers over TCP. Viewers use `SnapshotSubscriber` as memory accessor of 
+ * `RemoteInstance`, so the same wrapper definitions work on the received copies.
+ *
+ * @code
+ *      // Agent inside the target.
+ *      SnapshotServer server;
+ *      server.add(player);
+ *      server.listen(7100, "0.0.0.0");
+ *      // ... every tick:
+ *      server.publish(tick);
+ *      
+ *      // Viewer.
+ *      SnapshotSubscriber snapshots;
+ *      if (snapshots.connect("10.0.0.5", 7100))
+ *      {
+ *          RemoteInstance<Player, SnapshotSubscriber> remote{snapshots, playerAddress};
+ *          while (snapshots.poll(100)) if (remote.refresh()) show(remote->health);
+ *      }
+ * @endcode
+ * 
+ * Frames captured between two wakeups of the background thread are sent as a batch. A 
+ * subscriber that falls behind by more than the configured backlog stops receiving deltas and 
+ * is resynchronized with a keyframe once it caught up, so slow viewers never hold back the 
+ * server or other viewers. Frames are dropped (and counted) while the encoder falls behind.
+ *
+ * Every message is a `SnapshotMessageHeader` followed by the message compressed in the LZ4 
+ * block format. Decompressed, the first byte is the `SnapshotMessage` type: directories hold the 
+ * number of objects followed by their address and size, frames use the format of recordings. 
+ */
+
+#include "Recording.hpp"
+#include "Remote.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef REMODEL_HAS_TCP_SOCKETS
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [Stream messages]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The header of a stream message.
+ */
+struct SnapshotMessageHeader
+{
+    uint32_t compressedSize;
+    uint32_t rawSize;
+};
+
+static_assert(sizeof(SnapshotMessageHeader) == 8, "unexpected padding");
+
+/**
+ * @brief   Enumeration of stream message types.
+ */
+enum class SnapshotMessage : uint8_t
+{
+    /// The addresses and sizes of the objects, sent before the first keyframe.
+    Directory,
+    /// A keyframe or the changes since the previous frame.
+    Frame,
+};
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Compresses a message and appends it, with its header.
+ * @param   out     The output.
+ * @param   raw     The message.
+ * @param   table   Scratch space of `kLzHashSize` entries.
+ */
+inline void appendSnapshotMessage(std::vector<uint8_t>& out, const std::vector<uint8_t>& raw, 
+    uint32_t* table)
+{
+    auto mark = out.size();
+    out.resize(mark + sizeof(SnapshotMessageHeader) + lzBound(raw.size()));
+    SnapshotMessageHeader header;
+    header.compressedSize = static_cast<uint32_t>(lzCompress(raw.data(), raw.size(), 
+        out.data() + mark + sizeof(header), table));
+    header.rawSize = static_cast<uint32_t>(raw.size());
+    std::memcpy(out.data() + mark, &header, sizeof(header));
+    out.resize(mark + sizeof(header) + header.compressedSize);
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [SnapshotServer]                                                                               //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Streams changes of local objects to `SnapshotSubscriber`s.
+ *          
+ * Objects are registered before `listen`. `publish` is called from a single thread and never 
+ * blocks.
+ */
+class SnapshotServer
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   queueDepth  The number of frames published ahead of the encoder.
+     * @param   maxBacklog  The number of unsent bytes after which a subscriber is resynchronized.
+     * @param   interval    The time between wakeups of the background thread.
+     */
+    explicit SnapshotServer(std::size_t queueDepth = 8, std::size_t maxBacklog = 1 << 20,
+        std::chrono::milliseconds interval = std::chrono::milliseconds{5})
+        : m_queueDepth{queueDepth}
+        , m_maxBacklog{maxBacklog}
+        , m_interval{interval}
+    {}
+
+    SnapshotServer(const SnapshotServer&) = delete;
+    SnapshotServer& operator = (const SnapshotServer&) = delete;
+
+    /**
+     * @brief   Destructor, stopping the server.
+     */
+    ~SnapshotServer() { stop(); }
+
+    /**
+     * @brief   Registers an object, before `listen`.
+     * @param   object  The object.
+     * @param   size    The size of the object, in bytes.
+     */
+    void add(const void* object, std::size_t size)
+    {
+        m_objects.push_back(static_cast<const uint8_t*>(object));
+        m_sizes.push_back(size);
+    }
+
+    /**
+     * @brief   Registers the object a wrapper points to, before `listen`.
+     * @param   wrapper The wrapper, derived from `AdvancedClassWrapper`.
+     */
+    template<typename WrapperT>
+    void add(const WrapperT& wrapper)
+    {
+        add(wrapper.addressOfObj(), WrapperT::kObjSize);
+    }
+
+    /**
+     * @brief   Listens for subscribers and starts the background thread.
+     * @param   port    The port, zero for any free port.
+     * @param   host    The dotted IPv4 address of the interface to listen on.
+     * @return  @c true on success, else @c false.
+     */
+    bool listen(uint16_t port, const char* host = "127.0.0.1")
+    {
+        if (m_thread.joinable() || !m_listener.listen(host, port)) return false;
+
+        m_directory.assign(1, static_cast<uint8_t>(SnapshotMessage::Directory));
+        internal::putVarint(m_directory, m_objects.size());
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            internal::putVarint(m_directory, reinterpret_cast<uintptr_t>(m_objects[i]));
+            internal::putVarint(m_directory, m_sizes[i]);
+        }
+        m_encoder.reset(m_sizes);
+        m_queue.reset(m_queueDepth, m_encoder.frameSize());
+        m_table.resize(internal::kLzHashSize);
+        m_stop = false;
+        m_thread = std::thread{[this] { run(); }};
+        m_publishing.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief   Gets the port listened on.
+     */
+    uint16_t port() const { return m_listener.localPort(); }
+
+    /**
+     * @brief   Captures the registered objects for sending.
+     * @param   tick    The tick (or time) of the frame, sent with it.
+     * @return  @c true if queued, @c false if dropped or not listening.
+     */
+    bool publish(uint64_t tick)
+    {
+        if (!m_publishing.load(std::memory_order_acquire)) return false;
+
+        auto slot = m_queue.acquire();
+        if (!slot)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            std::memcpy(slot, m_objects[i], m_sizes[i]);
+            slot += m_sizes[i];
+        }
+        m_queue.commit(tick);
+        return true;
+    }
+
+    /**
+     * @brief   Stops the background thread and disconnects all subscribers.
+     */
+    void stop()
+    {
+        m_publishing.store(false, std::memory_order_release);
+        if (m_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_stop = true;
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+        }
+        m_subscribers.clear();
+        m_subscriberCount.store(0, std::memory_order_relaxed);
+        m_listener.close();
+    }
+
+    /**
+     * @brief   Gets the number of connected subscribers.
+     */
+    std::size_t subscribers() const { return m_subscriberCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the number of frames dropped because the queue was full.
+     */
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief   Gets the number of times subscribers fell behind and had to be resynchronized.
+     */
+    uint64_t resyncs() const { return m_resyncs.load(std::memory_order_relaxed); }
+private:
+    struct Subscriber
+    {
+        platform::TcpSocket  socket;
+        std::vector<uint8_t> pending;
+        std::size_t          sent       = 0;
+        bool                 introduced = false;
+        bool                 synced     = false;
+
+        std::size_t backlog() const { return pending.size() - sent; }
+    };
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        while (!m_stop)
+        {
+            m_wakeup.wait_for(lock, m_interval, [this] { return m_stop; });
+            lock.unlock();
+            acceptSubscribers();
+            sendFrames();
+            syncSubscribers();
+            flush();
+            lock.lock();
+        }
+    }
+
+    void acceptSubscribers()
+    {
+        Subscriber subscriber;
+        while (m_listener.accept(subscriber.socket))
+        {
+            m_subscribers.push_back(std::move(subscriber));
+            subscriber = Subscriber{};
+        }
+        m_subscriberCount.store(m_subscribers.size(), std::memory_order_relaxed);
+    }
+
+    void sendFrames()
+    {
+        m_queue.consume([this](const uint8_t* frame, uint64_t tick)
+        {
+            m_message.assign(1, static_cast<uint8_t>(SnapshotMessage::Frame));
+            const auto& raw = m_encoder.encode(frame, tick, false);
+            m_message.insert(m_message.end(), raw.begin(), raw.end());
+            m_packed.clear();
+            internal::appendSnapshotMessage(m_packed, m_message, m_table.data());
+            m_lastTick = tick;
+            m_hasState = true;
+
+            for (auto& subscriber : m_subscribers)
+            {
+                if (!subscriber.synced) continue;
+                if (subscriber.backlog() > m_maxBacklog)
+                {
+                    subscriber.synced = false;
+                    m_resyncs.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                subscriber.pending.insert(subscriber.pending.end(), m_packed.begin(), 
+                    m_packed.end());
+            }
+        });
+    }
+
+    void syncSubscribers()
+    {
+        if (!m_hasState) return;
+
+        bool encoded = false;
+        for (auto& subscriber : m_subscribers)
+        {
+            if (subscriber.synced || subscriber.backlog() > m_maxBacklog) continue;
+            if (!subscriber.introduced)
+            {
+                internal::appendSnapshotMessage(subscriber.pending, m_directory, m_table.data());
+                subscriber.introduced = true;
+            }
+            if (!encoded)
+            {
+                m_message.assign(1, static_cast<uint8_t>(SnapshotMessage::Frame));
+                const auto& raw = m_encoder.encode(m_encoder.previous(), m_lastTick, true);
+                m_message.insert(m_message.end(), raw.begin(), raw.end());
+                m_packed.clear();
+                internal::appendSnapshotMessage(m_packed, m_message, m_table.data());
+                encoded = true;
+            }
+            subscriber.pending.insert(subscriber.pending.end(), m_packed.begin(), m_packed.end());
+            subscriber.synced = true;
+        }
+    }
+
+    void flush()
+    {
+        for (auto it = m_subscribers.begin(); it != m_subscribers.end();)
+        {
+            auto& subscriber = *it;
+            if (subscriber.backlog())
+            {
+                auto sent = subscriber.socket.send(subscriber.pending.data() + subscriber.sent, 
+                    subscriber.backlog());
+                if (sent < 0)
+                {
+                    it = m_subscribers.erase(it);
+                    continue;
+                }
+                subscriber.sent += static_cast<std::size_t>(sent);
+                if (!subscriber.backlog())
+                {
+                    subscriber.pending.clear();
+                    subscriber.sent = 0;
+                }
+            }
+            ++it;
+        }
+        m_subscriberCount.store(m_subscribers.size(), std::memory_order_relaxed);
+    }
+private:
+    std::size_t m_queueDepth;
+    std::size_t m_maxBacklog;
+    std::chrono::milliseconds m_interval;
+    std::vector<const uint8_t*> m_objects;
+    std::vector<std::size_t> m_sizes;
+    std::atomic<bool> m_publishing{false};
+    std::atomic<uint64_t> m_dropped{0};
+    internal::FrameQueue m_queue;
+
+    // Used by the background thread.
+    platform::TcpSocket m_listener;
+    std::vector<Subscriber> m_subscribers;
+    internal::FrameEncoder m_encoder;
+    std::vector<uint8_t> m_directory;
+    std::vector<uint8_t> m_message;
+    std::vector<uint8_t> m_packed;
+    std::vector<uint32_t> m_table;
+    uint64_t m_lastTick = 0;
+    bool m_hasState = false;
+    std::atomic<std::size_t> m_subscriberCount{0};
+    std::atomic<uint64_t> m_resyncs{0};
+
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::thread m_thread;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [SnapshotSubscriber]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Receives objects from a `SnapshotServer`, serving reads as a memory accessor.
+ *          
+ * A read succeeds once the first keyframe arrived, if it lies within a single object. Received
+ * messages are applied by `poll`, which isn't thread-safe with respect to reads.
+ */
+class SnapshotSubscriber
+{
+public:
+    /// The maximum size of a decompressed message.
+    static const uint32_t kMaxMessageSize = 1u << 30;
+
+    /**
+     * @brief   Connects to a server.
+     * @param   host    The dotted IPv4 address of the server.
+     * @param   port    The port.
+     * @return  @c true on success, else @c false.
+     */
+    bool connect(const char* host, uint16_t port)
+    {
+        close();
+        return m_socket.connect(host, port);
+    }
+
+    /**
+     * @brief   Disconnects, discarding all objects.
+     */
+    void close()
+    {
+        m_socket.close();
+        m_input.clear();
+        m_entries.clear();
+        m_decoder.reset({});
+        m_synced = false;
+    }
+
+    /**
+     * @brief   Applies the messages received so far.
+     * @param   timeoutMs   The maximum time to wait for a message if none was received yet.
+     * @return  @c true while connected, @c false once the connection was closed or on protocol 
+     *          errors.
+     */
+    bool poll(int timeoutMs = 0)
+    {
+        if (!m_socket.isOpen()) return false;
+        if (timeoutMs > 0) m_socket.waitReadable(timeoutMs);
+
+        uint8_t buffer[64 * 1024];
+        for (;;)
+        {
+            auto received = m_socket.receive(buffer, sizeof(buffer));
+            if (received < 0)
+            {
+                m_socket.close();
+                break;
+            }
+            if (!received) break;
+            m_input.insert(m_input.end(), buffer, buffer + received);
+        }
+
+        std::size_t pos = 0;
+        SnapshotMessageHeader header;
+        while (m_input.size() - pos >= sizeof(header))
+        {
+            std::memcpy(&header, m_input.data() + pos, sizeof(header));
+            if (m_input.size() - pos - sizeof(header) < header.compressedSize) break;
+            if (header.rawSize == 0 || header.rawSize > kMaxMessageSize
+                || !apply(m_input.data() + pos + sizeof(header), header))
+            {
+                close();
+                return false;
+            }
+            pos += sizeof(header) + header.compressedSize;
+        }
+        m_input.erase(m_input.begin(), m_input.begin() + static_cast<std::ptrdiff_t>(pos));
+        return m_socket.isOpen();
+    }
+
+    /**
+     * @brief   Determines whether the objects were received in full.
+     */
+    bool isSynced() const { return m_synced; }
+
+    /**
+     * @brief   Gets the tick of the most recent frame.
+     */
+    uint64_t tick() const { return m_decoder.tick(); }
+
+    /**
+     * @brief   Gets the number of objects sent by the server.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange&)
+     * @return  @c true if the range lies within a received object, else @c false.
+     */
+    bool read(const MemoryRange& range)
+    {
+        if (!m_synced) return false;
+        auto it = std::upper_bound(m_entries.begin(), m_entries.end(), 
+            static_cast<uint64_t>(range.address), [](uint64_t address, const Entry& entry) 
+            { 
+                return address < entry.address; 
+            });
+        if (it == m_entries.begin()) return false;
+
+        auto& entry = *(it - 1);
+        auto  offs  = static_cast<uint64_t>(range.address) - entry.address;
+        auto  size  = m_decoder.objectSize(entry.index);
+        if (offs > size || size - offs < range.size) return false;
+        std::memcpy(range.buffer, m_decoder.object(entry.index) + offs, range.size);
+        return true;
+    }
+
+    /**
+     * @copydoc LocalMemoryAccessor::read(const MemoryRange*, std::size_t)
+     * @return  @c true if all ranges were read, else @c false.
+     */
+    bool read(const MemoryRange* ranges, std::size_t count)
+    {
+        bool success = true;
+        for (std::size_t i = 0; i < count; ++i) success &= read(ranges[i]);
+        return success;
+    }
+
+    /**
+     * @brief   Writing is not supported, snapshots are read-only.
+     * @return  @c false.
+     */
+    bool write(const MemoryRange&) { return false; }
+private:
+    struct Entry
+    {
+        uint64_t    address;
+        std::size_t index;
+    };
+
+    bool apply(const uint8_t* packed, const SnapshotMessageHeader& header)
+    {
+        m_raw.resize(header.rawSize);
+        if (!internal::lzDecompress(packed, header.compressedSize, m_raw.data(), m_raw.size()))
+        {
+            return false;
+        }
+
+        const uint8_t* cur = m_raw.data() + 1;
+        const uint8_t* end = m_raw.data() + m_raw.size();
+        switch (static_cast<SnapshotMessage>(m_raw[0]))
+        {
+            case SnapshotMessage::Directory:
+            {
+                uint64_t count, address, size;
+                if (!internal::getVarint(cur, end, count) 
+                    || count > static_cast<uint64_t>(end - cur)) 
+                {
+                    return false;
+                }
+                std::vector<std::size_t> sizes;
+                m_entries.clear();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (!internal::getVarint(cur, end, address) 
+                        || !internal::getVarint(cur, end, size) || size > kMaxMessageSize) 
+                    {
+                        return false;
+                    }
+                    m_entries.push_back(Entry{address, i});
+                    sizes.push_back(static_cast<std::size_t>(size));
+                }
+                std::sort(m_entries.begin(), m_entries.end(), 
+                    [](const Entry& a, const Entry& b) { return a.address < b.address; });
+                m_decoder.reset(sizes);
+                m_synced = false;
+                return true;
+            }
+            case SnapshotMessage::Frame:
+                if (!m_decoder.apply(cur, end)) return false;
+                m_synced |= m_decoder.isKeyframe();
+                return true;
+            default:
+                return false;
+        }
+    }
+private:
+    platform::TcpSocket m_socket;
+    std::vector<uint8_t> m_input;
+    std::vector<uint8_t> m_raw;
+    std::vector<Entry> m_entries;
+    internal::FrameDecoder m_decoder;
+    bool m_synced = false;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // ifdef REMODEL_HAS_TCP_SOCKETS
+
+#endif // REMODEL_SNAPSHOTSTREAM_HPP
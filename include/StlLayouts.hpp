@@ -0,0 +1,697 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_STLLAYOUTS_HPP
+#define REMODEL_STLLAYOUTS_HPP
+
+/**
+ * @file
+ * @brief Contains read-only views over standard containers laid out by the target's STL.
+ *
+ * Objects of the wrapped program often embed `std::vector`, `std::string` or
+ * `std::unordered_map` of its own standard library, which is not necessarily ours, so they can't
+ * be accessed by casting to our types. The types in this file mirror the memory layout of the
+ * major implementations instead and can be used as `Field` types. They never allocate nor copy
+ * the contents, lookups in hash maps walk the bucket array of the target directly.
+ *
+ * @code
+ *      class Guild : public AdvancedClassWrapper<0x80>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Guild)
+ *      public:
+ *          Field<RemoteString<StlAbi::Msvc>>                           name   {this, 0x08};
+ *          Field<RemoteVector<Player, StlAbi::Msvc>>                   members{this, 0x28};
+ *          Field<RemoteHashMap<uint32_t, int32_t, StlAbi::Msvc>>       ranks  {this, 0x40};
+ *      };
+ *
+ *      if (auto rank = guild.ranks->find(playerId)) ...
+ *      for (auto& player : guild.members->view()) ...
+ * @endcode
+ *
+ * The layouts are those of release builds: MSVC's STL of Visual Studio 2017 and later without
+ * iterator debugging, and libstdc++ with the C++11 ABI (GCC 5 and later). The containers have
+ * to live in the current address space.
+ */
+
+#include "Remodel.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [StlAbi]                                                                                       //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Enumeration of supported standard library implementations.
+ */
+enum class StlAbi
+{
+    /// Microsoft's STL as shipped with Visual Studio 2017 and later.
+    Msvc,
+    /// GNU libstdc++, using the C++11 ABI.
+    Libstdcxx,
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [RemoteVector]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Read-only view over a `std::vector` of the target.
+ * @tparam  T       The type of the elements. Wrapper types are rewritten to their `WeakWrapper`
+ *                  type, just like with `Field`.
+ * @tparam  abiT    The standard library of the target.
+ *
+ * Both supported libraries lay out vectors as three pointers: first element, end of elements and
+ * end of storage. The view doesn't modify the vector itself, its elements are however accessible
+ * for writing, just like with `ArrayView`.
+ */
+template<typename T, StlAbi abiT>
+class RemoteVector
+{
+    static_assert(!std::is_same<std::remove_cv_t<T>, bool>::value,
+        "std::vector<bool> is bit-packed and not supported");
+public:
+    using ElementT = internal::RewriteWrappers<T>;
+
+    /**
+     * @brief   Gets a pointer to the first element.
+     * @return  The pointer, @c nullptr for vectors that never held elements.
+     */
+    ElementT* data() const { return m_first; }
+
+    /**
+     * @brief   Gets the number of elements.
+     * @return  The number of elements.
+     */
+    std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+
+    /**
+     * @brief   Gets the number of elements the vector has allocated storage for.
+     * @return  The capacity.
+     */
+    std::size_t capacity() const { return static_cast<std::size_t>(m_end - m_first); }
+
+    /**
+     * @brief   Determines whether the vector is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return m_first == m_last; }
+
+    /**
+     * @brief   Creates a view over the elements.
+     * @return  The view.
+     */
+    ArrayView<ElementT> view() const { return {m_first, size()}; }
+
+    ElementT* begin() const { return m_first; }
+    ElementT* end() const { return m_last; }
+
+    /**
+     * @brief   Accesses an element.
+     * @param   idx The index of the element, less than `size()`.
+     * @return  A reference to the element.
+     */
+    ElementT& operator [] (std::size_t idx) const { return m_first[idx]; }
+private:
+    ElementT* m_first;
+    ElementT* m_last;
+    ElementT* m_end;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [RemoteString]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Memory layout of `std::basic_string`.
+ * @tparam  CharT   The character type.
+ * @tparam  abiT    The standard library of the target.
+ */
+template<typename CharT, StlAbi abiT>
+struct StringLayout;
+
+/**
+ * @internal
+ * @brief   Memory layout of `std::basic_string` in MSVC's STL.
+ *
+ * Short strings are stored in a buffer overlapping the heap pointer, which one is in use is
+ * determined by the capacity.
+ */
+template<typename CharT>
+struct StringLayout<CharT, StlAbi::Msvc>
+{
+    static const std::size_t kBufSize = 16 / sizeof(CharT) < 1 ? 1 : 16 / sizeof(CharT);
+
+    union
+    {
+        CharT  buf[kBufSize];
+        CharT* ptr;
+    } bx;
+    std::size_t size;
+    std::size_t res;
+
+    const CharT* data() const { return res < kBufSize ? bx.buf : bx.ptr; }
+    std::size_t length() const { return size; }
+};
+
+/**
+ * @internal
+ * @brief   Memory layout of `std::basic_string` in libstdc++.
+ *
+ * The data pointer always points to the characters, for short strings to the local buffer.
+ */
+template<typename CharT>
+struct StringLayout<CharT, StlAbi::Libstdcxx>
+{
+    CharT* ptr;
+    std::size_t len;
+    union
+    {
+        CharT       local[15 / sizeof(CharT) + 1];
+        std::size_t capacity;
+    } storage;
+
+    const CharT* data() const { return ptr; }
+    std::size_t length() const { return len; }
+};
+
+} // namespace internal
+
+/**
+ * @brief   Read-only view over a `std::basic_string` of the target.
+ * @tparam  abiT    The standard library of the target.
+ * @tparam  CharT   The character type.
+ */
+template<StlAbi abiT, typename CharT = char>
+class RemoteString
+{
+public:
+    /**
+     * @brief   Gets a pointer to the characters.
+     * @return  The pointer to the null-terminated characters.
+     */
+    const CharT* data() const { return m_layout.data(); }
+
+    /**
+     * @brief   Gets the number of characters, excluding the terminator.
+     * @return  The number of characters.
+     */
+    std::size_t size() const { return m_layout.length(); }
+
+    /**
+     * @brief   Determines whether the string is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !size(); }
+
+    /**
+     * @brief   Creates a view over the characters.
+     * @return  The view, excluding the terminator.
+     */
+    ArrayView<const CharT> view() const { return {data(), size()}; }
+
+    /**
+     * @brief   Copies the characters into a string of our own standard library.
+     * @return  The copy.
+     */
+    std::basic_string<CharT> str() const { return {data(), size()}; }
+
+    /**
+     * @brief   Compares the characters with a character array.
+     * @param   chars   The characters to compare with.
+     * @param   count   The number of characters.
+     * @return  @c true if equal, else @c false.
+     */
+    bool equals(const CharT* chars, std::size_t count) const
+    {
+        return size() == count && !std::memcmp(data(), chars, count * sizeof(CharT));
+    }
+
+    bool operator == (const std::basic_string<CharT>& rhs) const
+    {
+        return equals(rhs.data(), rhs.size());
+    }
+
+    bool operator == (const RemoteString& rhs) const { return equals(rhs.data(), rhs.size()); }
+    bool operator == (const CharT* rhs) const
+    {
+        return equals(rhs, std::char_traits<CharT>::length(rhs));
+    }
+
+    template<typename RhsT>
+    bool operator != (const RhsT& rhs) const { return !(*this == rhs); }
+private:
+    internal::StringLayout<CharT, abiT> m_layout;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [StlHash]                                                                                      //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Hashes bytes the way `std::hash` of MSVC's STL does (FNV-1a).
+ * @param   data    The bytes.
+ * @param   size    The number of bytes.
+ * @return  The hash.
+ */
+inline std::size_t fnv1aHash(const void* data, std::size_t size)
+{
+#   if SIZE_MAX > UINT32_MAX
+        const std::size_t kOffsetBasis = 14695981039346656037ULL;
+        const std::size_t kPrime       = 1099511628211ULL;
+#   else
+        const std::size_t kOffsetBasis = 2166136261U;
+        const std::size_t kPrime       = 16777619U;
+#   endif
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    auto hash  = kOffsetBasis;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= kPrime;
+    }
+    return hash;
+}
+
+/**
+ * @internal
+ * @brief   Hashes bytes the way `std::hash` of libstdc++ does (`std::_Hash_bytes`, a variant of
+ *          MurmurHash2).
+ * @param   data    The bytes.
+ * @param   size    The number of bytes.
+ * @param   seed    The seed.
+ * @return  The hash.
+ */
+inline std::size_t murmur2Hash(const void* data, std::size_t size, std::size_t seed = 0xC70F6907)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+#   if SIZE_MAX > UINT32_MAX
+        const std::size_t kMul = (std::size_t{0xC6A4A793} << 32) + 0x5BD1E995;
+        auto shiftMix = [](std::size_t v) { return v ^ (v >> 47); };
+
+        auto alignedSize = size & ~std::size_t{7};
+        auto hash = seed ^ (size * kMul);
+        for (std::size_t i = 0; i < alignedSize; i += 8)
+        {
+            std::size_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            hash ^= shiftMix(word * kMul) * kMul;
+            hash *= kMul;
+        }
+        if (size & 7)
+        {
+            std::size_t word = 0;
+            for (auto i = size; i-- > alignedSize; ) word = (word << 8) + bytes[i];
+            hash ^= word;
+            hash *= kMul;
+        }
+        hash = shiftMix(hash) * kMul;
+        return shiftMix(hash);
+#   else
+        const std::size_t kMul = 0x5BD1E995;
+
+        auto hash = seed ^ size;
+        for (; size >= 4; bytes += 4, size -= 4)
+        {
+            std::size_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            word *= kMul;
+            word ^= word >> 24;
+            word *= kMul;
+            hash *= kMul;
+            hash ^= word;
+        }
+        switch (size)
+        {
+            case 3: hash ^= std::size_t{bytes[2]} << 16; // fall through
+            case 2: hash ^= std::size_t{bytes[1]} << 8;  // fall through
+            case 1: hash ^= bytes[0]; hash *= kMul;
+        }
+        hash ^= hash >> 13;
+        hash *= kMul;
+        return hash ^ (hash >> 15);
+#   endif
+}
+
+/**
+ * @internal
+ * @brief   Hashes bytes the way `std::hash` of a standard library does for strings.
+ */
+template<StlAbi abiT>
+inline std::size_t stlHashBytes(const void* data, std::size_t size)
+{
+    return abiT == StlAbi::Msvc ? fnv1aHash(data, size) : murmur2Hash(data, size);
+}
+
+/**
+ * @internal
+ * @brief   Determines whether libstdc++ caches the hash codes of keys in the nodes by default,
+ *          which it does for hash functions it doesn't consider fast, i.e. the string ones.
+ */
+template<typename KeyT>
+struct LibstdcxxCachesHash : std::false_type {};
+
+template<StlAbi abiT, typename CharT>
+struct LibstdcxxCachesHash<RemoteString<abiT, CharT>> : std::true_type {};
+
+} // namespace internal
+
+/**
+ * @brief   Hash function object computing the same hashes as `std::hash` of the target's
+ *          standard library.
+ * @tparam  abiT    The standard library of the target.
+ *
+ * Supports integral, enumeration and pointer keys as well as strings, in the form of
+ * `std::basic_string` and `RemoteString`.
+ */
+template<StlAbi abiT>
+struct StlHash
+{
+    template<typename T>
+    std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value
+        || std::is_pointer<T>::value, std::size_t>
+    operator () (const T& key) const
+    {
+        return abiT == StlAbi::Msvc ? internal::fnv1aHash(&key, sizeof(key)) : toSize(key);
+    }
+
+    template<typename CharT>
+    std::size_t operator () (const std::basic_string<CharT>& key) const
+    {
+        return internal::stlHashBytes<abiT>(key.data(), key.size() * sizeof(CharT));
+    }
+
+    template<typename CharT>
+    std::size_t operator () (const RemoteString<abiT, CharT>& key) const
+    {
+        return internal::stlHashBytes<abiT>(key.data(), key.size() * sizeof(CharT));
+    }
+private:
+    template<typename T>
+    static std::enable_if_t<std::is_integral<T>::value, std::size_t> toSize(T key)
+    {
+        return static_cast<std::size_t>(key);
+    }
+
+    template<typename T>
+    static std::enable_if_t<std::is_enum<T>::value, std::size_t> toSize(T key)
+    {
+        return static_cast<std::size_t>(static_cast<std::underlying_type_t<T>>(key));
+    }
+
+    template<typename T>
+    static std::size_t toSize(T* key) { return reinterpret_cast<std::size_t>(key); }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [RemoteHashMap]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Memory layout of the `std::pair<const KeyT, MappedT>` values of maps.
+ */
+template<typename KeyT, typename MappedT>
+struct StlPair
+{
+    KeyT    first;
+    MappedT second;
+};
+
+/**
+ * @internal
+ * @brief   Memory layout and lookup of `std::unordered_map`.
+ * @tparam  KeyT        The type of the keys.
+ * @tparam  MappedT     The type of the mapped values.
+ * @tparam  abiT        The standard library of the target.
+ * @tparam  cachedHashT Whether libstdc++ stores the hash codes in the nodes.
+ */
+template<typename KeyT, typename MappedT, StlAbi abiT, bool cachedHashT>
+struct HashMapLayout;
+
+/**
+ * @internal
+ * @brief   Memory layout of `std::unordered_map` in MSVC's STL.
+ *
+ * All elements are kept in a doubly linked list with a sentinel head. Each bucket is a pair of
+ * list iterators to its first and last element, both pointing to the head for empty buckets.
+ */
+template<typename KeyT, typename MappedT, bool cachedHashT>
+struct HashMapLayout<KeyT, MappedT, StlAbi::Msvc, cachedHashT>
+{
+    struct Node
+    {
+        Node*                      next;
+        Node*                      prev;
+        StlPair<KeyT, MappedT>     value;
+    };
+
+    float       maxBucketSize;
+    Node*       head;
+    std::size_t size;
+    Node**      bucketsFirst;
+    Node**      bucketsLast;
+    Node**      bucketsEnd;
+    std::size_t mask;
+    std::size_t maxIdx;
+
+    std::size_t count() const { return size; }
+    std::size_t bucketCount() const
+    {
+        return static_cast<std::size_t>(bucketsLast - bucketsFirst) / 2;
+    }
+
+    template<typename LookupT, typename HashT>
+    MappedT* find(const LookupT& key, const HashT& hasher) const
+    {
+        if (!bucketsFirst) return nullptr;
+
+        auto bucket = (hasher(key) & mask) * 2;
+        auto node   = bucketsFirst[bucket];
+        auto last   = bucketsFirst[bucket + 1];
+        if (node == head) return nullptr;
+
+        for (;; node = node->next)
+        {
+            if (node->value.first == key) return &node->value.second;
+            if (node == last) return nullptr;
+        }
+    }
+
+    template<typename FuncT>
+    void forEach(FuncT func) const
+    {
+        for (auto node = head->next; node != head; node = node->next)
+        {
+            func(static_cast<const KeyT&>(node->value.first), node->value.second);
+        }
+    }
+};
+
+/**
+ * @internal
+ * @brief   Memory layout of `std::unordered_map` in libstdc++.
+ *
+ * All elements are kept in a singly linked list starting at a node embedded in the table. Each
+ * bucket points to the node preceding its first element, the elements of a bucket are adjacent
+ * in the list.
+ */
+template<typename KeyT, typename MappedT, bool cachedHashT>
+struct HashMapLayout<KeyT, MappedT, StlAbi::Libstdcxx, cachedHashT>
+{
+    struct NodeBase
+    {
+        NodeBase* next;
+    };
+
+    struct PlainNode : NodeBase
+    {
+        StlPair<KeyT, MappedT> value;
+    };
+
+    struct CachingNode : NodeBase
+    {
+        StlPair<KeyT, MappedT> value;
+        std::size_t            hash;
+    };
+
+    using Node = std::conditional_t<cachedHashT, CachingNode, PlainNode>;
+
+    NodeBase**  buckets;
+    std::size_t numBuckets;
+    NodeBase    beforeBegin;
+    std::size_t elementCount;
+    float       maxLoadFactor;
+    std::size_t nextResize;
+    NodeBase*   singleBucket;
+
+    std::size_t count() const { return elementCount; }
+    std::size_t bucketCount() const { return numBuckets; }
+
+    template<typename LookupT, typename HashT>
+    MappedT* find(const LookupT& key, const HashT& hasher) const
+    {
+        if (!numBuckets) return nullptr;
+
+        auto hash   = hasher(key);
+        auto bucket = hash % numBuckets;
+        auto prev   = buckets[bucket];
+        if (!prev) return nullptr;
+
+        for (auto node = static_cast<Node*>(prev->next); node; )
+        {
+            if (hashMatches(node, hash) && node->value.first == key) return &node->value.second;
+
+            node = static_cast<Node*>(node->next);
+            if (node && bucketOf(node, hasher) != bucket) return nullptr;
+        }
+        return nullptr;
+    }
+
+    template<typename FuncT>
+    void forEach(FuncT func) const
+    {
+        for (auto node = static_cast<Node*>(beforeBegin.next); node; 
+            node = static_cast<Node*>(node->next))
+        {
+            func(static_cast<const KeyT&>(node->value.first), node->value.second);
+        }
+    }
+private:
+    static bool hashMatches(const CachingNode* node, std::size_t hash)
+    {
+        return node->hash == hash;
+    }
+
+    static bool hashMatches(const PlainNode* /*node*/, std::size_t /*hash*/) { return true; }
+
+    template<typename HashT>
+    std::size_t bucketOf(const CachingNode* node, const HashT& /*hasher*/) const
+    {
+        return node->hash % numBuckets;
+    }
+
+    template<typename HashT>
+    std::size_t bucketOf(const PlainNode* node, const HashT& hasher) const
+    {
+        return hasher(node->value.first) % numBuckets;
+    }
+};
+
+} // namespace internal
+
+/**
+ * @brief   Read-only view over a `std::unordered_map` of the target.
+ * @tparam  KeyT        The type of the keys.
+ * @tparam  MappedT     The type of the mapped values. Wrapper types are rewritten to their
+ *                      `WeakWrapper` type, just like with `Field`.
+ * @tparam  abiT        The standard library of the target.
+ * @tparam  HashT       Function object computing the hashes of the target's hash function,
+ *                      required to match it exactly for lookups to succeed.
+ * @tparam  cachedHashT Whether libstdc++ stores the hash codes in the nodes, which it does by
+ *                      default for string keys only. Ignored for MSVC.
+ *
+ * `find` hashes the key and walks only the matching bucket of the target's table, nothing is
+ * copied out. Keys are compared using `==`, lookups can thus use any type comparable with
+ * `KeyT` and supported by `HashT`, like `std::string` for `RemoteString` keys.
+ */
+template<typename KeyT, typename MappedT, StlAbi abiT, typename HashT = StlHash<abiT>,
+    bool cachedHashT = internal::LibstdcxxCachesHash<KeyT>::value>
+class RemoteHashMap
+{
+public:
+    using MappedRewrittenT = internal::RewriteWrappers<MappedT>;
+private:
+    using Layout = internal::HashMapLayout<KeyT, MappedRewrittenT, abiT, cachedHashT>;
+public:
+    /**
+     * @brief   Gets the number of elements.
+     * @return  The number of elements.
+     */
+    std::size_t size() const { return m_layout.count(); }
+
+    /**
+     * @brief   Determines whether the map is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !size(); }
+
+    /**
+     * @brief   Gets the number of buckets.
+     * @return  The number of buckets.
+     */
+    std::size_t bucketCount() const { return m_layout.bucketCount(); }
+
+    /**
+     * @brief   Looks up the value mapped to a key.
+     * @tparam  LookupT The type of the key, comparable with `KeyT` and hashable by `HashT`.
+     * @param   key     The key.
+     * @param   hasher  The hash function object.
+     * @return  A pointer to the mapped value, @c nullptr if the key is not present.
+     */
+    template<typename LookupT>
+    MappedRewrittenT* find(const LookupT& key, const HashT& hasher = HashT{}) const
+    {
+        return m_layout.find(key, hasher);
+    }
+
+    /**
+     * @brief   Determines whether a key is present.
+     * @param   key The key.
+     * @return  @c true if present, else @c false.
+     */
+    template<typename LookupT>
+    bool contains(const LookupT& key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief   Invokes a function for every element, in the iteration order of the target.
+     * @param   func    The function, invoked with the key and a reference to the mapped value.
+     */
+    template<typename FuncT>
+    void forEach(FuncT func) const { m_layout.forEach(func); }
+private:
+    Layout m_layout;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_STLLAYOUTS_HPP
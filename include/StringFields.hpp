@@ -0,0 +1,473 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_STRINGFIELDS_HPP
+#define REMODEL_STRINGFIELDS_HPP
+
+/**
+ * @file
+ * @brief Contains views over fixed character arrays and pointer and length strings.
+ *
+ * Names and labels of the wrapped program are commonly stored as fixed size, null-terminated
+ * character arrays or as a pointer and a length, in 8 or 16 bit characters. The types in this
+ * file mirror these layouts and can be used as `Field` types, measuring the characters with SIMD
+ * instead of a `strlen` that may run past the array and converting UTF-16 to UTF-8 in a single
+ * pass.
+ *
+ * @code
+ *      class Entity : public AdvancedClassWrapper<0xA0>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Entity)
+ *      public:
+ *          Field<FixedString<char, 64>>            name {this, 0x08};
+ *          Field<FixedString<char16_t, 16>>        title{this, 0x48};
+ *          Field<CountedString<char16_t, uint32_t>> guild{this, 0x68};
+ *      };
+ *
+ *      std::string name  = entity.name->str();
+ *      std::string title = entity.title->utf8();
+ * @endcode
+ *
+ * Existing `Field<char[64]>` declarations can be switched to `Field<FixedString<char, 64>>`,
+ * which has the same layout, or measured in place using `boundedView`.
+ */
+
+#include "Remodel.hpp"
+
+#include <cstring>
+#include <string>
+
+#if defined(ZYCORE_MSVC)
+#   include <intrin.h>
+#endif
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define REMODEL_STRING_AVX2
+#   define REMODEL_STRING_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define REMODEL_STRING_SSE2
+#endif
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [boundedLength]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Gets the index of the lowest set bit of a non-zero comparison mask.
+ */
+inline unsigned lowestMaskBit(uint32_t mask)
+{
+#   ifdef ZYCORE_MSVC
+        unsigned long idx;
+        _BitScanForward(&idx, mask);
+        return idx;
+#   else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#   endif
+}
+
+/**
+ * @internal
+ * @brief   Finds the terminator of characters of any type, one character at a time.
+ */
+template<typename CharT>
+inline std::size_t boundedLengthScalar(const CharT* chars, std::size_t first, std::size_t max)
+{
+    for (auto i = first; i < max; ++i) if (chars[i] == CharT{}) return i;
+    return max;
+}
+
+/**
+ * @internal
+ * @brief   Gets the number of characters before the terminator, reading no more than @c max.
+ * @param   chars   The characters.
+ * @param   max     The size of the buffer, in characters.
+ * @return  The number of characters, @c max if not terminated.
+ *
+ * Whole blocks are compared using SIMD, which never reads beyond the buffer.
+ */
+template<typename CharT>
+inline std::size_t boundedLength(const CharT* chars, std::size_t max)
+{
+    return boundedLengthScalar(chars, 0, max);
+}
+
+inline std::size_t boundedLength(const char* chars, std::size_t max)
+{
+    std::size_t i = 0;
+#   if defined(REMODEL_STRING_AVX2)
+        const auto zero32 = _mm256_setzero_si256();
+        for (; i + 32 <= max; i += 32)
+        {
+            auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + i));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero32)));
+            if (mask) return i + lowestMaskBit(mask);
+        }
+#   endif
+#   if defined(REMODEL_STRING_SSE2)
+        const auto zero = _mm_setzero_si128();
+        for (; i + 16 <= max; i += 16)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+            if (mask) return i + lowestMaskBit(mask);
+        }
+#   endif
+    return boundedLengthScalar(chars, i, max);
+}
+
+inline std::size_t boundedLength(const char16_t* chars, std::size_t max)
+{
+    std::size_t i = 0;
+#   if defined(REMODEL_STRING_AVX2)
+        const auto zero32 = _mm256_setzero_si256();
+        for (; i + 16 <= max; i += 16)
+        {
+            auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + i));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, zero32)));
+            if (mask) return i + lowestMaskBit(mask) / 2;
+        }
+#   endif
+#   if defined(REMODEL_STRING_SSE2)
+        const auto zero = _mm_setzero_si128();
+        for (; i + 8 <= max; i += 8)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(v, zero)));
+            if (mask) return i + lowestMaskBit(mask) / 2;
+        }
+#   endif
+    return boundedLengthScalar(chars, i, max);
+}
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [utf16ToUtf8]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Appends UTF-16 characters to a string, converted to UTF-8.
+ * @param   out     The string to append to.
+ * @param   chars   The UTF-16 code units.
+ * @param   count   The number of code units.
+ *
+ * Runs of ASCII characters are narrowed 8 at a time. Unpaired surrogates are replaced by
+ * U+FFFD, as the wrapped data isn't necessarily valid.
+ */
+inline void appendUtf8(std::string& out, const char16_t* chars, std::size_t count)
+{
+    // Every code unit takes at most 3 bytes, surrogate pairs take 4 bytes for 2 units.
+    auto first = out.size();
+    out.resize(first + count * 3);
+    auto begin = reinterpret_cast<uint8_t*>(&out[0]) + first;
+    auto dst = begin;
+
+#   if defined(REMODEL_STRING_SSE2)
+        const auto nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const auto zero = _mm_setzero_si128();
+#   endif
+
+    std::size_t i = 0;
+    while (i < count)
+    {
+#       if defined(REMODEL_STRING_SSE2)
+            for (; i + 8 <= count; i += 8, dst += 8)
+            {
+                auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+                auto ascii = _mm_cmpeq_epi16(_mm_and_si128(v, nonAscii), zero);
+                if (_mm_movemask_epi8(ascii) != 0xFFFF) break;
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(v, v));
+            }
+            if (i == count) break;
+#       endif
+
+        uint32_t cp = chars[i++];
+        if (cp < 0x80)
+        {
+            *dst++ = static_cast<uint8_t>(cp);
+            continue;
+        }
+        if (cp < 0x800)
+        {
+            *dst++ = static_cast<uint8_t>(0xC0 | (cp >> 6));
+            *dst++ = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            continue;
+        }
+        if (cp >= 0xD800 && cp < 0xE000)
+        {
+            if (cp < 0xDC00 && i < count && chars[i] >= 0xDC00 && chars[i] < 0xE000)
+            {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (chars[i++] - 0xDC00);
+                *dst++ = static_cast<uint8_t>(0xF0 | (cp >> 18));
+                *dst++ = static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+                *dst++ = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+                *dst++ = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+                continue;
+            }
+            cp = 0xFFFD;
+        }
+        *dst++ = static_cast<uint8_t>(0xE0 | (cp >> 12));
+        *dst++ = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+        *dst++ = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+    }
+    out.resize(first + static_cast<std::size_t>(dst - begin));
+}
+
+/**
+ * @brief   Converts UTF-16 characters to UTF-8.
+ * @param   chars   The UTF-16 code units.
+ * @param   count   The number of code units.
+ * @return  The UTF-8 string.
+ * @see     appendUtf8
+ */
+inline std::string utf16ToUtf8(const char16_t* chars, std::size_t count)
+{
+    std::string out;
+    appendUtf8(out, chars, count);
+    return out;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [FixedString]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Measures a fixed size character array in place.
+ * @param   chars   The array, e.g. `*field.addressOfObj()` of a `Field<char[64]>`.
+ * @return  A view over the characters before the terminator or the whole array.
+ */
+template<typename CharT, std::size_t countT>
+inline ArrayView<const CharT> boundedView(const CharT (&chars)[countT])
+{
+    return {chars, internal::boundedLength(chars, countT)};
+}
+
+/**
+ * @brief   Fixed size character array, null-terminated unless completely filled.
+ * @tparam  CharT   The character type.
+ * @tparam  countT  The size of the array, in characters.
+ */
+template<typename CharT, std::size_t countT>
+struct FixedString
+{
+    static const std::size_t kCapacity = countT;
+
+    /**
+     * @brief   Gets a pointer to the characters.
+     * @return  The pointer, not necessarily null-terminated.
+     */
+    const CharT* data() const { return m_chars; }
+
+    /**
+     * @brief   Gets the number of characters before the terminator, reading no more than the
+     *          array.
+     * @return  The number of characters.
+     */
+    std::size_t size() const { return internal::boundedLength(m_chars, countT); }
+
+    /**
+     * @brief   Determines whether the string is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return m_chars[0] == CharT{}; }
+
+    /**
+     * @brief   Creates a view over the characters.
+     * @return  The view, excluding the terminator.
+     */
+    ArrayView<const CharT> view() const { return {m_chars, size()}; }
+
+    /**
+     * @brief   Copies the characters into a string of our own standard library.
+     * @return  The copy.
+     */
+    std::basic_string<CharT> str() const { return {m_chars, size()}; }
+
+    /**
+     * @brief   Converts the UTF-16 characters to UTF-8.
+     * @return  The UTF-8 string.
+     */
+    template<typename C = CharT, typename = std::enable_if_t<std::is_same<C, char16_t>::value>>
+    std::string utf8() const { return utf16ToUtf8(m_chars, size()); }
+
+    /**
+     * @brief   Replaces the characters, truncating to leave room for the terminator.
+     * @param   chars   The new characters.
+     * @param   count   The number of characters.
+     * @return  The number of characters stored.
+     */
+    std::size_t assign(const CharT* chars, std::size_t count)
+    {
+        if (count > countT - 1) count = countT - 1;
+        std::memcpy(m_chars, chars, count * sizeof(CharT));
+        m_chars[count] = CharT{};
+        return count;
+    }
+
+    /**
+     * @brief   Compares the characters with a character array.
+     * @param   chars   The characters to compare with.
+     * @param   count   The number of characters.
+     * @return  @c true if equal, else @c false.
+     */
+    bool equals(const CharT* chars, std::size_t count) const
+    {
+        return size() == count && !std::memcmp(m_chars, chars, count * sizeof(CharT));
+    }
+
+    bool operator == (const std::basic_string<CharT>& rhs) const
+    {
+        return equals(rhs.data(), rhs.size());
+    }
+
+    bool operator == (const CharT* rhs) const
+    {
+        return equals(rhs, std::char_traits<CharT>::length(rhs));
+    }
+
+    template<typename RhsT>
+    bool operator != (const RhsT& rhs) const { return !(*this == rhs); }
+private:
+    CharT m_chars[countT];
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [CountedString]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Memory layout of a string stored as a pointer and a length.
+ */
+template<typename CharT, typename LenT, bool lengthFirstT>
+struct CountedStringLayout
+{
+    const CharT* ptr;
+    LenT         len;
+};
+
+template<typename CharT, typename LenT>
+struct CountedStringLayout<CharT, LenT, true>
+{
+    LenT         len;
+    const CharT* ptr;
+};
+
+} // namespace internal
+
+/**
+ * @brief   Read-only view over a string stored as a pointer to the characters and a length.
+ * @tparam  CharT           The character type.
+ * @tparam  LenT            The type of the length, in characters.
+ * @tparam  lengthFirstT    Whether the length precedes the pointer.
+ */
+template<typename CharT, typename LenT = uint32_t, bool lengthFirstT = false>
+class CountedString
+{
+    static_assert(std::is_integral<LenT>::value, "the length has to be an integer");
+public:
+    /**
+     * @brief   Gets a pointer to the characters.
+     * @return  The pointer, not necessarily null-terminated.
+     */
+    const CharT* data() const { return m_layout.ptr; }
+
+    /**
+     * @brief   Gets the number of characters.
+     * @return  The number of characters, zero for a null pointer.
+     */
+    std::size_t size() const 
+    { 
+        return m_layout.ptr && m_layout.len > 0 ? static_cast<std::size_t>(m_layout.len) : 0; 
+    }
+
+    /**
+     * @brief   Determines whether the string is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !size(); }
+
+    /**
+     * @brief   Creates a view over the characters.
+     * @return  The view.
+     */
+    ArrayView<const CharT> view() const { return {data(), size()}; }
+
+    /**
+     * @brief   Copies the characters into a string of our own standard library.
+     * @return  The copy.
+     */
+    std::basic_string<CharT> str() const { return {data(), size()}; }
+
+    /**
+     * @brief   Converts the UTF-16 characters to UTF-8.
+     * @return  The UTF-8 string.
+     */
+    template<typename C = CharT, typename = std::enable_if_t<std::is_same<C, char16_t>::value>>
+    std::string utf8() const { return utf16ToUtf8(data(), size()); }
+
+    /**
+     * @brief   Compares the characters with a character array.
+     * @param   chars   The characters to compare with.
+     * @param   count   The number of characters.
+     * @return  @c true if equal, else @c false.
+     */
+    bool equals(const CharT* chars, std::size_t count) const
+    {
+        return size() == count && (!count || !std::memcmp(data(), chars, count * sizeof(CharT)));
+    }
+
+    bool operator == (const std::basic_string<CharT>& rhs) const
+    {
+        return equals(rhs.data(), rhs.size());
+    }
+
+    bool operator == (const CharT* rhs) const
+    {
+        return equals(rhs, std::char_traits<CharT>::length(rhs));
+    }
+
+    template<typename RhsT>
+    bool operator != (const RhsT& rhs) const { return !(*this == rhs); }
+private:
+    internal::CountedStringLayout<CharT, LenT, lengthFirstT> m_layout;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_STRINGFIELDS_HPP
@@ -0,0 +1,247 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_SYMBOLS_HPP
+#define REMODEL_SYMBOLS_HPP
+
+/**     
+ * @file
+ * @brief Contains symbolization of wrapped target functions for sampling profilers.
+ *        
+ * Target code reached through `Function{0x...}` has no debug information, so profilers show raw
+ * addresses. A `SymbolTable` collects names for the functions known to the wrappers, e.g. from
+ * the active `LayoutTable` or a resolved `PatternBatch`, and publishes them as a perf map file,
+ * which perf, the Linux VTune collector and other tools pick up from `/tmp/perf-PID.map`.
+ *
+ * @code
+ *      SymbolTable symbols;
+ *      symbols.add("Game::update", updateFunc);
+ *      symbols.addPatterns(batch, kPatternNames);
+ *      symbols.writePerfMap();
+ * @endcode
+ * 
+ * For other consumers (JIT profiling APIs, ETW rundown providers), `symbols()` yields the sorted 
+ * entries with sizes, ready to be forwarded.
+ */
+
+#include "LayoutProfile.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [SymbolTable]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   A named range of target code.
+ */
+struct Symbol
+{
+    std::string name;
+    uintptr_t   address;
+    /// The size in bytes, zero if unknown.
+    std::size_t size;
+};
+
+/**
+ * @brief   Collection of names for target functions.
+ *          
+ * Functions of unknown size are assumed to extend up to the next symbol, but at most 
+ * `kDefaultSize` bytes. When multiple names are added for an address, the first one is kept.
+ */
+class SymbolTable
+{
+public:
+    static const std::size_t kDefaultSize = 0x100;
+
+    /**
+     * @brief   Adds a function by address.
+     * @param   name    The name of the function.
+     * @param   address The address of the function.
+     * @param   size    The size of the function, zero if unknown.
+     */
+    void add(std::string name, uintptr_t address, std::size_t size = 0)
+    {
+        if (!address) return;
+        m_symbols.push_back(Symbol{std::move(name), address, size});
+        m_sorted = false;
+    }
+
+    /**
+     * @copydoc add(std::string, uintptr_t, std::size_t)
+     */
+    void add(std::string name, const void* address, std::size_t size = 0)
+    {
+        add(std::move(name), reinterpret_cast<uintptr_t>(address), size);
+    }
+
+    /**
+     * @brief   Adds the function a `Function`, `MemberFunction` or `VirtualFunction` wrapper 
+     *          currently resolves to.
+     * @param   name    The name of the function.
+     * @param   func    The wrapper.
+     */
+    template<typename FuncT>
+    auto add(std::string name, const FuncT& func) -> decltype(func.get(), void())
+    {
+        auto ptr = func.get();
+        static_assert(sizeof(ptr) == sizeof(void*), "unsupported function pointer size");
+        add(std::move(name), *reinterpret_cast<void* const*>(&ptr));
+    }
+
+    /**
+     * @brief   Adds functions resolved by a `LayoutTable` whose entries are RVAs.
+     * @param   table   The table, nothing is added while no profile is active.
+     * @param   names   The names of the IDs.
+     * @param   ids     The IDs of the entries holding function RVAs.
+     * @param   count   The number of IDs.
+     * @return  The number of functions added.
+     */
+    std::size_t addLayout(const LayoutTable& table, const char* const* names, 
+        const std::size_t* ids, std::size_t count)
+    {
+        if (!table.isActive()) return 0;
+
+        for (std::size_t i = 0; i < count; ++i) add(names[ids[i]], table.address(ids[i]));
+        return count;
+    }
+
+    /**
+     * @brief   Adds the addresses resolved by a `PatternBatch`, skipping unresolved patterns.
+     * @param   batch   The batch.
+     * @param   names   The names of the patterns, one per pattern of the batch.
+     * @return  The number of functions added.
+     */
+    std::size_t addPatterns(const PatternBatch& batch, const char* const* names)
+    {
+        std::size_t added = 0;
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            if (!batch.isResolved(i)) continue;
+            add(names[i], batch.address(i));
+            ++added;
+        }
+        return added;
+    }
+
+    /**
+     * @brief   Gets the symbols sorted by address, with the size of every symbol determined.
+     * @return  The symbols.
+     */
+    const std::vector<Symbol>& symbols()
+    {
+        if (!m_sorted) finalize();
+        return m_symbols;
+    }
+
+    /**
+     * @brief   Gets the number of symbols.
+     */
+    std::size_t size() const { return m_symbols.size(); }
+
+    /**
+     * @brief   Writes the symbols in perf map format (`START SIZE name` per line, in hex).
+     * @param   path    The path of the file, replaced if existing.
+     * @return  @c true on success, else @c false.
+     */
+    bool writePerfMap(const char* path)
+    {
+        auto file = std::fopen(path, "w");
+        if (!file) return false;
+
+        bool ok = true;
+        for (const auto& symbol : symbols())
+        {
+            ok &= std::fprintf(file, "%llx %llx %s\n", 
+                static_cast<unsigned long long>(symbol.address), 
+                static_cast<unsigned long long>(symbol.size), symbol.name.c_str()) > 0;
+        }
+        ok &= std::fclose(file) == 0;
+        return ok;
+    }
+
+    /**
+     * @brief   Writes the symbols to `/tmp/perf-PID.map` for the current process.
+     * @return  @c true on success, else @c false.
+     * @see     writePerfMap(const char*)
+     */
+    bool writePerfMap()
+    {
+        return writePerfMap(perfMapPath().c_str());
+    }
+
+    /**
+     * @brief   Gets the path perf looks up symbols of the current process at.
+     * @return  The path.
+     */
+    static std::string perfMapPath()
+    {
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto pid = static_cast<unsigned long long>(GetCurrentProcessId());
+#   else
+        auto pid = static_cast<unsigned long long>(platform::currentProcess());
+#   endif
+        char path[64];
+        std::snprintf(path, sizeof(path), "/tmp/perf-%llu.map", pid);
+        return path;
+    }
+private:
+    void finalize()
+    {
+        std::stable_sort(m_symbols.begin(), m_symbols.end(), 
+            [](const Symbol& a, const Symbol& b) { return a.address < b.address; });
+        m_symbols.erase(std::unique(m_symbols.begin(), m_symbols.end(),
+            [](const Symbol& a, const Symbol& b) { return a.address == b.address; }), 
+            m_symbols.end());
+
+        for (std::size_t i = 0; i < m_symbols.size(); ++i)
+        {
+            auto& symbol = m_symbols[i];
+            if (symbol.size) continue;
+            symbol.size = kDefaultSize;
+            if (i + 1 < m_symbols.size())
+            {
+                symbol.size = std::min(
+                    std::size_t{kDefaultSize}, m_symbols[i + 1].address - symbol.address);
+            }
+        }
+        m_sorted = true;
+    }
+private:
+    std::vector<Symbol> m_symbols;
+    bool m_sorted = true;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_SYMBOLS_HPP
@@ -0,0 +1,549 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_TRACE_HPP
+#define REMODEL_TRACE_HPP
+
+/**     
+ * @file
+ * @brief Contains call tracing into per-thread lock-free ring buffers.
+ *        
+ * Every thread emitting trace records owns a single-producer single-consumer ring buffer, so
+ * emitting a record takes neither locks nor atomic read-modify-write instructions. Records 
+ * hold a timestamp, the called address, the thread and the first argument words. A consumer 
+ * drains all rings, e.g. a `TraceWriter` appending them to a binary file from a background 
+ * thread. Records are dropped (and counted) while a ring is full.
+ * 
+ * With `REMODEL_TRACE` defined (for all translation units, e.g. using the CMake option of the 
+ * same name), calls through `Function`, `MemberFunction`, `VirtualFunction` and 
+ * `Hook::callOriginal` emit records while tracing is enabled. Otherwise, records are only 
+ * emitted by explicit `trace::emit` calls, e.g. from detours.
+ *
+ * @code
+ *      TraceWriter writer{"game.trace"};
+ *      trace::setEnabled(true);
+ *      // ...
+ *      trace::setEnabled(false);
+ *      writer.stop();
+ * @endcode
+ * 
+ * The file is a `TraceFileHeader` followed by `TraceRecord`s in native byte order, in the order
+ * they were drained: sorted per thread, but interleaved between threads.
+ */
+
+#include "Platform.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief   The number of records per thread ring, a power of two.
+ */
+#ifndef REMODEL_TRACE_RING_CAPACITY
+#   define REMODEL_TRACE_RING_CAPACITY 4096
+#endif
+
+namespace remodel
+{
+namespace trace
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [TraceRecord]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The origin of a trace record.
+ */
+enum class CallKind : uint16_t
+{
+    Function,
+    MemberFunction,
+    HookOriginal,
+    User,
+};
+
+/**
+ * @brief   A trace record, exactly one cache line.
+ */
+struct TraceRecord
+{
+    static const std::size_t kMaxArgs = 5;
+
+    /// See `platform::readTimestamp`.
+    uint64_t timestamp;
+    /// The called address, for hooks the hooked function rather than the trampoline.
+    uint64_t target;
+    /// Sequential ID of the emitting thread, starting at 1.
+    uint32_t thread;
+    CallKind kind;
+    /// The number of valid `args`, the object pointer is the first one for member functions.
+    uint16_t argCount;
+    /// Arguments that are at most 8 bytes and trivially copyable, zero for others.
+    uint64_t args[kMaxArgs];
+};
+
+static_assert(sizeof(TraceRecord) == 64, "unexpected padding");
+
+// ---------------------------------------------------------------------------------------------- //
+// [TraceRing]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Single-producer single-consumer ring of trace records.
+ */
+class TraceRing
+{
+public:
+    static const std::size_t kCapacity = REMODEL_TRACE_RING_CAPACITY;
+    static_assert(kCapacity && !(kCapacity & (kCapacity - 1)), "capacity must be a power of two");
+
+    explicit TraceRing(uint32_t thread)
+        : m_thread{thread}
+        , m_records{new TraceRecord[kCapacity]}
+    {}
+
+    uint32_t thread() const { return m_thread; }
+
+    /**
+     * @brief   Appends a record, called by the owning thread only.
+     * @return  The slot to fill, @c nullptr if the ring is full. Has to be committed.
+     */
+    TraceRecord* reserve()
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == kCapacity)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == kCapacity)
+            {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, 
+                    std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+        return &m_records[head & (kCapacity - 1)];
+    }
+
+    /**
+     * @brief   Publishes the record obtained by `reserve`.
+     */
+    void commit()
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Removes all published records, called by the consumer only.
+     * @param   func    Invoked with contiguous runs of records as `(const TraceRecord*, size_t)`.
+     * @return  The number of records drained.
+     */
+    template<typename FuncT>
+    std::size_t drain(FuncT& func)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto head = m_head.load(std::memory_order_acquire);
+        for (auto cur = tail; cur != head;)
+        {
+            auto idx = cur & (kCapacity - 1);
+            auto run = std::min<std::size_t>(head - cur, kCapacity - idx);
+            func(&m_records[idx], run);
+            cur += run;
+        }
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /**
+     * @brief   Determines whether the ring holds published records.
+     */
+    bool empty() const 
+    { 
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Set once the owning thread exited, the ring is released after being drained.
+    std::atomic<bool> retired{false};
+private:
+    const uint32_t m_thread;
+    std::unique_ptr<TraceRecord[]> m_records;
+    // Producer and consumer indices on separate cache lines, avoiding false sharing.
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+    std::atomic<uint64_t> m_dropped{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+/**
+ * @internal
+ * @brief   Registry of all thread rings.
+ */
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    uint32_t nextThread = 1;
+    /// Dropped records of released rings.
+    uint64_t droppedReleased = 0;
+    std::atomic<bool> enabled{false};
+
+    static TraceRegistry& instance()
+    {
+        static TraceRegistry registry;
+        return registry;
+    }
+};
+
+/**
+ * @internal
+ * @brief   Owner of the ring of the current thread, retiring it on thread exit.
+ */
+struct ThreadRing
+{
+    std::shared_ptr<TraceRing> ring;
+
+    ThreadRing()
+    {
+        auto& registry = TraceRegistry::instance();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        ring = std::make_shared<TraceRing>(registry.nextThread++);
+        registry.rings.push_back(ring);
+    }
+
+    ~ThreadRing() { ring->retired.store(true, std::memory_order_release); }
+
+    static TraceRing& current()
+    {
+        // Trivially initialized, avoiding the guard of `owner` on the fast path.
+        static thread_local TraceRing* ring = nullptr;
+        if (!ring)
+        {
+            static thread_local ThreadRing owner;
+            ring = owner.ring.get();
+        }
+        return *ring;
+    }
+};
+
+/**
+ * @internal
+ * @brief   Converts an argument to a record word.
+ */
+template<typename T>
+inline std::enable_if_t<std::is_trivially_copyable<T>::value && sizeof(T) <= 8, uint64_t> 
+    argWord(const T& arg)
+{
+    uint64_t word = 0;
+    std::memcpy(&word, &arg, sizeof(arg));
+    return word;
+}
+
+template<typename T>
+inline std::enable_if_t<!(std::is_trivially_copyable<T>::value && sizeof(T) <= 8), uint64_t> 
+    argWord(const T&)
+{
+    return 0;
+}
+
+/**
+ * @internal
+ * @brief   Obtains the address of a function pointer.
+ */
+template<typename FuncPtrT>
+inline std::enable_if_t<std::is_pointer<FuncPtrT>::value, const void*> codeAddress(FuncPtrT ptr)
+{
+    static_assert(sizeof(FuncPtrT) == sizeof(void*), "unsupported function pointer size");
+    return *reinterpret_cast<const void* const*>(&ptr);
+}
+
+inline const void* codeAddress(const void* ptr)     { return ptr; }
+inline const void* codeAddress(uintptr_t addr)      { return reinterpret_cast<void*>(addr); }
+inline const void* codeAddress(std::nullptr_t)      { return nullptr; }
+
+} // namespace internal
+
+// ---------------------------------------------------------------------------------------------- //
+// [emit]                                                                                         //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Enables or disables emitting records, disabled by default.
+ * @param   enabled @c true to enable, @c false to disable.
+ */
+inline void setEnabled(bool enabled)
+{
+    internal::TraceRegistry::instance().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief   Determines whether records are emitted.
+ * @return  @c true if enabled, else @c false.
+ */
+inline bool isEnabled()
+{
+    return internal::TraceRegistry::instance().enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief   Emits a record into the ring of the current thread, if tracing is enabled.
+ * @tparam  ArgsT   The argument types, only the first `TraceRecord::kMaxArgs` are recorded.
+ * @param   kind    The origin of the record.
+ * @param   target  The called address, a data or function pointer.
+ * @param   args    The arguments to record.
+ */
+template<typename TargetT, typename... ArgsT>
+inline void emit(CallKind kind, TargetT target, const ArgsT&... args)
+{
+    if (!isEnabled()) return;
+
+    auto& ring = internal::ThreadRing::current();
+    auto record = ring.reserve();
+    if (!record) return;
+
+    const std::size_t count = std::min(sizeof...(ArgsT), std::size_t{TraceRecord::kMaxArgs});
+    record->timestamp = platform::readTimestamp();
+    record->target    = reinterpret_cast<uintptr_t>(internal::codeAddress(target));
+    record->thread    = ring.thread();
+    record->kind      = kind;
+    record->argCount  = static_cast<uint16_t>(count);
+    // Padded with zeros for unused words.
+    const uint64_t words[] = {internal::argWord(args)..., 0, 0, 0, 0, 0};
+    std::memcpy(record->args, words, sizeof(record->args));
+    ring.commit();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [drain]                                                                                        //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Removes the records of all threads, releasing rings of exited threads.
+ * @param   func    Invoked with contiguous runs of records as `(const TraceRecord*, size_t)`.
+ * @return  The number of records drained.
+ * @note    Drains from multiple threads are serialized.
+ */
+template<typename FuncT>
+inline std::size_t drain(FuncT&& func)
+{
+    auto& registry = internal::TraceRegistry::instance();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    std::size_t drained = 0;
+    auto& rings = registry.rings;
+    for (std::size_t i = 0; i < rings.size();)
+    {
+        // Checking retirement first, so records published before retiring are drained below.
+        bool retired = rings[i]->retired.load(std::memory_order_acquire);
+        drained += rings[i]->drain(func);
+        if (retired)
+        {
+            registry.droppedReleased += rings[i]->dropped();
+            rings[i] = std::move(rings.back());
+            rings.pop_back();
+        }
+        else ++i;
+    }
+    return drained;
+}
+
+/**
+ * @brief   Gets the number of records dropped because of full rings.
+ * @return  The number of dropped records.
+ */
+inline uint64_t droppedRecords()
+{
+    auto& registry = internal::TraceRegistry::instance();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    auto dropped = registry.droppedReleased;
+    for (const auto& ring : registry.rings) dropped += ring->dropped();
+    return dropped;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [TraceWriter]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   The header of a trace file.
+ */
+struct TraceFileHeader
+{
+    static const uint32_t kVersion = 1;
+    static const uint32_t kFlagCycles = 1;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    /// `kFlagCycles` if timestamps are cycles, else nanoseconds.
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(TraceFileHeader) == 24, "unexpected padding");
+
+const char kTraceFileMagic[8] = {'R', 'M', 'D', 'L', 'T', 'R', 'C', 'E'};
+
+/**
+ * @brief   Drains trace records into a file from a background thread.
+ * 
+ * The file is written with buffered I/O, so records reach the disk when the buffer is flushed
+ * or the writer is stopped.
+ */
+class TraceWriter
+{
+public:
+    /**
+     * @brief   Constructor, creating the file and starting the background thread.
+     * @param   path        The path of the file, replaced if existing.
+     * @param   interval    The time between drains.
+     */
+    explicit TraceWriter(const char* path, 
+        std::chrono::milliseconds interval = std::chrono::milliseconds{10})
+        : m_file{std::fopen(path, "wb")}
+        , m_interval{interval}
+    {
+        if (!m_file) return;
+
+        TraceFileHeader header{};
+        std::memcpy(header.magic, kTraceFileMagic, sizeof(header.magic));
+        header.version    = TraceFileHeader::kVersion;
+        header.recordSize = sizeof(TraceRecord);
+        header.flags      = platform::kTimestampIsCycles ? TraceFileHeader::kFlagCycles : 0;
+        m_ok = std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+        m_thread = std::thread{[this] { run(); }};
+    }
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator = (const TraceWriter&) = delete;
+
+    /**
+     * @brief   Destructor, stopping the writer.
+     */
+    ~TraceWriter() { stop(); }
+
+    /**
+     * @brief   Stops the background thread, drains the remaining records and closes the file.
+     * @return  @c true if all records were written, else @c false.
+     */
+    bool stop()
+    {
+        if (m_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_stop = true;
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+        }
+        if (m_file)
+        {
+            writePending();
+            m_ok &= std::fclose(m_file) == 0;
+            m_file = nullptr;
+        }
+        return m_ok;
+    }
+
+    /**
+     * @brief   Determines whether the file was created and all writes succeeded so far.
+     */
+    bool isOk() const { return m_ok; }
+
+    /**
+     * @brief   Gets the number of records written.
+     */
+    uint64_t written() const { return m_written.load(std::memory_order_relaxed); }
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        while (!m_stop)
+        {
+            m_wakeup.wait_for(lock, m_interval, [this] { return m_stop; });
+            lock.unlock();
+            writePending();
+            lock.lock();
+        }
+    }
+
+    void writePending()
+    {
+        drain([this](const TraceRecord* records, std::size_t count)
+        {
+            m_ok &= std::fwrite(records, sizeof(TraceRecord), count, m_file) == count;
+            m_written.fetch_add(count, std::memory_order_relaxed);
+        });
+    }
+private:
+    std::FILE* m_file;
+    std::chrono::milliseconds m_interval;
+    bool m_ok = false;
+    bool m_stop = false;
+    std::atomic<uint64_t> m_written{0};
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::thread m_thread;
+};
+
+// ============================================================================================== //
+
+} // namespace trace
+} // namespace remodel
+
+// ---------------------------------------------------------------------------------------------- //
+// [Wrapper hooks]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+#ifdef REMODEL_TRACE
+/**
+ * @internal
+ * @brief   Emits a record for a call through a wrapper.
+ * @param   kind    The `CallKind` enumerator.
+ * @param   ...     The called address, followed by the arguments.
+ */
+#   define REMODEL_TRACE_CALL(kind, ...)                                                           \
+        ::remodel::trace::emit(::remodel::trace::CallKind::kind, __VA_ARGS__)
+#else
+#   define REMODEL_TRACE_CALL(kind, ...) (void)0
+#endif
+
+#endif // REMODEL_TRACE_HPP
@@ -0,0 +1,463 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_TYPEREGISTRY_HPP
+#define REMODEL_TYPEREGISTRY_HPP
+
+/**     
+ * @file
+ * @brief Contains identification of the dynamic wrapper type of objects by their vftables.
+ *        
+ * Every instance of a polymorphic class starts with a pointer to the vftable of its dynamic 
+ * type. `TypeRegistry` maps vftable addresses to wrapper types, so pointers to base classes can 
+ * be downcast without RTTI.
+ *
+ * @code
+ *      TypeRegistry types;
+ *      types.add<Cat>(module->addressOfObj() + kCatVftableRva);
+ *      types.add<Dog>(module->addressOfObj() + kDogVftableRva);
+ *      
+ *      for (void* animal : animals)
+ *      {
+ *          types.dispatch<Cat, Dog>(animal, [](auto& concrete) { concrete.feed(); });
+ *      }
+ * @endcode
+ * 
+ * Lookups load the vftable pointer of the object and probe a flat open-addressing table, there
+ * are no allocations, locks or chains to follow. `TypeSwitch` additionally maps the vftables
+ * directly to handlers, for dispatching over many types.
+ */
+
+#include "Remodel.hpp"
+
+#include <cstring>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace remodel
+{
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Provides an address unique to a wrapper type, identifying it without RTTI.
+ */
+template<typename WrapperT>
+struct TypeKey
+{
+    static const char kKey;
+};
+
+template<typename WrapperT>
+const char TypeKey<WrapperT>::kKey = 0;
+
+/**
+ * @internal
+ * @brief   Flat open-addressing hash table keyed by vftable addresses.
+ * @tparam  ValueT  Type of the values, value-initialized values mark absent entries.
+ *
+ * The table is kept at most half full, so probe sequences are short.
+ */
+template<typename ValueT>
+class VftableMap
+{
+    struct Slot
+    {
+        uintptr_t vftable;
+        ValueT    value;
+    };
+public:
+    VftableMap()
+    {
+        rehash(kInitialBits);
+    }
+
+    std::size_t size() const { return m_count; }
+
+    ValueT find(uintptr_t vftable) const
+    {
+        for (auto idx = slotOf(vftable);; idx = (idx + 1) & m_mask)
+        {
+            const auto& slot = m_slots[idx];
+            if (slot.vftable == vftable) return slot.value;
+            if (!slot.vftable) return ValueT{};
+        }
+    }
+
+    bool insert(uintptr_t vftable, ValueT value)
+    {
+        if (!vftable) return false;
+        auto existing = find(vftable);
+        if (existing != ValueT{}) return existing == value;
+        if ((m_count + 1) * 2 > m_slots.size()) rehash(m_bits + 1);
+        place(vftable, value);
+        ++m_count;
+        return true;
+    }
+
+    template<typename FuncT>
+    void forEach(FuncT&& func) const
+    {
+        for (const auto& slot : m_slots) if (slot.vftable) func(slot.vftable, slot.value);
+    }
+private:
+    static const unsigned kInitialBits = 4;
+
+    std::size_t slotOf(uintptr_t vftable) const
+    {
+        // Fibonacci hashing, vftables are aligned so the low bits carry little information.
+        return static_cast<std::size_t>(
+            (static_cast<uint64_t>(vftable) * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    void place(uintptr_t vftable, ValueT value)
+    {
+        auto idx = slotOf(vftable);
+        while (m_slots[idx].vftable) idx = (idx + 1) & m_mask;
+        m_slots[idx] = {vftable, value};
+    }
+
+    void rehash(unsigned bits)
+    {
+        std::vector<Slot> old(std::size_t{1} << bits, Slot{0, ValueT{}});
+        old.swap(m_slots);
+        m_bits  = bits;
+        m_shift = 64 - bits;
+        m_mask  = m_slots.size() - 1;
+        for (const auto& slot : old) if (slot.vftable) place(slot.vftable, slot.value);
+    }
+private:
+    std::vector<Slot> m_slots;
+    std::size_t       m_mask  = 0;
+    std::size_t       m_count = 0;
+    unsigned          m_bits  = 0;
+    unsigned          m_shift = 0;
+};
+
+/**
+ * @internal
+ * @brief   Reads the vftable pointer of an object.
+ */
+inline uintptr_t vftableOf(const void* obj, std::size_t vftableOffset)
+{
+    uintptr_t vftable;
+    std::memcpy(&vftable, static_cast<const uint8_t*>(obj) + vftableOffset, sizeof(vftable));
+    return vftable;
+}
+
+} // namespace internal
+
+/**
+ * @brief   Gets the key identifying a wrapper type in a `TypeRegistry`.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @return  The key.
+ */
+template<typename WrapperT>
+inline const void* typeKeyOf()
+{
+    return &internal::TypeKey<WrapperT>::kKey;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// [TypeRegistry]                                                                                 //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Maps vftable addresses to wrapper types.
+ *          
+ * Several vftables may map to the same wrapper type (e.g. subclasses without own wrappers), but 
+ * every vftable maps to a single type.
+ * 
+ * @note    Registering is not thread-safe. Lookups on a registry that is no longer modified are.
+ */
+class TypeRegistry
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   vftableOffset   The offset of the vftable pointer in the objects.
+     */
+    explicit TypeRegistry(std::size_t vftableOffset = 0)
+        : m_vftableOffset{vftableOffset}
+    {}
+
+    /**
+     * @brief   Registers a vftable.
+     * @tparam  WrapperT    The wrapper type of the objects using the vftable.
+     * @param   vftable     The address of the vftable.
+     * @return  @c false if the vftable is null or registered for another type, else @c true.
+     */
+    template<typename WrapperT>
+    bool add(const void* vftable)
+    {
+        return m_table.insert(reinterpret_cast<uintptr_t>(vftable), typeKeyOf<WrapperT>());
+    }
+
+    /**
+     * @brief   Registers the vftable of a known instance.
+     * @tparam  WrapperT    The wrapper type to register the vftable for.
+     * @param   instance    The instance.
+     * @return  @c false if the vftable is null or registered for another type, else @c true.
+     */
+    template<typename WrapperT>
+    bool addOf(const WrapperT& instance)
+    {
+        return m_table.insert(internal::vftableOf(instance.addressOfObj(), m_vftableOffset), 
+            typeKeyOf<WrapperT>());
+    }
+
+    /**
+     * @brief   Gets the number of registered vftables.
+     * @return  The number of vftables.
+     */
+    std::size_t size() const { return m_table.size(); }
+
+    /**
+     * @brief   Gets the offset of the vftable pointer in the objects.
+     * @return  The offset.
+     */
+    std::size_t vftableOffset() const { return m_vftableOffset; }
+
+    /**
+     * @brief   Looks up the type registered for a vftable.
+     * @param   vftable The address of the vftable.
+     * @return  The key of the wrapper type (see `typeKeyOf`), @c nullptr if not registered.
+     */
+    const void* find(const void* vftable) const 
+    { 
+        return m_table.find(reinterpret_cast<uintptr_t>(vftable)); 
+    }
+
+    /**
+     * @brief   Identifies the dynamic type of an object.
+     * @param   obj The object, may be @c nullptr.
+     * @return  The key of the wrapper type (see `typeKeyOf`), @c nullptr if unknown.
+     */
+    const void* typeOf(const void* obj) const
+    {
+        return obj ? m_table.find(internal::vftableOf(obj, m_vftableOffset)) : nullptr;
+    }
+
+    /**
+     * @brief   Determines whether an object is of a wrapper type.
+     * @tparam  WrapperT    Type of the wrapper.
+     * @param   obj         The object, may be @c nullptr.
+     * @return  @c true if the vftable of the object is registered for the type, else @c false.
+     */
+    template<typename WrapperT>
+    bool is(const void* obj) const
+    {
+        return obj && typeOf(obj) == typeKeyOf<WrapperT>();
+    }
+
+    /**
+     * @brief   Wraps an object if it is of a wrapper type.
+     * @tparam  WrapperT    Type of the wrapper.
+     * @param   obj         The object, may be @c nullptr.
+     * @return  The wrapper, or an empty optional if the object is of another type.
+     */
+    template<typename WrapperT>
+    zycore::Optional<WrapperT> cast(void* obj) const
+    {
+        if (!is<WrapperT>(obj)) return zycore::kEmpty;
+        return {zycore::kInPlace, wrapper_cast<WrapperT>(obj)};
+    }
+
+    /**
+     * @brief   Invokes a function with a wrapper of the dynamic type of an object.
+     * @tparam  WrappersT   The wrapper types to dispatch to.
+     * @param   obj         The object, may be @c nullptr.
+     * @param   func        The function, invoked with a reference to a wrapper of the first 
+     *                      matching type, e.g. a generic lambda.
+     * @return  @c true if the function was invoked, @c false if the object is of none of the 
+     *          types.
+     *          
+     * The type is looked up once, matching it against the types is a chain of comparisons with
+     * constants. Hot loops over many types should use a `TypeSwitch` instead.
+     */
+    template<typename... WrappersT, typename FuncT>
+    bool dispatch(void* obj, FuncT&& func) const
+    {
+        auto type = typeOf(obj);
+        if (!type) return false;
+
+        bool handled = false;
+        (void)std::initializer_list<int>{
+            (handled = handled || dispatchAs<WrappersT>(type, obj, func), 0)...};
+        return handled;
+    }
+
+    /**
+     * @brief   Invokes a function for every registered vftable.
+     * @param   func    The function, taking the vftable address and the key of its type.
+     */
+    template<typename FuncT>
+    void forEach(FuncT&& func) const
+    {
+        m_table.forEach([&](uintptr_t vftable, const void* type)
+        {
+            func(reinterpret_cast<const void*>(vftable), type);
+        });
+    }
+private:
+    template<typename WrapperT, typename FuncT>
+    static bool dispatchAs(const void* type, void* obj, FuncT& func)
+    {
+        if (type != typeKeyOf<WrapperT>()) return false;
+        auto wrapper = wrapper_cast<WrapperT>(obj);
+        func(wrapper);
+        return true;
+    }
+private:
+    internal::VftableMap<const void*> m_table;
+    std::size_t                       m_vftableOffset;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [TypeSwitch]                                                                                   //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Dispatches objects to per-type handlers by their vftables.
+ * @tparam  WrappersT   The wrapper types handled, in the order of the handlers.
+ *          
+ * The vftables of the wrapper types are taken from a `TypeRegistry` on construction and mapped 
+ * directly to handler indices. Visiting an object loads its vftable pointer, probes the table 
+ * once and calls the handler through a table of thunks, no matter how many types there are.
+ * 
+ * @code
+ *      TypeSwitch<Player, Monster, Projectile> onEntity{types};
+ *      for (void* entity : entities)
+ *      {
+ *          onEntity.visit(entity, 
+ *              [](Player& player) { ... },
+ *              [](Monster& monster) { ... },
+ *              [](Projectile& projectile) { ... });
+ *      }
+ * @endcode
+ * 
+ * @note    Vftables registered after construction are not picked up, use `refresh`.
+ */
+template<typename... WrappersT>
+class TypeSwitch
+{
+    static_assert(sizeof...(WrappersT) > 0, "TypeSwitch requires at least one wrapper type");
+public:
+    /**
+     * @brief   Constructor.
+     * @param   types   The registry to take the vftables from.
+     */
+    explicit TypeSwitch(const TypeRegistry& types)
+    {
+        refresh(types);
+    }
+
+    /**
+     * @brief   Rebuilds the table from a registry.
+     * @param   types   The registry to take the vftables from.
+     */
+    void refresh(const TypeRegistry& types)
+    {
+        const void* keys[] = {typeKeyOf<WrappersT>()...};
+
+        m_table         = {};
+        m_vftableOffset = types.vftableOffset();
+        types.forEach([&](const void* vftable, const void* type)
+        {
+            for (uint32_t i = 0; i < sizeof...(WrappersT); ++i)
+            {
+                if (keys[i] != type) continue;
+                m_table.insert(reinterpret_cast<uintptr_t>(vftable), i + 1);
+                break;
+            }
+        });
+    }
+
+    /**
+     * @brief   Gets the number of vftables handled.
+     * @return  The number of vftables.
+     */
+    std::size_t size() const { return m_table.size(); }
+
+    /**
+     * @brief   Gets the index of the wrapper type of an object.
+     * @param   obj The object, may be @c nullptr.
+     * @return  The index into `WrappersT`, -1 if the object is of none of the types.
+     */
+    int indexOf(const void* obj) const
+    {
+        return (obj ? static_cast<int>(m_table.find(internal::vftableOf(obj, m_vftableOffset))) 
+            : 0) - 1;
+    }
+
+    /**
+     * @brief   Invokes the handler of the dynamic type of an object.
+     * @param   obj         The object, may be @c nullptr.
+     * @param   handlers    One handler per wrapper type, taking a reference to the wrapper.
+     * @return  @c true if a handler was invoked, @c false if the object is of none of the types.
+     */
+    template<typename... HandlersT>
+    bool visit(void* obj, HandlersT&&... handlers) const
+    {
+        static_assert(sizeof...(HandlersT) == sizeof...(WrappersT), 
+            "visit requires exactly one handler per wrapper type");
+
+        auto idx = indexOf(obj);
+        if (idx < 0) return false;
+
+        std::tuple<HandlersT&...> handlerRefs{handlers...};
+        thunks<std::tuple<HandlersT&...>>(std::index_sequence_for<WrappersT...>{})[idx](
+            obj, handlerRefs);
+        return true;
+    }
+private:
+    template<typename HandlersT>
+    using Thunk = void (*)(void* obj, HandlersT& handlers);
+
+    template<std::size_t idxT, typename HandlersT>
+    static void invoke(void* obj, HandlersT& handlers)
+    {
+        auto wrapper = wrapper_cast<std::tuple_element_t<idxT, std::tuple<WrappersT...>>>(obj);
+        std::get<idxT>(handlers)(wrapper);
+    }
+
+    template<typename HandlersT, std::size_t... idxs>
+    static const Thunk<HandlersT>* thunks(std::index_sequence<idxs...>)
+    {
+        static const Thunk<HandlersT> kThunks[] = {&invoke<idxs, HandlersT>...};
+        return kThunks;
+    }
+private:
+    internal::VftableMap<uint32_t> m_table;
+    std::size_t                    m_vftableOffset = 0;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_TYPEREGISTRY_HPP
@@ -0,0 +1,333 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_VECTORMATH_HPP
+#define REMODEL_VECTORMATH_HPP
+
+/**     
+ * @file
+ * @brief Contains SIMD loads and stores of vector and matrix fields and bulk operations on them.
+ *        
+ * Positions, directions and transforms of the wrapped program are usually `float[3]`, 
+ * `float[4]` and `float[4][4]` members. The functions in this file move such fields between 
+ * memory and SSE registers directly, using aligned instructions where the field happens to be 
+ * aligned, and convert them to the vector types of math libraries. Bulk operations over a 
+ * `WrapperSpan` process four objects per iteration, with one object per SIMD lane.
+ *
+ * @code
+ *      class Entity : public AdvancedClassWrapper<0x90>
+ *      {
+ *          REMODEL_ADV_WRAPPER(Entity)
+ *      public:
+ *          Field<float[3]>    position{this, 0x10};
+ *          Field<float[4][4]> world   {this, 0x20};
+ *      };
+ *      
+ *      __m128 pos = loadVec3(entity.position);
+ *      auto glmPos = loadAs<glm::vec3>(entity.position);
+ *      
+ *      std::vector<float> dist(entities.size());
+ *      distancesTo(entities, &Entity::position, {x, y, z}, dist.data());
+ * @endcode
+ * 
+ * The SSE functions are available on x86 with SSE enabled (`REMODEL_HAS_SSE_MATH`), `loadAs`, 
+ * `storeAs` and the bulk operations everywhere.
+ */
+
+#include "Remodel.hpp"
+#include "WrapperSpan.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#   include <xmmintrin.h>
+#   define REMODEL_HAS_SSE_MATH
+#endif
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [loadAs] + [storeAs]                                                                           //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Loads a field as a type of the same size, e.g. a vector type of a math library.
+ * @tparam  T   The type to load as, trivially copyable.
+ * @param   field   The field, e.g. a `Field<float[3]>`.
+ * @return  The value.
+ */
+template<typename T, typename FieldT, typename PtrGetterT>
+inline T loadAs(const internal::BasicField<FieldT, PtrGetterT>& field)
+{
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) == sizeof(FieldT),
+        "the type has to be trivially copyable and of the size of the field");
+    T value;
+    std::memcpy(&value, field.addressOfObj(), sizeof(value));
+    return value;
+}
+
+/**
+ * @brief   Stores a value of a type of the same size into a field.
+ * @param   field   The field, e.g. a `Field<float[3]>`.
+ * @param   value   The value, e.g. of a vector type of a math library.
+ */
+template<typename T, typename FieldT, typename PtrGetterT>
+inline void storeAs(internal::BasicField<FieldT, PtrGetterT>& field, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) == sizeof(FieldT),
+        "the type has to be trivially copyable and of the size of the field");
+    std::memcpy(field.addressOfObj(), &value, sizeof(value));
+}
+
+#ifdef REMODEL_HAS_SSE_MATH
+
+// ---------------------------------------------------------------------------------------------- //
+// [SSE loads and stores]                                                                         //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Determines whether a pointer is suitable for aligned SSE loads and stores.
+ */
+inline bool isSimdAligned(const void* ptr) 
+{ 
+    return !(reinterpret_cast<uintptr_t>(ptr) & 15); 
+}
+
+/**
+ * @brief   Loads four floats, using an aligned load if possible.
+ */
+inline __m128 loadVec4(const float* src)
+{
+    return isSimdAligned(src) ? _mm_load_ps(src) : _mm_loadu_ps(src);
+}
+
+/**
+ * @brief   Stores four floats, using an aligned store if possible.
+ */
+inline void storeVec4(float* dst, __m128 value)
+{
+    if (isSimdAligned(dst)) _mm_store_ps(dst, value); else _mm_storeu_ps(dst, value);
+}
+
+/**
+ * @brief   Loads three floats without reading past them, with a zero fourth lane.
+ */
+inline __m128 loadVec3(const float* src)
+{
+    auto xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(src));
+    return _mm_movelh_ps(xy, _mm_load_ss(src + 2));
+}
+
+/**
+ * @brief   Stores the first three lanes without writing past them.
+ */
+inline void storeVec3(float* dst, __m128 value)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst), value);
+    _mm_store_ss(dst + 2, _mm_movehl_ps(value, value));
+}
+
+template<typename PtrGetterT>
+inline __m128 loadVec4(const internal::BasicField<float[4], PtrGetterT>& field)
+{
+    return loadVec4(*field.addressOfObj());
+}
+
+template<typename PtrGetterT>
+inline void storeVec4(internal::BasicField<float[4], PtrGetterT>& field, __m128 value)
+{
+    storeVec4(*field.addressOfObj(), value);
+}
+
+template<typename PtrGetterT>
+inline __m128 loadVec3(const internal::BasicField<float[3], PtrGetterT>& field)
+{
+    return loadVec3(*field.addressOfObj());
+}
+
+template<typename PtrGetterT>
+inline void storeVec3(internal::BasicField<float[3], PtrGetterT>& field, __m128 value)
+{
+    storeVec3(*field.addressOfObj(), value);
+}
+
+/**
+ * @brief   The rows of a 4x4 float matrix in SSE registers.
+ */
+struct Mat4Rows
+{
+    __m128 rows[4];
+};
+
+/**
+ * @brief   Loads the rows of a 4x4 matrix, using aligned loads if possible.
+ */
+inline Mat4Rows loadMat4(const float (&src)[4][4])
+{
+    Mat4Rows mat;
+    if (isSimdAligned(src))
+    {
+        for (int i = 0; i < 4; ++i) mat.rows[i] = _mm_load_ps(src[i]);
+    }
+    else
+    {
+        for (int i = 0; i < 4; ++i) mat.rows[i] = _mm_loadu_ps(src[i]);
+    }
+    return mat;
+}
+
+/**
+ * @brief   Stores the rows of a 4x4 matrix, using aligned stores if possible.
+ */
+inline void storeMat4(float (&dst)[4][4], const Mat4Rows& mat)
+{
+    if (isSimdAligned(dst))
+    {
+        for (int i = 0; i < 4; ++i) _mm_store_ps(dst[i], mat.rows[i]);
+    }
+    else
+    {
+        for (int i = 0; i < 4; ++i) _mm_storeu_ps(dst[i], mat.rows[i]);
+    }
+}
+
+template<typename PtrGetterT>
+inline Mat4Rows loadMat4(const internal::BasicField<float[4][4], PtrGetterT>& field)
+{
+    return loadMat4(*field.addressOfObj());
+}
+
+template<typename PtrGetterT>
+inline void storeMat4(internal::BasicField<float[4][4], PtrGetterT>& field, const Mat4Rows& mat)
+{
+    storeMat4(*field.addressOfObj(), mat);
+}
+
+#endif // ifdef REMODEL_HAS_SSE_MATH
+
+// ---------------------------------------------------------------------------------------------- //
+// [distancesTo]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+namespace internal
+{
+
+/**
+ * @internal
+ * @brief   Computes the squared distances of `float[3]` fields of consecutive objects to a point.
+ * @param   bytes   The first object.
+ * @param   stride  The distance between two objects, in bytes.
+ * @param   count   The number of objects.
+ * @param   point   The point.
+ * @param   out     Receives one distance per object.
+ * @param   root    Whether to take the square root.
+ */
+inline void vec3Distances(const uint8_t* bytes, std::size_t stride, std::size_t count, 
+    const float (&point)[3], float* out, bool root)
+{
+    std::size_t i = 0;
+#   ifdef REMODEL_HAS_SSE_MATH
+        const auto px = _mm_set1_ps(point[0]);
+        const auto py = _mm_set1_ps(point[1]);
+        const auto pz = _mm_set1_ps(point[2]);
+        for (; i + 4 <= count; i += 4)
+        {
+            // Four objects, one per lane.
+            auto r0 = loadVec3(reinterpret_cast<const float*>(bytes + (i + 0) * stride));
+            auto r1 = loadVec3(reinterpret_cast<const float*>(bytes + (i + 1) * stride));
+            auto r2 = loadVec3(reinterpret_cast<const float*>(bytes + (i + 2) * stride));
+            auto r3 = loadVec3(reinterpret_cast<const float*>(bytes + (i + 3) * stride));
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            auto dx = _mm_sub_ps(r0, px);
+            auto dy = _mm_sub_ps(r1, py);
+            auto dz = _mm_sub_ps(r2, pz);
+            auto sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), 
+                _mm_mul_ps(dz, dz));
+            _mm_storeu_ps(out + i, root ? _mm_sqrt_ps(sq) : sq);
+        }
+#   endif
+    for (; i < count; ++i)
+    {
+        float pos[3];
+        std::memcpy(pos, bytes + i * stride, sizeof(pos));
+        auto dx = pos[0] - point[0], dy = pos[1] - point[1], dz = pos[2] - point[2];
+        auto sq = dx * dx + dy * dy + dz * dz;
+        out[i] = root ? std::sqrt(sq) : sq;
+    }
+}
+
+/**
+ * @internal
+ * @brief   Computes the distances of a `float[3]` field of every object of a span to a point.
+ */
+template<typename WrapperT, typename FieldT>
+inline void spanVec3Distances(const WrapperSpan<WrapperT>& span, FieldT WrapperT::* field, 
+    const float (&point)[3], float* out, bool root)
+{
+    static_assert(std::is_same<typename FieldT::RewrittenT, float[3]>::value, 
+        "the field has to be a float[3]");
+    if (span.empty()) return;
+
+    auto first = span[0];
+    auto bytes = static_cast<const uint8_t*>(first.addressOfObj());
+    auto offs  = reinterpret_cast<const uint8_t*>((first.*field).addressOfObj()) - bytes;
+    vec3Distances(bytes + offs, WrapperT::kObjSize, span.size(), point, out, root);
+}
+
+} // namespace internal
+
+/**
+ * @brief   Computes the distance of a `float[3]` field of every object of a span to a point.
+ * @param   span    The span.
+ * @param   field   The field member of the wrapper, e.g. `&Entity::position`.
+ * @param   point   The point.
+ * @param   out     The output array, large enough to hold one element per object.
+ * @note    The field is required to be located at the same offset in every object. It is 
+ *          resolved by wrapping the first object once, no wrappers are created afterwards.
+ */
+template<typename WrapperT, typename FieldT>
+inline void distancesTo(const WrapperSpan<WrapperT>& span, FieldT WrapperT::* field, 
+    const float (&point)[3], float* out)
+{
+    internal::spanVec3Distances(span, field, point, out, true);
+}
+
+/**
+ * @brief   Computes the squared distance of a `float[3]` field of every object of a span to a 
+ *          point, e.g. for comparisons against a squared radius.
+ * @copydetails distancesTo
+ */
+template<typename WrapperT, typename FieldT>
+inline void squaredDistancesTo(const WrapperSpan<WrapperT>& span, FieldT WrapperT::* field, 
+    const float (&point)[3], float* out)
+{
+    internal::spanVec3Distances(span, field, point, out, false);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_VECTORMATH_HPP
@@ -0,0 +1,537 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_WATCH_HPP
+#define REMODEL_WATCH_HPP
+
+/**     
+ * @file
+ * @brief Contains change detection for fields and wrapped objects.
+ *        
+ * @code
+ *      WatchSet watches;
+ *      auto health = watches.watch(player.health);
+ *      watches.watchObject(inventory);
+ *      
+ *      std::vector<std::size_t> changed;
+ *      for (;;)
+ *      {
+ *          watches.poll(changed);
+ *          for (auto idx : changed) { ... }
+ *      }
+ * @endcode
+ * 
+ * `WatchNotifier` delivers changes of a few hot fields via hardware watchpoints instead, 
+ * without polling.
+ */
+
+#include "Remodel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [WatchSet]                                                                                     //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Detects changes of watched memory ranges between polls.
+ *          
+ * Every watch keeps a shadow copy of its range in a single contiguous arena. Polling compares 
+ * each range against its shadow (using the vectorized `memcmp`) and refreshes the shadows of the 
+ * changed ones. Watches are identified by the index returned on registration.
+ * 
+ * With page tracking enabled, ranges on pages not written since the last poll are skipped 
+ * without being read. Page tracking is best-effort: writes racing with a poll may only be 
+ * reported by the next write to the page.
+ */
+class WatchSet
+{
+    struct Watch
+    {
+        const uint8_t* address;
+        std::size_t    size;
+        std::size_t    shadowOffset;
+        std::size_t    firstPage;
+        std::size_t    pageCount;
+    };
+
+    std::vector<Watch>     m_watches;
+    std::vector<uint8_t>   m_shadow;
+#   ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+        std::unique_ptr<platform::SoftDirtyTracker> m_tracker;
+        /// Distinct pages covered by the watches, sorted, and their state during a poll.
+        std::vector<uintptr_t> m_pages;
+        std::vector<uint8_t>   m_pageDirty;
+        /// Set after enabling tracking, writes before enabling aren't reflected by the pages.
+        bool                   m_fullPoll = false;
+#   endif
+public:
+    /**
+     * @brief   Watches a field.
+     * @param   field   The field, its address is resolved once.
+     * @return  The index of the watch.
+     */
+    template<typename FieldT>
+    std::enable_if_t<std::is_base_of<internal::FieldBase, FieldT>::value, std::size_t>
+    watch(FieldT& field)
+    {
+        auto address = field.addressOfObj();
+        return watchRange(address, sizeof(*address));
+    }
+
+    /**
+     * @brief   Watches a whole wrapped object.
+     * @param   wrapper The wrapper, derived from `AdvancedClassWrapper`.
+     * @return  The index of the watch.
+     */
+    template<typename WrapperT>
+    std::size_t watchObject(WrapperT& wrapper)
+    {
+        return watchRange(wrapper.addressOfObj(), WrapperT::kObjSize);
+    }
+
+    /**
+     * @brief   Watches a memory range.
+     * @param   address The begin of the range.
+     * @param   size    The size of the range, in bytes.
+     * @return  The index of the watch.
+     */
+    std::size_t watchRange(const void* address, std::size_t size)
+    {
+        auto begin = static_cast<const uint8_t*>(address);
+        m_watches.push_back({begin, size, m_shadow.size(), 0, 0});
+        m_shadow.insert(m_shadow.end(), begin, begin + size);
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            if (m_tracker) indexPages();
+#       endif
+        return m_watches.size() - 1;
+    }
+
+    /**
+     * @brief   Watches many memory ranges of the same size, indexing pages only once.
+     * @param   addresses   The begins of the ranges.
+     * @param   count       The number of ranges.
+     * @param   size        The size of every range, in bytes.
+     * @return  The index of the watch of the first range, the others follow consecutively.
+     */
+    std::size_t watchRanges(const void* const* addresses, std::size_t count, std::size_t size)
+    {
+        auto first = m_watches.size();
+        m_watches.reserve(first + count);
+        m_shadow.reserve(m_shadow.size() + count * size);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto begin = static_cast<const uint8_t*>(addresses[i]);
+            m_watches.push_back({begin, size, m_shadow.size(), 0, 0});
+            m_shadow.insert(m_shadow.end(), begin, begin + size);
+        }
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            if (m_tracker) indexPages();
+#       endif
+        return first;
+    }
+
+    /**
+     * @brief   Gets the number of watches.
+     */
+    std::size_t size() const { return m_watches.size(); }
+
+    /**
+     * @brief   Removes all watches.
+     */
+    void clear()
+    {
+        m_watches.clear();
+        m_shadow.clear();
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            if (m_tracker) indexPages();
+#       endif
+    }
+
+    /**
+     * @brief   Gets the value of a watched range as of the last poll (or registration).
+     * @param   watchIdx    The index of the watch.
+     */
+    const void* shadow(std::size_t watchIdx) const 
+    { 
+        return m_shadow.data() + m_watches[watchIdx].shadowOffset; 
+    }
+
+    /**
+     * @brief   Enables skipping of unwritten pages.
+     * @return  @c true if supported by the platform, else @c false.
+     * @note    On Linux, this uses soft-dirty bits, which are reset for the whole process on 
+     *          every poll.
+     */
+    bool enablePageTracking()
+    {
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            if (m_tracker) return true;
+            std::unique_ptr<platform::SoftDirtyTracker> tracker{new platform::SoftDirtyTracker};
+            if (!tracker->isAvailable()) return false;
+            m_tracker  = std::move(tracker);
+            m_fullPoll = true;
+            indexPages();
+            return true;
+#       else
+            return false;
+#       endif
+    }
+
+    /**
+     * @brief   Determines whether page tracking is enabled.
+     */
+    bool isPageTrackingEnabled() const
+    {
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            return m_tracker != nullptr;
+#       else
+            return false;
+#       endif
+    }
+
+    /**
+     * @brief   Detects the watches changed since the last poll.
+     * @param   changed Receives the indices of the changed watches, in ascending order.
+     * @return  The number of changed watches.
+     */
+    std::size_t poll(std::vector<std::size_t>& changed)
+    {
+        changed.clear();
+#       ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+            if (m_tracker && !queryPages()) m_tracker.reset();
+            auto skipClean = m_tracker && !m_fullPoll;
+            m_fullPoll = false;
+#       endif
+
+        for (std::size_t i = 0; i < m_watches.size(); ++i)
+        {
+            const auto& watch = m_watches[i];
+#           ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+                if (skipClean && !std::any_of(m_pageDirty.begin() + watch.firstPage, 
+                    m_pageDirty.begin() + watch.firstPage + watch.pageCount, 
+                    [](uint8_t dirty) { return dirty != 0; })) continue;
+#           endif
+
+            auto shadow = m_shadow.data() + watch.shadowOffset;
+            if (equals(shadow, watch.address, watch.size)) continue;
+            std::memcpy(shadow, watch.address, watch.size);
+            changed.push_back(i);
+        }
+        return changed.size();
+    }
+private:
+    /// Compares a range with its shadow, inlining the comparisons of typical field sizes.
+    static bool equals(const uint8_t* shadow, const uint8_t* address, std::size_t size)
+    {
+        switch (size)
+        {
+        case 1: return *shadow == *address;
+        case 2: return equalsFixed<uint16_t>(shadow, address);
+        case 4: return equalsFixed<uint32_t>(shadow, address);
+        case 8: return equalsFixed<uint64_t>(shadow, address);
+        default: return std::memcmp(shadow, address, size) == 0;
+        }
+    }
+
+    template<typename T>
+    static bool equalsFixed(const uint8_t* shadow, const uint8_t* address)
+    {
+        T lhs, rhs;
+        std::memcpy(&lhs, shadow, sizeof(T));
+        std::memcpy(&rhs, address, sizeof(T));
+        return lhs == rhs;
+    }
+
+#   ifdef REMODEL_HAS_PAGE_DIRTY_TRACKING
+    void indexPages()
+    {
+        auto pageSize = m_tracker->pageSize();
+        m_pages.clear();
+        for (const auto& watch : m_watches)
+        {
+            if (!watch.size) continue;
+            auto first = reinterpret_cast<uintptr_t>(watch.address) / pageSize;
+            auto last  = (reinterpret_cast<uintptr_t>(watch.address) + watch.size - 1) / pageSize;
+            for (auto page = first; page <= last; ++page) m_pages.push_back(page);
+        }
+        std::sort(m_pages.begin(), m_pages.end());
+        m_pages.erase(std::unique(m_pages.begin(), m_pages.end()), m_pages.end());
+        m_pageDirty.assign(m_pages.size(), 0);
+
+        for (auto& watch : m_watches)
+        {
+            auto first = reinterpret_cast<uintptr_t>(watch.address) / pageSize;
+            auto last  = (reinterpret_cast<uintptr_t>(watch.address) 
+                + (watch.size ? watch.size - 1 : 0)) / pageSize;
+            watch.firstPage = static_cast<std::size_t>(
+                std::lower_bound(m_pages.begin(), m_pages.end(), first) - m_pages.begin());
+            watch.pageCount = watch.size ? static_cast<std::size_t>(last - first + 1) : 0;
+        }
+    }
+
+    bool queryPages()
+    {
+        auto pageSize = m_tracker->pageSize();
+        for (std::size_t i = 0; i < m_pages.size(); ++i)
+        {
+            bool dirty;
+            if (!m_tracker->isDirty(reinterpret_cast<const void*>(m_pages[i] * pageSize), dirty)) 
+                return false;
+            m_pageDirty[i] = dirty;
+        }
+        return m_tracker->reset();
+    }
+#   endif
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [WatchNotifier]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Invokes a callback when watched ranges change, using hardware watchpoints if possible.
+ *          
+ * Up to `platform::kMaxWriteWatchpoints` watches of 1, 2, 4 or 8 aligned bytes (i.e. typical 
+ * fields) are armed as hardware write watchpoints in the order of registration: a write wakes 
+ * the notifier thread right away, no polling involved. All other watches, or all of them where 
+ * watchpoints are unsupported or exhausted, fall back to a `WatchSet` polled by the notifier 
+ * thread every poll interval.
+ * 
+ * Callbacks are invoked on the notifier thread with the index of the watch, only for writes 
+ * changing the value. Watches are registered while the notifier is stopped.
+ * @code
+ *      WatchNotifier notifier{[](std::size_t idx) { onChanged(idx); }};
+ *      notifier.watch(player.health);
+ *      notifier.start();
+ * @endcode
+ */
+class WatchNotifier : public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   The callback type, taking the index of the changed watch.
+     */
+    using Callback = std::function<void (std::size_t watchIdx)>;
+
+    /**
+     * @brief   Constructor.
+     * @param   callback        The callback.
+     * @param   pollInterval    The interval fallback watches are polled in.
+     */
+    explicit WatchNotifier(Callback callback, 
+        std::chrono::milliseconds pollInterval = std::chrono::milliseconds{1})
+        : m_callback{std::move(callback)}
+        , m_pollInterval{pollInterval}
+    {}
+
+    /**
+     * @brief   Destructor, stopping the notifier.
+     */
+    ~WatchNotifier() { stop(); }
+
+    /**
+     * @brief   Watches a field.
+     * @param   field   The field, its address is resolved once.
+     * @return  The index of the watch.
+     */
+    template<typename FieldT>
+    std::enable_if_t<std::is_base_of<internal::FieldBase, FieldT>::value, std::size_t>
+    watch(FieldT& field)
+    {
+        auto address = field.addressOfObj();
+        return watchRange(address, sizeof(*address));
+    }
+
+    /**
+     * @brief   Watches a memory range.
+     * @param   address The begin of the range.
+     * @param   size    The size of the range, in bytes.
+     * @return  The index of the watch.
+     */
+    std::size_t watchRange(const void* address, std::size_t size)
+    {
+        m_watches.push_back({static_cast<const uint8_t*>(address), size, false, {}});
+        return m_watches.size() - 1;
+    }
+
+    /**
+     * @brief   Gets the number of watches.
+     */
+    std::size_t size() const { return m_watches.size(); }
+
+    /**
+     * @brief   Starts the notifier thread, arming the watchpoints.
+     */
+    void start()
+    {
+        if (m_thread.joinable()) return;
+
+        m_stop.store(false);
+        m_ready = false;
+        m_thread = std::thread{[this] { run(); }};
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_ready; });
+    }
+
+    /**
+     * @brief   Stops the notifier thread, disarming the watchpoints.
+     */
+    void stop()
+    {
+        if (!m_thread.joinable()) return;
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stop.store(true);
+#           ifdef REMODEL_HAS_HW_WATCHPOINTS
+                m_listener->wake();
+#           endif
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    /**
+     * @brief   Determines whether the notifier thread is running.
+     */
+    bool isRunning() const { return m_thread.joinable(); }
+
+    /**
+     * @brief   Determines whether a watch is served by a hardware watchpoint, valid while running.
+     * @param   watchIdx    The index of the watch.
+     */
+    bool isHardware(std::size_t watchIdx) const { return m_watches[watchIdx].hardware; }
+private:
+    struct Watch
+    {
+        const uint8_t* address;
+        std::size_t    size;
+        bool           hardware;
+        uint8_t        shadow[8];
+    };
+
+    void run()
+    {
+        WatchSet fallback;
+        std::vector<std::size_t> fallbackIdxs, changed;
+#       ifdef REMODEL_HAS_HW_WATCHPOINTS
+            platform::WatchpointListener listener;
+            std::vector<platform::WriteWatchpoint> watchpoints;
+            std::vector<std::size_t> watchpointIdxs;
+#       endif
+
+        for (std::size_t i = 0; i < m_watches.size(); ++i)
+        {
+            auto& watch = m_watches[i];
+            watch.hardware = false;
+#           ifdef REMODEL_HAS_HW_WATCHPOINTS
+                if (watchpoints.size() < platform::kMaxWriteWatchpoints)
+                {
+                    platform::WriteWatchpoint watchpoint;
+                    std::memcpy(watch.shadow, watch.address, 
+                        std::min(watch.size, sizeof(watch.shadow)));
+                    if (watchpoint.arm(watch.address, watch.size, listener))
+                    {
+                        watch.hardware = true;
+                        watchpoints.push_back(std::move(watchpoint));
+                        watchpointIdxs.push_back(i);
+                        continue;
+                    }
+                }
+#           endif
+            fallback.watchRange(watch.address, watch.size);
+            fallbackIdxs.push_back(i);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+#           ifdef REMODEL_HAS_HW_WATCHPOINTS
+                m_listener = &listener;
+#           endif
+            m_ready = true;
+        }
+        m_cv.notify_all();
+
+        while (!m_stop.load())
+        {
+#           ifdef REMODEL_HAS_HW_WATCHPOINTS
+                auto fd = listener.wait(fallbackIdxs.empty() ? -1L 
+                    : static_cast<long>(m_pollInterval.count()));
+                for (std::size_t i = 0; fd >= 0 && i < watchpoints.size(); ++i)
+                {
+                    if (!watchpoints[i].owns(fd)) continue;
+                    auto& watch = m_watches[watchpointIdxs[i]];
+                    if (std::memcmp(watch.shadow, watch.address, watch.size) == 0) break;
+                    std::memcpy(watch.shadow, watch.address, watch.size);
+                    m_callback(watchpointIdxs[i]);
+                    break;
+                }
+#           else
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_cv.wait_for(lock, m_pollInterval, [this] { return m_stop.load(); });
+#           endif
+
+            if (fallbackIdxs.empty()) continue;
+            fallback.poll(changed);
+            for (auto idx : changed) m_callback(fallbackIdxs[idx]);
+        }
+
+#       ifdef REMODEL_HAS_HW_WATCHPOINTS
+            // Disarm before the listener discards the notifications still pending.
+            watchpoints.clear();
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_listener = nullptr;
+#       endif
+    }
+
+    Callback m_callback;
+    std::chrono::milliseconds m_pollInterval;
+    std::vector<Watch> m_watches;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_ready = false;
+#   ifdef REMODEL_HAS_HW_WATCHPOINTS
+        platform::WatchpointListener* m_listener = nullptr;
+#   endif
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_WATCH_HPP
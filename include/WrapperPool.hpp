@@ -0,0 +1,194 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_WRAPPERPOOL_HPP
+#define REMODEL_WRAPPERPOOL_HPP
+
+/**     
+ * @file
+ * @brief Contains per-thread pools of reusable wrappers.
+ *        
+ * Creating a wrapper constructs all of its fields, which dominates the cost of callbacks invoked 
+ * for many objects. Pooled wrappers are created once per thread (and nesting depth) and rebound 
+ * to the next object afterwards.
+ *        
+ * @code
+ *      void horseTraverser(Horse::Weak* weak)
+ *      {
+ *          auto horse = pooledWrapper(weak);
+ *          horse->age += 1;
+ *      }
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [WrapperPool]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Pool of reusable wrappers of one type, one instance per thread.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @see     PooledWrapper
+ */
+template<typename WrapperT>
+class WrapperPool : public zycore::NonCopyable
+{
+public:
+    /**
+     * @brief   Gets the pool of the calling thread.
+     */
+    static WrapperPool& threadInstance()
+    {
+        static thread_local WrapperPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief   Takes a wrapper from the pool, creating one if all are in use.
+     * @param   raw The raw pointer of the object to wrap.
+     * @return  The wrapper, to be returned using `release`.
+     */
+    WrapperT* acquire(void* raw)
+    {
+        if (m_free.empty())
+        {
+            m_all.emplace_back(new WrapperT{wrapper_cast<WrapperT>(raw)});
+            return m_all.back().get();
+        }
+
+        auto wrapper = m_free.back();
+        m_free.pop_back();
+        wrapper->ClassWrapper::rebind(raw);
+        return wrapper;
+    }
+
+    /**
+     * @brief   Returns a wrapper to the pool.
+     * @param   wrapper The wrapper, obtained from `acquire` of this pool.
+     */
+    void release(WrapperT* wrapper) { m_free.push_back(wrapper); }
+
+    /**
+     * @brief   Gets the number of wrappers created by this pool.
+     */
+    std::size_t size() const { return m_all.size(); }
+private:
+    WrapperPool() = default;
+private:
+    std::vector<std::unique_ptr<WrapperT>> m_all;
+    std::vector<WrapperT*> m_free;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [PooledWrapper]                                                                                //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Wrapper leased from the `WrapperPool` of the current thread, returned when destroyed.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @note    Leases are required to be destroyed by the thread that created them.
+ */
+template<typename WrapperT>
+class PooledWrapper
+{
+public:
+    /**
+     * @brief   Constructor.
+     * @param   raw The raw pointer of the object to wrap.
+     */
+    explicit PooledWrapper(void* raw)
+        : m_pool{&WrapperPool<WrapperT>::threadInstance()}
+        , m_wrapper{m_pool->acquire(raw)}
+    {}
+
+    PooledWrapper(PooledWrapper&& other)
+        : m_pool{other.m_pool}
+        , m_wrapper{other.m_wrapper}
+    {
+        other.m_wrapper = nullptr;
+    }
+
+    PooledWrapper(const PooledWrapper&) = delete;
+    PooledWrapper& operator = (const PooledWrapper&) = delete;
+    PooledWrapper& operator = (PooledWrapper&&) = delete;
+
+    /**
+     * @brief   Destructor.
+     */
+    ~PooledWrapper()
+    {
+        if (m_wrapper) m_pool->release(m_wrapper);
+    }
+
+    /**
+     * @brief   Points the wrapper to another object.
+     * @param   raw The raw pointer of the new object.
+     */
+    void rebind(void* raw) { m_wrapper->ClassWrapper::rebind(raw); }
+
+    WrapperT& get() const           { return *m_wrapper; }
+    WrapperT& operator * () const   { return *m_wrapper; }
+    WrapperT* operator -> () const  { return m_wrapper; }
+private:
+    WrapperPool<WrapperT>* m_pool;
+    WrapperT* m_wrapper;
+};
+
+/**
+ * @brief   Leases a pooled wrapper for an object.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @param   raw         The raw pointer of the object.
+ * @return  The lease.
+ */
+template<typename WrapperT>
+inline PooledWrapper<WrapperT> pooledWrapper(void* raw)
+{
+    return PooledWrapper<WrapperT>{raw};
+}
+
+/**
+ * @brief   Leases a pooled wrapper for an object referenced by a weak wrapper.
+ * @param   weak    The weak wrapper, e.g. passed to a callback.
+ * @return  The lease.
+ * @see     internal::WeakWrapperImpl::toStrong
+ */
+template<typename WrapperT>
+inline PooledWrapper<WrapperT> pooledWrapper(WeakWrapper<WrapperT>* weak)
+{
+    return PooledWrapper<WrapperT>{weak->raw()};
+}
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_WRAPPERPOOL_HPP
@@ -0,0 +1,345 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_WRAPPERSPAN_HPP
+#define REMODEL_WRAPPERSPAN_HPP
+
+/**     
+ * @file
+ * @brief Contains a typed view over contiguous arrays of wrapped objects.
+ *        
+ * @code
+ *      for (auto& cat : WrapperSpan<Cat>{game->cats, game->numCats})
+ *      {
+ *          cat.giveGoodie(1);
+ *      }
+ * @endcode
+ */
+
+#include "Remodel.hpp"
+
+#include <cstring>
+#include <iterator>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [WrapperSpanIterator]                                                                          //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Random access iterator over contiguous wrapped objects.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ *                      
+ * Every iterator owns a single wrapper that is rebound to the current object when the iterator
+ * is moved, so no wrapper is constructed per element. Consequently, references obtained by 
+ * dereferencing are only valid until the iterator is moved or destroyed. Distinct iterator 
+ * copies do not share any state, so they can be handed to different threads (e.g. by parallel 
+ * algorithms).
+ * 
+ * Iterators obtained from a span with a prefetch distance prefetch the object that many elements 
+ * ahead whenever they are incremented.
+ */
+template<typename WrapperT>
+class WrapperSpanIterator
+{
+    static_assert(std::is_base_of<
+        AdvancedClassWrapper<WrapperT::kObjSize, WrapperT::kObjAlign>, WrapperT>::value,
+        "WrapperSpan requires usage of AdvancedClassWrapper as base");
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = WrapperT;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = WrapperT*;
+    using reference         = WrapperT&;
+
+    static const std::size_t kStride = WrapperT::kObjSize;
+
+    /**
+     * @brief   Default constructor, creating a singular iterator.
+     */
+    WrapperSpanIterator()
+        : m_wrapper{wrapper_cast<WrapperT>(nullptr)}
+    {}
+
+    /**
+     * @brief   Constructs an iterator pointing to an object.
+     * @param   raw The raw pointer of the object.
+     */
+    explicit WrapperSpanIterator(void* raw)
+        : m_wrapper{wrapper_cast<WrapperT>(raw)}
+    {}
+
+    /**
+     * @brief   Constructs an iterator pointing to an object, prefetching ahead.
+     * @param   raw         The raw pointer of the object.
+     * @param   distance    The prefetch distance in elements, 0 to disable prefetching.
+     * @param   end         The raw pointer past the last object, bounding the prefetches.
+     */
+    WrapperSpanIterator(void* raw, std::size_t distance, const void* end)
+        : m_wrapper{wrapper_cast<WrapperT>(raw)}
+        , m_lookahead{static_cast<difference_type>(distance * kStride)}
+        , m_end{static_cast<const uint8_t*>(end)}
+    {}
+
+    /**
+     * @brief   Copy constructor.
+     * @param   other   The iterator to copy from.
+     */
+    WrapperSpanIterator(const WrapperSpanIterator& other)
+        : m_wrapper{wrapper_cast<WrapperT>(other.raw())}
+        , m_lookahead{other.m_lookahead}
+        , m_end{other.m_end}
+    {}
+
+    /**
+     * @brief   Assignment operator, rebinding the wrapper of this iterator.
+     * @param   other   The iterator to assign from.
+     * @return  `*this`.
+     */
+    WrapperSpanIterator& operator = (const WrapperSpanIterator& other)
+    {
+        rebind(other.raw());
+        m_lookahead = other.m_lookahead;
+        m_end       = other.m_end;
+        return *this;
+    }
+
+    /**
+     * @brief   Gets the raw pointer of the current object.
+     * @return  The raw pointer.
+     */
+    uint8_t* raw() const
+    {
+        return static_cast<uint8_t*>(m_wrapper.addressOfObj());
+    }
+
+    reference operator * () const   { return m_wrapper; }
+    pointer operator -> () const    { return m_wrapper.addressOfWrapper(); }
+
+    /**
+     * @brief   Subscript operator.
+     * @param   n   The offset in elements from the current object.
+     * @return  A new wrapper for the requested object.
+     */
+    value_type operator [] (difference_type n) const 
+    { 
+        return wrapper_cast<WrapperT>(raw() + n * kStride); 
+    }
+
+    WrapperSpanIterator& operator ++ ()     
+    { 
+        *this += 1; 
+        if (m_lookahead && m_end - raw() > m_lookahead) 
+        {
+            platform::prefetchRange(raw() + m_lookahead, kStride);
+        }
+        return *this;
+    }
+
+    WrapperSpanIterator& operator -- ()     { return *this -= 1; }
+    WrapperSpanIterator operator ++ (int)   { auto tmp = *this; ++*this; return tmp; }
+    WrapperSpanIterator operator -- (int)   { auto tmp = *this; --*this; return tmp; }
+
+    WrapperSpanIterator& operator += (difference_type n) 
+    { 
+        rebind(raw() + n * static_cast<difference_type>(kStride)); 
+        return *this; 
+    }
+
+    WrapperSpanIterator& operator -= (difference_type n) { return *this += -n; }
+
+    WrapperSpanIterator operator + (difference_type n) const 
+    { 
+        auto tmp = *this;
+        return tmp += n;
+    }
+
+    WrapperSpanIterator operator - (difference_type n) const { return *this + -n; }
+
+    friend WrapperSpanIterator operator + (difference_type n, const WrapperSpanIterator& it)
+    {
+        return it + n;
+    }
+
+    difference_type operator - (const WrapperSpanIterator& rhs) const
+    {
+        return (raw() - rhs.raw()) / static_cast<difference_type>(kStride);
+    }
+
+    bool operator == (const WrapperSpanIterator& rhs) const { return raw() == rhs.raw(); }
+    bool operator != (const WrapperSpanIterator& rhs) const { return raw() != rhs.raw(); }
+    bool operator <  (const WrapperSpanIterator& rhs) const { return raw() <  rhs.raw(); }
+    bool operator >  (const WrapperSpanIterator& rhs) const { return raw() >  rhs.raw(); }
+    bool operator <= (const WrapperSpanIterator& rhs) const { return raw() <= rhs.raw(); }
+    bool operator >= (const WrapperSpanIterator& rhs) const { return raw() >= rhs.raw(); }
+private:
+    void rebind(void* raw) { m_wrapper.ClassWrapper::rebind(raw); }
+private:
+    mutable WrapperT m_wrapper;
+    difference_type m_lookahead = 0;
+    const uint8_t* m_end = nullptr;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [WrapperSpan]                                                                                  //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Typed view over a contiguous, dynamically sized array of wrapped objects.
+ * @tparam  WrapperT    Type of the wrapper, derived from `AdvancedClassWrapper`.
+ * @see     WrapperSpanIterator
+ */
+template<typename WrapperT>
+class WrapperSpan
+{
+public:
+    using Weak      = WeakWrapper<WrapperT>;
+    using iterator  = WrapperSpanIterator<WrapperT>;
+
+    /**
+     * @brief   Constructor.
+     * @param   first   Pointer to the first object.
+     * @param   count   The number of objects.
+     */
+    WrapperSpan(Weak* first, std::size_t count)
+        : m_first{first}
+        , m_count{count}
+    {}
+
+    /**
+     * @brief   Constructor.
+     * @param   first               Pointer to the first object.
+     * @param   count               The number of objects.
+     * @param   prefetchDistance    The distance in elements iterators prefetch ahead.
+     */
+    WrapperSpan(Weak* first, std::size_t count, std::size_t prefetchDistance)
+        : m_first{first}
+        , m_count{count}
+        , m_prefetchDistance{prefetchDistance}
+    {}
+
+    /**
+     * @brief   Constructor.
+     * @param   first   Raw pointer to the first object.
+     * @param   count   The number of objects.
+     */
+    WrapperSpan(void* first, std::size_t count)
+        : WrapperSpan{static_cast<Weak*>(first), count}
+    {}
+
+    /**
+     * @brief   Gets an iterator to the first object.
+     * @return  The iterator.
+     */
+    iterator begin() const { return iterator{m_first, m_prefetchDistance, m_first + m_count}; }
+
+    /**
+     * @brief   Gets an iterator past the last object.
+     * @return  The iterator.
+     */
+    iterator end() const 
+    { 
+        return iterator{m_first + m_count, m_prefetchDistance, m_first + m_count}; 
+    }
+
+    /**
+     * @brief   Creates a view of the same objects whose iterators prefetch ahead.
+     * @param   distance    The distance in elements, 0 to disable prefetching.
+     * @return  The span.
+     *          
+     * Distances should cover the memory latency, e.g. 4 to 16 objects for cheap loop bodies.
+     */
+    WrapperSpan prefetched(std::size_t distance) const 
+    { 
+        return WrapperSpan{m_first, m_count, distance}; 
+    }
+
+    /**
+     * @brief   Gets the number of objects.
+     * @return  The number of objects.
+     */
+    std::size_t size() const { return m_count; }
+
+    /**
+     * @brief   Determines whether the span is empty.
+     * @return  @c true if empty, else @c false.
+     */
+    bool empty() const { return !m_count; }
+
+    /**
+     * @brief   Gets a pointer to the first object.
+     * @return  The pointer.
+     */
+    Weak* data() const { return m_first; }
+
+    /**
+     * @brief   Creates a wrapper for an object.
+     * @param   idx The index of the object.
+     * @return  The wrapper.
+     */
+    WrapperT operator [] (std::size_t idx) const { return m_first[idx].toStrong(); }
+private:
+    Weak* m_first;
+    std::size_t m_count;
+    std::size_t m_prefetchDistance = 0;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+// [extractBitField]                                                                              //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Extracts a `BitField` from every object of a span into a contiguous output array.
+ * @tparam  WrapperT    Type of the wrapper.
+ * @tparam  FieldT      Type of the bit field.
+ * @param   span        The span.
+ * @param   field       The bit field member of the wrapper.
+ * @param   out         The output array, large enough to hold one element per object.
+ * @note    The storage unit is required to be located at the same offset in every object. It is
+ *          resolved by wrapping the first object once, no wrappers are created afterwards.
+ */
+template<typename WrapperT, typename FieldT>
+inline void extractBitField(const WrapperSpan<WrapperT>& span, FieldT WrapperT::* field, 
+    typename FieldT::ValueType* out)
+{
+    if (span.empty()) return;
+
+    auto first = span[0];
+    auto bytes = static_cast<const uint8_t*>(first.addressOfObj());
+    auto offs  = reinterpret_cast<const uint8_t*>((first.*field).addressOfObj()) - bytes;
+
+    for (std::size_t i = 0; i < span.size(); ++i)
+    {
+        typename FieldT::Storage unit;
+        std::memcpy(&unit, bytes + i * WrapperT::kObjSize + offs, sizeof(unit));
+        out[i] = FieldT::extract(unit);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+} // namespace remodel
+
+#endif // REMODEL_WRAPPERSPAN_HPP
@@ -0,0 +1,294 @@
+/**
+ * This file is part of the remodel library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Hner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef REMODEL_XREF_HPP
+#define REMODEL_XREF_HPP
+
+/**     
+ * @file
+ * @brief Contains an index of the code references of a module.
+ *        
+ * `XrefIndex` decodes the code sections of a module once, recording every RIP-relative memory 
+ * operand (absolute `disp32` operands on x86) and relative `call`/`jmp` into the module. Queries
+ * are binary searches over the recorded references afterwards, instead of scanning the code again
+ * for every global.
+ *
+ * @code
+ *      XrefIndex xrefs;
+ *      xrefs.build(module);
+ *      
+ *      // Who references the string?
+ *      xrefs.forEachReferrer(stringAddress, [](const Xref& xref) { ... });
+ *      
+ *      // What globals does the function load?
+ *      xrefs.forEachReference(function, functionSize, [&](const Xref& xref) 
+ *      { 
+ *          if (xref.kind == XrefKind::Data) globals.push_back(xrefs.address(xref.target));
+ *      });
+ * @endcode
+ * 
+ * Code is decoded linearly, bytes that don't decode are skipped one at a time. Data embedded in 
+ * code may thus yield spurious references, only those targeting the module's image are kept.
+ */
+
+#include "Remodel.hpp"
+#include "Hook.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace remodel
+{
+
+// ---------------------------------------------------------------------------------------------- //
+// [XrefIndex]                                                                                    //
+// ---------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief   Kinds of code references.
+ */
+enum class XrefKind : uint8_t
+{
+    /// A memory operand, e.g. `mov rax, [rip+disp]` or `lea rcx, [rip+disp]`.
+    Data,
+    /// A relative `call`.
+    Call,
+    /// A relative `jmp` or conditional jump.
+    Jump,
+};
+
+/**
+ * @brief   A code reference, addresses are RVAs.
+ */
+struct Xref
+{
+    /// The instruction referencing the target.
+    uint32_t referrer;
+    /// The address referenced.
+    uint32_t target;
+    /// The kind of reference.
+    XrefKind kind;
+};
+
+/**
+ * @brief   Index of the code references of a module, queryable by target and by referrer.
+ *          
+ * References are stored once, ordered by referrer, plus a table of indices ordered by target.
+ * That's 16 bytes per reference.
+ */
+class XrefIndex
+{
+public:
+    /**
+     * @brief   Builds the index over the executable sections of a module.
+     * @param   module  The module.
+     * @return  The number of references found.
+     */
+    std::size_t build(const Module& module)
+    {
+        m_xrefs.clear();
+        m_byTarget.clear();
+        m_moduleBase = reinterpret_cast<uintptr_t>(module.addressOfObj());
+        auto imageSize = module.imageSize();
+
+        for (const auto& section : module.sections())
+        {
+            if (section.executable) addSection(section.begin, section.size, imageSize);
+        }
+        std::sort(m_xrefs.begin(), m_xrefs.end(), 
+            [](const Xref& a, const Xref& b) { return a.referrer < b.referrer; });
+
+        m_byTarget.resize(m_xrefs.size());
+        for (std::size_t i = 0; i < m_byTarget.size(); ++i) 
+            m_byTarget[i] = static_cast<uint32_t>(i);
+        std::stable_sort(m_byTarget.begin(), m_byTarget.end(), [this](uint32_t a, uint32_t b) 
+        { 
+            return m_xrefs[a].target < m_xrefs[b].target; 
+        });
+        return m_xrefs.size();
+    }
+
+    /**
+     * @brief   Gets the number of references.
+     */
+    std::size_t size() const { return m_xrefs.size(); }
+
+    /**
+     * @brief   Gets the references, ordered by referrer.
+     */
+    const std::vector<Xref>& xrefs() const { return m_xrefs; }
+
+    /**
+     * @brief   Gets the base of the module the RVAs are relative to.
+     */
+    uintptr_t moduleBase() const { return m_moduleBase; }
+
+    /**
+     * @brief   Converts an RVA of a reference to an absolute address.
+     * @param   rva The RVA.
+     * @return  The address.
+     */
+    uintptr_t address(uint32_t rva) const { return m_moduleBase + rva; }
+
+    /**
+     * @brief   Invokes a function for every reference to an address.
+     * @param   target  The address.
+     * @param   func    The function, taking a `const Xref&`, in order of referrers.
+     * @return  The number of references.
+     */
+    template<typename FuncT>
+    std::size_t forEachReferrer(const void* target, FuncT&& func) const
+    {
+        uint32_t rva;
+        if (!toRva(target, rva)) return 0;
+
+        std::size_t count = 0;
+        for (auto it = lowerBound(rva); it != m_byTarget.end() && m_xrefs[*it].target == rva; 
+            ++it, ++count) func(m_xrefs[*it]);
+        return count;
+    }
+
+    /**
+     * @brief   Invokes a function for every reference made by the instructions in a range, e.g. 
+     *          a function.
+     * @param   begin   The start of the range.
+     * @param   size    The size of the range, in bytes.
+     * @param   func    The function, taking a `const Xref&`, in order of referrers.
+     * @return  The number of references.
+     */
+    template<typename FuncT>
+    std::size_t forEachReference(const void* begin, std::size_t size, FuncT&& func) const
+    {
+        uint32_t rva;
+        if (!toRva(begin, rva)) return 0;
+
+        auto first = std::lower_bound(m_xrefs.begin(), m_xrefs.end(), rva, 
+            [](const Xref& xref, uint32_t value) { return xref.referrer < value; });
+        std::size_t count = 0;
+        for (auto it = first; it != m_xrefs.end() && it->referrer - rva < size; ++it, ++count) 
+            func(*it);
+        return count;
+    }
+
+    /**
+     * @brief   Gets the first instruction referencing an address.
+     * @param   target  The address.
+     * @return  The address of the instruction, zero if unreferenced.
+     */
+    uintptr_t firstReferrer(const void* target) const
+    {
+        uint32_t rva;
+        if (!toRva(target, rva)) return 0;
+
+        auto it = lowerBound(rva);
+        return it != m_byTarget.end() && m_xrefs[*it].target == rva 
+            ? address(m_xrefs[*it].referrer) : 0;
+    }
+private:
+    std::vector<uint32_t>::const_iterator lowerBound(uint32_t targetRva) const
+    {
+        return std::lower_bound(m_byTarget.begin(), m_byTarget.end(), targetRva, 
+            [this](uint32_t idx, uint32_t rva) { return m_xrefs[idx].target < rva; });
+    }
+
+    bool toRva(const void* ptr, uint32_t& rva) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        if (addr < m_moduleBase || addr - m_moduleBase > UINT32_MAX) return false;
+        rva = static_cast<uint32_t>(addr - m_moduleBase);
+        return true;
+    }
+
+    void addSection(const uint8_t* begin, std::size_t size, std::size_t imageSize)
+    {
+        const bool kIs64 = sizeof(void*) == 8;
+        const std::size_t kMaxInsn = 15;
+
+        // The decoder reads up to 15 bytes, the tail of the section is decoded from a copy.
+        uint8_t tail[2 * kMaxInsn] = {};
+        for (std::size_t offset = 0; offset < size;)
+        {
+            auto code = begin + offset;
+            if (size - offset < kMaxInsn)
+            {
+                std::memcpy(tail, code, size - offset);
+                code = tail;
+            }
+
+            internal::X86Instruction insn;
+            if (!internal::decodeX86(code, kIs64, insn) || offset + insn.length > size)
+            {
+                ++offset;
+                continue;
+            }
+
+            auto insnAddr = reinterpret_cast<uintptr_t>(begin + offset);
+            auto next     = insnAddr + insn.length;
+            if (kIs64 && insn.ripDispOffset >= 0)
+            {
+                add(insnAddr, next + readDisp(code + insn.ripDispOffset, 4), XrefKind::Data, 
+                    imageSize);
+            }
+            else if (!kIs64 && insn.dispOffset >= 0 && insn.dispSize == 4 
+                && (code[insn.dispOffset - 1] & 0xC7) == 0x05)
+            {
+                // `mod == 0` with a `disp32` base, an absolute (possibly indexed) address.
+                add(insnAddr, readDisp(code + insn.dispOffset, 4), XrefKind::Data, imageSize);
+            }
+            if (insn.relOffset >= 0 && insn.branch != internal::X86Branch::Loop)
+            {
+                add(insnAddr, next + readDisp(code + insn.relOffset, insn.relSize), 
+                    insn.branch == internal::X86Branch::Call ? XrefKind::Call : XrefKind::Jump,
+                    imageSize);
+            }
+            offset += insn.length;
+        }
+    }
+
+    static uintptr_t readDisp(const uint8_t* code, std::size_t size)
+    {
+        if (size == 1) return static_cast<uintptr_t>(static_cast<intptr_t>(
+            static_cast<int8_t>(*code)));
+        int32_t disp;
+        std::memcpy(&disp, code, sizeof(disp));
+        return static_cast<uintptr_t>(static_cast<intptr_t>(disp));
+    }
+
+    void add(uintptr_t insnAddr, uintptr_t target, XrefKind kind, std::size_t imageSize)
+    {
+        if (target < m_moduleBase || target - m_moduleBase >= imageSize) return;
+        m_xrefs.push_back({static_cast<uint32_t>(insnAddr - m_moduleBase), 
+            static_cast<uint32_t>(target - m_moduleBase), kind});
+    }
+private:
+    std::vector<Xref>     m_xrefs;
+    std::vector<uint32_t> m_byTarget;
+    uintptr_t             m_moduleBase = 0;
+};
+
+// ============================================================================================== //
+
+} // namespace remodel
+
+#endif // REMODEL_XREF_HPP
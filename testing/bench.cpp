@@ -0,0 +1,1906 @@
+#include "Remodel.hpp"
+#include "Gather.hpp"
+#include "Scanner.hpp"
+#include "InstantiablePool.hpp"
+#include "Diff.hpp"
+#include "PacketView.hpp"
+#include "SafeRead.hpp"
+#include "Intrusive.hpp"
+#include "StlLayouts.hpp"
+#include "InstanceScan.hpp"
+#include "LayoutProfile.hpp"
+#include "Trace.hpp"
+#include "SharedSnapshot.hpp"
+#include "Marshal.hpp"
+#include "WrapperPool.hpp"
+#include "Capture.hpp"
+#include "Parallel.hpp"
+#include "ColumnCache.hpp"
+#include "Query.hpp"
+#include "FieldIndex.hpp"
+#include "Hook.hpp"
+#include "TypeRegistry.hpp"
+#include "Xref.hpp"
+#include "ReadView.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace remodel;
+
+namespace
+{
+
+// ============================================================================================== //
+// Benchmark infrastructure                                                                       //
+// ============================================================================================== //
+
+const std::size_t kIterations  = 10000000;
+const std::size_t kRepetitions = 5;
+
+#ifndef ZYCORE_GNUC
+volatile const void* g_sink;
+#endif
+
+/**
+ * @brief   Prevents the compiler from optimizing away the computation of @c value.
+ * @param   value   The value to keep alive.
+ */
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#   ifdef ZYCORE_GNUC
+        asm volatile("" : : "r,m"(value) : "memory");
+#   else
+        g_sink = &value;
+#   endif
+}
+
+/**
+ * @brief   Hides the value of a pointer from the optimizer, preventing constant propagation.
+ * @param   ptr The pointer to launder.
+ * @return  @c ptr.
+ */
+template<typename T>
+inline T* opaque(T* ptr)
+{
+    T* volatile laundered = ptr;
+    return laundered;
+}
+
+/**
+ * @brief   Measures the average run-time of a function.
+ * @param   func        The function to measure, invoked with the iteration index.
+ * @param   iterations  The number of iterations per repetition.
+ * @return  The best average time of all repetitions, in nanoseconds per iteration.
+ */
+template<typename FuncT>
+double measure(FuncT&& func, std::size_t iterations = kIterations)
+{
+    double best = 0.;
+    for (std::size_t rep = 0; rep < kRepetitions; ++rep)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            func(i);
+        }
+        std::chrono::duration<double, std::nano> elapsed
+            = std::chrono::high_resolution_clock::now() - start;
+
+        double avg = elapsed.count() / iterations;
+        best = rep ? std::min(best, avg) : avg;
+    }
+    return best;
+}
+
+/**
+ * @brief   State of a regression gate run (`--gate`), in which only `gate` comparisons run.
+ */
+struct GateState
+{
+    bool        active      = false;
+    double      maxRatio    = 1.5;
+    std::size_t failures    = 0;
+};
+
+GateState g_gate;
+
+/// Absolute overhead always tolerated by gates, timer noise of sub-nanosecond operations.
+const double kGateSlackNs = 0.25;
+/// The number of measurements before a gate fails.
+const std::size_t kGateAttempts = 5;
+
+/**
+ * @brief   Measures a wrapped operation against its handwritten baseline and prints the result.
+ * @param   name        The name of the benchmark.
+ * @param   baseline    The handwritten raw-pointer implementation.
+ * @param   wrapped     The implementation using remodel.
+ * @param   iterations  The number of iterations per repetition.
+ * @param   gated       Whether exceeding the ratio of a gate run fails it.
+ * @return  The ratio of the wrapped to the baseline time.
+ */
+template<typename BaselineT, typename WrappedT>
+double measureRatio(const char* name, BaselineT&& baseline, WrappedT&& wrapped, 
+    std::size_t iterations, bool gated)
+{
+    double baselineNs = 0., wrappedNs = 0., ratio = 0.;
+    auto exceeded = [&] 
+    { 
+        return ratio > g_gate.maxRatio && wrappedNs - baselineNs > kGateSlackNs; 
+    };
+    // Gates remeasure before failing, a single noisy repetition set shouldn't fail a build.
+    for (std::size_t attempt = 0; attempt < (gated ? kGateAttempts : 1); ++attempt)
+    {
+        baselineNs = measure(baseline, iterations);
+        wrappedNs  = measure(wrapped, iterations);
+        ratio      = baselineNs > 0. ? wrappedNs / baselineNs : 0.;
+        if (!exceeded()) break;
+    }
+    std::printf("%-40s %10.3f ns %10.3f ns %8.2fx", name, baselineNs, wrappedNs, ratio);
+    if (gated && exceeded())
+    {
+        std::printf("  FAILED (> %.2fx)", g_gate.maxRatio);
+        ++g_gate.failures;
+    }
+    std::printf("\n");
+    return ratio;
+}
+
+/**
+ * @brief   Measures a wrapped operation against its handwritten baseline and prints the result.
+ *          Skipped in gate runs.
+ * @param   name        The name of the benchmark.
+ * @param   baseline    The handwritten raw-pointer implementation.
+ * @param   wrapped     The implementation using remodel.
+ * @param   iterations  The number of iterations per repetition.
+ */
+template<typename BaselineT, typename WrappedT>
+void compare(const char* name, BaselineT&& baseline, WrappedT&& wrapped, 
+    std::size_t iterations = kIterations)
+{
+    if (g_gate.active) return;
+    measureRatio(name, baseline, wrapped, iterations, false);
+}
+
+/**
+ * @brief   Compares an operation promised to be zero-overhead against its raw-pointer baseline.
+ *          In gate runs, exceeding the maximum ratio fails the run.
+ * @copydetails compare
+ */
+template<typename BaselineT, typename WrappedT>
+void gate(const char* name, BaselineT&& baseline, WrappedT&& wrapped, 
+    std::size_t iterations = kIterations)
+{
+    measureRatio(name, baseline, wrapped, iterations, g_gate.active);
+}
+
+// ============================================================================================== //
+// [wrapper_cast] benchmarks                                                                      //
+// ============================================================================================== //
+
+struct Raw16
+{
+    int f[16];
+};
+
+class Wrap1 : public AdvancedClassWrapper<sizeof(Raw16)>
+{
+    REMODEL_ADV_WRAPPER(Wrap1)
+public:
+    Field<int> f0{this, offsetof(Raw16, f[0])};
+};
+
+class Wrap4 : public AdvancedClassWrapper<sizeof(Raw16)>
+{
+    REMODEL_ADV_WRAPPER(Wrap4)
+public:
+    Field<int> f0{this, offsetof(Raw16, f[0])};
+    Field<int> f1{this, offsetof(Raw16, f[1])};
+    Field<int> f2{this, offsetof(Raw16, f[2])};
+    Field<int> f3{this, offsetof(Raw16, f[3])};
+};
+
+class Wrap16 : public AdvancedClassWrapper<sizeof(Raw16)>
+{
+    REMODEL_ADV_WRAPPER(Wrap16)
+public:
+    Field<int> f0 {this, offsetof(Raw16, f[0 ])};
+    Field<int> f1 {this, offsetof(Raw16, f[1 ])};
+    Field<int> f2 {this, offsetof(Raw16, f[2 ])};
+    Field<int> f3 {this, offsetof(Raw16, f[3 ])};
+    Field<int> f4 {this, offsetof(Raw16, f[4 ])};
+    Field<int> f5 {this, offsetof(Raw16, f[5 ])};
+    Field<int> f6 {this, offsetof(Raw16, f[6 ])};
+    Field<int> f7 {this, offsetof(Raw16, f[7 ])};
+    Field<int> f8 {this, offsetof(Raw16, f[8 ])};
+    Field<int> f9 {this, offsetof(Raw16, f[9 ])};
+    Field<int> f10{this, offsetof(Raw16, f[10])};
+    Field<int> f11{this, offsetof(Raw16, f[11])};
+    Field<int> f12{this, offsetof(Raw16, f[12])};
+    Field<int> f13{this, offsetof(Raw16, f[13])};
+    Field<int> f14{this, offsetof(Raw16, f[14])};
+    Field<int> f15{this, offsetof(Raw16, f[15])};
+};
+
+class Wrap16Static : public AdvancedClassWrapper<sizeof(Raw16)>
+{
+    REMODEL_ADV_WRAPPER(Wrap16Static)
+public:
+    StaticField<int, offsetof(Raw16, f[0 ])> f0 {this};
+    StaticField<int, offsetof(Raw16, f[1 ])> f1 {this};
+    StaticField<int, offsetof(Raw16, f[2 ])> f2 {this};
+    StaticField<int, offsetof(Raw16, f[3 ])> f3 {this};
+    StaticField<int, offsetof(Raw16, f[4 ])> f4 {this};
+    StaticField<int, offsetof(Raw16, f[5 ])> f5 {this};
+    StaticField<int, offsetof(Raw16, f[6 ])> f6 {this};
+    StaticField<int, offsetof(Raw16, f[7 ])> f7 {this};
+    StaticField<int, offsetof(Raw16, f[8 ])> f8 {this};
+    StaticField<int, offsetof(Raw16, f[9 ])> f9 {this};
+    StaticField<int, offsetof(Raw16, f[10])> f10{this};
+    StaticField<int, offsetof(Raw16, f[11])> f11{this};
+    StaticField<int, offsetof(Raw16, f[12])> f12{this};
+    StaticField<int, offsetof(Raw16, f[13])> f13{this};
+    StaticField<int, offsetof(Raw16, f[14])> f14{this};
+    StaticField<int, offsetof(Raw16, f[15])> f15{this};
+};
+
+template<typename WrapperT>
+void benchWrapperCast(const char* name)
+{
+    Raw16 raw{};
+    Raw16* ptr = opaque(&raw);
+
+    compare(name,
+        [&](std::size_t) { doNotOptimize(ptr->f[0]); },
+        [&](std::size_t) { doNotOptimize(static_cast<int>(wrapper_cast<WrapperT>(ptr).f0)); }
+    );
+}
+
+class WrapChained : public AdvancedClassWrapper<sizeof(Raw16)>
+{
+    REMODEL_ADV_WRAPPER(WrapChained)
+public:
+    // Chains exceed the inline buffer of the default getter, so copies allocate.
+    Field<int> f0{this, PtrChainGetter{{0, offsetof(Raw16, f[0])}}};
+    Field<int> f1{this, PtrChainGetter{{0, offsetof(Raw16, f[1])}}};
+    Field<int> f2{this, PtrChainGetter{{0, offsetof(Raw16, f[2])}}};
+    Field<int> f3{this, PtrChainGetter{{0, offsetof(Raw16, f[3])}}};
+};
+
+template<typename WrapperT>
+void benchWrapperMove(const char* name)
+{
+    Raw16 raw{};
+    auto wrapper = wrapper_cast<WrapperT>(opaque(&raw));
+
+    compare(name,
+        [&](std::size_t) 
+        { 
+            WrapperT copy{wrapper};
+            doNotOptimize(copy.addressOfObj()); 
+        },
+        [&](std::size_t) 
+        { 
+            WrapperT moved{std::move(wrapper)};
+            doNotOptimize(moved.addressOfObj()); 
+            wrapper.ClassWrapper::rebind(moved.addressOfObj());
+        }
+    );
+}
+
+void benchWrapperCasts()
+{
+    benchWrapperCast<Wrap1       >("wrapper_cast, 1 field"           );
+    benchWrapperCast<Wrap4       >("wrapper_cast, 4 fields"          );
+    benchWrapperCast<Wrap16      >("wrapper_cast, 16 fields"         );
+    benchWrapperCast<Wrap16Static>("wrapper_cast, 16 static fields"  );
+
+    benchWrapperMove<Wrap16     >("copy vs move, 16 fields"         );
+    benchWrapperMove<WrapChained>("copy vs move, 4 chained fields"  );
+}
+
+// ============================================================================================== //
+// [Field] benchmarks                                                                             //
+// ============================================================================================== //
+
+struct Inner
+{
+    int a;
+    int b;
+};
+
+struct RawFields
+{
+    int   arith;
+    int*  ptr;
+    int   arr[8];
+    Inner inner;
+};
+
+const auto kArithGetter = [](void* raw) -> void* { return &static_cast<RawFields*>(raw)->arith; };
+
+class WrapFields : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapFields)
+public:
+    Field<int>    arith{this, offsetof(RawFields, arith)};
+    Field<int*>   ptr  {this, offsetof(RawFields, ptr  )};
+    Field<int[8]> arr  {this, offsetof(RawFields, arr  )};
+    Field<Inner>  inner{this, offsetof(RawFields, inner)};
+
+    StaticField<int,    offsetof(RawFields, arith)> sArith{this};
+    StaticField<int*,   offsetof(RawFields, ptr  )> sPtr  {this};
+    StaticField<int[8], offsetof(RawFields, arr  )> sArr  {this};
+    StaticField<Inner,  offsetof(RawFields, inner)> sInner{this};
+};
+
+class WrapErasedGetter : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapErasedGetter)
+public:
+    Field<int> arith{this, kArithGetter};
+};
+
+class WrapInlineGetter : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapInlineGetter)
+public:
+    Field<int, decltype(kArithGetter)> arith{this, kArithGetter};
+};
+
+void benchFields()
+{
+    int pointee = 0;
+    RawFields raw{};
+    raw.ptr = &pointee;
+
+    RawFields* r = opaque(&raw);
+    WrapFields w = wrapper_cast<WrapFields>(r);
+
+    compare("Field<int> read/write",
+        [&](std::size_t i) { r->arith += static_cast<int>(i); doNotOptimize(r->arith); },
+        [&](std::size_t i) { w.arith += static_cast<int>(i); doNotOptimize(w.arith + 0); }
+    );
+    gate("StaticField<int> read/write",
+        [&](std::size_t i) { r->arith += static_cast<int>(i); doNotOptimize(r->arith); },
+        [&](std::size_t i) { w.sArith += static_cast<int>(i); doNotOptimize(w.sArith + 0); }
+    );
+    compare("lambda getter: type-erased vs inline",
+        [&](std::size_t) 
+        { 
+            doNotOptimize(static_cast<int>(wrapper_cast<WrapErasedGetter>(r).arith)); 
+        },
+        [&](std::size_t) 
+        { 
+            doNotOptimize(static_cast<int>(wrapper_cast<WrapInlineGetter>(r).arith)); 
+        }
+    );
+    auto arith = readField(&WrapFields::arith, w);
+    gate("ReadView, readField<int> read",
+        [&](std::size_t i) { doNotOptimize(opaque(r + (i & 0))->arith); },
+        [&](std::size_t i) { doNotOptimize(ReadView<WrapFields>{opaque(r + (i & 0))}[arith]); }
+    );
+    gate("ReadView, StaticField<int> read",
+        [&](std::size_t i) { doNotOptimize(opaque(r + (i & 0))->arith); },
+        [&](std::size_t i) 
+        { 
+            doNotOptimize(ReadView<WrapFields>{opaque(r + (i & 0))}[&WrapFields::sArith]); 
+        }
+    );
+    compare("Field<int*> read/write",
+        [&](std::size_t i) { *r->ptr = static_cast<int>(i); doNotOptimize(*r->ptr); },
+        [&](std::size_t i) { *w.ptr = static_cast<int>(i); doNotOptimize(*w.ptr); }
+    );
+    gate("StaticField<int*> read/write",
+        [&](std::size_t i) { *r->ptr = static_cast<int>(i); doNotOptimize(*r->ptr); },
+        [&](std::size_t i) { *w.sPtr = static_cast<int>(i); doNotOptimize(*w.sPtr); }
+    );
+    compare("Field<int[8]> read/write",
+        [&](std::size_t i) { r->arr[i & 7] = static_cast<int>(i); doNotOptimize(r->arr[i & 7]); },
+        [&](std::size_t i) { w.arr[i & 7] = static_cast<int>(i); doNotOptimize(w.arr[i & 7]); }
+    );
+    gate("StaticField<int[8]> read/write",
+        [&](std::size_t i) { r->arr[i & 7] = static_cast<int>(i); doNotOptimize(r->arr[i & 7]); },
+        [&](std::size_t i) { w.sArr[i & 7] = static_cast<int>(i); doNotOptimize(w.sArr[i & 7]); }
+    );
+    compare("Field<Inner> read/write",
+        [&](std::size_t i) { r->inner.b = static_cast<int>(i); doNotOptimize(r->inner.a); },
+        [&](std::size_t i) { w.inner->b = static_cast<int>(i); doNotOptimize(w.inner->a); }
+    );
+    gate("StaticField<Inner> read/write",
+        [&](std::size_t i) { r->inner.b = static_cast<int>(i); doNotOptimize(r->inner.a); },
+        [&](std::size_t i) { w.sInner->b = static_cast<int>(i); doNotOptimize(w.sInner->a); }
+    );
+}
+
+// ============================================================================================== //
+// [Function], [MemberFunction] and [VirtualFunction] benchmarks                                  //
+// ============================================================================================== //
+
+int rawAdd(int x, int y)
+{
+    return x + y;
+}
+
+int rawMemberAdd(void* thiz, int x, int y)
+{
+    return x + y + *static_cast<int*>(thiz);
+}
+
+struct RawVirtual
+{
+    void** vftable;
+    int    c;
+};
+
+class WrapVirtual : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapVirtual)
+public:
+    VirtualFunction<int (*)(int, int)>       add      {this, 0};
+    CachedVirtualFunction<int (*)(int, int)> cachedAdd{this, 0};
+};
+
+class WrapMember : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapMember)
+public:
+    MemberFunction<int (*)(int, int)> add{this, reinterpret_cast<uintptr_t>(&rawMemberAdd)};
+};
+
+void benchFunctions()
+{
+    using AddFn       = int (*)(int, int);
+    using MemberAddFn = int (*)(void*, int, int);
+
+    AddFn add = opaque(&rawAdd);
+    Function<AddFn> wrappedAdd{add};
+    gate("Function call",
+        [&](std::size_t i) { doNotOptimize(add(static_cast<int>(i), 1)); },
+        [&](std::size_t i) { doNotOptimize(wrappedAdd(static_cast<int>(i), 1)); }
+    );
+
+    int memberObj = 42;
+    MemberAddFn memberAdd = opaque(&rawMemberAdd);
+    WrapMember wrapMember = wrapper_cast<WrapMember>(opaque(&memberObj));
+    gate("MemberFunction call",
+        [&](std::size_t i) { doNotOptimize(memberAdd(&memberObj, static_cast<int>(i), 1)); },
+        [&](std::size_t i) { doNotOptimize(wrapMember.add(static_cast<int>(i), 1)); }
+    );
+
+#ifdef REMODEL_HAS_HOOKS
+    // Callbacks handed to code expecting a plain function pointer.
+    std::function<int(int, int)> callback = [&](int x, int y) { return wrapMember.add(x, y); };
+    auto thunk = bindThunk(wrapMember.add);
+    auto thunkFn = opaque(thunk.get());
+    compare("callback: std::function vs BoundThunk",
+        [&](std::size_t i) { doNotOptimize(callback(static_cast<int>(i), 1)); },
+        [&](std::size_t i) { doNotOptimize(thunkFn(static_cast<int>(i), 1)); }
+    );
+#endif
+
+    void* vftable[] = {reinterpret_cast<void*>(&rawMemberAdd)};
+    RawVirtual virtualObj{vftable, 42};
+    RawVirtual* v = opaque(&virtualObj);
+    WrapVirtual wrapVirtual = wrapper_cast<WrapVirtual>(v);
+    auto virtualCall = [&](int x)
+    {
+        return reinterpret_cast<MemberAddFn>(v->vftable[0])(&v->c, x, 1);
+    };
+    compare("VirtualFunction call",
+        [&](std::size_t i) { doNotOptimize(virtualCall(static_cast<int>(i))); },
+        [&](std::size_t i) { doNotOptimize(wrapVirtual.add(static_cast<int>(i), 1)); }
+    );
+    gate("CachedVirtualFunction call",
+        [&](std::size_t i) { doNotOptimize(virtualCall(static_cast<int>(i))); },
+        [&](std::size_t i) { doNotOptimize(wrapVirtual.cachedAdd(static_cast<int>(i), 1)); }
+    );
+}
+
+// ============================================================================================== //
+// [InstantiableWrapper] benchmarks                                                               //
+// ============================================================================================== //
+
+void benchInstantiable()
+{
+    compare("InstantiableWrapper construction",
+        [](std::size_t) { Raw16 raw{}; doNotOptimize(raw); },
+        [](std::size_t) { Wrap16::Instantiable inst; doNotOptimize(inst.addressOfObj()); }
+    );
+    compare("InstantiableWrapper construction, static",
+        [](std::size_t) { Raw16 raw{}; doNotOptimize(raw); },
+        [](std::size_t) { Wrap16Static::Instantiable inst; doNotOptimize(inst.addressOfObj()); }
+    );
+
+    // Creating and destroying 1000 heap objects per iteration.
+    const std::size_t kObjects = 1000;
+    std::vector<Wrap16::Instantiable*> heap(kObjects);
+    InstantiablePool<Wrap16> pool{kObjects};
+    compare("Instantiable x1000, new vs pool",
+        [&](std::size_t) 
+        { 
+            for (auto& inst : heap) inst = new Wrap16::Instantiable;
+            doNotOptimize(heap.back());
+            for (auto inst : heap) delete inst;
+        },
+        [&](std::size_t) 
+        { 
+            pool.createMany(kObjects);
+            doNotOptimize(pool[kObjects - 1].addressOfObj());
+            pool.clear();
+        },
+        kIterations / kObjects
+    );
+}
+
+// ============================================================================================== //
+// [gatherFields] benchmarks                                                                      //
+// ============================================================================================== //
+
+struct RawEntity
+{
+    uint32_t id;
+    float    health;
+    uint8_t  pad[56];
+};
+
+class WrapEntity : public AdvancedClassWrapper<sizeof(RawEntity)>
+{
+    REMODEL_ADV_WRAPPER(WrapEntity)
+public:
+    static constexpr FieldDesc<uint32_t, offsetof(RawEntity, id    )> id    {};
+    static constexpr FieldDesc<float,    offsetof(RawEntity, health)> health{};
+
+    Field<uint32_t> dynId    {this, offsetof(RawEntity, id    )};
+    Field<float>    dynHealth{this, offsetof(RawEntity, health)};
+};
+
+void benchGather()
+{
+    const std::size_t kCount = 16384;
+    std::vector<RawEntity> entities(kCount);
+    std::vector<uint32_t>  ids(kCount);
+    std::vector<float>     health(kCount);
+
+    compare("gatherFields, 2 fields of 16384 objects",
+        [&](std::size_t) 
+        {
+            for (std::size_t i = 0; i < kCount; ++i)
+            {
+                auto entity = wrapper_cast<WrapEntity>(&entities[i]);
+                ids[i]    = entity.dynId;
+                health[i] = entity.dynHealth;
+            }
+            doNotOptimize(ids.data());
+        },
+        [&](std::size_t) 
+        {
+            gatherFields<WrapEntity>(entities.data(), kCount,
+                gatherInto(WrapEntity::id,     ids.data()   ),
+                gatherInto(WrapEntity::health, health.data()));
+            doNotOptimize(ids.data());
+        },
+        kIterations / kCount
+    );
+
+    // A tick changing 1% of the objects.
+    auto cache = mirrorFields(&WrapEntity::dynId, &WrapEntity::dynHealth);
+    cache.assign(WrapperSpan<WrapEntity>{entities.data(), kCount});
+    auto tick = [&](std::size_t i)
+    {
+        for (std::size_t k = 0; k < kCount / 100; ++k)
+        {
+            entities[(i * 7919 + k * 101) % kCount].health += 1.f;
+        }
+    };
+    compare("1% changed: gatherFields vs ColumnCache",
+        [&](std::size_t i) 
+        {
+            tick(i);
+            gatherFields<WrapEntity>(entities.data(), kCount,
+                gatherInto(WrapEntity::id,     ids.data()   ),
+                gatherInto(WrapEntity::health, health.data()));
+            doNotOptimize(ids.data());
+        },
+        [&](std::size_t i) 
+        {
+            tick(i);
+            doNotOptimize(cache.refresh());
+        },
+        kIterations / kCount
+    );
+}
+
+// ============================================================================================== //
+// [selectRows] benchmarks                                                                        //
+// ============================================================================================== //
+
+struct RawHorse
+{
+    int32_t age;
+    float   weight;
+    bool    hatesKittehz;
+    uint8_t pad[20];
+};
+
+class WrapHorse : public AdvancedClassWrapper<sizeof(RawHorse)>
+{
+    REMODEL_ADV_WRAPPER(WrapHorse)
+public:
+    Field<int32_t>  age         {this, offsetof(RawHorse, age         )};
+    Field<float>    weight      {this, offsetof(RawHorse, weight      )};
+    Field<bool>     hatesKittehz{this, offsetof(RawHorse, hatesKittehz)};
+    Field<uint8_t>  pad0        {this, offsetof(RawHorse, pad[0]      )};
+    Field<uint8_t>  pad1        {this, offsetof(RawHorse, pad[1]      )};
+    Field<uint32_t> pad4        {this, offsetof(RawHorse, pad[4]      )};
+};
+
+void benchQuery()
+{
+    const std::size_t kCount = 1 << 16;
+    std::vector<RawHorse> horses(kCount);
+    std::mt19937 rng{42};
+    for (auto& horse : horses)
+    {
+        horse.age          = static_cast<int32_t>(rng() % 10);
+        horse.hatesKittehz = rng() % 2 == 0;
+    }
+    WrapperSpan<WrapHorse> span{horses.data(), kCount};
+    auto cache = mirrorFields(&WrapHorse::age, &WrapHorse::hatesKittehz);
+    cache.assign(span);
+
+    std::vector<uint32_t> selection;
+    selection.reserve(kCount);
+    auto lambda = [&](std::size_t) 
+    {
+        selection.clear();
+        for (std::size_t i = 0; i < kCount; ++i)
+        {
+            auto horse = wrapper_cast<WrapHorse>(opaque(&horses[i]));
+            if (horse.age > 5 && horse.hatesKittehz) selection.push_back(static_cast<uint32_t>(i));
+        }
+        doNotOptimize(selection.data());
+    };
+    auto query = column(&WrapHorse::age) > 5 && column(&WrapHorse::hatesKittehz);
+
+    compare("64k rows: lambda vs query over span",
+        lambda,
+        [&](std::size_t) { selectRows(span, query, selection); doNotOptimize(selection.data()); },
+        kIterations / kCount
+    );
+    compare("64k rows: lambda vs query over columns",
+        lambda,
+        [&](std::size_t) { selectRows(cache, query, selection); doNotOptimize(selection.data()); },
+        kIterations / kCount
+    );
+}
+
+// ============================================================================================== //
+// [HashIndex] benchmarks                                                                         //
+// ============================================================================================== //
+
+void benchFieldIndex()
+{
+    const std::size_t kCount = 16384;
+    std::vector<RawEntity> entities(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) entities[i].id = static_cast<uint32_t>(i * 7 + 1);
+    WrapperSpan<WrapEntity> span{entities.data(), kCount};
+    auto byId = hashIndexOf(&WrapEntity::dynId);
+    byId.assign(span);
+
+    compare("find by id: scan vs HashIndex",
+        [&](std::size_t i) 
+        {
+            auto id = static_cast<uint32_t>(i % kCount * 7 + 1);
+            auto found = std::find_if(span.begin(), span.end(), 
+                [&](WrapEntity& entity) { return entity.dynId == id; });
+            doNotOptimize(found.raw());
+        },
+        [&](std::size_t i) 
+        {
+            doNotOptimize(byId.find(static_cast<uint32_t>(i % kCount * 7 + 1)));
+        },
+        kIterations / 1000
+    );
+}
+
+// ============================================================================================== //
+// [findPattern] benchmarks                                                                       //
+// ============================================================================================== //
+
+void benchScanner()
+{
+    // A 64 MiB image of code-like bytes with the signature placed at the very end.
+    const std::size_t kSize = 64 * 1024 * 1024;
+    std::vector<uint8_t> image(kSize);
+    uint32_t state = 0x12345678;
+    for (auto& byte : image)
+    {
+        state = state * 1664525 + 1013904223;
+        byte  = static_cast<uint8_t>(state >> 24);
+    }
+
+    const uint8_t kSignature[] = {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0};
+    std::copy(std::begin(kSignature), std::end(kSignature), image.end() - sizeof(kSignature));
+    Pattern pattern{"48 8B 05 ?? ?? ?? ?? 48 85 C0"};
+
+    // Baseline is the portable memchr based kernel, reported per full scan.
+    compare("findPattern, 64 MiB image",
+        [&](std::size_t) 
+        {
+            doNotOptimize(findPattern(opaque(image.data()), kSize, pattern, ScanKernel::Scalar));
+        },
+        [&](std::size_t) 
+        {
+            doNotOptimize(findPattern(opaque(image.data()), kSize, pattern));
+        },
+        4
+    );
+
+    // Patterns cut out of the last MiB of the image, with wildcards where operands would be.
+    const std::size_t kPatterns = 64;
+    std::vector<Pattern> patterns;
+    PatternBatch batch;
+    for (std::size_t i = 0; i < kPatterns; ++i)
+    {
+        auto offset = kSize - (i + 1) * 16 * 1024;
+        char mask[] = "xx????xxxx";
+        patterns.emplace_back(&image[offset], mask);
+        batch.add(patterns.back());
+    }
+
+    compare("64 patterns, 64 MiB image, batch",
+        [&](std::size_t) 
+        {
+            for (const auto& pattern : patterns)
+            {
+                doNotOptimize(findPattern(opaque(image.data()), kSize, pattern));
+            }
+        },
+        [&](std::size_t) 
+        {
+            batch.reset();
+            batch.scan(opaque(image.data()), kSize);
+            doNotOptimize(batch.address(0));
+        },
+        1
+    );
+
+    compare("64 patterns, 64 MiB image, all threads",
+        [&](std::size_t) 
+        {
+            batch.reset();
+            batch.scan(opaque(image.data()), kSize);
+            doNotOptimize(batch.address(0));
+        },
+        [&](std::size_t) 
+        {
+            batch.reset();
+            batch.scan(opaque(image.data()), kSize, 0);
+            doNotOptimize(batch.address(0));
+        },
+        1
+    );
+}
+
+// ============================================================================================== //
+// [ObjectDiff] benchmarks                                                                        //
+// ============================================================================================== //
+
+struct RawState
+{
+    float values[32];
+};
+
+class WrapState : public AdvancedClassWrapper<sizeof(RawState)>
+{
+    REMODEL_ADV_WRAPPER(WrapState)
+public:
+    Field<float> v0 {this,  0 * 4}; Field<float> v1 {this,  1 * 4}; Field<float> v2 {this,  2 * 4};
+    Field<float> v3 {this,  3 * 4}; Field<float> v4 {this,  4 * 4}; Field<float> v5 {this,  5 * 4};
+    Field<float> v6 {this,  6 * 4}; Field<float> v7 {this,  7 * 4}; Field<float> v8 {this,  8 * 4};
+    Field<float> v9 {this,  9 * 4}; Field<float> v10{this, 10 * 4}; Field<float> v11{this, 11 * 4};
+    Field<float> v12{this, 12 * 4}; Field<float> v13{this, 13 * 4}; Field<float> v14{this, 14 * 4};
+    Field<float> v15{this, 15 * 4};
+};
+
+void benchDiff()
+{
+    RawState a{}, b{};
+    b.values[9] = 1.f;
+    auto wrapA = wrapper_cast<WrapState>(opaque(&a));
+    auto wrapB = wrapper_cast<WrapState>(opaque(&b));
+    ObjectDiff<WrapState> diff{&WrapState::v0, &WrapState::v1, &WrapState::v2, &WrapState::v3,
+        &WrapState::v4, &WrapState::v5, &WrapState::v6, &WrapState::v7, &WrapState::v8, 
+        &WrapState::v9, &WrapState::v10, &WrapState::v11, &WrapState::v12, &WrapState::v13,
+        &WrapState::v14, &WrapState::v15};
+    std::vector<std::size_t> changed;
+    changed.reserve(16);
+
+    compare("diff of 16 fields, per-Field vs ObjectDiff",
+        [&](std::size_t)
+        {
+            changed.clear();
+            Field<float> WrapState::* fields[] = {&WrapState::v0, &WrapState::v1, 
+                &WrapState::v2, &WrapState::v3, &WrapState::v4, &WrapState::v5, &WrapState::v6,
+                &WrapState::v7, &WrapState::v8, &WrapState::v9, &WrapState::v10, 
+                &WrapState::v11, &WrapState::v12, &WrapState::v13, &WrapState::v14, 
+                &WrapState::v15};
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                if (wrapA.*fields[i] != static_cast<float>(wrapB.*fields[i])) changed.push_back(i);
+            }
+            doNotOptimize(changed.size());
+        },
+        [&](std::size_t) { doNotOptimize(diff.changedFields(wrapA, wrapB, changed)); },
+        kIterations / 10
+    );
+}
+
+// ============================================================================================== //
+// [PacketView] benchmarks                                                                        //
+// ============================================================================================== //
+
+class WrapUdpFields : public AdvancedClassWrapper<8>
+{
+    REMODEL_ADV_WRAPPER(WrapUdpFields)
+public:
+    BigEndianField<uint16_t> srcPort{this, 0};
+    BigEndianField<uint16_t> dstPort{this, 2};
+    BigEndianField<uint16_t> length {this, 4};
+    BigEndianField<uint16_t> check  {this, 6};
+};
+
+class WrapUdpDescs : public AdvancedClassWrapper<8>
+{
+    REMODEL_ADV_WRAPPER(WrapUdpDescs)
+public:
+    static constexpr FieldDesc<uint16_t, 0> srcPort{};
+    static constexpr FieldDesc<uint16_t, 2> dstPort{};
+    static constexpr FieldDesc<uint16_t, 4> length {};
+    static constexpr FieldDesc<uint16_t, 6> check  {};
+};
+
+void benchPacketView()
+{
+    const std::size_t kPackets = 256;
+    std::vector<uint8_t> buffer(kPackets * 64, 0x11);
+    std::vector<const void*> packets(kPackets);
+    std::vector<std::size_t> sizes(kPackets, 64);
+    for (std::size_t i = 0; i < kPackets; ++i) packets[i] = buffer.data() + i * 64;
+
+    compare("256 packets, wrapper_cast vs PacketView",
+        [&](std::size_t)
+        {
+            uint32_t sum = 0;
+            for (std::size_t i = 0; i < kPackets; ++i)
+            {
+                auto udp = wrapper_cast<WrapUdpFields>(const_cast<void*>(opaque(packets[i])));
+                sum += udp.length + udp.dstPort;
+            }
+            doNotOptimize(sum);
+        },
+        [&](std::size_t)
+        {
+            uint32_t sum = 0;
+            forEachPacket<WrapUdpDescs>(packets.data(), sizes.data(), kPackets, 
+                [&](PacketView<WrapUdpDescs> udp)
+                {
+                    sum += udp.getUnchecked<ByteOrder::Big>(WrapUdpDescs::length) 
+                        + udp.getUnchecked<ByteOrder::Big>(WrapUdpDescs::dstPort);
+                });
+            doNotOptimize(sum);
+        },
+        kIterations / 100
+    );
+}
+
+// ============================================================================================== //
+// [ReadableRegionMap] benchmarks                                                                 //
+// ============================================================================================== //
+
+void benchSafeRead()
+{
+    auto& map = ReadableRegionMap::process();
+    int value = 42;
+    int* ptr = opaque(&value);
+    map.contains(ptr, sizeof(int));
+
+    compare("deref vs validated deref, process map",
+        [&](std::size_t) { doNotOptimize(*opaque(ptr)); },
+        [&](std::size_t) 
+        { 
+            auto p = opaque(ptr);
+            doNotOptimize(map.contains(p, sizeof(int)) ? *p : 0); 
+        }
+    );
+
+    auto reader = map.reader();
+    compare("deref vs validated deref, held Reader",
+        [&](std::size_t) { doNotOptimize(*opaque(ptr)); },
+        [&](std::size_t) 
+        { 
+            auto p = opaque(ptr);
+            doNotOptimize(reader.contains(p, sizeof(int)) ? *p : 0); 
+        }
+    );
+}
+
+// ============================================================================================== //
+// [PtrChainGetter] benchmarks                                                                    //
+// ============================================================================================== //
+
+void benchPtrChains()
+{
+    // Three levels of 64 byte nodes, linked in random order so every hop misses the cache.
+    const std::size_t kChains = 1 << 16;
+    struct Node { uintptr_t next; uint8_t pad[56]; };
+    std::vector<Node> levels[3];
+    std::vector<void*> raws(kChains), out(kChains);
+    uint32_t seed = 1;
+    auto random = [&] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    for (auto& level : levels) level.resize(kChains);
+    for (std::size_t l = 0; l < 2; ++l)
+    {
+        for (auto& node : levels[l]) node.next = reinterpret_cast<uintptr_t>(
+            &levels[l + 1][random() % kChains]);
+    }
+    for (auto& raw : raws) raw = &levels[0][random() % kChains];
+
+    StaticPtrChainGetter<0, 0, 8> getter;
+    compare("64Ki chains of 3 hops, plain vs resolvePtrChains",
+        [&](std::size_t)
+        {
+            for (std::size_t i = 0; i < kChains; ++i) out[i] = getter(raws[i]);
+            doNotOptimize(out[kChains / 2]);
+        },
+        [&](std::size_t)
+        {
+            resolvePtrChains(getter, raws.data(), out.data(), kChains);
+            doNotOptimize(out[kChains / 2]);
+        },
+        kIterations / 10000
+    );
+}
+
+// ============================================================================================== //
+// [IntrusiveList] benchmarks                                                                     //
+// ============================================================================================== //
+
+struct RawListNode
+{
+    RawListNode* next;
+    int32_t      value;
+    uint8_t      pad[52];
+};
+
+class WrapListNode : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapListNode)
+public:
+    Field<RawListNode*> next{this, offsetof(RawListNode, next)};
+    Field<int32_t>      value{this, offsetof(RawListNode, value)};
+};
+
+void benchIntrusiveList()
+{
+    // Nodes linked in random order, so following the list misses the cache.
+    const std::size_t kNodes = 1 << 16;
+    std::vector<RawListNode> nodes(kNodes);
+    std::vector<std::size_t> order(kNodes);
+    uint32_t seed = 1;
+    for (std::size_t i = 0; i < kNodes; ++i) order[i] = i;
+    for (std::size_t i = kNodes - 1; i > 0; --i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        std::swap(order[i], order[(seed >> 8) % (i + 1)]);
+    }
+    for (std::size_t i = 0; i < kNodes; ++i)
+    {
+        nodes[order[i]].next  = i + 1 < kNodes ? &nodes[order[i + 1]] : nullptr;
+        nodes[order[i]].value = static_cast<int32_t>(i);
+    }
+    auto first = &nodes[order[0]];
+
+    compare("64Ki list nodes, wrapper_cast vs IntrusiveList",
+        [&](std::size_t)
+        {
+            int32_t sum = 0;
+            for (RawListNode* node = first; node; )
+            {
+                auto wrapped = wrapper_cast<WrapListNode>(node);
+                sum += wrapped.value;
+                node = wrapped.next;
+            }
+            doNotOptimize(sum);
+        },
+        [&](std::size_t)
+        {
+            int32_t sum = 0;
+            for (auto& node : IntrusiveList<WrapListNode, offsetof(RawListNode, next)>{first})
+            {
+                sum += node.value;
+            }
+            doNotOptimize(sum);
+        },
+        kIterations / 10000
+    );
+}
+
+// ============================================================================================== //
+// [RemoteHashMap] benchmarks                                                                     //
+// ============================================================================================== //
+
+void benchRemoteHashMap()
+{
+#   if defined(__GLIBCXX__) && _GLIBCXX_USE_CXX11_ABI
+        // Copying the target's map out every tick versus looking up in place.
+        std::unordered_map<uint32_t, int32_t> target;
+        for (uint32_t i = 0; i < 1024; ++i) target[i * 13] = static_cast<int32_t>(i);
+        auto& remote = reinterpret_cast<
+            RemoteHashMap<uint32_t, int32_t, StlAbi::Libstdcxx>&>(target);
+
+        compare("1Ki map, 16 lookups, copy out vs RemoteHashMap",
+            [&](std::size_t i)
+            {
+                std::unordered_map<uint32_t, int32_t> copy{*opaque(&target)};
+                int32_t sum = 0;
+                for (uint32_t j = 0; j < 16; ++j) sum += copy.find((i + j) % 1024 * 13)->second;
+                doNotOptimize(sum);
+            },
+            [&](std::size_t i)
+            {
+                int32_t sum = 0;
+                for (uint32_t j = 0; j < 16; ++j) sum += *remote.find((i + j) % 1024 * 13);
+                doNotOptimize(sum);
+            },
+            kIterations / 1000
+        );
+#   endif
+}
+
+// ============================================================================================== //
+// [VftableScanner] benchmarks                                                                    //
+// ============================================================================================== //
+
+void benchVftableScan()
+{
+    // 64 MiB of heap-like words, pointers and small integers, with a sparse set of instances.
+    const std::size_t kWords = 8 * 1024 * 1024;
+    std::vector<uintptr_t> heap(kWords);
+    uint32_t state = 0x12345678;
+    for (auto& word : heap)
+    {
+        state = state * 1664525 + 1013904223;
+        word  = state & 1 ? reinterpret_cast<uintptr_t>(&heap[state % kWords]) : state >> 20;
+    }
+    const uintptr_t kVftables[] = {0x7FF612340000 & UINTPTR_MAX, 0x7FF612340100 & UINTPTR_MAX};
+    for (std::size_t i = 0; i < kWords; i += 4099) heap[i] = kVftables[i & 1];
+
+    std::vector<const void*> matches;
+    compare("findPointerValues, 2 vftables, 64 MiB",
+        [&](std::size_t)
+        {
+            matches.clear();
+            findPointerValues(opaque(heap.data()), kWords * sizeof(uintptr_t), kVftables, 2,
+                matches, ScanKernel::Scalar);
+            doNotOptimize(matches.size());
+        },
+        [&](std::size_t)
+        {
+            matches.clear();
+            findPointerValues(opaque(heap.data()), kWords * sizeof(uintptr_t), kVftables, 2,
+                matches);
+            doNotOptimize(matches.size());
+        },
+        4
+    );
+
+    // Steady state with 64 dirty pages per tick.
+    VftableScanner scanner;
+    scanner.add(reinterpret_cast<const void*>(kVftables[0]));
+    scanner.add(reinterpret_cast<const void*>(kVftables[1]));
+    scanner.scan(heap.data(), kWords * sizeof(uintptr_t));
+    std::vector<VftableScanner::Range> dirty;
+    auto bytes = reinterpret_cast<const uint8_t*>(heap.data());
+    for (std::size_t i = 0; i < 64; ++i) dirty.push_back({bytes + i * 1024 * 1024, 4096});
+
+    compare("VftableScanner, full rescan vs update of 64 dirty pages",
+        [&](std::size_t)
+        {
+            scanner.reset();
+            scanner.scan(opaque(heap.data()), kWords * sizeof(uintptr_t));
+            doNotOptimize(scanner.candidates(0).size());
+        },
+        [&](std::size_t)
+        {
+            scanner.update(dirty);
+            doNotOptimize(scanner.candidates(0).size());
+        },
+        4
+    );
+}
+
+// ============================================================================================== //
+// [TypeRegistry] benchmarks                                                                      //
+// ============================================================================================== //
+
+class WrapBenchCat : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapBenchCat)
+};
+
+class WrapBenchDog : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapBenchDog)
+};
+
+class WrapBenchBird : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapBenchBird)
+};
+
+class WrapBenchFish : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapBenchFish)
+};
+
+void benchTypeRegistry()
+{
+    // 4096 objects of 32 classes, identified one per iteration.
+    static void* vftables[32][4];
+    TypeRegistry types;
+    std::unordered_map<uintptr_t, const void*> map;
+    for (std::size_t i = 0; i < 32; ++i)
+    {
+        auto type = i % 2 ? typeKeyOf<WrapBenchCat>() : typeKeyOf<WrapBenchDog>();
+        i % 2 ? types.add<WrapBenchCat>(vftables[i]) : types.add<WrapBenchDog>(vftables[i]);
+        map[reinterpret_cast<uintptr_t>(vftables[i])] = type;
+    }
+    std::vector<const void*> objs(4096);
+    uint32_t state = 0x12345678;
+    for (auto& obj : objs)
+    {
+        state = state * 1664525 + 1013904223;
+        obj = vftables[state >> 27];
+    }
+
+    auto objPtrs = opaque(objs.data());
+    compare("type of object: unordered_map vs TypeRegistry",
+        [&](std::size_t i) 
+        { 
+            auto it = map.find(*reinterpret_cast<const uintptr_t*>(&objPtrs[i & 4095]));
+            doNotOptimize(it == map.end() ? nullptr : it->second); 
+        },
+        [&](std::size_t i) { doNotOptimize(types.typeOf(&objPtrs[i & 4095])); }
+    );
+}
+
+void benchTypeSwitch()
+{
+    // 4096 objects of 4 classes, each dispatched to the handler of its type.
+    static void* vftables[4][4];
+    TypeRegistry types;
+    types.add<WrapBenchCat>(vftables[0]);
+    types.add<WrapBenchDog>(vftables[1]);
+    types.add<WrapBenchBird>(vftables[2]);
+    types.add<WrapBenchFish>(vftables[3]);
+    TypeSwitch<WrapBenchCat, WrapBenchDog, WrapBenchBird, WrapBenchFish> onAnimal{types};
+
+    std::vector<const void*> objs(4096);
+    uint32_t state = 0x12345678;
+    for (auto& obj : objs)
+    {
+        state = state * 1664525 + 1013904223;
+        obj = vftables[state >> 30];
+    }
+
+    auto objPtrs = opaque(objs.data());
+    int counts[4] = {};
+    compare("dispatch by type: vftable if/else vs TypeSwitch",
+        [&](std::size_t i) 
+        { 
+            auto vftable = objPtrs[i & 4095];
+            if (vftable == vftables[0])      ++counts[0];
+            else if (vftable == vftables[1]) ++counts[1];
+            else if (vftable == vftables[2]) ++counts[2];
+            else if (vftable == vftables[3]) ++counts[3];
+        },
+        [&](std::size_t i) 
+        { 
+            onAnimal.visit(&objPtrs[i & 4095],
+                [&](WrapBenchCat&) { ++counts[0]; },
+                [&](WrapBenchDog&) { ++counts[1]; },
+                [&](WrapBenchBird&) { ++counts[2]; },
+                [&](WrapBenchFish&) { ++counts[3]; });
+        }
+    );
+    doNotOptimize(counts);
+}
+
+// ============================================================================================== //
+// [LayoutProfile] benchmarks                                                                     //
+// ============================================================================================== //
+
+LayoutTable& benchLayoutTable()
+{
+    static LayoutTable table{1};
+    return table;
+}
+
+class WrapProfiled : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapProfiled)
+public:
+    ProfileField<int> arith{this, ProfileOffsGetter{benchLayoutTable(), 0}};
+};
+
+void benchLayoutProfile()
+{
+    LayoutProfile profile{"bench", 1};
+    profile.set(0, offsetof(RawFields, arith));
+    benchLayoutTable().activate(profile, nullptr);
+
+    RawFields raw{};
+    RawFields* r = opaque(&raw);
+    WrapFields w = wrapper_cast<WrapFields>(r);
+    WrapProfiled p = wrapper_cast<WrapProfiled>(r);
+
+    compare("Field<int> vs ProfileField<int>",
+        [&](std::size_t i) { w.arith += static_cast<int>(i); doNotOptimize(w.arith + 0); },
+        [&](std::size_t i) { p.arith += static_cast<int>(i); doNotOptimize(p.arith + 0); }
+    );
+    compare("StaticField<int> vs ProfileField<int>",
+        [&](std::size_t i) { w.sArith += static_cast<int>(i); doNotOptimize(w.sArith + 0); },
+        [&](std::size_t i) { p.arith += static_cast<int>(i); doNotOptimize(p.arith + 0); }
+    );
+}
+
+// ============================================================================================== //
+// [trace] benchmarks                                                                             //
+// ============================================================================================== //
+
+void benchTrace()
+{
+    using AddFn = int (*)(int, int);
+    AddFn add = opaque(&rawAdd);
+
+    // Draining regularly (like a `TraceWriter` would), so records are never dropped.
+    auto noop = [](const trace::TraceRecord*, std::size_t) {};
+    trace::setEnabled(true);
+    compare("call vs call + trace::emit",
+        [&](std::size_t i) { doNotOptimize(add(static_cast<int>(i), 1)); },
+        [&](std::size_t i) 
+        { 
+            trace::emit(trace::CallKind::User, add, i, 1);
+            doNotOptimize(add(static_cast<int>(i), 1));
+            if (!(i & 1023)) trace::drain(noop);
+        }
+    );
+    trace::setEnabled(false);
+    compare("call vs call + disabled trace::emit",
+        [&](std::size_t i) { doNotOptimize(add(static_cast<int>(i), 1)); },
+        [&](std::size_t i) 
+        { 
+            trace::emit(trace::CallKind::User, add, i, 1);
+            doNotOptimize(add(static_cast<int>(i), 1));
+        }
+    );
+    trace::drain(noop);
+}
+
+// ============================================================================================== //
+// [SharedSnapshotAccessor] benchmarks                                                            //
+// ============================================================================================== //
+
+struct RawSnapshotObj
+{
+    int     health;
+    uint8_t pad[252];
+};
+
+class WrapSnapshotObj : public AdvancedClassWrapper<sizeof(RawSnapshotObj)>
+{
+    REMODEL_ADV_WRAPPER(WrapSnapshotObj)
+public:
+    Field<int> health{this, offsetof(RawSnapshotObj, health)};
+};
+
+void benchSharedSnapshot()
+{
+#if defined(REMODEL_HAS_SHARED_MEMORY) && defined(REMODEL_HAS_PROCESS_MEMORY)
+    RawSnapshotObj obj{};
+    SnapshotPublisher publisher;
+    publisher.add(&obj, sizeof(obj));
+    auto name = "remodel-bench-" + std::to_string(
+        static_cast<unsigned long long>(platform::currentProcess()));
+    if (!publisher.create(name.c_str())) return;
+    SharedSnapshotAccessor snapshots;
+    if (!snapshots.open(name.c_str())) return;
+
+    ProcessMemoryAccessor process{platform::currentProcess()};
+    RemoteInstance<WrapSnapshotObj, ProcessMemoryAccessor> viaProcess{process, &obj};
+    RemoteInstance<WrapSnapshotObj, SharedSnapshotAccessor> viaSnapshot{snapshots, &obj};
+    compare("RemoteInstance refresh: vm_readv vs shm",
+        [&](std::size_t) { viaProcess.refresh(); doNotOptimize(viaProcess->health + 0); },
+        [&](std::size_t) { viaSnapshot.refresh(); doNotOptimize(viaSnapshot->health + 0); },
+        kIterations / 100
+    );
+#endif
+}
+
+void benchPageCache()
+{
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+    // A tick reading 256 small fields spread over 4 pages, as remote wrappers would.
+    std::vector<int> objs(4096);
+    ProcessMemoryAccessor process{platform::currentProcess()};
+    PageCacheAccessor<ProcessMemoryAccessor> cache{process};
+    auto tick = [&](auto& accessor)
+    {
+        int sum = 0;
+        for (std::size_t k = 0; k < 256; ++k)
+        {
+            int value;
+            accessor.read(MemoryRange{reinterpret_cast<uintptr_t>(&objs[k * 13 % 4096]), 
+                &value, sizeof(value)});
+            sum += value;
+        }
+        doNotOptimize(sum);
+    };
+    compare("256 remote reads: vm_readv vs page cache",
+        [&](std::size_t) { tick(process); },
+        [&](std::size_t) { cache.invalidate(); tick(cache); },
+        kIterations / 10000
+    );
+
+    // A tick writing 2 separate fields of 64 objects.
+    WriteCombiningAccessor<ProcessMemoryAccessor> combiner{process};
+    auto writes = [&](auto& accessor)
+    {
+        for (std::size_t k = 0; k < 64; ++k)
+        {
+            int value = static_cast<int>(k);
+            accessor.write(MemoryRange{reinterpret_cast<uintptr_t>(&objs[k * 64]), 
+                &value, sizeof(value)});
+            accessor.write(MemoryRange{reinterpret_cast<uintptr_t>(&objs[k * 64 + 8]), 
+                &value, sizeof(value)});
+        }
+    };
+    compare("128 remote writes: vm_writev vs combined",
+        [&](std::size_t) { writes(process); },
+        [&](std::size_t) { writes(combiner); combiner.flush(); },
+        kIterations / 10000
+    );
+
+#   ifdef REMODEL_HAS_IO_URING
+    // A scan over 1024 remote objects of 64 bytes, spread over separate pages.
+    std::vector<uint8_t> heap(1024 * 4096);
+    std::vector<uint8_t> snapshots(1024 * 64);
+    std::vector<MemoryRange> scan(1024);
+    for (std::size_t k = 0; k < scan.size(); ++k)
+    {
+        scan[k] = {reinterpret_cast<uintptr_t>(&heap[k * 4096]), &snapshots[k * 64], 64};
+    }
+    UringMemoryAccessor uring{platform::currentProcess()};
+    compare("1024 remote objects: vm_readv vs io_uring",
+        [&](std::size_t) { doNotOptimize(process.read(scan.data(), scan.size())); },
+        [&](std::size_t) { doNotOptimize(uring.read(scan.data(), scan.size())); },
+        kIterations / 100000
+    );
+#   endif
+#endif
+}
+
+// ============================================================================================== //
+// [TaskQueue] benchmarks                                                                         //
+// ============================================================================================== //
+
+void benchTaskQueue()
+{
+    std::mutex mutex;
+    std::queue<std::function<void()>> locked;
+    TaskQueue queue{1024};
+    uint64_t sum = 0, a = 1, b = 2, c = 3;
+
+    // Captures exceed the small buffer of common `std::function` implementations.
+    compare("post + drain: locked queue vs TaskQueue",
+        [&](std::size_t i)
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                locked.push([&sum, a, b, c, i] { sum += a + b + c + i; });
+            }
+            if ((i & 63) == 63)
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                for (; !locked.empty(); locked.pop()) locked.front()();
+            }
+        },
+        [&](std::size_t i)
+        {
+            queue.post([&sum, a, b, c, i] { sum += a + b + c + i; });
+            if ((i & 63) == 63) queue.drain();
+        }
+    );
+    doNotOptimize(sum);
+}
+
+// ============================================================================================== //
+// [WrapperPool] benchmarks                                                                       //
+// ============================================================================================== //
+
+void benchWrapperPool()
+{
+    std::vector<Raw16> objs(1024);
+    auto first = opaque(objs.data());
+
+    compare("visit, 16 fields: toStrong vs pooled",
+        [&](std::size_t i) 
+        { 
+            auto weak = reinterpret_cast<Wrap16::Weak*>(first + (i & 1023));
+            doNotOptimize(static_cast<int>(weak->toStrong().f15));
+        },
+        [&](std::size_t i) 
+        { 
+            auto weak = reinterpret_cast<Wrap16::Weak*>(first + (i & 1023));
+            doNotOptimize(static_cast<int>(pooledWrapper(weak)->f15));
+        }
+    );
+}
+
+// ============================================================================================== //
+// [parallelForEach] benchmarks                                                                   //
+// ============================================================================================== //
+
+void benchParallel()
+{
+    std::vector<Raw16> objs(1 << 18);
+    WrapperSpan<Wrap4> span{opaque(objs.data()), objs.size()};
+    auto body = [](Wrap4& obj) { obj.f0 = obj.f1 * 3 + obj.f2 - obj.f3; };
+
+    compare("256k objects: for_each vs parallel",
+        [&](std::size_t) { std::for_each(span.begin(), span.end(), body); },
+        [&](std::size_t) { parallelForEach(span, body); },
+        kIterations / 100000
+    );
+}
+
+// ============================================================================================== //
+// [CaptureWriter] benchmarks                                                                     //
+// ============================================================================================== //
+
+void benchCapture()
+{
+    const std::size_t kObjs = 1024;
+    std::vector<Raw16> objs(kObjs);
+    for (std::size_t i = 0; i < kObjs; ++i)
+    {
+        for (int k = 0; k < 16; ++k) objs[i].f[k] = static_cast<int>(i * 16 + k);
+    }
+
+    // Per-field text, as done before whole-object captures existed.
+    std::string text;
+    std::vector<uint8_t> data;
+    CaptureType<Wrap16> type{"Raw16"};
+    compare("1024 objects, per-field text vs capture",
+        [&](std::size_t)
+        {
+            text.clear();
+            char line[32];
+            for (auto& obj : objs)
+            {
+                auto wrapper = wrapper_cast<Wrap16>(&obj);
+                text += '{';
+                int fields[] = {wrapper.f0, wrapper.f1, wrapper.f2, wrapper.f3, wrapper.f4, 
+                    wrapper.f5, wrapper.f6, wrapper.f7, wrapper.f8, wrapper.f9, wrapper.f10, 
+                    wrapper.f11, wrapper.f12, wrapper.f13, wrapper.f14, wrapper.f15};
+                for (int k = 0; k < 16; ++k)
+                {
+                    text.append(line, std::snprintf(line, sizeof(line), "\"f%d\":%d,", k, 
+                        fields[k]));
+                }
+                text += "},\n";
+            }
+            doNotOptimize(text.data());
+        },
+        [&](std::size_t)
+        {
+            data.clear();
+            CaptureWriter writer{data};
+            for (auto& obj : objs) writer.write(type, &obj);
+            doNotOptimize(data.data());
+        }, 
+        200
+    );
+
+#   ifdef REMODEL_HAS_MAPPED_FILE
+        // Looking up a single object of a 64k object capture.
+        const char* kPath = "remodel_bench.capture";
+        std::vector<Raw16> many(64 * 1024);
+        {
+            CaptureWriter writer{kPath};
+            for (auto& obj : many) writer.write(type, &obj);
+        }
+        auto address = reinterpret_cast<uintptr_t>(&many[many.size() / 2]);
+        compare("64k objects, read + parse vs mmap",
+            [&](std::size_t)
+            {
+                std::vector<uint8_t> file;
+                CaptureReader::readFile(kPath, file);
+                CaptureReader capture{std::move(file)};
+                doNotOptimize(capture.find(address)->bytes[0]);
+            },
+            [&](std::size_t)
+            {
+                MappedCapture capture;
+                capture.open(kPath);
+                doNotOptimize(static_cast<uint8_t*>(capture.resolve(address))[0]);
+            },
+            20
+        );
+        std::remove(kPath);
+#   endif
+}
+
+// ============================================================================================== //
+// [prefetch] benchmarks                                                                          //
+// ============================================================================================== //
+
+void benchPrefetch()
+{
+    // 64 MiB of 128 byte objects visited in random order, far exceeding the caches.
+    const std::size_t kObjs = 512 * 1024;
+    std::vector<Raw16> storage(kObjs * 4);
+    std::vector<void*> raws(kObjs);
+    uint32_t state = 0x12345678;
+    for (std::size_t i = 0; i < kObjs; ++i)
+    {
+        state = state * 1664525 + 1013904223;
+        raws[i] = &storage[i * 4 + (state >> 30)];
+    }
+    std::shuffle(raws.begin(), raws.end(), std::minstd_rand{1});
+
+    InstanceSet<Wrap16Static> set{raws};
+    auto visit = [&](std::size_t distance)
+    {
+        set.setPrefetchDistance(distance);
+        // Some dependent work per object, keeping the out-of-order window from reaching ahead.
+        int sum = 0;
+        for (auto& obj : set) 
+        {
+            int acc = obj.f0;
+            for (int k = 0; k < 32; ++k) acc = acc * 31 + (acc >> 7);
+            sum += acc;
+        }
+        doNotOptimize(sum);
+    };
+    compare("InstanceSet visit, no prefetch vs 8 ahead",
+        [&](std::size_t) { visit(0); }, [&](std::size_t) { visit(8); }, 4);
+}
+
+// ============================================================================================== //
+// Startup benchmarks                                                                             //
+// ============================================================================================== //
+
+const ScanKernel kScanKernels[] = {ScanKernel::Scalar, ScanKernel::Sse2, ScanKernel::Avx2};
+const char* const kScanKernelNames[] = {"scalar", "SSE2", "AVX2"};
+
+/**
+ * @brief   Prints the result of a startup benchmark.
+ * @param   name    The name of the benchmark.
+ * @param   ns      The time of one pass, in nanoseconds.
+ * @param   bytes   The number of bytes processed per pass, zero if not applicable.
+ * @param   items   The number of patterns (or lookups) per pass, zero if not applicable.
+ */
+void report(const std::string& name, double ns, std::size_t bytes, std::size_t items)
+{
+    std::printf("%-52s %10.3f ms", name.c_str(), ns / 1e6);
+    if (bytes) std::printf(" %9.2f GB/s", static_cast<double>(bytes) / ns);
+    else std::printf(" %14s", "");
+    if (items) std::printf(" %12.3f us/item", ns / 1e3 / static_cast<double>(items));
+    std::printf("\n");
+}
+
+/**
+ * @brief   Creates an image of code-like bytes.
+ * @param   size    The size, in bytes.
+ * @return  The image.
+ */
+std::vector<uint8_t> makeCodeImage(std::size_t size)
+{
+    std::vector<uint8_t> image(size);
+    uint32_t state = 0x12345678;
+    for (auto& byte : image)
+    {
+        state = state * 1664525 + 1013904223;
+        byte  = static_cast<uint8_t>(state >> 24);
+    }
+    return image;
+}
+
+/**
+ * @brief   Cuts patterns out of the last part of a range, with wildcards where operands would be.
+ *          The first one ends 6 bytes before the end, so scanning for it passes the whole range.
+ * @param   data    The range.
+ * @param   size    The size of the range, in bytes.
+ * @param   count   The number of patterns.
+ * @return  The patterns, empty if the range is too small.
+ */
+std::vector<Pattern> cutPatterns(const uint8_t* data, std::size_t size, std::size_t count)
+{
+    std::vector<Pattern> patterns;
+    const std::size_t kStride = 4096;
+    if (size < (count + 1) * kStride) return patterns;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        char mask[] = "xx????xxxx";
+        patterns.emplace_back(data + size - 16 - i * kStride, mask);
+    }
+    return patterns;
+}
+
+/**
+ * @brief   Measures single and batched signature scans of a range, with every supported kernel.
+ * @param   label   The name of the range.
+ * @param   data    The range.
+ * @param   size    The size of the range, in bytes.
+ */
+void benchScanKernels(const std::string& label, const uint8_t* data, std::size_t size)
+{
+    auto patterns = cutPatterns(data, size, 64);
+    if (patterns.empty()) 
+    {
+        std::printf("%s: too small to scan\n", label.c_str());
+        return;
+    }
+
+    // Earlier matches end the scan, throughput counts the bytes actually passed.
+    auto match   = findPattern(data, size, patterns.front(), ScanKernel::Scalar);
+    auto scanned = static_cast<std::size_t>(match - data) + patterns.front().size();
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (kScanKernels[i] > bestScanKernel()) continue;
+        auto ns = measure([&](std::size_t)
+        {
+            doNotOptimize(findPattern(opaque(data), size, patterns.front(), kScanKernels[i]));
+        }, 4);
+        report(label + ": findPattern, " + kScanKernelNames[i], ns, scanned, 1);
+    }
+
+    PatternBatch batch;
+    for (const auto& pattern : patterns) batch.add(pattern);
+    for (unsigned threads : {1u, 0u})
+    {
+        auto ns = measure([&](std::size_t)
+        {
+            batch.reset();
+            batch.scan(opaque(data), size, threads);
+            doNotOptimize(batch.address(0));
+        }, 1);
+        report(label + (threads ? ": 64 patterns, batch" : ": 64 patterns, batch, all threads"),
+            ns, size, patterns.size());
+    }
+}
+
+/**
+ * @brief   Measures pointer scans of a range, with every supported kernel.
+ * @param   label   The name of the range.
+ * @param   data    The range, aligned to pointers.
+ * @param   size    The size of the range, in bytes.
+ * @param   values  The pointer values to search for.
+ * @param   count   The number of values.
+ */
+void benchPointerKernels(const std::string& label, const void* data, std::size_t size, 
+    const uintptr_t* values, std::size_t count)
+{
+    std::vector<const void*> matches;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (kScanKernels[i] > bestScanKernel()) continue;
+        auto ns = measure([&](std::size_t)
+        {
+            matches.clear();
+            findPointerValues(opaque(data), size, values, count, matches, kScanKernels[i]);
+            doNotOptimize(matches.size());
+        }, 4);
+        report(label + ": findPointerValues, " + kScanKernelNames[i], ns, size, 0);
+    }
+}
+
+/**
+ * @brief   Measures the startup paths on a loaded module: scans of its sections, indexing and 
+ *          looking up its exports and building its xref index.
+ * @param   label   The name of the module.
+ * @param   module  The module.
+ */
+void benchModule(const std::string& label, const Module& module)
+{
+    std::size_t exec = 0;
+    const platform::ModuleSection* code = nullptr;
+    auto sections = module.sections();
+    for (const auto& section : sections)
+    {
+        if (!section.executable) continue;
+        exec += section.size;
+        if (!code || section.size > code->size) code = &section;
+    }
+    if (code) benchScanKernels(label + " code", code->begin, code->size);
+
+    std::size_t indexed = 0;
+    auto ns = measure([&](std::size_t)
+    {
+        platform::ExportIndex index{opaque(module.addressOfObj())};
+        indexed = index.size();
+        doNotOptimize(indexed);
+    }, 16);
+    report(label + ": ExportIndex build, " + std::to_string(indexed) + " exports", ns, 0, 
+        indexed);
+
+    platform::ExportIndex index{module.addressOfObj()};
+    std::vector<std::string> names;
+    index.forEach([&](const char* name, void*) { names.emplace_back(name); });
+    if (!names.empty())
+    {
+        ns = measure([&](std::size_t)
+        {
+            for (const auto& name : names) doNotOptimize(index.find(name.c_str()));
+        }, 16);
+        report(label + ": ExportIndex lookup", ns, 0, names.size());
+    }
+
+    std::size_t xrefs = 0;
+    ns = measure([&](std::size_t)
+    {
+        XrefIndex index;
+        xrefs = index.build(module);
+        doNotOptimize(xrefs);
+    }, 1);
+    report(label + ": XrefIndex build, " + std::to_string(xrefs) + " refs", ns, exec, 0);
+}
+
+/**
+ * @brief   Runs the startup benchmarks on a user-supplied image.
+ * @param   path    The path of the image. Loaded as a module if possible, else only scanned.
+ */
+void benchImage(const char* path)
+{
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto handle = LoadLibraryExA(path, nullptr, DONT_RESOLVE_DLL_REFERENCES);
+        void* base = handle;
+#   else
+        auto handle = dlopen(path, RTLD_LAZY | RTLD_LOCAL);
+        void* base = handle ? platform::obtainModuleHandle(path) : nullptr;
+#   endif
+    if (base) return benchModule(path, wrapper_cast<Module>(base));
+
+    platform::MappedFile file;
+    if (!file.open(path)) 
+    {
+        std::printf("%s: can't be opened\n", path);
+        return;
+    }
+    benchScanKernels(std::string{path} + " (raw file)", 
+        static_cast<const uint8_t*>(file.data()), file.size());
+}
+
+/**
+ * @brief   Measures the paths run on startup: signature scans, export lookups, xref indexing 
+ *          and object scans, over a synthetic image, the loaded modules and user images.
+ * @param   images  Paths of additional module images.
+ */
+void benchStartup(const std::vector<const char*>& images)
+{
+    std::printf("\n%-52s %13s %14s %20s\n", "startup benchmark", "time", "throughput", 
+        "latency");
+
+    const std::size_t kSize = 64 * 1024 * 1024;
+    auto image = makeCodeImage(kSize);
+    benchScanKernels("synthetic 64 MiB", image.data(), kSize);
+
+    const uintptr_t kValues[] = {reinterpret_cast<uintptr_t>(&image[64]), 
+        reinterpret_cast<uintptr_t>(&image[128])};
+    benchPointerKernels("synthetic 64 MiB", image.data(), kSize, kValues, 2);
+
+    if (auto main = Module::getModule(nullptr)) benchModule("main module", main.value());
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        if (auto ntdll = Module::getModule("ntdll.dll")) benchModule("ntdll.dll", ntdll.value());
+#   elif defined(__linux__)
+        if (auto libc = Module::getModule("libc.so.6")) benchModule("libc.so.6", libc.value());
+#   endif
+    for (auto path : images) benchImage(path);
+}
+
+// ============================================================================================== //
+
+} // anon namespace
+
+/**
+ * Usage: `remodel_bench [--startup] [image...]`. With arguments, only the startup benchmarks run,
+ * including the given module images.
+ * 
+ * `remodel_bench --gate fields|functions [--max-ratio 1.5]` runs the zero-overhead comparisons of
+ * a group and fails if a wrapper exceeds its raw-pointer baseline by more than the ratio.
+ */
+int main(int argc, char** argv)
+{
+    const char* gateName = nullptr;
+    std::vector<const char*> images;
+    for (int i = 1; i < argc; ++i) 
+    {
+        if (!std::strcmp(argv[i], "--gate") && i + 1 < argc) gateName = argv[++i];
+        else if (!std::strcmp(argv[i], "--max-ratio") && i + 1 < argc) 
+            g_gate.maxRatio = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--startup")) images.push_back(argv[i]);
+    }
+
+    if (gateName)
+    {
+        g_gate.active = true;
+        std::printf("%-40s %13s %13s %9s\n", "gate", "baseline", "remodel", "ratio");
+        if (!std::strcmp(gateName, "fields"))
+        {
+            benchWrapperCasts();
+            benchFields();
+        }
+        else if (!std::strcmp(gateName, "functions")) 
+        {
+            benchFunctions();
+        }
+        else
+        {
+            std::printf("unknown gate %s\n", gateName);
+            return 2;
+        }
+        return g_gate.failures ? 1 : 0;
+    }
+    if (argc > 1) 
+    {
+        benchStartup(images);
+        return 0;
+    }
+
+    std::printf("%-40s %13s %13s %9s\n", "benchmark", "baseline", "remodel", "ratio");
+
+    benchWrapperCasts();
+    benchFields();
+    benchFunctions();
+    benchInstantiable();
+    benchGather();
+    benchQuery();
+    benchFieldIndex();
+    benchScanner();
+    benchDiff();
+    benchPacketView();
+    benchSafeRead();
+    benchPtrChains();
+    benchIntrusiveList();
+    benchRemoteHashMap();
+    benchVftableScan();
+    benchTypeRegistry();
+    benchTypeSwitch();
+    benchLayoutProfile();
+    benchTrace();
+    benchSharedSnapshot();
+    benchTaskQueue();
+    benchWrapperPool();
+    benchPrefetch();
+    benchCapture();
+    benchPageCache();
+    benchParallel();
+    benchStartup(images);
+
+    return 0;
+}
@@ -1,9 +1,65 @@
 #include "Remodel.hpp"
+#include "Gather.hpp"
+#include "ConsistentRead.hpp"
+#include "WrapperSpan.hpp"
+#include "WrapperPool.hpp"
+#include "IdentityMap.hpp"
+#include "Remote.hpp"
+#include "RemoteCall.hpp"
+#include "SharedSnapshot.hpp"
+#include "SignatureCache.hpp"
+#include "Hook.hpp"
+#include "InstantiablePool.hpp"
+#include "Diff.hpp"
+#include "Capture.hpp"
+#include "Dump.hpp"
+#include "Watch.hpp"
+#include "Endian.hpp"
+#include "PacketView.hpp"
+#include "SafeRead.hpp"
+#include "Intrusive.hpp"
+#include "StlLayouts.hpp"
+#include "StringFields.hpp"
+#include "InstanceScan.hpp"
+#include "LayoutProfile.hpp"
+#include "Resolver.hpp"
+#include "Trace.hpp"
+#include "Symbols.hpp"
+#include "Marshal.hpp"
+#include "Parallel.hpp"
+#include "ColumnCache.hpp"
+#include "Query.hpp"
+#include "FieldIndex.hpp"
+#include "Reflect.hpp"
+#include "TypeRegistry.hpp"
+#include "Xref.hpp"
+#include "SetterEvents.hpp"
+#include "Recording.hpp"
+#include "SnapshotStream.hpp"
+#include "VectorMath.hpp"
+#include "LifetimeTracker.hpp"
+#include "Inheritance.hpp"
+#include "ReadView.hpp"
+#include "Footprint.hpp"
+#ifdef REMODEL_TEST_GENERATED_WRAPPERS
+#   include "generated_test.hpp"
+#endif
 #include "gtest/gtest.h"
 
 #include <cstdint>
 #include <stdarg.h>
 #include <numeric>
+#include <algorithm>
+#include <memory>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <unordered_map>
+#include <chrono>
 
 using namespace remodel;
 
@@ -741,246 +797,7465 @@ TEST_F(EnumTest, EnumTest)
 }
 
 // ============================================================================================== //
-// [Global] testing                                                                               //
+// [ClassWrapper] move testing                                                                    //
 // ============================================================================================== //
 
-class GlobalTest : public testing::Test {};
+int wrapperMoveGetterCount = 0;
 
-TEST_F(GlobalTest, GlobalTest)
+class WrapperMoveTest : public testing::Test
 {
-    auto global    = Global::instance();
-    int myStackVar = 854693;
-    Field<int> myStackVarField{global, reinterpret_cast<ptrdiff_t>(&myStackVar)};
-
-    EXPECT_EQ(myStackVar, myStackVarField);
-
-    ++myStackVarField;
-    EXPECT_EQ(myStackVarField, 854693 + 1);
-    EXPECT_EQ(myStackVar,      854693 + 1);
-}
-
-// ============================================================================================== //
-// [Module] testing                                                                               //
-// ============================================================================================== //
+protected:
+    struct A
+    {
+        int32_t x;
+        uint8_t flags;
+        int32_t length;
+        int32_t items[4];
+    };
 
-class ModuleTest : public testing::Test {};
+    static OffsGetter countedOffsGetter(std::ptrdiff_t offs)
+    {
+        ++wrapperMoveGetterCount;
+        return OffsGetter{offs};
+    }
 
-TEST_F(ModuleTest, ModuleTest)
-{
-    static int myStaticVar = 854693;
-    auto mainModulePtr = platform::obtainModuleHandle(nullptr);
-    auto mainModule = Module::getModule(nullptr);
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t>             x       {this, countedOffsGetter(offsetof(A, x))};
+        StaticField<int32_t, 0>    sx      {this};
+        BitField<uint8_t, 1, 3>    mode    {this, offsetof(A, flags)};
+        BigEndianField<int32_t>    beX     {this, offsetof(A, x)};
+        AtomicField<int32_t>       atomicX {this, offsetof(A, x)};
+    };
 
-    EXPECT_TRUE(mainModule);
-    EXPECT_TRUE(mainModulePtr != nullptr);
+    class WrapOuter : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapOuter)
+    public:
+        Field<int32_t> before{this, offsetof(A, x)};
+        WrapA          inner {wrapper_cast<WrapA>(addressOfObj())};
+        Field<int32_t> after {this, offsetof(A, length)};
+    };
 
-    Field<int> myStaticVarField{
-        addressOfWrapper(mainModule.value()), 
-        static_cast<ptrdiff_t>(reinterpret_cast<uintptr_t>(&myStaticVar)
-            - reinterpret_cast<uintptr_t>(mainModulePtr))
+    class WrapMid : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapMid)
+    public:
+        WrapA          first {wrapper_cast<WrapA>(addressOfObj())};
+        WrapA          second{wrapper_cast<WrapA>(addressOfObj())};
+        WrapA          third {wrapper_cast<WrapA>(addressOfObj())};
+        Field<int32_t> length{this, offsetof(A, length)};
     };
 
-    ++myStaticVarField;
-    EXPECT_EQ(myStaticVarField, 854693 + 1);
-    EXPECT_EQ(myStaticVar,      854693 + 1);
-}
+    class WrapDeep : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapDeep)
+    public:
+        WrapA          inner1{wrapper_cast<WrapA>(addressOfObj())};
+        WrapA          inner2{wrapper_cast<WrapA>(addressOfObj())};
+        WrapA          inner3{wrapper_cast<WrapA>(addressOfObj())};
+        WrapA          inner4{wrapper_cast<WrapA>(addressOfObj())};
+        WrapA          inner5{wrapper_cast<WrapA>(addressOfObj())};
+        WrapMid        mid   {wrapper_cast<WrapMid>(addressOfObj())};
+        Field<int32_t> after {this, offsetof(A, length)};
+    };
 
-// ============================================================================================== //
-// [Function] testing                                                                             //
-// ============================================================================================== //
+    class WrapTrailing : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapTrailing)
+    public:
+        Field<int32_t>                                length{this, offsetof(A, length)};
+        TrailingArrayField<int32_t, Field<int32_t>>   items {this, offsetof(A, items), length};
+    };
 
-class FunctionTest : public testing::Test
-{
+    static WrapA makeWrapper(void* raw)
+    {
+        auto wrapper = wrapper_cast<WrapA>(raw);
+        return wrapper;
+    }
 protected:
-    static int add(int a, int b) { return a + b; }
-    Function<int(*)(int, int)> wrapAdd{&add};
-    static void magic(int& out) { out = 42; }
-    Function<void(*)(int&)> wrapMagic{&magic};
-
-    static int cVarArgSum(std::size_t numArgs, ...)
+    WrapperMoveTest()
     {
-        va_list va;
-        va_start(va, numArgs);
-
-        int sum = 0;
-        for (std::size_t i = 0; i < numArgs; ++i)
-        {
-            sum += va_arg(va, int);
-        }
-
-        va_end(va);
-        return sum;
+        a1 = A{1, 0x0A, 2, {10, 20, 30, 40}};
+        a2 = A{5, 0x04, 3, {50, 60, 70, 80}};
     }
-
-    Function<int(*)(std::size_t, ...)> wrapCVarArgSum{&cVarArgSum};
-public:
-    FunctionTest() = default;
+protected:
+    A a1;
+    A a2;
 };
 
-TEST_F(FunctionTest, FunctionTest)
+TEST_F(WrapperMoveTest, MoveTest)
 {
-    EXPECT_EQ(add(1423,  6879), wrapAdd(1423, 6879 ));
-    EXPECT_EQ(add(-1423, 6879), wrapAdd(-1423, 6879));
+    static_assert(std::is_nothrow_move_constructible<WrapperMoveTest::WrapA>::value, 
+        "wrappers of movable fields should be movable");
+
+    wrapperMoveGetterCount = 0;
+    auto made    = makeWrapper(&a1);
+    auto wrapper = std::move(made);
+    EXPECT_EQ(1, wrapperMoveGetterCount);
+
+    // Fields follow the moved wrapper rather than the moved-from one.
+    wrapper.ClassWrapper::rebind(&a2);
+    EXPECT_EQ(5, wrapper.x);
+    EXPECT_EQ(5, wrapper.sx);
+    EXPECT_EQ(2, wrapper.mode);
+    EXPECT_EQ(5, wrapper.atomicX.load());
+    wrapper.beX = 0x01000000;
+    EXPECT_EQ(1, a2.x);
+
+    // Copies still construct their fields anew.
+    auto copy = wrapper;
+    EXPECT_EQ(2, wrapperMoveGetterCount);
+    EXPECT_EQ(1, copy.x);
+
+    std::vector<WrapA> wrappers;
+    for (int i = 0; i < 64; ++i) wrappers.push_back(wrapper_cast<WrapA>(i % 2 ? &a1 : &a2));
+    EXPECT_EQ(2 + 64, wrapperMoveGetterCount);
+    for (std::size_t i = 0; i < wrappers.size(); ++i)
+    {
+        EXPECT_EQ(i % 2 ? &a1.x : &a2.x, wrappers[i].x.addressOfObj());
+        EXPECT_EQ(i % 2 ? 5 : 2, wrappers[i].mode);
+    }
+}
 
-    int a = 0;
-    wrapMagic(a);
-    EXPECT_EQ(42, a);
+TEST_F(WrapperMoveTest, NestedTest)
+{
+    auto outer = wrapper_cast<WrapOuter>(&a1);
+    auto moved = std::move(outer);
+    moved.ClassWrapper::rebind(&a2);
+    moved.inner.ClassWrapper::rebind(&a2);
+    EXPECT_EQ(5, moved.before);
+    EXPECT_EQ(5, moved.inner.x);
+    EXPECT_EQ(3, moved.after);
+}
 
-    EXPECT_EQ(15, cVarArgSum    (3, 1, 5, 9));
-    EXPECT_EQ(15, wrapCVarArgSum(3, 1, 5, 9));
+TEST_F(WrapperMoveTest, DeepNestingTest)
+{
+    auto deep  = wrapper_cast<WrapDeep>(&a1);
+    auto moved = std::move(deep);
+    moved.ClassWrapper::rebind(&a2);
+    moved.inner5.ClassWrapper::rebind(&a2);
+    moved.mid.ClassWrapper::rebind(&a2);
+    moved.mid.third.ClassWrapper::rebind(&a2);
+    EXPECT_EQ(3, moved.after);
+    EXPECT_EQ(5, moved.inner5.x);
+    EXPECT_EQ(3, moved.mid.length);
+    EXPECT_EQ(5, moved.mid.third.x);
+    EXPECT_EQ(2, deep.after);
+
+    // Reallocations move all elements by the same distance.
+    std::vector<WrapDeep> wrappers;
+    for (int i = 0; i < 16; ++i) wrappers.push_back(wrapper_cast<WrapDeep>(i % 2 ? &a1 : &a2));
+    for (std::size_t i = 0; i < wrappers.size(); ++i)
+    {
+        EXPECT_EQ(i % 2 ? &a1.length : &a2.length, wrappers[i].after.addressOfObj());
+        EXPECT_EQ(i % 2 ? &a1.length : &a2.length, wrappers[i].mid.length.addressOfObj());
+        EXPECT_EQ(i % 2 ? &a1.x : &a2.x, wrappers[i].mid.third.x.addressOfObj());
+    }
+}
+
+TEST_F(WrapperMoveTest, FallbackTest)
+{
+    // Trailing arrays refer to their length field, so such wrappers are copied instead.
+    static_assert(std::is_move_constructible<WrapperMoveTest::WrapTrailing>::value,
+        "wrappers should fall back to copying");
+
+    auto wrapper = wrapper_cast<WrapTrailing>(&a1);
+    auto moved   = std::move(wrapper);
+    moved.ClassWrapper::rebind(&a2);
+    ASSERT_EQ(3u, moved.items.size());
+    EXPECT_EQ(70, moved.items[2]);
+
+    // Standalone fields with other parents keep them when moved.
+    int32_t value = 42;
+    Field<int32_t> field{Global::instance(), reinterpret_cast<std::ptrdiff_t>(&value)};
+    auto movedField = std::move(field);
+    EXPECT_EQ(42, movedField);
 }
 
 // ============================================================================================== //
-// [MemberFunction] testing                                                                       //
+// [StaticField] testing                                                                          //
 // ============================================================================================== //
 
-// We rely on the fact that the compiler handles member-function-pointers as regular function
-// pointers on the hood here (which is not guaranteed by the standard), so let's just perform
-// this test with MSVC for now (where we know that the stuff is implemented this way).
-#ifdef ZYCORE_MSVC
-
-class MemberFunctionTest : public testing::Test
+class StaticFieldTest : public testing::Test
 {
 protected:
     struct A
     {
-        int c = 42;
-        int __thiscall add(int x, int y) { return x + y + c; }
-        void __thiscall magic(int& out) { out = 42; }
+        uint32_t x;
+    };
 
-        int __cdecl cVarArgSum(std::size_t numArgs, ...)
-        {
-            va_list va;
-            va_start(va, numArgs);
+    struct B
+    {
+        int32_t x;
+        float   y;
+        A*      a;
+    };
 
-            int sum = 0;
-            for (std::size_t i = 0; i < numArgs; ++i)
-            {
-                sum += va_arg(va, int);
-            }
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        StaticField<uint32_t, offsetof(A, x)> x{this};
+    };
 
-            va_end(va);
-            return sum;
-        }
+    struct C
+    {
+        uint64_t id;
+        int32_t  hp;
+        A*       a;
     };
 
-    struct WrapA : ClassWrapper
+    class WrapC : public AdvancedClassWrapper<sizeof(C)>
     {
-        REMODEL_WRAPPER(WrapA)
+        REMODEL_ADV_WRAPPER(WrapC)
     public:
-        int(A::*pAdd)(int, int){&A::add};
-        MemberFunction<int (__thiscall*)(int, int)> add{this, reinterpret_cast<uintptr_t&>(pAdd)};
+        StaticField<uint64_t, offsetof(C, id)> id{this};
+        StaticField<WrapA*,   offsetof(C, a)>  a {this};
 
-        void(A::*pMagic)(int&){&A::magic};
-        MemberFunction<void (__thiscall*)(int&)> magic{this, reinterpret_cast<uintptr_t&>(pMagic)};
+        static constexpr FieldDesc<int32_t, offsetof(C, hp)> hp{};
+    };
 
-        int(A::*pCVarArgSum)(std::size_t, ...){&A::cVarArgSum};
-        MemberFunction<int (__cdecl*)(std::size_t, ...)> cVarArgSum{
-            this, reinterpret_cast<uintptr_t&>(pCVarArgSum)};
+    class WrapB : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapB)
+    public:
+        StaticField<int32_t, offsetof(B, x)> x    {this};
+        Field<int32_t>                       dynX {this, offsetof(B, x)};
+        StaticField<float,   offsetof(B, y)> y    {this};
+        StaticField<A*,      offsetof(B, a)> a    {this};
+        StaticField<WrapA*,  offsetof(B, a)> wrapA{this};
     };
-public:
-    MemberFunctionTest() = default;
 protected:
-    A a;
-    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+    StaticFieldTest()
+        : wrapB{wrapper_cast<WrapB>(&b)}
+    {
+        a.x = 1234;
+        b.x = 1000;
+        b.y = 567.89f;
+        b.a = &a;
+    }
+protected:
+    A     a;
+    B     b;
+    WrapB wrapB;
 };
 
-TEST_F(MemberFunctionTest, FunctionTest)
+TEST_F(StaticFieldTest, StaticFieldTest)
 {
-    EXPECT_EQ(a.add(1423,  6879), wrapA.add(1423, 6879 ));
-    EXPECT_EQ(a.add(-1423, 6879), wrapA.add(-1423, 6879));
+    EXPECT_EQ(wrapB.x.addressOfObj(), wrapB.dynX.addressOfObj());
+    EXPECT_EQ(&b.x,                   wrapB.x.addressOfObj()   );
 
-    int x = 0;
-    wrapA.magic(x);
-    EXPECT_EQ(42, x);
+    EXPECT_EQ(1000 + 100, wrapB.x + 100);
+    wrapB.x += 100;
+    EXPECT_EQ(1100,       b.x          );
+    EXPECT_EQ(1100,       wrapB.x++    );
+    EXPECT_EQ(1101,       wrapB.dynX   );
 
-    EXPECT_EQ(21, a.cVarArgSum    (5, 1, 6, 7, 8, -1));
-    EXPECT_EQ(21, wrapA.cVarArgSum(5, 1, 6, 7, 8, -1));
+    wrapB.x = wrapB.dynX;
+    EXPECT_EQ(1101,       b.x          );
+
+    EXPECT_FLOAT_EQ(567.89f, wrapB.y);
+    wrapB.y = 1.f;
+    EXPECT_FLOAT_EQ(1.f,     b.y    );
 }
 
-#endif // ifdef ZYCORE_MSVC
+TEST_F(StaticFieldTest, PointerFieldTest)
+{
+    EXPECT_EQ(1234, wrapB.a->x                );
+    EXPECT_EQ(1234, wrapB.wrapA->toStrong().x++);
+    EXPECT_EQ(1235, a.x                       );
+}
+
+constexpr FieldDesc<int32_t, offsetof(StaticFieldTest::C, hp)> StaticFieldTest::WrapC::hp;
+
+TEST_F(StaticFieldTest, WeakAccessTest)
+{
+    C cs[5];
+    for (uint32_t i = 0; i < 5; ++i) cs[i] = C{i * 10, static_cast<int32_t>(i), &a};
+
+    // Weak pointers step through the array, fields are accessed without strong wrappers.
+    auto weak = reinterpret_cast<WrapC::Weak*>(cs);
+    uint64_t sum = 0;
+    for (auto cur = weak; cur != weak + 5; ++cur) 
+    {
+        sum += cur->get(&WrapC::id);
+        cur->get(WrapC::hp) *= 2;
+    }
+    EXPECT_EQ(100u, sum);
+    EXPECT_EQ(8, cs[4].hp);
+    EXPECT_EQ(&cs[3].id, &weak[3].get(&WrapC::id));
+
+    // Wrapper pointers are rewritten to weak pointers, allowing chained accesses.
+    weak[2].get(&WrapC::a)->get(&WrapA::x) = 4321;
+    EXPECT_EQ(4321u, a.x);
+
+    const auto& constWeak = weak[1];
+    EXPECT_EQ(10u, constWeak.get(&WrapC::id));
+    EXPECT_EQ(2, constWeak.get(WrapC::hp));
+}
 
 // ============================================================================================== //
-// [VirtualFunction] testing                                                                      //
+// [GlobalField] testing                                                                          //
 // ============================================================================================== //
 
-// VF-Table layout is highly compiler-dependant, just perform this test with MSVC for now.
-#ifdef ZYCORE_MSVC
+// Only compiles if the constructor is a constant expression.
+constexpr GlobalField<uint32_t> kConstantGlobal{0x1000};
 
-class VirtualFunctionTest : public testing::Test
+TEST(GlobalFieldTest, AccessTest)
+{
+    static int32_t value = 10;
+    static float real = 1.5f;
+    GlobalField<int32_t> global{reinterpret_cast<uintptr_t>(&value)};
+    GlobalField<float> globalReal{reinterpret_cast<uintptr_t>(&real)};
+
+    EXPECT_EQ(&value, global.addressOfObj());
+    EXPECT_EQ(10, global);
+    global += 5;
+    EXPECT_EQ(15, value);
+    EXPECT_EQ(15, global++);
+    EXPECT_EQ(16, value);
+    globalReal = 2.5f;
+    EXPECT_FLOAT_EQ(2.5f, real);
+
+    Field<int32_t, AbsGetter> field{Global::instance(), AbsGetter{&value}};
+    field = 7;
+    EXPECT_EQ(7, global);
+    (void)kConstantGlobal;
+}
+
+// ============================================================================================== //
+// [AtomicField] testing                                                                          //
+// ============================================================================================== //
+
+class AtomicFieldTest : public testing::Test
 {
 protected:
     struct A
     {
-        int c = 42;
-        virtual int add(int x, int y) { return x + y + c; }
+        uint32_t counter;
+        uint64_t flags;
+        float    value;
     };
 
-    struct WrapA : ClassWrapper
+    class WrapA : public AdvancedClassWrapper<sizeof(A), alignof(A)>
     {
-        REMODEL_WRAPPER(WrapA)
+        REMODEL_ADV_WRAPPER(WrapA)
     public:
-        VirtualFunction<int (__thiscall*)(int, int)> add{this, 0};
+        AtomicField<uint32_t> counter{this, offsetof(A, counter)};
+        AtomicField<uint64_t> flags  {this, offsetof(A, flags)  };
+        AtomicField<float>    value  {this, offsetof(A, value)  };
     };
-public:
-    VirtualFunctionTest() = default;
 protected:
-    A a;
-    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+    AtomicFieldTest()
+        : wrapA{wrapper_cast<WrapA>(&a)}
+    {
+        a.counter = 10;
+        a.flags   = 0;
+        a.value   = 1.5f;
+    }
+protected:
+    A     a;
+    WrapA wrapA;
 };
 
-TEST_F(VirtualFunctionTest, FunctionTest)
+TEST_F(AtomicFieldTest, OperationTest)
 {
-    EXPECT_EQ(a.add(1423,  6879), wrapA.add(1423, 6879 ));
-    EXPECT_EQ(a.add(-1423, 6879), wrapA.add(-1423, 6879));
+    EXPECT_EQ(&a.counter, wrapA.counter.addressOfObj());
+    EXPECT_EQ(10u, wrapA.counter.load(std::memory_order_acquire));
+    wrapA.counter.store(20, std::memory_order_release);
+    EXPECT_EQ(20u, a.counter);
+
+    EXPECT_EQ(20u, wrapA.counter.exchange(30));
+    EXPECT_EQ(30u, wrapA.counter.fetchAdd(5));
+    EXPECT_EQ(35u, wrapA.counter.fetchSub(3));
+    EXPECT_EQ(33u, ++wrapA.counter);
+    EXPECT_EQ(33u, wrapA.counter--);
+    EXPECT_EQ(42u, wrapA.counter += 10);
+    EXPECT_EQ(42u, a.counter);
+
+    EXPECT_EQ(0x0ull, wrapA.flags.fetchOr(0xF0));
+    EXPECT_EQ(0xF0ull, wrapA.flags.fetchAnd(0x30));
+    EXPECT_EQ(0x30ull, wrapA.flags.fetchXor(0x11));
+    EXPECT_EQ(0x21ull, a.flags);
+
+    uint32_t expected = 41;
+    EXPECT_FALSE(wrapA.counter.compareExchangeStrong(expected, 50));
+    EXPECT_EQ(42u, expected);
+    EXPECT_TRUE(wrapA.counter.compareExchangeStrong(expected, 50,
+        std::memory_order_acq_rel, std::memory_order_acquire));
+    EXPECT_EQ(50u, a.counter);
+
+    float expectedValue = wrapA.value;
+    while (!wrapA.value.compareExchangeWeak(expectedValue, expectedValue * 2.f));
+    EXPECT_FLOAT_EQ(3.f, a.value);
+    wrapA.value = 0.5f;
+    EXPECT_FLOAT_EQ(0.5f, a.value);
 }
 
-#endif // ifdef ZYCORE_MSVC
+TEST_F(AtomicFieldTest, ConcurrencyTest)
+{
+    static const int kThreads    = 4;
+    static const int kIterations = 10000;
+
+    a.counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i)
+    {
+        threads.emplace_back([this]
+        {
+            for (int j = 0; j < kIterations; ++j)
+            {
+                wrapA.counter.fetchAdd(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(static_cast<uint32_t>(kThreads * kIterations), wrapA.counter.load());
+}
 
 // ============================================================================================== //
-// [MyWrapperType::Instantiable] testing                                                          //
+// [consistentRead] testing                                                                       //
 // ============================================================================================== //
 
-int* hackyGlobalPtr = nullptr;
-
-class InstantiableTest : public testing::Test
+class ConsistentReadTest : public testing::Test
 {
 protected:
     struct A
     {
-        int    a;
-        float  b;
-        double c;
+        uint32_t seq;
+        int32_t  x;
+        uint8_t  pad[64];
+        int32_t  y;
     };
 
-    struct WrapA
-        : AdvancedClassWrapper<sizeof(A)>
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
     {
         REMODEL_ADV_WRAPPER(WrapA)
     public:
-        Field<int>    a{this, offsetof(A, a)};
-        Field<float>  b{this, offsetof(A, b)};
-        Field<double> c{this, offsetof(A, c)};
+        Field<uint32_t> seq{this, offsetof(A, seq)};
+        Field<int32_t>  x{this, offsetof(A, x)};
+        static constexpr FieldDesc<int32_t, offsetof(A, y)> y{};
     };
 
-    struct WrapACustomCtor
-        : AdvancedClassWrapper<sizeof(A)>
+    /// Keeps updating x and y to the same value, bumping `seq` like a seqlock writer.
+    template<typename FuncT>
+    void runWriter(FuncT&& body)
     {
-        REMODEL_ADV_WRAPPER(WrapACustomCtor)
-    public:
-        Field<int>    a{this, offsetof(A, a)};
-        Field<float>  b{this, offsetof(A, b)};
-        Field<double> c{this, offsetof(A, c)};
-    
-        void construct(int a_, float b_, double c_)
+        std::atomic<bool> stop{false};
+        std::thread writer{[&]
         {
-            a = a_;
-            b = b_;
-            c = c_;
-        }
-    };
-
-    struct WrapACustomDtor
+            auto volatileObj = static_cast<volatile A*>(&obj);
+            for (int32_t i = 1; !stop.load(std::memory_order_relaxed); ++i)
+            {
+                volatileObj->seq = volatileObj->seq + 1;
+                std::atomic_thread_fence(std::memory_order_release);
+                volatileObj->x = i;
+                for (auto& cur : volatileObj->pad) cur = static_cast<uint8_t>(i);
+                volatileObj->y = i;
+                std::atomic_thread_fence(std::memory_order_release);
+                volatileObj->seq = volatileObj->seq + 1;
+                // Leaving readers room, like a writer updating once per frame.
+                std::this_thread::yield();
+            }
+        }};
+        body();
+        stop = true;
+        writer.join();
+    }
+protected:
+    A obj{0, 0, {}, 0};
+};
+
+constexpr FieldDesc<int32_t, offsetof(ConsistentReadTest::A, y)> ConsistentReadTest::WrapA::y;
+
+TEST_F(ConsistentReadTest, FieldsTest)
+{
+    auto wrapA = wrapper_cast<WrapA>(&obj);
+    runWriter([&]
+    {
+        for (int i = 0; i < 2000; ++i)
+        {
+            int32_t x = -1, y = -2;
+            ASSERT_TRUE(consistentRead(wrapA, versionedBy(wrapA.seq), 
+                consistentInto(&WrapA::x, x), consistentInto(WrapA::y, y)));
+            ASSERT_EQ(x, y);
+            ASSERT_TRUE(consistentRead(wrapA, consistentInto(&WrapA::x, x), 
+                consistentInto(WrapA::y, y)));
+            ASSERT_EQ(x, y);
+        }
+    });
+}
+
+TEST_F(ConsistentReadTest, CopyTest)
+{
+    auto wrapA = wrapper_cast<WrapA>(&obj);
+    runWriter([&]
+    {
+        WrapA::Compact copy;
+        for (int i = 0; i < 2000; ++i)
+        {
+            ASSERT_TRUE(consistentCopy(wrapA, versionedBy(wrapA.seq), copy.addressOfObj()));
+            auto raw = static_cast<const A*>(copy.addressOfObj());
+            ASSERT_EQ(raw->seq % 2, 0u);
+            ASSERT_EQ(raw->x, raw->y);
+            ASSERT_EQ(raw->pad[63], static_cast<uint8_t>(raw->x));
+            ASSERT_TRUE(consistentCopy(wrapA, copy.addressOfObj()));
+            ASSERT_EQ(copy.wrapper().x + 0, raw->y);
+        }
+    });
+}
+
+TEST_F(ConsistentReadTest, GiveUpTest)
+{
+    auto wrapA = wrapper_cast<WrapA>(&obj);
+    obj.seq = 1;
+    obj.x = 5;
+    int32_t x = 0;
+    EXPECT_FALSE(consistentRead(wrapA, versionedBy(wrapA.seq), consistentInto(&WrapA::x, x)));
+    EXPECT_TRUE(consistentRead(wrapA, versionedBy(wrapA.seq, VersionKind::Counter), 
+        consistentInto(&WrapA::x, x)));
+    EXPECT_EQ(x, 5);
+
+    WrapA::Compact copy;
+    EXPECT_FALSE(consistentCopy(wrapA, versionedBy(wrapA.seq), copy.addressOfObj(), 10));
+    EXPECT_TRUE(consistentCopy(wrapA, copy.addressOfObj(), 1));
+    EXPECT_EQ(copy.wrapper().x + 0, 5);
+}
+
+#ifdef REMODEL_HAS_THREAD_FREEZE
+
+TEST_F(ConsistentReadTest, FrozenTest)
+{
+    auto wrapA = wrapper_cast<WrapA>(&obj);
+    runWriter([&]
+    {
+        // Nothing may allocate while frozen, gtest's assertions included.
+        int succeeded = 0, torn = 0;
+        FrozenReads frozen{std::chrono::microseconds{200}};
+        ASSERT_TRUE(frozen.freeze());
+        EXPECT_TRUE(frozen.isFrozen());
+        WrapA::Compact copy;
+        auto raw = static_cast<const A*>(copy.addressOfObj());
+        for (int i = 0; i < 20000 && frozen.checkpoint(); ++i)
+        {
+            if (!consistentCopy(wrapA, versionedBy(wrapA.seq), copy.addressOfObj(), 1)) continue;
+            ++succeeded;
+            torn += raw->seq % 2 != 0 || raw->x != raw->y;
+        }
+        EXPECT_TRUE(frozen.isFrozen());
+        frozen.thaw();
+        EXPECT_FALSE(frozen.isFrozen());
+        EXPECT_GT(succeeded, 0);
+        EXPECT_EQ(torn, 0);
+    });
+
+    // The fast path ends with the freeze, a held seqlock is retried again.
+    obj.seq = 1;
+    WrapA::Compact copy;
+    EXPECT_FALSE(consistentCopy(wrapA, versionedBy(wrapA.seq), copy.addressOfObj(), 10));
+}
+
+#endif // ifdef REMODEL_HAS_THREAD_FREEZE
+
+// ============================================================================================== //
+// [BitField] testing                                                                             //
+// ============================================================================================== //
+
+class BitFieldTest : public testing::Test
+{
+protected:
+    enum Kind : uint8_t
+    {
+        KIND_NONE,
+        KIND_PLAYER,
+        KIND_MONSTER,
+    };
+
+    struct A
+    {
+        uint32_t alive : 1;
+        uint32_t level : 7;
+        int32_t  delta : 5;
+        uint32_t       : 19;
+        uint8_t  kind;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A), alignof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        BitField<uint32_t, 0, 1> alive{this, 0};
+        BitField<uint32_t, 1, 7> level{this, 0};
+        BitField<int32_t,  8, 5> delta{this, 0};
+        BitField<Kind,     0, 2> kind {this, offsetof(A, kind)};
+    };
+protected:
+    BitFieldTest()
+        : wrapA{wrapper_cast<WrapA>(&a)}
+    {
+        std::memset(&a, 0, sizeof(a));
+        a.alive = 1;
+        a.level = 42;
+        a.delta = -3;
+        a.kind  = KIND_PLAYER;
+    }
+protected:
+    A     a;
+    WrapA wrapA;
+};
+
+TEST_F(BitFieldTest, AccessTest)
+{
+    EXPECT_EQ(1u,          wrapA.alive);
+    EXPECT_EQ(42u,         wrapA.level);
+    EXPECT_EQ(-3,          wrapA.delta);
+    EXPECT_EQ(KIND_PLAYER, wrapA.kind.get());
+
+    wrapA.level = 100;
+    wrapA.delta = 7;
+    wrapA.kind  = KIND_MONSTER;
+    EXPECT_EQ(1u,           a.alive);
+    EXPECT_EQ(100u,         a.level);
+    EXPECT_EQ(7,            a.delta);
+    EXPECT_EQ(KIND_MONSTER, a.kind );
+
+    // Values are truncated to the width of the field.
+    wrapA.level = 130;
+    EXPECT_EQ(2u, a.level);
+    EXPECT_EQ(1u, a.alive);
+
+    EXPECT_EQ(3u,  ++wrapA.level);
+    EXPECT_EQ(3u,  wrapA.level++);
+    EXPECT_EQ(14u, wrapA.level += 10);
+    EXPECT_EQ(28u, wrapA.level <<= 1);
+    EXPECT_EQ(28u, a.level);
+    EXPECT_EQ(-9,  wrapA.delta -= 16);
+    EXPECT_EQ(-9,  a.delta);
+    EXPECT_EQ(30u, wrapA.level + 2);
+
+    EXPECT_EQ(0x7Fu << 1, (BitField<uint32_t, 1, 7>::kMask));
+    EXPECT_EQ(0xFFFFFFFFu, (BitField<uint32_t, 0, 32>::kValueMask));
+}
+
+TEST_F(BitFieldTest, ExtractTest)
+{
+    A objs[5];
+    std::memset(objs, 0, sizeof(objs));
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        objs[i].level = i * 10;
+        objs[i].delta = static_cast<int32_t>(i) - 2;
+    }
+
+    WrapperSpan<WrapA> span{objs, 5};
+    uint32_t levels[5];
+    int32_t  deltas[5];
+    extractBitField(span, &WrapA::level, levels);
+    extractBitField(span, &WrapA::delta, deltas);
+
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(i * 10, levels[i]);
+        EXPECT_EQ(static_cast<int32_t>(i) - 2, deltas[i]);
+    }
+}
+
+// ============================================================================================== //
+// [EndianField] testing                                                                          //
+// ============================================================================================== //
+
+class EndianFieldTest : public testing::Test
+{
+protected:
+    class WrapPacket : public AdvancedClassWrapper<32>
+    {
+        REMODEL_ADV_WRAPPER(WrapPacket)
+    public:
+        BigEndianField<uint16_t>                         length  {this, 0};
+        BigEndianField<uint32_t>                         address {this, 2};
+        LittleEndianField<uint32_t>                      cookie  {this, 6};
+        BigEndianField<float>                            scale   {this, 10};
+        EndianArrayField<uint16_t, 9, ByteOrder::Big>    samples {this, 14};
+    };
+protected:
+    EndianFieldTest()
+        : packet{wrapper_cast<WrapPacket>(bytes)}
+    {
+        const uint8_t data[32] = {
+            0x01, 0x02,                 0xC0, 0xA8, 0x00, 0x01, 0x78, 0x56, 0x34, 0x12,
+            0x3F, 0xC0, 0x00, 0x00,     0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04,
+            0x00, 0x05, 0x00, 0x06,     0x00, 0x07, 0x00, 0x08, 0x01, 0x00,
+        };
+        std::memcpy(bytes, data, sizeof(bytes));
+    }
+protected:
+    uint8_t    bytes[32];
+    WrapPacket packet;
+};
+
+TEST_F(EndianFieldTest, AccessTest)
+{
+    EXPECT_EQ(0x0102u,     packet.length);
+    EXPECT_EQ(0xC0A80001u, packet.address);
+    EXPECT_EQ(0x12345678u, packet.cookie);
+    EXPECT_FLOAT_EQ(1.5f,  packet.scale);
+
+    packet.length = 0xABCD;
+    EXPECT_EQ(0xAB, bytes[0]);
+    EXPECT_EQ(0xCD, bytes[1]);
+    EXPECT_EQ(0xABCEu, ++packet.length);
+    EXPECT_EQ(0xABDEu, packet.length += 0x10);
+    EXPECT_EQ(0xDE, bytes[1]);
+
+    packet.cookie |= 0x80000000u;
+    EXPECT_EQ(0x92, bytes[9]);
+    packet.scale = -2.f;
+    EXPECT_EQ(0xC0, bytes[10]);
+    EXPECT_EQ(0x00, bytes[11]);
+}
+
+TEST_F(EndianFieldTest, ArrayTest)
+{
+    EXPECT_EQ(9u, packet.samples.size());
+    EXPECT_EQ(3u, packet.samples[2]);
+    EXPECT_EQ(0x100u, packet.samples[8]);
+
+    uint16_t samples[9];
+    packet.samples.load(samples);
+    for (uint16_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(i + 1, samples[i]);
+    }
+    EXPECT_EQ(0x100u, samples[8]);
+
+    for (auto& sample : samples) sample = static_cast<uint16_t>(sample * 0x101);
+    packet.samples.store(samples, 1, 100);
+    EXPECT_EQ(1u, packet.samples[0]);
+    EXPECT_EQ(0x0101u, packet.samples[1]);
+    EXPECT_EQ(0x0808u, packet.samples[8]);
+
+    packet.samples.set(0, 0x1234);
+    EXPECT_EQ(0x12, bytes[14]);
+    EXPECT_EQ(0x34, bytes[15]);
+}
+
+TEST_F(EndianFieldTest, ConvertTest)
+{
+    uint32_t values32[37];
+    uint64_t values64[19];
+    for (uint32_t i = 0; i < 37; ++i) values32[i] = 0x01020304u * (i + 1);
+    for (uint32_t i = 0; i < 19; ++i) values64[i] = 0x0102030405060708ull * (i + 1);
+
+    uint32_t swapped32[37];
+    convertByteOrder<ByteOrder::Big>(swapped32, values32, 37);
+    convertByteOrder<ByteOrder::Little>(values64, values64, 19);
+    convertByteOrder<ByteOrder::Big>(values64, values64, 19);
+
+    for (uint32_t i = 0; i < 37; ++i)
+    {
+        EXPECT_EQ(internal::byteSwap(values32[i]), swapped32[i]);
+    }
+    for (uint32_t i = 0; i < 19; ++i)
+    {
+        EXPECT_EQ(internal::byteSwap(uint64_t{0x0102030405060708ull * (i + 1)}), values64[i]);
+    }
+}
+
+// ============================================================================================== //
+// [PacketView] testing                                                                           //
+// ============================================================================================== //
+
+class PacketViewTest : public testing::Test
+{
+protected:
+    class WrapUdp : public AdvancedClassWrapper<8>
+    {
+        REMODEL_ADV_WRAPPER(WrapUdp)
+    public:
+        static constexpr FieldDesc<uint16_t, 0> srcPort{};
+        static constexpr FieldDesc<uint16_t, 2> dstPort{};
+        static constexpr FieldDesc<uint16_t, 4> length {};
+        static constexpr FieldDesc<uint16_t, 6> check  {};
+    };
+
+    class WrapPayload : public AdvancedClassWrapper<4>
+    {
+        REMODEL_ADV_WRAPPER(WrapPayload)
+    public:
+        static constexpr FieldDesc<uint32_t, 0> magic{};
+    };
+protected:
+    PacketViewTest()
+    {
+        const uint8_t data[14] = {
+            0x30, 0x39, 0x00, 0x35, 0x00, 0x0E, 0xAB, 0xCD, 0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02,
+        };
+        std::memcpy(bytes, data, sizeof(bytes));
+    }
+protected:
+    uint8_t bytes[14];
+};
+
+TEST_F(PacketViewTest, AccessTest)
+{
+    static_assert(std::is_trivially_copyable<PacketView<WrapUdp>>::value, 
+        "views are expected to be trivially copyable");
+
+    PacketView<WrapUdp> udp{bytes, sizeof(bytes)};
+    ASSERT_TRUE(udp.isComplete());
+    EXPECT_EQ(12345, udp.get<ByteOrder::Big>(WrapUdp::srcPort).value());
+    EXPECT_EQ(53,    udp.getUnchecked<ByteOrder::Big>(WrapUdp::dstPort));
+    EXPECT_EQ(14,    udp.get<ByteOrder::Big>(WrapUdp::length).valueOr(0));
+
+    auto payload = udp.payload<WrapPayload>();
+    EXPECT_EQ(6u, payload.size());
+    EXPECT_EQ(0xDEADBEEFu, payload.get<ByteOrder::Big>(WrapPayload::magic).value());
+    EXPECT_EQ(0x0201, (payload.read<uint16_t, ByteOrder::Little>(4).value()));
+    EXPECT_FALSE(payload.read<uint16_t>(5));
+
+    auto wrapper = udp.toWrapper();
+    ASSERT_TRUE(wrapper);
+    EXPECT_EQ(bytes, wrapper.value().addressOfObj());
+}
+
+TEST_F(PacketViewTest, BoundsTest)
+{
+    PacketView<WrapUdp> truncated{bytes, 5};
+    EXPECT_FALSE(truncated.isComplete());
+    EXPECT_TRUE(truncated.get(WrapUdp::dstPort));
+    EXPECT_FALSE(truncated.get(WrapUdp::length));
+    EXPECT_FALSE(truncated.get(WrapUdp::check));
+    EXPECT_FALSE(truncated.toWrapper());
+    EXPECT_FALSE(truncated.payload<WrapPayload>().get(WrapPayload::magic));
+    EXPECT_FALSE(truncated.read<uint8_t>(SIZE_MAX));
+
+    PacketView<WrapUdp> empty;
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_FALSE(empty.get(WrapUdp::srcPort));
+}
+
+TEST_F(PacketViewTest, BatchTest)
+{
+    const void* packets[6];
+    std::size_t sizes[6];
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        packets[i] = bytes;
+        sizes[i]   = i % 2 ? sizeof(bytes) : 7;
+    }
+
+    uint32_t sum = 0;
+    auto visited = forEachPacket<WrapUdp>(packets, sizes, 6, [&](PacketView<WrapUdp> udp)
+    {
+        sum += udp.getUnchecked<ByteOrder::Big>(WrapUdp::length);
+    });
+    EXPECT_EQ(3u, visited);
+    EXPECT_EQ(3u * 14, sum);
+}
+
+// ============================================================================================== //
+// [TrailingArrayField] testing                                                                   //
+// ============================================================================================== //
+
+class TrailingArrayFieldTest : public testing::Test
+{
+protected:
+    struct Item
+    {
+        uint16_t id;
+        uint16_t durability;
+    };
+
+    class WrapItem : public AdvancedClassWrapper<sizeof(Item)>
+    {
+        REMODEL_ADV_WRAPPER(WrapItem)
+    public:
+        Field<uint16_t> id        {this, offsetof(Item, id)        };
+        Field<uint16_t> durability{this, offsetof(Item, durability)};
+    };
+
+    class WrapInventory : public AdvancedClassWrapper<8>
+    {
+        REMODEL_ADV_WRAPPER(WrapInventory)
+    public:
+        Field<uint32_t>                                          owner{this, 0};
+        StaticField<uint32_t, 4>                                 count{this};
+        TrailingArrayField<WrapItem, StaticField<uint32_t, 4>>   items{this, 8, count};
+        TrailingArrayField<uint16_t, StaticField<uint32_t, 4>>   ids  {this, 8, count};
+    };
+protected:
+    TrailingArrayFieldTest()
+    {
+        std::memset(buffer, 0, sizeof(buffer));
+        uint32_t count = 3;
+        std::memcpy(buffer + 4, &count, sizeof(count));
+        for (uint16_t i = 0; i < 3; ++i)
+        {
+            Item item{static_cast<uint16_t>(100 + i), static_cast<uint16_t>(i * 10)};
+            std::memcpy(buffer + 8 + i * sizeof(Item), &item, sizeof(item));
+        }
+    }
+protected:
+    alignas(8) uint8_t buffer[8 + 8 * sizeof(Item)];
+};
+
+TEST_F(TrailingArrayFieldTest, ViewTest)
+{
+    auto inventory = wrapper_cast<WrapInventory>(buffer);
+    ASSERT_EQ(3u, inventory.items.size());
+    EXPECT_FALSE(inventory.items.empty());
+    EXPECT_EQ(buffer + 8, reinterpret_cast<uint8_t*>(inventory.items.addressOfObj()));
+
+    uint16_t expectedId = 100;
+    for (auto& item : inventory.items.view())
+    {
+        EXPECT_EQ(expectedId++, item.toStrong().id);
+        item.toStrong().durability = 99;
+    }
+    EXPECT_EQ(103, expectedId);
+    EXPECT_EQ(99, inventory.items[2].toStrong().durability);
+    EXPECT_EQ(102, inventory.ids[4]);
+
+    // The length is re-read on every access.
+    inventory.count = 5;
+    EXPECT_EQ(5u, inventory.items.view().size());
+    EXPECT_EQ(2u, inventory.items.view(2).size());
+
+    const auto& constInventory = inventory;
+    EXPECT_EQ(101, constInventory.ids.view()[2]);
+
+    auto copy = inventory;
+    copy.count = 1;
+    EXPECT_EQ(1u, copy.items.size());
+}
+
+// ============================================================================================== //
+// [StridedField] testing                                                                         //
+// ============================================================================================== //
+
+class StridedFieldTest : public testing::Test
+{
+protected:
+    struct Record
+    {
+        uint32_t id;
+        float    health;
+        double   pos;
+        uint16_t flags;
+        uint8_t  pad[6];
+    };
+
+    static const std::size_t kCount = 37;
+
+    class WrapTable : public AdvancedClassWrapper<sizeof(Record) * kCount>
+    {
+        REMODEL_ADV_WRAPPER(WrapTable)
+    public:
+        StridedField<uint32_t> ids   {this, offsetof(Record, id),     sizeof(Record), kCount};
+        StridedField<float>    health{this, offsetof(Record, health), sizeof(Record), kCount};
+        StridedField<double>   pos   {this, offsetof(Record, pos),    sizeof(Record), kCount};
+        StridedField<uint16_t> flags {this, offsetof(Record, flags),  sizeof(Record), kCount};
+        StridedField<uint32_t> idsReversed{this, 
+            static_cast<std::ptrdiff_t>(offsetof(Record, id) + sizeof(Record) * (kCount - 1)),
+            -static_cast<std::ptrdiff_t>(sizeof(Record)), kCount};
+    };
+
+    class WrapMatrix : public AdvancedClassWrapper<sizeof(float[4][4])>
+    {
+        REMODEL_ADV_WRAPPER(WrapMatrix)
+    public:
+        StridedField<float> diagonal{this, 0, 5 * sizeof(float), 4};
+        StridedField<float> column2 {this, 2 * sizeof(float), 4 * sizeof(float), 4};
+    };
+protected:
+    StridedFieldTest()
+    {
+        for (uint32_t i = 0; i < kCount; ++i)
+        {
+            records[i] = Record{i, i * 1.5f, i * -0.25, static_cast<uint16_t>(i ^ 0xF0F0), {}};
+        }
+    }
+protected:
+    Record records[kCount];
+};
+
+const std::size_t StridedFieldTest::kCount;
+
+TEST_F(StridedFieldTest, ViewTest)
+{
+    auto table = wrapper_cast<WrapTable>(records);
+    ASSERT_EQ(kCount, table.health.size());
+    EXPECT_FALSE(table.health.empty());
+    EXPECT_EQ(&records[0].health, table.health.addressOfObj());
+    EXPECT_EQ(static_cast<std::ptrdiff_t>(sizeof(Record)), table.health.stride());
+
+    auto view = table.health.view();
+    EXPECT_EQ(static_cast<std::ptrdiff_t>(kCount), std::distance(view.begin(), view.end()));
+    EXPECT_EQ(kCount * (kCount - 1) / 2 * 1.5f, std::accumulate(view.begin(), view.end(), 0.f));
+    EXPECT_EQ(3.f, view[2]);
+    EXPECT_EQ(4.5f, *(view.begin() + 3));
+    EXPECT_EQ(36 * 1.5f, *std::max_element(view.begin(), view.end()));
+    EXPECT_TRUE(view.begin() < view.end());
+    EXPECT_EQ(view.begin() + 5, std::find(view.begin(), view.end(), 7.5f));
+
+    for (auto& health : table.health.view()) health = 100.f;
+    EXPECT_EQ(100.f, records[20].health);
+    EXPECT_EQ(20u, records[20].id);
+    table.flags[3] = 7;
+    EXPECT_EQ(7, records[3].flags);
+
+    EXPECT_EQ(kCount - 1, table.idsReversed[0]);
+    EXPECT_EQ(kCount - 1, *table.idsReversed.view().begin());
+    EXPECT_TRUE(std::is_sorted(table.idsReversed.view().begin(), table.idsReversed.view().end(), 
+        std::greater<uint32_t>{}));
+
+    const auto& constTable = table;
+    EXPECT_EQ(5u, constTable.ids.view()[5]);
+
+    float matrix[4][4];
+    for (int i = 0; i < 16; ++i) matrix[i / 4][i % 4] = static_cast<float>(i);
+    auto wrappedMatrix = wrapper_cast<WrapMatrix>(matrix);
+    EXPECT_EQ((std::vector<float>{0.f, 5.f, 10.f, 15.f}), wrappedMatrix.diagonal.view().copy());
+    EXPECT_EQ((std::vector<float>{2.f, 6.f, 10.f, 14.f}), wrappedMatrix.column2.view().copy());
+}
+
+TEST_F(StridedFieldTest, CopyTest)
+{
+    auto table = wrapper_cast<WrapTable>(records);
+
+    uint32_t ids[kCount];
+    float health[kCount];
+    double pos[kCount];
+    uint16_t flags[kCount];
+    uint32_t idsReversed[kCount];
+    ASSERT_EQ(kCount, table.ids.copyTo(ids, kCount));
+    ASSERT_EQ(kCount, table.health.copyTo(health, kCount));
+    ASSERT_EQ(kCount, table.pos.copyTo(pos, kCount));
+    ASSERT_EQ(kCount, table.flags.copyTo(flags, kCount));
+    ASSERT_EQ(kCount, table.idsReversed.copyTo(idsReversed, kCount));
+    for (uint32_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_EQ(records[i].id, ids[i]);
+        EXPECT_EQ(records[i].health, health[i]);
+        EXPECT_EQ(records[i].pos, pos[i]);
+        EXPECT_EQ(records[i].flags, flags[i]);
+        EXPECT_EQ(kCount - 1 - i, idsReversed[i]);
+    }
+
+    // Clamped to the capacity of the buffer.
+    float few[3] = {};
+    EXPECT_EQ(3u, table.health.copyTo(few, 3));
+    EXPECT_EQ(3.f, few[2]);
+
+    // Densely packed elements.
+    uint32_t dense[10];
+    for (uint32_t i = 0; i < 10; ++i) dense[i] = i * i;
+    uint32_t denseCopy[10] = {};
+    StridedView<const uint32_t>{dense, sizeof(uint32_t), 10}.copyTo(denseCopy, 10);
+    EXPECT_EQ(0, std::memcmp(dense, denseCopy, sizeof(dense)));
+    EXPECT_EQ(0u, StridedView<const uint32_t>{}.copyTo(denseCopy, 10));
+}
+
+// ============================================================================================== //
+// [RcuCell] testing                                                                              //
+// ============================================================================================== //
+
+TEST(RcuCellTest, PublishTest)
+{
+    platform::RcuCell<std::vector<int>> cell{std::vector<int>(16, 0)};
+    EXPECT_EQ(0u, cell.version());
+    EXPECT_EQ(16u, cell.read()->size());
+
+    // Declined updates aren't published.
+    EXPECT_FALSE(cell.update([](std::vector<int>&) { return false; }));
+    EXPECT_EQ(0u, cell.version());
+
+    // Readers always observe a complete value, while writers replace it.
+    const int kWrites = 300;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 8; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            int last = 0;
+            while (!done)
+            {
+                auto reader = cell.read();
+                auto first = reader->front();
+                for (auto value : *reader) torn += value != first;
+                torn += first < last;
+                last = first;
+            }
+        });
+    }
+
+    for (int i = 1; i <= kWrites; ++i)
+    {
+        cell.update([i](std::vector<int>& next) { std::fill(next.begin(), next.end(), i); });
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(0, torn);
+    EXPECT_EQ(static_cast<uint64_t>(kWrites), cell.version());
+    EXPECT_EQ(kWrites, cell.read()->back());
+
+    cell.publish({1, 2, 3});
+    EXPECT_EQ(3u, cell.read().get().size());
+}
+
+// ============================================================================================== //
+// [ReadableRegionMap] testing                                                                    //
+// ============================================================================================== //
+
+class SafeReadTest : public testing::Test
+{
+protected:
+    struct Str
+    {
+        uint32_t length;
+        char     data[12];
+    };
+
+    struct Player
+    {
+        Str*  name;
+        int*  score;
+    };
+
+    class WrapStr : public AdvancedClassWrapper<sizeof(Str)>
+    {
+        REMODEL_ADV_WRAPPER(WrapStr)
+    public:
+        Field<uint32_t> length{this, offsetof(Str, length)};
+    };
+
+    class WrapPlayer : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapPlayer)
+    public:
+        Field<WrapStr*> name {this, offsetof(Player, name) };
+        Field<int*>     score{this, offsetof(Player, score)};
+    };
+};
+
+TEST_F(SafeReadTest, MapTest)
+{
+    alignas(8) uint8_t buffer[64] = {};
+    ReadableRegionMap map;
+    EXPECT_FALSE(map.contains(buffer, 1));
+
+    map.addRange(buffer, 16);
+    map.addRange(buffer + 32, 16);
+    map.addRange(buffer + 16, 8);
+    EXPECT_EQ(2u, map.regionCount());
+    EXPECT_TRUE(map.contains(buffer, 24));
+    EXPECT_TRUE(map.contains(buffer + 40, 8));
+    EXPECT_FALSE(map.contains(buffer + 20, 8));
+    EXPECT_FALSE(map.contains(buffer + 40, 9));
+
+    map.setQueryOnMiss(false);
+    EXPECT_FALSE(map.read<uint64_t>(buffer + 24));
+    EXPECT_TRUE(map.read<uint64_t>(buffer + 32));
+
+    map.clear();
+    EXPECT_EQ(0u, map.regionCount());
+}
+
+TEST_F(SafeReadTest, ConcurrencyTest)
+{
+    static uint8_t buffer[4096];
+    ReadableRegionMap map;
+    map.setQueryOnMiss(false);
+    map.addRange(buffer, 64);
+    auto generation = map.generation();
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> failures{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            while (!stop)
+            {
+                auto reader = map.reader();
+                if (!reader.contains(buffer, 64)) ++failures;
+                if (!map.contains(buffer + 32, 32)) ++failures;
+            }
+        });
+    }
+
+    for (std::size_t i = 1; i < 64; ++i)
+    {
+        map.addRange(buffer + i * 64, 32);
+    }
+    stop = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(0u, failures.load());
+    EXPECT_EQ(generation + 63, map.generation());
+    EXPECT_EQ(63u, map.regionCount()); // the first two ranges are adjacent, thus merged
+    EXPECT_TRUE(map.reader().contains(buffer + 63 * 64, 32));
+    EXPECT_FALSE(map.contains(buffer + 63 * 64, 33));
+}
+
+#ifdef REMODEL_HAS_REGION_QUERY
+
+TEST_F(SafeReadTest, DerefTest)
+{
+    Str str{5, "hello"};
+    int score = 1337;
+    Player player{&str, &score};
+    auto wrapPlayer = wrapper_cast<WrapPlayer>(&player);
+
+    auto name = safeDeref(wrapPlayer.name);
+    ASSERT_TRUE(name);
+    EXPECT_EQ(5u, name.value().length);
+    EXPECT_EQ(1337, safeDeref(wrapPlayer.score).valueOr(0));
+
+    // Page-aligned mapping that's been released again: guaranteed to fault.
+    auto pageSize = platform::pageSize();
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto page = VirtualAlloc(nullptr, pageSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        VirtualFree(page, 0, MEM_RELEASE);
+#   else
+        auto page = mmap(nullptr, pageSize, PROT_READ | PROT_WRITE, 
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        munmap(page, pageSize);
+#   endif
+    player.name  = static_cast<Str*>(page);
+    player.score = nullptr;
+    EXPECT_FALSE(safeDeref(wrapPlayer.name));
+    EXPECT_FALSE(safeDeref(wrapPlayer.score));
+    EXPECT_FALSE(safeRead<uint32_t>(page));
+    EXPECT_FALSE(safeWrap<WrapStr>(page));
+
+    // Regions mapped after building the map are picked up on a miss.
+    std::unique_ptr<uint8_t[]> fresh{new uint8_t[1 << 20]()};
+    EXPECT_TRUE(safeRead<uint64_t>(fresh.get() + 1000));
+}
+
+#endif // REMODEL_HAS_REGION_QUERY
+
+// ============================================================================================== //
+// [StaticDispatch] testing                                                                       //
+// ============================================================================================== //
+
+static_assert(!std::is_polymorphic<ClassWrapper>::value, "wrappers should not be polymorphic");
+static_assert(!std::is_polymorphic<StaticField<int, 0>>::value, "unexpected vftable");
+#ifndef REMODEL_INSTRUMENT // Instrumentation adds the ID of the declaration site.
+static_assert(sizeof(StaticField<int, 0>) == sizeof(void*), "unexpected field size");
+#endif
+
+class StaticDispatchTest : public testing::Test
+{
+protected:
+    enum class E : uint8_t { Foo, Bar };
+
+    struct A
+    {
+        uint32_t x;
+    };
+
+    struct B
+    {
+        uint8_t u;
+        bool    flag;
+        E       e;
+        A       a;
+        int     arr[4];
+        A       arrA[2];
+    };
+
+    class WrapB : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapB)
+    public:
+        StaticField<uint8_t, offsetof(B, u)>    u   {this};
+        StaticField<bool,    offsetof(B, flag)> flag{this};
+        StaticField<E,       offsetof(B, e)>    e   {this};
+        StaticField<A,       offsetof(B, a)>    a   {this};
+        StaticField<int[4],  offsetof(B, arr)>  arr {this};
+        StaticField<A[2],    offsetof(B, arrA)> arrA{this};
+    };
+protected:
+    StaticDispatchTest()
+        : b{0xF0, false, E::Foo, {42}, {1, 2, 3, 4}, {{5}, {6}}}
+        , wrapB{wrapper_cast<WrapB>(&b)}
+    {}
+protected:
+    B     b;
+    WrapB wrapB;
+};
+
+TEST_F(StaticDispatchTest, ArithmeticTest)
+{
+    EXPECT_EQ(0x0F,  ~wrapB.u & 0xFF);
+    EXPECT_EQ(0xF0 | 0x0F, wrapB.u | 0x0F);
+    EXPECT_EQ(0xF0 >> 4,   wrapB.u >> 4  );
+    EXPECT_TRUE(wrapB.u == 0xF0 && wrapB.u > 100 && wrapB.u != 0);
+    wrapB.u ^= 0xFF;
+    EXPECT_EQ(0x0F,  b.u);
+    EXPECT_EQ(0x10,  ++wrapB.u);
+    EXPECT_EQ(0x20,  wrapB.u * 2);
+
+    EXPECT_FALSE(wrapB.flag);
+    wrapB.flag = true;
+    EXPECT_TRUE(b.flag);
+
+    EXPECT_EQ(E::Foo, wrapB.e);
+    wrapB.e = E::Bar;
+    EXPECT_EQ(E::Bar, b.e);
+}
+
+TEST_F(StaticDispatchTest, CompoundTest)
+{
+    EXPECT_EQ(42, wrapB.a->x);
+    wrapB.a.get().x = 43;
+    EXPECT_EQ(43, b.a.x);
+
+    EXPECT_EQ(3,      wrapB.arr[2]);
+    EXPECT_EQ(1,      *wrapB.arr  );
+    EXPECT_EQ(b.arr + 1, wrapB.arr + 1);
+    wrapB.arr[3] = 10;
+    EXPECT_EQ(10,     b.arr[3]    );
+
+    EXPECT_EQ(5,      (*wrapB.arrA).x);
+    EXPECT_EQ(6,      wrapB.arrA[1].x);
+}
+
+// Custom getter types are stored inline, stateless ones take no space at all.
+const auto kSecondSlot = [](void* raw) -> void* { return static_cast<int*>(raw) + 1; };
+
+#ifndef REMODEL_INSTRUMENT
+static_assert(sizeof(Field<int, decltype(kSecondSlot)>) == sizeof(void*), 
+    "stateless getters must not take up storage");
+#endif
+
+class CustomGetterTest : public testing::Test
+{
+protected:
+    struct SlotGetter
+    {
+        int slot;
+        void* operator () (void* raw) const { return static_cast<int*>(raw) + slot; }
+    };
+
+    static int twice(int x) { return 2 * x; }
+    static int sumSlots(void* thiz, int x) { return static_cast<int*>(thiz)[0] + x; }
+
+    struct SumGetter
+    {
+        void* operator () (void*) const { return reinterpret_cast<void*>(&sumSlots); }
+    };
+
+    class WrapSlots : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapSlots)
+    public:
+        Field<int, decltype(kSecondSlot)> second{this, kSecondSlot};
+        Field<int[2], SlotGetter> tail{this, SlotGetter{2}};
+        MemberFunction<int (*)(int), SumGetter> sum{this, SumGetter{}};
+    };
+};
+
+TEST_F(CustomGetterTest, GetterTest)
+{
+    static_assert(!std::is_polymorphic<Field<int, SlotGetter>>::value, "unexpected vftable");
+
+    int slots[4] = {1, 2, 3, 4};
+    auto wrapper = wrapper_cast<WrapSlots>(slots);
+    EXPECT_EQ(2, wrapper.second);
+    wrapper.second += 10;
+    EXPECT_EQ(12, slots[1]);
+    EXPECT_EQ(4, wrapper.tail[1]);
+    EXPECT_EQ(11, wrapper.sum(10));
+
+    // Capturing lambdas work the same, without allocating like a type-erased getter might.
+    auto fixed = reinterpret_cast<void*>(&twice);
+    char padding[64] = {};
+    auto getter = [fixed, padding](void*) { return fixed; };
+    Function<int (*)(int), decltype(getter)> func{getter};
+    EXPECT_EQ(42, func(21));
+}
+
+// ============================================================================================== //
+// [FieldDesc] testing                                                                            //
+// ============================================================================================== //
+
+class FieldDescTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        uint32_t x;
+    };
+
+    struct B
+    {
+        int32_t x;
+        float   y;
+        A*      a;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        static constexpr FieldDesc<uint32_t, offsetof(A, x)> x{};
+    };
+
+    class WrapB : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapB)
+    public:
+        static constexpr FieldDesc<int32_t, offsetof(B, x)> x    {};
+        static constexpr FieldDesc<float,   offsetof(B, y)> y    {};
+        static constexpr FieldDesc<A*,      offsetof(B, a)> a    {};
+        static constexpr FieldDesc<WrapA*,  offsetof(B, a)> wrapA{};
+    };
+protected:
+    FieldDescTest()
+        : wrapB{wrapper_cast<WrapB>(&b)}
+    {
+        a.x = 1234;
+        b.x = 1000;
+        b.y = 567.89f;
+        b.a = &a;
+    }
+protected:
+    A     a;
+    B     b;
+    WrapB wrapB;
+};
+
+TEST_F(FieldDescTest, FieldDescTest)
+{
+    static_assert(sizeof(WrapB) == sizeof(ClassWrapper), "descriptors must not take up storage");
+
+    EXPECT_EQ(&b.x,        &(wrapB->*WrapB::x));
+    EXPECT_EQ(1000 + 100,  wrapB->*WrapB::x + 100);
+    wrapB->*WrapB::x += 100;
+    EXPECT_EQ(1100,        b.x);
+
+    EXPECT_FLOAT_EQ(567.89f, wrapB->*WrapB::y);
+    wrapB->*WrapB::y = 1.f;
+    EXPECT_FLOAT_EQ(1.f,     b.y);
+
+    const WrapB& constWrapB = wrapB;
+    EXPECT_EQ(1100, constWrapB->*WrapB::x);
+    EXPECT_EQ(1100, wrapper_cast<WrapB>(&b)->*WrapB::x);
+}
+
+TEST_F(FieldDescTest, PointerFieldDescTest)
+{
+    EXPECT_EQ(1234, (wrapB->*WrapB::a)->x);
+    EXPECT_EQ(1234, (wrapB->*WrapB::wrapA)->toStrong()->*WrapA::x);
+    EXPECT_EQ(1234, WrapA::x.get((wrapB->*WrapB::wrapA)->raw()));
+}
+
+// ============================================================================================== //
+// [validateLayout] testing                                                                       //
+// ============================================================================================== //
+
+class ValidateLayoutTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        uint32_t id;
+        uint16_t age;
+        uint8_t  flags;
+        int32_t* owner;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A), alignof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        StaticField<uint32_t, offsetof(A, id)> id{this};
+        static constexpr FieldDesc<uint16_t, offsetof(A, age)>     age    {};
+        static constexpr FieldDesc<uint8_t,  offsetof(A, flags)>   flags  {};
+        static constexpr FieldDesc<int32_t&, offsetof(A, owner)>   owner  {};
+        static constexpr FieldDesc<int32_t*, offsetof(A, owner)>   ownerPtr{};
+    };
+
+    class PackedWrap : public AdvancedClassWrapper<7>
+    {
+        REMODEL_ADV_WRAPPER(PackedWrap)
+    public:
+        static constexpr FieldDesc<uint8_t,  0> kind{};
+        static constexpr FieldDesc<uint32_t, 1> len {};
+        static constexpr FieldDesc<uint16_t, 5> crc {};
+    };
+};
+
+TEST_F(ValidateLayoutTest, ValidLayoutTest)
+{
+    static_assert(validateLayout<WrapA, decltype(WrapA::id), decltype(WrapA::age), 
+        decltype(WrapA::flags), decltype(WrapA::owner), decltype(WrapA::ownerPtr)>(), "");
+    static_assert(validateLayout<WrapA>(), "");
+    static_assert(validatePackedLayout<PackedWrap, decltype(PackedWrap::kind), 
+        decltype(PackedWrap::len), decltype(PackedWrap::crc)>(), "");
+
+    using internal::FieldLayout;
+    EXPECT_EQ(sizeof(void*), FieldLayout<decltype(WrapA::owner)>::kSize);
+    EXPECT_EQ(offsetof(A, age) + 2, 
+        static_cast<std::size_t>(FieldLayout<decltype(WrapA::age)>::kEnd));
+}
+
+TEST_F(ValidateLayoutTest, ViolationTest)
+{
+    using namespace internal;
+    EXPECT_FALSE((fieldFits<PackedWrap, FieldDesc<uint32_t, 4>>()));
+    EXPECT_FALSE((fieldFits<PackedWrap, FieldDesc<uint8_t, -1>>()));
+    EXPECT_TRUE ((fieldFits<PackedWrap, FieldDesc<uint8_t, 6>>()));
+    EXPECT_FALSE((fieldAligned<FieldDesc<uint32_t, 1>>()));
+    EXPECT_TRUE ((fieldAligned<FieldDesc<uint32_t, 8>>()));
+    EXPECT_FALSE((fieldsCompatible<FieldDesc<uint32_t, 0>, FieldDesc<uint16_t, 2>>()));
+    EXPECT_FALSE((fieldsCompatible<FieldDesc<uint32_t, 0>, FieldDesc<uint32_t, 2>>()));
+    EXPECT_TRUE ((fieldsCompatible<FieldDesc<uint32_t, 0>, FieldDesc<float, 0>>()));
+    EXPECT_TRUE ((fieldsCompatible<FieldDesc<uint16_t, 0>, StaticField<uint16_t, 2>>()));
+}
+
+// ============================================================================================== //
+// [remodel_gen] testing                                                                          //
+// ============================================================================================== //
+
+#ifdef REMODEL_TEST_GENERATED_WRAPPERS
+
+class GeneratedWrapperTest : public testing::Test
+{
+protected:
+    struct Vec2
+    {
+        float x;
+        float y;
+    };
+
+    struct alignas(8) Unit
+    {
+        void** vftable;
+        int32_t hp;
+        Vec2 pos;
+        Vec2* home;
+    };
+
+    static int damage(void* thiz, int amount) { return static_cast<Unit*>(thiz)->hp -= amount; }
+protected:
+    GeneratedWrapperTest()
+    {
+        vftable[0] = nullptr;
+        vftable[1] = reinterpret_cast<void*>(&damage);
+        unit.vftable = vftable;
+        unit.hp = 100;
+        unit.pos = {1.f, 2.f};
+        unit.home = &home;
+        home = {-5.f, 5.f};
+    }
+protected:
+    void* vftable[2];
+    Vec2 home;
+    Unit unit;
+};
+
+TEST_F(GeneratedWrapperTest, GeneratedWrapperTest)
+{
+    static_assert(sizeof(Unit) == generated::Unit::kObjSize, "spec does not match the struct");
+    static_assert(decltype(generated::Unit::pos)::kOffs == offsetof(Unit, pos), "");
+    static_assert(decltype(generated::Unit::home)::kOffs == offsetof(Unit, home), "");
+
+    auto wrapped = wrapper_cast<generated::Unit>(&unit);
+    EXPECT_EQ(100, wrapped.hp);
+    EXPECT_FLOAT_EQ(2.f, wrapped.pos->toStrong().y);
+    EXPECT_FLOAT_EQ(-5.f, wrapped.home->toStrong().x);
+    EXPECT_EQ(70, wrapped.damage(30));
+    EXPECT_EQ(70, unit.hp);
+}
+
+#endif // ifdef REMODEL_TEST_GENERATED_WRAPPERS
+
+// ============================================================================================== //
+// [gatherFields] testing                                                                         //
+// ============================================================================================== //
+
+class GatherTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        uint32_t id;
+        uint8_t  flags;
+        double   pos;
+        int32_t  hp;
+        int32_t* ref;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        static constexpr FieldDesc<uint32_t, offsetof(A, id)>  id {};
+        static constexpr FieldDesc<double,   offsetof(A, pos)> pos{};
+        static constexpr FieldDesc<int32_t&, offsetof(A, ref)> ref{};
+
+        Field<uint8_t>                       flags{this, offsetof(A, flags)};
+        StaticField<int32_t, offsetof(A, hp)> hp  {this};
+    };
+protected:
+    // Not a multiple of the SIMD width to cover the remainder loop.
+    static const std::size_t kCount = 37;
+
+    GatherTest()
+    {
+        for (std::size_t i = 0; i < kCount; ++i)
+        {
+            values[i] = -static_cast<int32_t>(i);
+            objs[i] = A{
+                static_cast<uint32_t>(i), static_cast<uint8_t>(i * 3), i * .5, 
+                static_cast<int32_t>(i * 7), &values[i]
+                };
+        }
+    }
+protected:
+    int32_t values[kCount];
+    A       objs  [kCount];
+};
+
+TEST_F(GatherTest, GatherTest)
+{
+    uint32_t ids   [kCount];
+    double   pos   [kCount];
+    int32_t  refs  [kCount];
+    uint8_t  flags [kCount];
+    int32_t  hp    [kCount];
+
+    gatherFields<WrapA>(objs, kCount, 
+        gatherInto(WrapA::id,     ids  ), 
+        gatherInto(WrapA::pos,    pos  ),
+        gatherInto(WrapA::ref,    refs ),
+        gatherInto(&WrapA::flags, flags),
+        gatherInto(&WrapA::hp,    hp   ));
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_EQ(objs[i].id,    ids  [i]);
+        EXPECT_EQ(objs[i].pos,   pos  [i]);
+        EXPECT_EQ(values[i],     refs [i]);
+        EXPECT_EQ(objs[i].flags, flags[i]);
+        EXPECT_EQ(objs[i].hp,    hp   [i]);
+    }
+}
+
+TEST_F(GatherTest, StrideTest)
+{
+    // Gather every second object only.
+    uint32_t ids[kCount / 2];
+    gatherFields(objs, sizeof(A) * 2, kCount / 2, gatherInto(WrapA::id, ids));
+
+    for (std::size_t i = 0; i < kCount / 2; ++i)
+    {
+        EXPECT_EQ(i * 2, ids[i]);
+    }
+}
+
+class ChainWalkTest : public testing::Test
+{
+protected:
+    struct Transform
+    {
+        uint32_t flags;
+        double   x;
+    };
+
+    struct Component
+    {
+        uint16_t   kind;
+        Transform* transform;
+    };
+
+    struct Entity
+    {
+        uint32_t   id;
+        Component* component;
+    };
+
+    class WrapEntity : public AdvancedClassWrapper<sizeof(Entity)>
+    {
+        REMODEL_ADV_WRAPPER(WrapEntity)
+    public:
+        Field<Component*> component{this, offsetof(Entity, component)};
+    };
+
+    class WrapComponent : public AdvancedClassWrapper<sizeof(Component)>
+    {
+        REMODEL_ADV_WRAPPER(WrapComponent)
+    public:
+        static constexpr FieldDesc<Transform*, offsetof(Component, transform)> transform{};
+    };
+
+    class WrapTransform : public AdvancedClassWrapper<sizeof(Transform)>
+    {
+        REMODEL_ADV_WRAPPER(WrapTransform)
+    public:
+        Field<double> x{this, offsetof(Transform, x)};
+    };
+protected:
+    // Spans multiple blocks and is not a multiple of the SIMD width.
+    static const std::size_t kCount = 601;
+
+    ChainWalkTest()
+        : transforms(kCount)
+        , components(kCount)
+        , entities  (kCount)
+    {
+        for (std::size_t i = 0; i < kCount; ++i)
+        {
+            transforms[i] = Transform{0, i * 1.5};
+
+            // Every 7th chain ends at the component, every 11th at the entity.
+            components[i] = Component{1, i % 7 ? &transforms[kCount - 1 - i] : nullptr};
+            entities  [i] = Entity{static_cast<uint32_t>(i), i % 11 ? &components[i] : nullptr};
+        }
+    }
+
+    double expected(std::size_t i) const
+    {
+        return i % 7 && i % 11 ? (kCount - 1 - i) * 1.5 : 0.;
+    }
+protected:
+    std::vector<Transform> transforms;
+    std::vector<Component> components;
+    std::vector<Entity>    entities;
+};
+
+TEST_F(ChainWalkTest, ArrayTest)
+{
+    std::vector<double> x(kCount, -1.);
+    auto complete = walkPointerChains(entities.data(), sizeof(Entity), kCount, 
+        gatherInto(&WrapTransform::x, x.data()), 
+        chainHop(&WrapEntity::component), chainHop(WrapComponent::transform));
+
+    std::size_t expectedComplete = 0;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_EQ(expected(i), x[i]);
+        if (i % 7 && i % 11) ++expectedComplete;
+    }
+    EXPECT_EQ(expectedComplete, complete);
+}
+
+TEST_F(ChainWalkTest, PointerTest)
+{
+    // Start at the components, in reverse order, with some null roots.
+    std::vector<const void*> roots(kCount);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        roots[i] = i % 5 ? &components[kCount - 1 - i] : nullptr;
+    }
+
+    std::vector<double> x(kCount, -1.);
+    walkPointerChains(roots.data(), kCount, gatherInto(&WrapTransform::x, x.data()), 
+        chainHop(WrapComponent::transform));
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        auto comp = kCount - 1 - i;
+        EXPECT_EQ(i % 5 && comp % 7 ? i * 1.5 : 0., x[i]);
+    }
+}
+
+// ============================================================================================== //
+// [ReadView] testing                                                                             //
+// ============================================================================================== //
+
+class ReadViewTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        uint32_t id;
+        bool     alive;
+        float    health;
+        int32_t* ref;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        static constexpr FieldDesc<uint32_t, offsetof(A, id)>  id {};
+        static constexpr FieldDesc<int32_t&, offsetof(A, ref)> ref{};
+
+        StaticField<bool, offsetof(A, alive)> alive {this};
+        Field<float>                          health{this, offsetof(A, health)};
+    };
+};
+
+TEST_F(ReadViewTest, ReadTest)
+{
+    int32_t values[8];
+    A objs[8];
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        values[i] = -static_cast<int32_t>(i);
+        objs[i] = A{i, i % 2 == 0, i * 10.f, &values[i]};
+    }
+
+    auto first  = wrapper_cast<WrapA>(&objs[0]);
+    auto health = readField(&WrapA::health, first);
+    EXPECT_EQ(static_cast<std::ptrdiff_t>(offsetof(A, health)), health.offset());
+
+    float total = 0.f;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        ReadView<WrapA> view{&objs[i]};
+        EXPECT_EQ(&objs[i], view.addressOfObj());
+        EXPECT_EQ(i, view[WrapA::id]);
+        EXPECT_EQ(values[i], view[WrapA::ref]);
+        if (view[&WrapA::alive]) total += view[health];
+    }
+    EXPECT_EQ(120.f, total);
+
+    auto view = readView(first);
+    EXPECT_EQ(0.f, view[health]);
+    objs[0].health = 5.f;
+    EXPECT_EQ(5.f, readView(first.weakPtr())[health]);
+}
+
+// ============================================================================================== //
+// [Footprint] testing                                                                            //
+// ============================================================================================== //
+
+class FootprintTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t  x;
+        int32_t  y;
+        int32_t* ref;
+    };
+
+    class WrapLean : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapLean)
+    public:
+        StaticField<int32_t, offsetof(A, x)> x{this};
+        StaticField<int32_t, offsetof(A, y)> y{this};
+    };
+
+    class WrapFat : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapFat)
+    public:
+        Field<int32_t>                       x{this, offsetof(A, x)};
+        StaticField<int32_t, offsetof(A, y)> y{this};
+        Field<int32_t> deref{this, PtrChainGetter{{offsetof(A, ref), 0}}};
+    };
+};
+
+TEST_F(FootprintTest, MeasureTest)
+{
+    using LeanTraits = FootprintTraits<WrapLean>;
+    static_assert(LeanTraits::kWrapperSize == sizeof(WrapLean), "");
+    static_assert(LeanTraits::kObjSize == sizeof(A), "");
+    static_assert(FootprintTraits<WrapFat>::kObjSize == 0, "");
+    EXPECT_EQ(2u, LeanTraits::kMaxFieldCount);
+    EXPECT_EQ(static_cast<double>(sizeof(WrapLean)) / sizeof(A), LeanTraits::sizeRatio());
+
+    auto lean = measureFootprint<WrapLean>();
+    EXPECT_EQ(sizeof(WrapLean), lean.wrapperSize);
+    EXPECT_EQ(2u, lean.fieldCount);
+    EXPECT_EQ(0u, lean.getterBytes);
+    EXPECT_EQ(0u, lean.heapGetters);
+    EXPECT_EQ(LeanTraits::sizeRatio(), lean.sizeRatio());
+
+    A obj{1, 2, nullptr};
+    auto fat = measureFootprint(wrapper_cast<WrapFat>(&obj));
+    EXPECT_EQ(3u, fat.fieldCount);
+    EXPECT_EQ(1u, fat.heapGetters);
+    EXPECT_EQ(sizeof(WrapFat) - sizeof(ClassWrapper) - 3 * sizeof(internal::FieldBase), 
+        fat.getterBytes);
+    EXPECT_GE(fat.getterBytes, 2 * sizeof(internal::InlineGetter));
+    EXPECT_EQ(0., fat.sizeRatio());
+
+    FootprintReport report;
+    report.add<WrapLean>("WrapLean");
+    report.add("WrapFat", fat);
+    ASSERT_EQ(2u, report.entries().size());
+    EXPECT_EQ("WrapFat", report.entries()[1].name);
+    EXPECT_EQ(sizeof(WrapLean) + sizeof(WrapFat), report.totalWrapperSize());
+}
+
+// ============================================================================================== //
+// [WrapperSpan] testing                                                                          //
+// ============================================================================================== //
+
+class WrapperSpanTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        float   y;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t>                      x{this, offsetof(A, x)};
+        StaticField<float, offsetof(A, y)> y{this};
+    };
+protected:
+    WrapperSpanTest()
+        : objs{{1, 1.f}, {2, 2.f}, {3, 3.f}, {4, 4.f}, {5, 5.f}}
+        , span{reinterpret_cast<WrapA::Weak*>(objs), 5}
+    {}
+protected:
+    A                  objs[5];
+    WrapperSpan<WrapA> span;
+};
+
+TEST_F(WrapperSpanTest, IterationTest)
+{
+    EXPECT_EQ(5u, span.size());
+    EXPECT_EQ(5,  std::distance(span.begin(), span.end()));
+
+    for (auto& a : span)
+    {
+        a.x *= 10;
+        a.y += 1.f;
+    }
+    EXPECT_EQ(30,  objs[2].x);
+    EXPECT_EQ(6.f, objs[4].y);
+
+    int sum = 0;
+    std::for_each(span.begin(), span.end(), [&](WrapA& a) { sum += a.x; });
+    EXPECT_EQ(150, sum);
+}
+
+TEST_F(WrapperSpanTest, RandomAccessTest)
+{
+    auto it = span.begin();
+    EXPECT_EQ(&objs[3], (it + 3)->addressOfObj());
+    EXPECT_EQ(3,        it[2].x);
+    EXPECT_EQ(4,        span[3].x);
+    EXPECT_EQ(5,        (*--span.end()).x);
+    EXPECT_TRUE(it < it + 1 && it + 1 > it && span.end() - it == 5);
+
+    auto found = std::find_if(span.begin(), span.end(), [](WrapA& a) { return a.x == 4; });
+    EXPECT_EQ(3, found - span.begin());
+
+    auto copy = found;
+    copy -= 2;
+    EXPECT_EQ(2, copy->x);
+    EXPECT_EQ(4, found->x);
+}
+
+TEST_F(WrapperSpanTest, PrefetchTest)
+{
+    auto prefetched = span.prefetched(2);
+    int sum = 0;
+    for (auto& a : prefetched) sum += a.x;
+    EXPECT_EQ(15, sum);
+
+    // Distances beyond the span and iterators derived by arithmetic stay in bounds.
+    auto it = span.prefetched(100).begin() + 1;
+    EXPECT_EQ(2, (it++)->x);
+    EXPECT_EQ(4, (++it)->x);
+    EXPECT_EQ(4u, static_cast<std::size_t>(std::distance(prefetched.begin() + 1, 
+        prefetched.end())));
+
+    // Hints on wrappers, weak wrappers and fields don't change any state.
+    span[1].prefetch();
+    span[1].prefetch(1000);
+    span.data()[2].prefetch();
+    span[3].x.prefetch();
+    EXPECT_EQ(4, objs[3].x);
+}
+
+// ============================================================================================== //
+// [VectorMath] testing                                                                           //
+// ============================================================================================== //
+
+class VectorMathTest : public testing::Test
+{
+protected:
+    struct Entity
+    {
+        uint32_t id;
+        float    position[3];
+        float    direction[4];
+        float    world[4][4];
+    };
+
+    class WrapEntity : public AdvancedClassWrapper<sizeof(Entity)>
+    {
+        REMODEL_ADV_WRAPPER(WrapEntity)
+    public:
+        Field<float[3]>    position {this, offsetof(Entity, position)};
+        Field<float[4]>    direction{this, offsetof(Entity, direction)};
+        Field<float[4][4]> world    {this, offsetof(Entity, world)};
+    };
+
+    struct Vec3
+    {
+        float x, y, z;
+    };
+};
+
+TEST_F(VectorMathTest, LoadStoreTest)
+{
+    Entity entity;
+    std::memset(&entity, 0, sizeof(entity));
+    entity.position[0] = 1.f; entity.position[1] = 2.f; entity.position[2] = 3.f;
+    for (int i = 0; i < 16; ++i) entity.world[i / 4][i % 4] = static_cast<float>(i);
+    auto wrapEntity = wrapper_cast<WrapEntity>(&entity);
+
+    auto vec = loadAs<Vec3>(wrapEntity.position);
+    EXPECT_EQ(2.f, vec.y);
+    vec.z = 7.f;
+    storeAs(wrapEntity.position, vec);
+    EXPECT_EQ(7.f, entity.position[2]);
+
+#   ifdef REMODEL_HAS_SSE_MATH
+        float lanes[4];
+        _mm_storeu_ps(lanes, loadVec3(wrapEntity.position));
+        EXPECT_EQ(1.f, lanes[0]);
+        EXPECT_EQ(7.f, lanes[2]);
+        EXPECT_EQ(0.f, lanes[3]);
+
+        // Stores of three lanes leave the following member alone.
+        entity.direction[0] = 42.f;
+        storeVec3(wrapEntity.position, _mm_set_ps(9.f, 6.f, 5.f, 4.f));
+        EXPECT_EQ(6.f,  entity.position[2]);
+        EXPECT_EQ(42.f, entity.direction[0]);
+
+        storeVec4(wrapEntity.direction, _mm_set_ps(4.f, 3.f, 2.f, 1.f));
+        _mm_storeu_ps(lanes, _mm_add_ps(loadVec4(wrapEntity.direction), _mm_set1_ps(1.f)));
+        EXPECT_EQ(2.f, lanes[0]);
+        EXPECT_EQ(5.f, lanes[3]);
+
+        auto mat = loadMat4(wrapEntity.world);
+        _mm_storeu_ps(lanes, mat.rows[2]);
+        EXPECT_EQ(8.f, lanes[0]);
+        EXPECT_EQ(11.f, lanes[3]);
+        mat.rows[3] = _mm_setzero_ps();
+        storeMat4(wrapEntity.world, mat);
+        EXPECT_EQ(0.f, entity.world[3][3]);
+        EXPECT_EQ(7.f, entity.world[1][3]);
+
+        alignas(16) float aligned[4] = {};
+        EXPECT_TRUE(isSimdAligned(aligned));
+        EXPECT_FALSE(isSimdAligned(aligned + 1));
+#   endif
+}
+
+TEST_F(VectorMathTest, DistanceTest)
+{
+    static const std::size_t kCount = 11;
+    Entity entities[kCount];
+    std::memset(entities, 0, sizeof(entities));
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        entities[i].position[0] = static_cast<float>(i);
+        entities[i].position[1] = static_cast<float>(i) * 2.f;
+        entities[i].position[2] = -static_cast<float>(i);
+    }
+
+    WrapperSpan<WrapEntity> span{reinterpret_cast<WrapEntity::Weak*>(entities), kCount};
+    float dist[kCount], sqDist[kCount];
+    distancesTo(span, &WrapEntity::position, {1.f, 2.f, 3.f}, dist);
+    squaredDistancesTo(span, &WrapEntity::position, {1.f, 2.f, 3.f}, sqDist);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        auto dx = entities[i].position[0] - 1.f;
+        auto dy = entities[i].position[1] - 2.f;
+        auto dz = entities[i].position[2] - 3.f;
+        auto sq = dx * dx + dy * dy + dz * dz;
+        EXPECT_FLOAT_EQ(sq, sqDist[i]);
+        EXPECT_FLOAT_EQ(std::sqrt(sq), dist[i]);
+    }
+}
+
+// ============================================================================================== //
+// [ParallelPool] testing                                                                         //
+// ============================================================================================== //
+
+class ParallelPoolTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        float   y;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t> x{this, offsetof(A, x)};
+    };
+protected:
+    ParallelPoolTest()
+        : pool{4}
+    {}
+protected:
+    ParallelPool pool;
+};
+
+TEST_F(ParallelPoolTest, SpanTest)
+{
+    EXPECT_EQ(4u, pool.threadCount());
+
+    for (std::size_t count : {0, 5, 100000})
+    {
+        std::vector<A> objs(count);
+        for (std::size_t i = 0; i < count; ++i) objs[i].x = static_cast<int32_t>(i);
+
+        WrapperSpan<WrapA> span{objs.data(), count};
+        parallelForEach(span, [](WrapA& a) { a.x += 1; }, pool);
+        parallelForEach(span, [](WrapA& a) { a.x *= 2; }, pool, 7);
+
+        std::size_t wrong = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (objs[i].x != static_cast<int32_t>(i + 1) * 2) ++wrong;
+        }
+        EXPECT_EQ(0u, wrong);
+    }
+}
+
+TEST_F(ParallelPoolTest, StealTest)
+{
+    // If the first worker gets index 0, it blocks until the others finished the rest of the 
+    // loop, so the rest of its share has to be stolen. Which worker gets which index depends on 
+    // the scheduler.
+    const std::size_t kCount = 256;
+    std::vector<std::atomic<int>> visits(kCount);
+    std::vector<std::atomic<std::size_t>> perWorker(pool.threadCount());
+    for (auto& cur : visits) cur = 0;
+    for (auto& cur : perWorker) cur = 0;
+    std::atomic<std::size_t> done{0};
+
+    pool.forRange(kCount, 1, [&](std::size_t begin, std::size_t end, unsigned worker)
+    {
+        for (auto i = begin; i < end; ++i) ++visits[i];
+        perWorker[worker] += end - begin;
+        if (worker == 0 && begin == 0)
+        {
+            while (done.load() != kCount - (end - begin)) std::this_thread::yield();
+        }
+        done += end - begin;
+    });
+
+    EXPECT_EQ(kCount, done.load());
+    std::size_t total = 0;
+    for (auto& cur : perWorker) total += cur.load();
+    EXPECT_EQ(kCount, total);
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](std::atomic<int>& cur) 
+    { 
+        return cur.load() == 1; 
+    }));
+}
+
+TEST_F(ParallelPoolTest, InstanceSetTest)
+{
+    std::vector<A> objs(10000);
+    std::vector<void*> raws;
+    for (std::size_t i = 0; i < objs.size(); ++i)
+    {
+        objs[i].x = static_cast<int32_t>(i);
+        raws.push_back(&objs[objs.size() - 1 - i]);
+    }
+
+    InstanceSet<WrapA> set{raws};
+    std::atomic<int64_t> sum{0};
+    parallelForEach(set, [&](WrapA& a) { sum += a.x; }, pool);
+    EXPECT_EQ(9999 * 10000 / 2, sum.load());
+
+    set.setPrefetchDistance(0);
+    parallelForEach(set, [](WrapA& a) { a.x = -a.x; }, pool);
+    EXPECT_EQ(-1234, objs[1234].x);
+}
+
+// ============================================================================================== //
+// [WrapperPool] testing                                                                          //
+// ============================================================================================== //
+
+class WrapperPoolTest : public testing::Test
+{
+protected:
+    struct Horse
+    {
+        int32_t age;
+        int32_t speed;
+    };
+
+    class WrapHorse : public AdvancedClassWrapper<sizeof(Horse)>
+    {
+        REMODEL_ADV_WRAPPER(WrapHorse)
+    public:
+        Field<int32_t> age{this, offsetof(Horse, age)};
+        Field<int32_t> speed{this, offsetof(Horse, speed)};
+    };
+
+    static void horseTraverser(WrapHorse::Weak* weak)
+    {
+        auto horse = pooledWrapper(weak);
+        horse->age += 1;
+    }
+
+    static std::size_t poolSize() { return WrapperPool<WrapHorse>::threadInstance().size(); }
+};
+
+TEST_F(WrapperPoolTest, RebindTest)
+{
+    Horse a{1, 2}, b{3, 4};
+    auto horse = wrapper_cast<WrapHorse>(&a);
+    horse.rebind(&b);
+    EXPECT_EQ(&b, horse.addressOfObj());
+    EXPECT_EQ(3, horse.age);
+    EXPECT_EQ(4, horse.speed);
+}
+
+TEST_F(WrapperPoolTest, VisitTest)
+{
+    std::vector<Horse> horses(1000000, Horse{0, 0});
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (auto& horse : horses) horseTraverser(reinterpret_cast<WrapHorse::Weak*>(&horse));
+    }
+    EXPECT_EQ(1u, poolSize());
+    EXPECT_TRUE(std::all_of(horses.begin(), horses.end(), [](const Horse& horse) 
+    { 
+        return horse.age == 2; 
+    }));
+
+    // Nested leases use distinct wrappers, other threads use their own pools.
+    {
+        auto outer = pooledWrapper<WrapHorse>(&horses[0]);
+        auto inner = pooledWrapper<WrapHorse>(&horses[1]);
+        inner->speed = 5;
+        EXPECT_EQ(0, outer->speed);
+        EXPECT_EQ(2u, poolSize());
+
+        outer.rebind(&horses[1]);
+        EXPECT_EQ(5, outer->speed);
+    }
+
+    std::size_t otherSize = 0;
+    std::thread other{[&]
+    {
+        for (int i = 0; i < 1000; ++i) 
+        {
+            horseTraverser(reinterpret_cast<WrapHorse::Weak*>(&horses[i]));
+        }
+        otherSize = poolSize();
+    }};
+    other.join();
+    EXPECT_EQ(1u, otherSize);
+    EXPECT_EQ(2u, poolSize());
+    EXPECT_EQ(3, horses[999].age);
+}
+
+// ============================================================================================== //
+// [WrapperIdentityMap] testing                                                                   //
+// ============================================================================================== //
+
+class IdentityMapTest : public testing::Test
+{
+protected:
+    struct Horse
+    {
+        int32_t age;
+        int32_t speed;
+    };
+
+    class WrapHorse : public AdvancedClassWrapper<sizeof(Horse)>
+    {
+        REMODEL_ADV_WRAPPER(WrapHorse)
+    public:
+        Field<int32_t> age{this, offsetof(Horse, age)};
+        Field<int32_t> speed{this, offsetof(Horse, speed)};
+    };
+};
+
+TEST_F(IdentityMapTest, InternTest)
+{
+    Horse horses[3] = {{1, 2}, {3, 4}, {5, 6}};
+    WrapperIdentityMap<WrapHorse> map{2};
+    EXPECT_EQ(2u, map.capacity());
+
+    auto a = map.get(&horses[0]);
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(a, map.get(reinterpret_cast<WrapHorse::Weak*>(&horses[0])));
+    EXPECT_EQ(a, map.find(&horses[0]));
+    EXPECT_EQ(1, a->age);
+    EXPECT_EQ(nullptr, map.find(&horses[1]));
+    EXPECT_EQ(nullptr, map.get(static_cast<void*>(nullptr)));
+
+    auto b = map.get(&horses[1]);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(4, b->speed);
+    EXPECT_EQ(2u, map.size());
+
+    // The capacity is exhausted for new addresses only.
+    EXPECT_EQ(nullptr, map.get(&horses[2]));
+    EXPECT_EQ(b, map.get(&horses[1]));
+
+    // Erased wrappers stay usable until the epoch advanced twice, the address is reused.
+    EXPECT_TRUE(map.erase(&horses[0]));
+    EXPECT_FALSE(map.erase(&horses[0]));
+    EXPECT_EQ(nullptr, map.find(&horses[0]));
+    EXPECT_EQ(1u, map.size());
+    EXPECT_EQ(0u, map.advanceEpoch());
+    EXPECT_EQ(1, a->age);
+    EXPECT_EQ(1u, map.advanceEpoch());
+
+    auto c = map.get(&horses[0]);
+    ASSERT_NE(nullptr, c);
+    EXPECT_EQ(2u, map.addressCount());
+    EXPECT_EQ(c, map.get(&horses[0]));
+}
+
+TEST_F(IdentityMapTest, ConcurrencyTest)
+{
+    static const std::size_t kObjCount = 1000;
+    std::vector<Horse> horses(kObjCount, Horse{0, 0});
+    WrapperIdentityMap<WrapHorse> map{kObjCount};
+
+    // All threads racing for the same addresses observe the same wrappers.
+    std::vector<std::vector<WrapHorse*>> seen(4, std::vector<WrapHorse*>(kObjCount));
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < seen.size(); ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (std::size_t i = 0; i < kObjCount; ++i) seen[t][i] = map.get(&horses[i]);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(kObjCount, map.size());
+    for (std::size_t i = 0; i < kObjCount; ++i)
+    {
+        EXPECT_EQ(&horses[i], seen[0][i]->addressOfObj());
+        for (std::size_t t = 1; t < seen.size(); ++t) EXPECT_EQ(seen[0][i], seen[t][i]);
+    }
+}
+
+// ============================================================================================== //
+// [IntrusiveList] / [IntrusiveTree] testing                                                      //
+// ============================================================================================== //
+
+class IntrusiveTest : public testing::Test
+{
+protected:
+    struct Link
+    {
+        Link* next;
+        Link* prev;
+    };
+
+    struct Item
+    {
+        int32_t value;
+        Item*   next;
+        Link    link;
+    };
+
+    struct Node
+    {
+        Node*   left;
+        Node*   right;
+        int32_t value;
+    };
+
+    class WrapItem : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapItem)
+    public:
+        Field<int32_t> value{this, offsetof(Item, value)};
+    };
+
+    class WrapNode : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapNode)
+    public:
+        Field<int32_t> value{this, offsetof(Node, value)};
+    };
+
+    using List      = IntrusiveList<WrapItem, offsetof(Item, next)>;
+    using LinkList  = IntrusiveList<WrapItem, offsetof(Item, link), offsetof(Item, link)>;
+    using Tree      = IntrusiveTree<WrapNode, offsetof(Node, left), offsetof(Node, right)>;
+protected:
+    IntrusiveTest()
+    {
+        // Circular list with a bare head, linking the items in reverse.
+        head.next = &items[3].link;
+        head.prev = &items[0].link;
+        for (int32_t i = 0; i < 4; ++i)
+        {
+            items[i].value     = i + 1;
+            items[i].next      = i < 3 ? &items[i + 1] : nullptr;
+            items[i].link.next = i > 0 ? &items[i - 1].link : &head;
+            items[i].link.prev = i < 3 ? &items[i + 1].link : &head;
+        }
+
+        //         3
+        //      1     5
+        //    0   2     6
+        for (int32_t i = 0; i < 7; ++i) nodes[i] = Node{nullptr, nullptr, i};
+        nodes[3].left  = &nodes[1];
+        nodes[3].right = &nodes[5];
+        nodes[1].left  = &nodes[0];
+        nodes[1].right = &nodes[2];
+        nodes[5].right = &nodes[6];
+    }
+protected:
+    Item items[4];
+    Link head;
+    Node nodes[7];
+};
+
+TEST_F(IntrusiveTest, ListTest)
+{
+    std::vector<int32_t> values;
+    for (auto& item : List{&items[0]}) values.push_back(item.value);
+    EXPECT_EQ((std::vector<int32_t>{1, 2, 3, 4}), values);
+
+    for (auto& item : List{&items[2]}) item.value *= 10;
+    EXPECT_EQ(30, items[2].value);
+    EXPECT_EQ(40, items[3].value);
+
+    values.clear();
+    for (auto& item : LinkList::circular(&head)) values.push_back(item.value);
+    EXPECT_EQ((std::vector<int32_t>{40, 30, 2, 1}), values);
+
+    Link empty{&empty, &empty};
+    EXPECT_TRUE(LinkList::circular(&empty).empty());
+    EXPECT_TRUE(List{nullptr}.begin() == List{nullptr}.end());
+
+    auto list  = List{&items[0]};
+    auto found = std::find_if(list.begin(), list.end(), [](WrapItem& a) { return a.value == 2; });
+    EXPECT_EQ(&items[1], found->addressOfObj());
+    auto copy = found++;
+    EXPECT_EQ(&items[1], copy.raw());
+    EXPECT_EQ(&items[2], found.raw());
+}
+
+TEST_F(IntrusiveTest, TreeTest)
+{
+    std::vector<int32_t> values;
+    for (auto& node : Tree{&nodes[3]}) values.push_back(node.value);
+    EXPECT_EQ((std::vector<int32_t>{0, 1, 2, 3, 5, 6}), values);
+
+    // Trees using a shared leaf node instead of null children.
+    Node nil{nullptr, nullptr, -1};
+    for (auto& node : nodes)
+    {
+        if (!node.left)  node.left  = &nil;
+        if (!node.right) node.right = &nil;
+    }
+    values.clear();
+    for (auto& node : Tree{&nodes[3], &nil}) values.push_back(node.value);
+    EXPECT_EQ((std::vector<int32_t>{0, 1, 2, 3, 5, 6}), values);
+    EXPECT_TRUE(Tree(&nil, &nil).empty());
+    EXPECT_TRUE(Tree(&nil, &nil).begin() == Tree(&nil, &nil).end());
+
+    // Degenerated trees exceeding the maximum depth end the iteration.
+    std::vector<Node> chain(Tree::iterator::kMaxDepth + 1, Node{nullptr, nullptr, 0});
+    for (std::size_t i = 0; i + 1 < chain.size(); ++i) chain[i].left = &chain[i + 1];
+    EXPECT_TRUE(Tree{chain.data()}.begin() == Tree{chain.data()}.end());
+}
+
+// ============================================================================================== //
+// [RemoteVector] / [RemoteString] / [RemoteHashMap] testing                                      //
+// ============================================================================================== //
+
+class StlLayoutsTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        int32_t y;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t> x{this, offsetof(A, x)};
+    };
+
+    struct Raw
+    {
+        uint32_t             id;
+        std::vector<int32_t> values;
+    };
+
+    class WrapRaw : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapRaw)
+    public:
+        Field<RemoteVector<int32_t, StlAbi::Libstdcxx>> values{this, offsetof(Raw, values)};
+    };
+
+    // Mirrors of MSVC's layouts, built by hand since we can't test against the real thing here.
+    struct MsvcString
+    {
+        union
+        {
+            char        buf[16];
+            const char* ptr;
+        };
+        std::size_t size;
+        std::size_t res;
+    };
+
+    struct MsvcNode
+    {
+        MsvcNode*   next;
+        MsvcNode*   prev;
+        uint32_t    key;
+        int32_t     value;
+    };
+
+    struct MsvcHashMap
+    {
+        float       maxBucketSize;
+        MsvcNode*   head;
+        std::size_t size;
+        MsvcNode**  first;
+        MsvcNode**  last;
+        MsvcNode**  end;
+        std::size_t mask;
+        std::size_t maxIdx;
+    };
+
+    /**
+     * Lays out the keys `0..count-1` (mapped to their negation) the way MSVC's STL would.
+     */
+    void buildMsvcHashMap(uint32_t count, std::size_t numBuckets)
+    {
+        msvcNodes.resize(count + 1);
+        msvcBuckets.assign(numBuckets * 2, &msvcNodes[0]);
+        msvcMap = MsvcHashMap{1.f, &msvcNodes[0], count,
+            msvcBuckets.data(), msvcBuckets.data() + numBuckets * 2,
+            msvcBuckets.data() + numBuckets * 2, numBuckets - 1, numBuckets};
+
+        auto prev = &msvcNodes[0];
+        std::size_t used = 1;
+        for (std::size_t bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            for (uint32_t key = 0; key < count; ++key)
+            {
+                if ((StlHash<StlAbi::Msvc>{}(key) & (numBuckets - 1)) != bucket) continue;
+                auto node = &msvcNodes[used++];
+                *node = MsvcNode{nullptr, prev, key, -static_cast<int32_t>(key)};
+                prev->next = node;
+                prev = node;
+                if (msvcBuckets[bucket * 2] == &msvcNodes[0]) msvcBuckets[bucket * 2] = node;
+                msvcBuckets[bucket * 2 + 1] = node;
+            }
+        }
+        prev->next = &msvcNodes[0];
+        msvcNodes[0].prev = prev;
+    }
+protected:
+    std::vector<MsvcNode>  msvcNodes;
+    std::vector<MsvcNode*> msvcBuckets;
+    MsvcHashMap           msvcMap;
+};
+
+TEST_F(StlLayoutsTest, HashTest)
+{
+    // FNV-1a reference values.
+    EXPECT_EQ(sizeof(std::size_t) == 8 ? static_cast<std::size_t>(0xAF63DC4C8601EC8CULL) 
+        : static_cast<std::size_t>(0xE40C292C), StlHash<StlAbi::Msvc>{}(std::string{"a"}));
+    EXPECT_EQ(internal::fnv1aHash("\x2A\0\0\0", 4), StlHash<StlAbi::Msvc>{}(uint32_t{42}));
+    EXPECT_EQ(42u, StlHash<StlAbi::Libstdcxx>{}(42));
+
+#   if defined(__GLIBCXX__)
+        for (auto str : {"", "a", "abcdefg", "abcdefgh", "a somewhat longer string!"})
+        {
+            EXPECT_EQ(std::hash<std::string>{}(str),
+                StlHash<StlAbi::Libstdcxx>{}(std::string{str}));
+        }
+        EXPECT_EQ(std::hash<std::wstring>{}(L"wide"),
+            StlHash<StlAbi::Libstdcxx>{}(std::wstring{L"wide"}));
+#   endif
+}
+
+TEST_F(StlLayoutsTest, MsvcTest)
+{
+    MsvcString shortStr{};
+    std::memcpy(shortStr.buf, "short", 6);
+    shortStr.size = 5;
+    shortStr.res  = 15;
+
+    MsvcString longStr{};
+    longStr.ptr  = "this one is stored on the heap";
+    longStr.size = std::strlen(longStr.ptr);
+    longStr.res  = 31;
+
+    auto& remoteShort = reinterpret_cast<RemoteString<StlAbi::Msvc>&>(shortStr);
+    auto& remoteLong  = reinterpret_cast<RemoteString<StlAbi::Msvc>&>(longStr);
+    EXPECT_EQ(sizeof(MsvcString), sizeof(remoteShort));
+    EXPECT_EQ("short", remoteShort.str());
+    EXPECT_TRUE(remoteShort == "short" && remoteShort != std::string{"shor"});
+    EXPECT_TRUE(remoteLong == std::string{longStr.ptr});
+    EXPECT_EQ(longStr.ptr, remoteLong.data());
+
+    buildMsvcHashMap(100, 64);
+    auto& map = reinterpret_cast<RemoteHashMap<uint32_t, int32_t, StlAbi::Msvc>&>(msvcMap);
+    EXPECT_EQ(sizeof(MsvcHashMap), sizeof(map));
+    EXPECT_EQ(100u, map.size());
+    EXPECT_EQ(64u,  map.bucketCount());
+    for (uint32_t key = 0; key < 100; ++key)
+    {
+        ASSERT_NE(nullptr, map.find(key));
+        EXPECT_EQ(-static_cast<int32_t>(key), *map.find(key));
+    }
+    EXPECT_FALSE(map.contains(100u));
+    EXPECT_FALSE(map.contains(12345u));
+
+    int32_t sum = 0;
+    map.forEach([&](uint32_t key, int32_t& value) { sum += value; EXPECT_EQ(-value, key); });
+    EXPECT_EQ(-4950, sum);
+}
+
+#if defined(__GLIBCXX__) && _GLIBCXX_USE_CXX11_ABI
+
+TEST_F(StlLayoutsTest, LibstdcxxTest)
+{
+    std::vector<A> vec{{1, 2}, {3, 4}, {5, 6}};
+    vec.reserve(10);
+    auto& remoteVec = reinterpret_cast<RemoteVector<WrapA, StlAbi::Libstdcxx>&>(vec);
+    EXPECT_EQ(3u,  remoteVec.size());
+    EXPECT_EQ(10u, remoteVec.capacity());
+    EXPECT_EQ(3,   remoteVec[1].toStrong().x);
+    remoteVec.view()[2].toStrong().x = 50;
+    EXPECT_EQ(50, vec[2].x);
+
+    std::string shortStr{"short"}, longStr{"this one is stored on the heap"};
+    auto& remoteShort = reinterpret_cast<RemoteString<StlAbi::Libstdcxx>&>(shortStr);
+    auto& remoteLong  = reinterpret_cast<RemoteString<StlAbi::Libstdcxx>&>(longStr);
+    EXPECT_EQ(sizeof(std::string), sizeof(remoteShort));
+    EXPECT_TRUE(remoteShort == shortStr && remoteLong == longStr && remoteShort != longStr);
+
+    std::unordered_map<int32_t, int32_t> ints;
+    for (int32_t i = -500; i < 500; ++i) ints[i * 7] = i;
+    auto& remoteInts = reinterpret_cast<RemoteHashMap<int32_t, int32_t, StlAbi::Libstdcxx>&>(ints);
+    EXPECT_EQ(sizeof(ints), sizeof(remoteInts));
+    EXPECT_EQ(ints.size(), remoteInts.size());
+    EXPECT_EQ(ints.bucket_count(), remoteInts.bucketCount());
+    for (const auto& entry : ints)
+    {
+        ASSERT_NE(nullptr, remoteInts.find(entry.first));
+        EXPECT_EQ(entry.second, *remoteInts.find(entry.first));
+    }
+    EXPECT_FALSE(remoteInts.contains(1));
+    EXPECT_FALSE(remoteInts.contains(7 * 500));
+
+    // String keys have their hash codes cached in the nodes.
+    std::unordered_map<std::string, int32_t> strings;
+    for (int32_t i = 0; i < 50; ++i) strings["key number " + std::to_string(i)] = i;
+    auto& remoteStrings = reinterpret_cast<RemoteHashMap<
+        RemoteString<StlAbi::Libstdcxx>, int32_t, StlAbi::Libstdcxx>&>(strings);
+    for (const auto& entry : strings)
+    {
+        ASSERT_NE(nullptr, remoteStrings.find(entry.first));
+        EXPECT_EQ(entry.second, *remoteStrings.find(entry.first));
+    }
+    EXPECT_FALSE(remoteStrings.contains(std::string{"key number 50"}));
+
+    std::size_t count = 0;
+    remoteStrings.forEach([&](const RemoteString<StlAbi::Libstdcxx>& key, int32_t& value)
+    {
+        EXPECT_EQ(strings.at(key.str()), value);
+        ++count;
+    });
+    EXPECT_EQ(50u, count);
+}
+
+#endif // __GLIBCXX__ && _GLIBCXX_USE_CXX11_ABI
+
+TEST_F(StlLayoutsTest, FieldTest)
+{
+    // The vector layout is the same for both libraries and likely for ours as well.
+    Raw raw{1, {1, 2, 3, 4}};
+    auto wrapped = wrapper_cast<WrapRaw>(&raw);
+    int32_t sum = 0;
+    for (auto value : wrapped.values->view()) sum += value;
+    EXPECT_EQ(10, sum);
+    EXPECT_EQ(4u, wrapped.values->size());
+}
+
+// ============================================================================================== //
+// [FixedString] / [CountedString] testing                                                        //
+// ============================================================================================== //
+
+struct StringFieldsRaw
+{
+    char            name[64];
+    char16_t        title[20];
+    const char16_t* guild;
+    uint32_t        guildLen;
+};
+
+class WrapStringFieldsRaw : public AdvancedClassWrapper<sizeof(StringFieldsRaw)>
+{
+    REMODEL_ADV_WRAPPER(WrapStringFieldsRaw)
+public:
+    Field<char[64]>                          rawName{this, offsetof(StringFieldsRaw, name)};
+    Field<FixedString<char, 64>>             name   {this, offsetof(StringFieldsRaw, name)};
+    Field<FixedString<char16_t, 20>>         title  {this, offsetof(StringFieldsRaw, title)};
+    Field<CountedString<char16_t, uint32_t>> guild  {this, offsetof(StringFieldsRaw, guild)};
+};
+
+TEST(StringFieldsTest, FieldTest)
+{
+    const char16_t guild[] = u"Gr\u00FC\u00DFe \u6F22\U0001F600!\xD800x";
+    StringFieldsRaw raw{};
+    std::memset(raw.name, 'a', sizeof(raw.name));
+    std::memcpy(raw.title, u"Lord of ASCII ranks", 20 * sizeof(char16_t));
+    raw.guild = guild;
+    raw.guildLen = sizeof(guild) / sizeof(char16_t) - 1;
+    auto wrapped = wrapper_cast<WrapStringFieldsRaw>(&raw);
+
+    // Unterminated arrays are bounded, every terminator position is found.
+    EXPECT_EQ(64u, wrapped.name->size());
+    for (std::size_t len = 0; len < 64; ++len)
+    {
+        raw.name[len] = '\0';
+        ASSERT_EQ(len, wrapped.name->size());
+        ASSERT_EQ(len, boundedView(*wrapped.rawName.addressOfObj()).size());
+        raw.name[len] = 'a';
+    }
+    EXPECT_EQ(5u, wrapped.name->assign("alice", 5));
+    EXPECT_TRUE(wrapped.name.get() == "alice");
+    EXPECT_EQ(63u, wrapped.name->assign(std::string(100, 'b').c_str(), 100));
+    EXPECT_EQ(std::string(63, 'b'), wrapped.name->str());
+
+    EXPECT_EQ(19u, wrapped.title->size());
+    EXPECT_EQ("Lord of ASCII ranks", wrapped.title->utf8());
+    EXPECT_FALSE(wrapped.title->empty());
+
+    // Two and three byte sequences, a surrogate pair and an unpaired surrogate.
+    EXPECT_EQ(12u, wrapped.guild->size());
+    EXPECT_EQ("Gr\xC3\xBC\xC3\x9F" "e \xE6\xBC\xA2\xF0\x9F\x98\x80!\xEF\xBF\xBDx", 
+        wrapped.guild->utf8());
+    EXPECT_TRUE(wrapped.guild.get() == guild);
+
+    // Long mixed input crossing the SIMD blocks.
+    std::u16string mixed;
+    std::string expected;
+    for (int i = 0; i < 50; ++i)
+    {
+        mixed += u"abcdefghijk\u00E9";
+        expected += "abcdefghijk\xC3\xA9";
+    }
+    EXPECT_EQ(expected, utf16ToUtf8(mixed.data(), mixed.size()));
+
+    raw.guild = nullptr;
+    EXPECT_TRUE(wrapped.guild->empty());
+    EXPECT_EQ("", wrapped.guild->utf8());
+}
+
+// ============================================================================================== //
+// [RemoteInstance] testing                                                                       //
+// ============================================================================================== //
+
+class RemoteInstanceTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        uint8_t pad[64];
+        int32_t y;
+        int32_t z;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t>                       x{this, offsetof(A, x)};
+        Field<int32_t>                       y{this, offsetof(A, y)};
+        StaticField<int32_t, offsetof(A, z)> z{this};
+    };
+
+    // Local accessor counting the issued transfers.
+    struct CountingAccessor : LocalMemoryAccessor
+    {
+        bool read(const MemoryRange* ranges, std::size_t count)
+        {
+            ++numReads;
+            return LocalMemoryAccessor::read(ranges, count);
+        }
+
+        bool write(const MemoryRange& range)
+        {
+            ++numWrites;
+            bytesWritten += range.size;
+            return LocalMemoryAccessor::write(range);
+        }
+
+        int numReads = 0;
+        int numWrites = 0;
+        std::size_t bytesWritten = 0;
+    };
+protected:
+    RemoteInstanceTest()
+        : objs{{1, {}, 2, 3}, {4, {}, 5, 6}}
+    {}
+protected:
+    A objs[2];
+    CountingAccessor accessor;
+};
+
+TEST_F(RemoteInstanceTest, SnapshotTest)
+{
+    RemoteInstance<WrapA, CountingAccessor> remote{accessor, &objs[0]};
+    EXPECT_FALSE(remote.isValid());
+    EXPECT_TRUE(remote.refresh());
+    EXPECT_EQ(1, accessor.numReads);
+    EXPECT_EQ(1, remote->x);
+    EXPECT_EQ(2, remote->y);
+    EXPECT_EQ(3, remote->z);
+
+    // Modifications stay local until committed.
+    remote->y = 20;
+    remote->z = 30;
+    EXPECT_TRUE(remote.isDirty());
+    EXPECT_EQ(2, objs[0].y);
+
+    // y and z are adjacent and thus written back in one go, x is untouched.
+    EXPECT_TRUE(remote.commit());
+    EXPECT_FALSE(remote.isDirty());
+    EXPECT_EQ(1,  accessor.numWrites);
+    EXPECT_EQ(20, objs[0].y);
+    EXPECT_EQ(30, objs[0].z);
+
+    remote->x = 10;
+    remote->z = 31;
+    EXPECT_TRUE(remote.commit());
+    EXPECT_EQ(3, accessor.numWrites);
+    EXPECT_EQ(10, objs[0].x);
+    EXPECT_GT(sizeof(A), accessor.bytesWritten);
+
+    auto copy = remote;
+    objs[0].x = 100;
+    EXPECT_TRUE(copy.refresh());
+    EXPECT_EQ(100, copy->x);
+    EXPECT_EQ(10,  remote->x);
+}
+
+TEST_F(RemoteInstanceTest, LazySnapshotTest)
+{
+    auto wrapA = wrapper_cast<WrapA>(&objs[0]);
+    auto snapshot = wrapA.snapshot(accessor);
+    EXPECT_EQ(1, accessor.numReads);
+
+    // All field reads are served by the snapshot's single read.
+    EXPECT_EQ(1, snapshot->x);
+    EXPECT_EQ(2, snapshot->y);
+    EXPECT_EQ(3, snapshot->z);
+    EXPECT_EQ(1, accessor.numReads);
+
+    objs[0].x = 42;
+    EXPECT_EQ(1,  snapshot->x);
+    snapshot.invalidate();
+    EXPECT_EQ(42, snapshot->x);
+    EXPECT_EQ(2,  accessor.numReads);
+
+    // Local objects can be snapshotted without specifying an accessor.
+    const auto localSnapshot = wrapA.snapshot();
+    objs[0].x = 43;
+    EXPECT_EQ(42, localSnapshot->x);
+    EXPECT_EQ(43, wrapA.x);
+}
+
+TEST_F(RemoteInstanceTest, BatchTest)
+{
+    // Plain instances are read lazily on first access.
+    RemoteInstance<WrapA, CountingAccessor> lazy{accessor, &objs[1]};
+    EXPECT_EQ(0, accessor.numReads);
+    EXPECT_EQ(4, lazy->x);
+    EXPECT_EQ(1, accessor.numReads);
+    accessor.numReads = 0;
+
+    using Remote = RemoteInstance<WrapA, CountingAccessor>;
+    Remote remotes[] = {{accessor, &objs[0]}, {accessor, &objs[1]}};
+
+    EXPECT_TRUE(Remote::refreshAll(remotes, 2));
+    EXPECT_EQ(1, accessor.numReads);
+    EXPECT_EQ(1, remotes[0]->x);
+    EXPECT_EQ(6, remotes[1]->z);
+}
+
+TEST_F(RemoteInstanceTest, SpanTest)
+{
+    std::vector<A> many(103);
+    for (std::size_t i = 0; i < many.size(); ++i) 
+    {
+        many[i].x = static_cast<int32_t>(i);
+        many[i].z = static_cast<int32_t>(i * 2);
+    }
+
+    for (auto mode : {RemoteReadMode::Blocking, RemoteReadMode::DoubleBuffered})
+    {
+        accessor.numReads = 0;
+        auto remote = RemoteSpan<WrapA, CountingAccessor>::of(
+            WrapperSpan<WrapA>{many.data(), many.size()}, accessor, 16, mode);
+        EXPECT_EQ(many.size(), remote.size());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(many.data()), remote.remoteAddress());
+
+        int32_t expected = 0;
+        auto it = remote.begin();
+        for (; it != remote.end(); ++it, ++expected)
+        {
+            ASSERT_TRUE(it.isValid());
+            EXPECT_EQ(expected, it->x);
+            EXPECT_EQ(expected * 2, (*it).z);
+            EXPECT_NE(static_cast<void*>(&many[expected]), it->addressOfObj());
+
+            // Changes stay local.
+            it->x = -1;
+        }
+        EXPECT_EQ(103, expected);
+        EXPECT_EQ(7u, it.windowReads());
+        EXPECT_EQ(7, accessor.numReads);
+        EXPECT_EQ(0, many[0].x);
+    }
+
+    std::size_t visited = 0;
+    for (auto& obj : RemoteSpan<WrapA, CountingAccessor>{
+        accessor, reinterpret_cast<uintptr_t>(many.data()), 5, 2})
+    {
+        EXPECT_EQ(static_cast<int32_t>(visited++), obj.x);
+    }
+    EXPECT_EQ(5u, visited);
+
+    RemoteSpan<WrapA, CountingAccessor> empty{accessor, uintptr_t{0}, 0};
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+TEST_F(RemoteInstanceTest, ProcessSpanTest)
+{
+    // The first objects are readable, the following ones are not.
+    auto pageSize = platform::pageSize();
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        auto pages = static_cast<uint8_t*>(VirtualAlloc(nullptr, 2 * pageSize, 
+            MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        VirtualFree(pages + pageSize, pageSize, MEM_DECOMMIT);
+#   else
+        auto pages = static_cast<uint8_t*>(mmap(nullptr, 2 * pageSize, PROT_READ | PROT_WRITE, 
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        munmap(pages + pageSize, pageSize);
+#   endif
+
+    auto numReadable = pageSize / sizeof(A);
+    auto objs = reinterpret_cast<A*>(pages);
+    for (std::size_t i = 0; i < numReadable; ++i) objs[i].x = static_cast<int32_t>(i);
+
+    ProcessMemoryAccessor process{platform::currentProcess()};
+    RemoteSpan<WrapA, ProcessMemoryAccessor> remote{process, reinterpret_cast<uintptr_t>(objs),
+        numReadable + 8, 8, RemoteReadMode::DoubleBuffered};
+
+    std::size_t valid = 0, invalid = 0;
+    for (auto it = remote.begin(); it != remote.end(); ++it)
+    {
+        if (it.isValid()) 
+        {
+            EXPECT_EQ(static_cast<int32_t>(it.index()), it->x);
+            ++valid;
+        }
+        else
+        {
+            ++invalid;
+        }
+    }
+    EXPECT_EQ(numReadable, valid);
+    EXPECT_EQ(8u, invalid);
+
+#   if defined(ZYCORE_WINDOWS) || defined(ZYCORE_WIN32)
+        VirtualFree(pages, 0, MEM_RELEASE);
+#   else
+        munmap(pages, pageSize);
+#   endif
+}
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+TEST_F(RemoteInstanceTest, ProcessMemoryTest)
+{
+    ProcessMemoryAccessor process{platform::currentProcess()};
+    using Remote = RemoteInstance<WrapA, ProcessMemoryAccessor>;
+    Remote remotes[] = {{process, &objs[0]}, {process, &objs[1]}};
+
+    ASSERT_TRUE(Remote::refreshAll(remotes, 2));
+    EXPECT_EQ(1, remotes[0]->x);
+    EXPECT_EQ(5, remotes[1]->y);
+
+    remotes[1]->y = 50;
+    EXPECT_TRUE(remotes[1].commit());
+    EXPECT_EQ(50, objs[1].y);
+
+    Remote invalid{process, uintptr_t{0}};
+    EXPECT_FALSE(invalid.refresh());
+}
+
+#ifdef REMODEL_HAS_REGION_QUERY
+
+TEST_F(RemoteInstanceTest, ProcessRegionsTest)
+{
+    auto addr = reinterpret_cast<uintptr_t>(&objs[0]);
+    bool found = false, ascending = true;
+    uintptr_t prevEnd = 0;
+    EXPECT_TRUE(platform::enumProcessRegions(platform::currentProcess(), 
+        [&](uintptr_t begin, std::size_t size, bool writable)
+    {
+        ascending &= begin >= prevEnd;
+        prevEnd = begin + size;
+        found |= addr >= begin && addr + sizeof(objs) <= begin + size && writable;
+    }));
+    EXPECT_TRUE(found);
+    EXPECT_TRUE(ascending);
+
+    // Unordered, adjacent and overlapping ranges, coalesced into few calls where supported.
+    int32_t values[4] = {};
+    MemoryRange ranges[] = {
+        {reinterpret_cast<uintptr_t>(&objs[1].z), &values[0], sizeof(int32_t)},
+        {reinterpret_cast<uintptr_t>(&objs[0].x), &values[1], sizeof(int32_t)},
+        {reinterpret_cast<uintptr_t>(&objs[0].y), &values[2], 2 * sizeof(int32_t)},
+    };
+    EXPECT_TRUE(platform::readProcessMemory(platform::currentProcess(), ranges, 3));
+    EXPECT_EQ(6, values[0]);
+    EXPECT_EQ(1, values[1]);
+    EXPECT_EQ(2, values[2]);
+    EXPECT_EQ(3, values[3]);
+}
+
+#endif // ifdef REMODEL_HAS_REGION_QUERY
+
+#ifdef REMODEL_HAS_IO_URING
+
+TEST_F(RemoteInstanceTest, UringMemoryTest)
+{
+    UringMemoryAccessor process{platform::currentProcess(), 64};
+    ASSERT_TRUE(process.isValid());
+    using Remote = RemoteInstance<WrapA, UringMemoryAccessor>;
+
+    // More objects than ring entries, so several batches are submitted.
+    std::vector<A> many(300);
+    for (std::size_t i = 0; i < many.size(); ++i) many[i].x = static_cast<int32_t>(i);
+    std::vector<Remote> remotes;
+    for (auto& obj : many) remotes.emplace_back(process, &obj);
+    ASSERT_TRUE(Remote::refreshAll(remotes.data(), remotes.size()));
+    EXPECT_EQ(0,   remotes[0]->x);
+    EXPECT_EQ(299, remotes[299]->x);
+
+    remotes[1]->y = 50;
+    EXPECT_TRUE(remotes[1].commit());
+    EXPECT_EQ(50, many[1].y);
+
+    // A failing range doesn't affect the other ranges of the batch.
+    int32_t values[3] = {};
+    MemoryRange ranges[] = {
+        {reinterpret_cast<uintptr_t>(&many[7].x), &values[0], sizeof(int32_t)},
+        {uintptr_t{0},                           &values[1], sizeof(int32_t)},
+        {reinterpret_cast<uintptr_t>(&many[9].x), &values[2], sizeof(int32_t)},
+    };
+    EXPECT_FALSE(process.read(ranges, 3));
+    EXPECT_EQ(7, values[0]);
+    EXPECT_EQ(9, values[2]);
+}
+
+#endif // ifdef REMODEL_HAS_IO_URING
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+// ============================================================================================== //
+// [PageCacheAccessor] testing                                                                    //
+// ============================================================================================== //
+
+class PageCacheTest : public testing::Test
+{
+protected:
+    static const std::size_t kPageSize = PageCacheAccessor<LocalMemoryAccessor>::kPageSize;
+
+    struct A
+    {
+        int32_t x;
+        int32_t y;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t> x{this, offsetof(A, x)};
+        Field<int32_t> y{this, offsetof(A, y)};
+    };
+
+    // Local accessor counting reads, failing whole-page reads of one page.
+    struct CountingAccessor : LocalMemoryAccessor
+    {
+        bool read(const MemoryRange& range)
+        {
+            ++numReads;
+            if (range.address / kPageSize == failingPage && range.size == kPageSize) return false;
+            return LocalMemoryAccessor::read(range);
+        }
+
+        bool read(const MemoryRange* ranges, std::size_t count)
+        {
+            bool success = true;
+            for (std::size_t i = 0; i < count; ++i) success &= read(ranges[i]);
+            --numReads;
+            numRanges += count;
+            ++numBatches;
+            return success;
+        }
+
+        int numReads = 0;
+        int numBatches = 0;
+        std::size_t numRanges = 0;
+        uintptr_t failingPage = 0;
+    };
+
+    template<typename T>
+    T readVia(PageCacheAccessor<CountingAccessor>& cache, const void* ptr)
+    {
+        T value{};
+        EXPECT_TRUE(cache.read(MemoryRange{reinterpret_cast<uintptr_t>(ptr), &value, sizeof(T)}));
+        return value;
+    }
+protected:
+    PageCacheTest()
+        : storage(4 * kPageSize)
+        , memory{reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(storage.data()) 
+            + kPageSize - 1) / kPageSize * kPageSize)}
+    {}
+protected:
+    // Fixtures are heap-allocated, `new` doesn't honor over-aligned members before C++17.
+    std::vector<uint8_t> storage;
+    uint8_t* memory;
+    CountingAccessor inner;
+};
+
+TEST_F(PageCacheTest, ReadTest)
+{
+    PageCacheAccessor<CountingAccessor> cache{inner};
+    uint64_t value = 0x1122334455667788;
+    std::memcpy(&memory[kPageSize - 4], &value, sizeof(value));
+    for (int i = 0; i < 100; ++i) memory[i] = static_cast<uint8_t>(i);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(readVia<uint8_t>(cache, &memory[i]), i);
+    EXPECT_EQ(cache.fetchCount(), 1u);
+    EXPECT_EQ(cache.pagesFetched(), 1u);
+
+    // Spanning the first two pages, fetching the second one only.
+    EXPECT_EQ(readVia<int32_t>(cache, &memory[kPageSize - 4]), 0x55667788);
+    EXPECT_EQ(readVia<uint64_t>(cache, &memory[kPageSize - 4]), 0x1122334455667788u);
+    EXPECT_EQ(cache.pagesFetched(), 2u);
+
+    // Changes are only seen after invalidating.
+    memory[10] = 0xFF;
+    memory[kPageSize + 10] = 0xFF;
+    EXPECT_EQ(readVia<uint8_t>(cache, &memory[10]), 10);
+    cache.invalidate(reinterpret_cast<uintptr_t>(&memory[10]), 1);
+    EXPECT_EQ(readVia<uint8_t>(cache, &memory[10]), 0xFF);
+    EXPECT_EQ(readVia<uint8_t>(cache, &memory[kPageSize + 10]), 0);
+    cache.invalidate();
+    EXPECT_EQ(readVia<uint8_t>(cache, &memory[kPageSize + 10]), 0xFF);
+    EXPECT_EQ(cache.pagesFetched(), 4u);
+
+    // Writes are passed through and update the cache, the first page isn't cached anymore.
+    uint32_t written = 0xDEADBEEF;
+    EXPECT_TRUE(cache.write(MemoryRange{reinterpret_cast<uintptr_t>(&memory[kPageSize - 2]), 
+        &written, sizeof(written)}));
+    EXPECT_EQ(readVia<uint32_t>(cache, &memory[kPageSize - 2]), 0xDEADBEEF);
+    uint32_t direct;
+    std::memcpy(&direct, &memory[kPageSize - 2], sizeof(direct));
+    EXPECT_EQ(direct, 0xDEADBEEF);
+    EXPECT_EQ(cache.pagesFetched(), 5u);
+
+    cache.setMaxAge(std::chrono::nanoseconds{1});
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    readVia<uint8_t>(cache, &memory[0]);
+    EXPECT_EQ(cache.pagesFetched(), 6u);
+}
+
+TEST_F(PageCacheTest, BatchTest)
+{
+    PageCacheAccessor<CountingAccessor> cache{inner};
+    A* objs = reinterpret_cast<A*>(memory);
+    using Remote = RemoteInstance<WrapA, PageCacheAccessor<CountingAccessor>>;
+    Remote remotes[] = {{cache, &objs[0]}, {cache, &objs[kPageSize / sizeof(A)]}, 
+        {cache, &objs[2 * kPageSize / sizeof(A) + 1]}};
+    objs[1 + 2 * kPageSize / sizeof(A)].y = 5;
+
+    ASSERT_TRUE(Remote::refreshAll(remotes, 3));
+    EXPECT_EQ(remotes[2]->y, 5);
+    EXPECT_EQ(inner.numBatches, 1);
+    EXPECT_EQ(inner.numRanges, 3u);
+    ASSERT_TRUE(Remote::refreshAll(remotes, 3));
+    EXPECT_EQ(inner.numBatches, 1);
+
+    // Exceeding the capacity bypasses the cache.
+    PageCacheAccessor<CountingAccessor> small{inner, 2};
+    ASSERT_TRUE(Remote::refreshAll(remotes, 3));
+    Remote viaSmall[] = {{small, &objs[0]}, {small, &objs[kPageSize / sizeof(A)]}, 
+        {small, &objs[2 * kPageSize / sizeof(A) + 1]}};
+    ASSERT_TRUE(Remote::refreshAll(viaSmall, 3));
+    EXPECT_EQ(small.pagesFetched(), 0u);
+    EXPECT_EQ(viaSmall[2]->y, 5);
+}
+
+TEST_F(PageCacheTest, FailingPageTest)
+{
+    PageCacheAccessor<CountingAccessor> cache{inner};
+    inner.failingPage = reinterpret_cast<uintptr_t>(&memory[kPageSize]) / kPageSize;
+    memory[kPageSize + 1] = 42;
+
+    // The page can't be fetched, the range is read directly.
+    EXPECT_EQ(readVia<uint8_t>(cache, &memory[kPageSize + 1]), 42);
+    EXPECT_EQ(readVia<uint8_t>(cache, &memory[kPageSize + 1]), 42);
+    EXPECT_EQ(cache.pagesFetched(), 2u);
+    EXPECT_EQ(inner.numReads, 4);
+}
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+TEST_F(PageCacheTest, ProcessMemoryTest)
+{
+    ProcessMemoryAccessor process{platform::currentProcess()};
+    PageCacheAccessor<ProcessMemoryAccessor> cache{process};
+    memory[123] = 7;
+    uint8_t value = 0;
+    EXPECT_TRUE(cache.read(MemoryRange{reinterpret_cast<uintptr_t>(&memory[123]), &value, 1}));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(cache.read(MemoryRange{uintptr_t{16}, &value, 1}));
+    EXPECT_EQ(cache.pagesFetched(), 2u);
+}
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+// ============================================================================================== //
+// [WriteCombiningAccessor] testing                                                               //
+// ============================================================================================== //
+
+class WriteCombiningTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        int32_t y;
+        uint8_t pad[64];
+        int32_t z;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t> x{this, offsetof(A, x)};
+        Field<int32_t> y{this, offsetof(A, y)};
+        Field<int32_t> z{this, offsetof(A, z)};
+    };
+
+    // Local accessor recording batched writes.
+    struct RecordingAccessor : LocalMemoryAccessor
+    {
+        using LocalMemoryAccessor::write;
+
+        bool write(const MemoryRange* ranges, std::size_t count)
+        {
+            ++numBatches;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                written.push_back({ranges[i].address, ranges[i].size});
+                LocalMemoryAccessor::write(ranges[i]);
+            }
+            return true;
+        }
+
+        int numBatches = 0;
+        std::vector<std::pair<uintptr_t, std::size_t>> written;
+    };
+protected:
+    uintptr_t addr(const void* ptr) const { return reinterpret_cast<uintptr_t>(ptr); }
+protected:
+    A objs[2] = {{1, 2, {}, 3}, {4, 5, {}, 6}};
+    RecordingAccessor inner;
+};
+
+TEST_F(WriteCombiningTest, CommitTest)
+{
+    // Separate changes of a single object are written in one batch.
+    RemoteInstance<WrapA, RecordingAccessor> remote{inner, &objs[0]};
+    remote->x = 10;
+    remote->z = 30;
+    EXPECT_TRUE(remote.commit());
+    EXPECT_EQ(inner.numBatches, 1);
+    ASSERT_EQ(inner.written.size(), 2u);
+    EXPECT_EQ(objs[0].x, 10);
+    EXPECT_EQ(objs[0].z, 30);
+    EXPECT_FALSE(remote.isDirty());
+}
+
+TEST_F(WriteCombiningTest, CoalesceTest)
+{
+    {
+        WriteCombiningAccessor<RecordingAccessor> combiner{inner};
+        using Remote = RemoteInstance<WrapA, WriteCombiningAccessor<RecordingAccessor>>;
+        Remote remotes[] = {{combiner, &objs[0]}, {combiner, &objs[1]}};
+        ASSERT_TRUE(Remote::refreshAll(remotes, 2));
+
+        // Changing all bytes, commits write changed bytes only.
+        remotes[1]->z = 0x60606060;
+        remotes[0]->x = 0x10101010;
+        remotes[0]->z = 0x30303030;
+        EXPECT_TRUE(remotes[0].commit());
+        EXPECT_TRUE(remotes[1].commit());
+        remotes[0]->y = 0x20202020;
+        EXPECT_TRUE(remotes[0].commit());
+        EXPECT_EQ(objs[0].x, 1);
+        EXPECT_EQ(inner.numBatches, 0);
+        EXPECT_EQ(combiner.pendingRanges(), 3u);
+        EXPECT_EQ(combiner.pendingBytes(), 16u);
+
+        // Reads see the buffered writes.
+        remotes[0].invalidate();
+        EXPECT_EQ(remotes[0]->x, 0x10101010);
+        EXPECT_EQ(remotes[0]->y, 0x20202020);
+
+        // x and y were coalesced, written along with x.
+        EXPECT_TRUE(combiner.flush());
+        EXPECT_TRUE(combiner.flush());
+        EXPECT_EQ(combiner.flushCount(), 1u);
+        EXPECT_EQ(inner.numBatches, 1);
+        using Written = std::vector<std::pair<uintptr_t, std::size_t>>;
+        EXPECT_EQ(inner.written, (Written{
+            {addr(&objs[0].x), 8}, {addr(&objs[0].z), 4}, {addr(&objs[1].z), 4}}));
+        EXPECT_EQ(objs[0].y, 0x20202020);
+        EXPECT_EQ(objs[1].z, 0x60606060);
+
+        int32_t value = 7;
+        combiner.write(MemoryRange{addr(&objs[1].x), &value, sizeof(value)});
+    }
+    // Flushed on destruction.
+    EXPECT_EQ(objs[1].x, 7);
+    EXPECT_EQ(inner.numBatches, 2);
+}
+
+TEST_F(WriteCombiningTest, OverlapTest)
+{
+    WriteCombiningAccessor<RecordingAccessor> combiner{inner, 8};
+    uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    auto base = addr(objs[0].pad);
+    combiner.write(MemoryRange{base + 4, bytes, 2});
+    combiner.write(MemoryRange{base,     bytes, 2});
+    combiner.write(MemoryRange{base + 1, bytes + 4, 4});
+    EXPECT_EQ(combiner.pendingRanges(), 1u);
+    EXPECT_EQ(combiner.pendingBytes(), 6u);
+    EXPECT_EQ(inner.numBatches, 0);
+
+    uint8_t read[6] = {};
+    EXPECT_TRUE(combiner.read(MemoryRange{base, read, sizeof(read)}));
+    EXPECT_EQ(std::vector<uint8_t>(read, read + 6), (std::vector<uint8_t>{1, 5, 6, 7, 8, 2}));
+
+    // Exceeding the limit flushes.
+    combiner.write(MemoryRange{base + 10, bytes, 4});
+    EXPECT_EQ(inner.numBatches, 1);
+    EXPECT_EQ(combiner.pendingRanges(), 0u);
+    EXPECT_EQ(std::vector<uint8_t>(objs[0].pad, objs[0].pad + 6), 
+        (std::vector<uint8_t>{1, 5, 6, 7, 8, 2}));
+    EXPECT_EQ(objs[0].pad[13], 4);
+}
+
+#ifdef REMODEL_HAS_PROCESS_MEMORY
+
+TEST_F(WriteCombiningTest, ProcessMemoryTest)
+{
+    ProcessMemoryAccessor process{platform::currentProcess()};
+    int32_t values[] = {10, 40};
+    MemoryRange ranges[] = {
+        {addr(&objs[0].x), &values[0], 4}, {addr(&objs[1].x), &values[1], 4}};
+    EXPECT_TRUE(process.write(ranges, 2));
+    EXPECT_EQ(objs[0].x, 10);
+    EXPECT_EQ(objs[1].x, 40);
+
+    // The faulting range is skipped, the others are still written.
+    values[0] = 11;
+    MemoryRange faulting[] = {
+        {addr(&objs[0].x), &values[0], 4}, {uintptr_t{16}, &values[1], 4}, 
+        {addr(&objs[1].z), &values[1], 4}};
+    EXPECT_FALSE(process.write(faulting, 3));
+    EXPECT_EQ(objs[0].x, 11);
+    EXPECT_EQ(objs[1].z, 40);
+}
+
+#endif // ifdef REMODEL_HAS_PROCESS_MEMORY
+
+// ============================================================================================== //
+// [DumpMemoryAccessor] testing                                                                   //
+// ============================================================================================== //
+
+#ifdef REMODEL_HAS_MAPPED_FILE
+
+class DumpTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        int32_t y;
+        int64_t z;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A), alignof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t> x{this, offsetof(A, x)};
+        Field<int32_t> y{this, offsetof(A, y)};
+        Field<int64_t> z{this, offsetof(A, z)};
+    };
+
+    template<typename T>
+    static void put(std::vector<uint8_t>& dump, std::size_t offs, T value)
+    {
+        if (dump.size() < offs + sizeof(T)) dump.resize(offs + sizeof(T));
+        std::memcpy(dump.data() + offs, &value, sizeof(T));
+    }
+
+    bool open(const std::vector<uint8_t>& dump)
+    {
+        auto file = std::fopen(kPath, "wb");
+        if (!file) return false;
+        std::fwrite(dump.data(), 1, dump.size(), file);
+        std::fclose(file);
+        return accessor.open(kPath);
+    }
+
+    ~DumpTest() { accessor.close(); std::remove(kPath); }
+protected:
+    const char* kPath = "remodel_test.dump";
+    DumpMemoryAccessor accessor;
+};
+
+TEST_F(DumpTest, ElfCoreTest)
+{
+    // ELFCLASS64 core: a PT_NOTE and three PT_LOAD segments, the first two adjacent, the third
+    // without contents in the file.
+    std::vector<uint8_t> dump(0x200);
+    std::memcpy(dump.data(), "\x7F" "ELF\x02\x01\x01", 7);
+    put<uint16_t>(dump, 16, 4);
+    put<uint64_t>(dump, 32, 64);
+    put<uint16_t>(dump, 56, 4);
+    struct { uint32_t type; uint64_t offset, address, fileSize; } segments[] = {
+        {4, 0x100, 0,       0x10},
+        {1, 0x120, 0x10008, 0x08},
+        {1, 0x180, 0x10010, 0x10},
+        {1, 0,     0x20000, 0},
+    };
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        auto phdr = 64 + i * 56;
+        put(dump, phdr,      segments[i].type);
+        put(dump, phdr + 8,  segments[i].offset);
+        put(dump, phdr + 16, segments[i].address);
+        put(dump, phdr + 32, segments[i].fileSize);
+        put(dump, phdr + 40, segments[i].fileSize + 0x1000);
+    }
+    put<int32_t>(dump, 0x120, 1);
+    put<int32_t>(dump, 0x124, 2);
+    put<int64_t>(dump, 0x180, 3);
+
+    ASSERT_TRUE(open(dump));
+    EXPECT_EQ(accessor.format(), DumpMemoryAccessor::Format::kElfCore);
+    ASSERT_EQ(accessor.regions().size(), 2u);
+    EXPECT_EQ(accessor.regions()[1].address, 0x10010u);
+
+    // The object spans both segments.
+    using Remote = RemoteInstance<WrapA, DumpMemoryAccessor>;
+    Remote remote{accessor, uintptr_t{0x10008}};
+    ASSERT_TRUE(remote.refresh());
+    EXPECT_EQ(remote->x, 1);
+    EXPECT_EQ(remote->y, 2);
+    EXPECT_EQ(remote->z, 3);
+    remote->x = 10;
+    EXPECT_FALSE(remote.commit());
+
+    EXPECT_EQ(static_cast<const uint8_t*>(accessor.translate(0x10008, 8)), 
+        static_cast<const uint8_t*>(accessor.translate(0x1000C, 4)) - 4);
+    EXPECT_EQ(accessor.translate(0x10008, 9), nullptr);
+    EXPECT_FALSE((Remote{accessor, uintptr_t{0x10018}}.refresh()));
+    EXPECT_FALSE((Remote{accessor, uintptr_t{0x20000}}.refresh()));
+    EXPECT_FALSE((Remote{accessor, uintptr_t{0x10000}}.refresh()));
+}
+
+TEST_F(DumpTest, MinidumpTest)
+{
+    // Header, a MemoryListStream and a Memory64ListStream.
+    std::vector<uint8_t> dump(0x200);
+    put<uint32_t>(dump, 0,  0x504D444D);
+    put<uint32_t>(dump, 4,  0xA793);
+    put<uint32_t>(dump, 8,  2);
+    put<uint32_t>(dump, 12, 32);
+    put<uint32_t>(dump, 32, 5);
+    put<uint32_t>(dump, 40, 0x60);
+    put<uint32_t>(dump, 44, 9);
+    put<uint32_t>(dump, 52, 0x80);
+
+    put<uint32_t>(dump, 0x60, 1);
+    put<uint64_t>(dump, 0x64, 0x5000);
+    put<uint32_t>(dump, 0x6C, sizeof(A));
+    put<uint32_t>(dump, 0x70, 0x100);
+    put(dump, 0x100, A{4, 5, 6});
+
+    put<uint64_t>(dump, 0x80, 2);
+    put<uint64_t>(dump, 0x88, 0x140);
+    put<uint64_t>(dump, 0x90, 0x7000);
+    put<uint64_t>(dump, 0x98, 0x10);
+    put<uint64_t>(dump, 0xA0, 0x9000);
+    put<uint64_t>(dump, 0xA8, 0x1000);
+    put(dump, 0x140, A{7, 8, 9});
+    put(dump, 0x150, A{10, 11, 12});
+
+    ASSERT_TRUE(open(dump));
+    EXPECT_EQ(accessor.format(), DumpMemoryAccessor::Format::kMinidump);
+    ASSERT_EQ(accessor.regions().size(), 3u);
+    // Clipped to the end of the file.
+    EXPECT_EQ(accessor.regions()[2].size, 0x200u - 0x150u);
+
+    using Remote = RemoteInstance<WrapA, DumpMemoryAccessor>;
+    Remote remotes[] = {
+        {accessor, uintptr_t{0x5000}}, {accessor, uintptr_t{0x7000}}, 
+        {accessor, uintptr_t{0x9000}}};
+    EXPECT_TRUE(Remote::refreshAll(remotes, 3));
+    EXPECT_EQ(remotes[0]->y, 5);
+    EXPECT_EQ(remotes[1]->z, 9);
+    EXPECT_EQ(remotes[2]->x, 10);
+}
+
+TEST_F(DumpTest, InvalidTest)
+{
+    std::vector<uint8_t> dump(64);
+    std::memcpy(dump.data(), "\x7F" "ELF\x02\x01\x01", 7);
+    put<uint16_t>(dump, 16, 2);
+    EXPECT_FALSE(open(dump));
+    EXPECT_FALSE(accessor.isOpen());
+
+    // Segments beyond the end of the file.
+    put<uint16_t>(dump, 16, 4);
+    put<uint64_t>(dump, 32, 64);
+    put<uint16_t>(dump, 56, 1);
+    EXPECT_FALSE(open(dump));
+
+    put<uint32_t>(dump, 0, 0x504D444D);
+    put<uint32_t>(dump, 8, 1);
+    put<uint32_t>(dump, 12, 1000);
+    EXPECT_FALSE(open(dump));
+    EXPECT_FALSE(accessor.open("/nonexistent/remodel.dump"));
+}
+
+#endif // ifdef REMODEL_HAS_MAPPED_FILE
+
+// ============================================================================================== //
+// [RemoteCallQueue] testing                                                                      //
+// ============================================================================================== //
+
+int remoteMultiply(int a, int b)
+{
+    return a * b;
+}
+
+const char* remoteOffset(const char* ptr, std::size_t offs)
+{
+    return ptr + offs;
+}
+
+class RemoteCallQueueTest : public testing::Test
+{
+protected:
+    struct CountingAccessor : LocalMemoryAccessor
+    {
+        using LocalMemoryAccessor::read;
+
+        bool read(const MemoryRange* ranges, std::size_t count)
+        {
+            ++numReads;
+            return LocalMemoryAccessor::read(ranges, count);
+        }
+
+        bool write(const MemoryRange& range)
+        {
+            ++numWrites;
+            return LocalMemoryAccessor::write(range);
+        }
+
+        int numReads = 0;
+        int numWrites = 0;
+    };
+protected:
+    CountingAccessor accessor;
+};
+
+TEST_F(RemoteCallQueueTest, BatchTest)
+{
+    CallQueueWorker worker{8};
+    RemoteCallQueue<CountingAccessor> queue{accessor, worker.address()};
+    EXPECT_FALSE(queue.flush());
+    ASSERT_TRUE(queue.attach());
+
+    std::vector<CallFuture<int>> products;
+    for (int i = 0; i < 20; ++i) products.push_back(queue.call<int>(
+        reinterpret_cast<uintptr_t>(&remoteMultiply), i, -3));
+    EXPECT_FALSE(products[0].isReady());
+    EXPECT_FALSE(products[0].get());
+    EXPECT_EQ(queue.pending(), 20u);
+
+    // One write for the slots and one for the counter, limited by the capacity.
+    accessor.numWrites = 0;
+    ASSERT_TRUE(queue.flush());
+    EXPECT_EQ(accessor.numWrites, 2);
+    EXPECT_EQ(queue.pending(), 12u);
+    EXPECT_EQ(queue.inFlight(), 8u);
+    ASSERT_TRUE(queue.flush());
+    EXPECT_EQ(accessor.numWrites, 2);
+
+    EXPECT_EQ(worker.runPending(), 8u);
+    EXPECT_EQ(worker.runPending(), 0u);
+    accessor.numReads = 0;
+    ASSERT_TRUE(queue.poll());
+    EXPECT_EQ(accessor.numReads, 1);
+    EXPECT_EQ(queue.inFlight(), 0u);
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(products[i].isReady());
+        EXPECT_EQ(products[i].get().value(), -3 * i);
+    }
+    EXPECT_FALSE(products[8].isReady());
+
+    // Wrapping around the end of the ring.
+    ASSERT_TRUE(queue.flush());
+    EXPECT_EQ(worker.runPending(), 8u);
+    ASSERT_TRUE(queue.progress());
+    EXPECT_EQ(worker.runPending(), 4u);
+    ASSERT_TRUE(queue.poll());
+    for (int i = 8; i < 20; ++i) EXPECT_EQ(products[i].get().value(), -3 * i);
+}
+
+TEST_F(RemoteCallQueueTest, WorkerThreadTest)
+{
+    CallQueueWorker worker{16};
+    std::atomic<bool> stop{false};
+    std::thread thread{[&] { worker.run(stop, std::chrono::microseconds{10}); }};
+
+    RemoteCallQueue<CountingAccessor> queue{accessor, worker.address()};
+    ASSERT_TRUE(queue.attach());
+    Function<int (*)(int, int)> multiply{&remoteMultiply};
+    const char kText[] = "remodel";
+
+    std::vector<CallFuture<int>> products;
+    for (int i = 0; i < 300; ++i) products.push_back(queue.call(multiply, i, 2));
+    auto offset = queue.call(Function<const char* (*)(const char*, std::size_t)>{&remoteOffset}, 
+        kText, std::size_t{2});
+    auto discarded = queue.call<void>(reinterpret_cast<uintptr_t>(&remoteMultiply), 1, 1);
+    ASSERT_TRUE(queue.flush());
+
+    for (int i = 0; i < 300; ++i)
+    {
+        ASSERT_TRUE(products[i].wait(std::chrono::milliseconds{5000}));
+        EXPECT_EQ(products[i].get().value(), 2 * i);
+    }
+    ASSERT_TRUE(offset.wait(std::chrono::milliseconds{5000}));
+    EXPECT_EQ(offset.get().value(), kText + 2);
+    EXPECT_TRUE(discarded.wait(std::chrono::milliseconds{5000}));
+    EXPECT_EQ(queue.pending() + queue.inFlight(), 0u);
+
+    stop = true;
+    thread.join();
+}
+
+TEST_F(RemoteCallQueueTest, AttachTest)
+{
+    uint8_t garbage[256] = {};
+    RemoteCallQueue<CountingAccessor> queue{accessor, reinterpret_cast<uintptr_t>(garbage)};
+    EXPECT_FALSE(queue.attach());
+    EXPECT_FALSE(queue.isAttached());
+    EXPECT_FALSE(queue.call<int>(reinterpret_cast<uintptr_t>(&remoteMultiply), 1, 2).wait());
+}
+
+// ============================================================================================== //
+// [SharedSnapshotAccessor] testing                                                               //
+// ============================================================================================== //
+
+#ifdef REMODEL_HAS_SHARED_MEMORY
+
+class SharedSnapshotTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        int32_t y;
+        uint8_t pad[100];
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int32_t> x{this, offsetof(A, x)};
+        Field<int32_t> y{this, offsetof(A, y)};
+    };
+
+    static std::string segmentName(const char* suffix)
+    {
+        return "remodel-test-" + std::to_string(static_cast<unsigned long long>(
+            platform::currentProcess())) + "-" + suffix;
+    }
+};
+
+TEST_F(SharedSnapshotTest, PublishTest)
+{
+    A objs[3] = {{1, 2, {}}, {3, 4, {}}, {5, 6, {}}};
+    auto name = segmentName("publish");
+
+    SnapshotPublisher publisher;
+    publisher.add(wrapper_cast<WrapA>(&objs[2]));
+    publisher.add(&objs[0], sizeof(A));
+    ASSERT_TRUE(publisher.create(name.c_str()));
+    SnapshotPublisher duplicate;
+    EXPECT_FALSE(duplicate.create(name.c_str()));
+
+    SharedSnapshotAccessor snapshots;
+    EXPECT_FALSE(snapshots.open("remodel-test-missing"));
+    ASSERT_TRUE(snapshots.open(name.c_str()));
+    EXPECT_EQ(snapshots.size(), 2u);
+
+    RemoteInstance<WrapA, SharedSnapshotAccessor> first{snapshots, &objs[0]};
+    RemoteInstance<WrapA, SharedSnapshotAccessor> third{snapshots, &objs[2]};
+    ASSERT_TRUE(first.refresh());
+    EXPECT_EQ(first->x, 1);
+    EXPECT_EQ(third->y, 6);
+
+    // Changes become visible when published.
+    objs[0].x = 10;
+    ASSERT_TRUE(first.refresh());
+    EXPECT_EQ(first->x, 1);
+    publisher.publish();
+    ASSERT_TRUE(first.refresh());
+    EXPECT_EQ(first->x, 10);
+
+    // Unpublished objects and partially covered ranges fail, writes are rejected.
+    RemoteInstance<WrapA, SharedSnapshotAccessor> second{snapshots, &objs[1]};
+    EXPECT_FALSE(second.refresh());
+    int32_t value;
+    auto last = reinterpret_cast<uintptr_t>(&objs[2]) + sizeof(A) - 2;
+    EXPECT_FALSE(snapshots.read(MemoryRange{last, &value, sizeof(value)}));
+    EXPECT_TRUE(snapshots.read(MemoryRange{last - 2, &value, sizeof(value)}));
+    first->x = 20;
+    EXPECT_FALSE(first.commit());
+    EXPECT_EQ(objs[0].x, 10);
+
+    SnapshotPublisher overlapping;
+    overlapping.add(&objs[0], sizeof(A) + 1);
+    overlapping.add(&objs[1], sizeof(A));
+    EXPECT_FALSE(overlapping.create(segmentName("overlapping").c_str()));
+}
+
+TEST_F(SharedSnapshotTest, ConsistencyTest)
+{
+    A obj{0, 0, {}};
+    auto name = segmentName("consistency");
+    SnapshotPublisher publisher;
+    publisher.add(&obj, sizeof(obj));
+    ASSERT_TRUE(publisher.create(name.c_str()));
+
+    std::atomic<bool> stop{false};
+    std::thread writer{[&]
+    {
+        for (int32_t i = 1; !stop; ++i)
+        {
+            obj.x = i;
+            std::memset(obj.pad, static_cast<uint8_t>(i), sizeof(obj.pad));
+            obj.y = i;
+            publisher.publish();
+        }
+    }};
+
+    SharedSnapshotAccessor snapshots;
+    ASSERT_TRUE(snapshots.open(name.c_str()));
+    RemoteInstance<WrapA, SharedSnapshotAccessor> remote{snapshots, &obj};
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_TRUE(remote.refresh());
+        ASSERT_EQ(remote->x + 0, remote->y + 0);
+    }
+    stop = true;
+    writer.join();
+}
+
+#ifdef REMODEL_HAS_TCP_SOCKETS
+
+TEST_F(SharedSnapshotTest, StreamTest)
+{
+    A objs[2] = {{1, 2, {}}, {3, 4, {}}};
+    SnapshotServer server{64, 1 << 20, std::chrono::milliseconds{1}};
+    server.add(wrapper_cast<WrapA>(&objs[1]));
+    server.add(&objs[0], sizeof(A));
+    EXPECT_FALSE(server.publish(0));
+    ASSERT_TRUE(server.listen(0));
+    ASSERT_NE(server.port(), 0u);
+
+    SnapshotSubscriber snapshots;
+    ASSERT_TRUE(snapshots.connect("127.0.0.1", server.port()));
+    RemoteInstance<WrapA, SnapshotSubscriber> first{snapshots, &objs[0]};
+    RemoteInstance<WrapA, SnapshotSubscriber> second{snapshots, &objs[1]};
+    EXPECT_FALSE(first.refresh());
+
+    auto waitForTick = [&](SnapshotSubscriber& subscriber, uint64_t tick)
+    {
+        for (int i = 0; i < 500 && (!subscriber.isSynced() || subscriber.tick() != tick); ++i)
+        {
+            if (!subscriber.poll(10)) return false;
+        }
+        return subscriber.isSynced() && subscriber.tick() == tick;
+    };
+
+    // The first frame arrives as a keyframe, later ones as deltas.
+    ASSERT_TRUE(server.publish(1));
+    ASSERT_TRUE(waitForTick(snapshots, 1));
+    EXPECT_EQ(snapshots.size(), 2u);
+    ASSERT_TRUE(first.refresh());
+    ASSERT_TRUE(second.refresh());
+    EXPECT_EQ(first->x, 1);
+    EXPECT_EQ(second->y, 4);
+
+    for (int32_t tick = 2; tick <= 50; ++tick)
+    {
+        objs[0].x = tick;
+        objs[1].pad[tick] = static_cast<uint8_t>(tick);
+        ASSERT_TRUE(server.publish(tick));
+    }
+    ASSERT_TRUE(waitForTick(snapshots, 50));
+    ASSERT_TRUE(first.refresh());
+    EXPECT_EQ(first->x, 50);
+    uint8_t pad[sizeof(objs[1].pad)];
+    ASSERT_TRUE(snapshots.read(MemoryRange{reinterpret_cast<uintptr_t>(objs[1].pad), pad, 
+        sizeof(pad)}));
+    EXPECT_EQ(0, std::memcmp(pad, objs[1].pad, sizeof(pad)));
+
+    // Late subscribers start with the current state, reads outside of objects fail.
+    SnapshotSubscriber late;
+    ASSERT_TRUE(late.connect("127.0.0.1", server.port()));
+    objs[1].y = 40;
+    ASSERT_TRUE(server.publish(51));
+    ASSERT_TRUE(waitForTick(late, 51));
+    RemoteInstance<WrapA, SnapshotSubscriber> lateSecond{late, &objs[1]};
+    ASSERT_TRUE(lateSecond.refresh());
+    EXPECT_EQ(lateSecond->y, 40);
+    int32_t value;
+    EXPECT_FALSE(late.read(MemoryRange{reinterpret_cast<uintptr_t>(&objs[1]) + sizeof(A) - 2, 
+        &value, sizeof(value)}));
+    EXPECT_FALSE(late.write(MemoryRange{reinterpret_cast<uintptr_t>(&objs[1]), &value, 
+        sizeof(value)}));
+    EXPECT_EQ(server.subscribers(), 2u);
+
+    server.stop();
+    EXPECT_FALSE(server.publish(52));
+    for (int i = 0; i < 100 && snapshots.poll(10); ++i) {}
+    EXPECT_FALSE(snapshots.poll());
+}
+
+#endif // ifdef REMODEL_HAS_TCP_SOCKETS
+
+#endif // ifdef REMODEL_HAS_SHARED_MEMORY
+
+// ============================================================================================== //
+// [PtrChainGetter] testing                                                                       //
+// ============================================================================================== //
+
+class PtrChainGetterTest : public testing::Test
+{
+protected:
+    struct Stats
+    {
+        int   pad;
+        float health;
+    };
+
+    struct Component
+    {
+        void*  pad;
+        Stats* stats;
+    };
+
+    struct Entity
+    {
+        uint32_t   id;
+        Component* component;
+    };
+
+    static int tick(int x) { return x + 10; }
+
+    struct Globals
+    {
+        int (*tick)(int);
+    };
+
+    using HealthChain = StaticPtrChainGetter<offsetof(Entity, component), 
+        offsetof(Component, stats), offsetof(Stats, health)>;
+
+    class WrapEntity : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapEntity)
+    public:
+        Field<float, HealthChain> health{this, HealthChain{}};
+        Field<float, PtrChainGetter> cachedHealth{this, PtrChainGetter{{
+            offsetof(Entity, component), offsetof(Component, stats), offsetof(Stats, health)
+            }, ChainCachePolicy::PerObject}};
+        Field<Component*> component{this, offsetof(Entity, component)};
+    };
+protected:
+    PtrChainGetterTest()
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            stats[i]      = Stats{0, 100.f + i};
+            components[i] = Component{nullptr, &stats[i]};
+            entities[i]   = Entity{static_cast<uint32_t>(i), &components[i]};
+        }
+    }
+protected:
+    Stats     stats[4];
+    Component components[4];
+    Entity    entities[4];
+};
+
+TEST_F(PtrChainGetterTest, FieldTest)
+{
+    auto entity = wrapper_cast<WrapEntity>(&entities[1]);
+    EXPECT_FLOAT_EQ(101.f, entity.health);
+    EXPECT_FLOAT_EQ(101.f, entity.cachedHealth);
+    entity.health = 50.f;
+    EXPECT_FLOAT_EQ(50.f, stats[1].health);
+
+    // The cached getter keeps using the old component until invalidated.
+    components[1].stats = &stats[2];
+    EXPECT_FLOAT_EQ(102.f, entity.health);
+    EXPECT_FLOAT_EQ(50.f,  entity.cachedHealth);
+
+    std::atomic<uint64_t> generation{0};
+    PtrChainGetter getter{{offsetof(Entity, component), offsetof(Component, stats)}, 
+        ChainCachePolicy::Generation, &generation};
+    EXPECT_EQ(&components[1].stats, getter(&entities[1]));
+    entities[1].component = &components[3];
+    EXPECT_EQ(&components[1].stats, getter(&entities[1]));
+    ++generation;
+    EXPECT_EQ(&components[3].stats, getter(&entities[1]));
+
+    entities[0].component = nullptr;
+    EXPECT_EQ(nullptr, (StaticPtrChainGetter<offsetof(Entity, component), 0>{}(&entities[0])));
+    EXPECT_FALSE((PtrChainGetter{{0, 0, 0, 0, 0, 0, 0, 0, 0}}.isValid()));
+}
+
+TEST_F(PtrChainGetterTest, FunctionTest)
+{
+    Globals globals{&tick};
+    Globals* globalsPtr = &globals;
+    Function<int(*)(int), PtrChainGetter> func{PtrChainGetter{&globalsPtr, 
+        {0, offsetof(Globals, tick), 0}, ChainCachePolicy::PerObject}};
+    EXPECT_EQ(15, func(5));
+}
+
+TEST_F(PtrChainGetterTest, BatchTest)
+{
+    entities[2].component = nullptr;
+    void* raws[5] = {&entities[0], &entities[1], &entities[2], &entities[3], nullptr};
+    void* out[5];
+    resolvePtrChains(HealthChain{}, raws, out, 5);
+
+    EXPECT_EQ(&stats[0].health, out[0]);
+    EXPECT_EQ(&stats[1].health, out[1]);
+    EXPECT_EQ(nullptr,          out[2]);
+    EXPECT_EQ(&stats[3].health, out[3]);
+    EXPECT_EQ(nullptr,          out[4]);
+
+    resolvePtrChains(PtrChainGetter{{offsetof(Entity, component)}}, raws, raws, 5);
+    EXPECT_EQ(reinterpret_cast<uint8_t*>(&entities[1]) + offsetof(Entity, component), raws[1]);
+}
+
+TEST_F(PtrChainGetterTest, RebindTest)
+{
+    // Per-object caches are keyed on the object, so rebinding wrappers keeps them coherent.
+    auto entity = wrapper_cast<WrapEntity>(&entities[0]);
+    for (int i = 0; i < 4; ++i)
+    {
+        entity.rebind(&entities[i]);
+        EXPECT_FLOAT_EQ(100.f + i, entity.health);
+        EXPECT_FLOAT_EQ(100.f + i, entity.cachedHealth);
+    }
+    entity.rebind(&entities[1]);
+    entity.cachedHealth = 1.f;
+    EXPECT_FLOAT_EQ(1.f, stats[1].health);
+}
+
+TEST_F(PtrChainGetterTest, PrefetchTest)
+{
+    // Walking the graph by hand, requesting the next hop ahead. Null pointers are fine.
+    auto entity = wrapper_cast<WrapEntity>(&entities[0]);
+    entities[3].component = nullptr;
+    float sum = 0.f;
+    for (int i = 0; i < 4; ++i)
+    {
+        entity.rebind(&entities[i]);
+        entity.component.prefetchPointee();
+        if (entity.component) sum += entity.health;
+    }
+    EXPECT_FLOAT_EQ(100.f + 101.f + 102.f, sum);
+}
+
+// ============================================================================================== //
+// [InlineGetter] testing                                                                         //
+// ============================================================================================== //
+
+static_assert(sizeof(internal::DefaultPtrGetter) == 3 * sizeof(void*), 
+    "default getters should be a buffer of two pointers and a call target");
+static_assert(internal::InlineGetter::FitsInline<OffsGetter>::value, "expected inline");
+static_assert(internal::InlineGetter::FitsInline<AbsGetter>::value, "expected inline");
+static_assert(internal::InlineGetter::FitsInline<VfTableGetter>::value, "expected inline");
+static_assert(!internal::InlineGetter::FitsInline<PtrChainGetter>::value, "expected heap");
+
+TEST(InlineGetterTest, StorageTest)
+{
+    uint8_t obj[64]{};
+
+    internal::InlineGetter offs{OffsGetter{0x10}};
+    EXPECT_TRUE(offs.storedInline());
+    EXPECT_EQ(obj + 0x10, offs(obj));
+
+    uintptr_t a = 0x20, b = 0x08;
+    internal::InlineGetter lambda{[a, b](void* raw) { return static_cast<uint8_t*>(raw) + a + b; }};
+    EXPECT_TRUE(lambda.storedInline());
+    EXPECT_EQ(obj + 0x28, lambda(obj));
+
+    // Captures exceeding the inline buffer are moved to the heap.
+    std::array<uintptr_t, 4> offsets{{1, 2, 3, 4}};
+    internal::InlineGetter big{[offsets](void* raw) { 
+        return static_cast<uint8_t*>(raw) + offsets[0] + offsets[1] + offsets[2] + offsets[3]; 
+    }};
+    EXPECT_FALSE(big.storedInline());
+    EXPECT_EQ(obj + 10, big(obj));
+
+    auto copy = big;
+    internal::InlineGetter moved{std::move(big)};
+    EXPECT_EQ(obj + 10, copy(obj));
+    EXPECT_EQ(obj + 10, moved(obj));
+    EXPECT_EQ(nullptr,  big(obj));
+
+    copy = offs;
+    EXPECT_TRUE(copy.storedInline());
+    EXPECT_EQ(obj + 0x10, copy(obj));
+    offs = moved;
+    EXPECT_FALSE(offs.storedInline());
+    EXPECT_EQ(obj + 10, offs(obj));
+
+    EXPECT_EQ(nullptr, internal::InlineGetter{}(obj));
+}
+
+// ============================================================================================== //
+// [SharedGetter] testing                                                                         //
+// ============================================================================================== //
+
+int sharedGetterEvalCount = 0;
+
+class SharedGetterTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        float   y;
+    };
+
+    static OffsGetter countedOffsGetter(std::ptrdiff_t offs)
+    {
+        ++sharedGetterEvalCount;
+        return OffsGetter{offs};
+    }
+
+    class WrapA : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+    public:
+        SharedField<int32_t> x{this, REMODEL_SHARED_GETTER(countedOffsGetter(offsetof(A, x)))};
+        SharedField<float>   y{this, REMODEL_SHARED_GETTER(countedOffsGetter(offsetof(A, y)))};
+    };
+protected:
+    SharedGetterTest()
+    {
+        a.x = 1000;
+        a.y = 567.89f;
+    }
+protected:
+    A a;
+};
+
+TEST_F(SharedGetterTest, SharedGetterTest)
+{
+    auto wrapA1 = wrapper_cast<WrapA>(&a);
+    auto wrapA2 = wrapper_cast<WrapA>(&a);
+    EXPECT_EQ(2, sharedGetterEvalCount);
+
+    EXPECT_EQ(1000 + 100, wrapA1.x + 100);
+    ++wrapA2.x;
+    EXPECT_EQ(1001,       a.x           );
+    wrapA1.y = 1.f;
+    EXPECT_FLOAT_EQ(1.f,  wrapA2.y      );
+}
+
+// ============================================================================================== //
+// [GetterTable] testing                                                                          //
+// ============================================================================================== //
+
+class GetterTableTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int32_t x;
+        float   y;
+    };
+
+    static int rawAdd(int a, int b) { return a + b; }
+
+    class WrapA : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+        REMODEL_GETTER_TABLE(getters, 
+            OffsGetter{offsetof(A, x)}, 
+            OffsGetter{offsetof(A, y)},
+            AbsGetter{reinterpret_cast<uintptr_t>(&rawAdd)}
+        )
+    public:
+        SharedField<int32_t>                     x  {this, getters()[0]};
+        SharedField<float>                       y  {this, getters()[1]};
+        Function<int(*)(int, int), SharedGetter> add{getters()[2]};
+    };
+protected:
+    GetterTableTest()
+        : wrapA{wrapper_cast<WrapA>(&a)}
+    {
+        a.x = 1000;
+        a.y = 567.89f;
+    }
+protected:
+    A     a;
+    WrapA wrapA;
+};
+
+TEST_F(GetterTableTest, GetterTableTest)
+{
+    EXPECT_EQ(1000 + 100,    wrapA.x + 100);
+    ++wrapA.x;
+    EXPECT_EQ(1001,          a.x          );
+    EXPECT_FLOAT_EQ(567.89f, wrapA.y      );
+    EXPECT_EQ(rawAdd(12, 34), wrapA.add(12, 34));
+
+    auto otherWrapA = wrapper_cast<WrapA>(&a);
+    otherWrapA.y = 1.f;
+    EXPECT_FLOAT_EQ(1.f,     wrapA.y      );
+}
+
+// ============================================================================================== //
+// [Global] testing                                                                               //
+// ============================================================================================== //
+
+class GlobalTest : public testing::Test {};
+
+TEST_F(GlobalTest, GlobalTest)
+{
+    auto global    = Global::instance();
+    int myStackVar = 854693;
+    Field<int> myStackVarField{global, reinterpret_cast<ptrdiff_t>(&myStackVar)};
+
+    EXPECT_EQ(myStackVar, myStackVarField);
+
+    ++myStackVarField;
+    EXPECT_EQ(myStackVarField, 854693 + 1);
+    EXPECT_EQ(myStackVar,      854693 + 1);
+}
+
+// ============================================================================================== //
+// [Module] testing                                                                               //
+// ============================================================================================== //
+
+class ModuleTest : public testing::Test {};
+
+TEST_F(ModuleTest, ModuleTest)
+{
+    static int myStaticVar = 854693;
+    auto mainModulePtr = platform::obtainModuleHandle(nullptr);
+    auto mainModule = Module::getModule(nullptr);
+
+    EXPECT_TRUE(mainModule);
+    EXPECT_TRUE(mainModulePtr != nullptr);
+
+    Field<int> myStaticVarField{
+        addressOfWrapper(mainModule.value()), 
+        static_cast<ptrdiff_t>(reinterpret_cast<uintptr_t>(&myStaticVar)
+            - reinterpret_cast<uintptr_t>(mainModulePtr))
+    };
+
+    ++myStaticVarField;
+    EXPECT_EQ(myStaticVarField, 854693 + 1);
+    EXPECT_EQ(myStaticVar,      854693 + 1);
+}
+
+TEST_F(ModuleTest, CachedLookupTest)
+{
+    EXPECT_EQ(platform::obtainModuleHandleCached(nullptr), platform::obtainModuleHandle(nullptr));
+    EXPECT_EQ(platform::obtainModuleHandleCached(nullptr), platform::obtainModuleHandle(nullptr));
+
+#   if defined(__linux__)
+        // Loading and unloading a library must invalidate cached results, including misses.
+        const char* kLibrary = "libresolv.so.2";
+        if (platform::obtainModuleHandle(kLibrary)) return;
+        EXPECT_EQ(platform::obtainModuleHandleCached(kLibrary), nullptr);
+
+        auto handle = dlopen(kLibrary, RTLD_NOW);
+        if (!handle) return;
+        auto loaded = platform::obtainModuleHandleCached(kLibrary);
+        EXPECT_NE(loaded, nullptr);
+        EXPECT_EQ(loaded, platform::obtainModuleHandle(kLibrary));
+        EXPECT_EQ(platform::obtainModuleHandleCached(kLibrary), loaded);
+        
+        dlclose(handle);
+        EXPECT_EQ(platform::obtainModuleHandleCached(kLibrary), 
+            platform::obtainModuleHandle(kLibrary));
+#   endif
+}
+
+TEST_F(ModuleTest, ExportAddressTest)
+{
+#   if defined(__linux__)
+        auto libc = Module::getModule("libc.so.6");
+        ASSERT_TRUE(libc);
+
+        auto index = platform::obtainExportIndex(libc.value().addressOfObj());
+        EXPECT_GT(index->size(), 1000u);
+        EXPECT_EQ(index, platform::obtainExportIndex(libc.value().addressOfObj()));
+
+        // Includes plain functions, default versions of versioned symbols and IFUNCs.
+        auto handle = dlopen("libc.so.6", RTLD_NOW | RTLD_NOLOAD);
+        ASSERT_TRUE(handle != nullptr);
+        for (auto name : {"abs", "fopen", "memcpy", "strlen", "environ"})
+        {
+            auto address = libc.value().exportAddress(name);
+            ASSERT_TRUE(address) << name;
+            EXPECT_EQ(address.value(), reinterpret_cast<uintptr_t>(dlsym(handle, name))) << name;
+        }
+        dlclose(handle);
+
+        Function<int(*)(int)> wrappedAbs{libc.value().exportAddress("abs").value()};
+        EXPECT_EQ(wrappedAbs(-5), 5);
+        EXPECT_FALSE(libc.value().exportAddress("remodel_no_such_symbol"));
+#   endif
+}
+
+static int moduleRelTestAdd(int a, int b) { return a + b; }
+static int moduleRelTestVar = 4711;
+
+TEST_F(ModuleTest, ModuleRelGetterTest)
+{
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    const auto& module = mainModule.value();
+    auto base  = reinterpret_cast<uintptr_t>(module.addressOfObj());
+    auto rvaOf = [&](const void* ptr) { return reinterpret_cast<uintptr_t>(ptr) - base; };
+
+    auto addPtr = &moduleRelTestAdd;
+    Function<int(*)(int, int)> add{module, rvaOf(*reinterpret_cast<void**>(&addPtr))};
+    EXPECT_EQ(add(3, 4), 7);
+
+    Field<int, ModuleRelGetter> var{Global::instance(), {module, rvaOf(&moduleRelTestVar)}};
+    EXPECT_EQ(var, 4711);
+    ++var;
+    EXPECT_EQ(moduleRelTestVar, 4712);
+}
+
+TEST_F(ModuleTest, FindPatternTest)
+{
+    static const uint8_t kSignature[] = {
+        0x5A, 0xC3, 0x17, 0x9E, 0x42, 0x00, 0x00, 0xE1, 0x7B, 0x3D, 0xA6, 0x88
+    };
+    
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+
+    auto addr = mainModule.value().findPattern("5A C3 17 9E ?? ?? ?? E1 7B 3D A6 88");
+    ASSERT_TRUE(addr);
+    EXPECT_EQ(addr.value(), reinterpret_cast<uintptr_t>(kSignature));
+    EXPECT_FALSE(mainModule.value().findPattern("5A C3 17 9E ?? ?? ?? E1 7B 3D A6 88 ZZ"));
+}
+
+TEST_F(ModuleTest, FindPatternsTest)
+{
+    static struct 
+    {
+        uint8_t signature[8];
+        int     value;
+    } marked = {{0x3F, 0xB1, 0x6E, 0xD4, 0x29, 0x8C, 0x57, 0xA0}, 1337};
+
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+
+    PatternBatch batch;
+    auto markedIdx = batch.add("3F B1 6E D4 29 8C 57 A0");
+    EXPECT_TRUE(mainModule.value().findPatterns(batch));
+    ASSERT_TRUE(batch.isResolved(markedIdx));
+
+    Field<int, AbsGetter> value{
+        Global::instance(), AbsGetter{batch.address(markedIdx) + offsetof(decltype(marked), value)}
+    };
+    EXPECT_EQ(value, 1337);
+    value = 42;
+    EXPECT_EQ(marked.value, 42);
+}
+
+TEST_F(ModuleTest, SectionsTest)
+{
+    static const uint8_t kReadOnly[] = {0x71, 0x0E, 0xB4, 0x2D, 0x93, 0x5C, 0xE6, 0x08};
+    static uint8_t writable[] = {0x71, 0x0E, 0xB4, 0x2D, 0x93, 0x5C, 0xE6, 0x08};
+    static int zeroInitialized;
+
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    const auto& module = mainModule.value();
+    auto base = reinterpret_cast<uintptr_t>(module.addressOfObj());
+
+    auto sections = module.sections();
+    ASSERT_FALSE(sections.empty());
+    auto size = module.imageSize();
+    for (const auto& section : sections)
+    {
+        EXPECT_GE(reinterpret_cast<uintptr_t>(section.begin), base);
+        EXPECT_LE(reinterpret_cast<uintptr_t>(section.begin) + section.size, base + size);
+    }
+
+    auto kindOf = [&](const void* ptr)
+    {
+        auto section = module.sectionOf(ptr);
+        EXPECT_TRUE(section);
+        return section ? section.value().kind : platform::SectionKind::Code;
+    };
+    EXPECT_EQ(kindOf(reinterpret_cast<const void*>(&platform::obtainModuleSize)), 
+        platform::SectionKind::Code);
+    EXPECT_EQ(kindOf(kReadOnly),        platform::SectionKind::ReadOnlyData);
+    EXPECT_EQ(kindOf(writable),         platform::SectionKind::Data);
+    EXPECT_EQ(kindOf(&zeroInitialized), platform::SectionKind::Data);
+    EXPECT_FALSE(module.sectionOf(&base));
+
+    // Restricted scans only find the copy in the respective section.
+    Pattern pattern{"71 0E B4 2D 93 5C E6 08"};
+    auto inReadOnly = module.findPattern(pattern, platform::SectionKind::ReadOnlyData);
+    ASSERT_TRUE(inReadOnly);
+    EXPECT_EQ(inReadOnly.value(), reinterpret_cast<uintptr_t>(kReadOnly));
+
+    PatternBatch batch;
+    batch.add(pattern);
+    EXPECT_TRUE(module.findPatterns(batch, platform::SectionKind::Data));
+    EXPECT_EQ(batch.address(0), reinterpret_cast<uintptr_t>(writable));
+}
+
+TEST_F(ModuleTest, SignatureCacheTest)
+{
+    static const uint8_t kSignature[] = {0x6B, 0xE2, 0x91, 0x0D, 0x5F, 0xA3, 0x38, 0xC7};
+    const char* kPath = "remodel_test.sigcache";
+    std::remove(kPath);
+
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    platform::ModuleIdentity identity;
+    if (!platform::obtainModuleIdentity(mainModule.value().addressOfObj(), identity))
+    {
+        return; // Built without identity (e.g. no build-id), caching is unavailable.
+    }
+
+    auto makeBatch = [](const char* extra)
+    {
+        PatternBatch batch;
+        batch.add("6B E2 91 0D ?? A3 38 C7");
+        batch.add(extra);
+        return batch;
+    };
+
+    // Miss: scans and writes the cache.
+    auto batch = makeBatch("DE AD BE EF 13 37");
+    EXPECT_FALSE(loadSignatureCache(kPath, mainModule.value(), batch));
+    EXPECT_FALSE(resolvePatternsCached(mainModule.value(), batch, kPath));
+    EXPECT_EQ(batch.address(0), reinterpret_cast<uintptr_t>(kSignature));
+    EXPECT_FALSE(batch.isResolved(1));
+
+    // Hit: populated from the file, unresolved patterns stay unresolved.
+    auto cached = makeBatch("DE AD BE EF 13 37");
+    EXPECT_TRUE(loadSignatureCache(kPath, mainModule.value(), cached));
+    EXPECT_EQ(cached.address(0), reinterpret_cast<uintptr_t>(kSignature));
+    EXPECT_FALSE(cached.isResolved(1));
+
+    // Changed patterns miss.
+    auto changed = makeBatch("DE AD BE EF 13 38");
+    EXPECT_FALSE(loadSignatureCache(kPath, mainModule.value(), changed));
+    EXPECT_FALSE(changed.isResolved(0));
+
+    // Truncated files miss.
+    auto file = std::fopen(kPath, "rb");
+    ASSERT_TRUE(file != nullptr);
+    std::vector<char> contents(1024);
+    contents.resize(std::fread(contents.data(), 1, contents.size(), file));
+    std::fclose(file);
+    file = std::fopen(kPath, "wb");
+    std::fwrite(contents.data(), 1, contents.size() - 1, file);
+    std::fclose(file);
+    EXPECT_FALSE(loadSignatureCache(kPath, mainModule.value(), cached));
+
+    std::remove(kPath);
+}
+
+// ============================================================================================== //
+// [LayoutProfile] testing                                                                        //
+// ============================================================================================== //
+
+int profiledTriple(int x)
+{
+    return 3 * x;
+}
+
+class LayoutProfileTest : public testing::Test
+{
+public:
+    enum : std::size_t { kIdA, kIdB, kIdTriple, kIdCount };
+
+    struct A
+    {
+        int32_t a;
+        int32_t b;
+    };
+
+    static LayoutTable& table()
+    {
+        static LayoutTable table{kIdCount};
+        return table;
+    }
+
+    class WrapA : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+    public:
+        ProfileField<int32_t> a{this, ProfileOffsGetter{table(), kIdA}};
+        ProfileField<int32_t> b{this, ProfileOffsGetter{table(), kIdB}};
+        Function<int (*)(int), ProfileRvaGetter> triple{ProfileRvaGetter{table(), kIdTriple}};
+    };
+
+    static const char* const kNames[kIdCount];
+};
+
+const char* const LayoutProfileTest::kNames[kIdCount] = {"A.a", "A.b", "triple"};
+
+TEST_F(LayoutProfileTest, ParseTest)
+{
+    const char kText[] =
+        "# profiles for testing\n"
+        "[v1]\n"
+        "identity = 00ff10Ab\n"
+        "A.a = 0\n"
+        "  A.b=0x4  \r\n"
+        "\n"
+        "[v2]\n"
+        "; b is missing\n"
+        "A.a = -8\n";
+
+    std::vector<LayoutProfile> profiles;
+    ASSERT_TRUE(parseLayoutProfiles(kText, sizeof(kText) - 1, kNames, kIdCount, profiles));
+    ASSERT_EQ(profiles.size(), 2u);
+
+    EXPECT_EQ(profiles[0].name(), "v1");
+    ASSERT_EQ(profiles[0].identity().size, 4u);
+    EXPECT_EQ(profiles[0].identity().bytes[1], 0xFF);
+    EXPECT_EQ(profiles[0].identity().bytes[3], 0xAB);
+    EXPECT_EQ(profiles[0].get(kIdB), 4);
+    EXPECT_EQ(profiles[0].get(kIdTriple), std::ptrdiff_t{LayoutProfile::kUnset});
+    EXPECT_EQ(profiles[1].get(kIdA), -8);
+    EXPECT_FALSE(profiles[1].isComplete());
+
+    for (const char* bad : {"A.a = 0\n", "[x]\nA.c = 1\n", "[x]\nidentity = 0g\n", 
+        "[x]\nA.a = 12z\n", "[x]\nA.a\n", "[]\n"})
+    {
+        EXPECT_FALSE(parseLayoutProfiles(bad, std::strlen(bad), kNames, kIdCount, profiles));
+    }
+    EXPECT_EQ(profiles.size(), 2u);
+
+    const char* kPath = "remodel_test.layouts";
+    auto file = std::fopen(kPath, "wb");
+    ASSERT_TRUE(file != nullptr);
+    std::fwrite(kText, 1, sizeof(kText) - 1, file);
+    std::fclose(file);
+    EXPECT_TRUE(loadLayoutProfiles(kPath, kNames, kIdCount, profiles));
+    EXPECT_EQ(profiles.size(), 4u);
+    std::remove(kPath);
+    EXPECT_FALSE(loadLayoutProfiles(kPath, kNames, kIdCount, profiles));
+}
+
+TEST_F(LayoutProfileTest, SelectTest)
+{
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    auto base = static_cast<uint8_t*>(mainModule.value().addressOfObj());
+    auto tripleRva = reinterpret_cast<uint8_t*>(&profiledTriple) - base;
+
+    LayoutProfile forward{"forward", kIdCount}, swapped{"swapped", kIdCount};
+    forward.set(kIdA, offsetof(A, a));
+    forward.set(kIdB, offsetof(A, b));
+    swapped.set(kIdA, offsetof(A, b));
+    swapped.set(kIdB, offsetof(A, a));
+    LayoutProfile incomplete = swapped;
+    forward.set(kIdTriple, tripleRva);
+    swapped.set(kIdTriple, tripleRva);
+
+    EXPECT_FALSE(table().activate(incomplete, base));
+    EXPECT_FALSE(table().isActive());
+    ASSERT_TRUE(table().activate(forward, base));
+    EXPECT_EQ(table().activeName(), "forward");
+
+    A a{10, 20};
+    auto wrapA = wrapper_cast<WrapA>(&a);
+    EXPECT_EQ(wrapA.a, 10);
+    EXPECT_EQ(wrapA.b, 20);
+    EXPECT_EQ(wrapA.triple(5), 15);
+
+    // Wrappers keep referring to the table, so later selections take effect immediately.
+    ASSERT_TRUE(table().activate(swapped, base));
+    wrapA.a = 30;
+    EXPECT_EQ(a.b, 30);
+
+    platform::ModuleIdentity identity;
+    if (platform::obtainModuleIdentity(base, identity))
+    {
+        std::vector<LayoutProfile> profiles{incomplete, swapped, forward};
+        profiles[0].setIdentity(identity);
+        profiles[2].setIdentity(identity);
+        EXPECT_FALSE(table().select(mainModule.value(), {profiles[1]}));
+        ASSERT_TRUE(table().select(mainModule.value(), profiles));
+        EXPECT_EQ(table().activeName(), "forward");
+        EXPECT_EQ(wrapA.a, 10);
+    }
+}
+
+TEST_F(LayoutProfileTest, HotSwapTest)
+{
+    LayoutProfile forward{"forward", kIdCount}, swapped{"swapped", kIdCount};
+    forward.set(kIdA, offsetof(A, a));
+    forward.set(kIdB, offsetof(A, b));
+    forward.set(kIdTriple, 0);
+    swapped.set(kIdA, offsetof(A, b));
+    swapped.set(kIdB, offsetof(A, a));
+    swapped.set(kIdTriple, 0);
+
+    LayoutTable table{kIdCount};
+    ASSERT_TRUE(table.activate(forward, nullptr));
+    EXPECT_EQ(table.reclaim(), 0u);
+
+    // Snapshots observed within an open read section survive the swap.
+    {
+        LayoutTable::Reader reader{table};
+        LayoutTable::ReadSection section{reader};
+        auto observed = table.snapshot();
+        ASSERT_TRUE(table.activate(swapped, nullptr));
+        EXPECT_EQ(table.reclaim(), 1u);
+        EXPECT_EQ(observed->name, "forward");
+        EXPECT_EQ(observed->values()[kIdB], std::ptrdiff_t{offsetof(A, b)});
+        EXPECT_EQ(table.activeName(), "swapped");
+
+        reader.quiesce();
+        EXPECT_EQ(table.reclaim(), 0u);
+    }
+
+    A a{10, 20};
+    ProfileOffsGetter getA{table, kIdA};
+    std::atomic<bool> done{false};
+    std::atomic<unsigned> torn{0};
+    std::thread readerThread{[&]
+    {
+        LayoutTable::Reader reader{table};
+        while (!done.load())
+        {
+            LayoutTable::ReadSection section{reader};
+            auto value = *static_cast<int32_t*>(getA(&a));
+            if (value != 10 && value != 20) ++torn;
+        }
+    }};
+    for (int i = 0; i < 1000; ++i) ASSERT_TRUE(table.activate(i & 1 ? forward : swapped, nullptr));
+    done = true;
+    readerThread.join();
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_EQ(table.reclaim(), 0u);
+    EXPECT_EQ(*static_cast<int32_t*>(getA(&a)), 10);
+}
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+TEST_F(LayoutProfileTest, ExtractOperandTest)
+{
+    const uint8_t kMovDisp8[] = {0x8B, 0x41, 0x7C};                         // mov eax, [rcx+0x7C]
+    const uint8_t kMovzx32[]  = {0x0F, 0xB6, 0x81, 0x20, 0x01, 0x00, 0x00}; // movzx, disp32 0x120
+    const uint8_t kAddImm8[]  = {0x48, 0x83, 0xC1, 0xF0};                   // add rcx, -0x10
+    const uint8_t kStoreImm[] = {0xC7, 0x41, 0x08, 0x2A, 0x00, 0x00, 0x00}; // mov [rcx+8], 42
+    const uint8_t kRipLoad[]  = {0x48, 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00}; // mov rax, [rip+0x10]
+    const uint8_t kCall[]     = {0xE8, 0xFB, 0xFF, 0xFF, 0xFF, 0x00, 0x00}; // call $
+    const uint8_t kRet[]      = {0xC3};
+
+    auto value = [](const uint8_t* insn, OperandKind kind, const void* base = nullptr) 
+    {
+        auto result = extractOperand(insn, kind, base);
+        return result ? result.value() : std::ptrdiff_t{-1};
+    };
+    EXPECT_EQ(value(kMovDisp8, OperandKind::Displacement), 0x7C);
+    EXPECT_EQ(value(kMovzx32, OperandKind::Displacement), 0x120);
+    EXPECT_EQ(value(kAddImm8, OperandKind::Immediate), -0x10);
+    EXPECT_EQ(value(kStoreImm, OperandKind::Displacement), 8);
+    EXPECT_EQ(value(kStoreImm, OperandKind::Immediate), 42);
+    EXPECT_EQ(value(kRipLoad, OperandKind::TargetRva, kRipLoad), 7 + 0x10);
+    EXPECT_EQ(value(kCall, OperandKind::TargetRva, kCall), 0);
+    EXPECT_FALSE(extractOperand(kMovDisp8, OperandKind::Immediate));
+    EXPECT_FALSE(extractOperand(kAddImm8, OperandKind::Displacement));
+    EXPECT_FALSE(extractOperand(kRet, OperandKind::TargetRva));
+}
+
+TEST_F(LayoutProfileTest, DeriveTest)
+{
+    // Marker bytes followed by the code accessing the values, as a signature would match it.
+    static const uint8_t kCode[] = {
+        0x6C, 0xE3, 0x91, 0x2F, 0xB8, 0x05,
+        0x8B, 0x41, 0x04,                               // mov eax, [rcx+4]
+        0x8B, 0x41, 0x00,                               // mov eax, [rcx+0]
+        0xE8, 0x00, 0x00, 0x00, 0x00,                   // call (next instruction)
+    };
+    const LayoutSignature kSignatures[] = {
+        {kIdB, "6C E3 91 2F B8 05 8B 41 ??", 6, OperandKind::Displacement},
+        {kIdA, "6C E3 91 2F B8 05 8B 41 04 8B 41", 9, OperandKind::Displacement},
+        {kIdTriple, "6C E3 91 2F B8 05 ?? ?? ?? ?? ?? ?? E8", 12, OperandKind::TargetRva},
+        {kIdTriple, "6C E3 91 2F B8 05 FF FF", 0, OperandKind::TargetRva},
+    };
+
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    auto base = static_cast<const uint8_t*>(mainModule.value().addressOfObj());
+
+    LayoutProfile profile{"derived", kIdCount};
+    EXPECT_EQ(deriveLayoutProfile(mainModule.value(), kSignatures, 4, profile), 3u);
+    EXPECT_EQ(profile.get(kIdA), 0);
+    EXPECT_EQ(profile.get(kIdB), 4);
+    EXPECT_EQ(profile.get(kIdTriple), kCode + sizeof(kCode) - base);
+    EXPECT_TRUE(profile.isComplete());
+}
+
+#endif // if defined(_M_X64) || defined(__x86_64__)
+
+// ============================================================================================== //
+// [Resolver] testing                                                                             //
+// ============================================================================================== //
+
+TEST(ResolverTest, DependencyTest)
+{
+    Resolver resolver;
+    auto a = resolver.add(ResolveStage::Custom, "a", {}, [](const Resolver&, uintptr_t& value) 
+    { 
+        value = 2; 
+        return true; 
+    });
+    auto b = resolver.add(ResolveStage::Custom, "b", {a}, [a](const Resolver& r, uintptr_t& value) 
+    { 
+        value = r.value(a) * 10; 
+        return true; 
+    });
+    auto broken = resolver.add(ResolveStage::Vftable, "broken", {a}, 
+        [](const Resolver&, uintptr_t&) { return false; });
+    int calls = 0;
+    auto after = resolver.add(ResolveStage::Derived, "after", {b, broken}, 
+        [&](const Resolver&, uintptr_t&) { return ++calls, true; });
+
+    EXPECT_FALSE(resolver.run(nullptr, 4));
+    EXPECT_EQ(resolver.value(a), 2u);
+    EXPECT_EQ(resolver.value(b), 20u);
+    EXPECT_TRUE(resolver.isResolved(b));
+    EXPECT_FALSE(resolver.isResolved(broken));
+    EXPECT_FALSE(resolver.isResolved(after));
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(resolver.failed(), std::vector<ResolveId>{broken});
+
+    const auto& report = resolver.report();
+    EXPECT_FALSE(report.cacheHit);
+    EXPECT_EQ(report[ResolveStage::Custom].total, 2u);
+    EXPECT_EQ(report[ResolveStage::Custom].resolved, 2u);
+    EXPECT_EQ(report[ResolveStage::Vftable].failed, 1u);
+    EXPECT_EQ(report[ResolveStage::Derived].skipped, 1u);
+    EXPECT_STREQ(resolveStageName(ResolveStage::Vftable), "vftable");
+}
+
+TEST(ResolverTest, ParallelTest)
+{
+    // Independent nodes waiting for each other only finish when run concurrently.
+    std::atomic<int> arrived{0};
+    auto rendezvous = [&](const Resolver&, uintptr_t& value)
+    {
+        ++arrived;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (arrived.load() < 2 && std::chrono::steady_clock::now() < deadline) 
+            std::this_thread::yield();
+        value = 1;
+        return arrived.load() == 2;
+    };
+
+    Resolver resolver;
+    auto left  = resolver.add(ResolveStage::Custom, "left", {}, rendezvous);
+    auto right = resolver.add(ResolveStage::Custom, "right", {}, rendezvous);
+    resolver.add(ResolveStage::Custom, "join", {left, right}, 
+        [=](const Resolver& r, uintptr_t& value) 
+        { 
+            value = r.value(left) + r.value(right); 
+            return true; 
+        });
+    EXPECT_TRUE(resolver.run(nullptr, 2));
+    EXPECT_EQ(resolver.value(2), 2u);
+}
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+TEST(ResolverTest, CacheTest)
+{
+    // Marker bytes followed by the code accessing a field, as a signature would match it.
+    static const uint8_t kCode[] = {
+        0x5A, 0xC4, 0x17, 0x9E, 0x63, 0xB2,
+        0x8B, 0x41, 0x7C,                               // mov eax, [rcx+0x7C]
+    };
+    const char* kPath = "remodel_test.resolve";
+    std::remove(kPath);
+
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    platform::ModuleIdentity identity;
+    if (!platform::obtainModuleIdentity(mainModule.value().addressOfObj(), identity))
+    {
+        return; // Built without identity (e.g. no build-id), caching is unavailable.
+    }
+
+    int hooked = 0;
+    ResolveId code, missing, offset, hook;
+    auto declare = [&](Resolver& resolver, const char* pattern)
+    {
+        auto main = resolver.module(nullptr);
+        code    = resolver.pattern(main, pattern);
+        missing = resolver.pattern(main, "DE AD BE EF 13 37");
+        offset  = resolver.operand(code, 6, OperandKind::Displacement);
+        hook    = resolver.hook(code, [&](uintptr_t target) 
+        { 
+            return ++hooked, target == reinterpret_cast<uintptr_t>(kCode); 
+        });
+    };
+
+    // Miss: scans and writes the cache.
+    Resolver cold;
+    declare(cold, "5A C4 17 9E ?? B2 8B 41");
+    EXPECT_FALSE(cold.run(kPath));
+    EXPECT_FALSE(cold.report().cacheHit);
+    EXPECT_EQ(cold.value(code), reinterpret_cast<uintptr_t>(kCode));
+    EXPECT_EQ(cold.value(offset), 0x7Cu);
+    EXPECT_TRUE(cold.isResolved(hook));
+    EXPECT_FALSE(cold.isResolved(missing));
+    EXPECT_EQ(cold.report()[ResolveStage::Signature].cached, 0u);
+    EXPECT_EQ(hooked, 1);
+
+    uint8_t object[0x80];
+    EXPECT_EQ(ResolvedOffsGetter(cold, offset)(object), object + 0x7C);
+    EXPECT_EQ(ResolvedAddrGetter(cold, code)(nullptr), kCode);
+
+    // Hit: values and failures are taken from the file, the scan is skipped, hooks still run.
+    Resolver warm;
+    declare(warm, "5A C4 17 9E ?? B2 8B 41");
+    EXPECT_FALSE(warm.run(kPath));
+    const auto& report = warm.report();
+    EXPECT_TRUE(report.cacheHit);
+    EXPECT_EQ(report[ResolveStage::Signature].cached, 2u);
+    EXPECT_EQ(report[ResolveStage::Signature].busy.count(), 0);
+    EXPECT_EQ(report[ResolveStage::Derived].cached, 1u);
+    EXPECT_EQ(report[ResolveStage::Hook].cached, 0u);
+    EXPECT_EQ(warm.value(code), reinterpret_cast<uintptr_t>(kCode));
+    EXPECT_EQ(warm.value(offset), 0x7Cu);
+    EXPECT_EQ(warm.failed(), std::vector<ResolveId>{missing});
+    EXPECT_EQ(hooked, 2);
+
+    // Changed declarations miss.
+    Resolver changed;
+    declare(changed, "5A C4 17 9E 63 B2 8B 41");
+    EXPECT_FALSE(changed.run(kPath));
+    EXPECT_FALSE(changed.report().cacheHit);
+    EXPECT_EQ(changed.value(code), reinterpret_cast<uintptr_t>(kCode));
+
+    std::remove(kPath);
+}
+
+#endif // if defined(_M_X64) || defined(__x86_64__)
+
+// ============================================================================================== //
+// [XrefIndex] testing                                                                            //
+// ============================================================================================== //
+
+#if defined(ZYCORE_GNUC) && defined(__x86_64__)
+
+static volatile int xrefTestGlobal = 5;
+
+__attribute__((noinline)) static int xrefTestLoad()
+{
+    return xrefTestGlobal * 3;
+}
+
+__attribute__((noinline)) static int xrefTestCall()
+{
+    return xrefTestLoad() + 1;
+}
+
+TEST(XrefIndexTest, QueryTest)
+{
+    EXPECT_EQ(xrefTestCall(), 16);
+
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    XrefIndex xrefs;
+    ASSERT_GT(xrefs.build(mainModule.value()), 0u);
+    EXPECT_EQ(xrefs.moduleBase(), reinterpret_cast<uintptr_t>(mainModule.value().addressOfObj()));
+    for (std::size_t i = 1; i < xrefs.size(); ++i)
+        ASSERT_LE(xrefs.xrefs()[i - 1].referrer, xrefs.xrefs()[i].referrer);
+
+    auto load = reinterpret_cast<const uint8_t*>(&xrefTestLoad);
+    auto call = reinterpret_cast<const uint8_t*>(&xrefTestCall);
+    auto global = const_cast<const int*>(&xrefTestGlobal);
+
+    // Who references the global: the load function, among others maybe.
+    bool fromLoad = false;
+    auto referrers = xrefs.forEachReferrer(global, [&](const Xref& xref)
+    {
+        EXPECT_EQ(xrefs.address(xref.target), reinterpret_cast<uintptr_t>(global));
+        EXPECT_EQ(xref.kind, XrefKind::Data);
+        auto referrer = xrefs.address(xref.referrer);
+        fromLoad |= referrer >= reinterpret_cast<uintptr_t>(load) 
+            && referrer < reinterpret_cast<uintptr_t>(load) + 64;
+    });
+    EXPECT_GE(referrers, 1u);
+    EXPECT_TRUE(fromLoad);
+    EXPECT_NE(xrefs.firstReferrer(global), 0u);
+
+    // What the functions reference.
+    bool loadsGlobal = false;
+    xrefs.forEachReference(load, 32, [&](const Xref& xref)
+    {
+        loadsGlobal |= xref.kind == XrefKind::Data 
+            && xrefs.address(xref.target) == reinterpret_cast<uintptr_t>(global);
+    });
+    EXPECT_TRUE(loadsGlobal);
+    bool callsLoad = false;
+    xrefs.forEachReference(call, 32, [&](const Xref& xref)
+    {
+        callsLoad |= xref.kind == XrefKind::Call 
+            && xrefs.address(xref.target) == reinterpret_cast<uintptr_t>(load);
+    });
+    EXPECT_TRUE(callsLoad);
+
+    int local = 0;
+    auto ignore = [](const Xref&) {};
+    EXPECT_EQ(xrefs.forEachReferrer(&local, ignore), 0u);
+    EXPECT_EQ(xrefs.firstReferrer(&local), 0u);
+}
+
+#endif // if defined(ZYCORE_GNUC) && defined(__x86_64__)
+
+// ============================================================================================== //
+// [SymbolTable] testing                                                                          //
+// ============================================================================================== //
+
+TEST(SymbolTableTest, PerfMapTest)
+{
+    SymbolTable symbols;
+    symbols.add("second", uintptr_t{0x2000}, 0x10);
+    symbols.add("first", uintptr_t{0x1000});
+    symbols.add("alias", uintptr_t{0x1000});
+    symbols.add("ignored", uintptr_t{0});
+    symbols.add("far", uintptr_t{0x1000000});
+
+    Function<int (*)(int)> triple{&profiledTriple};
+    symbols.add("triple", triple);
+
+    PatternBatch batch;
+    batch.add("90");
+    batch.add("CC");
+    batch.setAddress(1, 0x1020);
+    const char* const kPatternNames[] = {"unresolved", "pattern"};
+    EXPECT_EQ(symbols.addPatterns(batch, kPatternNames), 1u);
+
+    LayoutTable table{LayoutProfileTest::kIdCount};
+    const std::size_t kFunctionIds[] = {LayoutProfileTest::kIdTriple};
+    EXPECT_EQ(symbols.addLayout(table, LayoutProfileTest::kNames, kFunctionIds, 1), 0u);
+    LayoutProfile profile{"test", LayoutProfileTest::kIdCount};
+    profile.set(LayoutProfileTest::kIdA, 0);
+    profile.set(LayoutProfileTest::kIdB, 4);
+    profile.set(LayoutProfileTest::kIdTriple, 0x800);
+    ASSERT_TRUE(table.activate(profile, reinterpret_cast<void*>(0x10000)));
+    EXPECT_EQ(symbols.addLayout(table, LayoutProfileTest::kNames, kFunctionIds, 1), 1u);
+
+    const auto& sorted = symbols.symbols();
+    ASSERT_EQ(sorted.size(), 6u);
+    EXPECT_EQ(sorted[0].name, "first");
+    EXPECT_EQ(sorted[0].size, 0x20u);
+    EXPECT_EQ(sorted[1].name, "pattern");
+    EXPECT_EQ(sorted[1].size, SymbolTable::kDefaultSize + 0);
+    EXPECT_EQ(sorted[2].size, 0x10u);
+    EXPECT_EQ(sorted[3].name, "triple");
+    EXPECT_EQ(sorted[3].address, 0x10800u);
+    auto tripleAddr = reinterpret_cast<uintptr_t>(triple.get());
+    EXPECT_TRUE(std::any_of(sorted.begin(), sorted.end(), 
+        [&](const Symbol& symbol) { return symbol.address == tripleAddr; }));
+
+    const char* kPath = "remodel_test.map";
+    ASSERT_TRUE(symbols.writePerfMap(kPath));
+    auto file = std::fopen(kPath, "r");
+    ASSERT_TRUE(file != nullptr);
+    char line[256];
+    ASSERT_TRUE(std::fgets(line, sizeof(line), file) != nullptr);
+    EXPECT_STREQ(line, "1000 20 first\n");
+    ASSERT_TRUE(std::fgets(line, sizeof(line), file) != nullptr);
+    EXPECT_STREQ(line, "1020 100 pattern\n");
+    std::fclose(file);
+    std::remove(kPath);
+
+    char expectedPath[64];
+    std::snprintf(expectedPath, sizeof(expectedPath), "/tmp/perf-%llu.map", 
+        static_cast<unsigned long long>(platform::currentProcess()));
+    EXPECT_EQ(SymbolTable::perfMapPath(), expectedPath);
+}
+
+// ============================================================================================== //
+// [Pattern] testing                                                                              //
+// ============================================================================================== //
+
+class PatternTest : public testing::Test {};
+
+TEST_F(PatternTest, ParseTest)
+{
+    Pattern ida{"48 8b ?? ? 05"};
+    ASSERT_TRUE(ida.isValid());
+    EXPECT_EQ(ida.size(),        5u);
+    EXPECT_EQ(ida.firstAnchor(), 0u);
+    EXPECT_EQ(ida.lastAnchor(),  4u);
+    EXPECT_EQ(ida.bytes()[1],    0x8B);
+    EXPECT_EQ(ida.mask()[2],     0);
+
+    const uint8_t bytes[] = {0x11, 0x00, 0x22};
+    Pattern code{bytes, "?xx"};
+    ASSERT_TRUE(code.isValid());
+    EXPECT_EQ(code.firstAnchor(), 1u);
+
+    EXPECT_FALSE(Pattern{"48 8"}.isValid());
+    EXPECT_FALSE(Pattern{"48 XY"}.isValid());
+    EXPECT_FALSE(Pattern{"?? ??"}.isValid());
+    EXPECT_FALSE(Pattern{""}.isValid());
+    EXPECT_FALSE((Pattern{bytes, "xy"}.isValid()));
+}
+
+TEST_F(PatternTest, ScanTest)
+{
+    std::vector<uint8_t> data(1000, 0xCC);
+    auto place = [&](std::size_t offset)
+    {
+        data[offset] = 0xE8; data[offset + 1] = 0x12; data[offset + 4] = 0x90;
+    };
+    
+    std::vector<ScanKernel> kernels{ScanKernel::Scalar};
+    if (bestScanKernel() >= ScanKernel::Sse2) kernels.push_back(ScanKernel::Sse2);
+    if (bestScanKernel() >= ScanKernel::Avx2) kernels.push_back(ScanKernel::Avx2);
+
+    Pattern pattern{"E8 12 ?? ?? 90"};
+    for (auto kernel : kernels)
+    {
+        std::fill(data.begin(), data.end(), 0xCC);
+        EXPECT_EQ(findPattern(data.data(), data.size(), pattern, kernel), nullptr);
+
+        // Partial matches must be rejected, full matches at the very end must be found.
+        data[100] = 0xE8; data[104] = 0x90;
+        place(data.size() - 5);
+        EXPECT_EQ(findPattern(data.data(), data.size(), pattern, kernel), &data[995]);
+        EXPECT_EQ(findPattern(data.data(), data.size() - 1, pattern, kernel), nullptr);
+
+        place(517);
+        EXPECT_EQ(findPattern(data.data(), data.size(), pattern, kernel), &data[517]);
+        place(3);
+        EXPECT_EQ(findPattern(data.data(), data.size(), pattern, kernel), &data[3]);
+        EXPECT_EQ(findPattern(data.data(), 4, pattern, kernel), nullptr);
+    }
+}
+
+TEST_F(PatternTest, BatchTest)
+{
+    std::vector<uint8_t> data(4096, 0xCC);
+    auto place = [&](std::size_t offset, std::initializer_list<uint8_t> bytes)
+    {
+        std::copy(bytes.begin(), bytes.end(), data.begin() + offset);
+    };
+    place(0,    {0x11, 0x22, 0x33, 0x44});
+    place(700,  {0xE8, 0x00, 0x00, 0x00, 0x00, 0xC3});
+    place(1500, {0xE8, 0x10, 0x20, 0x30, 0x40, 0xC3});
+    place(2000, {0x55, 0x90, 0x66, 0x90, 0x77});
+    place(4092, {0xAB, 0xCD, 0xEF, 0x01});
+
+    PatternBatch batch;
+    const char* patterns[] = {
+        "11 22 33 44",          // At the very begin, anchor at offset 0.
+        "?? ?? 22 33",          // Anchor preceded by wildcards, must not reach before the data.
+        "E8 ?? ?? ?? ?? C3",    // Two matches, the first one wins.
+        "E8 10 ?? ?? 40 C3",    // Shares its lead byte with the previous pattern.
+        "55 ?? 66 ?? 77",       // No adjacent anchors, bucketed by a single byte.
+        "AB CD EF 01",          // At the very end.
+        "AB CD EF 01 02",       // Would reach past the end.
+        "DE AD BE EF",          // Not present.
+        "XY",                   // Invalid.
+    };
+    for (auto pattern : patterns) batch.add(pattern);
+    EXPECT_EQ(batch.size(), 9u);
+
+    batch.scan(data.data(), data.size());
+    EXPECT_FALSE(batch.allResolved());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        auto expected = findPattern(data.data(), data.size(), batch.pattern(i));
+        EXPECT_EQ(batch.address(i), reinterpret_cast<uintptr_t>(expected)) << patterns[i];
+    }
+    EXPECT_EQ(batch.address(2), reinterpret_cast<uintptr_t>(&data[700]));
+    EXPECT_EQ(batch.address(4), reinterpret_cast<uintptr_t>(&data[2000]));
+
+    // Further scans only resolve what is still missing.
+    std::vector<uint8_t> more{0x00, 0xDE, 0xAD, 0xBE, 0xEF};
+    batch.scan(more.data(), more.size());
+    EXPECT_EQ(batch.address(7), reinterpret_cast<uintptr_t>(&more[1]));
+    EXPECT_EQ(batch.address(0), reinterpret_cast<uintptr_t>(&data[0]));
+
+    batch.reset();
+    EXPECT_FALSE(batch.isResolved(0));
+}
+
+TEST_F(PatternTest, ParallelBatchTest)
+{
+    // 8 threads split 4 MiB into 512 KiB chunks.
+    const std::size_t kChunk = 512 * 1024;
+    std::vector<uint8_t> data(8 * kChunk, 0xCC);
+    auto place = [&](std::size_t offset, std::initializer_list<uint8_t> bytes)
+    {
+        std::copy(bytes.begin(), bytes.end(), data.begin() + offset);
+    };
+    place(1 * kChunk - 2, {0x10, 0x20, 0x30, 0x40});    // Straddling chunk 0 and 1.
+    place(3 * kChunk - 1, {0x50, 0x60, 0x70});          // Bucketed bytes straddling 2 and 3.
+    place(6 * kChunk + 9, {0x80, 0x90, 0xA0});          // Later match loses ...
+    place(2 * kChunk + 9, {0x80, 0x90, 0xA0});          // ... against the earlier one.
+    place(8 * kChunk - 3, {0xB0, 0xC0, 0xD0});          // At the very end.
+
+    PatternBatch batch;
+    batch.add("10 20 30 40");
+    batch.add("?? ?? 50 60 70");
+    batch.add("80 90 A0");
+    batch.add("B0 C0 D0");
+    batch.add("DE AD");
+
+    PatternBatch serial = batch;
+    serial.scan(data.data(), data.size());
+    batch.scan(data.data(), data.size(), 8);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_EQ(batch.address(i), serial.address(i));
+    }
+    EXPECT_EQ(batch.address(0), reinterpret_cast<uintptr_t>(&data[1 * kChunk - 2]));
+    EXPECT_EQ(batch.address(1), reinterpret_cast<uintptr_t>(&data[3 * kChunk - 3]));
+    EXPECT_EQ(batch.address(2), reinterpret_cast<uintptr_t>(&data[2 * kChunk + 9]));
+    EXPECT_EQ(batch.address(3), reinterpret_cast<uintptr_t>(&data[8 * kChunk - 3]));
+    EXPECT_FALSE(batch.isResolved(4));
+}
+
+// ============================================================================================== //
+// [TypeRegistry] testing                                                                         //
+// ============================================================================================== //
+
+class WrapTypedA : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapTypedA)
+public:
+    Field<int> value{this, sizeof(void*)};
+};
+
+class WrapTypedB : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapTypedB)
+public:
+    Field<int> value{this, sizeof(void*)};
+};
+
+TEST(TypeRegistryTest, LookupTest)
+{
+    struct Obj
+    {
+        const void* vftable;
+        int         value;
+    };
+    static void* vftables[64];
+    TypeRegistry types;
+    EXPECT_TRUE(types.add<WrapTypedA>(&vftables[0]));
+    EXPECT_TRUE(types.add<WrapTypedB>(&vftables[1]));
+    EXPECT_TRUE(types.add<WrapTypedB>(&vftables[1]));
+    EXPECT_FALSE(types.add<WrapTypedA>(&vftables[1]));
+    EXPECT_FALSE(types.add<WrapTypedA>(nullptr));
+
+    // Growing the table keeps all entries.
+    for (std::size_t i = 2; i < 64; ++i) 
+    {
+        EXPECT_TRUE(i % 2 ? types.add<WrapTypedB>(&vftables[i]) 
+            : types.add<WrapTypedA>(&vftables[i]));
+    }
+    EXPECT_EQ(types.size(), 64u);
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(types.find(&vftables[i]), i % 2 ? typeKeyOf<WrapTypedB>() 
+            : typeKeyOf<WrapTypedA>());
+    }
+
+    Obj a{&vftables[4], 1}, b{&vftables[7], 2}, unknown{&a, 3};
+    EXPECT_TRUE(types.is<WrapTypedA>(&a));
+    EXPECT_FALSE(types.is<WrapTypedA>(&b));
+    EXPECT_FALSE(types.is<WrapTypedA>(nullptr));
+    EXPECT_EQ(types.typeOf(&unknown), nullptr);
+    auto castB = types.cast<WrapTypedB>(&b);
+    ASSERT_TRUE(castB.hasValue());
+    EXPECT_EQ((*castB).value, 2);
+    EXPECT_FALSE(types.cast<WrapTypedB>(&a).hasValue());
+
+    TypeRegistry byInstance;
+    EXPECT_TRUE(byInstance.addOf(wrapper_cast<WrapTypedB>(&b)));
+    EXPECT_TRUE(byInstance.is<WrapTypedB>(&b));
+
+    // Heterogeneous dispatch, receiving the wrapper of the dynamic type.
+    int sumA = 0, sumB = 0;
+    void* objs[] = {&a, &b, &unknown, &b};
+    int dispatched = 0;
+    for (auto obj : objs)
+    {
+        dispatched += types.dispatch<WrapTypedA, WrapTypedB>(obj, [&](auto& typed)
+        {
+            using Typed = std::decay_t<decltype(typed)>;
+            (std::is_same<Typed, WrapTypedA>::value ? sumA : sumB) += typed.value;
+        });
+    }
+    EXPECT_EQ(dispatched, 3);
+    EXPECT_EQ(sumA, 1);
+    EXPECT_EQ(sumB, 4);
+}
+
+TEST(TypeRegistryTest, TypeSwitchTest)
+{
+    struct Obj
+    {
+        const void* vftable;
+        int         value;
+    };
+    static void* vftables[3];
+    TypeRegistry types;
+    types.add<WrapTypedA>(&vftables[0]);
+    types.add<WrapTypedB>(&vftables[1]);
+    types.add<WrapTypedB>(&vftables[2]);
+
+    TypeSwitch<WrapTypedB, WrapTypedA> onTyped{types};
+    EXPECT_EQ(onTyped.size(), 3u);
+
+    Obj a{&vftables[0], 1}, b{&vftables[1], 2}, b2{&vftables[2], 4}, unknown{&a, 8};
+    EXPECT_EQ(onTyped.indexOf(&a), 1);
+    EXPECT_EQ(onTyped.indexOf(&b2), 0);
+    EXPECT_EQ(onTyped.indexOf(&unknown), -1);
+    EXPECT_EQ(onTyped.indexOf(nullptr), -1);
+
+    int sumA = 0, sumB = 0, visited = 0;
+    for (void* obj : {&a, &b, &b2, &unknown})
+    {
+        visited += onTyped.visit(obj,
+            [&](WrapTypedB& typed) { sumB += typed.value; },
+            [&](WrapTypedA& typed) { sumA += typed.value; });
+    }
+    EXPECT_EQ(visited, 3);
+    EXPECT_EQ(sumA, 1);
+    EXPECT_EQ(sumB, 6);
+
+    // Vftables registered later are picked up on refresh only.
+    types.add<WrapTypedA>(&a);
+    EXPECT_FALSE(onTyped.visit(&unknown, [](WrapTypedB&) {}, [](WrapTypedA&) {}));
+    onTyped.refresh(types);
+    EXPECT_TRUE(onTyped.visit(&unknown, [](WrapTypedB&) {}, [](WrapTypedA&) {}));
+}
+
+// ============================================================================================== //
+// [VftableScanner] testing                                                                       //
+// ============================================================================================== //
+
+class VftableScannerTest : public testing::Test
+{
+public:
+    struct Base
+    {
+        explicit Base(int32_t tag) : tag{tag} {}
+        virtual ~Base() = default;
+        int32_t tag;
+    };
+
+    struct Derived : Base
+    {
+        using Base::Base;
+    };
+
+    class WrapBase : public ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapBase)
+    public:
+        Field<int32_t> tag{this, sizeof(void*)};
+    };
+};
+
+VftableScannerTest::Base gScannedGlobal{0x600D};
+
+TEST_F(VftableScannerTest, KernelTest)
+{
+    std::vector<uintptr_t> words(4096);
+    for (std::size_t i = 0; i < words.size(); ++i) words[i] = i * 0x1001;
+
+    std::vector<uintptr_t> values{0xAAAA0001, 0xBBBB0002, 0xCCCC0003};
+    for (std::size_t i = 10; i < 12; ++i) values.push_back(0xDDDD0000 + i);
+    words[0]    = values[0];
+    words[17]   = values[1];
+    words[18]   = values[1];
+    words[2000] = values[2];
+    words[4095] = values[0];
+    // A value straddling two words must not be found.
+    auto straddling = values[2];
+    std::memcpy(reinterpret_cast<uint8_t*>(&words[3000]) + 1, &straddling, sizeof(straddling));
+
+    std::vector<ScanKernel> kernels{ScanKernel::Scalar};
+    if (bestScanKernel() >= ScanKernel::Sse2) kernels.push_back(ScanKernel::Sse2);
+    if (bestScanKernel() >= ScanKernel::Avx2) kernels.push_back(ScanKernel::Avx2);
+
+    std::vector<const void*> expected{&words[0], &words[17], &words[18], &words[2000], 
+        &words[4095]};
+    for (auto kernel : kernels)
+    {
+        std::vector<const void*> matches;
+        findPointerValues(words.data(), words.size() * sizeof(uintptr_t), values.data(), 3,
+            matches, kernel);
+        EXPECT_EQ(expected, matches);
+
+        // Words only partially inside the data are skipped.
+        matches.clear();
+        findPointerValues(reinterpret_cast<uint8_t*>(words.data()) + 1, 
+            words.size() * sizeof(uintptr_t) - 2, values.data(), 3, matches, kernel);
+        EXPECT_EQ(std::vector<const void*>(expected.begin() + 1, expected.end() - 1), matches);
+    }
+
+    // More values than the vector kernels support.
+    values.resize(12, 0xEEEE0000);
+    words[100] = values.back();
+    std::vector<const void*> matches;
+    findPointerValues(words.data(), words.size() * sizeof(uintptr_t), values.data(), 
+        values.size(), matches);
+    EXPECT_EQ(6u, matches.size());
+}
+
+TEST_F(VftableScannerTest, ScanTest)
+{
+    std::vector<std::unique_ptr<Base>> objects;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        if (i % 4) objects.emplace_back(new Base{i});
+        else       objects.emplace_back(new Derived{i});
+    }
+
+    VftableScanner scanner;
+    auto baseIdx    = scanner.addOf(wrapper_cast<WrapBase>(objects[1].get()));
+    auto derivedIdx = scanner.addOf(wrapper_cast<WrapBase>(objects[0].get()));
+    EXPECT_EQ(2u, scanner.size());
+
+#   ifdef REMODEL_HAS_REGION_QUERY
+        ASSERT_TRUE(scanner.scanProcess(2));
+        auto bases    = scanner.instances<WrapBase>(baseIdx);
+        auto deriveds = scanner.instances<WrapBase>(derivedIdx);
+        auto all      = scanner.instances<WrapBase>();
+        EXPECT_EQ(all.size(), bases.size() + deriveds.size());
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            EXPECT_TRUE((i % 4 ? bases : deriveds).contains(objects[i].get()));
+        }
+        EXPECT_TRUE(bases.contains(&gScannedGlobal));
+
+        // Stale copies in freed memory are candidates as well, only sum the live objects.
+        std::vector<void*> live;
+        for (const auto& object : objects) live.push_back(object.get());
+        std::sort(live.begin(), live.end());
+        int64_t tagSum = 0;
+        for (auto& candidate : all) 
+        {
+            if (std::binary_search(live.begin(), live.end(), candidate.addressOfObj())) 
+            {
+                tagSum += candidate.tag;
+            }
+        }
+        EXPECT_EQ(999 * 1000 / 2, tagSum);
+        EXPECT_TRUE(std::is_sorted(all.data(), all.data() + all.size()));
+
+        // Rescanning replaces the candidates, finding every live object once.
+        ASSERT_TRUE(scanner.scanProcess(1));
+        const auto& rescanned = scanner.candidates(baseIdx);
+        EXPECT_TRUE(std::adjacent_find(rescanned.begin(), rescanned.end()) == rescanned.end());
+        std::size_t liveCount = 0;
+        for (auto candidate : rescanned)
+        {
+            if (std::binary_search(live.begin(), live.end(), candidate)) ++liveCount;
+        }
+        EXPECT_EQ(750u, liveCount);
+#   endif
+
+    scanner.reset();
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    if (scanner.scanModule(mainModule.value()))
+    {
+        EXPECT_TRUE(scanner.instances<WrapBase>(baseIdx).contains(&gScannedGlobal));
+        EXPECT_FALSE(scanner.instances<WrapBase>(baseIdx).contains(objects[1].get()));
+    }
+
+    scanner.reset();
+    scanner.scan(objects[2].get(), sizeof(Base));
+    ASSERT_EQ(1u, scanner.instances<WrapBase>().size());
+    EXPECT_EQ(2, scanner.instances<WrapBase>()[0].tag);
+}
+
+TEST_F(VftableScannerTest, InstanceSetTest)
+{
+    std::vector<std::unique_ptr<Base>> objects;
+    std::vector<void*> raws;
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        objects.emplace_back(new Base{i});
+        raws.push_back(objects.back().get());
+    }
+    std::sort(raws.begin(), raws.end());
+
+    InstanceSet<WrapBase> set{raws};
+    EXPECT_EQ(8u, set.prefetchDistance());
+    for (std::size_t distance : {0, 1, 8, 1000})
+    {
+        set.setPrefetchDistance(distance);
+        int32_t sum = 0;
+        for (auto& object : set) sum += object.tag;
+        EXPECT_EQ(99 * 100 / 2, sum);
+        EXPECT_EQ(100, std::distance(set.begin() + 2, set.end() - 2) + 4);
+    }
+}
+
+TEST_F(VftableScannerTest, UpdateTest)
+{
+    // Objects placed in an arena, page-sized chunks of which are marked dirty by hand.
+    const std::size_t kPage = 4096;
+    std::vector<uintptr_t> storage(4 * kPage / sizeof(uintptr_t) + 64);
+    auto arena = reinterpret_cast<uint8_t*>(
+        (reinterpret_cast<uintptr_t>(storage.data()) + kPage - 1) / kPage * kPage);
+    auto place = [&](std::size_t offset, int32_t tag) { return new (arena + offset) Base{tag}; };
+
+    auto a = place(0, 1);
+    auto b = place(kPage + 64, 2);
+    place(2 * kPage, 3);
+
+    VftableScanner scanner;
+    auto idx = scanner.addOf(wrapper_cast<WrapBase>(a));
+    scanner.scan(arena, 4 * kPage);
+    EXPECT_EQ(3u, scanner.candidates(idx).size());
+
+    // Overwritten objects are dropped by re-validation, even without dirty ranges.
+    std::memset(static_cast<void*>(b), 0, sizeof(Base));
+    scanner.update({});
+    EXPECT_EQ(0u, scanner.lastScanSize());
+    EXPECT_EQ((std::vector<void*>{arena, arena + 2 * kPage}), scanner.candidates(idx));
+
+    // New objects are found in dirty ranges, objects in dirty ranges are re-discovered.
+    place(3 * kPage + 128, 4);
+    scanner.update({{arena + 2 * kPage, 2 * kPage}});
+    EXPECT_EQ(2 * kPage, scanner.lastScanSize());
+    EXPECT_EQ((std::vector<void*>{arena, arena + 2 * kPage, arena + 3 * kPage + 128}),
+        scanner.candidates(idx));
+}
+
+TEST_F(VftableScannerTest, RescanTest)
+{
+    std::vector<std::unique_ptr<Base>> objects;
+    for (int32_t i = 0; i < 100; ++i) objects.emplace_back(new Base{i});
+
+    VftableScanner scanner;
+    auto idx = scanner.addOf(wrapper_cast<WrapBase>(objects[0].get()));
+    bool tracking = scanner.enablePageTracking();
+    EXPECT_EQ(tracking, scanner.isPageTrackingEnabled());
+
+#   ifdef REMODEL_HAS_REGION_QUERY
+        ASSERT_TRUE(scanner.rescanProcess(1));
+        auto fullSize = scanner.lastScanSize();
+        for (const auto& object : objects)
+        {
+            EXPECT_TRUE(scanner.instances<WrapBase>(idx).contains(object.get()));
+        }
+
+        objects.resize(50);
+        for (int32_t i = 0; i < 50; ++i) objects.emplace_back(new Base{1000 + i});
+        ASSERT_TRUE(scanner.rescanProcess(1));
+        auto instances = scanner.instances<WrapBase>(idx);
+        for (const auto& object : objects) EXPECT_TRUE(instances.contains(object.get()));
+        if (tracking) EXPECT_LT(scanner.lastScanSize(), fullSize);
+        else          EXPECT_GT(scanner.lastScanSize(), 0u);
+#   endif
+}
+
+// ============================================================================================== //
+// [REMODEL_REFLECT] testing                                                                      //
+// ============================================================================================== //
+
+struct RawReflected
+{
+    int32_t id;
+    float   speed;
+    int16_t flags;
+    double  weight;
+};
+
+class WrapReflected : public AdvancedClassWrapper<sizeof(RawReflected)>
+{
+    REMODEL_ADV_WRAPPER(WrapReflected)
+public:
+    StaticField<int32_t, offsetof(RawReflected, id)>     id     {this};
+    StaticField<float,   offsetof(RawReflected, speed)>  speed  {this};
+    Field<int16_t>                                       flags  {this, 
+                                                                 offsetof(RawReflected, flags)};
+    StaticField<double,  offsetof(RawReflected, weight)> weight {this};
+    REMODEL_REFLECT(&WrapReflected::id, &WrapReflected::speed, &WrapReflected::flags, 
+        &WrapReflected::weight)
+};
+
+TEST(ReflectTest, MetadataTest)
+{
+    using Speed = ReflectedField<WrapReflected, 1>;
+    using Flags = ReflectedField<WrapReflected, 2>;
+
+    // Everything but the offsets of runtime fields is a constant.
+    static_assert(reflectedFieldCount<WrapReflected>() == 4, "");
+    static_assert(IsReflected<WrapReflected>::value, "");
+    static_assert(!IsReflected<RawReflected>::value, "");
+    static_assert(std::is_same<Speed::Type, float>::value, "");
+    static_assert(Speed::kSize == sizeof(float), "");
+    static_assert(Speed::kHasStaticOffset && Speed::kOffset == offsetof(RawReflected, speed), "");
+    static_assert(!Flags::kHasStaticOffset && Flags::kOffset == -1, "");
+    static_assert(Speed::nameLength() == 5 && Speed::name()[0] == 's', "");
+    static_assert(Speed::member() == &WrapReflected::speed, "");
+
+    EXPECT_STREQ("id", (ReflectedField<WrapReflected, 0>::name()));
+    EXPECT_STREQ("flags", Flags::name());
+    EXPECT_STREQ("weight", (ReflectedField<WrapReflected, 3>::name()));
+
+    RawReflected raw{7, 1.5f, 3, 80.};
+    auto wrapper = wrapper_cast<WrapReflected>(&raw);
+    EXPECT_EQ(Flags::offsetIn(wrapper), 
+        static_cast<std::ptrdiff_t>(offsetof(RawReflected, flags)));
+    Flags::of(wrapper) = 4;
+    EXPECT_EQ(raw.flags, 4);
+}
+
+TEST(ReflectTest, ForEachFieldTest)
+{
+    std::string names;
+    std::size_t totalSize = 0;
+    forEachField<WrapReflected>([&](auto info)
+    {
+        using Info = decltype(info);
+        names += Info::name();
+        names += ';';
+        totalSize += Info::kSize;
+    });
+    EXPECT_EQ(names, "id;speed;flags;weight;");
+    EXPECT_EQ(totalSize, 4u + 4u + 2u + 8u);
+
+    // Values are accessed through the fields with their real types.
+    RawReflected raw{7, 1.5f, 3, 80.};
+    auto wrapper = wrapper_cast<WrapReflected>(&raw);
+    double sum = 0.;
+    forEachField(wrapper, [&](auto info, auto& field)
+    {
+        typename decltype(info)::Type value = field;
+        sum += value;
+        field = value * 2;
+    });
+    EXPECT_EQ(sum, 7. + 1.5 + 3. + 80.);
+    EXPECT_EQ(raw.id, 14);
+    EXPECT_EQ(raw.speed, 3.f);
+    EXPECT_EQ(raw.flags, 6);
+    EXPECT_EQ(raw.weight, 160.);
+}
+
+// ============================================================================================== //
+// [ObjectDiff] testing                                                                           //
+// ============================================================================================== //
+
+class ObjectDiffTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int      id;
+        float    health;
+        double   position[2];
+        uint64_t lastSeen;
+        uint8_t  blob[37];
+        uint8_t  flags;
+    };
+
+    struct WrapA : AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int>       id      {this, offsetof(A, id)};
+        Field<float>     health  {this, offsetof(A, health)};
+        Field<double[2]> position{this, offsetof(A, position)};
+        static constexpr FieldDesc<uint64_t, offsetof(A, lastSeen)> lastSeen{};
+        static constexpr FieldDesc<uint8_t,  offsetof(A, flags)>    flags{};
+    };
+public:
+    ObjectDiffTest()
+    {
+        std::memset(&a, 0, sizeof(a));
+        a.id     = 1;
+        a.health = 100.f;
+        b = a;
+    }
+protected:
+    A a;
+    A b;
+};
+
+TEST_F(ObjectDiffTest, CompareTest)
+{
+    ObjectDiff<WrapA> diff{&WrapA::id, &WrapA::health, &WrapA::position, WrapA::lastSeen, 
+        WrapA::flags};
+    EXPECT_EQ(diff.fieldCount(), 5u);
+    EXPECT_EQ(diff.fieldOffset(2), offsetof(A, position));
+    EXPECT_EQ(diff.fieldSize(2), sizeof(double[2]));
+    EXPECT_EQ(diff.fieldOffset(4), offsetof(A, flags));
+
+    std::vector<std::size_t> changed;
+    EXPECT_TRUE(diff.equal(&a, &b));
+    EXPECT_EQ(diff.changedFields(&a, &b, changed), 0u);
+
+    b.position[1] = 3.;
+    b.flags       = 1;
+    EXPECT_FALSE(diff.equal(&a, &b));
+    EXPECT_EQ(diff.changedFields(&a, &b, changed), 2u);
+    EXPECT_EQ(changed, (std::vector<std::size_t>{2, 4}));
+
+    // Undeclared bytes make objects unequal without being reported as fields.
+    b = a;
+    b.blob[30] = 1;
+    EXPECT_FALSE(diff.equal(&a, &b));
+    EXPECT_EQ(diff.changedFields(&a, &b, changed), 0u);
+
+    b = a;
+    b.lastSeen = 42;
+    b.health   = 5.f;
+    diff.ignore(3);
+    EXPECT_TRUE(diff.isIgnored(3));
+    EXPECT_EQ(diff.changedFields(wrapper_cast<WrapA>(&a), wrapper_cast<WrapA>(&b), changed), 1u);
+    EXPECT_EQ(changed, std::vector<std::size_t>{1});
+    b.health = a.health;
+    EXPECT_TRUE(diff.equal(wrapper_cast<WrapA>(&a), wrapper_cast<WrapA>(&b)));
+    diff.include(3);
+    EXPECT_FALSE(diff.equal(&a, &b));
+}
+
+TEST_F(ObjectDiffTest, CopyTest)
+{
+    ObjectDiff<WrapA> diff{&WrapA::id, WrapA::lastSeen};
+    b.id       = 7;
+    b.lastSeen = 9;
+    b.blob[36] = 3;
+    b.flags    = 4;
+
+    A c = a;
+    diff.copy(&c, &b);
+    EXPECT_EQ(std::memcmp(&c, &b, sizeof(A)), 0);
+
+    c = a;
+    diff.ignore(1);
+    diff.copy(&c, &b);
+    EXPECT_EQ(c.id, 7);
+    EXPECT_EQ(c.lastSeen, 0u);
+    EXPECT_EQ(c.blob[36], 3);
+    EXPECT_EQ(c.flags, 4);
+}
+
+// ============================================================================================== //
+// [CaptureWriter] / [CaptureReader] testing                                                      //
+// ============================================================================================== //
+
+class CaptureTest : public testing::Test
+{
+protected:
+    struct Node
+    {
+        int   value;
+        Node* next;
+    };
+
+    struct World
+    {
+        uint32_t id;
+        Node*    first;
+        Node*    selected;
+        alignas(16) float position[4];
+    };
+
+    class WrapNode : public AdvancedClassWrapper<sizeof(Node), alignof(Node)>
+    {
+        REMODEL_ADV_WRAPPER(WrapNode)
+    public:
+        Field<int>       value{this, offsetof(Node, value)};
+        Field<Node*>     next {this, offsetof(Node, next)};
+    };
+
+    class WrapWorld : public AdvancedClassWrapper<sizeof(World), alignof(World)>
+    {
+        REMODEL_ADV_WRAPPER(WrapWorld)
+    public:
+        Field<uint32_t>  id      {this, offsetof(World, id)};
+        Field<WrapNode*> first   {this, offsetof(World, first)};
+        Field<WrapNode*> selected{this, offsetof(World, selected)};
+        Field<float[4]>  position{this, offsetof(World, position)};
+    };
+
+    /// Fails reading the object at a given address.
+    struct FailingAccessor
+    {
+        uintptr_t failing;
+
+        bool read(const platform::MemoryRange& range)
+        {
+            if (range.address == failing) return false;
+            std::memcpy(range.buffer, reinterpret_cast<const void*>(range.address), range.size);
+            return true;
+        }
+    };
+protected:
+    CaptureTest()
+    {
+        for (int i = 0; i < 4; ++i) nodes[i] = Node{i * 10, &nodes[(i + 1) % 4]};
+        world = World{7, &nodes[0], &nodes[2], {1.f, 2.f, 3.f, 4.f}};
+        nodeType.follow(&WrapNode::next, nodeType);
+        worldType.follow(&WrapWorld::first, nodeType).follow(&WrapWorld::selected, nodeType);
+    }
+protected:
+    Node nodes[4];
+    World world;
+    CaptureType<WrapNode> nodeType{"Node"};
+    CaptureType<WrapWorld> worldType{"World"};
+};
+
+TEST_F(CaptureTest, WriteReadTest)
+{
+    EXPECT_EQ(worldType.edgeCount(), 2u);
+
+    std::vector<uint8_t> data{1, 2, 3};
+    {
+        CaptureWriter writer{data};
+        EXPECT_EQ(writer.write(worldType, wrapper_cast<WrapWorld>(&world)), 5u);
+        EXPECT_EQ(writer.write(nodeType, &nodes[3]), 0u);
+        EXPECT_EQ(writer.write(nodeType, nullptr), 0u);
+        EXPECT_EQ(writer.objectsWritten(), 5u);
+        EXPECT_TRUE(writer.close());
+    }
+    data.erase(data.begin(), data.begin() + 3);
+
+    CaptureReader capture{std::move(data)};
+    ASSERT_TRUE(capture.isOk());
+    ASSERT_EQ(capture.types().size(), 2u);
+    EXPECT_EQ(capture.types()[0].name, "World");
+    EXPECT_EQ(capture.types()[0].objSize, sizeof(World));
+    EXPECT_EQ(capture.types()[1].edgeOffsets, std::vector<uint32_t>{offsetof(Node, next)});
+    ASSERT_EQ(capture.objects().size(), 5u);
+    EXPECT_EQ(capture.findType("Node").value(), 1u);
+    EXPECT_FALSE(capture.findType("Cat"));
+
+    for (const auto& obj : capture.objects())
+    {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(obj.bytes) % capture.typeOf(obj).objAlign, 0u);
+        EXPECT_EQ(std::memcmp(obj.bytes, reinterpret_cast<const void*>(obj.address), 
+            capture.typeOf(obj).objSize), 0);
+    }
+
+    auto root = capture.objects()[0];
+    auto wrapWorld = capture.wrap<WrapWorld>(root);
+    EXPECT_EQ(wrapWorld.id, 7u);
+    EXPECT_EQ(wrapWorld.position[3], 4.f);
+    EXPECT_EQ(static_cast<void*>(wrapWorld.first), static_cast<void*>(&nodes[0]));
+
+    auto selected = capture.follow(root, 1);
+    ASSERT_TRUE(selected != nullptr);
+    EXPECT_EQ(capture.wrap<WrapNode>(*selected).value, 20);
+    auto node = selected;
+    for (int i = 0; i < 4; ++i) node = capture.follow(*node, 0);
+    EXPECT_EQ(node, selected);
+    EXPECT_EQ(capture.find(reinterpret_cast<uintptr_t>(&nodes[1]), 1)->address, 
+        reinterpret_cast<uintptr_t>(&nodes[1]));
+    EXPECT_EQ(capture.find(reinterpret_cast<uintptr_t>(&nodes[1]), 0), nullptr);
+    EXPECT_EQ(capture.find(reinterpret_cast<uintptr_t>(&world) + 1), nullptr);
+}
+
+TEST_F(CaptureTest, FileTest)
+{
+    const char* kPath = "remodel_test.capture";
+    std::vector<uint8_t> expected;
+    CaptureWriter{expected}.write(worldType, &world);
+    {
+        // Smaller than a single record, every record is flushed separately.
+        CaptureWriter writer{kPath, 16};
+        ASSERT_TRUE(writer.isOk());
+        EXPECT_EQ(writer.write(worldType, &world), 5u);
+        EXPECT_TRUE(writer.close());
+    }
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(CaptureReader::readFile(kPath, data));
+    std::remove(kPath);
+    EXPECT_EQ(data, expected);
+    EXPECT_FALSE(CaptureReader::readFile(kPath, data));
+    EXPECT_FALSE(CaptureWriter{"/nonexistent/remodel.capture"}.isOk());
+}
+
+TEST_F(CaptureTest, AccessorTest)
+{
+    std::vector<uint8_t> data;
+    {
+        CaptureWriter writer{data};
+        FailingAccessor accessor{reinterpret_cast<uintptr_t>(&nodes[1])};
+        EXPECT_EQ(writer.write(accessor, worldType, reinterpret_cast<uintptr_t>(&world)), 4u);
+    }
+
+    CaptureReader capture{data};
+    ASSERT_TRUE(capture.isOk());
+    EXPECT_EQ(capture.objects().size(), 4u);
+    EXPECT_EQ(capture.follow(capture.objects()[0], 0)->address, 
+        reinterpret_cast<uintptr_t>(&nodes[0]));
+    EXPECT_EQ(capture.follow(*capture.follow(capture.objects()[0], 0), 0), nullptr);
+
+    data.resize(data.size() - 1);
+    CaptureReader truncated{data};
+    EXPECT_FALSE(truncated.isOk());
+    EXPECT_EQ(truncated.objects().size(), 4u);
+    data[0] = 'X';
+    EXPECT_TRUE(CaptureReader{data}.objects().empty());
+}
+
+#ifdef REMODEL_HAS_MAPPED_FILE
+
+TEST_F(CaptureTest, MappedTest)
+{
+    const char* kPath = "remodel_test.capture";
+    {
+        CaptureWriter writer{kPath};
+        FailingAccessor accessor{reinterpret_cast<uintptr_t>(&nodes[3])};
+        EXPECT_EQ(writer.write(accessor, worldType, reinterpret_cast<uintptr_t>(&world)), 4u);
+    }
+    std::vector<uint8_t> before;
+    ASSERT_TRUE(CaptureReader::readFile(kPath, before));
+
+    {
+        MappedCapture capture;
+        ASSERT_TRUE(capture.open(kPath));
+        ASSERT_EQ(capture.types().size(), 2u);
+        EXPECT_EQ(capture.findType("Node").value(), 1u);
+        ASSERT_EQ(capture.objectCount(), 4u);
+        for (std::size_t i = 1; i < capture.objectCount(); ++i)
+        {
+            EXPECT_LT(capture.entry(i - 1).address, capture.entry(i).address);
+        }
+
+        auto wrapWorld = capture.wrap<WrapWorld>(reinterpret_cast<uintptr_t>(&world));
+        ASSERT_TRUE(wrapWorld);
+        EXPECT_EQ(wrapWorld.value().id, 7u);
+        EXPECT_EQ(wrapWorld.value().position[1], 2.f);
+
+        // Chains of pointer fields resolve within the mapping.
+        auto first = wrapWorld.value().first->toStrong();
+        EXPECT_NE(first.addressOfObj(), static_cast<void*>(&nodes[0]));
+        EXPECT_EQ(first.value, 0);
+        Node* next = first.next;
+        ASSERT_TRUE(next != nullptr);
+        EXPECT_EQ(next->value, 10);
+        EXPECT_EQ(next->next->value, 20);
+        EXPECT_EQ(next->next->next, nullptr);
+        EXPECT_EQ(wrapWorld.value().selected->toStrong().addressOfObj(), next->next);
+
+        EXPECT_EQ(capture.resolve(reinterpret_cast<uintptr_t>(&nodes[2])), next->next);
+        EXPECT_EQ(capture.resolve(reinterpret_cast<uintptr_t>(&nodes[2]), 1), next->next);
+        EXPECT_EQ(capture.resolve(reinterpret_cast<uintptr_t>(&nodes[2]), 0), nullptr);
+        EXPECT_EQ(capture.resolve(reinterpret_cast<uintptr_t>(&nodes[3])), nullptr);
+        EXPECT_FALSE(capture.wrap<WrapNode>(reinterpret_cast<uintptr_t>(&world) + 1));
+    }
+
+    std::vector<uint8_t> after;
+    ASSERT_TRUE(CaptureReader::readFile(kPath, after));
+    EXPECT_EQ(before, after);
+
+    // Captures without index can't be mapped.
+    auto file = std::fopen(kPath, "wb");
+    ASSERT_TRUE(file != nullptr);
+    std::fwrite(before.data(), 1, before.size() - 32, file);
+    std::fclose(file);
+    MappedCapture capture;
+    EXPECT_FALSE(capture.open(kPath));
+    EXPECT_FALSE(capture.isOpen());
+    std::remove(kPath);
+    EXPECT_FALSE(capture.open(kPath));
+}
+
+#endif // ifdef REMODEL_HAS_MAPPED_FILE
+
+// ============================================================================================== //
+// [ColumnCache] testing                                                                          //
+// ============================================================================================== //
+
+class ColumnCacheTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        uint32_t id;
+        uint8_t  pad[20];
+        float    health;
+        int16_t  ammo;
+        uint8_t  untracked;
+    };
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<uint32_t>                         id{this, offsetof(A, id)};
+        StaticField<float, offsetof(A, health)> health{this};
+        Field<int16_t>                          ammo{this, offsetof(A, ammo)};
+        Field<uint8_t>                          untracked{this, offsetof(A, untracked)};
+    };
+protected:
+    ColumnCacheTest()
+        : objs(1000)
+    {
+        for (std::size_t i = 0; i < objs.size(); ++i)
+        {
+            objs[i] = A{};
+            objs[i].id     = static_cast<uint32_t>(i);
+            objs[i].health = static_cast<float>(i) / 2.f;
+            objs[i].ammo   = static_cast<int16_t>(i % 100);
+        }
+    }
+protected:
+    std::vector<A> objs;
+};
+
+TEST_F(ColumnCacheTest, SpanTest)
+{
+    auto cache = mirrorFields(&WrapA::health, &WrapA::ammo);
+    cache.assign(WrapperSpan<WrapA>{objs.data(), objs.size()});
+    ASSERT_EQ(1000u, cache.size());
+    EXPECT_EQ(400.f, cache.column<0>()[800]);
+    EXPECT_EQ(99,    cache.column<1>()[999]);
+    EXPECT_EQ(0u,    cache.refresh());
+
+    objs[10].health     = -1.f;
+    objs[500].ammo      = 7;
+    objs[501].id        = 12345;
+    objs[502].untracked = 1;
+    EXPECT_EQ(2u, cache.refresh());
+    EXPECT_EQ((std::vector<std::size_t>{10, 500}), cache.changedRows());
+    EXPECT_EQ(-1.f, cache.column<0>()[10]);
+    EXPECT_EQ(7,    cache.column<1>()[500]);
+    EXPECT_EQ(&objs[500], cache.object(500));
+    EXPECT_EQ(0u, cache.refresh());
+    EXPECT_TRUE(cache.changedRows().empty());
+}
+
+TEST_F(ColumnCacheTest, InstanceSetTest)
+{
+    std::vector<void*> raws{&objs[3], &objs[1], &objs[2]};
+    ColumnCache<WrapA, Field<uint32_t>, Field<uint8_t>> cache{&WrapA::id, &WrapA::untracked};
+    cache.assign(InstanceSet<WrapA>{raws});
+    ASSERT_EQ(3u, cache.size());
+    EXPECT_EQ(1u, cache.column<0>()[1]);
+
+    // The watched range covers everything from the id to the end of the last field.
+    objs[1].pad[3] = 1;
+    objs[2].untracked = 9;
+    EXPECT_EQ(2u, cache.refresh());
+    EXPECT_EQ(9, cache.column<1>()[2]);
+
+    cache.assign(std::vector<void*>{});
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.refresh());
+}
+
+TEST_F(ColumnCacheTest, PageTrackingTest)
+{
+    auto cache = mirrorFields(&WrapA::id);
+    cache.assign(WrapperSpan<WrapA>{objs.data(), objs.size()});
+    if (!cache.enablePageTracking()) return;
+    cache.refresh();
+
+    objs[999].id = 0;
+    EXPECT_EQ(1u, cache.refresh());
+    EXPECT_EQ((std::vector<std::size_t>{999}), cache.changedRows());
+    EXPECT_EQ(0u, cache.column<0>()[999]);
+}
+
+TEST_F(ColumnCacheTest, PagePolicyTest)
+{
+    platform::PageBuffer buffer{3 << 20, {platform::PageKind::Huge2M, true}};
+    ASSERT_NE(nullptr, buffer.data());
+    EXPECT_EQ(size_t{3 << 20}, buffer.size());
+    EXPECT_GE(buffer.mappedPageSize(), 1u);
+    auto bytes = static_cast<uint8_t*>(buffer.data());
+    EXPECT_EQ(0, bytes[0] | bytes[(3 << 20) - 1]);
+    bytes[(3 << 20) - 1] = 1;
+
+    auto cache = mirrorFields(&WrapA::health, &WrapA::id);
+    cache.setPagePolicy({platform::PageKind::Huge1G, false});
+    cache.assign(WrapperSpan<WrapA>{objs.data(), objs.size()});
+    EXPECT_EQ(400.f, cache.column<0>()[800]);
+    EXPECT_EQ(999u,  cache.column<1>()[999]);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(cache.column<1>()) % 64);
+
+    objs[999].id = 1;
+    EXPECT_EQ(1u, cache.refresh());
+    EXPECT_EQ(1u, cache.column<1>()[999]);
+}
+
+// ============================================================================================== //
+// [selectRows] testing                                                                           //
+// ============================================================================================== //
+
+class QueryTest : public testing::Test
+{
+protected:
+    struct Horse
+    {
+        int32_t age;
+        float   weight;
+        bool    hatesKittehz;
+        uint8_t pad[7];
+    };
+
+    class WrapHorse : public AdvancedClassWrapper<sizeof(Horse)>
+    {
+        REMODEL_ADV_WRAPPER(WrapHorse)
+    public:
+        Field<int32_t>                                   age{this, offsetof(Horse, age)};
+        Field<float>                                     weight{this, offsetof(Horse, weight)};
+        StaticField<bool, offsetof(Horse, hatesKittehz)> hatesKittehz{this};
+    };
+protected:
+    QueryTest()
+        : horses(3000)
+    {
+        for (std::size_t i = 0; i < horses.size(); ++i)
+        {
+            horses[i] = Horse{};
+            horses[i].age          = static_cast<int32_t>(i % 10);
+            horses[i].weight       = static_cast<float>(i);
+            horses[i].hatesKittehz = i % 3 == 0;
+        }
+    }
+
+    template<typename PredT>
+    std::vector<uint32_t> expected(PredT pred) const
+    {
+        std::vector<uint32_t> result;
+        for (std::size_t i = 0; i < horses.size(); ++i)
+        {
+            if (pred(horses[i])) result.push_back(static_cast<uint32_t>(i));
+        }
+        return result;
+    }
+protected:
+    std::vector<Horse> horses;
+};
+
+TEST_F(QueryTest, SpanTest)
+{
+    WrapperSpan<WrapHorse> span{horses.data(), horses.size()};
+    std::vector<uint32_t> selection;
+
+    auto query = column(&WrapHorse::age) > 5 && column(&WrapHorse::hatesKittehz);
+    ASSERT_TRUE(selectRows(span, query, selection));
+    auto oldHaters = expected([](const Horse& h) { return h.age > 5 && h.hatesKittehz; });
+    EXPECT_EQ(oldHaters, selection);
+
+    ASSERT_TRUE(selectRows(span, 2 >= column(&WrapHorse::age) 
+        || !(column(&WrapHorse::weight) < 2500.5), selection));
+    auto youngOrHeavy = expected([](const Horse& h) 
+    { 
+        return 2 >= h.age || !(h.weight < 2500.5f); 
+    });
+    EXPECT_EQ(youngOrHeavy, selection);
+
+    // Columns compared with each other, and with constants converted to their type.
+    ASSERT_TRUE(selectRows(span, column(&WrapHorse::weight) == column(&WrapHorse::age) 
+        && column(&WrapHorse::age) != 7.9, selection));
+    EXPECT_EQ((std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6, 8, 9}), selection);
+
+    ASSERT_TRUE(selectRows(WrapperSpan<WrapHorse>{horses.data(), 0}, query, selection));
+    EXPECT_TRUE(selection.empty());
+}
+
+TEST_F(QueryTest, ColumnCacheTest)
+{
+    auto cache = mirrorFields(&WrapHorse::age, &WrapHorse::hatesKittehz);
+    cache.assign(WrapperSpan<WrapHorse>{horses.data(), horses.size()});
+    EXPECT_EQ(cache.column<1>(), cache.columnOf(&WrapHorse::hatesKittehz));
+    EXPECT_EQ(nullptr, cache.columnOf(&WrapHorse::weight));
+
+    std::vector<uint32_t> selection;
+    ASSERT_TRUE(selectRows(cache, column(&WrapHorse::age) <= 1 && 
+        !column(&WrapHorse::hatesKittehz), selection));
+    auto youngLovers = expected([](const Horse& h) { return h.age <= 1 && !h.hatesKittehz; });
+    EXPECT_EQ(youngLovers, selection);
+
+    // Fields not mirrored by the cache can't be queried.
+    EXPECT_FALSE(selectRows(cache, column(&WrapHorse::weight) > 1.f, selection));
+    EXPECT_TRUE(selection.empty());
+}
+
+// ============================================================================================== //
+// [HashIndex] / [SortedIndex] testing                                                            //
+// ============================================================================================== //
+
+class FieldIndexTest : public testing::Test
+{
+protected:
+    struct Entity
+    {
+        float    health;
+        uint32_t id;
+    };
+
+    class WrapEntity : public AdvancedClassWrapper<sizeof(Entity)>
+    {
+        REMODEL_ADV_WRAPPER(WrapEntity)
+    public:
+        Field<float>    health{this, offsetof(Entity, health)};
+        Field<uint32_t> id{this, offsetof(Entity, id)};
+    };
+protected:
+    FieldIndexTest()
+        : entities(100)
+    {
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            entities[i].health = 1.f;
+            entities[i].id     = static_cast<uint32_t>(1000 + i);
+        }
+    }
+
+    InstanceSet<WrapEntity> setOf(std::initializer_list<std::size_t> idxs)
+    {
+        std::vector<void*> raws;
+        for (auto idx : idxs) raws.push_back(&entities[idx]);
+        std::sort(raws.begin(), raws.end());
+        return InstanceSet<WrapEntity>{raws};
+    }
+protected:
+    std::vector<Entity> entities;
+};
+
+TEST_F(FieldIndexTest, HashIndexTest)
+{
+    auto byId = hashIndexOf(&WrapEntity::id);
+    byId.assign(WrapperSpan<WrapEntity>{entities.data(), entities.size()});
+    EXPECT_EQ(100u, byId.size());
+    EXPECT_EQ(&entities[42], byId.find(1042));
+    EXPECT_EQ(nullptr, byId.find(999));
+
+    // Lookups check the live key, refreshing re-keys the changed objects.
+    entities[42].id     = 7;
+    entities[43].health = 0.f;
+    EXPECT_EQ(nullptr, byId.find(1042));
+    EXPECT_EQ(nullptr, byId.find(7));
+    EXPECT_EQ(1u, byId.refresh());
+    EXPECT_EQ(&entities[42], byId.find(7));
+    EXPECT_EQ(0u, byId.refresh());
+
+    entities[44].id = 7;
+    byId.refresh();
+    std::vector<void*> found;
+    EXPECT_EQ(2u, byId.findAll(7, found));
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ((std::vector<void*>{&entities[42], &entities[44]}), found);
+}
+
+TEST_F(FieldIndexTest, SyncTest)
+{
+    HashIndex<WrapEntity, Field<uint32_t>> byId{&WrapEntity::id};
+    EXPECT_EQ(3u, byId.sync(setOf({1, 2, 3})));
+    EXPECT_EQ(&entities[2], byId.find(1002));
+
+    // One object vanished, one appeared, one kept changed its key.
+    entities[3].id = 5;
+    EXPECT_EQ(3u, byId.sync(setOf({2, 3, 50})));
+    EXPECT_EQ(3u, byId.size());
+    EXPECT_EQ(nullptr,       byId.find(1001));
+    EXPECT_EQ(&entities[3],  byId.find(5));
+    EXPECT_EQ(&entities[50], byId.find(1050));
+    EXPECT_EQ(0u, byId.sync(setOf({2, 3, 50})));
+
+    // Watches follow the synced objects.
+    entities[50].id = 6;
+    EXPECT_EQ(1u, byId.refresh());
+    EXPECT_EQ(&entities[50], byId.find(6));
+
+    EXPECT_EQ(3u, byId.sync(InstanceSet<WrapEntity>{}));
+    EXPECT_EQ(nullptr, byId.find(6));
+}
+
+TEST_F(FieldIndexTest, SortedIndexTest)
+{
+    auto byId = sortedIndexOf(&WrapEntity::id);
+    byId.sync(setOf({10, 5, 20, 30}));
+    EXPECT_EQ(&entities[20], byId.find(1020));
+
+    std::vector<void*> found;
+    EXPECT_EQ(3u, byId.findRange(1005, 1030, found));
+    EXPECT_EQ((std::vector<void*>{&entities[5], &entities[10], &entities[20]}), found);
+
+    entities[30].id = 1006;
+    byId.refresh();
+    EXPECT_EQ(3u, byId.findRange(1005, 1020, found));
+    EXPECT_EQ((std::vector<void*>{&entities[5], &entities[30], &entities[10]}), found);
+}
+
+// ============================================================================================== //
+// [WatchSet] testing                                                                             //
+// ============================================================================================== //
+
+class WatchSetTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int      id;
+        float    health;
+        uint8_t  blob[64];
+    };
+
+    struct WrapA : AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int>   id    {this, offsetof(A, id)};
+        Field<float> health{this, offsetof(A, health)};
+    };
+public:
+    WatchSetTest()
+    {
+        std::memset(&a, 0, sizeof(a));
+        std::memset(&b, 0, sizeof(b));
+    }
+protected:
+    A     a;
+    A     b;
+    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+    WrapA wrapB{wrapper_cast<WrapA>(&b)};
+
+    void runPolls(WatchSet& watches)
+    {
+        auto id     = watches.watch(wrapA.id);
+        auto health = watches.watch(wrapA.health);
+        auto object = watches.watchObject(wrapB);
+        EXPECT_EQ(watches.size(), 3u);
+
+        std::vector<std::size_t> changed;
+        EXPECT_EQ(watches.poll(changed), 0u);
+
+        a.health = 5.f;
+        b.blob[63] = 1;
+        EXPECT_EQ(watches.poll(changed), 2u);
+        EXPECT_EQ(changed, (std::vector<std::size_t>{health, object}));
+        EXPECT_EQ(*static_cast<const float*>(watches.shadow(health)), 5.f);
+        EXPECT_EQ(watches.poll(changed), 0u);
+
+        // Writing the same value doesn't count as a change.
+        a.id    = 0;
+        a.id    = 3;
+        a.blob[0] = 9;
+        EXPECT_EQ(watches.poll(changed), 1u);
+        EXPECT_EQ(changed, std::vector<std::size_t>{id});
+        a.id = 3;
+        EXPECT_EQ(watches.poll(changed), 0u);
+    }
+};
+
+TEST_F(WatchSetTest, PollTest)
+{
+    WatchSet watches;
+    EXPECT_FALSE(watches.isPageTrackingEnabled());
+    runPolls(watches);
+
+    watches.clear();
+    EXPECT_EQ(watches.size(), 0u);
+    std::vector<std::size_t> changed;
+    EXPECT_EQ(watches.poll(changed), 0u);
+}
+
+TEST_F(WatchSetTest, PageTrackingTest)
+{
+    WatchSet watches;
+    if (!watches.enablePageTracking()) return; // not supported by the platform/kernel
+    EXPECT_TRUE(watches.isPageTrackingEnabled());
+    runPolls(watches);
+
+    // Changes made before tracking was enabled are still reported.
+    WatchSet late;
+    auto idx = late.watch(wrapA.id);
+    a.id = 17;
+    ASSERT_TRUE(late.enablePageTracking());
+    std::vector<std::size_t> changed;
+    EXPECT_EQ(late.poll(changed), 1u);
+    EXPECT_EQ(changed, std::vector<std::size_t>{idx});
+}
+
+TEST_F(WatchSetTest, NotifierTest)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::size_t> notified;
+    WatchNotifier notifier{[&](std::size_t idx)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        notified.push_back(idx);
+        cv.notify_all();
+    }};
+    auto id   = notifier.watch(wrapA.id);
+    auto blob = notifier.watchRange(a.blob, 3);
+    notifier.start();
+    EXPECT_TRUE(notifier.isRunning());
+    EXPECT_FALSE(notifier.isHardware(blob));
+
+    auto waitFor = [&](std::size_t idx)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        return cv.wait_for(lock, std::chrono::seconds{5}, [&] 
+        { 
+            return std::find(notified.begin(), notified.end(), idx) != notified.end(); 
+        });
+    };
+
+    wrapA.id = 5;
+    EXPECT_TRUE(waitFor(id));
+    a.blob[2] = 1;
+    EXPECT_TRUE(waitFor(blob));
+
+    // Writes from other threads are reported as well.
+    std::thread{[&] { wrapA.id = 6; }}.join();
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        notified.clear();
+    }
+    std::thread{[&] { wrapA.id = 7; }}.join();
+    EXPECT_TRUE(waitFor(id));
+
+    notifier.stop();
+    EXPECT_FALSE(notifier.isRunning());
+}
+
+// ============================================================================================== //
+// [Function] testing                                                                             //
+// ============================================================================================== //
+
+class FunctionTest : public testing::Test
+{
+protected:
+    static int add(int a, int b) { return a + b; }
+    Function<int(*)(int, int)> wrapAdd{&add};
+    static void magic(int& out) { out = 42; }
+    Function<void(*)(int&)> wrapMagic{&magic};
+
+    static int cVarArgSum(std::size_t numArgs, ...)
+    {
+        va_list va;
+        va_start(va, numArgs);
+
+        int sum = 0;
+        for (std::size_t i = 0; i < numArgs; ++i)
+        {
+            sum += va_arg(va, int);
+        }
+
+        va_end(va);
+        return sum;
+    }
+
+    Function<int(*)(std::size_t, ...)> wrapCVarArgSum{&cVarArgSum};
+public:
+    FunctionTest() = default;
+};
+
+TEST_F(FunctionTest, FunctionTest)
+{
+    EXPECT_EQ(add(1423,  6879), wrapAdd(1423, 6879 ));
+    EXPECT_EQ(add(-1423, 6879), wrapAdd(-1423, 6879));
+
+    int a = 0;
+    wrapMagic(a);
+    EXPECT_EQ(42, a);
+
+    EXPECT_EQ(15, cVarArgSum    (3, 1, 5, 9));
+    EXPECT_EQ(15, wrapCVarArgSum(3, 1, 5, 9));
+}
+
+struct CopyCounted
+{
+    static int copies;
+    int data[32];
+
+    CopyCounted() = default;
+    CopyCounted(const CopyCounted& other) { ++copies; std::copy_n(other.data, 32, data); }
+};
+
+int CopyCounted::copies = 0;
+
+static int sumCounted(CopyCounted counted) 
+{ 
+    return std::accumulate(counted.data, counted.data + 32, 0); 
+}
+static int derefUnique(std::unique_ptr<int> ptr) { return *ptr; }
+static bool isNull(const int* ptr) { return ptr == nullptr; }
+
+TEST_F(FunctionTest, ArgumentPassingTest)
+{
+    static_assert(std::is_same<internal::CallParamT<int>,         int>::value,    "");
+    static_assert(std::is_same<internal::CallParamT<int&>,        int&>::value,   "");
+    static_assert(std::is_same<internal::CallParamT<CopyCounted>, 
+        const CopyCounted&>::value, "");
+    static_assert(std::is_same<internal::CallParamT<std::unique_ptr<int>>, 
+        std::unique_ptr<int>&&>::value, "");
+
+    // Large arguments are copied once, straight into the callee's parameter.
+    CopyCounted counted;
+    std::fill_n(counted.data, 32, 2);
+    Function<int(*)(CopyCounted)> wrapSum{&sumCounted};
+    CopyCounted::copies = 0;
+    EXPECT_EQ(wrapSum(counted), 64);
+    EXPECT_EQ(CopyCounted::copies, 1);
+
+    // Move-only arguments are forwarded.
+    Function<int(*)(std::unique_ptr<int>)> wrapDeref{&derefUnique};
+    EXPECT_EQ(wrapDeref(std::unique_ptr<int>{new int{1337}}), 1337);
+
+    // Null pointer constants still convert.
+    Function<bool(*)(const int*)> wrapIsNull{&isNull};
+    EXPECT_TRUE(wrapIsNull(0));
+    EXPECT_TRUE(wrapIsNull(nullptr));
+}
+
+#if defined(ZYCORE_GNUC) && defined(__x86_64__) \
+    && !defined(ZYCORE_WINDOWS) && !defined(ZYCORE_WIN32)
+
+// Functions of the foreign ABI, vector arguments are passed in registers by both ABIs.
+typedef float Vec4 __attribute__((vector_size(16)));
+
+static float __attribute__((ms_abi)) msDot(Vec4 a, Vec4 b, float scale) 
+{ 
+    auto prod = a * b;
+    return (prod[0] + prod[1] + prod[2] + prod[3]) * scale; 
+}
+
+static int __attribute__((ms_abi)) msMember(void* thiz, int a, int b, int c, int d, int e) 
+{ 
+    return *static_cast<int*>(thiz) + a - b + c - d + e; 
+}
+
+class WrapMsMember : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapMsMember)
+public:
+    using MsMember = int (__attribute__((ms_abi))*)(int, int, int, int, int);
+    MemberFunction<MsMember> member{this, reinterpret_cast<void*>(&msMember)};
+};
+
+TEST_F(FunctionTest, ForeignAbiTest)
+{
+    using MsDot = float (__attribute__((ms_abi))*)(Vec4, Vec4, float);
+    Function<MsDot> wrapDot{&msDot};
+    static_assert(std::is_same<decltype(wrapDot.get()), MsDot>::value, "");
+    Vec4 a = {1.f, 2.f, 3.f, 4.f}, b = {4.f, 3.f, 2.f, 1.f};
+    EXPECT_EQ(40.f, wrapDot(a, b, 2.f));
+
+    // Five arguments after the object exceed the four register arguments of the MS ABI.
+    int base = 100;
+    EXPECT_EQ(103, wrapper_cast<WrapMsMember>(&base).member(1, 2, 3, 4, 5));
+}
+
+#endif
+
+TEST_F(FunctionTest, LazyBindingTest)
+{
+    static std::atomic<int> resolves{0};
+    static std::atomic<bool> available{false};
+    static LazyBinding addBinding{[]() -> void*
+    {
+        ++resolves;
+        if (!available) return nullptr;
+        auto ptr = &FunctionTest::add;
+        return *reinterpret_cast<void**>(&ptr);
+    }};
+
+    Function<int(*)(int, int)> lazyAdd{addBinding};
+    Function<int(*)(int, int), LazyGetter> staticLazyAdd{addBinding};
+    EXPECT_EQ(resolves, 0);
+    EXPECT_FALSE(addBinding.isResolved());
+
+    // Failures are not published.
+    EXPECT_EQ(lazyAdd.get(), nullptr);
+    EXPECT_EQ(resolves, 1);
+    available = true;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> wrong{0};
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&, i]
+        {
+            for (int j = 0; j < 1000; ++j) 
+            {
+                wrong += (i % 2 ? lazyAdd(i, j) : staticLazyAdd(i, j)) != i + j;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(wrong, 0);
+    EXPECT_TRUE(addBinding.isResolved());
+    EXPECT_LE(resolves, 5);
+
+    auto resolved = resolves.load();
+    EXPECT_EQ(lazyAdd(1, 2), 3);
+    EXPECT_EQ(resolves, resolved);
+
+    addBinding.reset();
+    EXPECT_EQ(staticLazyAdd(2, 3), 5);
+    EXPECT_EQ(resolves, resolved + 1);
+}
+
+// ============================================================================================== //
+// [MemberFunction] testing                                                                       //
+// ============================================================================================== //
+
+// We rely on the fact that the compiler handles member-function-pointers as regular function
+// pointers on the hood here (which is not guaranteed by the standard), so let's just perform
+// this test with MSVC for now (where we know that the stuff is implemented this way).
+#ifdef ZYCORE_MSVC
+
+class MemberFunctionTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int c = 42;
+        int __thiscall add(int x, int y) { return x + y + c; }
+        void __thiscall magic(int& out) { out = 42; }
+
+        int __cdecl cVarArgSum(std::size_t numArgs, ...)
+        {
+            va_list va;
+            va_start(va, numArgs);
+
+            int sum = 0;
+            for (std::size_t i = 0; i < numArgs; ++i)
+            {
+                sum += va_arg(va, int);
+            }
+
+            va_end(va);
+            return sum;
+        }
+    };
+
+    struct WrapA : ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+    public:
+        int(A::*pAdd)(int, int){&A::add};
+        MemberFunction<int (__thiscall*)(int, int)> add{this, reinterpret_cast<uintptr_t&>(pAdd)};
+
+        void(A::*pMagic)(int&){&A::magic};
+        MemberFunction<void (__thiscall*)(int&)> magic{this, reinterpret_cast<uintptr_t&>(pMagic)};
+
+        int(A::*pCVarArgSum)(std::size_t, ...){&A::cVarArgSum};
+        MemberFunction<int (__cdecl*)(std::size_t, ...)> cVarArgSum{
+            this, reinterpret_cast<uintptr_t&>(pCVarArgSum)};
+    };
+public:
+    MemberFunctionTest() = default;
+protected:
+    A a;
+    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+};
+
+TEST_F(MemberFunctionTest, FunctionTest)
+{
+    EXPECT_EQ(a.add(1423,  6879), wrapA.add(1423, 6879 ));
+    EXPECT_EQ(a.add(-1423, 6879), wrapA.add(-1423, 6879));
+
+    int x = 0;
+    wrapA.magic(x);
+    EXPECT_EQ(42, x);
+
+    EXPECT_EQ(21, a.cVarArgSum    (5, 1, 6, 7, 8, -1));
+    EXPECT_EQ(21, wrapA.cVarArgSum(5, 1, 6, 7, 8, -1));
+}
+
+#endif // ifdef ZYCORE_MSVC
+
+// ============================================================================================== //
+// [VirtualFunction] testing                                                                      //
+// ============================================================================================== //
+
+// VF-Table layout is highly compiler-dependant, just perform this test with MSVC for now.
+#ifdef ZYCORE_MSVC
+
+class VirtualFunctionTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int c = 42;
+        virtual int add(int x, int y) { return x + y + c; }
+    };
+
+    struct WrapA : ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+    public:
+        VirtualFunction<int (__thiscall*)(int, int)> add{this, 0};
+    };
+public:
+    VirtualFunctionTest() = default;
+protected:
+    A a;
+    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+};
+
+TEST_F(VirtualFunctionTest, FunctionTest)
+{
+    EXPECT_EQ(a.add(1423,  6879), wrapA.add(1423, 6879 ));
+    EXPECT_EQ(a.add(-1423, 6879), wrapA.add(-1423, 6879));
+}
+
+#endif // ifdef ZYCORE_MSVC
+
+// ============================================================================================== //
+// [CachedVirtualFunction] testing                                                                //
+// ============================================================================================== //
+
+// Uses a hand-crafted vftable, so unlike the test above, this works with every compiler.
+class CachedVirtualFunctionTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        void** vftable;
+        int    c;
+    };
+
+    static int add(void* thiz, int x, int y) { return x + y + static_cast<A*>(thiz)->c; }
+    static int sub(void* thiz, int x, int y) { return x - y - static_cast<A*>(thiz)->c; }
+
+    struct WrapA : ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+    public:
+        CachedVirtualFunction<int (*)(int, int)> first {this, 0};
+        CachedVirtualFunction<int (*)(int, int)> second{this, 1};
+    };
+public:
+    CachedVirtualFunctionTest()
+    {
+        vftable[0] = reinterpret_cast<void*>(&add);
+        vftable[1] = reinterpret_cast<void*>(&sub);
+        a.vftable  = vftable;
+        a.c        = 42;
+    }
+protected:
+    void* vftable[2];
+    A     a;
+    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+};
+
+TEST_F(CachedVirtualFunctionTest, CachedVirtualFunctionTest)
+{
+    EXPECT_EQ(add(&a, 1423, 6879), wrapA.first (1423, 6879));
+    EXPECT_EQ(sub(&a, 1423, 6879), wrapA.second(1423, 6879));
+
+    // Swap the entries, cached targets are used until the functions are refreshed.
+    std::swap(vftable[0], vftable[1]);
+    EXPECT_EQ(add(&a, 1423, 6879), wrapA.first (1423, 6879));
+
+    wrapA.first.refresh();
+    EXPECT_EQ(sub(&a, 1423, 6879), wrapA.first (1423, 6879));
+    EXPECT_EQ(sub(&a, 1423, 6879), wrapA.second(1423, 6879));
+
+    std::swap(vftable[0], vftable[1]);
+    refreshVirtualFunctions(wrapA.first, wrapA.second);
+    EXPECT_EQ(add(&a, 1423, 6879), wrapA.first (1423, 6879));
+    EXPECT_EQ(sub(&a, 1423, 6879), wrapA.second(1423, 6879));
+}
+
+// ============================================================================================== //
+// [BaseSubobject] testing                                                                        //
+// ============================================================================================== //
+
+// Mimics a class with two polymorphic bases using hand-crafted vftables.
+class BaseSubobjectTest : public testing::Test
+{
+protected:
+    struct FlyerPart
+    {
+        void** vftable;
+        int    wings;
+    };
+
+    struct Bird
+    {
+        void**    vftable;
+        int       legs;
+        FlyerPart flyer;
+        int       featherCount;
+    };
+
+    // Secondary vftable entries expect `this` to point to the base subobject.
+    static int flap(void* thiz, int times) 
+    { 
+        return static_cast<FlyerPart*>(thiz)->wings * times; 
+    }
+
+    class WrapFlyer : public AdvancedClassWrapper<sizeof(FlyerPart)>
+    {
+        REMODEL_ADV_WRAPPER(WrapFlyer)
+    public:
+        Field<int> wings{this, offsetof(FlyerPart, wings)};
+        CachedVirtualFunction<int (*)(int)> flap{this, 0};
+    };
+
+    class WrapBird : public AdvancedClassWrapper<sizeof(Bird)>
+    {
+        REMODEL_ADV_WRAPPER(WrapBird)
+    public:
+        Field<int> legs{this, offsetof(Bird, legs)};
+        BaseSubobject<WrapFlyer, offsetof(Bird, flyer)> flyer{this};
+    };
+protected:
+    BaseSubobjectTest()
+    {
+        flyerVftable[0] = reinterpret_cast<void*>(&flap);
+        for (int i = 0; i < 2; ++i) birds[i] = Bird{nullptr, 2, {flyerVftable, 2 + i}, 0};
+    }
+protected:
+    void* flyerVftable[1];
+    Bird  birds[2];
+};
+
+TEST_F(BaseSubobjectTest, CallTest)
+{
+    auto bird = wrapper_cast<WrapBird>(&birds[0]);
+    EXPECT_EQ(&birds[0].flyer, bird.flyer.addressOfObj());
+    EXPECT_EQ(&birds[0].flyer, bird.flyer->addressOfObj());
+    EXPECT_EQ(2, bird.flyer->wings);
+    EXPECT_EQ(6, bird.flyer->flap(3));
+
+    // The base wrapper follows rebinding of the derived one, also in copies.
+    bird.ClassWrapper::rebind(&birds[1]);
+    EXPECT_EQ(9, bird.flyer->flap(3));
+    auto copy = bird;
+    copy.flyer->wings = 5;
+    EXPECT_EQ(5, birds[1].flyer.wings);
+    EXPECT_EQ(&birds[1].flyer, copy.flyer.get().addressOfObj());
+}
+
+TEST_F(BaseSubobjectTest, CastTest)
+{
+    auto bird = wrapper_cast<WrapBird>(&birds[1]);
+    WrapFlyer flyer = upcast(bird, &WrapBird::flyer);
+    EXPECT_EQ(&birds[1].flyer, flyer.addressOfObj());
+
+    WrapBird same = downcast(flyer, &WrapBird::flyer);
+    EXPECT_EQ(&birds[1], same.addressOfObj());
+    EXPECT_EQ(2, same.legs);
+
+    using Decl = decltype(bird.flyer);
+    EXPECT_EQ(&birds[0].flyer, Decl::toBase(&birds[0]));
+    EXPECT_EQ(&birds[0], Decl::toDerived(&birds[0].flyer));
+    EXPECT_EQ(nullptr, Decl::toDerived(nullptr));
+}
+
+// ============================================================================================== //
+// [instrument] testing                                                                           //
+// ============================================================================================== //
+
+class InstrumentTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        void** vftable;
+        int    x;
+    };
+
+    static int virtualTwice(void* thiz, int y) { return 2 * y + static_cast<A*>(thiz)->x; }
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        StaticField<int, offsetof(A, x)> x{this};
+        VirtualFunction<int (*)(int)> twice{this, 0};
+    };
+protected:
+    /// Looks up a member by offset, or a declaration without parent by line.
+    static instrument::SiteStats stats(instrument::SiteKind kind, std::ptrdiff_t member, 
+        unsigned line = 0)
+    {
+        for (const auto& cur : instrument::collectStats())
+        {
+            if (cur.kind == kind && cur.member == member && (!line || cur.site.line == line)
+                && !std::strcmp(cur.site.file, __FILE__))
+            {
+                return cur;
+            }
+        }
+        return instrument::SiteStats{{nullptr, 0}, kind, member, 0, 0, 0};
+    }
+
+    template<typename MemberT>
+    static std::ptrdiff_t memberOffset(const WrapA& wrapper, const MemberT& member)
+    {
+        return reinterpret_cast<const char*>(std::addressof(member)) 
+            - reinterpret_cast<const char*>(std::addressof(wrapper));
+    }
+};
+
+#ifdef REMODEL_INSTRUMENT
+
+int instrumentedAdd(int x, int y)
+{
+    return x + y;
+}
+
+TEST_F(InstrumentTest, CountTest)
+{
+    instrument::resetStats();
+    instrument::setTimingEnabled(true);
+
+    void* vftable[] = {reinterpret_cast<void*>(&virtualTwice)};
+    A a{vftable, 1};
+    auto wrapA = wrapper_cast<WrapA>(&a);
+    wrapA.x = 5;
+    EXPECT_EQ(wrapA.x + 0, 5);
+    EXPECT_EQ(wrapA.twice(2), 9);
+
+    const unsigned kFunctionLine = __LINE__ + 1;
+    Function<int (*)(int, int)> add{&instrumentedAdd};
+    std::thread{[&]
+    {
+        auto wrapOther = wrapper_cast<WrapA>(&a);
+        for (int i = 0; i < 10; ++i) wrapOther.x += add(i, 0);
+    }}.join();
+
+    auto xOffs = memberOffset(wrapA, wrapA.x), twiceOffs = memberOffset(wrapA, wrapA.twice);
+    auto field = stats(instrument::SiteKind::Field, xOffs);
+    EXPECT_EQ(field.accesses, 12u);
+    EXPECT_EQ(field.timedCalls, 0u);
+    auto twice = stats(instrument::SiteKind::Function, twiceOffs);
+    EXPECT_EQ(twice.accesses, 1u);
+    EXPECT_EQ(twice.timedCalls, 1u);
+    EXPECT_EQ(stats(instrument::SiteKind::Function, -1, kFunctionLine).accesses, 10u);
+
+    instrument::setTimingEnabled(false);
+    wrapA.twice(0);
+    EXPECT_EQ(stats(instrument::SiteKind::Function, twiceOffs).timedCalls, 1u);
+
+    instrument::resetStats();
+    EXPECT_EQ(stats(instrument::SiteKind::Field, xOffs).accesses, 0u);
+}
+
+#else
+
+TEST_F(InstrumentTest, DisabledTest)
+{
+    void* vftable[] = {reinterpret_cast<void*>(&virtualTwice)};
+    A a{vftable, 1};
+    auto wrapA = wrapper_cast<WrapA>(&a);
+    EXPECT_EQ(wrapA.twice(wrapA.x), 3);
+    EXPECT_TRUE(instrument::collectStats().empty());
+    EXPECT_EQ(stats(instrument::SiteKind::Field, memberOffset(wrapA, wrapA.x)).accesses, 0u);
+}
+
+#endif // ifdef REMODEL_INSTRUMENT
+
+// ============================================================================================== //
+// [trace] testing                                                                                //
+// ============================================================================================== //
+
+int tracedAdd(int x, int y)
+{
+    return x + y;
+}
+
+class TraceTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        void** vftable;
+        int    x;
+    };
+
+    static int virtualTwice(void* thiz, int y) { return 2 * y + static_cast<A*>(thiz)->x; }
+
+    class WrapA : public AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        VirtualFunction<int (*)(int)> twice{this, 0};
+    };
+protected:
+    void SetUp() override { trace::drain([](const trace::TraceRecord*, std::size_t) {}); }
+    void TearDown() override { trace::setEnabled(false); }
+
+    const uintptr_t kTracedAdd 
+        = reinterpret_cast<uintptr_t>(trace::internal::codeAddress(&tracedAdd));
+
+    static std::vector<trace::TraceRecord> drainAll()
+    {
+        std::vector<trace::TraceRecord> records;
+        trace::drain([&](const trace::TraceRecord* first, std::size_t count)
+        {
+            records.insert(records.end(), first, first + count);
+        });
+        return records;
+    }
+};
+
+TEST_F(TraceTest, EmitTest)
+{
+    trace::emit(trace::CallKind::User, &tracedAdd, 1, 2);
+    EXPECT_TRUE(drainAll().empty());
+
+    trace::setEnabled(true);
+    EXPECT_TRUE(trace::isEnabled());
+    std::string nonTrivial = "x";
+    trace::emit(trace::CallKind::User, &tracedAdd, 1, -2, nonTrivial, 1, 2, 3, 4);
+    std::thread{[] { trace::emit(trace::CallKind::User, nullptr, 0x1234); }}.join();
+    trace::setEnabled(false);
+    trace::emit(trace::CallKind::User, &tracedAdd);
+
+    auto records = drainAll();
+    ASSERT_EQ(records.size(), 2u);
+    std::sort(records.begin(), records.end(), 
+        [](const trace::TraceRecord& a, const trace::TraceRecord& b) 
+        { 
+            return a.argCount > b.argCount; 
+        });
+
+    const auto& local = records[0];
+    EXPECT_EQ(local.kind, trace::CallKind::User);
+    EXPECT_EQ(local.target, kTracedAdd);
+    EXPECT_EQ(local.argCount, 5u);
+    EXPECT_EQ(local.args[0], 1u);
+    EXPECT_EQ(static_cast<int>(local.args[1]), -2);
+    EXPECT_EQ(local.args[2], 0u);
+    EXPECT_EQ(local.args[4], 2u);
+    EXPECT_EQ(records[1].argCount, 1u);
+    EXPECT_EQ(records[1].args[0], 0x1234u);
+    EXPECT_EQ(records[1].target, 0u);
+    EXPECT_NE(records[1].thread, local.thread);
+    EXPECT_NE(local.timestamp, 0u);
+    EXPECT_TRUE(drainAll().empty());
+}
+
+TEST_F(TraceTest, OverflowTest)
+{
+    trace::setEnabled(true);
+    auto dropped = trace::droppedRecords();
+    const std::size_t kCapacity = trace::internal::TraceRing::kCapacity;
+    for (std::size_t i = 0; i < kCapacity + 10; ++i)
+    {
+        trace::emit(trace::CallKind::User, nullptr, i);
+    }
+    EXPECT_EQ(trace::droppedRecords(), dropped + 10);
+
+    auto records = drainAll();
+    ASSERT_EQ(records.size(), kCapacity);
+    EXPECT_EQ(records.front().args[0], 0u);
+    EXPECT_EQ(records.back().args[0], kCapacity - 1);
+
+    // Wrapping around the end of the ring.
+    for (std::size_t i = 0; i < kCapacity / 2 + 1; ++i)
+    {
+        trace::emit(trace::CallKind::User, nullptr, i);
+    }
+    trace::drain([](const trace::TraceRecord*, std::size_t) {});
+    for (std::size_t i = 0; i < kCapacity; ++i) trace::emit(trace::CallKind::User, nullptr, i);
+    records = drainAll();
+    ASSERT_EQ(records.size(), kCapacity);
+    for (std::size_t i = 0; i < kCapacity; ++i) EXPECT_EQ(records[i].args[0], i);
+    EXPECT_EQ(trace::droppedRecords(), dropped + 10);
+}
+
+TEST_F(TraceTest, WriterTest)
+{
+    const char* kPath = "remodel_test.trace";
+    {
+        trace::TraceWriter writer{kPath, std::chrono::milliseconds{1}};
+        ASSERT_TRUE(writer.isOk());
+        trace::setEnabled(true);
+        std::thread{[]
+        {
+            for (int i = 0; i < 100; ++i) trace::emit(trace::CallKind::User, 1u, i);
+        }}.join();
+        for (int i = 0; i < 50; ++i) trace::emit(trace::CallKind::User, &tracedAdd, i);
+        trace::setEnabled(false);
+        EXPECT_TRUE(writer.stop());
+        EXPECT_EQ(writer.written(), 150u);
+    }
+
+    auto file = std::fopen(kPath, "rb");
+    ASSERT_TRUE(file != nullptr);
+    trace::TraceFileHeader header;
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1, file), 1u);
+    EXPECT_EQ(std::memcmp(header.magic, trace::kTraceFileMagic, sizeof(header.magic)), 0);
+    EXPECT_EQ(header.version, 1u);
+    EXPECT_EQ(header.recordSize, sizeof(trace::TraceRecord));
+    std::vector<trace::TraceRecord> records(200);
+    EXPECT_EQ(std::fread(records.data(), sizeof(trace::TraceRecord), records.size(), file), 150u);
+    std::fclose(file);
+    std::remove(kPath);
+
+    EXPECT_FALSE(trace::TraceWriter{"/nonexistent/remodel.trace"}.isOk());
+}
+
+#ifdef REMODEL_TRACE
+
+TEST_F(TraceTest, WrapperTest)
+{
+    void* vftable[] = {reinterpret_cast<void*>(&virtualTwice)};
+    A a{vftable, 1};
+    auto wrapA = wrapper_cast<WrapA>(&a);
+    Function<int (*)(int, int)> add{&tracedAdd};
+
+    EXPECT_EQ(add(1, 2), 3);
+    EXPECT_TRUE(drainAll().empty());
+    trace::setEnabled(true);
+    EXPECT_EQ(add(3, 4), 7);
+    EXPECT_EQ(wrapA.twice(5), 11);
+    trace::setEnabled(false);
+
+    auto records = drainAll();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].kind, trace::CallKind::Function);
+    EXPECT_EQ(records[0].target, kTracedAdd);
+    EXPECT_EQ(records[0].argCount, 2u);
+    EXPECT_EQ(records[0].args[1], 4u);
+    EXPECT_EQ(records[1].kind, trace::CallKind::MemberFunction);
+    EXPECT_EQ(records[1].args[0], reinterpret_cast<uintptr_t>(&a));
+    EXPECT_EQ(records[1].args[1], 5u);
+}
+
+#endif // ifdef REMODEL_TRACE
+
+// ============================================================================================== //
+// [StateRecorder] testing                                                                        //
+// ============================================================================================== //
+
+TEST(StateRecorderTest, RoundTripTest)
+{
+    struct Unit
+    {
+        float    x, y, z;
+        uint32_t health;
+    };
+
+    const char* kPath = "remodel_test.rec";
+    std::vector<int32_t> grid(1024);
+    std::iota(grid.begin(), grid.end(), 0);
+    Unit unit{1.f, 2.f, 3.f, 100};
+    std::vector<std::vector<uint8_t>> expected;
+    {
+        StateRecorder recorder{kPath, 512, 100, std::chrono::milliseconds{1}};
+        recorder.add(grid.data(), grid.size() * sizeof(int32_t));
+        recorder.add(&unit, sizeof(unit));
+        ASSERT_TRUE(recorder.start());
+
+        for (uint32_t tick = 0; tick < 300; ++tick)
+        {
+            unit.x += 0.5f;
+            if (tick % 7 == 0) --unit.health;
+            for (uint32_t i = 0; i < 4; ++i) grid[(tick * 37 + i * 101) % grid.size()] += tick;
+            ASSERT_TRUE(recorder.capture(tick * 16));
+
+            std::vector<uint8_t> state(grid.size() * sizeof(int32_t) + sizeof(unit));
+            std::memcpy(state.data(), grid.data(), grid.size() * sizeof(int32_t));
+            std::memcpy(state.data() + grid.size() * sizeof(int32_t), &unit, sizeof(unit));
+            expected.push_back(std::move(state));
+        }
+        EXPECT_TRUE(recorder.stop());
+        EXPECT_FALSE(recorder.capture(0));
+        EXPECT_EQ(300u, recorder.recorded());
+        EXPECT_EQ(0u, recorder.dropped());
+        EXPECT_LT(recorder.writtenBytes() * 10, recorder.rawBytes());
+    }
+
+    StateReplay replay;
+    ASSERT_TRUE(replay.open(kPath));
+    ASSERT_EQ(2u, replay.objectCount());
+    EXPECT_EQ(sizeof(Unit), replay.objectSize(1));
+    for (uint32_t tick = 0; tick < 300; ++tick)
+    {
+        ASSERT_TRUE(replay.next());
+        EXPECT_EQ(tick * 16u, replay.tick());
+        EXPECT_EQ(tick % 100 == 0, replay.isKeyframe());
+        ASSERT_EQ(0, std::memcmp(expected[tick].data(), replay.object(0), replay.objectSize(0)));
+        ASSERT_EQ(0, std::memcmp(expected[tick].data() + replay.objectSize(0), replay.object(1), 
+            sizeof(Unit)));
+    }
+    EXPECT_FALSE(replay.next());
+    replay.close();
+    std::remove(kPath);
+
+    // Frames are dropped while the encoder lags behind.
+    {
+        StateRecorder recorder{kPath, 2, 100, std::chrono::hours{1}};
+        recorder.add(&unit, sizeof(unit));
+        EXPECT_FALSE(recorder.capture(0));
+        ASSERT_TRUE(recorder.start());
+        EXPECT_TRUE(recorder.capture(1));
+        EXPECT_TRUE(recorder.capture(2));
+        EXPECT_FALSE(recorder.capture(3));
+        EXPECT_TRUE(recorder.stop());
+        EXPECT_EQ(2u, recorder.recorded());
+        EXPECT_EQ(1u, recorder.dropped());
+    }
+    std::remove(kPath);
+
+    EXPECT_FALSE(StateRecorder{"/nonexistent/remodel.rec"}.isOk());
+    EXPECT_FALSE(replay.open("/nonexistent/remodel.rec"));
+}
+
+TEST(StateRecorderTest, CompressionTest)
+{
+    std::vector<uint8_t> input;
+    for (int i = 0; i < 5000; ++i) input.push_back(static_cast<uint8_t>(i % 40 ? i % 40 : i));
+    for (int i = 0; i < 300; ++i) input.push_back(static_cast<uint8_t>(i * 7919 >> 3));
+
+    std::vector<uint32_t> table(internal::kLzHashSize);
+    for (std::size_t size : {0u, 1u, 12u, 13u, 100u, 5300u})
+    {
+        std::vector<uint8_t> packed(internal::lzBound(size));
+        auto packedSize = internal::lzCompress(input.data(), size, packed.data(), table.data());
+        ASSERT_LE(packedSize, packed.size());
+        std::vector<uint8_t> output(size);
+        ASSERT_TRUE(internal::lzDecompress(packed.data(), packedSize, output.data(), size));
+        EXPECT_TRUE(std::equal(output.begin(), output.end(), input.begin()));
+        if (size == 5300)
+        {
+            EXPECT_LT(packedSize, size / 4);
+        }
+        if (size)
+        {
+            EXPECT_FALSE(internal::lzDecompress(packed.data(), packedSize, output.data(), 
+                size - 1));
+        }
+    }
+}
+
+// ============================================================================================== //
+// [TaskQueue] testing                                                                            //
+// ============================================================================================== //
+
+class TaskQueueTest : public testing::Test
+{
+protected:
+    struct Stable
+    {
+        int horses[8];
+        int numHorses;
+    };
+
+    static void addHorseImpl(void* thiz, int id)
+    {
+        auto stable = static_cast<Stable*>(thiz);
+        stable->horses[stable->numHorses++] = id;
+    }
+
+    static void renameImpl(void* thiz, std::string name, int idx)
+    {
+        static_cast<Stable*>(thiz)->horses[idx] = static_cast<int>(name.size());
+    }
+
+    static int countImpl(void* thiz) { return static_cast<Stable*>(thiz)->numHorses; }
+    static int add(int a, int b) { return a + b; }
+
+    struct WrapStable : ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapStable)
+    public:
+        MemberFunction<void (*)(int)> addHorse{
+            this, reinterpret_cast<uintptr_t>(&addHorseImpl)};
+        MemberFunction<void (*)(std::string, int)> rename{
+            this, reinterpret_cast<uintptr_t>(&renameImpl)};
+        MemberFunction<int (*)()> count{
+            this, reinterpret_cast<uintptr_t>(&countImpl)};
+    };
+
+    static void countDone(void* context) { ++*static_cast<int*>(context); }
+
+    Function<int (*)(int, int)> wrapAdd{&add};
+};
+
+TEST_F(TaskQueueTest, MemberCallTest)
+{
+    Stable stable{};
+    auto wrapper = wrapper_cast<WrapStable>(&stable);
+
+    TaskQueue queue{4};
+    EXPECT_TRUE(queue.postCall(wrapper, &WrapStable::addHorse, 7));
+    EXPECT_TRUE(queue.postCall(wrapper, &WrapStable::addHorse, 9));
+    EXPECT_TRUE(queue.postCall(wrapper, &WrapStable::rename, std::string{"Bucephalus"}, 0));
+    EXPECT_EQ(0, stable.numHorses);
+
+    EXPECT_EQ(3u, queue.drain());
+    EXPECT_EQ(2, stable.numHorses);
+    EXPECT_EQ(10, stable.horses[0]);
+    EXPECT_EQ(9, stable.horses[1]);
+    EXPECT_EQ(0u, queue.drain());
+}
+
+TEST_F(TaskQueueTest, CapacityTest)
+{
+    TaskQueue queue{4};
+    int sum = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.post([&sum, i] { sum += i; }));
+    }
+    EXPECT_FALSE(queue.post([&sum] { sum += 100; }));
+
+    // Partial drains free slots for the next lap.
+    EXPECT_EQ(2u, queue.drain(2));
+    EXPECT_TRUE(queue.post([&sum] { sum += 10; }));
+    EXPECT_EQ(3u, queue.drain());
+    EXPECT_EQ(16, sum);
+}
+
+TEST_F(TaskQueueTest, CapacityRoundingTest)
+{
+    for (std::size_t requested : {0, 1, 2, 5, 100})
+    {
+        TaskQueue queue{requested};
+        auto capacity = queue.capacity();
+        EXPECT_GE(capacity, std::max<std::size_t>(requested, 2));
+        EXPECT_EQ(0u, capacity & (capacity - 1));
+
+        int count = 0;
+        for (std::size_t i = 0; i < capacity; ++i) EXPECT_TRUE(queue.post([&count] { ++count; }));
+        EXPECT_FALSE(queue.post([&count] { ++count; }));
+        EXPECT_EQ(capacity, queue.drain());
+        EXPECT_EQ(static_cast<int>(capacity), count);
+    }
+}
+
+TEST_F(TaskQueueTest, StorageTest)
+{
+    auto token = std::make_shared<int>(0);
+    {
+        TaskQueue queue{8};
+
+        // Exceeds the inline storage, stored on the heap.
+        std::array<uint64_t, 16> big{};
+        big[15] = 5;
+        EXPECT_TRUE(queue.post([token, big] { *token += static_cast<int>(big[15]); }));
+        EXPECT_TRUE(queue.post([token] { *token += 1; }));
+        EXPECT_EQ(3, token.use_count());
+
+        EXPECT_EQ(1u, queue.drain(1));
+        EXPECT_EQ(5, *token);
+        EXPECT_EQ(2, token.use_count());
+
+        // Pending tasks are destroyed without running.
+        EXPECT_TRUE(queue.post([token] { *token += 100; }));
+    }
+    EXPECT_EQ(5, *token);
+    EXPECT_EQ(1, token.use_count());
+}
+
+TEST_F(TaskQueueTest, ProducerThreadsTest)
+{
+    const int kThreads = 4;
+    const int kPerThread = 10000;
+
+    TaskQueue queue{256};
+    long long sum = 0;
+    int lastSeen[kThreads] = {};
+    bool ordered = true;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&, t]
+        {
+            for (int i = 1; i <= kPerThread; ++i)
+            {
+                while (!queue.post([&, t, i] 
+                {
+                    sum += i;
+                    ordered = ordered && lastSeen[t] == i - 1;
+                    lastSeen[t] = i;
+                })) 
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::size_t ran = 0;
+    while (ran < std::size_t{kThreads * kPerThread})
+    {
+        ran += queue.drain(64);
+    }
+    for (auto& producer : producers) producer.join();
+
+    EXPECT_EQ(0u, queue.drain());
+    EXPECT_EQ(static_cast<long long>(kThreads) * kPerThread * (kPerThread + 1) / 2, sum);
+    EXPECT_TRUE(ordered);
+}
+
+TEST_F(TaskQueueTest, AsyncCallTest)
+{
+    Stable stable{};
+    auto wrapper = wrapper_cast<WrapStable>(&stable);
+
+    TaskQueue target;
+    ResumeQueue resume;
+    int done = 0;
+
+    auto add = asyncMemberCall(target, resume, wrapper, &WrapStable::addHorse, 3);
+    auto count = asyncMemberCall(target, resume, wrapper, &WrapStable::count);
+    auto sum = asyncCall(target, resume, wrapAdd, 20, 22);
+    EXPECT_TRUE(add.start(&countDone, &done));
+    EXPECT_TRUE(count.start(&countDone, &done));
+    EXPECT_TRUE(sum.start(&countDone, &done));
+
+    EXPECT_EQ(0u, resume.drain());
+    EXPECT_EQ(3u, target.drain());
+    EXPECT_EQ(0, done);
+    EXPECT_EQ(3u, resume.drain());
+    EXPECT_EQ(3, done);
+
+    EXPECT_TRUE(add.result());
+    ASSERT_TRUE(count.result());
+    EXPECT_EQ(1, count.result().value());
+    ASSERT_TRUE(sum.result());
+    EXPECT_EQ(42, sum.result().value());
+
+    // Posting fails without running the continuation once the target queue is full.
+    TaskQueue full{2};
+    EXPECT_TRUE(full.post([] {}));
+    EXPECT_TRUE(full.post([] {}));
+    auto rejected = asyncCall(full, resume, wrapAdd, 1, 2);
+    EXPECT_FALSE(rejected.start(&countDone, &done));
+    EXPECT_EQ(2u, full.drain());
+    EXPECT_EQ(0u, resume.drain());
+    EXPECT_FALSE(rejected.result());
+}
+
+TEST_F(TaskQueueTest, AsyncThreadTest)
+{
+    const int kCalls = 2000;
+
+    TaskQueue target{64};
+    ResumeQueue resume;
+    std::atomic<bool> stop{false};
+    std::thread mainThread{[&]
+    {
+        while (!stop.load()) 
+        {
+            if (!target.drain()) std::this_thread::yield();
+        }
+    }};
+
+    std::vector<decltype(asyncCall(target, resume, wrapAdd, 0, 0))> calls;
+    calls.reserve(kCalls);
+    int done = 0;
+    for (int i = 0; i < kCalls; ++i)
+    {
+        calls.push_back(asyncCall(target, resume, wrapAdd, i, 1));
+        while (!calls.back().start(&countDone, &done)) resume.drain();
+    }
+    while (done < kCalls) 
+    {
+        if (!resume.drain()) std::this_thread::yield();
+    }
+    stop = true;
+    mainThread.join();
+
+    long long sum = 0;
+    for (auto& call : calls) sum += call.result().valueOr(0);
+    EXPECT_EQ(static_cast<long long>(kCalls) * (kCalls + 1) / 2, sum);
+}
+
+#ifdef REMODEL_HAS_COROUTINES
+
+TEST_F(TaskQueueTest, CoroutineTest)
+{
+    Stable stable{};
+    auto wrapper = wrapper_cast<WrapStable>(&stable);
+
+    TaskQueue target;
+    ResumeQueue resume;
+    int result = 0;
+    auto script = [&]() -> AsyncTask
+    {
+        co_await asyncMemberCall(target, resume, wrapper, &WrapStable::addHorse, 5);
+        auto count = co_await asyncMemberCall(target, resume, wrapper, &WrapStable::count);
+        auto sum = co_await asyncCall(target, resume, wrapAdd, count.valueOr(0), 41);
+        result = sum.valueOr(0);
+    };
+
+    script();
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(0, result);
+        EXPECT_EQ(1u, target.drain());
+        EXPECT_EQ(1u, resume.drain());
+    }
+    EXPECT_EQ(42, result);
+}
+
+#endif // ifdef REMODEL_HAS_COROUTINES
+
+TEST(FramePoolTest, ReuseTest)
+{
+    auto block = FramePool::allocate(100);
+    FramePool::deallocate(block, 100);
+    EXPECT_EQ(block, FramePool::allocate(120));
+
+    // Other size classes and oversized blocks don't share cached blocks.
+    auto small = FramePool::allocate(16);
+    auto big = FramePool::allocate(1 << 20);
+    EXPECT_NE(block, small);
+    FramePool::deallocate(small, 16);
+    FramePool::deallocate(big, 1 << 20);
+    FramePool::deallocate(block, 120);
+    EXPECT_EQ(small, FramePool::allocate(64));
+    FramePool::deallocate(small, 64);
+}
+
+// ============================================================================================== //
+// [MyWrapperType::Instantiable] testing                                                          //
+// ============================================================================================== //
+
+int* hackyGlobalPtr = nullptr;
+
+class InstantiableTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        int    a;
+        float  b;
+        double c;
+    };
+
+    struct WrapA
+        : AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapA)
+    public:
+        Field<int>    a{this, offsetof(A, a)};
+        Field<float>  b{this, offsetof(A, b)};
+        Field<double> c{this, offsetof(A, c)};
+    };
+
+    struct WrapACustomCtor
+        : AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapACustomCtor)
+    public:
+        Field<int>    a{this, offsetof(A, a)};
+        Field<float>  b{this, offsetof(A, b)};
+        Field<double> c{this, offsetof(A, c)};
+    
+        void construct(int a_, float b_, double c_)
+        {
+            a = a_;
+            b = b_;
+            c = c_;
+        }
+    };
+
+    struct WrapACustomDtor
         : AdvancedClassWrapper<sizeof(A)>
     {
         REMODEL_ADV_WRAPPER(WrapACustomDtor)
@@ -1022,10 +8297,38 @@ protected:
     public:
         Function<void(*)()> destruct{&pseudoDtor};
     };
+
+    static std::vector<int> destructed;
+
+    struct alignas(64) Aligned
+    {
+        float values[16];
+    };
+
+    struct WrapAligned
+        : AdvancedClassWrapper<sizeof(Aligned), alignof(Aligned)>
+    {
+        REMODEL_ADV_WRAPPER(WrapAligned)
+    public:
+        Field<float> first{this, 0};
+    };
+
+    struct WrapACounted
+        : AdvancedClassWrapper<sizeof(A)>
+    {
+        REMODEL_ADV_WRAPPER(WrapACounted)
+    public:
+        Field<int> a{this, offsetof(A, a)};
+
+        void construct(int a_) { a = a_; }
+        void destruct() { destructed.push_back(a); }
+    };
 protected:
     InstantiableTest() = default;
 };
 
+std::vector<int> InstantiableTest::destructed;
+
 TEST_F(InstantiableTest, InstantiableTest)
 {
     WrapA::Instantiable simple;
@@ -1047,6 +8350,110 @@ TEST_F(InstantiableTest, InstantiableTest)
     EXPECT_EQ(42, x);
 }
 
+TEST_F(InstantiableTest, PoolTest)
+{
+    {
+        InstantiablePool<WrapACustomCtor> pool{64};
+        auto first = pool.createMany(1000, 42, 43.f, 44.);
+        EXPECT_EQ(first, 0u);
+        EXPECT_EQ(pool.size(), 1000u);
+        EXPECT_EQ(pool.capacity(), 1024u);
+        auto& single = pool.create(1, 2.f, 3.);
+        EXPECT_EQ(pool[1000].addressOfObj(), single.addressOfObj());
+
+        for (std::size_t i = 0; i < pool.size(); ++i)
+        {
+            EXPECT_EQ(pool[i].a, i < 1000 ? 42 : 1);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(pool[i].addressOfObj()) % alignof(void*), 0u);
+        }
+
+        // Addresses are stable across growth.
+        auto obj = pool[10].addressOfObj();
+        pool.createMany(5000, 0, 0.f, 0.);
+        EXPECT_EQ(pool[10].addressOfObj(), obj);
+        EXPECT_EQ(static_cast<A*>(obj)->c, 44.);
+    }
+
+    destructed.clear();
+    {
+        InstantiablePool<WrapACounted> pool{2};
+        pool.createMany(3, 7);
+        pool.create(8);
+        pool.clear();
+        EXPECT_EQ(destructed, (std::vector<int>{8, 7, 7, 7}));
+        EXPECT_EQ(pool.size(), 0u);
+        EXPECT_EQ(pool.capacity(), 4u);
+
+        pool.create(9);
+    }
+    EXPECT_EQ(destructed.back(), 9);
+}
+
+TEST_F(InstantiableTest, AlignmentTest)
+{
+    static_assert(WrapAligned::kObjAlign == 64, "");
+    static_assert(alignof(WrapAligned::Weak) == 64, "");
+    static_assert(sizeof(WrapAligned::Weak) == sizeof(Aligned), "");
+    static_assert(WrapA::kObjAlign == 1, "");
+
+    auto isAligned = [](const void* ptr) { return reinterpret_cast<uintptr_t>(ptr) % 64 == 0; };
+
+    WrapAligned::Instantiable onStack;
+    EXPECT_TRUE(isAligned(onStack.addressOfObj()));
+
+    std::vector<std::unique_ptr<WrapAligned::Instantiable>> onHeap;
+    for (int i = 0; i < 16; ++i)
+    {
+        onHeap.emplace_back(new WrapAligned::Instantiable);
+        EXPECT_TRUE(isAligned(onHeap.back()->addressOfObj()));
+        onHeap.back()->first = 1.f;
+    }
+
+    InstantiablePool<WrapAligned> pool{3};
+    pool.createMany(10);
+    for (std::size_t i = 0; i < pool.size(); ++i)
+    {
+        EXPECT_TRUE(isAligned(pool[i].addressOfObj()));
+    }
+}
+
+TEST_F(InstantiableTest, CompactTest)
+{
+    static_assert(sizeof(WrapA::Compact) == sizeof(A), "");
+    static_assert(sizeof(WrapAligned::Compact) == sizeof(Aligned), "");
+    static_assert(alignof(WrapAligned::Compact) == alignof(Aligned), "");
+
+    WrapACustomCtor::Compact compact{42, 43.f, 44.};
+    auto* raw = static_cast<A*>(compact.addressOfObj());
+    EXPECT_EQ(raw->a, 42);
+    EXPECT_EQ(raw->b, 43.f);
+    EXPECT_EQ(compact.wrapper().c, 44.);
+    compact.wrapper().a = 7;
+    EXPECT_EQ(raw->a, 7);
+    EXPECT_EQ(compact.weakPtr()->toStrong().a, 7);
+
+    // Arrays are laid out like arrays of the wrapped class.
+    std::unique_ptr<WrapA::Compact[]> array{new WrapA::Compact[8]};
+    EXPECT_EQ(static_cast<uint8_t*>(array[1].addressOfObj()) 
+        - static_cast<uint8_t*>(array[0].addressOfObj()), 
+        static_cast<std::ptrdiff_t>(sizeof(A)));
+    std::unique_ptr<WrapAligned::Compact[]> aligned{new WrapAligned::Compact[3]};
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned[1].addressOfObj()) % 64, 0u);
+
+    destructed.clear();
+    {
+        WrapACounted::Compact counted{5};
+        EXPECT_EQ(counted.wrapper().a, 5);
+    }
+    EXPECT_EQ(destructed, std::vector<int>{5});
+
+    int x = 0;
+    {
+        WrapACustomWrappedCtor::Compact wrappedCtor{x};
+        EXPECT_EQ(42, x);
+    }
+}
+
 TEST_F(InstantiableTest, WrappedFunctionUsage)
 {
     int a = 0;
@@ -1062,6 +8469,867 @@ TEST_F(InstantiableTest, WrappedFunctionUsage)
     EXPECT_EQ(42, a);
 }
 
+static std::atomic<int> targetHeapAllocs{0};
+static std::atomic<int> targetHeapFrees{0};
+
+static void* targetHeapMalloc(std::size_t size)
+{
+    ++targetHeapAllocs;
+    return std::malloc(size);
+}
+
+static void targetHeapFree(void* ptr)
+{
+    ++targetHeapFrees;
+    std::free(ptr);
+}
+
+TEST_F(InstantiableTest, TargetHeapTest)
+{
+    targetHeapAllocs = targetHeapFrees = 0;
+    auto heap = makeTargetHeap(Function<void* (*)(std::size_t)>{&targetHeapMalloc}, 
+        Function<void (*)(void*)>{&targetHeapFree}, sizeof(A), 4);
+    using Heap = decltype(heap)::element_type;
+
+    destructed.clear();
+    {
+        TargetInstantiable<WrapACounted, Heap> obj{*heap, 3};
+        ASSERT_TRUE(obj.isValid());
+        EXPECT_EQ(3, static_cast<A*>(obj.addressOfObj())->a);
+        obj.a = 4;
+    }
+    EXPECT_EQ(destructed, std::vector<int>{4});
+    EXPECT_EQ(1, targetHeapAllocs.load());
+    EXPECT_EQ(0, targetHeapFrees.load());
+    EXPECT_EQ(1u, heap->cachedByThread());
+
+    // Creating thousands of objects only reaches the target for the live ones.
+    for (int i = 0; i < 1000; ++i)
+    {
+        TargetInstantiable<WrapACounted, Heap> a{*heap, i}, b{*heap, i};
+    }
+    EXPECT_EQ(2, targetHeapAllocs.load());
+
+    // Released objects are owned by the target, and neither destructed nor freed by us.
+    void* released;
+    {
+        TargetInstantiable<WrapACounted, Heap> obj{*heap, 5};
+        released = obj.release();
+        EXPECT_FALSE(obj.isValid());
+    }
+    EXPECT_EQ(5, static_cast<A*>(released)->a);
+    EXPECT_EQ(destructed.back(), 999);
+    targetHeapFree(released);
+
+    // Overfull caches spill to the shared list, other threads reuse it.
+    std::vector<void*> blocks;
+    for (int i = 0; i < 6; ++i) blocks.push_back(heap->allocate());
+    for (auto block : blocks) heap->deallocate(block);
+    EXPECT_EQ(4u, heap->cachedByThread());
+    auto allocs = targetHeapAllocs.load();
+    std::thread other{[&] 
+    { 
+        auto block = heap->allocate();
+        heap->deallocate(block);
+    }};
+    other.join();
+    EXPECT_EQ(allocs, targetHeapAllocs.load());
+
+    // Destroying the heap returns all blocks but the released one, which was freed above.
+    heap.reset();
+    EXPECT_EQ(targetHeapAllocs.load(), targetHeapFrees.load());
+}
+
+// ============================================================================================== //
+// [Hook] testing                                                                                 //
+// ============================================================================================== //
+
+class HookTest : public testing::Test
+{
+protected:
+    static internal::X86Instruction decode(std::initializer_list<uint8_t> code, bool is64 = true)
+    {
+        uint8_t buffer[32] = {};
+        std::copy(code.begin(), code.end(), buffer);
+        internal::X86Instruction insn;
+        EXPECT_TRUE(internal::decodeX86(buffer, is64, insn));
+        EXPECT_EQ(insn.length, code.size());
+        return insn;
+    }
+};
+
+TEST_F(HookTest, DecoderTest)
+{
+    decode({0x55});                                                 // push rbp
+    decode({0x48, 0x89, 0xE5});                                     // mov rbp, rsp
+    decode({0x48, 0x83, 0xEC, 0x20});                               // sub rsp, 0x20
+    decode({0xF3, 0x0F, 0x1E, 0xFA});                               // endbr64
+    decode({0x0F, 0x1F, 0x44, 0x00, 0x00});                         // nop [rax + rax]
+    decode({0x66, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00}); // nop [rax + rax + 0]
+    decode({0xC5, 0xF8, 0x77});                                     // vzeroupper
+    decode({0xC7, 0x44, 0x24, 0x08, 0x01, 0x00, 0x00, 0x00});       // mov [rsp + 8], 1
+    decode({0x81, 0x7D, 0xF8, 0x00, 0x01, 0x00, 0x00});             // cmp [rbp - 8], 0x100
+    decode({0x66, 0x81, 0x7D, 0xF8, 0x00, 0x01});                   // cmp word [rbp - 8], 0x100
+    decode({0xF7, 0xC1, 0x01, 0x00, 0x00, 0x00});                   // test ecx, 1
+    decode({0xF7, 0xD9});                                           // neg ecx
+    decode({0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8});                   // mov rax, imm64
+    decode({0xB8, 1, 2, 3, 4});                                     // mov eax, imm32
+    decode({0x8B, 0x04, 0x25, 0x10, 0x00, 0x00, 0x00});             // mov eax, [0x10]
+
+    auto rip = decode({0x48, 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00});   // mov rax, [rip + 0x10]
+    EXPECT_EQ(rip.ripDispOffset, 3);
+    auto ripImm = decode({0xF6, 0x05, 0x10, 0x00, 0x00, 0x00, 0x01}); // test byte [rip + 0x10], 1
+    EXPECT_EQ(ripImm.ripDispOffset, 2);
+    auto vex = decode({0xC4, 0xE2, 0x79, 0x18, 0x05, 0, 0, 0, 0}); // vbroadcastss xmm0, [rip]
+    EXPECT_EQ(vex.ripDispOffset, 5);
+    EXPECT_EQ(decode({0x8B, 0x05, 0x10, 0x00, 0x00, 0x00}, false).ripDispOffset, -1);
+
+    auto call = decode({0xE8, 0x00, 0x00, 0x00, 0x00});
+    EXPECT_EQ(call.branch, internal::X86Branch::Call);
+    EXPECT_EQ(call.relOffset, 1);
+    EXPECT_FALSE(call.endsFlow);
+    auto jcc = decode({0x74, 0x10});
+    EXPECT_EQ(jcc.branch, internal::X86Branch::Jcc);
+    EXPECT_EQ(jcc.condition, 4);
+    EXPECT_EQ(jcc.relSize, 1);
+    auto jccNear = decode({0x0F, 0x85, 0x00, 0x01, 0x00, 0x00});
+    EXPECT_EQ(jccNear.branch, internal::X86Branch::Jcc);
+    EXPECT_EQ(jccNear.condition, 5);
+    EXPECT_EQ(jccNear.relOffset, 2);
+    EXPECT_TRUE(decode({0xEB, 0x00}).endsFlow);
+    EXPECT_TRUE(decode({0xC3}).endsFlow);
+    EXPECT_TRUE(decode({0xFF, 0x25, 0x00, 0x00, 0x00, 0x00}).endsFlow);
+
+    internal::X86Instruction insn;
+    const uint8_t kEvex[] = {0x62, 0xF1, 0x7C, 0x48, 0x10, 0x00};
+    EXPECT_FALSE(internal::decodeX86(kEvex, true, insn));
+    const uint8_t kFarJmp[] = {0xEA, 0, 0, 0, 0, 0, 0};
+    EXPECT_FALSE(internal::decodeX86(kFarJmp, false, insn));
+
+    // Padding between functions.
+    const uint8_t kPadding[] = {
+        0x66, 0x66, 0x2E, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, // nop cs:[rax + rax + 0]
+        0x0F, 0x1F, 0x40, 0x00,                                           // nop [rax + 0]
+        0x66, 0x90,                                                       // xchg ax, ax
+        0x90, 0xCC,                                                       // nop, int3
+    };
+    EXPECT_EQ(internal::x86PaddingLength(kPadding, true), 11u);
+    EXPECT_EQ(internal::x86PaddingLength(kPadding + 11, true), 4u);
+    EXPECT_EQ(internal::x86PaddingLength(kPadding + 15, true), 2u);
+    EXPECT_EQ(internal::x86PaddingLength(kPadding + 17, true), 1u);
+    EXPECT_EQ(internal::x86PaddingLength(kPadding + 18, true), 1u);
+    const uint8_t kNotPadding[] = {0x0F, 0x1F, 0x48, 0x00, 0x66, 0x89, 0xC0};
+    EXPECT_EQ(internal::x86PaddingLength(kNotPadding, true), 0u);       // nop with reg != 0
+    EXPECT_EQ(internal::x86PaddingLength(kNotPadding + 4, true), 0u);   // mov ax, ax
+}
+
+#ifdef REMODEL_HAS_HOOKS
+
+#if defined(_MSC_VER)
+#   define REMODEL_TEST_NOINLINE __declspec(noinline)
+#else
+#   define REMODEL_TEST_NOINLINE __attribute__((noinline))
+#endif
+
+REMODEL_TEST_NOINLINE static int hookTarget(int a, int b)
+{
+    volatile int product = a * b;
+    return product + 1;
+}
+
+Hook<int(*)(int, int)>* activeHook = nullptr;
+
+static int hookDetour(int a, int b)
+{
+    return activeHook->original()(a, b) + 1000;
+}
+
+TEST_F(HookTest, InstallTest)
+{
+    int (* volatile call)(int, int) = &hookTarget;
+    Function<int(*)(int, int)> wrapTarget{&hookTarget};
+    {
+        Hook<int(*)(int, int)> hook{wrapTarget, &hookDetour};
+        activeHook = &hook;
+        EXPECT_EQ(call(6, 7), 43);
+        EXPECT_EQ(hook.original()(6, 7), 43);
+
+        ASSERT_TRUE(hook.install());
+        EXPECT_TRUE(hook.isInstalled());
+        EXPECT_EQ(call(6, 7), 1043);
+        EXPECT_EQ(wrapTarget(6, 7), 1043);
+        EXPECT_EQ(hook.original()(6, 7), 43);
+        EXPECT_EQ(hook.callOriginal(6, 7), 43);
+
+        ASSERT_TRUE(hook.uninstall());
+        EXPECT_FALSE(hook.isInstalled());
+        EXPECT_EQ(call(6, 7), 43);
+
+        ASSERT_TRUE(hook.install());
+        EXPECT_EQ(call(2, 3), 1007);
+    }
+    EXPECT_EQ(call(2, 3), 7);
+    activeHook = nullptr;
+}
+
+REMODEL_TEST_NOINLINE static int secondHookTarget(int a, int b)
+{
+    volatile int sum = a + b;
+    return sum - 1;
+}
+
+Hook<int(*)(int, int)>* activeSecondHook = nullptr;
+
+static int secondHookDetour(int a, int b)
+{
+    return activeSecondHook->original()(a, b) + 2000;
+}
+
+TEST_F(HookTest, TransactionTest)
+{
+    int (* volatile first)(int, int)  = &hookTarget;
+    int (* volatile second)(int, int) = &secondHookTarget;
+    Hook<int(*)(int, int)> firstHook{first, &hookDetour};
+    Hook<int(*)(int, int)> secondHook{second, &secondHookDetour};
+    activeHook       = &firstHook;
+    activeSecondHook = &secondHook;
+
+    // Keep another thread busy in the targets while patching.
+    std::atomic<bool> stop{false};
+    std::atomic<int>  inconsistent{0};
+    std::thread worker{[&]
+    {
+        while (!stop.load())
+        {
+            auto a = first(6, 7);
+            auto b = second(6, 7);
+            if ((a != 43 && a != 1043) || (b != 12 && b != 2012)) ++inconsistent;
+        }
+    }};
+
+    HookTransaction install;
+    install.install(firstHook).install(secondHook);
+    EXPECT_EQ(install.size(), 2u);
+    ASSERT_TRUE(install.commit());
+    EXPECT_TRUE(firstHook.isInstalled());
+    EXPECT_TRUE(secondHook.isInstalled());
+    EXPECT_EQ(first(6, 7),  1043);
+    EXPECT_EQ(second(6, 7), 2012);
+
+    HookTransaction uninstall;
+    uninstall.uninstall(firstHook).uninstall(secondHook);
+    ASSERT_TRUE(uninstall.commit());
+    EXPECT_EQ(first(6, 7),  43);
+    EXPECT_EQ(second(6, 7), 12);
+
+    stop.store(true);
+    worker.join();
+    EXPECT_EQ(inconsistent.load(), 0);
+    activeHook       = nullptr;
+    activeSecondHook = nullptr;
+}
+
+#ifdef REMODEL_HAS_THREAD_FREEZE
+
+TEST_F(HookTest, ThreadFreezeTest)
+{
+    std::atomic<bool>     stop{false};
+    std::atomic<uint64_t> counter{0};
+    std::thread worker{[&] { while (!stop.load()) ++counter; }};
+    while (!counter.load()) std::this_thread::yield();
+
+    platform::ThreadFreeze freeze;
+    ASSERT_TRUE(freeze.freeze());
+    EXPECT_TRUE(freeze.isFrozen());
+    std::size_t threads = 0;
+    freeze.forEachThread([&](uintptr_t& ip) { threads += ip != 0; });
+    EXPECT_GE(threads, 1u);
+    auto frozen = counter.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    EXPECT_EQ(counter.load(), frozen);
+
+    freeze.thaw();
+    EXPECT_FALSE(freeze.isFrozen());
+    while (counter.load() == frozen) std::this_thread::yield();
+    stop.store(true);
+    worker.join();
+}
+
+#endif // ifdef REMODEL_HAS_THREAD_FREEZE
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+Hook<int(*)(int)>* activeStubHook = nullptr;
+
+static int stubDetour(int x)
+{
+    return activeStubHook->original()(x) + 1000;
+}
+
+TEST_F(HookTest, RelocationTest)
+{
+    auto code = static_cast<uint8_t*>(platform::allocateCodeNear(
+        reinterpret_cast<void*>(&stubDetour), 256));
+    ASSERT_NE(code, nullptr);
+
+    // int stub(int x) { return x == 0 ? 7 : 3; }, starting with a short `je`.
+#if defined(_WIN64)
+    const uint8_t kTestArg = 0xC9;
+#else
+    const uint8_t kTestArg = 0xFF;
+#endif
+    const uint8_t kBranchStub[] = {
+        0x85, kTestArg,                 // test ecx/edi, ecx/edi
+        0x74, 0x06,                     // je +6
+        0xB8, 0x03, 0x00, 0x00, 0x00,   // mov eax, 3
+        0xC3,                           // ret
+        0xB8, 0x07, 0x00, 0x00, 0x00,   // mov eax, 7
+        0xC3,                           // ret
+    };
+    // int stub(int) { return *(int*)(rip + 57); }, reading the constant at offset 128.
+    const uint8_t kRipStub[] = {
+        0x8B, 0x05, 0x7A, 0x00, 0x00, 0x00, // mov eax, [rip + 0x7A]
+        0xC3,                               // ret
+    };
+    // int stub(int x) { return x; }, shorter than the patch and padded with a multi-byte nop.
+    const uint8_t kShortStub[] = {
+        0x89, static_cast<uint8_t>(kTestArg == 0xC9 ? 0xC8 : 0xF8), // mov eax, ecx/edi
+        0xC3,                                                       // ret
+        0x0F, 0x1F, 0x40, 0x00,                                     // nop [rax + 0]
+    };
+    const int32_t kConstant = 1234;
+    std::memcpy(code, kBranchStub, sizeof(kBranchStub));
+    std::memcpy(code + 32, kShortStub, sizeof(kShortStub));
+    std::memcpy(code + 64, kRipStub, sizeof(kRipStub));
+    std::memset(code + 64 + sizeof(kRipStub), 0xCC, 8);
+    std::memcpy(code + 64 + 6 + 0x7A, &kConstant, sizeof(kConstant));
+
+    auto branchStub = reinterpret_cast<int(*)(int)>(code);
+    auto ripStub    = reinterpret_cast<int(*)(int)>(code + 64);
+    {
+        Hook<int(*)(int)> hook{branchStub, &stubDetour};
+        ASSERT_TRUE(hook.impl().prepare());
+        auto trampoline = reinterpret_cast<uintptr_t>(hook.impl().trampoline());
+        auto base       = reinterpret_cast<uintptr_t>(code);
+        EXPECT_EQ(hook.impl().relocateInstructionPointer(base + 0), trampoline + 0);
+        EXPECT_EQ(hook.impl().relocateInstructionPointer(base + 2), trampoline + 2);
+        EXPECT_EQ(hook.impl().relocateInstructionPointer(base + 4), trampoline + 8);
+        EXPECT_EQ(hook.impl().relocateInstructionPointer(base + 9), base + 9);
+
+        activeStubHook = &hook;
+        ASSERT_TRUE(hook.install());
+        EXPECT_EQ(branchStub(0), 1007);
+        EXPECT_EQ(branchStub(1), 1003);
+        EXPECT_EQ(hook.original()(0), 7);
+        EXPECT_EQ(hook.original()(1), 3);
+    }
+    EXPECT_EQ(branchStub(0), 7);
+    {
+        Hook<int(*)(int)> hook{ripStub, &stubDetour};
+        activeStubHook = &hook;
+        ASSERT_TRUE(hook.install());
+        EXPECT_EQ(ripStub(0), 2234);
+        EXPECT_EQ(hook.original()(0), 1234);
+    }
+    EXPECT_EQ(ripStub(0), 1234);
+
+    auto shortStub = reinterpret_cast<int(*)(int)>(code + 32);
+    {
+        Hook<int(*)(int)> hook{shortStub, &stubDetour};
+        activeStubHook = &hook;
+        ASSERT_TRUE(hook.install());
+        EXPECT_EQ(shortStub(5), 1005);
+        EXPECT_EQ(hook.original()(5), 5);
+    }
+    EXPECT_EQ(shortStub(5), 5);
+    activeStubHook = nullptr;
+}
+
+#endif // if defined(_M_X64) || defined(__x86_64__)
+#endif // ifdef REMODEL_HAS_HOOKS
+
+// ============================================================================================== //
+// [NearCodeAllocator] testing                                                                    //
+// ============================================================================================== //
+
+#ifdef REMODEL_HAS_CODE_MEMORY
+
+TEST(NearCodeAllocatorTest, AllocateTest)
+{
+    auto mainModule = Module::getModule(nullptr);
+    ASSERT_TRUE(mainModule);
+    auto base = static_cast<const uint8_t*>(mainModule.value().addressOfObj());
+    auto size = mainModule.value().imageSize();
+    ASSERT_NE(size, 0u);
+
+    NearCodeAllocator caves{mainModule.value()};
+    auto a = caves.allocate(20);
+    auto b = caves.allocate(20, 64);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 16, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    EXPECT_TRUE(b >= a + 20 || b + 20 <= a);
+    EXPECT_TRUE(caves.reaches(base));
+    EXPECT_TRUE(caves.reaches(base + size - 1));
+    EXPECT_EQ(caves.allocate(0), nullptr);
+
+    // Freed blocks are handed out again.
+    caves.deallocate(a, 20);
+    EXPECT_EQ(caves.allocate(16), a);
+
+#if defined(_M_X64) || defined(__x86_64__)
+    // int cave() { return 42; }
+    const uint8_t kCode[] = {0xB8, 0x2A, 0x00, 0x00, 0x00, 0xC3};
+    std::memcpy(b, kCode, sizeof(kCode));
+    EXPECT_EQ(reinterpret_cast<int(*)()>(b)(), 42);
+#endif
+}
+
+TEST(PatchTransactionTest, CommitTest)
+{
+    auto pages = platform::pageSize();
+    auto code  = static_cast<uint8_t*>(platform::allocateCodeNear(&pages, 3 * pages));
+    ASSERT_NE(code, nullptr);
+    std::memset(code, 0xCC, 3 * pages);
+
+    PatchTransaction patches;
+    patches
+        .write(code + 1, {0x90, 0x90})
+        .write(code + 16, uint32_t{0x11223344})
+        .write(code + 2 * pages + 7, {0xC3});
+    EXPECT_EQ(patches.size(), 3u);
+    ASSERT_TRUE(patches.commit());
+    EXPECT_TRUE(patches.isCommitted());
+    EXPECT_EQ(code[0], 0xCC);
+    EXPECT_EQ(code[1], 0x90);
+    EXPECT_EQ(code[2], 0x90);
+    EXPECT_EQ(code[3], 0xCC);
+    uint32_t value;
+    std::memcpy(&value, code + 16, sizeof(value));
+    EXPECT_EQ(value, 0x11223344u);
+    EXPECT_EQ(code[2 * pages + 7], 0xC3);
+
+    ASSERT_TRUE(patches.revert());
+    EXPECT_FALSE(patches.isCommitted());
+    for (std::size_t i = 0; i < 3 * pages; ++i) ASSERT_EQ(code[i], 0xCC);
+    platform::releaseCode(code, 3 * pages);
+}
+
+#endif // ifdef REMODEL_HAS_CODE_MEMORY
+
+// ============================================================================================== //
+// [BoundThunk] testing                                                                           //
+// ============================================================================================== //
+
+#if defined(REMODEL_HAS_HOOKS) && defined(ZYCORE_GNUC) && defined(__x86_64__) \
+    && !defined(ZYCORE_WINDOWS)
+
+static int thunkVisit(void* thiz, int a, int b, int c, int d, int e, float scale)
+{
+    return static_cast<int>(static_cast<float>(*static_cast<int*>(thiz) + a - b + c - d + e) 
+        * scale);
+}
+
+static float __attribute__((ms_abi)) thunkMsVisit(void* thiz, int a, float b, int c)
+{
+    return static_cast<float>(*static_cast<int*>(thiz) + a + c) * b;
+}
+
+class WrapThunkTarget : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapThunkTarget)
+public:
+    using MsVisit = float (__attribute__((ms_abi))*)(int, float, int);
+    MemberFunction<int (*)(int, int, int, int, int, float)> visit{
+        this, reinterpret_cast<void*>(&thunkVisit)};
+    MemberFunction<MsVisit> msVisit{this, reinterpret_cast<void*>(&thunkMsVisit)};
+};
+
+TEST(BoundThunkTest, CallbackTest)
+{
+    int objA = 100, objB = 200;
+    auto thunkA = bindThunk(wrapper_cast<WrapThunkTarget>(&objA).visit);
+    auto thunkB = bindThunk(wrapper_cast<WrapThunkTarget>(&objB).visit);
+    ASSERT_TRUE(thunkA.isValid());
+    ASSERT_TRUE(thunkB.isValid());
+    static_assert(std::is_same<decltype(thunkA.get()), int (*)(int, int, int, int, int, float)>
+        ::value, "");
+    EXPECT_EQ(206, thunkA.get()(1, 2, 3, 4, 5, 2.f));
+    EXPECT_EQ(203, thunkB.get()(1, 2, 3, 4, 5, 1.f));
+
+    auto msThunk = bindThunk(wrapper_cast<WrapThunkTarget>(&objA).msVisit);
+    ASSERT_TRUE(msThunk.isValid());
+    EXPECT_EQ(208.f, msThunk.get()(1, 2.f, 3));
+
+    // Moved-from thunks are invalid, recycled slots are regenerated.
+    auto moved = std::move(thunkA);
+    EXPECT_FALSE(thunkA.isValid());
+    EXPECT_EQ(206, moved.get()(1, 2, 3, 4, 5, 2.f));
+    {
+        auto scratch = std::move(moved);
+    }
+    auto recycled = bindThunk(wrapper_cast<WrapThunkTarget>(&objB).visit);
+    EXPECT_EQ(406, recycled.get()(1, 2, 3, 4, 5, 2.f));
+}
+
+static long traverseNodes(const int* nodes, std::size_t count, long (*visit)(int node, int depth))
+{
+    long total = 0;
+    for (std::size_t i = 0; i < count; ++i) total += visit(nodes[i], static_cast<int>(i % 3));
+    return total;
+}
+
+TEST(CallbackThunkTest, ClosureTest)
+{
+    const int nodes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    using Visit = long (*)(int, int);
+
+    // Concurrent traversals with independent state.
+    std::vector<long> sums(4);
+    std::vector<int> visits(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&, i]
+        {
+            for (int round = 0; round < 100; ++round)
+            {
+                auto visit = makeCallback<Visit>([&, i](int node, int depth) -> long
+                {
+                    ++visits[i];
+                    return node * (i + 1) + depth;
+                });
+                ASSERT_TRUE(visit.isValid());
+                sums[i] = traverseNodes(nodes, 8, visit.get());
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(36 * (i + 1) + 7, sums[i]);
+        EXPECT_EQ(800, visits[i]);
+    }
+
+    // Callables too large for the slot live on the heap, owned state is destroyed.
+    auto owned = std::make_shared<int>(5);
+    char padding[200] = {3};
+    {
+        CallbackThunk<Visit> large{[owned, padding](int node, int) -> long 
+        { 
+            return node * *owned + padding[0]; 
+        }};
+        ASSERT_TRUE(large.isValid());
+        EXPECT_EQ(2, owned.use_count());
+        EXPECT_EQ(36 * 5 + 8 * 3, traverseNodes(nodes, 8, large.get()));
+
+        auto moved = std::move(large);
+        EXPECT_FALSE(large.isValid());
+        EXPECT_EQ(36 * 5 + 8 * 3, traverseNodes(nodes, 8, moved.get()));
+    }
+    EXPECT_EQ(1, owned.use_count());
+
+    auto msThunk = makeCallback<float (__attribute__((ms_abi))*)(int, float)>(
+        [owned](int a, float b) { return static_cast<float>(a + *owned) * b; });
+    EXPECT_EQ(16.f, msThunk.get()(3, 2.f));
+}
+
+#endif
+
+// ============================================================================================== //
+// [SetterEventStream] testing                                                                    //
+// ============================================================================================== //
+
+#ifdef REMODEL_HAS_HOOKS
+
+struct SetterTestVec
+{
+    float x;
+    float y;
+};
+
+// Longer than the hook patch, so hooking doesn't depend on the padding the optimizer emits.
+REMODEL_TEST_NOINLINE static void setterHealth(void* thiz, int health)
+{
+    volatile int clamped = health < 0 ? 0 : health;
+    *static_cast<volatile int*>(thiz) = clamped;
+}
+
+REMODEL_TEST_NOINLINE static void setterPosition(void* thiz, const SetterTestVec& pos)
+{
+    std::memcpy(static_cast<char*>(thiz) + sizeof(int), &pos, sizeof(pos));
+}
+
+class WrapSetterTarget : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapSetterTarget)
+public:
+    MemberFunction<void (*)(int)> setHealth{this, reinterpret_cast<void*>(&setterHealth)};
+};
+
+TEST(SetterEventStreamTest, PublishTest)
+{
+    struct Obj { int health; SetterTestVec pos; } a{}, b{};
+    auto wrapA = wrapper_cast<WrapSetterTarget>(&a);
+    auto wrapB = wrapper_cast<WrapSetterTarget>(&b);
+
+    SetterEventStream<void (*)(void*, int), void, 4> healthEvents{wrapA.setHealth};
+    ASSERT_TRUE(healthEvents.install());
+    SetterEventStream<void (*)(void*, int), void, 4> duplicate{&setterHealth};
+    EXPECT_FALSE(duplicate.install());
+
+    wrapA.setHealth(10);
+    wrapB.setHealth(20);
+    wrapA.setHealth(30);
+    EXPECT_EQ(a.health, 30);
+    EXPECT_EQ(b.health, 20);
+
+    std::vector<std::pair<void*, int>> events;
+    auto collect = [&](const SetterEvent<int>& event)
+    {
+        events.emplace_back(event.object, std::get<0>(event.args));
+    };
+    EXPECT_EQ(healthEvents.drainLatest(collect), 3u);
+    EXPECT_EQ(events, (std::vector<std::pair<void*, int>>{{&b, 20}, {&a, 30}}));
+    EXPECT_TRUE(healthEvents.empty());
+
+    // Full rings drop events, the setter itself keeps working.
+    for (int i = 0; i < 6; ++i) wrapA.setHealth(i);
+    EXPECT_EQ(a.health, 5);
+    EXPECT_EQ(healthEvents.dropped(), 2u);
+    events.clear();
+    healthEvents.drain([&](const SetterEvent<int>* run, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) collect(run[i]);
+    });
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[3].second, 3);
+
+    // Arguments passed by reference are stored by value.
+    SetterEventStream<void (*)(void*, const SetterTestVec&)> posEvents{&setterPosition};
+    ASSERT_TRUE(posEvents.install());
+    void (* volatile setPos)(void*, const SetterTestVec&) = &setterPosition;
+    setPos(&b, SetterTestVec{1.f, 2.f});
+    EXPECT_EQ(b.pos.y, 2.f);
+    posEvents.drainLatest([&](const SetterEvent<const SetterTestVec&>& event)
+    {
+        EXPECT_EQ(event.object, &b);
+        EXPECT_EQ(std::get<0>(event.args).x, 1.f);
+    });
+
+    ASSERT_TRUE(healthEvents.uninstall());
+    wrapA.setHealth(99);
+    EXPECT_TRUE(healthEvents.empty());
+    ASSERT_TRUE(duplicate.install());
+    EXPECT_TRUE(duplicate.uninstall());
+}
+
+#endif // ifdef REMODEL_HAS_HOOKS
+
+// ============================================================================================== //
+// [LifetimeTracker] testing                                                                      //
+// ============================================================================================== //
+
+#ifdef REMODEL_HAS_HOOKS
+
+struct LifetimeTestObj
+{
+    int alive;
+};
+
+REMODEL_TEST_NOINLINE static void lifetimeDestroy(void* thiz)
+{
+    static_cast<volatile LifetimeTestObj*>(thiz)->alive = 0;
+}
+
+class WrapLifetimeTestObj : public AdvancedClassWrapper<sizeof(LifetimeTestObj)>
+{
+    REMODEL_ADV_WRAPPER(WrapLifetimeTestObj)
+public:
+    Field<int> alive{this, offsetof(LifetimeTestObj, alive)};
+    MemberFunction<void (*)()> destroy{this, reinterpret_cast<void*>(&lifetimeDestroy)};
+};
+
+TEST(LifetimeTrackerTest, InvalidationTest)
+{
+    LifetimeTestObj objs[4] = {{1}, {1}, {1}, {1}};
+    WrapperIdentityMap<WrapLifetimeTestObj> map{16};
+    for (auto& obj : objs) map.get(&obj);
+
+    auto wrap0 = wrapper_cast<WrapLifetimeTestObj>(&objs[0]);
+    LifetimeTracker<void (*)(void*)> tracker{wrap0.destroy, 2};
+    tracker.attach(map);
+    std::vector<const void*> destroyed;
+    auto id = tracker.subscribe([&](const void* obj) { destroyed.push_back(obj); });
+    ASSERT_TRUE(tracker.install());
+
+    // Destruction from any thread is published, the original still runs.
+    wrap0.destroy();
+    std::thread other{[&] { map.find(&objs[1])->destroy(); }};
+    other.join();
+    EXPECT_EQ(0, objs[1].alive);
+    EXPECT_EQ(4u, map.size());
+
+    EXPECT_EQ(2u, tracker.dispatch());
+    EXPECT_EQ(2u, map.size());
+    EXPECT_EQ(nullptr, map.find(&objs[0]));
+    EXPECT_EQ(nullptr, map.find(&objs[1]));
+    EXPECT_EQ((std::vector<const void*>{&objs[0], &objs[1]}), destroyed);
+
+    // Overflowing the queue invalidates everything.
+    std::size_t lostCalls = 0;
+    EXPECT_TRUE(tracker.unsubscribe(id));
+    EXPECT_FALSE(tracker.unsubscribe(id));
+    tracker.subscribe([&](const void*) {}, [&] { ++lostCalls; });
+    map.get(&objs[0]);
+    for (int i = 0; i < 3; ++i) wrapper_cast<WrapLifetimeTestObj>(&objs[i]).destroy();
+    EXPECT_EQ(1u, tracker.lost());
+    EXPECT_EQ(2u, tracker.dispatch());
+    EXPECT_EQ(1u, lostCalls);
+    EXPECT_EQ(0u, map.size());
+
+    // Objects destroyed by other means are reported manually.
+    map.get(&objs[3]);
+    EXPECT_TRUE(tracker.publish(&objs[3]));
+    ASSERT_TRUE(tracker.uninstall());
+    wrap0.destroy();
+    EXPECT_EQ(1u, tracker.dispatch());
+    EXPECT_EQ(0u, map.size());
+    EXPECT_EQ(0u, tracker.dispatch());
+}
+
+#endif // ifdef REMODEL_HAS_HOOKS
+
+// ============================================================================================== //
+// [ShadowVfTable] testing                                                                        //
+// ============================================================================================== //
+
+class ShadowVfTableTest : public testing::Test
+{
+protected:
+    struct A
+    {
+        void** vftable;
+        int    c;
+    };
+
+    static int add(void* thiz, int x, int y) { return x + y + static_cast<A*>(thiz)->c; }
+    static int sub(void* thiz, int x, int y) { return x - y - static_cast<A*>(thiz)->c; }
+    static int mul(void* thiz, int x, int y) { return x * y * static_cast<A*>(thiz)->c; }
+
+    struct WrapA : ClassWrapper
+    {
+        REMODEL_WRAPPER(WrapA)
+    public:
+        VirtualFunction<int (*)(int, int)> first {this, 0};
+        VirtualFunction<int (*)(int, int)> second{this, 1};
+    };
+public:
+    ShadowVfTableTest()
+    {
+        storage[0] = nullptr;
+        storage[1] = &storage;
+        storage[2] = reinterpret_cast<void*>(&add);
+        storage[3] = reinterpret_cast<void*>(&sub);
+        a.vftable  = storage + 2;
+        a.c        = 2;
+        b          = a;
+    }
+protected:
+    void* storage[4];
+    A     a;
+    A     b;
+    WrapA wrapA{wrapper_cast<WrapA>(&a)};
+    WrapA wrapB{wrapper_cast<WrapA>(&b)};
+};
+
+TEST_F(ShadowVfTableTest, ShadowVfTableTest)
+{
+    {
+        ShadowVfTable shadow{wrapA, 2};
+        EXPECT_EQ(shadow.size(), 2u);
+        shadow.set(1, &mul);
+        EXPECT_FALSE(shadow.isAttached());
+        EXPECT_EQ(wrapA.second(3, 4), 3 - 4 - 2);
+
+        shadow.attach();
+        EXPECT_TRUE(shadow.isAttached());
+        EXPECT_EQ(wrapA.first (3, 4), 3 + 4 + 2);
+        EXPECT_EQ(wrapA.second(3, 4), 3 * 4 * 2);
+        EXPECT_EQ(shadow.original<int (*)(void*, int, int)>(1)(&a, 3, 4), 3 - 4 - 2);
+        EXPECT_EQ(shadow.shadowTable()[-1], storage[1]);
+
+        // Other objects and the original table are unaffected.
+        EXPECT_EQ(wrapB.second(3, 4), 3 - 4 - 2);
+        EXPECT_EQ(storage[3], reinterpret_cast<void*>(&sub));
+
+        shadow.restore(1);
+        EXPECT_EQ(wrapA.second(3, 4), 3 - 4 - 2);
+        shadow.set(0, &mul);
+        EXPECT_EQ(wrapA.first (3, 4), 3 * 4 * 2);
+
+        EXPECT_TRUE(shadow.detach());
+        EXPECT_EQ(wrapA.first (3, 4), 3 + 4 + 2);
+        shadow.attach();
+    }
+    EXPECT_EQ(a.vftable, storage + 2);
+    EXPECT_EQ(wrapA.first(3, 4), 3 + 4 + 2);
+}
+
+#if !defined(ZYCORE_MSVC) || defined(_WIN64)
+
+struct ShadowBase
+{
+    int c = 5;
+    virtual ~ShadowBase() = default;
+    virtual int value() const { return c; }
+};
+
+struct ShadowDerived : ShadowBase
+{
+    int value() const override { return c * 10; }
+};
+
+static int shadowValueDetour(const ShadowBase* thiz)
+{
+    return thiz->c + 1000;
+}
+
+// MSVC emits a single (deleting) destructor entry, the Itanium ABI two.
+#ifdef ZYCORE_MSVC
+const std::size_t kShadowValueIdx = 1;
+#else
+const std::size_t kShadowValueIdx = 2;
+#endif
+
+// Calls through the vftable at runtime; C++ virtual calls may be devirtualized by the compiler.
+class WrapShadowBase : public ClassWrapper
+{
+    REMODEL_WRAPPER(WrapShadowBase)
+public:
+    VirtualFunction<int (*)()> value{this, kShadowValueIdx};
+};
+
+TEST_F(ShadowVfTableTest, PolymorphicTest)
+{
+    std::unique_ptr<ShadowBase> derived{new ShadowDerived};
+    ShadowBase* volatile object = derived.get();
+    auto wrapper = wrapper_cast<WrapShadowBase>(derived.get());
+    EXPECT_EQ(wrapper.value(), 50);
+
+    ShadowVfTable shadow{object, kShadowValueIdx + 1};
+    shadow.set(kShadowValueIdx, &shadowValueDetour);
+    shadow.attach();
+    EXPECT_EQ(wrapper.value(), 1005);
+    EXPECT_TRUE(typeid(*object) == typeid(ShadowDerived));
+    EXPECT_NE(dynamic_cast<ShadowDerived*>(object), nullptr);
+    EXPECT_TRUE(shadow.detach());
+    EXPECT_EQ(wrapper.value(), 50);
+}
+
+#endif // if !defined(ZYCORE_MSVC) || defined(_WIN64)
+
 // ============================================================================================== //
 
 } // anon namespace
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+#
+# This file is part of the remodel library (zyantific.com).
+#
+# The MIT License (MIT), see LICENSE for details.
+#
+"""Generates remodel wrapper headers from layout description files.
+
+A layout spec describes the target classes of a module by their size, fields, vftable indices and
+function RVAs. The generated wrappers use compile-time offsets (`StaticField`) and are validated
+by `validateLayout` when compiled. Specs are read as JSON, or as YAML if PyYAML is installed and
+the file ends in `.yml`/`.yaml`::
+
+    {
+        "namespace": "game",
+        "module": "game.exe",
+        "includes": ["<cstdint>"],
+        "classes": [
+            {
+                "name": "Cat", "size": "0x18", "align": 8,
+                "fields": [
+                    {"name": "id",    "type": "uint32_t", "offset": "0x8"},
+                    {"name": "owner", "type": "Human*",   "offset": "0x10"}
+                ],
+                "virtuals":  [{"name": "meow", "type": "int (*)(int)", "index": 3}],
+                "functions": [{"name": "feed", "type": "void (*)(int)", "rva": "0x1234"}]
+            }
+        ],
+        "globals": [{"name": "catCount", "type": "uint32_t", "rva": "0x5000"}]
+    }
+
+Classes are emitted in order, so classes referenced by fields have to be listed first. `module`
+defaults to the main module of the process. `packed` classes skip alignment validation.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+_IDENT = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+
+
+class SpecError(Exception):
+    pass
+
+
+def _load(path):
+    with open(path, 'r', encoding='utf-8') as f:
+        if path.endswith(('.yml', '.yaml')):
+            try:
+                import yaml
+            except ImportError:
+                raise SpecError('reading YAML specs requires PyYAML')
+            return yaml.safe_load(f)
+        return json.load(f)
+
+
+def _number(value, what):
+    if isinstance(value, bool):
+        raise SpecError('%s: expected a number' % what)
+    if isinstance(value, int):
+        return value
+    if isinstance(value, str):
+        try:
+            return int(value, 0)
+        except ValueError:
+            pass
+    raise SpecError('%s: expected a number, got %r' % (what, value))
+
+
+def _ident(entry, what):
+    name = entry.get('name')
+    if not isinstance(name, str) or not _IDENT.match(name):
+        raise SpecError('%s: invalid name %r' % (what, name))
+    return name
+
+
+def _string(entry, key, what):
+    value = entry.get(key)
+    if not isinstance(value, str) or not value.strip():
+        raise SpecError('%s: missing "%s"' % (what, key))
+    return value.strip()
+
+
+def _emit_class(cls, out):
+    name = _ident(cls, 'class')
+    what = 'class ' + name
+    size = _number(cls.get('size'), what + ': size')
+    align = _number(cls.get('align', 1), what + ': align')
+    if size <= 0:
+        raise SpecError('%s: size must be positive' % what)
+
+    members = []
+    fields = []
+    for field in cls.get('fields', []):
+        fname = _ident(field, what + ': field')
+        fwhat = '%s::%s' % (name, fname)
+        offs = _number(field.get('offset'), fwhat + ': offset')
+        members.append('    remodel::StaticField<%s, 0x%X> %s{this};'
+                       % (_string(field, 'type', fwhat), offs, fname))
+        fields.append(fname)
+    for func in cls.get('virtuals', []):
+        fname = _ident(func, what + ': virtual')
+        fwhat = '%s::%s' % (name, fname)
+        index = _number(func.get('index'), fwhat + ': index')
+        vftOffs = _number(func.get('vftableOffset', 0), fwhat + ': vftableOffset')
+        extra = ', 0x%X' % vftOffs if vftOffs else ''
+        members.append('    remodel::VirtualFunction<%s> %s{this, %d%s};'
+                       % (_string(func, 'type', fwhat), fname, index, extra))
+    for func in cls.get('functions', []):
+        fname = _ident(func, what + ': function')
+        fwhat = '%s::%s' % (name, fname)
+        rva = _number(func.get('rva'), fwhat + ': rva')
+        members.append('    remodel::MemberFunction<%s> %s{this, targetModule(), 0x%X};'
+                       % (_string(func, 'type', fwhat), fname, rva))
+
+    out.append('class %s : public remodel::AdvancedClassWrapper<0x%X, %d>' % (name, size, align))
+    out.append('{')
+    out.append('    REMODEL_ADV_WRAPPER(%s)' % name)
+    out.append('public:')
+    out.extend(members)
+    out.append('};')
+    out.append('')
+
+    validate = 'validatePackedLayout' if cls.get('packed', False) else 'validateLayout'
+    args = ''.join(',\n    decltype(%s::%s)' % (name, f) for f in fields)
+    out.append('static_assert(remodel::%s<%s%s>(),' % (validate, name, args))
+    out.append('    "layout of %s is invalid");' % name)
+    out.append('')
+
+
+def _uses_module(spec):
+    return bool(spec.get('globals')) or any(
+        cls.get('functions') for cls in spec.get('classes', []))
+
+
+def generate(spec, source):
+    if not isinstance(spec, dict):
+        raise SpecError('spec root must be an object')
+
+    guard = 'REMODEL_GENERATED_%s_HPP' % re.sub(r'\W', '_', source).upper()
+    out = [
+        '// Generated by remodel_gen.py from %s, do not edit.' % source,
+        '',
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+        '#include <Remodel.hpp>',
+    ]
+    for include in spec.get('includes', []):
+        out.append('#include %s' % (include if include[:1] in '<"' else '"%s"' % include))
+    out.append('')
+
+    namespaces = [ns for ns in spec.get('namespace', '').split('::') if ns]
+    for ns in namespaces:
+        if not _IDENT.match(ns):
+            raise SpecError('invalid namespace %r' % spec['namespace'])
+        out.append('namespace %s' % ns)
+        out.append('{')
+    if namespaces:
+        out.append('')
+
+    if _uses_module(spec):
+        module = spec.get('module')
+        out.append('inline const remodel::Module& targetModule()')
+        out.append('{')
+        out.append('    static auto module = remodel::Module::getModule(%s);'
+                   % (json.dumps(module) if module else 'nullptr'))
+        out.append('    return module.value();')
+        out.append('}')
+        out.append('')
+
+    for cls in spec.get('classes', []):
+        _emit_class(cls, out)
+
+    for glob in spec.get('globals', []):
+        gname = _ident(glob, 'global')
+        gtype = _string(glob, 'type', 'global ' + gname)
+        rva = _number(glob.get('rva'), 'global %s: rva' % gname)
+        out.append('inline %s& %s()' % (gtype, gname))
+        out.append('{')
+        out.append('    return *static_cast<%s*>(remodel::ModuleRelGetter{targetModule(), 0x%X}'
+                   '(nullptr));' % (gtype, rva))
+        out.append('}')
+        out.append('')
+
+    for ns in reversed(namespaces):
+        out.append('} // namespace %s' % ns)
+    if namespaces:
+        out.append('')
+    out.append('#endif // %s' % guard)
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('spec', help='the layout spec (JSON or YAML)')
+    parser.add_argument('-o', '--output', required=True, help='the header to write')
+    args = parser.parse_args()
+
+    try:
+        header = generate(_load(args.spec), os.path.basename(args.spec))
+    except (SpecError, ValueError, OSError) as e:
+        sys.stderr.write('%s: error: %s\n' % (args.spec, e))
+        return 1
+
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(header)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())